@@ -37,6 +37,7 @@
 #include <ntfw_com_mem_alloc.h>
 #include <ntfw_com_data_model.h>
 #include <ntfw_com_debug_util.h>
+#include <ntfw_com_timer_wheel.h>
 #include <ntfw_cryptography.h>
 #include <ntfw_io_gpio_util.h>
 #include <ntfw_io_file_util.h>
@@ -207,6 +208,16 @@
 #define COM_TICKET_TX_SEQ       "tx_seq_no"
 // 受信シーケンス番号
 #define COM_TICKET_RX_SEQ       "rx_seq_no"
+// メッセージ認証モード
+#define COM_TICKET_AUTH_MODE    "auth_mode"
+// 暗号スイート
+#define COM_TICKET_CIPHER       "cipher_suite"
+// 送信ウィンドウサイズ
+#define COM_TICKET_TX_WINDOW    "tx_window"
+// 本文の圧縮の有無
+#define COM_TICKET_COMPRESS     "compress"
+// 暗号文のコンテンツ種別の有無
+#define COM_TICKET_CONTENT      "content"
 
 //==============================================================================
 // タスク関係
@@ -483,7 +494,9 @@ typedef struct {
     bool b_secure_connect;                          // セキュアコネクトフラグ
     char c_pair_chk_code[BLE_MSG_CODE_SIZE + 1];    // ペアリング確認用コード(Base64)
     ts_ctrl_msg_t s_ctrl_msg;                       // 制御メッセージ
-    int64_t i64_timeout_ms;                         // タイムアウト時刻（ミリ秒）
+    ts_tmw_timer_t s_timeout_timer;                 // タイムアウトタイマー
+    uint32_t u32_timeout_gen;                       // タイムアウトの世代（停止済みタイマーの判別用）
+    bool b_timeout;                                 // タイムアウト発生フラグ
 } ts_com_status_t;
 
 /**
@@ -595,6 +608,8 @@ static bool b_evt_chk_timeout();
 static void v_evt_set_timeout(int64_t i64_timeout_ms);
 /** タイムアウト時間のクリア */
 static void v_evt_clear_timeout();
+/** タイムアウトタイマーのコールバック */
+static void v_evt_timeout_cb(void* pv_arg);
 /** 接続ステータスの更新処理 */
 static void v_upd_link_sts(bool b_linked);
 /** センサーステータス参照 */
@@ -735,7 +750,9 @@ static ts_com_status_t s_com_status = {
         .e_cmd  = CTL_CMD_COUNT,                // 制御コマンド
         .e_mode = OPR_MODE_COUNT,               // 動作モード
     },
-    .i64_timeout_ms = MAX_VALUE_INT64,          // タイムアウト（ミリ秒）
+    .s_timeout_timer = {0},                     // タイムアウトタイマー
+    .u32_timeout_gen = 0,                       // タイムアウトの世代
+    .b_timeout = false,                         // タイムアウト発生フラグ
 };
 
 /** 各画面のステータス */
@@ -870,6 +887,8 @@ void app_main() {
     //==========================================================================
     // ミューテックスの初期化
     s_mutex = xSemaphoreCreateRecursiveMutex();
+    // タイマーサービスの開始
+    ESP_ERROR_CHECK(sts_tmw_begin_service());
     // デバイス初期処理
     v_init_device();
     // アプリケーション初期処理
@@ -1565,6 +1584,11 @@ static bool b_read_ticket_file() {
         cJSON* ps_max_seq_no;               // 最大シーケンス番号
         cJSON* ps_tx_seq_no;                // 送信シーケンス番号
         cJSON* ps_rx_seq_no;                // 受信シーケンス番号
+        cJSON* ps_auth_mode;                // メッセージ認証モード
+        cJSON* ps_cipher_suite;             // 暗号スイート
+        cJSON* ps_tx_window;                // 送信ウィンドウサイズ
+        cJSON* ps_compress;                 // 本文の圧縮の有無
+        cJSON* ps_content;                  // 暗号文のコンテンツ種別の有無
         int i_idx;
         for (i_idx = 0; i_idx < i_list_size; i_idx++) {
             // チケット要素
@@ -1645,6 +1669,35 @@ static bool b_read_ticket_file() {
             if (!b_vutil_dec_string(ps_rx_seq_no->valuestring, 10)) {
                 break;
             }
+            // メッセージ認証モード（旧形式のチケットは互換モード）
+            ps_auth_mode = cJSON_GetObjectItem(ps_ticket_elm, COM_TICKET_AUTH_MODE);
+            if (ps_auth_mode != NULL && (!b_vutil_dec_string(ps_auth_mode->valuestring, 3) ||
+                u32_vutil_to_numeric(ps_auth_mode->valuestring) >= COM_BLE_MSG_AUTH_CNT)) {
+                break;
+            }
+            // 暗号スイート（旧形式のチケットは互換モード）
+            ps_cipher_suite = cJSON_GetObjectItem(ps_ticket_elm, COM_TICKET_CIPHER);
+            if (ps_cipher_suite != NULL && (!b_vutil_dec_string(ps_cipher_suite->valuestring, 3) ||
+                u32_vutil_to_numeric(ps_cipher_suite->valuestring) >= COM_BLE_MSG_CIPHER_CNT)) {
+                break;
+            }
+            // 送信ウィンドウサイズ（旧形式のチケットはストップアンドウェイト）
+            ps_tx_window = cJSON_GetObjectItem(ps_ticket_elm, COM_TICKET_TX_WINDOW);
+            if (ps_tx_window != NULL && (!b_vutil_dec_string(ps_tx_window->valuestring, 3) ||
+                u32_vutil_to_numeric(ps_tx_window->valuestring) < 1 ||
+                u32_vutil_to_numeric(ps_tx_window->valuestring) > COM_MSG_TX_WINDOW_MAX)) {
+                break;
+            }
+            // 本文の圧縮の有無（旧形式のチケットは圧縮無し）
+            ps_compress = cJSON_GetObjectItem(ps_ticket_elm, COM_TICKET_COMPRESS);
+            if (ps_compress != NULL && !b_vutil_dec_string(ps_compress->valuestring, 1)) {
+                break;
+            }
+            // 暗号文のコンテンツ種別の有無（旧形式のチケットは種別無し）
+            ps_content = cJSON_GetObjectItem(ps_ticket_elm, COM_TICKET_CONTENT);
+            if (ps_content != NULL && !b_vutil_dec_string(ps_content->valuestring, 1)) {
+                break;
+            }
             // チケット生成
             ps_ticket_node_bef = ps_ticket_node_tgt;
             ps_ticket_node_tgt = pv_mem_malloc(sizeof(ts_ticket_node_t));
@@ -1672,6 +1725,25 @@ static bool b_read_ticket_file() {
             ps_ticket_edit->u32_tx_seq_no = u32_vutil_to_numeric(ps_tx_seq_no->valuestring);
             // 受信シーケンス番号
             ps_ticket_edit->u32_rx_seq_no = u32_vutil_to_numeric(ps_rx_seq_no->valuestring);
+            // メッセージ認証モード
+            ps_ticket_edit->e_auth_mode = COM_BLE_MSG_AUTH_HASH;
+            if (ps_auth_mode != NULL) {
+                ps_ticket_edit->e_auth_mode = (te_com_ble_msg_auth_mode_t)u32_vutil_to_numeric(ps_auth_mode->valuestring);
+            }
+            // 暗号スイート
+            ps_ticket_edit->e_cipher_suite = COM_BLE_MSG_CIPHER_AES_GCM;
+            if (ps_cipher_suite != NULL) {
+                ps_ticket_edit->e_cipher_suite = (te_com_ble_msg_cipher_suite_t)u32_vutil_to_numeric(ps_cipher_suite->valuestring);
+            }
+            // 送信ウィンドウサイズ
+            ps_ticket_edit->u8_tx_window = 1;
+            if (ps_tx_window != NULL) {
+                ps_ticket_edit->u8_tx_window = (uint8_t)u32_vutil_to_numeric(ps_tx_window->valuestring);
+            }
+            // 本文の圧縮の有無
+            ps_ticket_edit->b_compress = (ps_compress != NULL && u32_vutil_to_numeric(ps_compress->valuestring) != 0);
+            // 暗号文のコンテンツ種別の有無
+            ps_ticket_edit->b_content = (ps_content != NULL && u32_vutil_to_numeric(ps_content->valuestring) != 0);
             // 次のチケットを初期化
             ps_ticket_node_tgt->ps_next = NULL;
         }
@@ -1815,6 +1887,21 @@ static bool b_write_ticket_file() {
             // 受信シーケンス番号
             b_vutil_edit_dec_string(c_wk_edit, ps_ticket->u32_rx_seq_no);
             cJSON_AddStringToObject(ps_ticket_elm, COM_TICKET_RX_SEQ, c_wk_edit);
+            // メッセージ認証モード
+            b_vutil_edit_dec_string(c_wk_edit, ps_ticket->e_auth_mode);
+            cJSON_AddStringToObject(ps_ticket_elm, COM_TICKET_AUTH_MODE, c_wk_edit);
+            // 暗号スイート
+            b_vutil_edit_dec_string(c_wk_edit, ps_ticket->e_cipher_suite);
+            cJSON_AddStringToObject(ps_ticket_elm, COM_TICKET_CIPHER, c_wk_edit);
+            // 送信ウィンドウサイズ
+            b_vutil_edit_dec_string(c_wk_edit, ps_ticket->u8_tx_window);
+            cJSON_AddStringToObject(ps_ticket_elm, COM_TICKET_TX_WINDOW, c_wk_edit);
+            // 本文の圧縮の有無
+            b_vutil_edit_dec_string(c_wk_edit, ps_ticket->b_compress ? 1 : 0);
+            cJSON_AddStringToObject(ps_ticket_elm, COM_TICKET_COMPRESS, c_wk_edit);
+            // 暗号文のコンテンツ種別の有無
+            b_vutil_edit_dec_string(c_wk_edit, ps_ticket->b_content ? 1 : 0);
+            cJSON_AddStringToObject(ps_ticket_elm, COM_TICKET_CONTENT, c_wk_edit);
             // チケットを追加
             cJSON_AddItemToArray(ps_ticket_list, ps_ticket_elm);
 
@@ -2940,7 +3027,7 @@ static bool b_evt_chk_timeout() {
     //==========================================================================
     // タイムアウト判定
     //==========================================================================
-    bool b_timeout = (s_com_status.i64_timeout_ms < xTaskGetTickCountMSec());
+    bool b_timeout = s_com_status.b_timeout;
 
     //==========================================================================
     // クリティカルセクション終了
@@ -2963,7 +3050,7 @@ static bool b_evt_chk_timeout() {
  * RETURNS:
  *
  * NOTES:複数のイベントソースに対応するために排他制御を行う
- * None.
+ * タイムアウトはタイマーサービスのワンショットタイマーで検知する。
  ******************************************************************************/
 static void v_evt_set_timeout(int64_t i64_timeout_ms) {
     //==========================================================================
@@ -2976,7 +3063,12 @@ static void v_evt_set_timeout(int64_t i64_timeout_ms) {
     //==========================================================================
     // タイムアウト設定
     //==========================================================================
-    s_com_status.i64_timeout_ms = xTaskGetTickCountMSec() + i64_timeout_ms;
+    // 設定中のタイマーを停止し、世代を更新して再設定
+    sts_tmw_stop(&s_com_status.s_timeout_timer);
+    s_com_status.u32_timeout_gen++;
+    s_com_status.b_timeout = false;
+    v_tmw_init_timer(&s_com_status.s_timeout_timer, v_evt_timeout_cb, (void*)(uintptr_t)s_com_status.u32_timeout_gen);
+    sts_tmw_start(&s_com_status.s_timeout_timer, (uint32_t)i64_timeout_ms, 0);
 
     //==========================================================================
     // クリティカルセクション終了
@@ -3008,7 +3100,10 @@ static void v_evt_clear_timeout() {
     //==========================================================================
     // タイムアウト設定
     //==========================================================================
-    s_com_status.i64_timeout_ms = MAX_VALUE_INT64;
+    // タイマーを停止し、停止前に満了したタイマーを無効化
+    sts_tmw_stop(&s_com_status.s_timeout_timer);
+    s_com_status.u32_timeout_gen++;
+    s_com_status.b_timeout = false;
 
     //==========================================================================
     // クリティカルセクション終了
@@ -3016,6 +3111,28 @@ static void v_evt_clear_timeout() {
     xSemaphoreGiveRecursive(s_mutex);
 }
 
+/*******************************************************************************
+ *
+ * NAME: v_evt_timeout_cb
+ *
+ * DESCRIPTION:タイムアウトタイマーのコールバック
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   void*          pv_arg          R   設定時のタイムアウトの世代
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * タイマーサービスタスクから呼び出される。
+ * タイマーサービスを停止させない様にミューテックスは取得せず、フラグの設定のみ行う。
+ * 設定後に停止や再設定されたタイマーの満了は世代の不一致で無視する。
+ ******************************************************************************/
+static void v_evt_timeout_cb(void* pv_arg) {
+    if ((uint32_t)(uintptr_t)pv_arg == s_com_status.u32_timeout_gen) {
+        s_com_status.b_timeout = true;
+    }
+}
+
 /*******************************************************************************
  *
  * NAME: v_upd_link_sts
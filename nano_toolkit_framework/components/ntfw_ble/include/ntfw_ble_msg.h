@@ -134,16 +134,81 @@ extern "C" {
     #define COM_MSG_AUTH_CHECK_VALUE    (0xA5)
 #endif
 
+/** ペアリング時に提案するメッセージ認証モード（HMACはv_com_msg_config_auth_modeで選択） */
+#ifndef COM_MSG_AUTH_MODE_DEFAULT
+    #define COM_MSG_AUTH_MODE_DEFAULT   (COM_BLE_MSG_AUTH_HASH)
+#endif
+
+/** ペアリング時に提案する暗号スイート */
+#ifndef COM_MSG_CIPHER_SUITE_DEFAULT
+    #define COM_MSG_CIPHER_SUITE_DEFAULT    (COM_BLE_MSG_CIPHER_AES_GCM)
+#endif
+
 /** 受信キューサイズ */
 #ifndef COM_MSG_RX_QUEUE_SIZE
     #define COM_MSG_RX_QUEUE_SIZE   (32)
 #endif
 
+/** 受信フレーム数（受信キューとアプリが保持中の受信メッセージの本文を格納） */
+#ifndef COM_MSG_RX_FRAME_COUNT
+    #define COM_MSG_RX_FRAME_COUNT  (4)
+#endif
+
 /** イベントキューサイズ */
 #ifndef COM_MSG_EVT_QUEUE_SIZE
     #define COM_MSG_EVT_QUEUE_SIZE  (32)
 #endif
 
+/** 送信ウィンドウの最大サイズ（応答待ちの暗号文メッセージ数） */
+#ifndef COM_MSG_TX_WINDOW_MAX
+    #define COM_MSG_TX_WINDOW_MAX   (8)
+#endif
+
+/** ペアリング時に提案する送信ウィンドウサイズ（1:ストップアンドウェイト） */
+#ifndef COM_MSG_TX_WINDOW_DEFAULT
+    #define COM_MSG_TX_WINDOW_DEFAULT   (1)
+#endif
+
+/** 送信ウィンドウの空き待ちタイムアウト */
+#ifndef COM_MSG_TX_WINDOW_TIMEOUT
+    #define COM_MSG_TX_WINDOW_TIMEOUT   (3000 / portTICK_PERIOD_MS)
+#endif
+
+/** 再送タイムアウト（ミリ秒） */
+#ifndef COM_MSG_TX_RETX_TIMEOUT_MS
+    #define COM_MSG_TX_RETX_TIMEOUT_MS  (1000)
+#endif
+
+/** 最大再送回数 */
+#ifndef COM_MSG_TX_RETX_MAX_CNT
+    #define COM_MSG_TX_RETX_MAX_CNT     (3)
+#endif
+
+/** バッチ送信の最大遅延時間（ミリ秒） */
+#ifndef COM_MSG_BATCH_DELAY_MS
+    #define COM_MSG_BATCH_DELAY_MS      (20)
+#endif
+
+/** バッチ送信の最大サイズ（0:暗号メッセージの平文の最大サイズ） */
+#ifndef COM_MSG_BATCH_MAX_SIZE
+    #define COM_MSG_BATCH_MAX_SIZE      (0)
+#endif
+
+/** チケットの送信シーケンス番号の予約ブロックサイズ（1:送信毎にチケットを更新） */
+#ifndef COM_MSG_TICKET_SEQ_BLOCK
+    #define COM_MSG_TICKET_SEQ_BLOCK    (16)
+#endif
+
+/** チケットの受信シーケンス番号の遅延更新時間（ミリ秒、0:受信毎にチケットを更新） */
+#ifndef COM_MSG_TICKET_FLUSH_MS
+    #define COM_MSG_TICKET_FLUSH_MS     (0)
+#endif
+
+/** チケットキャッシュのエントリ数（リモートデバイスチケット以外） */
+#ifndef COM_MSG_TICKET_CACHE_SIZE
+    #define COM_MSG_TICKET_CACHE_SIZE   (4)
+#endif
+
 /******************************************************************************/
 /***      Type Definitions                                                  ***/
 /******************************************************************************/
@@ -167,6 +232,34 @@ typedef enum {
     COM_BLE_MSG_TYP_CNT                 // メッセージタイプ数
 } te_com_ble_msg_type_t;
 
+/**
+ * 暗号文のコンテンツ種別（ペアリング時に合意した場合のみ付与）
+ */
+typedef enum {
+    COM_BLE_MSG_CONTENT_APP = 0x00,     // アプリケーションデータ
+    COM_BLE_MSG_CONTENT_STREAM,         // ストリームのフレーム
+    COM_BLE_MSG_CONTENT_BATCH,          // バッチ送信のコンテナ
+    COM_BLE_MSG_CONTENT_CNT             // コンテンツ種別数
+} te_com_ble_msg_content_t;
+
+/**
+ * メッセージ認証モード
+ */
+typedef enum {
+    COM_BLE_MSG_AUTH_HASH = 0x00,       // ハッシュストレッチング（互換モード）
+    COM_BLE_MSG_AUTH_HMAC,              // HMAC-SHA256（暗号鍵から導出した認証鍵）
+    COM_BLE_MSG_AUTH_CNT                // 認証モード数
+} te_com_ble_msg_auth_mode_t;
+
+/**
+ * 暗号スイート（暗号文メッセージ）
+ */
+typedef enum {
+    COM_BLE_MSG_CIPHER_AES_GCM = 0x00,      // AES-256-GCM（互換モード）
+    COM_BLE_MSG_CIPHER_CHACHA20_POLY1305,   // ChaCha20-Poly1305
+    COM_BLE_MSG_CIPHER_CNT                  // 暗号スイート数
+} te_com_ble_msg_cipher_suite_t;
+
 /**
  * 接続ステータス
  */
@@ -222,6 +315,7 @@ typedef enum {
     COM_BLE_MSG_EVT_STATUS_ERR,             // ステータス異常
     COM_BLE_MSG_EVT_STATUS_TIMEOUT,         // ステータスチェックタイムアウト
     COM_BLE_MSG_EVT_HANDLING_ERR,           // メッセージハンドリングエラー
+    COM_BLE_MSG_EVT_TX_TIMEOUT,             // 送信タイムアウト（最大再送回数超過）
     COM_BLE_MSG_EVT_COUNT                   // コールバックイベント数
 } te_com_ble_msg_event;
 
@@ -233,6 +327,7 @@ typedef struct {
     uint32_t u32_rcv_tick_ms;                           // 受信ティック（ミリ秒）
     uint64_t u64_device_id;                             // デバイスID
     te_com_ble_msg_type_t e_type;                       // メッセージタイプ
+    te_com_ble_msg_content_t e_content;                 // 暗号文のコンテンツ種別
     uint16_t u16_length;                                // メッセージ長
     uint32_t u32_seq_no;                                // シーケンス番号
     uint8_t u8_auth_tag[COM_MSG_SIZE_AUTH_TAG];         // 認証タグ
@@ -251,6 +346,11 @@ typedef struct {
     uint32_t u32_max_seq_no;                            // 最大シーケンス番号
     uint32_t u32_tx_seq_no;                             // 送信シーケンス番号
     uint32_t u32_rx_seq_no;                             // 受信シーケンス番号
+    te_com_ble_msg_auth_mode_t e_auth_mode;             // メッセージ認証モード
+    te_com_ble_msg_cipher_suite_t e_cipher_suite;       // 暗号スイート
+    uint8_t u8_tx_window;                               // 送信ウィンドウサイズ（1:ストップアンドウェイト）
+    bool b_compress;                                    // 本文の圧縮の有無
+    bool b_content;                                     // 暗号文のコンテンツ種別の有無
 } ts_com_msg_auth_ticket_t;
 
 /**
@@ -263,6 +363,12 @@ typedef esp_err_t (*tf_com_ble_msg_ticket_cb_t)(te_com_ble_msg_ticket_evt_t e_ev
  */
 typedef void (*tf_com_ble_msg_evt_cb_t)(te_com_ble_msg_event e_msg_evt);
 
+/**
+ * 暗号メッセージの受信フィルター関数
+ * ※trueを返した場合はメッセージを消費したものとし（本文データの所有権も移る）、受信キューに投入しない
+ */
+typedef bool (*tf_com_ble_msg_rx_filter_t)(ts_com_msg_t* ps_msg);
+
 
 /******************************************************************************/
 /***      Exported Variables                                                ***/
@@ -291,6 +397,24 @@ extern void v_com_msg_rx_disabled(te_com_ble_msg_type_t e_type);
 extern void v_com_msg_config_pairing(bool b_enabled);
 /** ステータスチェック機能の設定 */
 extern void v_com_msg_config_sts_chk(bool b_enabled);
+/** メッセージ認証モードの設定（ペアリング時に提案するモード） */
+extern void v_com_msg_config_auth_mode(te_com_ble_msg_auth_mode_t e_mode);
+/** 暗号スイートの設定（ペアリング時に提案する暗号スイート） */
+extern void v_com_msg_config_cipher_suite(te_com_ble_msg_cipher_suite_t e_suite);
+/** 送信ウィンドウサイズの設定（ペアリング時に提案するサイズ） */
+extern void v_com_msg_config_tx_window(uint8_t u8_window);
+/** 暗号メッセージの受信フィルターの設定（NULL:フィルター無し） */
+extern void v_com_msg_config_rx_filter(tf_com_ble_msg_rx_filter_t pf_filter);
+/** バッチ送受信の設定（送信側と受信側の双方で有効化する事） */
+extern void v_com_msg_config_batch(bool b_enabled, uint32_t u32_delay_ms, uint16_t u16_max_size);
+/** 本文の圧縮の設定（ペアリング時に提案し、双方が有効な場合のみ圧縮） */
+extern void v_com_msg_config_compress(bool b_enabled);
+/** 暗号文のコンテンツ種別の設定（ペアリング時に提案し、双方が有効な場合のみ付与） */
+extern void v_com_msg_config_content(bool b_enabled);
+/** チケット更新の設定（送信シーケンス番号の予約ブロックサイズ、受信シーケンス番号の遅延更新時間） */
+extern void v_com_msg_config_ticket_update(uint32_t u32_seq_block, uint32_t u32_flush_ms);
+/** 暗号メッセージ１件で送信可能な平文の最大サイズ */
+extern uint32_t u32_com_msg_max_cipher_size();
 /** ペアリングの有効判定 */
 extern bool b_com_msg_is_paired(uint64_t u64_device_id);
 /** 接続ステータス取得 */
@@ -321,14 +445,28 @@ extern esp_err_t sts_com_msg_tx_pairing_certification(bool b_result, uint32_t u3
 extern esp_err_t sts_com_msg_tx_sts_chk_request();
 /** 平文メッセージの送信処理 */
 extern esp_err_t sts_com_msg_tx_plain_msg(uint64_t u64_device_id, ts_u8_array_t* ps_data);
-/** 暗号メッセージの送信処理 */
+/** 暗号メッセージの送信処理（チケットアクセスコールバック内からは呼び出し不可） */
 extern esp_err_t sts_com_msg_tx_cipher_msg(uint64_t u64_device_id, ts_u8_array_t* ps_data);
+/** コンテンツ種別を指定した暗号メッセージの送信処理（チケットアクセスコールバック内からは呼び出し不可） */
+extern esp_err_t sts_com_msg_tx_cipher_content(uint64_t u64_device_id,
+                                               te_com_ble_msg_content_t e_content,
+                                               ts_u8_array_t* ps_data);
+/** 暗号メッセージのバッチ送信処理（遅延時間内の送信を１件の暗号メッセージに集約） */
+extern esp_err_t sts_com_msg_tx_cipher_batch(uint64_t u64_device_id, ts_u8_array_t* ps_data);
+/** バッチ送信待ちの暗号メッセージの送信処理 */
+extern esp_err_t sts_com_msg_flush_batch();
 /** メッセージの削除処理 */
 extern esp_err_t sts_com_msg_delete_msg(ts_com_msg_t* ps_msg);
+/** 受信メッセージ本文の削除処理（受信フレームの返却） */
+extern esp_err_t sts_com_msg_delete_data(ts_u8_array_t* ps_data);
 /** チケットの削除処理 */
 extern esp_err_t sts_com_msg_delete_ticket(uint64_t u64_device_id);
 /** チケットステータスのクリア処理 */
 extern esp_err_t sts_com_msg_clear_status(uint64_t u64_device_id);
+/** 遅延中のチケット更新の書き込み */
+extern esp_err_t sts_com_msg_flush_ticket();
+/** キャッシュ中のチケットの破棄処理 */
+extern esp_err_t sts_com_msg_invalidate_ticket(uint64_t u64_device_id);
 
 #if defined __cplusplus
 }
@@ -0,0 +1,128 @@
+/*******************************************************************************
+ *
+ * COMPONENT:Nano Toolkit Framework
+ *
+ * MODULE :BLE message stream function header file
+ *
+ * CREATED:2024/11/24 10:00:00
+ * AUTHOR :Kakuheiki.Nakanohito
+ *
+ * DESCRIPTION:セキュアメッセージング（暗号メッセージ）上のバルク転送ストリーム
+ *   送信側はオープン、書き込み、クローズで任意サイズのデータを送信し、
+ *   受信側はオフセット付きのコールバックで受信する。
+ *   データは最大メッセージサイズに合わせて自動で分割し、受信側のクレジットによるフロー制御を行う。
+ *   切断後は同一のストリームIDでオープンする事で受信済みのオフセットから再開出来る。
+ *   フレームは暗号メッセージのコンテンツ種別で判別するので、ペアリング時に双方で合意している事。
+ *
+ * CHANGE HISTORY:
+ *
+ * LAST MODIFIED BY:
+ *
+ *******************************************************************************
+ *
+ * Copyright (c) 2024 Kakuheiki.Nakanohito
+ * Released under the MIT license
+ * https://opensource.org/licenses/mit-license.php
+ *
+ ******************************************************************************/
+#ifndef  __NTFW_BLE_STREAM_H__
+#define  __NTFW_BLE_STREAM_H__
+
+#if defined __cplusplus
+extern "C" {
+#endif
+
+/******************************************************************************/
+/***      Include files                                                     ***/
+/******************************************************************************/
+#include <stdio.h>
+#include <stdbool.h>
+#include <esp_system.h>
+#include <ntfw_ble_msg.h>
+
+/******************************************************************************/
+/***      Macro Definitions                                                 ***/
+/******************************************************************************/
+/** ストリーム受信デーモンタスクのスタックの深さ */
+#ifndef COM_STREAM_DEAMON_STACK_DEPTH
+    #define COM_STREAM_DEAMON_STACK_DEPTH   (4096)
+#endif
+
+/** ストリーム受信デーモンタスクの優先度 */
+#ifndef COM_STREAM_DEAMON_PRIORITIES
+    #define COM_STREAM_DEAMON_PRIORITIES    (configMAX_PRIORITIES - 4)
+#endif
+
+/** 受信クレジット（確認応答無しで送信可能なフラグメント数）※確認応答の間隔以上とする事 */
+#ifndef COM_STREAM_RX_CREDIT
+    #define COM_STREAM_RX_CREDIT    (8)
+#endif
+
+/** 確認応答の間隔（受信フラグメント数） */
+#ifndef COM_STREAM_ACK_INTERVAL
+    #define COM_STREAM_ACK_INTERVAL (4)
+#endif
+
+/** ストリーム受信キューサイズ */
+#ifndef COM_STREAM_RX_QUEUE_SIZE
+    #define COM_STREAM_RX_QUEUE_SIZE    (COM_STREAM_RX_CREDIT + 4)
+#endif
+
+/** 確認応答待ちタイムアウト */
+#ifndef COM_STREAM_ACK_TIMEOUT
+    #define COM_STREAM_ACK_TIMEOUT  (5000 / portTICK_PERIOD_MS)
+#endif
+
+/******************************************************************************/
+/***      Type Definitions                                                  ***/
+/******************************************************************************/
+/**
+ * ストリーム受信イベント
+ */
+typedef enum {
+    COM_STREAM_EVT_OPEN = 0,    // オープン（u32_offset:再開オフセット、t_len:総サイズ）
+    COM_STREAM_EVT_DATA,        // データ受信（u32_offset:データの先頭オフセット）
+    COM_STREAM_EVT_CLOSE,       // クローズ（u32_offset:総受信サイズ）
+    COM_STREAM_EVT_ABORT,       // 中断（u32_offset:受信済みサイズ）
+} te_com_stream_evt_t;
+
+/**
+ * ストリーム受信コールバック関数
+ */
+typedef void (*tf_com_stream_rx_cb_t)(te_com_stream_evt_t e_evt,
+                                      uint64_t u64_device_id,
+                                      uint8_t u8_stream_id,
+                                      uint32_t u32_offset,
+                                      const uint8_t* pu8_data,
+                                      size_t t_len);
+
+/******************************************************************************/
+/***      Exported Variables                                                ***/
+/******************************************************************************/
+
+/******************************************************************************/
+/***      Exported Function Prototypes                                      ***/
+/******************************************************************************/
+/** ストリームの初期処理（メッセージの初期処理後、ペアリング前に呼び出す事） */
+extern esp_err_t sts_com_stream_init(tf_com_stream_rx_cb_t pf_rx_cb);
+/** 送信ストリームのオープン（再開時は受信済みのオフセットを返す） */
+extern esp_err_t sts_com_stream_open(uint64_t u64_device_id,
+                                     uint8_t u8_stream_id,
+                                     uint32_t u32_size,
+                                     uint32_t* pu32_offset);
+/** 送信ストリームへの書き込み */
+extern esp_err_t sts_com_stream_write(const uint8_t* pu8_data, size_t t_len);
+/** 送信ストリームのクローズ（全データの確認応答まで待機） */
+extern esp_err_t sts_com_stream_close();
+/** 送信ストリームの中断 */
+extern esp_err_t sts_com_stream_abort();
+
+#if defined __cplusplus
+}
+#endif
+
+#endif  /* __NTFW_BLE_STREAM_H__ */
+
+/******************************************************************************/
+/***      END OF FILE                                                       ***/
+/******************************************************************************/
@@ -33,6 +33,8 @@
 #include <ntfw_com_value_util.h>
 #include <ntfw_com_date_time.h>
 #include <ntfw_com_debug_util.h>
+#include <ntfw_com_timer_wheel.h>
+#include <ntfw_com_lz.h>
 #include <ntfw_cryptography.h>
 
 /******************************************************************************/
@@ -66,6 +68,42 @@
 #define MSG_SIZE_CHECK_CODE (32)
 /** check random number length */
 #define MSG_SIZE_CHECK_RANDOM   (32)
+/** auth mode length (pairing request/response extension) */
+#define MSG_SIZE_AUTH_MODE  (1)
+/** pairing extension:auth mode (lower 4bit) */
+#define MSG_EXT_AUTH_MODE(v)    ((v) & 0x0F)
+/** pairing extension:cipher suite (upper 4bit) */
+#define MSG_EXT_CIPHER(v)       (((v) >> 4) & 0x0F)
+/** pairing extension value */
+#define MSG_EXT_VALUE(auth, cipher) ((uint8_t)(((cipher) << 4) | (auth)))
+/** tx window length (pairing request/response extension) */
+#define MSG_SIZE_TX_WINDOW  (1)
+/** pairing extension:tx window (lower 6bit) */
+#define MSG_EXT_TX_WINDOW(v)    ((v) & 0x3F)
+/** pairing extension:compress flag */
+#define MSG_EXT_COMPRESS    (0x80)
+/** pairing extension:content type flag */
+#define MSG_EXT_CONTENT     (0x40)
+/** content type length (ciphertext body) */
+#define MSG_SIZE_CONTENT_TYPE   (1)
+/** compress header length (compress type) */
+#define MSG_SIZE_COMPRESS_TYPE  (1)
+/** compress header length (original length) */
+#define MSG_SIZE_COMPRESS_LEN   (2)
+/** compress type:raw */
+#define MSG_COMPRESS_TYPE_RAW   (0x00)
+/** compress type:LZ */
+#define MSG_COMPRESS_TYPE_LZ    (0x01)
+/** cumulative ack length (response extension) */
+#define MSG_SIZE_CUM_ACK    (4)
+/** batch container header length (count) */
+#define MSG_SIZE_BATCH_HEADER   (1)
+/** batch element header length (element length) */
+#define MSG_SIZE_BATCH_ELEMENT  (2)
+/** batch element max count */
+#define MSG_BATCH_MAX_CNT   (0xff)
+/** auth key derivation label */
+#define MSG_AUTH_KEY_LABEL  "ntfw_ble_msg:auth"
 
 /** Receive message device id position */
 #define MSG_POS_DEVICE_ID   (0)
@@ -79,6 +117,8 @@
 #define MSG_POS_AUTH_TAG    (15)
 /** message body position */
 #define MSG_POS_BODY        (47)
+/** response cumulative ack position */
+#define MSG_POS_RSP_CUM_ACK (MSG_POS_BODY + 2)
 /** status response 1 random position */
 #define MSG_POS_STS_RSP1_RND    (MSG_POS_BODY + MSG_SIZE_CHECK_CODE)
 /** plain data position */
@@ -128,6 +168,9 @@ typedef enum {
     COM_BLE_MSG_RCV_HANDLING_ERR,       // 受信ハンドリングエラー
     COM_BLE_MSG_RCV_TIMEOUT_ERR,        // 受信タイムアウト
     COM_BLE_MSG_RCV_ADDRESS_ERR,        // 受信アドレスエラー
+    COM_BLE_MSG_RCV_DUPLICATE,          // 重複受信（再送された受信済みメッセージ）
+    COM_BLE_MSG_RCV_DECOMPRESS_ERR,     // 本文の伸長エラー
+    COM_BLE_MSG_RCV_OUT_OF_ORDER,       // 順序外受信（欠番より後の暗号文）
 } te_com_ble_msg_rcv_sts_t;
 
 /**
@@ -136,6 +179,9 @@ typedef enum {
 typedef enum {
     MSG_FUNC_CTL_PAIRING = 0x01,            // ペアリング有効
     MSG_FUNC_CTL_STS_CHK = 0x02,            // ステータスチェック有効
+    MSG_FUNC_CTL_BATCH   = 0x04,            // バッチ送受信有効
+    MSG_FUNC_CTL_COMPRESS = 0x08,           // 本文の圧縮有効
+    MSG_FUNC_CTL_CONTENT = 0x10,            // 暗号文のコンテンツ種別有効
 } te_msg_function_ctrl_t;
 
 /**
@@ -221,8 +267,94 @@ typedef struct {
     uint8_t u8_dev_status[COM_MSG_SIZE_TICKET_STS];     // 自デバイスステータス
     uint8_t u8_rmt_sts_hash[COM_MSG_SIZE_TICKET_STS];   // 相手デバイスステータスハッシュ
     uint32_t u32_max_seq_no;                            // 最大シーケンス番号
+    bool b_auth_ext;                                    // 認証モード拡張の有無
+    te_com_ble_msg_auth_mode_t e_auth_mode;             // メッセージ認証モード
+    te_com_ble_msg_cipher_suite_t e_cipher_suite;       // 暗号スイート
+    bool b_win_ext;                                     // 送信ウィンドウ拡張の有無
+    uint8_t u8_tx_window;                               // 送信ウィンドウサイズ
+    bool b_compress;                                    // 本文の圧縮の有無
+    bool b_content;                                     // 暗号文のコンテンツ種別の有無
 } ts_pairing_info_t;
 
+/**
+ * セッション暗号コンテキスト（切断まで保持）
+ */
+typedef struct {
+    bool b_auth_ready;                                  // HMACコンテキスト初期化済みフラグ
+    uint8_t u8_auth_src_key[COM_MSG_SIZE_CIPHER_KEY];   // 認証鍵の導出元の暗号鍵
+    ts_crypto_hmac_context_t s_hmac_ctx;                // HMACコンテキスト（認証鍵）
+    uint8_t u8_gcm_key[COM_MSG_SIZE_CIPHER_KEY];        // GCMコンテキストの暗号鍵
+    ts_crypto_gcm_context_t s_gcm_ctx;                  // GCMコンテキスト（鍵スケジュール展開済み）
+} ts_msg_session_ctx_t;
+
+/**
+ * バッチ送信待ちの暗号メッセージ（集約用コンテナ）
+ */
+typedef struct {
+    uint64_t u64_device_id;                             // 送信先デバイスID
+    uint8_t u8_count;                                   // 集約したメッセージ数
+    ts_u8_array_t* ps_container;                        // コンテナ（t_sizeは確保サイズ）
+    uint16_t u16_length;                                // コンテナの使用サイズ
+} ts_msg_batch_t;
+
+/**
+ * チケット更新の遅延状態（リモートデバイスチケットのキャッシュの書き込み状況）
+ */
+typedef struct {
+    bool b_valid;                                       // 有効フラグ
+    uint64_t u64_device_id;                             // 対象デバイスID
+    uint32_t u32_tx_reserved;                           // 書き込み済みの送信シーケンス番号（予約ブロックの上限）
+    uint32_t u32_rx_flushed;                            // 書き込み済みの受信シーケンス番号
+} ts_msg_ticket_persist_t;
+
+/**
+ * チケットキャッシュのエントリ
+ */
+typedef struct {
+    ts_com_msg_auth_ticket_t s_ticket;                  // チケット
+    ts_msg_ticket_persist_t s_persist;                  // チケット更新の遅延状態（b_valid:使用中）
+    uint32_t u32_last_ref;                              // 最終参照カウンタ
+} ts_msg_ticket_entry_t;
+
+/**
+ * チケットキャッシュ（リモートデバイスチケット以外の直近に参照したチケット）
+ */
+typedef struct {
+    uint32_t u32_ref_cnt;                               // 参照カウンタ
+    ts_msg_ticket_entry_t s_entry[COM_MSG_TICKET_CACHE_SIZE];   // エントリ
+} ts_msg_ticket_cache_t;
+
+/**
+ * 送信ウィンドウのスロット（応答待ちの暗号文メッセージ）
+ */
+typedef struct {
+    uint32_t u32_seq_no;                                // シーケンス番号
+    uint32_t u32_tx_tick_ms;                            // 送信ティック（ミリ秒）
+    uint8_t u8_retry;                                   // 再送回数
+    bool b_acked;                                       // 応答受信済みフラグ
+    ts_u8_array_t* ps_msg;                              // 送信メッセージ（再送用）
+} ts_msg_tx_slot_t;
+
+/**
+ * 送信ウィンドウ（シーケンス番号順のリングバッファ）
+ */
+typedef struct {
+    uint8_t u8_head;                                    // 先頭スロット
+    uint8_t u8_count;                                   // 使用中のスロット数
+    ts_msg_tx_slot_t s_slot[COM_MSG_TX_WINDOW_MAX];     // スロット
+} ts_msg_tx_window_t;
+
+/**
+ * 受信メッセージの逐次認証コンテキスト（1メッセージの受信中のみ保持）
+ */
+typedef struct {
+    bool b_ready;                                       // 初期化済みフラグ
+    bool b_hmac;                                        // HMACモード判定
+    ts_crypto_hmac_context_t s_hmac_ctx;                // HMACコンテキスト（セッションの複製）
+    ts_crypto_hash_context_t s_hash_ctx;                // ハッシュコンテキスト（互換モード）
+    uint32_t u32_pos;                                   // 計算済みのメッセージ上の位置
+} ts_msg_rx_auth_t;
+
 /**
  * ステータスチェック情報
  */
@@ -270,6 +402,13 @@ typedef struct {
     uint16_t u16_app_id;                    // アプリケーションID
     uint64_t u64_device_id;                 // 自デバイスID
     te_msg_function_ctrl_t s_func_ctl;      // 機能制御
+    te_com_ble_msg_auth_mode_t e_auth_mode; // メッセージ認証モード
+    te_com_ble_msg_cipher_suite_t e_cipher_suite;   // 暗号スイート
+    uint8_t u8_tx_window;                   // 送信ウィンドウサイズ
+    uint32_t u32_batch_delay_ms;            // バッチ送信の最大遅延時間（ミリ秒）
+    uint16_t u16_batch_max_size;            // バッチ送信の最大サイズ
+    uint32_t u32_tkt_seq_block;             // チケットの送信シーケンス番号の予約ブロックサイズ
+    uint32_t u32_tkt_flush_ms;              // チケットの受信シーケンス番号の遅延更新時間（ミリ秒）
     uint32_t u32_max_length;                // 最大メッセージサイズ
     tf_get_gatt_if_t pf_gatt_if;            // GATTインターフェース取得関数
     tf_connection_sts_t pf_connect_sts;     // 接続ステータス取得関数
@@ -279,6 +418,7 @@ typedef struct {
     tf_ble_rx_through_t pf_rx_through;      // 受信キュー読み飛ばし関数
     tf_com_ble_msg_ticket_cb_t pf_tkt_cb;   // チケットアクセスイベントコールバック関数
     tf_com_ble_msg_evt_cb_t pf_evt_cb;      // 受信イベントコールバック関数
+    tf_com_ble_msg_rx_filter_t pf_rx_filter;    // 暗号メッセージの受信フィルター関数
 } ts_msg_ctrl_cfg_t;
 
 /**
@@ -297,9 +437,25 @@ typedef struct {
     ts_transaction_info_t s_tran;           // トランザクション情報
     ts_pairing_info_t s_pairing;            // ペアリング情報
     ts_sts_check_info_t s_sts_chk;          // ステータスチェック情報
+    ts_msg_session_ctx_t s_session;         // セッション暗号コンテキスト
+    ts_msg_tx_window_t s_tx_window;         // 送信ウィンドウ
+    ts_msg_batch_t s_batch;                 // バッチ送信待ちの暗号メッセージ
+    ts_msg_ticket_persist_t s_tkt_persist;  // チケット更新の遅延状態
+    ts_msg_ticket_cache_t s_tkt_cache;      // チケットキャッシュ
+    bool b_rx_seq_sync;                     // 受信シーケンス番号の同期済み（接続毎）
     ts_com_ble_gattc_con_info_t* ps_con;    // BLEコネクション
 } ts_msg_ctrl_sts_t;
 
+/**
+ * 受信フレーム
+ */
+typedef struct {
+    bool b_used;                            // 使用中フラグ
+    uint8_t* pu8_buff;                      // メッセージ全体のバッファ（最大メッセージサイズ）
+    ts_u8_array_t s_data;                   // 本文のビュー（バッファ内を参照）
+    ts_com_msg_t s_msg;                     // 受信キューに投入するメッセージ
+} ts_msg_rx_frame_t;
+
 /**
  * デーモンタスク制御ステータス
  */
@@ -309,6 +465,12 @@ typedef struct {
     uint32_t u32_rx_enqueue_filter;         // 受信キューイングフィルタ
     TaskHandle_t s_evt_deamon_handle;       // イベント通知デーモンタスクハンドル
     QueueHandle_t s_evt_queue_handle;       // イベント通知キューハンドラ
+    ts_tmw_timer_t s_tran_timer;            // トランザクションタイムアウトタイマー
+    ts_tmw_timer_t s_retx_timer;            // 再送タイマー
+    ts_tmw_timer_t s_batch_timer;           // バッチ送信タイマー
+    ts_tmw_timer_t s_tkt_timer;             // チケット更新タイマー
+    SemaphoreHandle_t s_tx_window_sem;      // 送信ウィンドウの空き通知
+    ts_msg_rx_frame_t s_rx_frame[COM_MSG_RX_FRAME_COUNT];   // 受信フレームプール
 } ts_msg_deamon_sts_t;
 
 /******************************************************************************/
@@ -333,6 +495,8 @@ static void v_msg_ctrl_sts_connection_reset();
 static void v_msg_ctrl_sts_transaction_reset();
 /** message controller transaction timeout */
 static void v_msg_ctrl_sts_transaction_timeout();
+/** message controller transaction timer callback */
+static void v_msg_ctrl_sts_transaction_timer_cb(void* pv_arg);
 /** message history reset processing */
 static void v_msg_history_reset(ts_msg_history_t* ps_msg_history);
 /** BLE Client Get Connection */
@@ -366,13 +530,98 @@ static esp_err_t sts_begin_sts_chk();
 /** status code check */
 static esp_err_t sts_status_check(uint64_t u64_device_id, uint8_t* pu8_chk_code, ts_com_msg_auth_ticket_t* ps_ticket);
 /** encryption message */
-static esp_err_t sts_msg_encryption(ts_u8_array_t* ps_msg, uint16_t u16_data_len, uint8_t* pu8_key);
+static esp_err_t sts_msg_encryption(ts_u8_array_t* ps_msg, uint16_t u16_data_len, uint8_t* pu8_key, te_com_ble_msg_cipher_suite_t e_cipher_suite);
+/** edit ChaCha20 nonce */
+static void v_msg_edit_nonce(uint8_t* pu8_nonce, ts_msg_edit_iv_t* ps_edit_iv);
 /** decryption message */
-static ts_u8_array_t* ps_msg_decryption(ts_com_msg_t* ps_rx_msg, uint8_t* pu8_key);
+static esp_err_t sts_msg_decryption(ts_com_msg_t* ps_rx_msg, uint8_t* pu8_key, te_com_ble_msg_cipher_suite_t e_cipher_suite);
 /** BLE edit Rx message header */
 static te_com_ble_msg_rcv_sts_t e_edit_rx_header(ts_com_msg_t* ps_rx_msg, ts_com_ble_gatt_rx_data_t* ps_rx_data);
 /** edit auth tag */
-static esp_err_t sts_edit_auth_tag(uint8_t* pu8_tag, ts_u8_array_t* ps_msg);
+static esp_err_t sts_edit_auth_tag(uint8_t* pu8_tag, ts_u8_array_t* ps_msg, uint64_t u64_rmt_device_id);
+/** begin rx auth */
+static esp_err_t sts_rx_auth_begin(ts_msg_rx_auth_t* ps_auth, uint8_t u8_type, uint64_t u64_rmt_device_id);
+/** update rx auth */
+static esp_err_t sts_rx_auth_update(ts_msg_rx_auth_t* ps_auth, const uint8_t* pu8_data, size_t t_len);
+/** finish rx auth */
+static esp_err_t sts_rx_auth_finish(ts_msg_rx_auth_t* ps_auth, uint8_t* pu8_tag);
+/** free rx auth */
+static void v_rx_auth_free(ts_msg_rx_auth_t* ps_auth);
+/** auth HMAC context */
+static esp_err_t sts_auth_hmac_context(uint8_t u8_type, uint64_t u64_rmt_device_id, ts_crypto_hmac_context_t** pps_ctx);
+/** session GCM context */
+static ts_crypto_gcm_context_t* ps_session_gcm_context(uint8_t* pu8_key);
+/** clear session context */
+static void v_msg_session_clear();
+/** tx window size */
+static uint8_t u8_tx_window_size();
+/** content type agreement */
+static bool b_msg_content_enabled();
+/** acquire tx window */
+static esp_err_t sts_tx_window_acquire();
+/** push tx window */
+static esp_err_t sts_tx_window_push(ts_u8_array_t* ps_msg);
+/** tx window acknowledge */
+static void v_tx_window_ack(ts_com_msg_t* ps_rx_msg);
+/** clear tx window */
+static void v_tx_window_clear();
+/** tx window retransmit timer callback */
+static void v_tx_window_timer_cb(void* pv_arg);
+/** batch size limit */
+static uint32_t u32_msg_batch_limit();
+/** detach batch container */
+static ts_u8_array_t* ps_msg_batch_detach(uint64_t* pu64_device_id);
+/** send batch container */
+static esp_err_t sts_msg_batch_send(uint64_t u64_device_id, ts_u8_array_t* ps_container);
+/** batch timer callback */
+static void v_msg_batch_timer_cb(void* pv_arg);
+/** batch container validation */
+static bool b_msg_batch_is_container(ts_u8_array_t* ps_data);
+/** compress message body */
+static ts_u8_array_t* ps_msg_compress(ts_u8_array_t* ps_data);
+/** decompress message body */
+static esp_err_t sts_msg_decompress(ts_com_msg_t* ps_rx_msg);
+/** reset ticket update state */
+static void v_msg_ticket_persist_reset(ts_msg_ticket_persist_t* ps_persist, ts_com_msg_auth_ticket_t* ps_ticket);
+/** ticket update state */
+static ts_msg_ticket_persist_t* ps_msg_ticket_persist(ts_com_msg_auth_ticket_t* ps_ticket);
+/** write ticket */
+static esp_err_t sts_msg_ticket_write(ts_com_msg_auth_ticket_t* ps_ticket);
+/** update ticket tx sequence */
+static esp_err_t sts_msg_ticket_tx_update(ts_com_msg_auth_ticket_t* ps_ticket);
+/** update ticket rx sequence */
+static esp_err_t sts_msg_ticket_rx_update(ts_com_msg_auth_ticket_t* ps_ticket);
+/** flush ticket */
+static esp_err_t sts_msg_ticket_flush(ts_com_msg_auth_ticket_t* ps_ticket);
+/** flush all tickets */
+static esp_err_t sts_msg_ticket_flush_all();
+/** find ticket cache entry */
+static ts_msg_ticket_entry_t* ps_msg_ticket_cache_find(uint64_t u64_device_id);
+/** allocate ticket cache entry */
+static ts_msg_ticket_entry_t* ps_msg_ticket_cache_alloc();
+/** park remote device ticket to ticket cache */
+static esp_err_t sts_msg_ticket_cache_park();
+/** remove ticket cache entry */
+static void v_msg_ticket_cache_remove(uint64_t u64_device_id);
+/** ticket update timer callback */
+static void v_msg_ticket_timer_cb(void* pv_arg);
+/** allocate rx frame buffers */
+static void v_msg_rx_frame_alloc();
+/** take rx frame */
+static ts_msg_rx_frame_t* ps_msg_rx_frame_take();
+/** give rx frame */
+static void v_msg_rx_frame_give(ts_msg_rx_frame_t* ps_frame);
+/** rx frame of data */
+static ts_msg_rx_frame_t* ps_msg_rx_frame_of_data(ts_u8_array_t* ps_data);
+/** rx frame of message */
+static ts_msg_rx_frame_t* ps_msg_rx_frame_of_msg(ts_com_msg_t* ps_msg);
+/** skip head of rx data */
+static void v_msg_rx_data_skip(ts_u8_array_t* ps_data, size_t t_skip);
+/** rx message dispatch */
+static void v_msg_rx_dispatch(QueueHandle_t s_rx_handle,
+                              ts_com_msg_t* ps_msg,
+                              uint32_t u32_rx_flt,
+                              tf_com_ble_msg_rx_filter_t pf_rx_filter);
 /** edit check code */
 static esp_err_t sts_edit_check_code(ts_com_msg_auth_ticket_t* ps_ticket, uint8_t* pu8_rand, uint8_t* pu8_digest);
 /** create message data */
@@ -639,11 +888,16 @@ static const ts_msg_definition_t MSG_DEF[] = {
     },
 };
 
+/** 暗号の追加認証データ（ゼロ埋め） */
+static const uint8_t MSG_CIPHER_AAD[MSG_SIZE_CIPHER_TAG] = {0x00};
+
 //==============================================================================
 // variable definition
 //==============================================================================
 /** ミューテックス：ステータス値用 */
 static SemaphoreHandle_t s_mutex_sts = NULL;
+/** スピンロック：受信フレームプール用 */
+static portMUX_TYPE s_rx_frame_spinlock = portMUX_INITIALIZER_UNLOCKED;
 
 /** 制御設定 */
 static ts_msg_ctrl_cfg_t s_msg_ctrl_cfg = {
@@ -651,6 +905,13 @@ static ts_msg_ctrl_cfg_t s_msg_ctrl_cfg = {
     .u16_app_id     = 0,                            // アプリケーションID
     .u64_device_id  = 0,                            // 自デバイスID
     .s_func_ctl     = 0x00,                         // 機能制御
+    .e_auth_mode    = COM_MSG_AUTH_MODE_DEFAULT,    // メッセージ認証モード
+    .e_cipher_suite = COM_MSG_CIPHER_SUITE_DEFAULT, // 暗号スイート
+    .u8_tx_window   = COM_MSG_TX_WINDOW_DEFAULT,    // 送信ウィンドウサイズ
+    .u32_batch_delay_ms = COM_MSG_BATCH_DELAY_MS,   // バッチ送信の最大遅延時間
+    .u16_batch_max_size = COM_MSG_BATCH_MAX_SIZE,   // バッチ送信の最大サイズ
+    .u32_tkt_seq_block  = COM_MSG_TICKET_SEQ_BLOCK, // チケットの送信シーケンス番号の予約ブロックサイズ
+    .u32_tkt_flush_ms   = COM_MSG_TICKET_FLUSH_MS,  // チケットの受信シーケンス番号の遅延更新時間
     .u32_max_length = MSG_SIZE_DEFAULT,             // 最大メッセージサイズ
     .pf_gatt_if     = t_gatt_if_default,            // GATTインターフェースの取得関数
     .pf_connect_sts = e_msg_dmy_connect_sts,        // 接続ステータス取得関数
@@ -660,6 +921,7 @@ static ts_msg_ctrl_cfg_t s_msg_ctrl_cfg = {
     .pf_rx_through  = v_msg_dmy_rx_through,         // 受信キューの読み飛ばし関数
     .pf_tkt_cb      = sts_msg_dmy_ticket_cb,        // チケットアクセスイベントコールバック関数
     .pf_evt_cb      = v_msg_dmy_evt_cb,             // 受信イベントコールバック関数
+    .pf_rx_filter   = NULL,                         // 暗号メッセージの受信フィルター関数
 };
 
 /** 制御ステータス */
@@ -676,6 +938,9 @@ static ts_msg_ctrl_sts_t s_msg_ctrl_sts = {
         .u32_max_seq_no  = 0,               // 最大シーケンス番号
         .u32_tx_seq_no   = 0,               // 送信シーケンス番号
         .u32_rx_seq_no   = 0,               // 受信シーケンス番号
+        .e_auth_mode     = COM_BLE_MSG_AUTH_HASH,   // メッセージ認証モード
+        .e_cipher_suite  = COM_BLE_MSG_CIPHER_AES_GCM,  // 暗号スイート
+        .u8_tx_window    = 1,               // 送信ウィンドウサイズ
     },
     .u64_tx_count   = 0,                    // 送信カウンタ
     .u64_rx_count   = 0,                    // 受信カウンタ
@@ -705,12 +970,48 @@ static ts_msg_ctrl_sts_t s_msg_ctrl_sts = {
         .ps_x25519_ctx     = NULL,          // X25519コンテキスト
         .u8_dev_status     = {0},           // 自デバイスステータス
         .u8_rmt_sts_hash   = {0},           // 相手デバイスステータスハッシュ
-        .u32_max_seq_no    = 0              // 最大シーケンス番号
+        .u32_max_seq_no    = 0,             // 最大シーケンス番号
+        .b_auth_ext        = false,         // 認証モード拡張の有無
+        .e_auth_mode       = COM_BLE_MSG_AUTH_HASH, // メッセージ認証モード
+        .e_cipher_suite    = COM_BLE_MSG_CIPHER_AES_GCM,    // 暗号スイート
+        .b_win_ext         = false,         // 送信ウィンドウ拡張の有無
+        .u8_tx_window      = 1,             // 送信ウィンドウサイズ
+        .b_compress        = false,         // 本文の圧縮の有無
+        .b_content         = false,         // 暗号文のコンテンツ種別の有無
     },
     .s_sts_chk = {
         .u8_tx_rand = {0},                  // 送信ステータスチェック乱数
         .u8_rx_rand = {0},                  // 受信ステータスチェック乱数
     },
+    .s_session = {
+        .b_auth_ready    = false,           // HMACコンテキスト初期化済みフラグ
+        .u8_auth_src_key = {0},             // 認証鍵の導出元の暗号鍵
+        .u8_gcm_key      = {0},             // GCMコンテキストの暗号鍵
+        .s_gcm_ctx = {
+            .b_ready = false,               // 鍵設定済みフラグ
+        },
+    },
+    .s_tx_window = {
+        .u8_head  = 0,                      // 先頭スロット
+        .u8_count = 0,                      // 使用中のスロット数
+    },
+    .s_batch = {
+        .u64_device_id = 0,                 // 送信先デバイスID
+        .u8_count      = 0,                 // 集約したメッセージ数
+        .ps_container  = NULL,              // コンテナ
+        .u16_length    = 0,                 // コンテナの使用サイズ
+    },
+    .s_tkt_persist = {
+        .b_valid         = false,           // 有効フラグ
+        .u64_device_id   = 0,               // 対象デバイスID
+        .u32_tx_reserved = 0,               // 書き込み済みの送信シーケンス番号
+        .u32_rx_flushed  = 0,               // 書き込み済みの受信シーケンス番号
+    },
+    .s_tkt_cache = {
+        .u32_ref_cnt = 0,                   // 参照カウンタ
+        .s_entry     = {{{0}}},             // エントリ
+    },
+    .b_rx_seq_sync = false,                 // 受信シーケンス番号の同期済み
     .ps_con = NULL,                         // BLEコネクション
 };
 
@@ -721,6 +1022,12 @@ static ts_msg_deamon_sts_t s_msg_deamon_sts = {
     .u32_rx_enqueue_filter = 0x00000000,    // 受信キューイングフィルタ
     .s_evt_deamon_handle   = NULL,          // イベント通知デーモンタスクハンドル
     .s_evt_queue_handle    = NULL,          // イベント通知キューハンドラ
+    .s_tran_timer          = {0},           // トランザクションタイムアウトタイマー
+    .s_retx_timer          = {0},           // 再送タイマー
+    .s_batch_timer         = {0},           // バッチ送信タイマー
+    .s_tkt_timer           = {0},           // チケット更新タイマー
+    .s_tx_window_sem       = NULL,          // 送信ウィンドウの空き通知
+    .s_rx_frame            = {{0}},         // 受信フレームプール
 };
 
 /******************************************************************************/
@@ -1094,396 +1401,372 @@ void v_com_msg_config_sts_chk(bool b_enabled) {
 
 /*******************************************************************************
  *
- * NAME: b_com_msg_is_paired
+ * NAME: v_com_msg_config_auth_mode
  *
- * DESCRIPTION:ペアリング済み判定
+ * DESCRIPTION:メッセージ認証モードの設定
  *
- * PARAMETERS:  Name            RW  Usage
- * uint64_t     u64_device_id   R   デバイスID
+ * PARAMETERS:                  Name        RW  Usage
+ * te_com_ble_msg_auth_mode_t   e_mode      R   ペアリング時に提案する認証モード
  *
  * RETURNS:
- *   true:ペアリング済み
  *
  * NOTES:
- * None.
+ * 設定はこれから行うペアリングにのみ適用され、作成済みのチケットは
+ * ペアリング時に合意した認証モードを使い続ける。
+ * 既定は互換モードで、HMACは双方が設定した場合のみ合意される。
  ******************************************************************************/
-bool b_com_msg_is_paired(uint64_t u64_device_id) {
+void v_com_msg_config_auth_mode(te_com_ble_msg_auth_mode_t e_mode) {
+    // 入力チェック
+    if (e_mode >= COM_BLE_MSG_AUTH_CNT) {
+        return;
+    }
+
     //==========================================================================
     // クリティカルセクション開始
     //==========================================================================
     if (xSemaphoreTakeRecursive(s_mutex_sts, portMAX_DELAY) != pdTRUE) {
-        return ESP_ERR_TIMEOUT;
+        return;
     }
 
     //==========================================================================
-    // チケット取得
+    // 認証モードの設定
     //==========================================================================
-    // チケットの有効判定
-    bool b_result = b_is_paired(u64_device_id);
+    s_msg_ctrl_cfg.e_auth_mode = e_mode;
 
     //==========================================================================
     // クリティカルセクション終了
     //==========================================================================
     xSemaphoreGiveRecursive(s_mutex_sts);
-
-    // 結果返信
-    return b_result;
 }
 
 /*******************************************************************************
  *
- * NAME: e_com_msg_connection_sts
+ * NAME: v_com_msg_config_cipher_suite
  *
- * DESCRIPTION:接続ステータス取得
+ * DESCRIPTION:暗号スイートの設定
  *
- * PARAMETERS:  Name            RW  Usage
+ * PARAMETERS:                      Name        RW  Usage
+ * te_com_ble_msg_cipher_suite_t    e_suite     R   ペアリング時に提案する暗号スイート
  *
  * RETURNS:
- *   te_com_ble_msg_connection_sts_t:接続ステータス
  *
  * NOTES:
- * None.
+ * 暗号文メッセージにのみ適用され、ダイジェスト一致メッセージはAES GCMモードのまま。
+ * 作成済みのチケットはペアリング時に合意した暗号スイートを使い続ける。
  ******************************************************************************/
-te_com_ble_msg_connection_sts_t e_com_msg_connection_sts() {
-    // 接続ステータス返却
-    return s_msg_ctrl_cfg.pf_connect_sts();
+void v_com_msg_config_cipher_suite(te_com_ble_msg_cipher_suite_t e_suite) {
+    // 入力チェック
+    if (e_suite >= COM_BLE_MSG_CIPHER_CNT) {
+        return;
+    }
+
+    //==========================================================================
+    // クリティカルセクション開始
+    //==========================================================================
+    if (xSemaphoreTakeRecursive(s_mutex_sts, portMAX_DELAY) != pdTRUE) {
+        return;
+    }
+
+    //==========================================================================
+    // 暗号スイートの設定
+    //==========================================================================
+    s_msg_ctrl_cfg.e_cipher_suite = e_suite;
+
+    //==========================================================================
+    // クリティカルセクション終了
+    //==========================================================================
+    xSemaphoreGiveRecursive(s_mutex_sts);
 }
 
 /*******************************************************************************
  *
- * NAME: sts_com_msg_transaction_sts
+ * NAME: v_com_msg_config_tx_window
  *
- * DESCRIPTION:トランザクションステータスの取得処理
+ * DESCRIPTION:送信ウィンドウサイズの設定
  *
  * PARAMETERS:  Name            RW  Usage
+ * uint8_t      u8_window       R   ペアリング時に提案する送信ウィンドウサイズ
  *
  * RETURNS:
- *   te_com_ble_msg_transaction_sts_t:トランザクションステータス
  *
  * NOTES:
- * None.
+ * 1の場合は従来のストップアンドウェイト（拡張無しでペアリング）となる。
+ * 暗号文メッセージにのみ適用され、送信時は合意したサイズと本設定の小さい方を利用する。
  ******************************************************************************/
-te_com_ble_msg_transaction_sts_t sts_com_msg_transaction_sts() {
+void v_com_msg_config_tx_window(uint8_t u8_window) {
+    // 入力チェック
+    if (u8_window < 1 || u8_window > COM_MSG_TX_WINDOW_MAX) {
+        return;
+    }
+
     //==========================================================================
     // クリティカルセクション開始
     //==========================================================================
     if (xSemaphoreTakeRecursive(s_mutex_sts, portMAX_DELAY) != pdTRUE) {
-        return ESP_ERR_TIMEOUT;
+        return;
     }
 
     //==========================================================================
-    // トランザクションステータスの取得
+    // 送信ウィンドウサイズの設定
     //==========================================================================
-    te_com_ble_msg_transaction_sts_t e_sts = s_msg_ctrl_sts.s_tran.e_sts;
+    s_msg_ctrl_cfg.u8_tx_window = u8_window;
 
     //==========================================================================
     // クリティカルセクション終了
     //==========================================================================
     xSemaphoreGiveRecursive(s_mutex_sts);
-
-    // 結果返信
-    return e_sts;
 }
 
 /*******************************************************************************
  *
- * NAME: sts_com_msg_open_server
+ * NAME: v_com_msg_config_rx_filter
  *
- * DESCRIPTION:メッセージサーバーへの接続
+ * DESCRIPTION:暗号メッセージの受信フィルターの設定
  *
  * PARAMETERS:                  Name        RW  Usage
- * ts_com_ble_gap_scan_result*  ps_device   R   スキャン結果
+ * tf_com_ble_msg_rx_filter_t   pf_filter   R   受信フィルター関数（NULL:フィルター無し）
  *
  * RETURNS:
- *   esp_err_t 結果ステータス
  *
  * NOTES:
- * None.
+ * フィルター関数は受信デーモンタスクからクリティカルセクション外で呼び出される。
+ * フィルター関数内で応答待ちとなる送信処理を行わない事。
  ******************************************************************************/
-esp_err_t sts_com_msg_open_server(ts_com_ble_gap_device_info_t* ps_device) {
+void v_com_msg_config_rx_filter(tf_com_ble_msg_rx_filter_t pf_filter) {
     //==========================================================================
-    // 入力チェック
+    // クリティカルセクション開始
     //==========================================================================
-    // パラメータチェック
-    if (ps_device == NULL) {
-        return ESP_ERR_INVALID_ARG;
-    }
-    // クライアント判定
-    if (s_msg_ctrl_cfg.e_mode != COM_BLE_MSG_MODE_BLE_CLIENT) {
-        // クライアントのみ実行可能
-        return ESP_ERR_INVALID_STATE;
+    if (xSemaphoreTakeRecursive(s_mutex_sts, portMAX_DELAY) != pdTRUE) {
+        return;
     }
 
+    //==========================================================================
+    // 受信フィルターの設定
+    //==========================================================================
+    s_msg_ctrl_cfg.pf_rx_filter = pf_filter;
+
+    //==========================================================================
+    // クリティカルセクション終了
+    //==========================================================================
+    xSemaphoreGiveRecursive(s_mutex_sts);
+}
+
+/*******************************************************************************
+ *
+ * NAME: v_com_msg_config_batch
+ *
+ * DESCRIPTION:バッチ送受信の設定
+ *
+ * PARAMETERS:  Name            RW  Usage
+ * bool         b_enabled       R   バッチ送受信の有効化フラグ
+ * uint32_t     u32_delay_ms    R   バッチ送信の最大遅延時間（ミリ秒）
+ * uint16_t     u16_max_size    R   バッチ送信の最大サイズ（0:暗号メッセージの平文の最大サイズ）
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * 有効化した場合はペアリング時にコンテンツ種別を提案し、合意した相手にのみコンテナを送信する。
+ * コンテナはコンテンツ種別（バッチ）で判別するので、受信時の分割は設定に関係無く行う。
+ * 設定の変更（コンテンツ種別の提案）は次回のペアリングから反映される。
+ ******************************************************************************/
+void v_com_msg_config_batch(bool b_enabled, uint32_t u32_delay_ms, uint16_t u16_max_size) {
     //==========================================================================
     // クリティカルセクション開始
     //==========================================================================
     if (xSemaphoreTakeRecursive(s_mutex_sts, portMAX_DELAY) != pdTRUE) {
-        return ESP_ERR_TIMEOUT;
+        return;
     }
 
     //==========================================================================
-    // サーバーへの接続処理
+    // 有効化判定
     //==========================================================================
-    esp_err_t sts_val = ESP_OK;
-    do {
-        //----------------------------------------------------------------------
-        // オープントランザクションの開始判定
-        //----------------------------------------------------------------------
-        uint32_t u32_timeout_ms = 0;
-        sts_val = sts_begin_open(ps_device->t_bda, &u32_timeout_ms);
-        // トランザクションの開始判定
-        if (sts_val != ESP_OK) {
-            break;
-        }
-        //----------------------------------------------------------------------
-        // GATT接続シーケンス
-        //----------------------------------------------------------------------
-        // GATTサーバーへの接続
-        esp_gatt_if_t t_gatt_if = s_msg_ctrl_cfg.pf_gatt_if();
-        sts_val = sts_com_ble_gattc_open(t_gatt_if, ps_device->t_bda, ps_device->e_addr_type, true);
-    } while(false);
+    if (b_enabled) {
+        // バッチ送受信有効
+        s_msg_ctrl_cfg.s_func_ctl |= MSG_FUNC_CTL_BATCH;
+    } else {
+        // バッチ送受信無効
+        s_msg_ctrl_cfg.s_func_ctl &= ~MSG_FUNC_CTL_BATCH;
+    }
+    s_msg_ctrl_cfg.u32_batch_delay_ms = u32_delay_ms;
+    s_msg_ctrl_cfg.u16_batch_max_size = u16_max_size;
 
     //==========================================================================
     // クリティカルセクション終了
     //==========================================================================
     xSemaphoreGiveRecursive(s_mutex_sts);
-
-    // 結果ステータス返信
-    return sts_val;
 }
 
 /*******************************************************************************
  *
- * NAME: sts_com_msg_close
+ * NAME: v_com_msg_config_compress
  *
- * DESCRIPTION:コネクションを切断
+ * DESCRIPTION:本文の圧縮の設定
  *
  * PARAMETERS:  Name            RW  Usage
+ * bool         b_enabled       R   本文の圧縮の有効化フラグ
  *
  * RETURNS:
- *   esp_err_t 結果ステータス
  *
  * NOTES:
- * None.
+ * ペアリング時に送信ウィンドウ拡張のバイトで提案し、双方が有効な場合のみ
+ * データと暗号データの本文をLZ圧縮する。設定の変更は次回のペアリングから反映される。
  ******************************************************************************/
-esp_err_t sts_com_msg_close() {
+void v_com_msg_config_compress(bool b_enabled) {
     //==========================================================================
     // クリティカルセクション開始
     //==========================================================================
     if (xSemaphoreTakeRecursive(s_mutex_sts, portMAX_DELAY) != pdTRUE) {
-        return ESP_ERR_TIMEOUT;
+        return;
     }
 
     //==========================================================================
-    // ディスコネクト処理
+    // 有効化判定
     //==========================================================================
-    esp_err_t sts_val = ESP_OK;
-    // コネクションを切断
-    ts_com_ble_gattc_con_info_t* ps_con = s_msg_ctrl_sts.ps_con;
-    if (ps_con != NULL) {
-        sts_val = sts_com_ble_disconnect(ps_con->t_bda);
+    if (b_enabled) {
+        // 本文の圧縮有効
+        s_msg_ctrl_cfg.s_func_ctl |= MSG_FUNC_CTL_COMPRESS;
+    } else {
+        // 本文の圧縮無効
+        s_msg_ctrl_cfg.s_func_ctl &= ~MSG_FUNC_CTL_COMPRESS;
     }
-    // 制御ステータス初期化
-    v_msg_ctrl_sts_init();
 
     //==========================================================================
     // クリティカルセクション終了
     //==========================================================================
     xSemaphoreGiveRecursive(s_mutex_sts);
-
-    // 結果返信
-    return sts_val;
 }
 
 /*******************************************************************************
  *
- * NAME: sts_com_msg_edit_remote_dev_id
+ * NAME: v_com_msg_config_content
  *
- * DESCRIPTION:接続先デバイスIDの取得
+ * DESCRIPTION:暗号文のコンテンツ種別の設定
  *
  * PARAMETERS:  Name            RW  Usage
- * uint64_t*    pu64_device_id  R   デバイスIDポインタ
+ * bool         b_enabled       R   コンテンツ種別の有効化フラグ
  *
  * RETURNS:
- *   esp_err_t 結果ステータス
  *
  * NOTES:
- * None.
+ * ペアリング時に送信ウィンドウ拡張のバイトで提案し、双方が有効な場合のみ
+ * 暗号文の平文の先頭にコンテンツ種別（1byte）を付与する。
+ * アプリケーションデータ以外の種別で送信する機能（ストリーム等）を利用する場合は有効化する事。
+ * バッチ送受信を有効化した場合も提案する。
+ * 設定の変更は次回のペアリングから反映される。
  ******************************************************************************/
-esp_err_t sts_com_msg_edit_remote_dev_id(uint64_t* pu64_device_id) {
+void v_com_msg_config_content(bool b_enabled) {
     //==========================================================================
     // クリティカルセクション開始
     //==========================================================================
     if (xSemaphoreTakeRecursive(s_mutex_sts, portMAX_DELAY) != pdTRUE) {
-        return ESP_ERR_TIMEOUT;
+        return;
     }
 
     //==========================================================================
-    // デバイスIDの取得
+    // 有効化判定
     //==========================================================================
-    esp_err_t sts_val = ESP_OK;
-    do {
-        // 接続確認
-        if (s_msg_ctrl_cfg.pf_connect_sts() != COM_BLE_MSG_CON_CONNECTED) {
-            // 結果ステータス
-            sts_val = ESP_ERR_NOT_FOUND;
-            break;
-        }
-        // 受信履歴のチェック
-        if (s_msg_ctrl_sts.u64_rmt_device_id == s_msg_ctrl_cfg.u64_device_id) {
-            // 結果ステータス
-            sts_val = ESP_ERR_NOT_FOUND;
-            break;
-        }
-        // デバイスID編集
-        *pu64_device_id = s_msg_ctrl_sts.u64_rmt_device_id;
-    } while(false);
+    if (b_enabled) {
+        // コンテンツ種別有効
+        s_msg_ctrl_cfg.s_func_ctl |= MSG_FUNC_CTL_CONTENT;
+    } else {
+        // コンテンツ種別無効
+        s_msg_ctrl_cfg.s_func_ctl &= ~MSG_FUNC_CTL_CONTENT;
+    }
 
     //==========================================================================
     // クリティカルセクション終了
     //==========================================================================
     xSemaphoreGiveRecursive(s_mutex_sts);
-
-    // 結果ステータス返信
-    return sts_val;
 }
 
 /*******************************************************************************
  *
- * NAME: sts_com_msg_edit_public_key_pair
+ * NAME: v_com_msg_config_ticket_update
  *
- * DESCRIPTION:ペアリング中の公開鍵のペアの編集処理
+ * DESCRIPTION:チケット更新の設定
  *
  * PARAMETERS:  Name            RW  Usage
- * uint8_t*     pu8_client_key  W   公開鍵（クライアント）
- * uint8_t*     pu8_server_key  W   公開鍵（サーバー）
+ * uint32_t     u32_seq_block   R   送信シーケンス番号の予約ブロックサイズ（1:送信毎に更新）
+ * uint32_t     u32_flush_ms    R   受信シーケンス番号の遅延更新時間（ミリ秒、0:受信毎に更新）
  *
  * RETURNS:
- *   esp_err_t 結果ステータス
  *
  * NOTES:
- * None.
+ * 送信シーケンス番号はブロック単位で予約し、予約したブロックの上限のみをチケットに書き込む。
+ * 再起動後は書き込み済みの上限から送信するので、送信済みのシーケンス番号は再利用されない。
+ * 受信シーケンス番号は遅延更新時間が0の場合、受信を受理する前に書き込む。
+ * 遅延更新時間を指定した場合は遅延更新時間の経過、ブロックサイズ分の受信、切断の何れかで
+ * 書き込むが、書き込み前に電源断が発生すると再起動後に未書き込み分の暗号文の再送（リプレイ）を
+ * 受理してしまうので、リプレイを許容出来る用途でのみ指定する事。
  ******************************************************************************/
-esp_err_t sts_com_msg_edit_public_key_pair(uint8_t* pu8_client_key, uint8_t* pu8_server_key) {
-    //==========================================================================
+void v_com_msg_config_ticket_update(uint32_t u32_seq_block, uint32_t u32_flush_ms) {
     // 入力チェック
-    //==========================================================================
-    if (pu8_client_key == NULL || pu8_server_key == NULL) {
-        return ESP_ERR_INVALID_ARG;
+    if (u32_seq_block < 1) {
+        return;
     }
 
     //==========================================================================
     // クリティカルセクション開始
     //==========================================================================
     if (xSemaphoreTakeRecursive(s_mutex_sts, portMAX_DELAY) != pdTRUE) {
-        return ESP_ERR_TIMEOUT;
+        return;
     }
 
     //==========================================================================
-    // 主処理
+    // チケット更新の設定
     //==========================================================================
-    esp_err_t sts_val = ESP_OK;
-    do {
-        //----------------------------------------------------------------------
-        // トランザクション開始判定
-        //----------------------------------------------------------------------
-        ts_transaction_info_t* ps_tran = &s_msg_ctrl_sts.s_tran;
-        if (ps_tran->e_sts != COM_BLE_MSG_TRN_PAIRING) {
-            // ペアリングトランザクションが開始していない
-            sts_val = ESP_ERR_INVALID_STATE;
-            break;
-        }
-
-        //----------------------------------------------------------------------
-        // タイムアウト判定
-        //----------------------------------------------------------------------
-        if (ps_tran->u32_timeout_ms < xTaskGetTickCountMSec()) {
-            // タイムアウト
-            sts_val = ESP_ERR_TIMEOUT;
-            break;
-        }
-
-        //----------------------------------------------------------------------
-        // 接続判定
-        //----------------------------------------------------------------------
-        if (s_msg_ctrl_cfg.pf_connect_sts() != COM_BLE_MSG_CON_CONNECTED) {
-            // 未接続
-            sts_val = ESP_ERR_INVALID_STATE;
-            break;
-        }
-
-        //----------------------------------------------------------------------
-        // 公開鍵の受信済み判定
-        //----------------------------------------------------------------------
-        if (!b_is_public_key_received()) {
-            // 公開鍵未受信
-            sts_val = ESP_ERR_INVALID_STATE;
-            break;
-        }
-
-        //----------------------------------------------------------------------
-        // 公開鍵のペアを編集
-        //----------------------------------------------------------------------
-        ts_pairing_info_t* ps_pairing = &s_msg_ctrl_sts.s_pairing;
-        // X25519コンテキスト
-        ts_crypto_x25519_context_t* ps_x25519_ctx = ps_pairing->ps_x25519_ctx;
-        // クライアント側の公開鍵を編集
-        memcpy(pu8_client_key, ps_x25519_ctx->u8_cli_public_key, CRYPTO_X25519_CLIENT_PUBLIC_KEY_SIZE);
-        // サーバー側の公開鍵を編集
-        memcpy(pu8_server_key, ps_x25519_ctx->u8_svr_public_key, CRYPTO_X25519_SERVER_PUBLIC_KEY_SIZE);
-
-    } while(false);
+    s_msg_ctrl_cfg.u32_tkt_seq_block = u32_seq_block;
+    s_msg_ctrl_cfg.u32_tkt_flush_ms  = u32_flush_ms;
 
     //==========================================================================
     // クリティカルセクション終了
     //==========================================================================
     xSemaphoreGiveRecursive(s_mutex_sts);
-
-    // 結果返信
-    return sts_val;
 }
 
 /*******************************************************************************
  *
- * NAME: ps_com_msg_rx_msg
+ * NAME: u32_com_msg_max_cipher_size
  *
- * DESCRIPTION:メッセージの読み込み処理
+ * DESCRIPTION:暗号メッセージ１件で送信可能な平文の最大サイズ
  *
- * PARAMETERS:              Name            RW  Usage
- * TickType_t               t_tick          R   ウェイト時間
+ * PARAMETERS:      Name            RW  Usage
  *
  * RETURNS:
- *   esp_err_t 結果ステータス
+ *   uint32_t:平文の最大サイズ（0:送信不可）
  *
  * NOTES:
- * None.
+ * 最大メッセージサイズからヘッダー、フッター、暗号ヘッダーを除き、
+ * PKCS#7パディング（最低1byte）と本文の圧縮タイプ（1byte）、
+ * コンテンツ種別（1byte）を考慮したサイズを返す。
  ******************************************************************************/
-ts_com_msg_t* ps_com_msg_rx_msg(TickType_t t_tick) {
-    // メッセージの読み込み
-    ts_com_msg_t* ps_msg = NULL;
-    if (xQueueReceive(s_msg_deamon_sts.s_rx_queue_handle, &ps_msg, t_tick) != pdPASS) {
-        ps_msg = NULL;
+uint32_t u32_com_msg_max_cipher_size() {
+    // 本文に利用可能なサイズ
+    uint32_t u32_overhead = MSG_SIZE_HEADER + MSG_SIZE_CIPHER_HEADER + MSG_SIZE_FOOTER;
+    if (s_msg_ctrl_cfg.u32_max_length < u32_overhead + AES_BLOCK_BYTES) {
+        return 0;
     }
-    // 受信データを返却
-    return ps_msg;
+    uint32_t u32_body_len = s_msg_ctrl_cfg.u32_max_length - u32_overhead;
+    // ブロック境界に切り捨ててパディング分と圧縮タイプ分、コンテンツ種別分を除く
+    return (u32_body_len - (u32_body_len % AES_BLOCK_BYTES)) - 1 - MSG_SIZE_COMPRESS_TYPE - MSG_SIZE_CONTENT_TYPE;
 }
 
 /*******************************************************************************
  *
- * NAME: sts_com_msg_rx_wait
+ * NAME: b_com_msg_is_paired
  *
- * DESCRIPTION:メッセージの受信ウェイト
+ * DESCRIPTION:ペアリング済み判定
  *
- * PARAMETERS:      Name            RW  Usage
- * TickType_t       t_tick          R   タイムアウト時間
+ * PARAMETERS:  Name            RW  Usage
+ * uint64_t     u64_device_id   R   デバイスID
  *
  * RETURNS:
- *   esp_err_t 結果ステータス
+ *   true:ペアリング済み
  *
  * NOTES:
  * None.
  ******************************************************************************/
-esp_err_t sts_com_msg_rx_wait(TickType_t t_tick) {
+bool b_com_msg_is_paired(uint64_t u64_device_id) {
     //==========================================================================
     // クリティカルセクション開始
     //==========================================================================
@@ -1492,74 +1775,54 @@ esp_err_t sts_com_msg_rx_wait(TickType_t t_tick) {
     }
 
     //==========================================================================
-    // 受信カウント宣言
+    // チケット取得
     //==========================================================================
-    uint64_t u64_rx_count_now = s_msg_ctrl_sts.u64_rx_count;
-    uint64_t u64_rx_count_pre = u64_rx_count_now;
+    // チケットの有効判定
+    bool b_result = b_is_paired(u64_device_id);
 
     //==========================================================================
     // クリティカルセクション終了
     //==========================================================================
     xSemaphoreGiveRecursive(s_mutex_sts);
 
-    // タイムアウト時刻を算出
-    TickType_t t_timeout = t_tick;
-    if (t_timeout != portMAX_DELAY) {
-        t_timeout += xTaskGetTickCount();
-    }
-
-    //==========================================================================
-    // ウェイトループ
-    //==========================================================================
-    // タイムアウトまでのループ
-    do {
-        //----------------------------------------------------------------------
-        // クリティカルセクション開始
-        //----------------------------------------------------------------------
-        if (xSemaphoreTakeRecursive(s_mutex_sts, portMAX_DELAY) != pdTRUE) {
-            return ESP_ERR_TIMEOUT;
-        }
-
-        //----------------------------------------------------------------------
-        // 受信カウント更新
-        //----------------------------------------------------------------------
-        u64_rx_count_pre = u64_rx_count_now;
-        u64_rx_count_now = s_msg_ctrl_sts.u64_rx_count;
-
-        //----------------------------------------------------------------------
-        // クリティカルセクション終了
-        //----------------------------------------------------------------------
-        xSemaphoreGiveRecursive(s_mutex_sts);
-
-        //----------------------------------------------------------------------
-        // 受信カウント判定
-        //----------------------------------------------------------------------
-        if (u64_rx_count_now > u64_rx_count_pre) {
-            return ESP_OK;
-        }
-        // ウェイト
-        vTaskDelay(COM_MSG_RETRY_WAIT);
-    } while(t_timeout >= xTaskGetTickCount());
-
     // 結果返信
-    return ESP_ERR_TIMEOUT;
+    return b_result;
 }
 
 /*******************************************************************************
  *
- * NAME: sts_com_msg_tx_reset_msg
+ * NAME: e_com_msg_connection_sts
  *
- * DESCRIPTION:RESETメッセージの送信処理
+ * DESCRIPTION:接続ステータス取得
  *
- * PARAMETERS:              Name            RW  Usage
+ * PARAMETERS:  Name            RW  Usage
  *
  * RETURNS:
- *   esp_err_t 結果ステータス
+ *   te_com_ble_msg_connection_sts_t:接続ステータス
  *
  * NOTES:
  * None.
  ******************************************************************************/
-esp_err_t sts_com_msg_tx_reset_msg() {
+te_com_ble_msg_connection_sts_t e_com_msg_connection_sts() {
+    // 接続ステータス返却
+    return s_msg_ctrl_cfg.pf_connect_sts();
+}
+
+/*******************************************************************************
+ *
+ * NAME: sts_com_msg_transaction_sts
+ *
+ * DESCRIPTION:トランザクションステータスの取得処理
+ *
+ * PARAMETERS:  Name            RW  Usage
+ *
+ * RETURNS:
+ *   te_com_ble_msg_transaction_sts_t:トランザクションステータス
+ *
+ * NOTES:
+ * None.
+ ******************************************************************************/
+te_com_ble_msg_transaction_sts_t sts_com_msg_transaction_sts() {
     //==========================================================================
     // クリティカルセクション開始
     //==========================================================================
@@ -1568,25 +1831,27 @@ esp_err_t sts_com_msg_tx_reset_msg() {
     }
 
     //==========================================================================
-    // Resetメッセージ送信
+    // トランザクションステータスの取得
     //==========================================================================
-    esp_err_t sts_val = sts_tx_reset_msg();
+    te_com_ble_msg_transaction_sts_t e_sts = s_msg_ctrl_sts.s_tran.e_sts;
 
     //==========================================================================
     // クリティカルセクション終了
     //==========================================================================
     xSemaphoreGiveRecursive(s_mutex_sts);
 
-    return sts_val;
+    // 結果返信
+    return e_sts;
 }
 
 /*******************************************************************************
  *
- * NAME: sts_com_msg_tx_ping_msg
+ * NAME: sts_com_msg_open_server
  *
- * DESCRIPTION:PINGメッセージの送信処理
+ * DESCRIPTION:メッセージサーバーへの接続
  *
- * PARAMETERS:              Name            RW  Usage
+ * PARAMETERS:                  Name        RW  Usage
+ * ts_com_ble_gap_scan_result*  ps_device   R   スキャン結果
  *
  * RETURNS:
  *   esp_err_t 結果ステータス
@@ -1594,7 +1859,20 @@ esp_err_t sts_com_msg_tx_reset_msg() {
  * NOTES:
  * None.
  ******************************************************************************/
-esp_err_t sts_com_msg_tx_ping_msg() {
+esp_err_t sts_com_msg_open_server(ts_com_ble_gap_device_info_t* ps_device) {
+    //==========================================================================
+    // 入力チェック
+    //==========================================================================
+    // パラメータチェック
+    if (ps_device == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    // クライアント判定
+    if (s_msg_ctrl_cfg.e_mode != COM_BLE_MSG_MODE_BLE_CLIENT) {
+        // クライアントのみ実行可能
+        return ESP_ERR_INVALID_STATE;
+    }
+
     //==========================================================================
     // クリティカルセクション開始
     //==========================================================================
@@ -1603,25 +1881,43 @@ esp_err_t sts_com_msg_tx_ping_msg() {
     }
 
     //==========================================================================
-    // Pingメッセージ送信
+    // サーバーへの接続処理
     //==========================================================================
-    esp_err_t sts_val = sts_tx_ping_msg();
+    esp_err_t sts_val = ESP_OK;
+    do {
+        //----------------------------------------------------------------------
+        // オープントランザクションの開始判定
+        //----------------------------------------------------------------------
+        uint32_t u32_timeout_ms = 0;
+        sts_val = sts_begin_open(ps_device->t_bda, &u32_timeout_ms);
+        // トランザクションの開始判定
+        if (sts_val != ESP_OK) {
+            break;
+        }
+        //----------------------------------------------------------------------
+        // GATT接続シーケンス
+        //----------------------------------------------------------------------
+        // GATTサーバーへの接続
+        esp_gatt_if_t t_gatt_if = s_msg_ctrl_cfg.pf_gatt_if();
+        sts_val = sts_com_ble_gattc_open(t_gatt_if, ps_device->t_bda, ps_device->e_addr_type, true);
+    } while(false);
 
     //==========================================================================
     // クリティカルセクション終了
     //==========================================================================
     xSemaphoreGiveRecursive(s_mutex_sts);
 
+    // 結果ステータス返信
     return sts_val;
 }
 
 /*******************************************************************************
  *
- * NAME: sts_com_msg_tx_pairing_request
+ * NAME: sts_com_msg_close
  *
- * DESCRIPTION:ペアリング要求
+ * DESCRIPTION:コネクションを切断
  *
- * PARAMETERS:              Name            RW  Usage
+ * PARAMETERS:  Name            RW  Usage
  *
  * RETURNS:
  *   esp_err_t 結果ステータス
@@ -1629,7 +1925,7 @@ esp_err_t sts_com_msg_tx_ping_msg() {
  * NOTES:
  * None.
  ******************************************************************************/
-esp_err_t sts_com_msg_tx_pairing_request() {
+esp_err_t sts_com_msg_close() {
     //==========================================================================
     // クリティカルセクション開始
     //==========================================================================
@@ -1638,43 +1934,16 @@ esp_err_t sts_com_msg_tx_pairing_request() {
     }
 
     //==========================================================================
-    // 主処理
+    // ディスコネクト処理
     //==========================================================================
     esp_err_t sts_val = ESP_OK;
-    do {
-        //----------------------------------------------------------------------
-        // ペアリングトランザクション開始
-        //----------------------------------------------------------------------
-        sts_val = sts_begin_pairing();
-        if (sts_val != ESP_OK) {
-            break;
-        }
-        // クライアント側のX25519コンテキストの生成
-        ts_pairing_info_t* ps_pairing = &s_msg_ctrl_sts.s_pairing;
-        ps_pairing->ps_x25519_ctx = ps_crypto_x25519_client_context();
-
-        //----------------------------------------------------------------------
-        // ペアリング要求の送信処理
-        //----------------------------------------------------------------------
-        // メッセージの生成
-        ts_u8_array_t* ps_msg_data = ps_create_msg_data(COM_BLE_MSG_TYP_PAIRING_REQ, NULL);
-        if (ps_msg_data == NULL) {
-            // メッセージ生成エラー
-            sts_val = ESP_ERR_NO_MEM;
-            // トランザクション終了
-            v_msg_ctrl_sts_transaction_reset();
-            break;
-        }
-        // ペアリング要求送信
-        sts_val = s_msg_ctrl_cfg.pf_tx_msg(ps_msg_data);
-        if (sts_val != ESP_OK) {
-            // トランザクション終了
-            v_msg_ctrl_sts_transaction_reset();
-            break;
-        }
-        // 生成したメッセージを解放
-        sts_mdl_delete_u8_array(ps_msg_data);
-    } while(false);
+    // コネクションを切断
+    ts_com_ble_gattc_con_info_t* ps_con = s_msg_ctrl_sts.ps_con;
+    if (ps_con != NULL) {
+        sts_val = sts_com_ble_disconnect(ps_con->t_bda);
+    }
+    // 制御ステータス初期化
+    v_msg_ctrl_sts_init();
 
     //==========================================================================
     // クリティカルセクション終了
@@ -1687,13 +1956,12 @@ esp_err_t sts_com_msg_tx_pairing_request() {
 
 /*******************************************************************************
  *
- * NAME: sts_com_msg_tx_pairing_certification
+ * NAME: sts_com_msg_edit_remote_dev_id
  *
- * DESCRIPTION:ペアリング認証（ダイジェスト比較結果の通知）
+ * DESCRIPTION:接続先デバイスIDの取得
  *
- * PARAMETERS:      Name            RW  Usage
- * bool             b_result        R   承認結果
- * uint32_t         u32_max_seq_no  R   最大シーケンス番号
+ * PARAMETERS:  Name            RW  Usage
+ * uint64_t*    pu64_device_id  R   デバイスIDポインタ
  *
  * RETURNS:
  *   esp_err_t 結果ステータス
@@ -1701,7 +1969,7 @@ esp_err_t sts_com_msg_tx_pairing_request() {
  * NOTES:
  * None.
  ******************************************************************************/
-esp_err_t sts_com_msg_tx_pairing_certification(bool b_result, uint32_t u32_max_seq_no) {
+esp_err_t sts_com_msg_edit_remote_dev_id(uint64_t* pu64_device_id) {
     //==========================================================================
     // クリティカルセクション開始
     //==========================================================================
@@ -1710,24 +1978,71 @@ esp_err_t sts_com_msg_tx_pairing_certification(bool b_result, uint32_t u32_max_s
     }
 
     //==========================================================================
-    // 主処理
+    // デバイスIDの取得
     //==========================================================================
     esp_err_t sts_val = ESP_OK;
-    bool b_end_tran = false;
-    te_com_ble_msg_event e_evt = COM_BLE_MSG_EVT_PAIRING_SUCCESS;
     do {
-        //======================================================================
-        // 状態チェック
-        //======================================================================
-        //----------------------------------------------------------------------
-        // ペアリング機能の有効判定
-        //----------------------------------------------------------------------
-        if ((s_msg_ctrl_cfg.s_func_ctl & MSG_FUNC_CTL_PAIRING) == 0x00) {
-            // 機能無効
-            sts_val = ESP_ERR_INVALID_STATE;
+        // 接続確認
+        if (s_msg_ctrl_cfg.pf_connect_sts() != COM_BLE_MSG_CON_CONNECTED) {
+            // 結果ステータス
+            sts_val = ESP_ERR_NOT_FOUND;
+            break;
+        }
+        // 受信履歴のチェック
+        if (s_msg_ctrl_sts.u64_rmt_device_id == s_msg_ctrl_cfg.u64_device_id) {
+            // 結果ステータス
+            sts_val = ESP_ERR_NOT_FOUND;
             break;
         }
+        // デバイスID編集
+        *pu64_device_id = s_msg_ctrl_sts.u64_rmt_device_id;
+    } while(false);
+
+    //==========================================================================
+    // クリティカルセクション終了
+    //==========================================================================
+    xSemaphoreGiveRecursive(s_mutex_sts);
+
+    // 結果ステータス返信
+    return sts_val;
+}
+
+/*******************************************************************************
+ *
+ * NAME: sts_com_msg_edit_public_key_pair
+ *
+ * DESCRIPTION:ペアリング中の公開鍵のペアの編集処理
+ *
+ * PARAMETERS:  Name            RW  Usage
+ * uint8_t*     pu8_client_key  W   公開鍵（クライアント）
+ * uint8_t*     pu8_server_key  W   公開鍵（サーバー）
+ *
+ * RETURNS:
+ *   esp_err_t 結果ステータス
+ *
+ * NOTES:
+ * None.
+ ******************************************************************************/
+esp_err_t sts_com_msg_edit_public_key_pair(uint8_t* pu8_client_key, uint8_t* pu8_server_key) {
+    //==========================================================================
+    // 入力チェック
+    //==========================================================================
+    if (pu8_client_key == NULL || pu8_server_key == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    //==========================================================================
+    // クリティカルセクション開始
+    //==========================================================================
+    if (xSemaphoreTakeRecursive(s_mutex_sts, portMAX_DELAY) != pdTRUE) {
+        return ESP_ERR_TIMEOUT;
+    }
 
+    //==========================================================================
+    // 主処理
+    //==========================================================================
+    esp_err_t sts_val = ESP_OK;
+    do {
         //----------------------------------------------------------------------
         // トランザクション開始判定
         //----------------------------------------------------------------------
@@ -1738,24 +2053,12 @@ esp_err_t sts_com_msg_tx_pairing_certification(bool b_result, uint32_t u32_max_s
             break;
         }
 
-        //----------------------------------------------------------------------
-        // ペアリング認証済み判定
-        //----------------------------------------------------------------------
-        ts_pairing_info_t* ps_pairing = &s_msg_ctrl_sts.s_pairing;
-        if ((ps_pairing->e_sts & MSG_PAIRING_CHK_LOCAL) != 0x00) {
-            // 既に認証済み
-            sts_val = ESP_ERR_INVALID_STATE;
-            b_end_tran = true;
-            break;
-        }
-
         //----------------------------------------------------------------------
         // タイムアウト判定
         //----------------------------------------------------------------------
         if (ps_tran->u32_timeout_ms < xTaskGetTickCountMSec()) {
             // タイムアウト
             sts_val = ESP_ERR_TIMEOUT;
-            b_end_tran = true;
             break;
         }
 
@@ -1777,74 +2080,19 @@ esp_err_t sts_com_msg_tx_pairing_certification(bool b_result, uint32_t u32_max_s
             break;
         }
 
-        //======================================================================
-        // 認証通知処理
-        //======================================================================
-        //----------------------------------------------------------------------
-        // ステータス判定
-        //----------------------------------------------------------------------
-        te_com_ble_msg_type_t e_result;
-        if (b_result) {
-            // ダイジェスト一致
-            e_result = COM_BLE_MSG_TYP_DIGEST_MATCH;
-            ps_pairing->e_sts |= MSG_PAIRING_CHK_LOCAL;
-            // 最大シーケンス番号の更新(後に認証した方が優先される)
-            ps_pairing->u32_max_seq_no = u32_max_seq_no;
-        } else {
-            // ダイジェスト不一致
-            e_result = COM_BLE_MSG_TYP_DIGEST_ERR;
-            b_end_tran = true;
-            e_evt = COM_BLE_MSG_EVT_PAIRING_ERR;
-        }
-
         //----------------------------------------------------------------------
-        // チケット生成判定
+        // 公開鍵のペアを編集
         //----------------------------------------------------------------------
-        if (ps_pairing->e_sts == MSG_PAIRING_CHK_ALL) {
-            // ダイジェスト一致
-            b_end_tran = true;
-            // チケットの生成
-            sts_val = sts_create_ticket(ps_tran, ps_pairing);
-            if (sts_val != ESP_OK) {
-                e_evt = COM_BLE_MSG_EVT_PAIRING_ERR;
-                break;
-            }
-        }
+        ts_pairing_info_t* ps_pairing = &s_msg_ctrl_sts.s_pairing;
+        // X25519コンテキスト
+        ts_crypto_x25519_context_t* ps_x25519_ctx = ps_pairing->ps_x25519_ctx;
+        // クライアント側の公開鍵を編集
+        memcpy(pu8_client_key, ps_x25519_ctx->u8_cli_public_key, CRYPTO_X25519_CLIENT_PUBLIC_KEY_SIZE);
+        // サーバー側の公開鍵を編集
+        memcpy(pu8_server_key, ps_x25519_ctx->u8_svr_public_key, CRYPTO_X25519_SERVER_PUBLIC_KEY_SIZE);
 
-        //----------------------------------------------------------------------
-        // ペアリング結果の通知
-        //----------------------------------------------------------------------
-        // メッセージ生成
-        ts_u8_array_t* ps_msg_data = ps_create_msg_data(e_result, NULL);
-        if (ps_msg_data == NULL) {
-            sts_val = ESP_ERR_NO_MEM;
-            b_end_tran = true;
-            e_evt = COM_BLE_MSG_EVT_PAIRING_ERR;
-            break;
-        }
-        // ペアリング結果送信
-        sts_val = s_msg_ctrl_cfg.pf_tx_msg(ps_msg_data);
-        // 生成したメッセージを解放
-        sts_mdl_delete_u8_array(ps_msg_data);
-        // 結果ステータス判定
-        if (sts_val != ESP_OK) {
-            b_end_tran = true;
-            e_evt = COM_BLE_MSG_EVT_PAIRING_ERR;
-            break;
-        }
     } while(false);
 
-    //==========================================================================
-    // 終了処理
-    //==========================================================================
-    // トランザクション終了判定
-    if (b_end_tran) {
-        // イベントエンキュー
-        v_msg_evt_enqueue(e_evt);
-        // トランザクション終了
-        v_msg_ctrl_sts_transaction_reset();
-    }
-
     //==========================================================================
     // クリティカルセクション終了
     //==========================================================================
@@ -1856,11 +2104,12 @@ esp_err_t sts_com_msg_tx_pairing_certification(bool b_result, uint32_t u32_max_s
 
 /*******************************************************************************
  *
- * NAME: sts_com_msg_tx_sts_chk_request
+ * NAME: ps_com_msg_rx_msg
  *
- * DESCRIPTION:ステータスチェック要求処理
+ * DESCRIPTION:メッセージの読み込み処理
  *
  * PARAMETERS:              Name            RW  Usage
+ * TickType_t               t_tick          R   ウェイト時間
  *
  * RETURNS:
  *   esp_err_t 結果ステータス
@@ -1868,69 +2117,24 @@ esp_err_t sts_com_msg_tx_pairing_certification(bool b_result, uint32_t u32_max_s
  * NOTES:
  * None.
  ******************************************************************************/
-esp_err_t sts_com_msg_tx_sts_chk_request() {
-    //==========================================================================
-    // クリティカルセクション開始
-    //==========================================================================
-    if (xSemaphoreTakeRecursive(s_mutex_sts, portMAX_DELAY) != pdTRUE) {
-        return ESP_ERR_TIMEOUT;
+ts_com_msg_t* ps_com_msg_rx_msg(TickType_t t_tick) {
+    // メッセージの読み込み
+    ts_com_msg_t* ps_msg = NULL;
+    if (xQueueReceive(s_msg_deamon_sts.s_rx_queue_handle, &ps_msg, t_tick) != pdPASS) {
+        ps_msg = NULL;
     }
-
-    //==========================================================================
-    // 主処理
-    //==========================================================================
-    // 結果ステータス
-    esp_err_t sts_val = ESP_OK;
-    do {
-        //----------------------------------------------------------------------
-        // ステータスチェックトランザクション開始
-        //----------------------------------------------------------------------
-        sts_val = sts_begin_sts_chk();
-        if (sts_val != ESP_OK) {
-            break;
-        }
-
-        //----------------------------------------------------------------------
-        // ステータスチェック要求の送信処理
-        //----------------------------------------------------------------------
-        // メッセージの生成
-        ts_u8_array_t* ps_msg_data = ps_create_msg_data(COM_BLE_MSG_TYP_STATUS_REQ, NULL);
-        if (ps_msg_data == NULL) {
-            // トランザクション終了
-            sts_val = ESP_ERR_NO_MEM;
-            // トランザクション終了
-            v_msg_ctrl_sts_transaction_reset();
-            break;
-        }
-        // ステータスチェック要求の送信
-        sts_val = s_msg_ctrl_cfg.pf_tx_msg(ps_msg_data);
-        // 生成したメッセージを解放
-        sts_mdl_delete_u8_array(ps_msg_data);
-        if (sts_val != ESP_OK) {
-            // トランザクション終了
-            v_msg_ctrl_sts_transaction_reset();
-            break;
-        }
-    } while (false);
-
-    //==========================================================================
-    // クリティカルセクション終了
-    //==========================================================================
-    xSemaphoreGiveRecursive(s_mutex_sts);
-
-    // 結果返信
-    return sts_val;
+    // 受信データを返却
+    return ps_msg;
 }
 
 /*******************************************************************************
  *
- * NAME: sts_com_msg_tx_plain_msg
+ * NAME: sts_com_msg_rx_wait
  *
- * DESCRIPTION:平文メッセージの送信処理
+ * DESCRIPTION:メッセージの受信ウェイト
  *
- * PARAMETERS:              Name            RW  Usage
- * uint64_t                 u64_device_id   R   デバイスID
- * ts_u8_array_t*           ps_data         R   送信メッセージデータ
+ * PARAMETERS:      Name            RW  Usage
+ * TickType_t       t_tick          R   タイムアウト時間
  *
  * RETURNS:
  *   esp_err_t 結果ステータス
@@ -1938,8 +2142,7 @@ esp_err_t sts_com_msg_tx_sts_chk_request() {
  * NOTES:
  * None.
  ******************************************************************************/
-esp_err_t sts_com_msg_tx_plain_msg(uint64_t u64_device_id,
-                                   ts_u8_array_t* ps_data) {
+esp_err_t sts_com_msg_rx_wait(TickType_t t_tick) {
     //==========================================================================
     // クリティカルセクション開始
     //==========================================================================
@@ -1948,58 +2151,66 @@ esp_err_t sts_com_msg_tx_plain_msg(uint64_t u64_device_id,
     }
 
     //==========================================================================
-    // 主処理
+    // 受信カウント宣言
     //==========================================================================
-    // 結果ステータス
-    esp_err_t sts_val = ESP_OK;
-    // メッセージ
-    ts_u8_array_t* ps_msg = NULL;
+    uint64_t u64_rx_count_now = s_msg_ctrl_sts.u64_rx_count;
+    uint64_t u64_rx_count_pre = u64_rx_count_now;
+
+    //==========================================================================
+    // クリティカルセクション終了
+    //==========================================================================
+    xSemaphoreGiveRecursive(s_mutex_sts);
+
+    // タイムアウト時刻を算出
+    TickType_t t_timeout = t_tick;
+    if (t_timeout != portMAX_DELAY) {
+        t_timeout += xTaskGetTickCount();
+    }
+
+    //==========================================================================
+    // ウェイトループ
+    //==========================================================================
+    // タイムアウトまでのループ
     do {
         //----------------------------------------------------------------------
-        // 接続判定
+        // クリティカルセクション開始
         //----------------------------------------------------------------------
-        if (s_msg_ctrl_cfg.pf_connect_sts() != COM_BLE_MSG_CON_CONNECTED) {
-            // 未接続
-            sts_val = ESP_ERR_INVALID_STATE;
-            break;
+        if (xSemaphoreTakeRecursive(s_mutex_sts, portMAX_DELAY) != pdTRUE) {
+            return ESP_ERR_TIMEOUT;
         }
 
         //----------------------------------------------------------------------
-        // メッセージ生成
+        // 受信カウント更新
         //----------------------------------------------------------------------
-        ps_msg = ps_create_msg_data(COM_BLE_MSG_TYP_DATA, ps_data);
-        if (ps_msg == NULL) {
-            // メッセージ生成エラー
-            sts_val = ESP_ERR_NO_MEM;
-            break;
-        }
+        u64_rx_count_pre = u64_rx_count_now;
+        u64_rx_count_now = s_msg_ctrl_sts.u64_rx_count;
 
         //----------------------------------------------------------------------
-        // メッセージの送信
+        // クリティカルセクション終了
         //----------------------------------------------------------------------
-        sts_val = s_msg_ctrl_cfg.pf_tx_msg(ps_msg);
-    } while(false);
-
-    // 送信メッセージ解放
-    sts_mdl_delete_u8_array(ps_msg);
+        xSemaphoreGiveRecursive(s_mutex_sts);
 
-    //==========================================================================
-    // クリティカルセクション終了
-    //==========================================================================
-    xSemaphoreGiveRecursive(s_mutex_sts);
+        //----------------------------------------------------------------------
+        // 受信カウント判定
+        //----------------------------------------------------------------------
+        if (u64_rx_count_now > u64_rx_count_pre) {
+            return ESP_OK;
+        }
+        // ウェイト
+        vTaskDelay(COM_MSG_RETRY_WAIT);
+    } while(t_timeout >= xTaskGetTickCount());
 
-    return sts_val;
+    // 結果返信
+    return ESP_ERR_TIMEOUT;
 }
 
 /*******************************************************************************
  *
- * NAME: sts_com_msg_tx_cipher_msg
+ * NAME: sts_com_msg_tx_reset_msg
  *
- * DESCRIPTION:暗号文メッセージの送信処理
+ * DESCRIPTION:RESETメッセージの送信処理
  *
  * PARAMETERS:              Name            RW  Usage
- * uint64_t                 u64_device_id   R   デバイスID
- * ts_u8_array_t*           ps_data         R   送信メッセージデータ
  *
  * RETURNS:
  *   esp_err_t 結果ステータス
@@ -2007,8 +2218,7 @@ esp_err_t sts_com_msg_tx_plain_msg(uint64_t u64_device_id,
  * NOTES:
  * None.
  ******************************************************************************/
-esp_err_t sts_com_msg_tx_cipher_msg(uint64_t u64_device_id,
-                                    ts_u8_array_t* ps_data) {
+esp_err_t sts_com_msg_tx_reset_msg() {
     //==========================================================================
     // クリティカルセクション開始
     //==========================================================================
@@ -2017,49 +2227,9 @@ esp_err_t sts_com_msg_tx_cipher_msg(uint64_t u64_device_id,
     }
 
     //==========================================================================
-    // 主処理
+    // Resetメッセージ送信
     //==========================================================================
-    // 結果ステータス
-    esp_err_t sts_val = ESP_OK;
-    do {
-        //----------------------------------------------------------------------
-        // ペアリング済み判定
-        //----------------------------------------------------------------------
-        if (!b_is_paired(u64_device_id)) {
-            // 未ペアリング
-            sts_val = ESP_ERR_INVALID_STATE;
-            break;
-        }
-
-        //----------------------------------------------------------------------
-        // 接続判定
-        //----------------------------------------------------------------------
-        if (s_msg_ctrl_cfg.pf_connect_sts() != COM_BLE_MSG_CON_CONNECTED) {
-            // 未接続
-            sts_val = ESP_ERR_INVALID_STATE;
-            break;
-        }
-
-        //----------------------------------------------------------------------
-        // メッセージ生成
-        //----------------------------------------------------------------------
-        ts_u8_array_t* ps_msg = ps_create_msg_data(COM_BLE_MSG_TYP_CIPHERTEXT, ps_data);
-        if (ps_msg == NULL) {
-            sts_val = ESP_ERR_NO_MEM;
-            break;
-        }
-
-        //----------------------------------------------------------------------
-        // メッセージの送信
-        //----------------------------------------------------------------------
-        sts_val = s_msg_ctrl_cfg.pf_tx_msg(ps_msg);
-
-        //----------------------------------------------------------------------
-        // メッセージ解放
-        //----------------------------------------------------------------------
-        sts_mdl_delete_u8_array(ps_msg);
-
-    } while (false);
+    esp_err_t sts_val = sts_tx_reset_msg();
 
     //==========================================================================
     // クリティカルセクション終了
@@ -2071,41 +2241,11 @@ esp_err_t sts_com_msg_tx_cipher_msg(uint64_t u64_device_id,
 
 /*******************************************************************************
  *
- * NAME: sts_com_msg_delete_msg
- *
- * DESCRIPTION:メッセージの削除処理
- *
- * PARAMETERS:      Name        RW  Usage
- * ts_com_msg_t*    ps_msg      RW  メッセージ
- *
- * RETURNS:
- *   esp_err_t 結果ステータス
- *
- * NOTES:
- * None.
- ******************************************************************************/
-esp_err_t sts_com_msg_delete_msg(ts_com_msg_t* ps_msg) {
-    // 入力チェック
-    if (ps_msg == NULL) {
-        return ESP_ERR_INVALID_ARG;
-    }
-    // 本文のデータ
-    sts_mdl_delete_u8_array(ps_msg->ps_data);
-    ps_msg->ps_data = NULL;
-    // メッセージを解放
-    l_mem_free(ps_msg);
-    // 正常に削除
-    return ESP_OK;
-}
-
-/*******************************************************************************
- *
- * NAME: sts_com_msg_delete_ticket
+ * NAME: sts_com_msg_tx_ping_msg
  *
- * DESCRIPTION:チケットの削除処理
+ * DESCRIPTION:PINGメッセージの送信処理
  *
- * PARAMETERS:      Name            RW  Usage
- * uint64_t         u64_device_id   R   デバイスID
+ * PARAMETERS:              Name            RW  Usage
  *
  * RETURNS:
  *   esp_err_t 結果ステータス
@@ -2113,7 +2253,7 @@ esp_err_t sts_com_msg_delete_msg(ts_com_msg_t* ps_msg) {
  * NOTES:
  * None.
  ******************************************************************************/
-esp_err_t sts_com_msg_delete_ticket(uint64_t u64_device_id) {
+esp_err_t sts_com_msg_tx_ping_msg() {
     //==========================================================================
     // クリティカルセクション開始
     //==========================================================================
@@ -2122,41 +2262,25 @@ esp_err_t sts_com_msg_delete_ticket(uint64_t u64_device_id) {
     }
 
     //==========================================================================
-    // チケットの削除処理
+    // Pingメッセージ送信
     //==========================================================================
-    esp_err_t sts_val = ESP_OK;
-    do {
-        // キャッシュチケット
-        ts_com_msg_auth_ticket_t s_cache_ticket;
-        ts_com_msg_auth_ticket_t* ps_ticket = ps_read_ticket(u64_device_id, &s_cache_ticket);
-        if (ps_ticket == NULL) {
-            // 対象チケットなし
-            sts_val = ESP_ERR_NOT_FOUND;
-            break;
-        }
-        // チケットを削除
-        sts_val = s_msg_ctrl_cfg.pf_tkt_cb(COM_BLE_MSG_TICKET_EVT_DELETE, ps_ticket);
-        // チケットクリア ※リモートチケットキャッシュのクリアを想定
-        v_init_ticket(ps_ticket);
-    } while(false);
+    esp_err_t sts_val = sts_tx_ping_msg();
 
     //==========================================================================
     // クリティカルセクション終了
     //==========================================================================
     xSemaphoreGiveRecursive(s_mutex_sts);
 
-    // 結果返信
     return sts_val;
 }
 
 /*******************************************************************************
  *
- * NAME: sts_com_msg_clear_status
+ * NAME: sts_com_msg_tx_pairing_request
  *
- * DESCRIPTION:チケットステータスのクリア処理
+ * DESCRIPTION:ペアリング要求
  *
- * PARAMETERS:      Name            RW  Usage
- * uint64_t         u64_device_id   R   デバイスID
+ * PARAMETERS:              Name            RW  Usage
  *
  * RETURNS:
  *   esp_err_t 結果ステータス
@@ -2164,7 +2288,7 @@ esp_err_t sts_com_msg_delete_ticket(uint64_t u64_device_id) {
  * NOTES:
  * None.
  ******************************************************************************/
-esp_err_t sts_com_msg_clear_status(uint64_t u64_device_id) {
+esp_err_t sts_com_msg_tx_pairing_request() {
     //==========================================================================
     // クリティカルセクション開始
     //==========================================================================
@@ -2173,22 +2297,52 @@ esp_err_t sts_com_msg_clear_status(uint64_t u64_device_id) {
     }
 
     //==========================================================================
-    // チケットステータスのクリア処理
+    // 主処理
     //==========================================================================
-    // 結果ステータス
-    esp_err_t sts_val = ESP_ERR_NOT_FOUND;
+    esp_err_t sts_val = ESP_OK;
     do {
-        // キャッシュチケット
-        ts_com_msg_auth_ticket_t s_cache_ticket;
-        ts_com_msg_auth_ticket_t* ps_ticket = ps_read_ticket(u64_device_id, &s_cache_ticket);
-        if (ps_ticket == NULL) {
-            // 対象チケットなし
+        //----------------------------------------------------------------------
+        // ペアリングトランザクション開始
+        //----------------------------------------------------------------------
+        sts_val = sts_begin_pairing();
+        if (sts_val != ESP_OK) {
             break;
         }
-        // 自デバイスの受信ステータスを乱数で更新
-        b_vutil_set_u8_rand_array(ps_ticket->u8_own_sts, COM_MSG_SIZE_TICKET_STS);
-        // チケットを更新
-        sts_val = s_msg_ctrl_cfg.pf_tkt_cb(COM_BLE_MSG_TICKET_EVT_UPDATE, ps_ticket);
+        // クライアント側のX25519コンテキストの生成
+        ts_pairing_info_t* ps_pairing = &s_msg_ctrl_sts.s_pairing;
+        ps_pairing->ps_x25519_ctx = ps_crypto_x25519_client_context();
+        // 提案する認証モードと暗号スイート、送信ウィンドウサイズ、圧縮、コンテンツ種別（全て互換モードの場合は拡張無しで送信）
+        ps_pairing->e_auth_mode    = s_msg_ctrl_cfg.e_auth_mode;
+        ps_pairing->e_cipher_suite = s_msg_ctrl_cfg.e_cipher_suite;
+        ps_pairing->u8_tx_window   = s_msg_ctrl_cfg.u8_tx_window;
+        ps_pairing->b_compress     = ((s_msg_ctrl_cfg.s_func_ctl & MSG_FUNC_CTL_COMPRESS) != 0x00);
+        ps_pairing->b_content      = ((s_msg_ctrl_cfg.s_func_ctl & (MSG_FUNC_CTL_CONTENT | MSG_FUNC_CTL_BATCH)) != 0x00);
+        ps_pairing->b_win_ext      = (ps_pairing->u8_tx_window > 1 || ps_pairing->b_compress || ps_pairing->b_content);
+        ps_pairing->b_auth_ext     = (ps_pairing->e_auth_mode != COM_BLE_MSG_AUTH_HASH ||
+                                      ps_pairing->e_cipher_suite != COM_BLE_MSG_CIPHER_AES_GCM ||
+                                      ps_pairing->b_win_ext);
+
+        //----------------------------------------------------------------------
+        // ペアリング要求の送信処理
+        //----------------------------------------------------------------------
+        // メッセージの生成
+        ts_u8_array_t* ps_msg_data = ps_create_msg_data(COM_BLE_MSG_TYP_PAIRING_REQ, NULL);
+        if (ps_msg_data == NULL) {
+            // メッセージ生成エラー
+            sts_val = ESP_ERR_NO_MEM;
+            // トランザクション終了
+            v_msg_ctrl_sts_transaction_reset();
+            break;
+        }
+        // ペアリング要求送信
+        sts_val = s_msg_ctrl_cfg.pf_tx_msg(ps_msg_data);
+        if (sts_val != ESP_OK) {
+            // トランザクション終了
+            v_msg_ctrl_sts_transaction_reset();
+            break;
+        }
+        // 生成したメッセージを解放
+        sts_mdl_delete_u8_array(ps_msg_data);
     } while(false);
 
     //==========================================================================
@@ -2200,2477 +2354,5246 @@ esp_err_t sts_com_msg_clear_status(uint64_t u64_device_id) {
     return sts_val;
 }
 
-
-/******************************************************************************/
-/***      Local Functions                                                   ***/
-/******************************************************************************/
-
 /*******************************************************************************
  *
- * NAME: sts_msg_begin_daemon_task
+ * NAME: sts_com_msg_tx_pairing_certification
  *
- * DESCRIPTION:begin message daemon task
+ * DESCRIPTION:ペアリング認証（ダイジェスト比較結果の通知）
  *
- * PARAMETERS:  Name            RW  Usage
+ * PARAMETERS:      Name            RW  Usage
+ * bool             b_result        R   承認結果
+ * uint32_t         u32_max_seq_no  R   最大シーケンス番号
  *
  * RETURNS:
+ *   esp_err_t 結果ステータス
  *
  * NOTES:
  * None.
  ******************************************************************************/
-static esp_err_t sts_msg_begin_daemon_task() {
+esp_err_t sts_com_msg_tx_pairing_certification(bool b_result, uint32_t u32_max_seq_no) {
     //==========================================================================
-    // メッセージ受信デーモンタスクの開始
+    // クリティカルセクション開始
     //==========================================================================
-    // 受信メッセージのキュー生成
-    if (s_msg_deamon_sts.s_rx_queue_handle == NULL) {
-        s_msg_deamon_sts.s_rx_queue_handle = xQueueCreate(COM_MSG_RX_QUEUE_SIZE, sizeof(ts_com_msg_t*));
-    }
-    if (s_msg_deamon_sts.s_rx_queue_handle == NULL) {
-        // 受信メッセージのキュー生成エラー
-        return ESP_FAIL;
-    }
-    // メッセージ受信デーモンの開始
-    portBASE_TYPE b_rx_type = xTaskCreatePinnedToCore(v_msg_rx_daemon_task,
-                                                      "msg_rx_deamon_task",
-                                                      COM_MSG_RX_DEAMON_STACK_DEPTH,
-                                                      (void*)s_msg_deamon_sts.s_rx_queue_handle,
-                                                      COM_MSG_RX_DEAMON_PRIORITIES,
-                                                      &s_msg_deamon_sts.s_rx_deamon_handle,
-                                                      tskNO_AFFINITY);
-    if (b_rx_type != pdPASS) {
-        // 受信デーモン開始に失敗
-        return ESP_FAIL;
+    if (xSemaphoreTakeRecursive(s_mutex_sts, portMAX_DELAY) != pdTRUE) {
+        return ESP_ERR_TIMEOUT;
     }
 
     //==========================================================================
-    // イベント通知デーモンタスクの開始
+    // 主処理
     //==========================================================================
-    // デーモンにイベント通知するキュー生成
-    if (s_msg_deamon_sts.s_evt_queue_handle == NULL) {
-        s_msg_deamon_sts.s_evt_queue_handle = xQueueCreate(COM_MSG_EVT_QUEUE_SIZE, sizeof(te_com_ble_msg_event));
-    }
-    if (s_msg_deamon_sts.s_evt_queue_handle == NULL) {
-        // イベント通知キューの生成エラー
-        return ESP_FAIL;
-    }
-    // イベント通知デーモンタスクの開始
-    portBASE_TYPE b_evt_type = xTaskCreatePinnedToCore(v_msg_evt_daemon_task,
-                                                       "msg_evt_deamon_task",
-                                                       COM_MSG_EVT_DEAMON_STACK_DEPTH,
-                                                       (void*)s_msg_deamon_sts.s_evt_queue_handle,
-                                                       COM_MSG_EVT_DEAMON_PRIORITIES,
-                                                       &s_msg_deamon_sts.s_evt_deamon_handle,
-                                                       tskNO_AFFINITY);
-    if (b_evt_type != pdPASS) {
-        // デーモン開始に失敗
-        return ESP_FAIL;
-    }
-
-    // 正常終了
-    return ESP_OK;
-}
-
-/*******************************************************************************
- *
- * NAME: v_msg_rx_daemon_task
- *
- * DESCRIPTION:message receiving daemon task
- *
- * PARAMETERS:  Name            RW  Usage
- * void*        pv_parameters   R   パラメータ
- *
- * RETURNS:
- *
- * NOTES:
- * None.
- ******************************************************************************/
-static void v_msg_rx_daemon_task(void* pv_parameters) {
-    // 現在時刻
-    int64_t i64_now_msec = xTaskGetTickCountMSec();
-    // 次の遅延時間
-    int64_t i64_next_delay_msec = i64_now_msec + COM_MSG_DEAMON_DELAY_INTERVAL_MSEC;
-    // パラメータから受信キューハンドルを取得
-    QueueHandle_t s_rx_handle = (QueueHandle_t)pv_parameters;
-    // 受信結果ステータス
-    te_com_ble_msg_rcv_sts_t e_rcv_sts = COM_BLE_MSG_RCV_NOT_FOUND;
-    // 受信メッセージ
-    ts_com_msg_t s_rx_msg = {0};
-    // 受信メッセージ（キュー投入用）
-    ts_com_msg_t* ps_rx_msg = NULL;
-    // 受信フィルター
-    uint32_t u32_rx_flt = 0;
-    // タイムアウト時刻
-    TickType_t t_timeout = 0;
-    // デーモンプロセスの無限ループ
-    while (true) {
+    esp_err_t sts_val = ESP_OK;
+    bool b_end_tran = false;
+    te_com_ble_msg_event e_evt = COM_BLE_MSG_EVT_PAIRING_SUCCESS;
+    do {
         //======================================================================
-        // 遅延処理　※Watchdog timer measures
+        // 状態チェック
         //======================================================================
-        i64_now_msec = xTaskGetTickCountMSec();
-        if (i64_now_msec >= i64_next_delay_msec) {
-            // 遅延処理
-            vTaskDelay(1);
-            // 遅延時間更新
-            i64_next_delay_msec = i64_now_msec + COM_MSG_DEAMON_DELAY_INTERVAL_MSEC;
+        //----------------------------------------------------------------------
+        // ペアリング機能の有効判定
+        //----------------------------------------------------------------------
+        if ((s_msg_ctrl_cfg.s_func_ctl & MSG_FUNC_CTL_PAIRING) == 0x00) {
+            // 機能無効
+            sts_val = ESP_ERR_INVALID_STATE;
+            break;
         }
 
-        //======================================================================
-        // トランザクションタイムアウト処理
-        //======================================================================
-        // クリティカルセクション開始
-        if (xSemaphoreTakeRecursive(s_mutex_sts, portMAX_DELAY) != pdTRUE) {
-            continue;
+        //----------------------------------------------------------------------
+        // トランザクション開始判定
+        //----------------------------------------------------------------------
+        ts_transaction_info_t* ps_tran = &s_msg_ctrl_sts.s_tran;
+        if (ps_tran->e_sts != COM_BLE_MSG_TRN_PAIRING) {
+            // ペアリングトランザクションが開始していない
+            sts_val = ESP_ERR_INVALID_STATE;
+            break;
         }
 
-        // トランザクションタイムアウト判定
-        ts_transaction_info_t* ps_tran = &s_msg_ctrl_sts.s_tran;
+        //----------------------------------------------------------------------
+        // ペアリング認証済み判定
+        //----------------------------------------------------------------------
+        ts_pairing_info_t* ps_pairing = &s_msg_ctrl_sts.s_pairing;
+        if ((ps_pairing->e_sts & MSG_PAIRING_CHK_LOCAL) != 0x00) {
+            // 既に認証済み
+            sts_val = ESP_ERR_INVALID_STATE;
+            b_end_tran = true;
+            break;
+        }
+
+        //----------------------------------------------------------------------
+        // タイムアウト判定
+        //----------------------------------------------------------------------
         if (ps_tran->u32_timeout_ms < xTaskGetTickCountMSec()) {
-            // トランザクションタイムアウト
-            v_msg_ctrl_sts_transaction_timeout();
+            // タイムアウト
+            sts_val = ESP_ERR_TIMEOUT;
+            b_end_tran = true;
+            break;
         }
 
-        // クリティカルセクション終了
-        xSemaphoreGiveRecursive(s_mutex_sts);
+        //----------------------------------------------------------------------
+        // 接続判定
+        //----------------------------------------------------------------------
+        if (s_msg_ctrl_cfg.pf_connect_sts() != COM_BLE_MSG_CON_CONNECTED) {
+            // 未接続
+            sts_val = ESP_ERR_INVALID_STATE;
+            break;
+        }
 
-        //======================================================================
-        // メッセージ受信処理
-        //======================================================================
-        // メッセージ受信
-        e_rcv_sts = e_rx_message(&s_rx_msg, COM_MSG_RX_CHK_TIMEOUT);
-        // 受信メッセージの有無を判定
-        if (e_rcv_sts == COM_BLE_MSG_RCV_NOT_FOUND) {
-            continue;
+        //----------------------------------------------------------------------
+        // 公開鍵の受信済み判定
+        //----------------------------------------------------------------------
+        if (!b_is_public_key_received()) {
+            // 公開鍵未受信
+            sts_val = ESP_ERR_INVALID_STATE;
+            break;
         }
 
         //======================================================================
-        // 受信メッセージ処理
+        // 認証通知処理
         //======================================================================
-        if (e_rcv_sts == COM_BLE_MSG_RCV_NORMAL) {
-            // クリティカルセクション開始
-            if (xSemaphoreTakeRecursive(s_mutex_sts, portMAX_DELAY) != pdTRUE) {
-                continue;
-            }
+        //----------------------------------------------------------------------
+        // ステータス判定
+        //----------------------------------------------------------------------
+        te_com_ble_msg_type_t e_result;
+        if (b_result) {
+            // ダイジェスト一致
+            e_result = COM_BLE_MSG_TYP_DIGEST_MATCH;
+            ps_pairing->e_sts |= MSG_PAIRING_CHK_LOCAL;
+            // 最大シーケンス番号の更新(後に認証した方が優先される)
+            ps_pairing->u32_max_seq_no = u32_max_seq_no;
+        } else {
+            // ダイジェスト不一致
+            e_result = COM_BLE_MSG_TYP_DIGEST_ERR;
+            b_end_tran = true;
+            e_evt = COM_BLE_MSG_EVT_PAIRING_ERR;
+        }
 
-            //------------------------------------------------------------------
-            // 受信メッセージチェック
-            //------------------------------------------------------------------
-            e_rcv_sts = e_rx_msg_check(&s_rx_msg);
-            if (e_rcv_sts == COM_BLE_MSG_RCV_NORMAL) {
-                // メッセージ受信イベント処理を実行
-                e_rcv_sts = e_rx_msg_event(&s_rx_msg);
+        //----------------------------------------------------------------------
+        // チケット生成判定
+        //----------------------------------------------------------------------
+        if (ps_pairing->e_sts == MSG_PAIRING_CHK_ALL) {
+            // ダイジェスト一致
+            b_end_tran = true;
+            // チケットの生成
+            sts_val = sts_create_ticket(ps_tran, ps_pairing);
+            if (sts_val != ESP_OK) {
+                e_evt = COM_BLE_MSG_EVT_PAIRING_ERR;
+                break;
             }
-
-            //------------------------------------------------------------------
-            // メッセージ受信キューのフィルタ設定
-            //------------------------------------------------------------------
-            u32_rx_flt = s_msg_deamon_sts.u32_rx_enqueue_filter;
-
-            // クリティカルセクション終了
-            xSemaphoreGiveRecursive(s_mutex_sts);
         }
 
-        //======================================================================
-        // 受信処理の結果判定
-        //======================================================================
-        // 受信エラー判定
-        if (e_rcv_sts != COM_BLE_MSG_RCV_NORMAL) {
-            // 受信エラーの場合
-            // 本文のデータが有ればクリアしてからリトライ
-            sts_mdl_delete_u8_array(s_rx_msg.ps_data);
-            s_rx_msg.ps_data = NULL;
-            continue;
+        //----------------------------------------------------------------------
+        // ペアリング結果の通知
+        //----------------------------------------------------------------------
+        // メッセージ生成
+        ts_u8_array_t* ps_msg_data = ps_create_msg_data(e_result, NULL);
+        if (ps_msg_data == NULL) {
+            sts_val = ESP_ERR_NO_MEM;
+            b_end_tran = true;
+            e_evt = COM_BLE_MSG_EVT_PAIRING_ERR;
+            break;
         }
-        // エンキュー対象か判定
-        if ((u32_rx_flt & (0x00000001 << s_rx_msg.e_type)) == 0x00000000) {
-            // エンキュー対象外の場合
-            // 本文のデータが有ればクリアしてからリトライ
-            sts_mdl_delete_u8_array(s_rx_msg.ps_data);
-            s_rx_msg.ps_data = NULL;
-            continue;
+        // ペアリング結果送信
+        sts_val = s_msg_ctrl_cfg.pf_tx_msg(ps_msg_data);
+        // 生成したメッセージを解放
+        sts_mdl_delete_u8_array(ps_msg_data);
+        // 結果ステータス判定
+        if (sts_val != ESP_OK) {
+            b_end_tran = true;
+            e_evt = COM_BLE_MSG_EVT_PAIRING_ERR;
+            break;
         }
+    } while(false);
 
-        //======================================================================
-        // 受信メッセージをクローン
-        //======================================================================
-        ps_rx_msg = (ts_com_msg_t*)pv_mem_clone((void*)&s_rx_msg, sizeof(ts_com_msg_t));
-        // オリジナルの本文データをクリアする
-        s_rx_msg.ps_data = NULL;
-
-        //======================================================================
-        // 受信メッセージエンキュー処理
-        //======================================================================
-        // 接続してサービス検索完了までウェイト
-        t_timeout = xTaskGetTickCount() + COM_MSG_QUEUE_TIMEOUT;
-        // 成功するまで実行
-        while (xQueueSendToBack(s_rx_handle, &ps_rx_msg, COM_MSG_RETRY_WAIT) != pdPASS) {
-            // タイムアウト判定
-            if (t_timeout < xTaskGetTickCount()) {
-                // メッセージを解放してからリトライ
-                sts_com_msg_delete_msg(ps_rx_msg);
-                ps_rx_msg = NULL;
-                break;
-            }
-        }
+    //==========================================================================
+    // 終了処理
+    //==========================================================================
+    // トランザクション終了判定
+    if (b_end_tran) {
+        // イベントエンキュー
+        v_msg_evt_enqueue(e_evt);
+        // トランザクション終了
+        v_msg_ctrl_sts_transaction_reset();
     }
+
+    //==========================================================================
+    // クリティカルセクション終了
+    //==========================================================================
+    xSemaphoreGiveRecursive(s_mutex_sts);
+
+    // 結果返信
+    return sts_val;
 }
 
 /*******************************************************************************
  *
- * NAME: v_msg_evt_daemon_task
+ * NAME: sts_com_msg_tx_sts_chk_request
  *
- * DESCRIPTION:event processing daemon task
+ * DESCRIPTION:ステータスチェック要求処理
  *
- * PARAMETERS:  Name            RW  Usage
- * void*        pv_parameters   R   パラメータ
+ * PARAMETERS:              Name            RW  Usage
  *
  * RETURNS:
+ *   esp_err_t 結果ステータス
  *
  * NOTES:
  * None.
  ******************************************************************************/
-static void v_msg_evt_daemon_task(void* pv_parameters) {
-    // 現在時刻
-    int64_t i64_now_msec = xTaskGetTickCountMSec();
-    // 次の遅延時間
-    int64_t i64_next_delay_msec = i64_now_msec + COM_MSG_DEAMON_DELAY_INTERVAL_MSEC;
-    // パラメータからイベントキューハンドルを取得
-    QueueHandle_t s_evt_handle = (QueueHandle_t)pv_parameters;
-    // イベント種別
-    te_com_ble_msg_event e_msg_evt;
-    // デーモンプロセスの無限ループ
-    while (true) {
-        //======================================================================
-        // 遅延処理　※Watchdog timer measures
-        //======================================================================
-        i64_now_msec = xTaskGetTickCountMSec();
-        if (i64_now_msec >= i64_next_delay_msec) {
-            // 遅延処理
-            vTaskDelay(1);
-            // 遅延時間更新
-            i64_next_delay_msec = i64_now_msec + COM_MSG_DEAMON_DELAY_INTERVAL_MSEC;
-        }
+esp_err_t sts_com_msg_tx_sts_chk_request() {
+    //==========================================================================
+    // クリティカルセクション開始
+    //==========================================================================
+    if (xSemaphoreTakeRecursive(s_mutex_sts, portMAX_DELAY) != pdTRUE) {
+        return ESP_ERR_TIMEOUT;
+    }
 
-        //======================================================================
-        // イベントの読み込み
-        //======================================================================
-        if (xQueueReceive(s_evt_handle, &e_msg_evt, COM_MSG_EVT_CHK_TIMEOUT) != pdPASS) {
-            continue;
+    //==========================================================================
+    // 主処理
+    //==========================================================================
+    // 結果ステータス
+    esp_err_t sts_val = ESP_OK;
+    do {
+        //----------------------------------------------------------------------
+        // ステータスチェックトランザクション開始
+        //----------------------------------------------------------------------
+        sts_val = sts_begin_sts_chk();
+        if (sts_val != ESP_OK) {
+            break;
         }
 
-        //======================================================================
-        // RESET送信イベント判定
-        //======================================================================
-        if (e_msg_evt == COM_BLE_MSG_EVT_LINK_SUCCESS) {
-            // RESET送信イベント
-            // 接続ステータス判定
-            te_com_ble_msg_connection_sts_t e_con_sts = s_msg_ctrl_cfg.pf_connect_sts();
-            if (e_con_sts != COM_BLE_MSG_CON_CONNECTED) {
-                continue;
-            }
-
-            //------------------------------------------------------------------
-            // クリティカルセクション開始
-            //------------------------------------------------------------------
-            if (xSemaphoreTakeRecursive(s_mutex_sts, portMAX_DELAY) != pdTRUE) {
-                continue;
-            }
-
-            //------------------------------------------------------------------
-            // リモートBLEアドレスを編集
-            //------------------------------------------------------------------
-            v_com_ble_addr_cpy(s_msg_ctrl_sts.t_rmt_bda, s_msg_ctrl_sts.s_tran.t_bda);
-
-            //------------------------------------------------------------------
-            // トランザクションリセット
-            //------------------------------------------------------------------
+        //----------------------------------------------------------------------
+        // ステータスチェック要求の送信処理
+        //----------------------------------------------------------------------
+        // メッセージの生成
+        ts_u8_array_t* ps_msg_data = ps_create_msg_data(COM_BLE_MSG_TYP_STATUS_REQ, NULL);
+        if (ps_msg_data == NULL) {
+            // トランザクション終了
+            sts_val = ESP_ERR_NO_MEM;
+            // トランザクション終了
             v_msg_ctrl_sts_transaction_reset();
-
-            //------------------------------------------------------------------
-            // クリティカルセクション終了
-            //------------------------------------------------------------------
-            xSemaphoreGiveRecursive(s_mutex_sts);
-
-            //------------------------------------------------------------------
-            // Resetメッセージ送信
-            // ※内部にクリティカルセクション有り
-            //------------------------------------------------------------------
-            while (sts_com_msg_tx_reset_msg() != ESP_OK) {
-                vTaskDelay(COM_MSG_RETRY_WAIT);
-            }
-        } else if (e_msg_evt == COM_BLE_MSG_EVT_GATT_DISCONNECT) {
-            // メッセージ機能のコネクションを切断 ※スレッドセーフ
-            sts_com_msg_close();
+            break;
         }
-        // イベントコールバック
-        s_msg_ctrl_cfg.pf_evt_cb(e_msg_evt);
-    }
+        // ステータスチェック要求の送信
+        sts_val = s_msg_ctrl_cfg.pf_tx_msg(ps_msg_data);
+        // 生成したメッセージを解放
+        sts_mdl_delete_u8_array(ps_msg_data);
+        if (sts_val != ESP_OK) {
+            // トランザクション終了
+            v_msg_ctrl_sts_transaction_reset();
+            break;
+        }
+    } while (false);
+
+    //==========================================================================
+    // クリティカルセクション終了
+    //==========================================================================
+    xSemaphoreGiveRecursive(s_mutex_sts);
 
+    // 結果返信
+    return sts_val;
 }
 
 /*******************************************************************************
  *
- * NAME: v_msg_evt_enqueue
+ * NAME: sts_com_msg_tx_plain_msg
  *
- * DESCRIPTION:message event enqueue processing
+ * DESCRIPTION:平文メッセージの送信処理
  *
- * PARAMETERS:          Name            RW  Usage
- * te_com_ble_msg_event e_msg_evt       R   メッセージイベント
+ * PARAMETERS:              Name            RW  Usage
+ * uint64_t                 u64_device_id   R   デバイスID
+ * ts_u8_array_t*           ps_data         R   送信メッセージデータ
  *
  * RETURNS:
+ *   esp_err_t 結果ステータス
  *
  * NOTES:
  * None.
  ******************************************************************************/
-static void v_msg_evt_enqueue(te_com_ble_msg_event e_msg_evt) {
+esp_err_t sts_com_msg_tx_plain_msg(uint64_t u64_device_id,
+                                   ts_u8_array_t* ps_data) {
     //==========================================================================
-    // イベントエンキュー
+    // クリティカルセクション開始
     //==========================================================================
-    int i_cnt;
-    for (i_cnt = 0; i_cnt < COM_MSG_EVT_MAX_RETRY_CNT; i_cnt++) {
-        if (xQueueSendToBack(s_msg_deamon_sts.s_evt_queue_handle, &e_msg_evt, COM_MSG_RETRY_WAIT) == pdPASS) {
+    if (xSemaphoreTakeRecursive(s_mutex_sts, portMAX_DELAY) != pdTRUE) {
+        return ESP_ERR_TIMEOUT;
+    }
+
+    //==========================================================================
+    // 主処理
+    //==========================================================================
+    // 結果ステータス
+    esp_err_t sts_val = ESP_OK;
+    // メッセージ
+    ts_u8_array_t* ps_msg = NULL;
+    do {
+        //----------------------------------------------------------------------
+        // 接続判定
+        //----------------------------------------------------------------------
+        if (s_msg_ctrl_cfg.pf_connect_sts() != COM_BLE_MSG_CON_CONNECTED) {
+            // 未接続
+            sts_val = ESP_ERR_INVALID_STATE;
             break;
         }
-    }
+
+        //----------------------------------------------------------------------
+        // メッセージ生成
+        //----------------------------------------------------------------------
+        ps_msg = ps_create_msg_data(COM_BLE_MSG_TYP_DATA, ps_data);
+        if (ps_msg == NULL) {
+            // メッセージ生成エラー
+            sts_val = ESP_ERR_NO_MEM;
+            break;
+        }
+
+        //----------------------------------------------------------------------
+        // メッセージの送信
+        //----------------------------------------------------------------------
+        sts_val = s_msg_ctrl_cfg.pf_tx_msg(ps_msg);
+    } while(false);
+
+    // 送信メッセージ解放
+    sts_mdl_delete_u8_array(ps_msg);
+
+    //==========================================================================
+    // クリティカルセクション終了
+    //==========================================================================
+    xSemaphoreGiveRecursive(s_mutex_sts);
+
+    return sts_val;
 }
 
 /*******************************************************************************
  *
- * NAME: v_msg_ctrl_sts_init
+ * NAME: sts_com_msg_tx_cipher_msg
  *
- * DESCRIPTION:Message Controller init
+ * DESCRIPTION:暗号文メッセージの送信処理
  *
- * PARAMETERS:  Name            RW  Usage
+ * PARAMETERS:              Name            RW  Usage
+ * uint64_t                 u64_device_id   R   デバイスID
+ * ts_u8_array_t*           ps_data         R   送信メッセージデータ
  *
  * RETURNS:
+ *   esp_err_t 結果ステータス
  *
  * NOTES:
- * None.
+ * アプリケーションデータのコンテンツ種別で送信する。
+ * 送信ウィンドウの空き待ちではs_mutex_stsを解放して確認応答を待つ為、
+ * チケットアクセスコールバック内等、s_mutex_stsを取得した状態で呼び出さない事
+ * （取得した状態で空き待ちになった場合はESP_ERR_INVALID_STATE）。
  ******************************************************************************/
-static void v_msg_ctrl_sts_init() {
-    //==========================================================================
-    // カウンタリセット
-    //==========================================================================
-    // 送信カウンタ
-    s_msg_ctrl_sts.u64_tx_count = 0;
-    // 受信カウンタ
-    s_msg_ctrl_sts.u64_rx_count = 0;
-
-    //==========================================================================
-    // コネクションステータスリセット
-    //==========================================================================
-    v_msg_ctrl_sts_connection_reset();
+esp_err_t sts_com_msg_tx_cipher_msg(uint64_t u64_device_id,
+                                    ts_u8_array_t* ps_data) {
+    return sts_com_msg_tx_cipher_content(u64_device_id, COM_BLE_MSG_CONTENT_APP, ps_data);
 }
 
 /*******************************************************************************
  *
- * NAME: v_msg_ctrl_sts_connection_reset
+ * NAME: sts_com_msg_tx_cipher_content
  *
- * DESCRIPTION:Message Controller Connection Reset
+ * DESCRIPTION:コンテンツ種別を指定した暗号文メッセージの送信処理
  *
- * PARAMETERS:      Name            RW  Usage
+ * PARAMETERS:              Name            RW  Usage
+ * uint64_t                 u64_device_id   R   デバイスID
+ * te_com_ble_msg_content_t e_content       R   コンテンツ種別
+ * ts_u8_array_t*           ps_data         R   送信メッセージデータ
  *
  * RETURNS:
+ *   esp_err_t 結果ステータス（ESP_ERR_NOT_SUPPORTED:コンテンツ種別を合意していない）
  *
  * NOTES:
- * None.
+ * コンテンツ種別を合意している場合は平文の先頭に種別を付与し、受信側はメッセージの
+ * e_contentで判別する。合意していない場合はアプリケーションデータのみ送信出来る。
+ * 送信ウィンドウの空き待ちではs_mutex_stsを解放して確認応答を待つ為、
+ * チケットアクセスコールバック内等、s_mutex_stsを取得した状態で呼び出さない事
+ * （取得した状態で空き待ちになった場合はESP_ERR_INVALID_STATE）。
  ******************************************************************************/
-static void v_msg_ctrl_sts_connection_reset() {
+esp_err_t sts_com_msg_tx_cipher_content(uint64_t u64_device_id,
+                                        te_com_ble_msg_content_t e_content,
+                                        ts_u8_array_t* ps_data) {
+    // 入力チェック
+    if (e_content >= COM_BLE_MSG_CONTENT_CNT) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
     //==========================================================================
     // クリティカルセクション開始
     //==========================================================================
     if (xSemaphoreTakeRecursive(s_mutex_sts, portMAX_DELAY) != pdTRUE) {
-        return;
+        return ESP_ERR_TIMEOUT;
     }
 
     //==========================================================================
-    // コネクションリセット処理
+    // 主処理
     //==========================================================================
+    // 結果ステータス
+    esp_err_t sts_val = ESP_OK;
     do {
         //----------------------------------------------------------------------
-        // 受信データのクリア
+        // 送信ウィンドウの空き待ち（ウィンドウ制御を合意している場合のみ）
         //----------------------------------------------------------------------
-        s_msg_ctrl_cfg.pf_rx_clear();
+        bool b_window = (u8_tx_window_size() > 1);
+        if (b_window) {
+            // 待機中はクリティカルセクションを一時的に解放する為、判定処理より前に実施
+            sts_val = sts_tx_window_acquire();
+            if (sts_val != ESP_OK) {
+                break;
+            }
+        }
 
         //----------------------------------------------------------------------
-        // リモートデバイス情報をクリア
+        // ペアリング済み判定
         //----------------------------------------------------------------------
-        // リモートデバイスID
-        s_msg_ctrl_sts.u64_rmt_device_id = s_msg_ctrl_cfg.u64_device_id;
-        // リモートデバイスBLEアドレス
-        v_com_ble_addr_clear(s_msg_ctrl_sts.t_rmt_bda);
-        // リモートデバイスチケット
-        v_init_ticket(&s_msg_ctrl_sts.s_rmt_ticket);
+        if (!b_is_paired(u64_device_id)) {
+            // 未ペアリング
+            sts_val = ESP_ERR_INVALID_STATE;
+            break;
+        }
 
         //----------------------------------------------------------------------
-        // 送受信履歴のクリア
+        // 接続判定
         //----------------------------------------------------------------------
-        // 直前の送信履歴
-        v_msg_history_reset(&s_msg_ctrl_sts.s_bef_tx_msg);
-        // 直前の受信履歴
-        v_msg_history_reset(&s_msg_ctrl_sts.s_bef_rx_msg);
-        // 直前の返信履歴
-        v_msg_history_reset(&s_msg_ctrl_sts.s_bef_rx_rsp);
+        if (s_msg_ctrl_cfg.pf_connect_sts() != COM_BLE_MSG_CON_CONNECTED) {
+            // 未接続
+            sts_val = ESP_ERR_INVALID_STATE;
+            break;
+        }
 
         //----------------------------------------------------------------------
-        // トランザクションステータスリセット
+        // コンテンツ種別の付与（合意している場合のみ）
         //----------------------------------------------------------------------
-        v_msg_ctrl_sts_transaction_reset();
+        ts_u8_array_t* ps_content = NULL;
+        if (b_msg_content_enabled()) {
+            size_t t_data_len = (ps_data != NULL) ? ps_data->t_size : 0;
+            ps_content = ps_mdl_empty_u8_array(MSG_SIZE_CONTENT_TYPE + t_data_len);
+            if (ps_content == NULL) {
+                sts_val = ESP_ERR_NO_MEM;
+                break;
+            }
+            ps_content->pu8_values[0] = e_content;
+            if (t_data_len > 0) {
+                memcpy(&ps_content->pu8_values[MSG_SIZE_CONTENT_TYPE], ps_data->pu8_values, t_data_len);
+            }
+        } else if (e_content != COM_BLE_MSG_CONTENT_APP) {
+            // コンテンツ種別を合意していない
+            sts_val = ESP_ERR_NOT_SUPPORTED;
+            break;
+        }
 
         //----------------------------------------------------------------------
-        // BLEコネクションリセット
+        // メッセージ生成
         //----------------------------------------------------------------------
-        v_com_ble_gattc_delete_con_info(s_msg_ctrl_sts.ps_con);
-        s_msg_ctrl_sts.ps_con = NULL;
-    } while(false);
+        ts_u8_array_t* ps_msg = ps_create_msg_data(COM_BLE_MSG_TYP_CIPHERTEXT, (ps_content != NULL) ? ps_content : ps_data);
+        sts_mdl_delete_u8_array(ps_content);
+        if (ps_msg == NULL) {
+            sts_val = ESP_ERR_NO_MEM;
+            break;
+        }
+
+        //----------------------------------------------------------------------
+        // メッセージの送信
+        //----------------------------------------------------------------------
+        sts_val = s_msg_ctrl_cfg.pf_tx_msg(ps_msg);
+
+        //----------------------------------------------------------------------
+        // メッセージ解放（ウィンドウ制御時は応答受信まで再送用に保持）
+        //----------------------------------------------------------------------
+        if (b_window && sts_val == ESP_OK) {
+            sts_val = sts_tx_window_push(ps_msg);
+        } else {
+            sts_mdl_delete_u8_array(ps_msg);
+        }
+
+    } while (false);
 
     //==========================================================================
     // クリティカルセクション終了
     //==========================================================================
     xSemaphoreGiveRecursive(s_mutex_sts);
+
+    return sts_val;
 }
 
 /*******************************************************************************
  *
- * NAME: v_msg_ctrl_sts_transaction_reset
+ * NAME: sts_com_msg_tx_cipher_batch
  *
- * DESCRIPTION:Message Controller transaction clear
+ * DESCRIPTION:暗号メッセージのバッチ送信処理
  *
- * PARAMETERS:  Name            RW  Usage
+ * PARAMETERS:      Name            RW  Usage
+ * uint64_t         u64_device_id   R   送信先デバイスID
+ * ts_u8_array_t*   ps_data         R   送信データ
  *
  * RETURNS:
+ *   esp_err_t 結果ステータス
  *
  * NOTES:
- * None.
+ * 最大遅延時間内の送信データを１件の暗号メッセージ（コンテナ）に集約して送信する。
+ * 最大サイズに達した場合や送信先が変わった場合は即時に送信し、
+ * 集約出来ないサイズのデータは通常の暗号メッセージとして送信する。
+ * コンテナはコンテンツ種別（バッチ）を付与して送信するので、バッチ送受信が無効の場合や
+ * ペアリング時にコンテンツ種別を合意していない場合は通常の暗号メッセージ送信と同じ。
+ * 集約したデータの送信結果は返さない（送信エラーはコネクションの切断で検知する事）。
  ******************************************************************************/
-static void v_msg_ctrl_sts_transaction_reset() {
-    //--------------------------------------------------------------------------
-    // トランザクション状態判定
-    //--------------------------------------------------------------------------
-    ts_transaction_info_t* ps_tran = &s_msg_ctrl_sts.s_tran;
-    if (ps_tran->e_sts == COM_BLE_MSG_TRN_NONE) {
-        return;
+esp_err_t sts_com_msg_tx_cipher_batch(uint64_t u64_device_id, ts_u8_array_t* ps_data) {
+    // 入力チェック
+    if (ps_data == NULL || ps_data->t_size > U16_MAX) {
+        return ESP_ERR_INVALID_ARG;
     }
 
-    //--------------------------------------------------------------------------
-    // トランザクションステータス
-    //--------------------------------------------------------------------------
-    ps_tran->e_sts         = COM_BLE_MSG_TRN_NONE;          // トランザクションステータス
-    ps_tran->u64_device_id = s_msg_ctrl_cfg.u64_device_id;  // トランザクション実行中の相手デバイスID
-    v_com_ble_addr_clear(ps_tran->t_bda);                   // トランザクション実行中の相手デバイスBLEアドレス
-    ps_tran->u32_timeout_ms = U32_MAX;                      // トランザクションタイムアウト
+    //==========================================================================
+    // クリティカルセクション開始
+    //==========================================================================
+    if (xSemaphoreTakeRecursive(s_mutex_sts, portMAX_DELAY) != pdTRUE) {
+        return ESP_ERR_TIMEOUT;
+    }
 
-    //--------------------------------------------------------------------------
-    // ペアリングステータス
-    //--------------------------------------------------------------------------
-    ts_pairing_info_t* ps_pairing = &s_msg_ctrl_sts.s_pairing;
-    // ペアリングステータス
-    ps_pairing->e_sts = MSG_PAIRING_CHK_NONE;
-    // 共通鍵
-    memset(ps_pairing->u8_com_key, 0x00, COM_MSG_SIZE_CIPHER_KEY);
-    // X25519コンテキスト
-    v_crypto_x25519_delete_context(ps_pairing->ps_x25519_ctx);
-    ps_pairing->ps_x25519_ctx = NULL;
-    // 自デバイスステータス
-    memset(ps_pairing->u8_dev_status, 0x00, COM_MSG_SIZE_TICKET_STS);
-    // 相手デバイスステータスハッシュ
-    memset(ps_pairing->u8_rmt_sts_hash, 0x00, COM_MSG_SIZE_TICKET_STS);
-    // 最大シーケンス番号
-    ps_pairing->u32_max_seq_no = 0;
+    //==========================================================================
+    // コンテナへの集約
+    //==========================================================================
+    // 結果ステータス
+    esp_err_t sts_val = ESP_OK;
+    // 先に送信するコンテナ
+    ts_u8_array_t* ps_prev = NULL;
+    uint64_t u64_prev_id = 0;
+    // 集約後に送信するコンテナ
+    ts_u8_array_t* ps_full = NULL;
+    // 集約せずに送信するか
+    bool b_direct = false;
+    ts_msg_batch_t* ps_batch = &s_msg_ctrl_sts.s_batch;
+    do {
+        //----------------------------------------------------------------------
+        // バッチ送信判定
+        //----------------------------------------------------------------------
+        if ((s_msg_ctrl_cfg.s_func_ctl & MSG_FUNC_CTL_BATCH) == 0x00) {
+            b_direct = true;
+            break;
+        }
+        // ペアリング済み判定
+        if (!b_is_paired(u64_device_id)) {
+            sts_val = ESP_ERR_INVALID_STATE;
+            break;
+        }
+        // コンテンツ種別の合意判定（合意していない相手はコンテナを判別出来ない）
+        if (!b_msg_content_enabled()) {
+            b_direct = true;
+            break;
+        }
+        // 集約後のサイズ
+        uint32_t u32_limit = u32_msg_batch_limit();
+        uint32_t u32_add = MSG_SIZE_BATCH_ELEMENT + ps_data->t_size;
+        if (MSG_SIZE_BATCH_HEADER + u32_add > u32_limit) {
+            // 集約出来ないサイズの場合は集約中のコンテナを先に送信
+            ps_prev  = ps_msg_batch_detach(&u64_prev_id);
+            b_direct = true;
+            break;
+        }
 
-    //--------------------------------------------------------------------------
-    // ステータスチェック
-    //--------------------------------------------------------------------------
-    ts_sts_check_info_t* ps_sts_chk = &s_msg_ctrl_sts.s_sts_chk;
-    memset(ps_sts_chk->u8_tx_rand, 0x00, COM_MSG_SIZE_TICKET_STS);  // 送信ステータスチェック乱数
-    memset(ps_sts_chk->u8_rx_rand, 0x00, COM_MSG_SIZE_TICKET_STS);  // 受信ステータスチェック乱数
+        //----------------------------------------------------------------------
+        // 集約中のコンテナに追加出来ない場合は先に送信
+        //----------------------------------------------------------------------
+        if (ps_batch->u8_count > 0 &&
+            (ps_batch->u64_device_id != u64_device_id ||
+             ps_batch->u16_length + u32_add > u32_limit ||
+             ps_batch->u8_count >= MSG_BATCH_MAX_CNT)) {
+            ps_prev = ps_msg_batch_detach(&u64_prev_id);
+        }
+
+        //----------------------------------------------------------------------
+        // コンテナの生成
+        //----------------------------------------------------------------------
+        if (ps_batch->ps_container == NULL) {
+            ps_batch->ps_container = ps_mdl_empty_u8_array(u32_limit);
+            if (ps_batch->ps_container == NULL) {
+                sts_val = ESP_ERR_NO_MEM;
+                break;
+            }
+        }
+        uint8_t* pu8_container = ps_batch->ps_container->pu8_values;
+        if (ps_batch->u8_count == 0) {
+            ps_batch->u64_device_id = u64_device_id;
+            ps_batch->u16_length    = MSG_SIZE_BATCH_HEADER;
+        }
+
+        //----------------------------------------------------------------------
+        // データの追加
+        //----------------------------------------------------------------------
+        tu_type_converter_t u_conv;
+        u_conv.u16_values[0] = ps_data->t_size;
+        pu8_container[ps_batch->u16_length]     = u_conv.u8_values[0];
+        pu8_container[ps_batch->u16_length + 1] = u_conv.u8_values[1];
+        memcpy(&pu8_container[ps_batch->u16_length + MSG_SIZE_BATCH_ELEMENT], ps_data->pu8_values, ps_data->t_size);
+        ps_batch->u16_length += u32_add;
+        ps_batch->u8_count++;
+        pu8_container[0] = ps_batch->u8_count;
+
+        //----------------------------------------------------------------------
+        // 送信タイミングの判定
+        //----------------------------------------------------------------------
+        if (ps_batch->u16_length + MSG_SIZE_BATCH_ELEMENT >= u32_limit ||
+            ps_batch->u8_count >= MSG_BATCH_MAX_CNT) {
+            // 空きが無い場合は即時に送信
+            ps_full = ps_msg_batch_detach(&u64_device_id);
+        } else if (ps_batch->u8_count == 1) {
+            // 最初のデータの場合は最大遅延時間後に送信
+            sts_tmw_start(&s_msg_deamon_sts.s_batch_timer, s_msg_ctrl_cfg.u32_batch_delay_ms, 0);
+        }
+    } while (false);
+
+    //==========================================================================
+    // クリティカルセクション終了
+    //==========================================================================
+    xSemaphoreGiveRecursive(s_mutex_sts);
+
+    //==========================================================================
+    // 送信処理（送信ウィンドウの空き待ちが有るのでクリティカルセクション外で実行）
+    //==========================================================================
+    if (ps_prev != NULL) {
+        sts_msg_batch_send(u64_prev_id, ps_prev);
+    }
+    if (ps_full != NULL) {
+        sts_val = sts_msg_batch_send(u64_device_id, ps_full);
+    }
+    if (b_direct && sts_val == ESP_OK) {
+        sts_val = sts_com_msg_tx_cipher_msg(u64_device_id, ps_data);
+    }
+
+    // 結果返信
+    return sts_val;
 }
 
 /*******************************************************************************
  *
- * NAME: v_msg_ctrl_sts_transaction_timeout
+ * NAME: sts_com_msg_flush_batch
  *
+ * DESCRIPTION:バッチ送信待ちの暗号メッセージの送信処理
  *
- * PARAMETERS:  Name            RW  Usage
+ * PARAMETERS:      Name            RW  Usage
  *
  * RETURNS:
+ *   esp_err_t 結果ステータス
  *
  * NOTES:
- * None.
+ * 最大遅延時間を待たずに集約中のコンテナを送信する。
  ******************************************************************************/
-static void v_msg_ctrl_sts_transaction_timeout() {
-    // トランザクション判定
-    switch (s_msg_ctrl_sts.s_tran.e_sts) {
-    case COM_BLE_MSG_TRN_OPEN:
-        // オープントランザクション実行中
-        // BLEの切断処理
-        sts_com_ble_disconnect(s_msg_ctrl_sts.s_tran.t_bda);
-        // イベントエンキュー
-        v_msg_evt_enqueue(COM_BLE_MSG_EVT_OPEN_TIMEOUT);
-        break;
-    case COM_BLE_MSG_TRN_PAIRING:
-        // ペアリングトランザクション実行中
-        // イベントエンキュー
-        v_msg_evt_enqueue(COM_BLE_MSG_EVT_PAIRING_TIMEOUT);
-        break;
-    case COM_BLE_MSG_TRN_STS_CHK:
-        // ステータスチェックトランザクション実行中
-        // イベントエンキュー
-        v_msg_evt_enqueue(COM_BLE_MSG_EVT_STATUS_TIMEOUT);
-        break;
-    default:
-        break;
+esp_err_t sts_com_msg_flush_batch() {
+    //==========================================================================
+    // クリティカルセクション開始
+    //==========================================================================
+    if (xSemaphoreTakeRecursive(s_mutex_sts, portMAX_DELAY) != pdTRUE) {
+        return ESP_ERR_TIMEOUT;
     }
-    // トランザクションをクリア
-    v_msg_ctrl_sts_transaction_reset();
+    // 集約中のコンテナを取り出し
+    uint64_t u64_device_id = 0;
+    ts_u8_array_t* ps_container = ps_msg_batch_detach(&u64_device_id);
+    //==========================================================================
+    // クリティカルセクション終了
+    //==========================================================================
+    xSemaphoreGiveRecursive(s_mutex_sts);
+
+    // 送信処理
+    if (ps_container == NULL) {
+        return ESP_OK;
+    }
+    return sts_msg_batch_send(u64_device_id, ps_container);
 }
 
 /*******************************************************************************
  *
- * NAME: v_msg_history_reset
+ * NAME: sts_com_msg_delete_msg
  *
- * DESCRIPTION:Message history reset processing
+ * DESCRIPTION:メッセージの削除処理
  *
- * PARAMETERS:      Name            RW  Usage
- * ts_msg_history*  ps_msg_history  W   対象のメッセージ履歴
+ * PARAMETERS:      Name        RW  Usage
+ * ts_com_msg_t*    ps_msg      RW  メッセージ
  *
  * RETURNS:
+ *   esp_err_t 結果ステータス
  *
  * NOTES:
  * None.
  ******************************************************************************/
-static void v_msg_history_reset(ts_msg_history_t* ps_msg_history) {
-    // 送受信履歴
-    v_com_ble_addr_clear(ps_msg_history->t_bda);
-    ps_msg_history->u64_device_id  = s_msg_ctrl_cfg.u64_device_id;
-    ps_msg_history->u32_tick_ms    = 0;
-    ps_msg_history->u32_seq_no     = 0;
-    ps_msg_history->e_type         = COM_BLE_MSG_TYP_CNT;
+esp_err_t sts_com_msg_delete_msg(ts_com_msg_t* ps_msg) {
+    // 入力チェック
+    if (ps_msg == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    // 受信フレーム内のメッセージ判定
+    ts_msg_rx_frame_t* ps_frame = ps_msg_rx_frame_of_msg(ps_msg);
+    // 本文のデータ（受信フレームの場合はフレームを返却）
+    ts_u8_array_t* ps_data = ps_msg->ps_data;
+    ps_msg->ps_data = NULL;
+    sts_com_msg_delete_data(ps_data);
+    // メッセージを解放
+    if (ps_frame == NULL) {
+        l_mem_free(ps_msg);
+    }
+    // 正常に削除
+    return ESP_OK;
 }
 
 /*******************************************************************************
  *
- * NAME: ps_get_connection
+ * NAME: sts_com_msg_delete_data
  *
- * DESCRIPTION:BLE Get Connection
+ * DESCRIPTION:受信メッセージ本文の削除処理
  *
- * PARAMETERS:          Name            RW  Usage
+ * PARAMETERS:      Name        RW  Usage
+ * ts_u8_array_t*   ps_data     RW  受信メッセージの本文
  *
  * RETURNS:
- * ts_com_ble_gattc_con_info*:サーバーへのコネクション
+ *   esp_err_t 結果ステータス
  *
  * NOTES:
- * None.
+ * 受信フレームを参照する本文の場合はフレームをプールに返却し、
+ * それ以外の場合はsts_mdl_delete_u8_arrayで解放する。
+ * 受信メッセージから本文のみを切り離して解放する場合に呼び出す事。
  ******************************************************************************/
-static ts_com_ble_gattc_con_info_t* ps_get_connection() {
-    //==========================================================================
-    // リモートデバイスBLEアドレスの取得
-    //==========================================================================
-    esp_bd_addr_t t_rmt_bda;
-    if (s_msg_ctrl_sts.s_tran.e_sts == COM_BLE_MSG_TRN_NONE) {
-        // 接続済みアドレス
-        v_com_ble_addr_cpy(t_rmt_bda, s_msg_ctrl_sts.t_rmt_bda);
-    } else {
-        // 接続中アドレス
-        v_com_ble_addr_cpy(t_rmt_bda, s_msg_ctrl_sts.s_tran.t_bda);
-    }
-    // 有効アドレスチェック
-    if (b_com_ble_addr_clear(t_rmt_bda)) {
-        return NULL;
-    }
-
-    //==========================================================================
-    // コネクションの有効判定
-    //==========================================================================
-    esp_gatt_if_t t_gatt_if = s_msg_ctrl_cfg.pf_gatt_if();
-    te_gattc_con_sts_t e_con_sts = e_com_ble_gattc_con_sts(t_gatt_if, t_rmt_bda);
-    if ((e_con_sts & GATTC_STS_CONNECTED) != GATTC_STS_CONNECTED) {
-        // コネクションが無効の場合は既存のコネクション情報をクリア
-        v_com_ble_gattc_delete_con_info(s_msg_ctrl_sts.ps_con);
-        s_msg_ctrl_sts.ps_con = NULL;
-        return NULL;
-    }
-
-    //==========================================================================
-    // コネクション情報の取得
-    //==========================================================================
-    // コネクション情報の有効判定
-    ts_com_ble_gattc_con_info_t* ps_con = s_msg_ctrl_sts.ps_con;
-    if (ps_con != NULL) {
-        if (l_com_ble_addr_cmp(t_rmt_bda, ps_con->t_bda) == 0) {
-            return ps_con;
-        }
-        // リモートデバイスのコネクションでは無いので解放する
-        v_com_ble_gattc_delete_con_info(s_msg_ctrl_sts.ps_con);
-        s_msg_ctrl_sts.ps_con = NULL;
-    }
-    // コネクション情報生成
-    ps_con = ps_com_ble_gattc_create_con_info(t_gatt_if, t_rmt_bda);
-    if (ps_con == NULL) {
-        return NULL;
+esp_err_t sts_com_msg_delete_data(ts_u8_array_t* ps_data) {
+    // 受信フレームの判定
+    ts_msg_rx_frame_t* ps_frame = ps_msg_rx_frame_of_data(ps_data);
+    if (ps_frame != NULL) {
+        v_msg_rx_frame_give(ps_frame);
+        return ESP_OK;
     }
-    // サービスの有無を判定
-    if (ps_con->u16_svc_cnt == 0) {
-        // サービスの無いコネクション情報は無効なのでクリア
-        v_com_ble_gattc_delete_con_info(ps_con);
-        return NULL;
-    }
-    // コネクション情報の更新
-    s_msg_ctrl_sts.ps_con = ps_con;
-    // 取得結果を返却
-    return s_msg_ctrl_sts.ps_con;
+    // 動的に確保した本文を解放
+    return sts_mdl_delete_u8_array(ps_data);
 }
 
 /*******************************************************************************
  *
- * NAME: e_rx_message
+ * NAME: sts_com_msg_delete_ticket
  *
- * DESCRIPTION:BLE Rx Message
+ * DESCRIPTION:チケットの削除処理
  *
- * PARAMETERS:                  Name        RW  Usage
- * ts_com_msg_t*                ps_rx_msg   W   受信メッセージの編集対象
- * TickType_t                   t_tick      R   ウェイト時間
+ * PARAMETERS:      Name            RW  Usage
+ * uint64_t         u64_device_id   R   デバイスID
  *
  * RETURNS:
- *   te_com_ble_msg_rcv_sts_t: 受信結果ステータス
+ *   esp_err_t 結果ステータス
  *
  * NOTES:
  * None.
  ******************************************************************************/
-static te_com_ble_msg_rcv_sts_t e_rx_message(ts_com_msg_t* ps_rx_msg,
-                                              TickType_t t_tick) {
-    // 型変換構造体
-    tu_type_converter_t u_conv;
-    // 受信ステータス
-    te_com_ble_msg_rcv_sts_t e_rcv_sts = COM_BLE_MSG_RCV_NORMAL;
-    // 受信データ(UART)
-    ts_com_ble_gatt_rx_data_t* ps_ble_data = NULL;
-    // 受信メッセージ全体のバッファ
-    ts_u8_array_t* ps_msg_buff = NULL;
-    // データ受信関数
-    tf_ble_rx_data_t pf_rx_data = s_msg_ctrl_cfg.pf_rx_data;
-
+esp_err_t sts_com_msg_delete_ticket(uint64_t u64_device_id) {
     //==========================================================================
-    // 先頭データ読み込み
+    // クリティカルセクション開始
     //==========================================================================
-    ps_ble_data = pf_rx_data(t_tick);
-    if (ps_ble_data == NULL) {
-        // 受信データなし
-        return COM_BLE_MSG_RCV_NOT_FOUND;
+    if (xSemaphoreTakeRecursive(s_mutex_sts, portMAX_DELAY) != pdTRUE) {
+        return ESP_ERR_TIMEOUT;
     }
 
     //==========================================================================
-    // メッセージ読み込み処理
+    // チケットの削除処理
     //==========================================================================
+    esp_err_t sts_val = ESP_OK;
     do {
-        //----------------------------------------------------------------------
-        // ヘッダー情報の編集
-        //----------------------------------------------------------------------
-        // メッセージヘッダー部を編集
-        e_rcv_sts = e_edit_rx_header(ps_rx_msg, ps_ble_data);
-        if (e_rcv_sts != COM_BLE_MSG_RCV_NORMAL) {
-            // 受信ヘッダーエラー
-            // 受信データなし
+        // キャッシュチケット
+        ts_com_msg_auth_ticket_t s_cache_ticket;
+        ts_com_msg_auth_ticket_t* ps_ticket = ps_read_ticket(u64_device_id, &s_cache_ticket);
+        if (ps_ticket == NULL) {
+            // 対象チケットなし
+            sts_val = ESP_ERR_NOT_FOUND;
             break;
         }
-
-        //----------------------------------------------------------------------
-        // 受信データをコピー
-        //----------------------------------------------------------------------
-        // メッセージ全体の領域を確保
-        ps_msg_buff = ps_mdl_empty_u8_array(ps_rx_msg->u16_length);
-        if (ps_msg_buff == NULL) {
-            // メモリ確保に失敗
-            // 受信応答を送信
-            e_rcv_sts = COM_BLE_MSG_RCV_RECEIVER_ERR;
-            break;
+        // チケットを削除
+        sts_val = s_msg_ctrl_cfg.pf_tkt_cb(COM_BLE_MSG_TICKET_EVT_DELETE, ps_ticket);
+        // 遅延中のチケット更新とキャッシュを破棄
+        if (ps_ticket == &s_msg_ctrl_sts.s_rmt_ticket) {
+            v_msg_ticket_persist_reset(&s_msg_ctrl_sts.s_tkt_persist, NULL);
         }
-        // 受信データ
-        ts_u8_array_t* ps_rx_data = ps_ble_data->ps_array;
-        // 先頭の受信データをコピー
-        memcpy(ps_msg_buff->pu8_values, ps_rx_data->pu8_values, ps_rx_data->t_size);
+        v_msg_ticket_cache_remove(u64_device_id);
+        // チケットクリア ※リモートチケットキャッシュのクリアを想定
+        v_init_ticket(ps_ticket);
+        // セッション暗号コンテキストのクリア
+        v_msg_session_clear();
+    } while(false);
 
-        //----------------------------------------------------------------------
-        // フッターまで受信
-        //----------------------------------------------------------------------
-        uint32_t u32_msg_length = ps_rx_msg->u16_length;
-        uint32_t u32_pos = ps_rx_data->t_size;
-        while (u32_pos < u32_msg_length) {
-            //------------------------------------------------------------------
-            // データ受信
-            //------------------------------------------------------------------
-            // 直前の受信データを解放
-            v_com_ble_gatt_delete_rx_data(ps_ble_data);
-            // データ受信
-            ps_ble_data = pf_rx_data(t_tick);
-            if (ps_ble_data == NULL) {
-                // 受信タイムアウト
-                // 受信応答を送信
-                e_rcv_sts = COM_BLE_MSG_RCV_TIMEOUT_ERR;
-                // キューが空なのでブレーク
-                break;
-            }
+    //==========================================================================
+    // クリティカルセクション終了
+    //==========================================================================
+    xSemaphoreGiveRecursive(s_mutex_sts);
 
-            //------------------------------------------------------------------
-            // 受信データ長チェック
-            //------------------------------------------------------------------
-            ps_rx_data = ps_ble_data->ps_array;
-            if ((u32_pos + ps_rx_data->t_size) > u32_msg_length) {
-                // 受信データサイズエラー
-                // 受信応答を送信
-                e_rcv_sts = COM_BLE_MSG_RCV_LENGTH_ERR;
-                break;
-            }
+    // 結果返信
+    return sts_val;
+}
 
-            //------------------------------------------------------------------
-            // 送信元デバイスチェック
-            //------------------------------------------------------------------
-            if (l_com_ble_addr_cmp(ps_ble_data->t_bda, ps_rx_msg->t_rcv_bda) != 0) {
-                // 受信アドレスエラー
-                // 受信応答を送信
-                e_rcv_sts = COM_BLE_MSG_RCV_ADDRESS_ERR;
-                break;
-            }
+/*******************************************************************************
+ *
+ * NAME: sts_com_msg_clear_status
+ *
+ * DESCRIPTION:チケットステータスのクリア処理
+ *
+ * PARAMETERS:      Name            RW  Usage
+ * uint64_t         u64_device_id   R   デバイスID
+ *
+ * RETURNS:
+ *   esp_err_t 結果ステータス
+ *
+ * NOTES:
+ * None.
+ ******************************************************************************/
+esp_err_t sts_com_msg_clear_status(uint64_t u64_device_id) {
+    //==========================================================================
+    // クリティカルセクション開始
+    //==========================================================================
+    if (xSemaphoreTakeRecursive(s_mutex_sts, portMAX_DELAY) != pdTRUE) {
+        return ESP_ERR_TIMEOUT;
+    }
 
-            //------------------------------------------------------------------
-            // 受信データをコピー
-            //------------------------------------------------------------------
-            memcpy(&ps_msg_buff->pu8_values[u32_pos], ps_rx_data->pu8_values, ps_rx_data->t_size);
-            u32_pos = u32_pos + ps_rx_data->t_size;
-        }
-        // エラー判定
-        if (e_rcv_sts != COM_BLE_MSG_RCV_NORMAL) {
+    //==========================================================================
+    // チケットステータスのクリア処理
+    //==========================================================================
+    // 結果ステータス
+    esp_err_t sts_val = ESP_ERR_NOT_FOUND;
+    do {
+        // キャッシュチケット
+        ts_com_msg_auth_ticket_t s_cache_ticket;
+        ts_com_msg_auth_ticket_t* ps_ticket = ps_read_ticket(u64_device_id, &s_cache_ticket);
+        if (ps_ticket == NULL) {
+            // 対象チケットなし
             break;
         }
+        // 自デバイスの受信ステータスを乱数で更新
+        b_vutil_set_u8_rand_array(ps_ticket->u8_own_sts, COM_MSG_SIZE_TICKET_STS);
+        // チケットを更新
+        sts_val = sts_msg_ticket_write(ps_ticket);
+    } while(false);
 
-        //======================================================================
-        // 受信メッセージの単体チェック
-        //======================================================================
-        //----------------------------------------------------------------------
-        // ストップトークンチェック
-        //----------------------------------------------------------------------
-        // 受信メッセージ
-        uint8_t* pu8_msg_buff = ps_msg_buff->pu8_values;
-        u_conv.u8_values[0] = pu8_msg_buff[ps_msg_buff->t_size - 2];
-        u_conv.u8_values[1] = pu8_msg_buff[ps_msg_buff->t_size - 1];
-        if (u_conv.u16_values[0] != (uint16_t)ps_rx_msg->u32_seq_no) {
-            // ストップトークンエラー
-            // 受信応答を送信
-            e_rcv_sts = COM_BLE_MSG_RCV_STOP_TKN_ERR;
-            break;
-        }
+    //==========================================================================
+    // クリティカルセクション終了
+    //==========================================================================
+    xSemaphoreGiveRecursive(s_mutex_sts);
 
-        //----------------------------------------------------------------------
-        // メッセージの署名タグチェック
-        //----------------------------------------------------------------------
-        // メッセージの認証ハッシュ生成
-        uint8_t u8_auth_tag[COM_MSG_SIZE_AUTH_TAG];
-        if (sts_edit_auth_tag(u8_auth_tag, ps_msg_buff) != ESP_OK) {
-            // メッセージ認証タグの生成エラー
-            e_rcv_sts = COM_BLE_MSG_RCV_RECEIVER_ERR;
-            break;
-        }
-        // ハッシュ値の検証
-        if (memcmp(ps_rx_msg->u8_auth_tag, u8_auth_tag, COM_MSG_SIZE_AUTH_TAG) != 0) {
-            // 認証タグエラー
-            e_rcv_sts = COM_BLE_MSG_RCV_AUTH_ERR;
-            break;
-        }
+    // 結果返信
+    return sts_val;
+}
 
-        //======================================================================
-        // メッセージ本文の編集
-        //======================================================================
-        // 本文のサイズ判定
-        uint16_t u16_body_size = ps_rx_msg->u16_length - (MSG_SIZE_HEADER + MSG_SIZE_FOOTER);
-        if (u16_body_size > 0) {
-            // 暗号文も一時的にそのままデータとして編集
-            ps_rx_msg->ps_data = ps_mdl_clone_u8_array(&pu8_msg_buff[MSG_POS_BODY], u16_body_size);
-            if (ps_rx_msg->ps_data == NULL) {
-                e_rcv_sts = COM_BLE_MSG_RCV_NO_MEM_ERR;
-                break;
-            }
-        }
+/*******************************************************************************
+ *
+ * NAME: sts_com_msg_flush_ticket
+ *
+ * DESCRIPTION:遅延中のチケット更新の書き込み
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *
+ * RETURNS:
+ *   esp_err_t 結果ステータス
+ *
+ * NOTES:
+ * 電源断やスリープの前に呼び出す事で、遅延中の受信シーケンス番号を書き込む。
+ ******************************************************************************/
+esp_err_t sts_com_msg_flush_ticket() {
+    //==========================================================================
+    // クリティカルセクション開始
+    //==========================================================================
+    if (xSemaphoreTakeRecursive(s_mutex_sts, portMAX_DELAY) != pdTRUE) {
+        return ESP_ERR_TIMEOUT;
+    }
 
-#ifdef COM_BLE_MSG_DEBUG
-        if (ps_rx_msg->e_type != COM_BLE_MSG_TYP_RESPONSE) {
-            ESP_LOGW(LOG_TAG, "%s L#%d rx type=%d", __func__, __LINE__, ps_rx_msg->e_type);
-        } else {
-			unsigned long ul_tick = (unsigned long)(xTaskGetTickCount() * portTICK_PERIOD_MS);
-            ESP_LOGW(LOG_TAG, "%s L#%d rx rsp_type=%d tick=%lums", __func__, __LINE__, ps_rx_msg->ps_data->pu8_values[0], ul_tick);
-        }
-#endif
-    } while(false);
+    //==========================================================================
+    // 遅延中のチケット更新の書き込み
+    //==========================================================================
+    esp_err_t sts_val = sts_msg_ticket_flush_all();
 
     //==========================================================================
-    // 終了処理
+    // クリティカルセクション終了
     //==========================================================================
-    // 受信エラー処理
-    if (e_rcv_sts != COM_BLE_MSG_RCV_NORMAL) {
-       // 受信エラーの場合
-        // コネクションリセット
-        v_msg_ctrl_sts_connection_reset();
-    }
-    // 受信メッセージバッファを削除
-    sts_mdl_delete_u8_array(ps_msg_buff);
-    // BLE受信データを削除
-    v_com_ble_gatt_delete_rx_data(ps_ble_data);
+    xSemaphoreGiveRecursive(s_mutex_sts);
 
-    // 結果ステータスを返信
-    return e_rcv_sts;
+    // 結果返信
+    return sts_val;
 }
 
 /*******************************************************************************
  *
- * NAME: e_rx_msg_check
+ * NAME: sts_com_msg_invalidate_ticket
  *
- * DESCRIPTION:Rx Message check
+ * DESCRIPTION:キャッシュ中のチケットの破棄処理
  *
- * PARAMETERS:          Name        RW  Usage
- * ts_com_msg_t*        ps_rx_msg   W   受信メッセージの編集対象
+ * PARAMETERS:      Name            RW  Usage
+ * uint64_t         u64_device_id   R   デバイスID
  *
  * RETURNS:
- *   te_com_ble_msg_rcv_sts_t: 受信結果ステータス
+ *   esp_err_t 結果ステータス
  *
  * NOTES:
- * None.
+ * 遅延中のチケット更新を書き込んだ上でキャッシュを破棄し、次回の参照時に
+ * チケットアクセスコールバック関数で読み直す。アプリ側でチケットを直接
+ * 書き換えた場合に呼び出す事。接続中のデバイスのチケットは破棄出来ない。
  ******************************************************************************/
-static te_com_ble_msg_rcv_sts_t e_rx_msg_check(ts_com_msg_t* ps_rx_msg) {
-    // 受信ステータス
-    te_com_ble_msg_rcv_sts_t e_rcv_sts = COM_BLE_MSG_RCV_NORMAL;
-    // メッセージ定義の取得
-    const ts_msg_definition_t* ps_rx_def = &MSG_DEF[ps_rx_msg->e_type];
-    // 本文データ
-    ts_u8_array_t* ps_data = ps_rx_msg->ps_data;
-    // リモートチケット
-    ts_com_msg_auth_ticket_t* ps_ticket = NULL;
-    // 直前の受信履歴
-    ts_msg_history_t* ps_bef_rx_msg = &s_msg_ctrl_sts.s_bef_rx_msg;
-    // トランザクション情報
-    ts_transaction_info_t* ps_tran = &s_msg_ctrl_sts.s_tran;
-    // ペアリング情報
-    ts_pairing_info_t* ps_pairing = &s_msg_ctrl_sts.s_pairing;
-    // 受信SEQのカウントアップフラグ
-    bool b_rx_seq_update = false;
+esp_err_t sts_com_msg_invalidate_ticket(uint64_t u64_device_id) {
+    //==========================================================================
+    // クリティカルセクション開始
+    //==========================================================================
+    if (xSemaphoreTakeRecursive(s_mutex_sts, portMAX_DELAY) != pdTRUE) {
+        return ESP_ERR_TIMEOUT;
+    }
 
+    //==========================================================================
+    // キャッシュ中のチケットの破棄
+    //==========================================================================
+    esp_err_t sts_val = ESP_OK;
     do {
-        //----------------------------------------------------------------------
-        // デバイスIDのチェック
-        //----------------------------------------------------------------------
-        if (ps_rx_msg->u64_device_id == s_msg_ctrl_cfg.u64_device_id) {
-            // デバイスIDエラー
-            e_rcv_sts = COM_BLE_MSG_RCV_DEV_ID_ERR;
-            break;
-        }
-
-        //----------------------------------------------------------------------
-        // 直前の受信履歴のメッセージタイプをチェック
-        //----------------------------------------------------------------------
-        if (((ps_rx_def->u16_map_before_rx >> ps_bef_rx_msg->e_type) & 0x0001) != 0x0000) {
-            // 直前の受信メッセージタイプエラー
-            e_rcv_sts = COM_BLE_MSG_RCV_TRAN_ERR;
-            break;
-        }
-
-        //----------------------------------------------------------------------
-        // メッセージヘッダーのトランザクション関連チェック
-        //----------------------------------------------------------------------
-        // トランザクションチェックタイプ
-        if (ps_rx_def->e_chk_trn_type == MSG_CHK_TRN_EXEC) {
-            // トランザクション実行中チェック
-            if (ps_tran->e_sts == COM_BLE_MSG_TRN_NONE) {
-                // トランザクションが実行中では無いのでエラー
-                // 受信タイプエラー
-                e_rcv_sts = COM_BLE_MSG_RCV_TYPE_ERR;
-                break;
-            }
-            // トランザクションのデバイスIDチェック
-            if (ps_rx_msg->u64_device_id != ps_tran->u64_device_id) {
-                // メッセージのデバイスIDが違うのでエラー
-                e_rcv_sts = COM_BLE_MSG_RCV_TRAN_ERR;
-                break;
-            }
-            // 物理アドレスチェック
-            if (l_com_ble_addr_cmp(ps_rx_msg->t_rcv_bda, ps_tran->t_bda) != 0) {
-                // トランザクションの通信相手エラー
-                e_rcv_sts = COM_BLE_MSG_RCV_TRAN_ERR;
-                break;
-            }
-            // トランザクションのタイムアウトをチェック
-            if (ps_rx_msg->u32_rcv_tick_ms > ps_tran->u32_timeout_ms) {
-                // トランザクションタイムアウト
-                e_rcv_sts = COM_BLE_MSG_RCV_TRAN_ERR;
-                break;
-            }
-        } else if (ps_rx_def->e_chk_trn_type == MSG_CHK_TRN_STOP) {
-            // トランザクション停止中チェック
-            if (ps_tran->e_sts != COM_BLE_MSG_TRN_NONE) {
-                // トランザクションが実行中なのでエラー
-                // 受信タイプエラー
-                e_rcv_sts = COM_BLE_MSG_RCV_TYPE_ERR;
-                break;
-            }
-        }
-
-        //----------------------------------------------------------------------
-        // シーケンス番号の関連チェック
-        //----------------------------------------------------------------------
-        // シーケンス番号のチェック用メッセージ定義（受信通知の場合には受信メッセージタイプ）
-        const ts_msg_definition_t* ps_seq_chk_def = ps_rx_def;
-        // シーケンス番号のチェックのメッセージ定義判定
-        if (ps_rx_msg->e_type == COM_BLE_MSG_TYP_RESPONSE) {
-            // レスポンスタイプを判定
-            uint8_t u8_seq_chk_type = ps_data->pu8_values[0];
-            if (u8_seq_chk_type == COM_BLE_MSG_TYP_RESPONSE) {
-                // チェックタイプエラー
-                e_rcv_sts = COM_BLE_MSG_RCV_TYPE_ERR;
+        // リモートデバイスチケットの判定
+        ts_com_msg_auth_ticket_t* ps_ticket = &s_msg_ctrl_sts.s_rmt_ticket;
+        if (ps_ticket->u64_rmt_device_id == u64_device_id) {
+            // 接続中のデバイスは対象外
+            if (s_msg_ctrl_sts.u64_rmt_device_id == u64_device_id) {
+                sts_val = ESP_ERR_INVALID_STATE;
                 break;
             }
-            // 受信通知の場合には、送信時のメッセージタイプで判定
-            ps_seq_chk_def = &MSG_DEF[u8_seq_chk_type];
+            // 遅延中のチケット更新の書き込み
+            sts_val = sts_msg_ticket_flush(ps_ticket);
+            v_msg_ticket_persist_reset(&s_msg_ctrl_sts.s_tkt_persist, NULL);
+            v_init_ticket(ps_ticket);
         }
-        // シーケンス番号チェックタイプの判定
-        if (ps_seq_chk_def->b_fixed_seq) {
-            // シーケンス番号が固定値の場合
-            if (ps_rx_msg->u32_seq_no != ps_seq_chk_def->u32_seq_no) {
-                // シーケンスエラー
-                e_rcv_sts = COM_BLE_MSG_RCV_SEQ_ERR;
-                break;
-            }
-        } else {
-            // シーケンス番号が可変値の場合
-            // チケット読み込み
-            ps_ticket = ps_read_ticket(ps_rx_msg->u64_device_id, &s_msg_ctrl_sts.s_rmt_ticket);
-            if (ps_ticket == NULL) {
-                // チケットが無いのでペアリングエラー
-                e_rcv_sts = COM_BLE_MSG_RCV_PAIRING_ERR;
-                break;
-            }
-            // メッセージタイプ判定
-            if (ps_rx_msg->e_type == COM_BLE_MSG_TYP_RESPONSE) {
-                // 受信通知の場合
-                // 受信メッセージのSEQ番号チェック
-                if (ps_rx_msg->u32_seq_no > ps_ticket->u32_tx_seq_no) {
-                    // 受信シーケンス番号エラー
-                    e_rcv_sts = COM_BLE_MSG_RCV_SEQ_ERR;
-                    break;
-                }
-            } else {
-                // 受信通知以外の場合
-                // 受信メッセージのSEQ番号チェック
-                if (ps_rx_msg->u32_seq_no <= ps_ticket->u32_rx_seq_no) {
-                    // 過去に受信したシーケンス番号以下なのでエラー
-                    e_rcv_sts = COM_BLE_MSG_RCV_SEQ_ERR;
-                    break;
-                }
-                // 受信SEQのアップデートフラグ
-                b_rx_seq_update = true;
+        // チケットキャッシュの判定
+        ts_msg_ticket_entry_t* ps_entry = ps_msg_ticket_cache_find(u64_device_id);
+        if (ps_entry != NULL) {
+            // 遅延中のチケット更新の書き込み
+            esp_err_t sts_flush = sts_msg_ticket_flush(&ps_entry->s_ticket);
+            if (sts_val == ESP_OK) {
+                sts_val = sts_flush;
             }
+            v_msg_ticket_cache_remove(u64_device_id);
         }
+    } while(false);
 
-        //======================================================================
-        // メッセージ本文の復号
-        //======================================================================
-        // 本文の暗号判定
-        if (ps_data != NULL && ps_rx_def->b_encryption) {
-            // 本文を復号
-            if (ps_rx_msg->e_type == COM_BLE_MSG_TYP_DIGEST_MATCH) {
-                // ダイジェスト一致の場合
-                ps_data = ps_msg_decryption(ps_rx_msg, ps_pairing->u8_com_key);
-            } else {
-                // 暗号データの場合
-                ts_u8_array_t* ps_pack_data = ps_msg_decryption(ps_rx_msg, ps_ticket->u8_enc_key);
-                // アンパディング
-                ps_data = ps_crypto_pkcs7_unpadding(ps_pack_data, AES_BLOCK_BYTES);
-                // 元の平文を解放
-                sts_mdl_delete_u8_array(ps_pack_data);
-            }
-            // 本文をプレーンデータと差し替え
-            sts_mdl_delete_u8_array(ps_rx_msg->ps_data);
-            ps_rx_msg->ps_data = ps_data;
-            // 編集結果判定
-            if (ps_rx_msg->ps_data == NULL) {
-                // 復号エラー
-                e_rcv_sts = COM_BLE_MSG_RCV_DECRYPT_ERR;
-                break;
-            }
-        }
+    //==========================================================================
+    // クリティカルセクション終了
+    //==========================================================================
+    xSemaphoreGiveRecursive(s_mutex_sts);
 
-        //======================================================================
-        // 受信SEQの更新
-        //======================================================================
-        if (b_rx_seq_update) {
-            // 受信シーケンス更新
-            ps_ticket->u32_rx_seq_no = ps_rx_msg->u32_seq_no;
-            if (s_msg_ctrl_cfg.pf_tkt_cb(COM_BLE_MSG_TICKET_EVT_UPDATE, ps_ticket) != ESP_OK) {
-                // シーケンス番号エラーとする
-                e_rcv_sts = COM_BLE_MSG_RCV_SEQ_ERR;
-                // 異常終了
-                break;
-            }
-        }
+    // 結果返信
+    return sts_val;
+}
 
-#ifdef COM_BLE_MSG_DEBUG
-        if (ps_rx_msg->e_type != COM_BLE_MSG_TYP_RESPONSE) {
-            ESP_LOGW(LOG_TAG, "%s L#%d rx type=%d", __func__, __LINE__, ps_rx_msg->e_type);
-        } else {
-			unsigned long ul_tick = (unsigned long)(xTaskGetTickCount() * portTICK_PERIOD_MS);
-            ESP_LOGW(LOG_TAG, "%s L#%d rx rsp_type=%d tick=%lums", __func__, __LINE__, ps_rx_msg->ps_data->pu8_values[0], ul_tick);
-        }
-#endif
-    } while(false);
 
+/******************************************************************************/
+/***      Local Functions                                                   ***/
+/******************************************************************************/
+
+/*******************************************************************************
+ *
+ * NAME: sts_msg_begin_daemon_task
+ *
+ * DESCRIPTION:begin message daemon task
+ *
+ * PARAMETERS:  Name            RW  Usage
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * None.
+ ******************************************************************************/
+static esp_err_t sts_msg_begin_daemon_task() {
     //==========================================================================
-    // 終了処理
+    // トランザクションタイムアウトタイマーの準備
     //==========================================================================
-    // 受信エラー処理
-    if (e_rcv_sts != COM_BLE_MSG_RCV_NORMAL) {
-        // 受信エラーの場合
-        // コネクションリセット
-        v_msg_ctrl_sts_connection_reset();
+    // タイマーサービスの開始
+    if (sts_tmw_begin_service() != ESP_OK) {
+        return ESP_FAIL;
+    }
+    // タイマーの初期化
+    if (!b_tmw_is_active(&s_msg_deamon_sts.s_tran_timer)) {
+        v_tmw_init_timer(&s_msg_deamon_sts.s_tran_timer, v_msg_ctrl_sts_transaction_timer_cb, NULL);
+    }
+    if (!b_tmw_is_active(&s_msg_deamon_sts.s_retx_timer)) {
+        v_tmw_init_timer(&s_msg_deamon_sts.s_retx_timer, v_tx_window_timer_cb, NULL);
+    }
+    if (!b_tmw_is_active(&s_msg_deamon_sts.s_batch_timer)) {
+        v_tmw_init_timer(&s_msg_deamon_sts.s_batch_timer, v_msg_batch_timer_cb, NULL);
+    }
+    if (!b_tmw_is_active(&s_msg_deamon_sts.s_tkt_timer)) {
+        v_tmw_init_timer(&s_msg_deamon_sts.s_tkt_timer, v_msg_ticket_timer_cb, NULL);
+    }
+    // 送信ウィンドウの空き通知の生成
+    if (s_msg_deamon_sts.s_tx_window_sem == NULL) {
+        s_msg_deamon_sts.s_tx_window_sem = xSemaphoreCreateBinary();
+    }
+    if (s_msg_deamon_sts.s_tx_window_sem == NULL) {
+        return ESP_FAIL;
     }
+    // 受信フレームプールの確保（確保出来ない場合は受信毎に動的に確保）
+    v_msg_rx_frame_alloc();
 
-    // 結果ステータスを返信
-    return e_rcv_sts;
+    //==========================================================================
+    // メッセージ受信デーモンタスクの開始
+    //==========================================================================
+    // 受信メッセージのキュー生成
+    if (s_msg_deamon_sts.s_rx_queue_handle == NULL) {
+        s_msg_deamon_sts.s_rx_queue_handle = xQueueCreate(COM_MSG_RX_QUEUE_SIZE, sizeof(ts_com_msg_t*));
+    }
+    if (s_msg_deamon_sts.s_rx_queue_handle == NULL) {
+        // 受信メッセージのキュー生成エラー
+        return ESP_FAIL;
+    }
+    // プロファイリングサンプラーの監視対象に登録
+    sts_dbg_sampler_add_queue("msg_rx_queue", s_msg_deamon_sts.s_rx_queue_handle);
+    // メッセージ受信デーモンの開始
+    portBASE_TYPE b_rx_type = xTaskCreatePinnedToCore(v_msg_rx_daemon_task,
+                                                      "msg_rx_deamon_task",
+                                                      COM_MSG_RX_DEAMON_STACK_DEPTH,
+                                                      (void*)s_msg_deamon_sts.s_rx_queue_handle,
+                                                      COM_MSG_RX_DEAMON_PRIORITIES,
+                                                      &s_msg_deamon_sts.s_rx_deamon_handle,
+                                                      tskNO_AFFINITY);
+    if (b_rx_type != pdPASS) {
+        // 受信デーモン開始に失敗
+        return ESP_FAIL;
+    }
+
+    //==========================================================================
+    // イベント通知デーモンタスクの開始
+    //==========================================================================
+    // デーモンにイベント通知するキュー生成
+    if (s_msg_deamon_sts.s_evt_queue_handle == NULL) {
+        s_msg_deamon_sts.s_evt_queue_handle = xQueueCreate(COM_MSG_EVT_QUEUE_SIZE, sizeof(te_com_ble_msg_event));
+    }
+    if (s_msg_deamon_sts.s_evt_queue_handle == NULL) {
+        // イベント通知キューの生成エラー
+        return ESP_FAIL;
+    }
+    // プロファイリングサンプラーの監視対象に登録
+    sts_dbg_sampler_add_queue("msg_evt_queue", s_msg_deamon_sts.s_evt_queue_handle);
+    // イベント通知デーモンタスクの開始
+    portBASE_TYPE b_evt_type = xTaskCreatePinnedToCore(v_msg_evt_daemon_task,
+                                                       "msg_evt_deamon_task",
+                                                       COM_MSG_EVT_DEAMON_STACK_DEPTH,
+                                                       (void*)s_msg_deamon_sts.s_evt_queue_handle,
+                                                       COM_MSG_EVT_DEAMON_PRIORITIES,
+                                                       &s_msg_deamon_sts.s_evt_deamon_handle,
+                                                       tskNO_AFFINITY);
+    if (b_evt_type != pdPASS) {
+        // デーモン開始に失敗
+        return ESP_FAIL;
+    }
+
+    //==========================================================================
+    // X25519鍵ペアプールの補充開始
+    //==========================================================================
+    // 開始に失敗した場合でも、ペアリング時に鍵ペアを都度生成するので継続
+    sts_crypto_x25519_pool_begin();
+
+    // 正常終了
+    return ESP_OK;
 }
 
 /*******************************************************************************
  *
- * NAME: e_rx_msg_event
+ * NAME: v_msg_rx_daemon_task
  *
- * DESCRIPTION:BLE Rx Message event processing
+ * DESCRIPTION:message receiving daemon task
  *
- * PARAMETERS:                  Name        RW  Usage
- * ts_com_msg_t*                ps_rx_msg   R   受信メッセージ
+ * PARAMETERS:  Name            RW  Usage
+ * void*        pv_parameters   R   パラメータ
  *
  * RETURNS:
- *   te_com_ble_msg_rcv_sts_t: 受信結果ステータス
  *
  * NOTES:
  * None.
  ******************************************************************************/
-static te_com_ble_msg_rcv_sts_t e_rx_msg_event(ts_com_msg_t* ps_rx_msg) {
-    // 結果ステータス
-    te_com_ble_msg_rcv_sts_t e_rcv_sts = COM_BLE_MSG_RCV_NORMAL;
-    // コールバックイベント
-    te_com_ble_msg_event e_cb_evt = COM_BLE_MSG_EVT_COUNT;
-    // 受信メッセージ本文
-    ts_u8_array_t* ps_rx_data = ps_rx_msg->ps_data;
-    // リモートデバイスチケット
-    ts_com_msg_auth_ticket_t* ps_ticket = &s_msg_ctrl_sts.s_rmt_ticket;
-    // トランザクション情報
-    ts_transaction_info_t* ps_tran = &s_msg_ctrl_sts.s_tran;
-    // ペアリング情報
-    ts_pairing_info_t* ps_pairing = &s_msg_ctrl_sts.s_pairing;
-    // ステータスチェック
-    ts_sts_check_info_t* ps_sts_chk = &s_msg_ctrl_sts.s_sts_chk;
+static void v_msg_rx_daemon_task(void* pv_parameters) {
+    // 現在時刻
+    int64_t i64_now_msec = xTaskGetTickCountMSec();
+    // 次の遅延時間
+    int64_t i64_next_delay_msec = i64_now_msec + COM_MSG_DEAMON_DELAY_INTERVAL_MSEC;
+    // パラメータから受信キューハンドルを取得
+    QueueHandle_t s_rx_handle = (QueueHandle_t)pv_parameters;
+    // 受信結果ステータス
+    te_com_ble_msg_rcv_sts_t e_rcv_sts = COM_BLE_MSG_RCV_NOT_FOUND;
+    // 受信メッセージ
+    ts_com_msg_t s_rx_msg = {0};
+    // 受信フィルター
+    uint32_t u32_rx_flt = 0;
+    // 暗号メッセージの受信フィルター関数
+    tf_com_ble_msg_rx_filter_t pf_rx_filter = NULL;
+    // デーモンプロセスの無限ループ
+    while (true) {
+        //======================================================================
+        // 遅延処理　※Watchdog timer measures
+        //======================================================================
+        i64_now_msec = xTaskGetTickCountMSec();
+        if (i64_now_msec >= i64_next_delay_msec) {
+            // 遅延処理
+            vTaskDelay(1);
+            // 遅延時間更新
+            i64_next_delay_msec = i64_now_msec + COM_MSG_DEAMON_DELAY_INTERVAL_MSEC;
+        }
 
-    do {
         //======================================================================
-        // リモートデバイス情報の更新処理
+        // メッセージ受信処理
         //======================================================================
-        // リモートデバイスのBluetoothアドレス
-        v_com_ble_addr_cpy(s_msg_ctrl_sts.t_rmt_bda, ps_rx_msg->t_rcv_bda);
-        // 接続判定
-        if (s_msg_ctrl_sts.u64_rmt_device_id != ps_rx_msg->u64_device_id) {
-            // リモートデバイスID
-            s_msg_ctrl_sts.u64_rmt_device_id = ps_rx_msg->u64_device_id;
-            // 接続イベントエンキュー
-            v_msg_evt_enqueue(COM_BLE_MSG_EVT_OPEN_SUCCESS);
+        // メッセージ受信
+        e_rcv_sts = e_rx_message(&s_rx_msg, COM_MSG_RX_CHK_TIMEOUT);
+        // 受信メッセージの有無を判定
+        if (e_rcv_sts == COM_BLE_MSG_RCV_NOT_FOUND) {
+            continue;
         }
 
         //======================================================================
-        // 受信処理
-        // ※メッセージタイプ毎の受信メッセージのハンドリング処理
+        // 受信メッセージ処理
         //======================================================================
-        // 受信データ本文（ダイジェスト一致）
-        ts_msg_digest_match_t* ps_digest_match = NULL;
-        // 公開鍵（受信）
-        uint8_t u8_receive_key[CRYPTO_X25519_CLIENT_PUBLIC_KEY_SIZE];
-        // 送信メッセージ
-        ts_u8_array_t* ps_tx_msg = NULL;
+        if (e_rcv_sts == COM_BLE_MSG_RCV_NORMAL) {
+            // クリティカルセクション開始
+            if (xSemaphoreTakeRecursive(s_mutex_sts, portMAX_DELAY) != pdTRUE) {
+                continue;
+            }
 
-        //----------------------------------------------------------------------
-        // イベント判定
-        //----------------------------------------------------------------------
-        esp_err_t sts_val = ESP_OK;
-        switch (ps_rx_msg->e_type) {
-        case COM_BLE_MSG_TYP_RESPONSE:
             //------------------------------------------------------------------
-            // 受信通知
+            // 受信メッセージチェック
             //------------------------------------------------------------------
-            // イベントエンキュー
-            v_msg_evt_enqueue(COM_BLE_MSG_EVT_RX_RESPONSE);
-            break;
-        case COM_BLE_MSG_TYP_RESET:
+            DBG_TRACE_BEGIN(DBG_TRACE_EVT_MSG_CHECK, s_rx_msg.u32_seq_no);
+            e_rcv_sts = e_rx_msg_check(&s_rx_msg);
+            DBG_TRACE_END_EVT(DBG_TRACE_EVT_MSG_CHECK, s_rx_msg.u32_seq_no, e_rcv_sts);
+            if (e_rcv_sts == COM_BLE_MSG_RCV_NORMAL) {
+                // メッセージ受信イベント処理を実行
+                DBG_TRACE_BEGIN(DBG_TRACE_EVT_MSG_EVENT, s_rx_msg.u32_seq_no);
+                e_rcv_sts = e_rx_msg_event(&s_rx_msg);
+                DBG_TRACE_END_EVT(DBG_TRACE_EVT_MSG_EVENT, s_rx_msg.u32_seq_no, e_rcv_sts);
+            }
+
             //------------------------------------------------------------------
-            // リセット
+            // メッセージ受信キューのフィルタ設定
             //------------------------------------------------------------------
-            // コネクションリセット
-            v_msg_ctrl_sts_connection_reset();
-            // リモートデバイスIDを再設定
-            s_msg_ctrl_sts.u64_rmt_device_id = ps_rx_msg->u64_device_id;
-            // リモートデバイスのBluetoothアドレスを再設定
-            v_com_ble_addr_cpy(s_msg_ctrl_sts.t_rmt_bda, ps_rx_msg->t_rcv_bda);
-            // イベントエンキュー
-            v_msg_evt_enqueue(COM_BLE_MSG_EVT_RX_RESET);
+            u32_rx_flt = s_msg_deamon_sts.u32_rx_enqueue_filter;
+            pf_rx_filter = s_msg_ctrl_cfg.pf_rx_filter;
+
+            // クリティカルセクション終了
+            xSemaphoreGiveRecursive(s_mutex_sts);
+        }
+
+        //======================================================================
+        // 受信処理の結果判定
+        //======================================================================
+        // 受信エラー判定
+        if (e_rcv_sts != COM_BLE_MSG_RCV_NORMAL) {
+            // 受信エラーの場合
+            // 本文のデータが有ればクリアしてからリトライ
+            sts_com_msg_delete_data(s_rx_msg.ps_data);
+            s_rx_msg.ps_data = NULL;
+            continue;
+        }
+        //======================================================================
+        // バッチ受信の分割
+        //======================================================================
+        if (s_rx_msg.e_type == COM_BLE_MSG_TYP_CIPHERTEXT && s_rx_msg.e_content == COM_BLE_MSG_CONTENT_BATCH) {
+            // 整合しないコンテナは破棄
+            if (!b_msg_batch_is_container(s_rx_msg.ps_data)) {
+                sts_com_msg_delete_data(s_rx_msg.ps_data);
+                s_rx_msg.ps_data = NULL;
+                continue;
+            }
+            // 集約されたメッセージ毎に受信メッセージを生成して振り分け
+            ts_com_msg_t s_elm_msg = s_rx_msg;
+            s_elm_msg.e_content = COM_BLE_MSG_CONTENT_APP;
+            uint8_t* pu8_container = s_rx_msg.ps_data->pu8_values;
+            uint8_t u8_count = pu8_container[0];
+            uint32_t u32_pos = MSG_SIZE_BATCH_HEADER;
+            tu_type_converter_t u_conv;
+            for (uint8_t u8_idx = 0; u8_idx < u8_count; u8_idx++) {
+                u_conv.u8_values[0] = pu8_container[u32_pos];
+                u_conv.u8_values[1] = pu8_container[u32_pos + 1];
+                u32_pos += MSG_SIZE_BATCH_ELEMENT;
+                s_elm_msg.ps_data = ps_mdl_clone_u8_array(&pu8_container[u32_pos], u_conv.u16_values[0]);
+                u32_pos += u_conv.u16_values[0];
+                if (s_elm_msg.ps_data == NULL) {
+                    continue;
+                }
+                v_msg_rx_dispatch(s_rx_handle, &s_elm_msg, u32_rx_flt, pf_rx_filter);
+            }
+            // コンテナを解放
+            sts_com_msg_delete_data(s_rx_msg.ps_data);
+            s_rx_msg.ps_data = NULL;
+            continue;
+        }
+
+        //======================================================================
+        // 受信メッセージの振り分け
+        //======================================================================
+        v_msg_rx_dispatch(s_rx_handle, &s_rx_msg, u32_rx_flt, pf_rx_filter);
+        // 本文データはキュー投入したメッセージに移動済み
+        s_rx_msg.ps_data = NULL;
+    }
+}
+
+/*******************************************************************************
+ *
+ * NAME: v_msg_rx_dispatch
+ *
+ * DESCRIPTION:受信メッセージの振り分け（受信フィルターと受信キューへの投入）
+ *
+ * PARAMETERS:                  Name            RW  Usage
+ * QueueHandle_t                s_rx_handle     R   受信キューハンドル
+ * ts_com_msg_t*                ps_msg          R   受信メッセージ
+ * uint32_t                     u32_rx_flt      R   エンキュー対象のメッセージタイプ
+ * tf_com_ble_msg_rx_filter_t   pf_rx_filter    R   暗号メッセージの受信フィルター関数
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * 本文データの所有権は常に移動する（受信フィルターかキュー投入したメッセージ、又は解放）。
+ * 本文が受信フレームの場合は、フレーム内のメッセージをキューに投入する。
+ * クリティカルセクション外で呼び出す事。
+ ******************************************************************************/
+static void v_msg_rx_dispatch(QueueHandle_t s_rx_handle,
+                              ts_com_msg_t* ps_msg,
+                              uint32_t u32_rx_flt,
+                              tf_com_ble_msg_rx_filter_t pf_rx_filter) {
+    // 暗号メッセージの受信フィルター判定
+    if (ps_msg->e_type == COM_BLE_MSG_TYP_CIPHERTEXT && pf_rx_filter != NULL) {
+        if (pf_rx_filter(ps_msg)) {
+            // フィルターで消費された場合（本文データの所有権はフィルターに移動）
+            return;
+        }
+    }
+    // エンキュー対象か判定
+    if ((u32_rx_flt & (0x00000001 << ps_msg->e_type)) == 0x00000000) {
+        // エンキュー対象外の場合は本文データを解放
+        sts_com_msg_delete_data(ps_msg->ps_data);
+        return;
+    }
+
+    //==========================================================================
+    // 受信メッセージをクローン
+    //==========================================================================
+    ts_com_msg_t* ps_rx_msg = NULL;
+    ts_msg_rx_frame_t* ps_frame = ps_msg_rx_frame_of_data(ps_msg->ps_data);
+    if (ps_frame != NULL) {
+        // 受信フレームの場合はフレーム内のメッセージを利用
+        ps_frame->s_msg = *ps_msg;
+        ps_rx_msg = &ps_frame->s_msg;
+    } else {
+        ps_rx_msg = (ts_com_msg_t*)pv_mem_clone((void*)ps_msg, sizeof(ts_com_msg_t));
+        if (ps_rx_msg == NULL) {
+            sts_mdl_delete_u8_array(ps_msg->ps_data);
+            return;
+        }
+    }
+
+    //==========================================================================
+    // 受信メッセージエンキュー処理
+    //==========================================================================
+    // 接続してサービス検索完了までウェイト
+    TickType_t t_timeout = xTaskGetTickCount() + COM_MSG_QUEUE_TIMEOUT;
+    // 成功するまで実行
+    DBG_TRACE(DBG_TRACE_EVT_MSG_ENQUEUE, ps_msg->u32_seq_no, ps_msg->e_type);
+    while (xQueueSendToBack(s_rx_handle, &ps_rx_msg, COM_MSG_RETRY_WAIT) != pdPASS) {
+        // タイムアウト判定
+        if (t_timeout < xTaskGetTickCount()) {
+            // メッセージを解放
+            sts_com_msg_delete_msg(ps_rx_msg);
             break;
-        case COM_BLE_MSG_TYP_PING:
+        }
+    }
+}
+
+/*******************************************************************************
+ *
+ * NAME: v_msg_evt_daemon_task
+ *
+ * DESCRIPTION:event processing daemon task
+ *
+ * PARAMETERS:  Name            RW  Usage
+ * void*        pv_parameters   R   パラメータ
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * None.
+ ******************************************************************************/
+static void v_msg_evt_daemon_task(void* pv_parameters) {
+    // 現在時刻
+    int64_t i64_now_msec = xTaskGetTickCountMSec();
+    // 次の遅延時間
+    int64_t i64_next_delay_msec = i64_now_msec + COM_MSG_DEAMON_DELAY_INTERVAL_MSEC;
+    // パラメータからイベントキューハンドルを取得
+    QueueHandle_t s_evt_handle = (QueueHandle_t)pv_parameters;
+    // イベント種別
+    te_com_ble_msg_event e_msg_evt;
+    // デーモンプロセスの無限ループ
+    while (true) {
+        //======================================================================
+        // 遅延処理　※Watchdog timer measures
+        //======================================================================
+        i64_now_msec = xTaskGetTickCountMSec();
+        if (i64_now_msec >= i64_next_delay_msec) {
+            // 遅延処理
+            vTaskDelay(1);
+            // 遅延時間更新
+            i64_next_delay_msec = i64_now_msec + COM_MSG_DEAMON_DELAY_INTERVAL_MSEC;
+        }
+
+        //======================================================================
+        // イベントの読み込み
+        //======================================================================
+        if (xQueueReceive(s_evt_handle, &e_msg_evt, COM_MSG_EVT_CHK_TIMEOUT) != pdPASS) {
+            continue;
+        }
+
+        //======================================================================
+        // RESET送信イベント判定
+        //======================================================================
+        if (e_msg_evt == COM_BLE_MSG_EVT_LINK_SUCCESS) {
+            // RESET送信イベント
+            // 接続ステータス判定
+            te_com_ble_msg_connection_sts_t e_con_sts = s_msg_ctrl_cfg.pf_connect_sts();
+            if (e_con_sts != COM_BLE_MSG_CON_CONNECTED) {
+                continue;
+            }
+
             //------------------------------------------------------------------
-            // PING
+            // クリティカルセクション開始
             //------------------------------------------------------------------
-            // イベントエンキュー
-            v_msg_evt_enqueue(COM_BLE_MSG_EVT_RX_PING);
-            break;
-        case COM_BLE_MSG_TYP_PAIRING_REQ:
+            if (xSemaphoreTakeRecursive(s_mutex_sts, portMAX_DELAY) != pdTRUE) {
+                continue;
+            }
+
             //------------------------------------------------------------------
-            // ペアリング要求
+            // リモートBLEアドレスを編集
             //------------------------------------------------------------------
-            // ペアリングトランザクションの初期処理
-            if (sts_begin_pairing() != ESP_OK) {
-                // 受信ステータス
-                e_rcv_sts = COM_BLE_MSG_RCV_HANDLING_ERR;
-                // ユーザーイベント
-                e_cb_evt = COM_BLE_MSG_EVT_HANDLING_ERR;
-                break;
-            }
-            // 相手デバイス公開鍵を保存
-            // 受信した公開鍵（Curve25519を想定）を設定
-            u8_receive_key[0] = 0x03;
-            u8_receive_key[1] = 0x00;
-            u8_receive_key[2] = 0x1D;
-            u8_receive_key[3] = 0x20;
-            memcpy(&u8_receive_key[4], ps_rx_data->pu8_values, ps_rx_data->t_size);
-            // サーバー側のX25519コンテキストを生成
-            ps_pairing->ps_x25519_ctx = ps_crypto_x25519_server_context(u8_receive_key);
-            // コンテキストの生成を確認
-            if (ps_pairing->ps_x25519_ctx == NULL) {
-                // 受信ステータス
-                e_rcv_sts = COM_BLE_MSG_RCV_NO_MEM_ERR;
-                // ユーザーイベント
-                e_cb_evt = COM_BLE_MSG_EVT_HANDLING_ERR;
-                break;
+            v_com_ble_addr_cpy(s_msg_ctrl_sts.t_rmt_bda, s_msg_ctrl_sts.s_tran.t_bda);
+
+            //------------------------------------------------------------------
+            // トランザクションリセット
+            //------------------------------------------------------------------
+            v_msg_ctrl_sts_transaction_reset();
+
+            //------------------------------------------------------------------
+            // クリティカルセクション終了
+            //------------------------------------------------------------------
+            xSemaphoreGiveRecursive(s_mutex_sts);
+
+            //------------------------------------------------------------------
+            // Resetメッセージ送信
+            // ※内部にクリティカルセクション有り
+            //------------------------------------------------------------------
+            while (sts_com_msg_tx_reset_msg() != ESP_OK) {
+                vTaskDelay(COM_MSG_RETRY_WAIT);
             }
-            // 共通鍵のコピー
-            memcpy(ps_pairing->u8_com_key, ps_pairing->ps_x25519_ctx->u8_key, CRYPTO_X25519_KEY_SIZE);
-#ifdef COM_BLE_MSG_DEBUG
-            do {
+        } else if (e_msg_evt == COM_BLE_MSG_EVT_GATT_DISCONNECT) {
+            // メッセージ機能のコネクションを切断 ※スレッドセーフ
+            sts_com_msg_close();
+        }
+        // イベントコールバック
+        s_msg_ctrl_cfg.pf_evt_cb(e_msg_evt);
+    }
+
+}
+
+/*******************************************************************************
+ *
+ * NAME: v_msg_evt_enqueue
+ *
+ * DESCRIPTION:message event enqueue processing
+ *
+ * PARAMETERS:          Name            RW  Usage
+ * te_com_ble_msg_event e_msg_evt       R   メッセージイベント
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * None.
+ ******************************************************************************/
+static void v_msg_evt_enqueue(te_com_ble_msg_event e_msg_evt) {
+    //==========================================================================
+    // イベントエンキュー
+    //==========================================================================
+    int i_cnt;
+    for (i_cnt = 0; i_cnt < COM_MSG_EVT_MAX_RETRY_CNT; i_cnt++) {
+        if (xQueueSendToBack(s_msg_deamon_sts.s_evt_queue_handle, &e_msg_evt, COM_MSG_RETRY_WAIT) == pdPASS) {
+            break;
+        }
+    }
+}
+
+/*******************************************************************************
+ *
+ * NAME: v_msg_ctrl_sts_init
+ *
+ * DESCRIPTION:Message Controller init
+ *
+ * PARAMETERS:  Name            RW  Usage
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * None.
+ ******************************************************************************/
+static void v_msg_ctrl_sts_init() {
+    //==========================================================================
+    // カウンタリセット
+    //==========================================================================
+    // 送信カウンタ
+    s_msg_ctrl_sts.u64_tx_count = 0;
+    // 受信カウンタ
+    s_msg_ctrl_sts.u64_rx_count = 0;
+
+    //==========================================================================
+    // コネクションステータスリセット
+    //==========================================================================
+    v_msg_ctrl_sts_connection_reset();
+}
+
+/*******************************************************************************
+ *
+ * NAME: v_msg_ctrl_sts_connection_reset
+ *
+ * DESCRIPTION:Message Controller Connection Reset
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * None.
+ ******************************************************************************/
+static void v_msg_ctrl_sts_connection_reset() {
+    //==========================================================================
+    // クリティカルセクション開始
+    //==========================================================================
+    if (xSemaphoreTakeRecursive(s_mutex_sts, portMAX_DELAY) != pdTRUE) {
+        return;
+    }
+
+    //==========================================================================
+    // コネクションリセット処理
+    //==========================================================================
+    do {
+        //----------------------------------------------------------------------
+        // 受信データのクリア
+        //----------------------------------------------------------------------
+        s_msg_ctrl_cfg.pf_rx_clear();
+
+        //----------------------------------------------------------------------
+        // リモートデバイス情報をクリア
+        //----------------------------------------------------------------------
+        // リモートデバイスID
+        s_msg_ctrl_sts.u64_rmt_device_id = s_msg_ctrl_cfg.u64_device_id;
+        // リモートデバイスBLEアドレス
+        v_com_ble_addr_clear(s_msg_ctrl_sts.t_rmt_bda);
+        // 遅延中のチケット更新を書き込み、チケットキャッシュに退避
+        sts_msg_ticket_flush(&s_msg_ctrl_sts.s_rmt_ticket);
+        sts_msg_ticket_cache_park();
+        // リモートデバイスチケット
+        v_init_ticket(&s_msg_ctrl_sts.s_rmt_ticket);
+        // 受信シーケンス番号の同期
+        s_msg_ctrl_sts.b_rx_seq_sync = false;
+        // セッション暗号コンテキスト
+        v_msg_session_clear();
+        // 送信ウィンドウ
+        v_tx_window_clear();
+        // バッチ送信待ちの暗号メッセージ
+        sts_mdl_delete_u8_array(ps_msg_batch_detach(NULL));
+
+        //----------------------------------------------------------------------
+        // 送受信履歴のクリア
+        //----------------------------------------------------------------------
+        // 直前の送信履歴
+        v_msg_history_reset(&s_msg_ctrl_sts.s_bef_tx_msg);
+        // 直前の受信履歴
+        v_msg_history_reset(&s_msg_ctrl_sts.s_bef_rx_msg);
+        // 直前の返信履歴
+        v_msg_history_reset(&s_msg_ctrl_sts.s_bef_rx_rsp);
+
+        //----------------------------------------------------------------------
+        // トランザクションステータスリセット
+        //----------------------------------------------------------------------
+        v_msg_ctrl_sts_transaction_reset();
+
+        //----------------------------------------------------------------------
+        // BLEコネクションリセット
+        //----------------------------------------------------------------------
+        v_com_ble_gattc_delete_con_info(s_msg_ctrl_sts.ps_con);
+        s_msg_ctrl_sts.ps_con = NULL;
+    } while(false);
+
+    //==========================================================================
+    // クリティカルセクション終了
+    //==========================================================================
+    xSemaphoreGiveRecursive(s_mutex_sts);
+}
+
+/*******************************************************************************
+ *
+ * NAME: v_msg_ctrl_sts_transaction_reset
+ *
+ * DESCRIPTION:Message Controller transaction clear
+ *
+ * PARAMETERS:  Name            RW  Usage
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * None.
+ ******************************************************************************/
+static void v_msg_ctrl_sts_transaction_reset() {
+    //--------------------------------------------------------------------------
+    // トランザクション状態判定
+    //--------------------------------------------------------------------------
+    ts_transaction_info_t* ps_tran = &s_msg_ctrl_sts.s_tran;
+    if (ps_tran->e_sts == COM_BLE_MSG_TRN_NONE) {
+        return;
+    }
+
+    //--------------------------------------------------------------------------
+    // トランザクションステータス
+    //--------------------------------------------------------------------------
+    ps_tran->e_sts         = COM_BLE_MSG_TRN_NONE;          // トランザクションステータス
+    ps_tran->u64_device_id = s_msg_ctrl_cfg.u64_device_id;  // トランザクション実行中の相手デバイスID
+    v_com_ble_addr_clear(ps_tran->t_bda);                   // トランザクション実行中の相手デバイスBLEアドレス
+    ps_tran->u32_timeout_ms = U32_MAX;                      // トランザクションタイムアウト
+    sts_tmw_stop(&s_msg_deamon_sts.s_tran_timer);           // トランザクションタイムアウトタイマー
+
+    //--------------------------------------------------------------------------
+    // ペアリングステータス
+    //--------------------------------------------------------------------------
+    ts_pairing_info_t* ps_pairing = &s_msg_ctrl_sts.s_pairing;
+    // ペアリングステータス
+    ps_pairing->e_sts = MSG_PAIRING_CHK_NONE;
+    // 共通鍵
+    memset(ps_pairing->u8_com_key, 0x00, COM_MSG_SIZE_CIPHER_KEY);
+    // X25519コンテキスト
+    v_crypto_x25519_delete_context(ps_pairing->ps_x25519_ctx);
+    ps_pairing->ps_x25519_ctx = NULL;
+    // 自デバイスステータス
+    memset(ps_pairing->u8_dev_status, 0x00, COM_MSG_SIZE_TICKET_STS);
+    // 相手デバイスステータスハッシュ
+    memset(ps_pairing->u8_rmt_sts_hash, 0x00, COM_MSG_SIZE_TICKET_STS);
+    // 最大シーケンス番号
+    ps_pairing->u32_max_seq_no = 0;
+    // 認証モード拡張の有無
+    ps_pairing->b_auth_ext = false;
+    // メッセージ認証モード
+    ps_pairing->e_auth_mode = COM_BLE_MSG_AUTH_HASH;
+    // 暗号スイート
+    ps_pairing->e_cipher_suite = COM_BLE_MSG_CIPHER_AES_GCM;
+    // 送信ウィンドウ拡張の有無
+    ps_pairing->b_win_ext = false;
+    // 送信ウィンドウサイズ
+    ps_pairing->u8_tx_window = 1;
+    // 本文の圧縮の有無
+    ps_pairing->b_compress = false;
+    // 暗号文のコンテンツ種別の有無
+    ps_pairing->b_content = false;
+
+    //--------------------------------------------------------------------------
+    // ステータスチェック
+    //--------------------------------------------------------------------------
+    ts_sts_check_info_t* ps_sts_chk = &s_msg_ctrl_sts.s_sts_chk;
+    memset(ps_sts_chk->u8_tx_rand, 0x00, COM_MSG_SIZE_TICKET_STS);  // 送信ステータスチェック乱数
+    memset(ps_sts_chk->u8_rx_rand, 0x00, COM_MSG_SIZE_TICKET_STS);  // 受信ステータスチェック乱数
+}
+
+/*******************************************************************************
+ *
+ * NAME: v_msg_ctrl_sts_transaction_timeout
+ *
+ *
+ * PARAMETERS:  Name            RW  Usage
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * None.
+ ******************************************************************************/
+static void v_msg_ctrl_sts_transaction_timeout() {
+    // トランザクション判定
+    switch (s_msg_ctrl_sts.s_tran.e_sts) {
+    case COM_BLE_MSG_TRN_OPEN:
+        // オープントランザクション実行中
+        // BLEの切断処理
+        sts_com_ble_disconnect(s_msg_ctrl_sts.s_tran.t_bda);
+        // イベントエンキュー
+        v_msg_evt_enqueue(COM_BLE_MSG_EVT_OPEN_TIMEOUT);
+        break;
+    case COM_BLE_MSG_TRN_PAIRING:
+        // ペアリングトランザクション実行中
+        // イベントエンキュー
+        v_msg_evt_enqueue(COM_BLE_MSG_EVT_PAIRING_TIMEOUT);
+        break;
+    case COM_BLE_MSG_TRN_STS_CHK:
+        // ステータスチェックトランザクション実行中
+        // イベントエンキュー
+        v_msg_evt_enqueue(COM_BLE_MSG_EVT_STATUS_TIMEOUT);
+        break;
+    default:
+        break;
+    }
+    // トランザクションをクリア
+    v_msg_ctrl_sts_transaction_reset();
+}
+
+/*******************************************************************************
+ *
+ * NAME: v_msg_ctrl_sts_transaction_timer_cb
+ *
+ * DESCRIPTION:Message Controller transaction timer callback
+ *
+ * PARAMETERS:  Name            RW  Usage
+ * void*        pv_arg          R   コールバック引数
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * タイマーサービスタスクから呼び出される
+ ******************************************************************************/
+static void v_msg_ctrl_sts_transaction_timer_cb(void* pv_arg) {
+    //==========================================================================
+    // クリティカルセクション開始
+    //==========================================================================
+    if (xSemaphoreTakeRecursive(s_mutex_sts, portMAX_DELAY) != pdTRUE) {
+        return;
+    }
+
+    //==========================================================================
+    // トランザクションタイムアウト判定
+    //==========================================================================
+    // タイマー満了後にトランザクションが完了もしくは再開始されていないか判定
+    ts_transaction_info_t* ps_tran = &s_msg_ctrl_sts.s_tran;
+    if (ps_tran->e_sts != COM_BLE_MSG_TRN_NONE && ps_tran->u32_timeout_ms <= xTaskGetTickCountMSec()) {
+        // トランザクションタイムアウト
+        v_msg_ctrl_sts_transaction_timeout();
+    }
+
+    //==========================================================================
+    // クリティカルセクション終了
+    //==========================================================================
+    xSemaphoreGiveRecursive(s_mutex_sts);
+}
+
+/*******************************************************************************
+ *
+ * NAME: v_msg_history_reset
+ *
+ * DESCRIPTION:Message history reset processing
+ *
+ * PARAMETERS:      Name            RW  Usage
+ * ts_msg_history*  ps_msg_history  W   対象のメッセージ履歴
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * None.
+ ******************************************************************************/
+static void v_msg_history_reset(ts_msg_history_t* ps_msg_history) {
+    // 送受信履歴
+    v_com_ble_addr_clear(ps_msg_history->t_bda);
+    ps_msg_history->u64_device_id  = s_msg_ctrl_cfg.u64_device_id;
+    ps_msg_history->u32_tick_ms    = 0;
+    ps_msg_history->u32_seq_no     = 0;
+    ps_msg_history->e_type         = COM_BLE_MSG_TYP_CNT;
+}
+
+/*******************************************************************************
+ *
+ * NAME: ps_get_connection
+ *
+ * DESCRIPTION:BLE Get Connection
+ *
+ * PARAMETERS:          Name            RW  Usage
+ *
+ * RETURNS:
+ * ts_com_ble_gattc_con_info*:サーバーへのコネクション
+ *
+ * NOTES:
+ * None.
+ ******************************************************************************/
+static ts_com_ble_gattc_con_info_t* ps_get_connection() {
+    //==========================================================================
+    // リモートデバイスBLEアドレスの取得
+    //==========================================================================
+    esp_bd_addr_t t_rmt_bda;
+    if (s_msg_ctrl_sts.s_tran.e_sts == COM_BLE_MSG_TRN_NONE) {
+        // 接続済みアドレス
+        v_com_ble_addr_cpy(t_rmt_bda, s_msg_ctrl_sts.t_rmt_bda);
+    } else {
+        // 接続中アドレス
+        v_com_ble_addr_cpy(t_rmt_bda, s_msg_ctrl_sts.s_tran.t_bda);
+    }
+    // 有効アドレスチェック
+    if (b_com_ble_addr_clear(t_rmt_bda)) {
+        return NULL;
+    }
+
+    //==========================================================================
+    // コネクションの有効判定
+    //==========================================================================
+    esp_gatt_if_t t_gatt_if = s_msg_ctrl_cfg.pf_gatt_if();
+    te_gattc_con_sts_t e_con_sts = e_com_ble_gattc_con_sts(t_gatt_if, t_rmt_bda);
+    if ((e_con_sts & GATTC_STS_CONNECTED) != GATTC_STS_CONNECTED) {
+        // コネクションが無効の場合は既存のコネクション情報をクリア
+        v_com_ble_gattc_delete_con_info(s_msg_ctrl_sts.ps_con);
+        s_msg_ctrl_sts.ps_con = NULL;
+        return NULL;
+    }
+
+    //==========================================================================
+    // コネクション情報の取得
+    //==========================================================================
+    // コネクション情報の有効判定
+    ts_com_ble_gattc_con_info_t* ps_con = s_msg_ctrl_sts.ps_con;
+    if (ps_con != NULL) {
+        if (l_com_ble_addr_cmp(t_rmt_bda, ps_con->t_bda) == 0) {
+            return ps_con;
+        }
+        // リモートデバイスのコネクションでは無いので解放する
+        v_com_ble_gattc_delete_con_info(s_msg_ctrl_sts.ps_con);
+        s_msg_ctrl_sts.ps_con = NULL;
+    }
+    // コネクション情報生成
+    ps_con = ps_com_ble_gattc_create_con_info(t_gatt_if, t_rmt_bda);
+    if (ps_con == NULL) {
+        return NULL;
+    }
+    // サービスの有無を判定
+    if (ps_con->u16_svc_cnt == 0) {
+        // サービスの無いコネクション情報は無効なのでクリア
+        v_com_ble_gattc_delete_con_info(ps_con);
+        return NULL;
+    }
+    // コネクション情報の更新
+    s_msg_ctrl_sts.ps_con = ps_con;
+    // 取得結果を返却
+    return s_msg_ctrl_sts.ps_con;
+}
+
+/*******************************************************************************
+ *
+ * NAME: e_rx_message
+ *
+ * DESCRIPTION:BLE Rx Message
+ *
+ * PARAMETERS:                  Name        RW  Usage
+ * ts_com_msg_t*                ps_rx_msg   W   受信メッセージの編集対象
+ * TickType_t                   t_tick      R   ウェイト時間
+ *
+ * RETURNS:
+ *   te_com_ble_msg_rcv_sts_t: 受信結果ステータス
+ *
+ * NOTES:
+ * 受信データは受信フレームに直接組み立て、本文は受信フレーム内を参照する。
+ * 受信フレームが枯渇している場合のみ、メッセージ全体の領域を動的に確保する。
+ ******************************************************************************/
+static te_com_ble_msg_rcv_sts_t e_rx_message(ts_com_msg_t* ps_rx_msg,
+                                              TickType_t t_tick) {
+    // 型変換構造体
+    tu_type_converter_t u_conv;
+    // 受信ステータス
+    te_com_ble_msg_rcv_sts_t e_rcv_sts = COM_BLE_MSG_RCV_NORMAL;
+    // 受信データ(UART)
+    ts_com_ble_gatt_rx_data_t* ps_ble_data = NULL;
+    // 受信フレーム
+    ts_msg_rx_frame_t* ps_frame = NULL;
+    // 受信メッセージ全体のバッファ（受信フレームの枯渇時）
+    ts_u8_array_t* ps_msg_buff = NULL;
+    // 逐次認証コンテキスト
+    ts_msg_rx_auth_t s_rx_auth = {0};
+    // データ受信関数
+    tf_ble_rx_data_t pf_rx_data = s_msg_ctrl_cfg.pf_rx_data;
+
+    //==========================================================================
+    // 先頭データ読み込み
+    //==========================================================================
+    ps_ble_data = pf_rx_data(t_tick);
+    if (ps_ble_data == NULL) {
+        // 受信データなし
+        return COM_BLE_MSG_RCV_NOT_FOUND;
+    }
+#ifdef DBG_TRACE_ENABLED
+    // トレース用のシーケンス番号（先頭データのヘッダーから取得）
+    tu_type_converter_t u_trace_seq = {0};
+    if (ps_ble_data->ps_array->t_size >= MSG_POS_SEQ_NO + sizeof(uint32_t)) {
+        memcpy(u_trace_seq.u8_values, &ps_ble_data->ps_array->pu8_values[MSG_POS_SEQ_NO], sizeof(uint32_t));
+    }
+    DBG_TRACE_BEGIN(DBG_TRACE_EVT_MSG_RX, u_trace_seq.u32_values[0]);
+#endif
+    PROF_BEGIN(DBG_PROF_SITE_MSG_RX);
+
+    //==========================================================================
+    // メッセージ読み込み処理
+    //==========================================================================
+    do {
+        //----------------------------------------------------------------------
+        // ヘッダー情報の編集
+        //----------------------------------------------------------------------
+        // メッセージヘッダー部を編集
+        e_rcv_sts = e_edit_rx_header(ps_rx_msg, ps_ble_data);
+        if (e_rcv_sts != COM_BLE_MSG_RCV_NORMAL) {
+            // 受信ヘッダーエラー
+            // 受信データなし
+            break;
+        }
+
+        //----------------------------------------------------------------------
+        // 受信データをコピー
+        //----------------------------------------------------------------------
+        // メッセージ全体の領域を確保（最大メッセージサイズの受信フレーム）
+        uint8_t* pu8_msg_buff = NULL;
+        ps_frame = ps_msg_rx_frame_take();
+        if (ps_frame != NULL) {
+            pu8_msg_buff = ps_frame->pu8_buff;
+        } else {
+            ps_msg_buff = ps_mdl_empty_u8_array(ps_rx_msg->u16_length);
+            if (ps_msg_buff == NULL) {
+                // メモリ確保に失敗
+                // 受信応答を送信
+                e_rcv_sts = COM_BLE_MSG_RCV_RECEIVER_ERR;
+                break;
+            }
+            pu8_msg_buff = ps_msg_buff->pu8_values;
+        }
+        // 受信データ
+        ts_u8_array_t* ps_rx_data = ps_ble_data->ps_array;
+        // 先頭の受信データをコピー
+        memcpy(pu8_msg_buff, ps_rx_data->pu8_values, ps_rx_data->t_size);
+
+        //----------------------------------------------------------------------
+        // 認証タグの逐次計算を開始
+        //----------------------------------------------------------------------
+        // 受信と並行してハッシュ値を計算し、最終データの受信直後に検証する
+        if (sts_rx_auth_begin(&s_rx_auth, ps_rx_msg->e_type, ps_rx_msg->u64_device_id) != ESP_OK ||
+            sts_rx_auth_update(&s_rx_auth, ps_rx_data->pu8_values, ps_rx_data->t_size) != ESP_OK) {
+            // メッセージ認証タグの生成エラー
+            e_rcv_sts = COM_BLE_MSG_RCV_RECEIVER_ERR;
+            break;
+        }
+
+        //----------------------------------------------------------------------
+        // フッターまで受信
+        //----------------------------------------------------------------------
+        uint32_t u32_msg_length = ps_rx_msg->u16_length;
+        uint32_t u32_pos = ps_rx_data->t_size;
+        while (u32_pos < u32_msg_length) {
+            //------------------------------------------------------------------
+            // データ受信
+            //------------------------------------------------------------------
+            // 直前の受信データを解放
+            v_com_ble_gatt_delete_rx_data(ps_ble_data);
+            // データ受信
+            ps_ble_data = pf_rx_data(t_tick);
+            if (ps_ble_data == NULL) {
+                // 受信タイムアウト
+                // 受信応答を送信
+                e_rcv_sts = COM_BLE_MSG_RCV_TIMEOUT_ERR;
+                // キューが空なのでブレーク
+                break;
+            }
+
+            //------------------------------------------------------------------
+            // 受信データ長チェック
+            //------------------------------------------------------------------
+            ps_rx_data = ps_ble_data->ps_array;
+            if ((u32_pos + ps_rx_data->t_size) > u32_msg_length) {
+                // 受信データサイズエラー
+                // 受信応答を送信
+                e_rcv_sts = COM_BLE_MSG_RCV_LENGTH_ERR;
+                break;
+            }
+
+            //------------------------------------------------------------------
+            // 送信元デバイスチェック
+            //------------------------------------------------------------------
+            if (l_com_ble_addr_cmp(ps_ble_data->t_bda, ps_rx_msg->t_rcv_bda) != 0) {
+                // 受信アドレスエラー
+                // 受信応答を送信
+                e_rcv_sts = COM_BLE_MSG_RCV_ADDRESS_ERR;
+                break;
+            }
+
+            //------------------------------------------------------------------
+            // 受信データをコピー
+            //------------------------------------------------------------------
+            memcpy(&pu8_msg_buff[u32_pos], ps_rx_data->pu8_values, ps_rx_data->t_size);
+            u32_pos = u32_pos + ps_rx_data->t_size;
+            // 認証タグの逐次計算
+            if (sts_rx_auth_update(&s_rx_auth, ps_rx_data->pu8_values, ps_rx_data->t_size) != ESP_OK) {
+                // メッセージ認証タグの生成エラー
+                e_rcv_sts = COM_BLE_MSG_RCV_RECEIVER_ERR;
+                break;
+            }
+        }
+        // エラー判定
+        if (e_rcv_sts != COM_BLE_MSG_RCV_NORMAL) {
+            break;
+        }
+
+        //======================================================================
+        // 受信メッセージの単体チェック
+        //======================================================================
+        //----------------------------------------------------------------------
+        // ストップトークンチェック
+        //----------------------------------------------------------------------
+        // 受信メッセージ
+        u_conv.u8_values[0] = pu8_msg_buff[u32_msg_length - 2];
+        u_conv.u8_values[1] = pu8_msg_buff[u32_msg_length - 1];
+        if (u_conv.u16_values[0] != (uint16_t)ps_rx_msg->u32_seq_no) {
+            // ストップトークンエラー
+            // 受信応答を送信
+            e_rcv_sts = COM_BLE_MSG_RCV_STOP_TKN_ERR;
+            break;
+        }
+
+        //----------------------------------------------------------------------
+        // メッセージの署名タグチェック
+        //----------------------------------------------------------------------
+        // メッセージの認証ハッシュ生成（受信済みデータの残りのみ計算）
+        uint8_t u8_auth_tag[COM_MSG_SIZE_AUTH_TAG];
+        if (sts_rx_auth_finish(&s_rx_auth, u8_auth_tag) != ESP_OK) {
+            // メッセージ認証タグの生成エラー
+            e_rcv_sts = COM_BLE_MSG_RCV_RECEIVER_ERR;
+            break;
+        }
+        // ハッシュ値の検証（定数時間比較）
+        if (!b_vutil_ct_equal(ps_rx_msg->u8_auth_tag, u8_auth_tag, COM_MSG_SIZE_AUTH_TAG)) {
+            // 認証タグエラー
+            e_rcv_sts = COM_BLE_MSG_RCV_AUTH_ERR;
+            break;
+        }
+
+        //======================================================================
+        // メッセージ本文の編集
+        //======================================================================
+        // 本文のサイズ判定
+        uint16_t u16_body_size = ps_rx_msg->u16_length - (MSG_SIZE_HEADER + MSG_SIZE_FOOTER);
+        if (u16_body_size > 0) {
+            // 暗号文も一時的にそのままデータとして編集
+            if (ps_frame != NULL) {
+                // 受信フレームは本文の位置を参照（所有権はメッセージに移動）
+                ps_frame->s_data.pu8_values = &pu8_msg_buff[MSG_POS_BODY];
+                ps_frame->s_data.t_size     = u16_body_size;
+                ps_rx_msg->ps_data = &ps_frame->s_data;
+                ps_frame = NULL;
+            } else {
+                // 動的に確保した領域は本文を先頭に詰める
+                memmove(pu8_msg_buff, &pu8_msg_buff[MSG_POS_BODY], u16_body_size);
+                ps_msg_buff->t_size = u16_body_size;
+                ps_rx_msg->ps_data = ps_msg_buff;
+                ps_msg_buff = NULL;
+            }
+        }
+
+#ifdef COM_BLE_MSG_DEBUG
+        if (ps_rx_msg->e_type != COM_BLE_MSG_TYP_RESPONSE) {
+            ESP_LOGW(LOG_TAG, "%s L#%d rx type=%d", __func__, __LINE__, ps_rx_msg->e_type);
+        } else {
+			unsigned long ul_tick = (unsigned long)(xTaskGetTickCount() * portTICK_PERIOD_MS);
+            ESP_LOGW(LOG_TAG, "%s L#%d rx rsp_type=%d tick=%lums", __func__, __LINE__, ps_rx_msg->ps_data->pu8_values[0], ul_tick);
+        }
+#endif
+    } while(false);
+
+    //==========================================================================
+    // 終了処理
+    //==========================================================================
+    // 受信エラー処理
+    if (e_rcv_sts != COM_BLE_MSG_RCV_NORMAL) {
+       // 受信エラーの場合
+        // コネクションリセット
+        v_msg_ctrl_sts_connection_reset();
+    }
+    // 逐次認証コンテキストを解放
+    v_rx_auth_free(&s_rx_auth);
+    // 本文として利用しなかった受信フレームを返却
+    if (ps_frame != NULL) {
+        v_msg_rx_frame_give(ps_frame);
+    }
+    // 受信メッセージバッファを削除
+    sts_mdl_delete_u8_array(ps_msg_buff);
+    // BLE受信データを削除
+    v_com_ble_gatt_delete_rx_data(ps_ble_data);
+    DBG_TRACE_END_EVT(DBG_TRACE_EVT_MSG_RX, u_trace_seq.u32_values[0], e_rcv_sts);
+    PROF_END(DBG_PROF_SITE_MSG_RX);
+
+    // 結果ステータスを返信
+    return e_rcv_sts;
+}
+
+/*******************************************************************************
+ *
+ * NAME: e_rx_msg_check
+ *
+ * DESCRIPTION:Rx Message check
+ *
+ * PARAMETERS:          Name        RW  Usage
+ * ts_com_msg_t*        ps_rx_msg   W   受信メッセージの編集対象
+ *
+ * RETURNS:
+ *   te_com_ble_msg_rcv_sts_t: 受信結果ステータス
+ *
+ * NOTES:
+ * None.
+ ******************************************************************************/
+static te_com_ble_msg_rcv_sts_t e_rx_msg_check(ts_com_msg_t* ps_rx_msg) {
+    // 受信ステータス
+    te_com_ble_msg_rcv_sts_t e_rcv_sts = COM_BLE_MSG_RCV_NORMAL;
+    // メッセージ定義の取得
+    const ts_msg_definition_t* ps_rx_def = &MSG_DEF[ps_rx_msg->e_type];
+    // 本文データ
+    ts_u8_array_t* ps_data = ps_rx_msg->ps_data;
+    // リモートチケット
+    ts_com_msg_auth_ticket_t* ps_ticket = NULL;
+    // 直前の受信履歴
+    ts_msg_history_t* ps_bef_rx_msg = &s_msg_ctrl_sts.s_bef_rx_msg;
+    // トランザクション情報
+    ts_transaction_info_t* ps_tran = &s_msg_ctrl_sts.s_tran;
+    // ペアリング情報
+    ts_pairing_info_t* ps_pairing = &s_msg_ctrl_sts.s_pairing;
+    // 受信SEQのカウントアップフラグ
+    bool b_rx_seq_update = false;
+
+    do {
+        //----------------------------------------------------------------------
+        // デバイスIDのチェック
+        //----------------------------------------------------------------------
+        if (ps_rx_msg->u64_device_id == s_msg_ctrl_cfg.u64_device_id) {
+            // デバイスIDエラー
+            e_rcv_sts = COM_BLE_MSG_RCV_DEV_ID_ERR;
+            break;
+        }
+
+        //----------------------------------------------------------------------
+        // 直前の受信履歴のメッセージタイプをチェック
+        //----------------------------------------------------------------------
+        if (((ps_rx_def->u16_map_before_rx >> ps_bef_rx_msg->e_type) & 0x0001) != 0x0000) {
+            // 直前の受信メッセージタイプエラー
+            e_rcv_sts = COM_BLE_MSG_RCV_TRAN_ERR;
+            break;
+        }
+
+        //----------------------------------------------------------------------
+        // メッセージヘッダーのトランザクション関連チェック
+        //----------------------------------------------------------------------
+        // トランザクションチェックタイプ
+        if (ps_rx_def->e_chk_trn_type == MSG_CHK_TRN_EXEC) {
+            // トランザクション実行中チェック
+            if (ps_tran->e_sts == COM_BLE_MSG_TRN_NONE) {
+                // トランザクションが実行中では無いのでエラー
+                // 受信タイプエラー
+                e_rcv_sts = COM_BLE_MSG_RCV_TYPE_ERR;
+                break;
+            }
+            // トランザクションのデバイスIDチェック
+            if (ps_rx_msg->u64_device_id != ps_tran->u64_device_id) {
+                // メッセージのデバイスIDが違うのでエラー
+                e_rcv_sts = COM_BLE_MSG_RCV_TRAN_ERR;
+                break;
+            }
+            // 物理アドレスチェック
+            if (l_com_ble_addr_cmp(ps_rx_msg->t_rcv_bda, ps_tran->t_bda) != 0) {
+                // トランザクションの通信相手エラー
+                e_rcv_sts = COM_BLE_MSG_RCV_TRAN_ERR;
+                break;
+            }
+            // トランザクションのタイムアウトをチェック
+            if (ps_rx_msg->u32_rcv_tick_ms > ps_tran->u32_timeout_ms) {
+                // トランザクションタイムアウト
+                e_rcv_sts = COM_BLE_MSG_RCV_TRAN_ERR;
+                break;
+            }
+        } else if (ps_rx_def->e_chk_trn_type == MSG_CHK_TRN_STOP) {
+            // トランザクション停止中チェック
+            if (ps_tran->e_sts != COM_BLE_MSG_TRN_NONE) {
+                // トランザクションが実行中なのでエラー
+                // 受信タイプエラー
+                e_rcv_sts = COM_BLE_MSG_RCV_TYPE_ERR;
+                break;
+            }
+        }
+
+        //----------------------------------------------------------------------
+        // シーケンス番号の関連チェック
+        //----------------------------------------------------------------------
+        // シーケンス番号のチェック用メッセージ定義（受信通知の場合には受信メッセージタイプ）
+        const ts_msg_definition_t* ps_seq_chk_def = ps_rx_def;
+        // シーケンス番号のチェックのメッセージ定義判定
+        if (ps_rx_msg->e_type == COM_BLE_MSG_TYP_RESPONSE) {
+            // レスポンスタイプを判定
+            uint8_t u8_seq_chk_type = ps_data->pu8_values[0];
+            if (u8_seq_chk_type == COM_BLE_MSG_TYP_RESPONSE) {
+                // チェックタイプエラー
+                e_rcv_sts = COM_BLE_MSG_RCV_TYPE_ERR;
+                break;
+            }
+            // 受信通知の場合には、送信時のメッセージタイプで判定
+            ps_seq_chk_def = &MSG_DEF[u8_seq_chk_type];
+        }
+        // シーケンス番号チェックタイプの判定
+        if (ps_seq_chk_def->b_fixed_seq) {
+            // シーケンス番号が固定値の場合
+            if (ps_rx_msg->u32_seq_no != ps_seq_chk_def->u32_seq_no) {
+                // シーケンスエラー
+                e_rcv_sts = COM_BLE_MSG_RCV_SEQ_ERR;
+                break;
+            }
+        } else {
+            // シーケンス番号が可変値の場合
+            // チケット読み込み
+            ps_ticket = ps_read_ticket(ps_rx_msg->u64_device_id, &s_msg_ctrl_sts.s_rmt_ticket);
+            if (ps_ticket == NULL) {
+                // チケットが無いのでペアリングエラー
+                e_rcv_sts = COM_BLE_MSG_RCV_PAIRING_ERR;
+                break;
+            }
+            // メッセージタイプ判定
+            if (ps_rx_msg->e_type == COM_BLE_MSG_TYP_RESPONSE) {
+                // 受信通知の場合
+                // 受信メッセージのSEQ番号チェック
+                if (ps_rx_msg->u32_seq_no > ps_ticket->u32_tx_seq_no) {
+                    // 受信シーケンス番号エラー
+                    e_rcv_sts = COM_BLE_MSG_RCV_SEQ_ERR;
+                    break;
+                }
+            } else {
+                // 受信通知以外の場合
+                // 受信メッセージのSEQ番号チェック
+                if (ps_rx_msg->u32_seq_no <= ps_ticket->u32_rx_seq_no) {
+                    // ウィンドウ制御時の暗号文は応答が失われた再送と判断し、応答のみ返信
+                    if (ps_rx_msg->e_type == COM_BLE_MSG_TYP_CIPHERTEXT && ps_ticket->u8_tx_window > 1) {
+                        sts_tx_response(ps_rx_msg->e_type, COM_BLE_MSG_RCV_NORMAL, ps_rx_msg->u32_seq_no);
+                        e_rcv_sts = COM_BLE_MSG_RCV_DUPLICATE;
+                        break;
+                    }
+                    // 過去に受信したシーケンス番号以下なのでエラー
+                    e_rcv_sts = COM_BLE_MSG_RCV_SEQ_ERR;
+                    break;
+                }
+                // ウィンドウ制御時の暗号文は連続したSEQ番号のみ受理（累積確認応答を連続した最大値とする為）
+                // 欠番より後の暗号文は応答せずに破棄し、送信元の再送で欠番から順に受信する
+                // ※接続後の最初の受信は送信側の予約ブロック分の読み飛ばしが有るので同期のみ
+                if (ps_rx_msg->e_type == COM_BLE_MSG_TYP_CIPHERTEXT && ps_ticket->u8_tx_window > 1 &&
+                    s_msg_ctrl_sts.b_rx_seq_sync && ps_rx_msg->u32_seq_no != ps_ticket->u32_rx_seq_no + 1) {
+                    e_rcv_sts = COM_BLE_MSG_RCV_OUT_OF_ORDER;
+                    break;
+                }
+                // 受信SEQのアップデートフラグ
+                b_rx_seq_update = true;
+            }
+        }
+
+        //======================================================================
+        // メッセージ本文の復号
+        //======================================================================
+        // 本文の暗号判定
+        if (ps_data != NULL && ps_rx_def->b_encryption) {
+            // 本文をインプレースで復号（本文は平文に置き換わる）
+            esp_err_t sts_dec;
+            if (ps_rx_msg->e_type == COM_BLE_MSG_TYP_DIGEST_MATCH) {
+                // ダイジェスト一致の場合
+                sts_dec = sts_msg_decryption(ps_rx_msg, ps_pairing->u8_com_key, COM_BLE_MSG_CIPHER_AES_GCM);
+            } else {
+                // 暗号データの場合
+                sts_dec = sts_msg_decryption(ps_rx_msg, ps_ticket->u8_enc_key, ps_ticket->e_cipher_suite);
+                // アンパディング（インプレース）
+                if (sts_dec == ESP_OK) {
+                    sts_dec = sts_crypto_pkcs7_unpadding(ps_data->pu8_values, ps_data, AES_BLOCK_BYTES);
+                }
+                if (sts_dec == ESP_OK) {
+                    ps_data->t_size -= ps_data->pu8_values[ps_data->t_size - 1];
+                }
+            }
+            // 編集結果判定
+            if (sts_dec != ESP_OK) {
+                // 復号エラー
+                e_rcv_sts = COM_BLE_MSG_RCV_DECRYPT_ERR;
+                break;
+            }
+        }
+
+        //======================================================================
+        // メッセージ本文の伸長
+        //======================================================================
+        if (ps_rx_msg->e_type == COM_BLE_MSG_TYP_DATA || ps_rx_msg->e_type == COM_BLE_MSG_TYP_CIPHERTEXT) {
+            // SEQ番号が固定のデータの場合もチケットで圧縮の有無を判定
+            ts_com_msg_auth_ticket_t* ps_cmp_ticket = ps_ticket;
+            if (ps_cmp_ticket == NULL) {
+                ps_cmp_ticket = ps_read_ticket(ps_rx_msg->u64_device_id, &s_msg_ctrl_sts.s_rmt_ticket);
+            }
+            if (ps_cmp_ticket != NULL && ps_cmp_ticket->b_compress && sts_msg_decompress(ps_rx_msg) != ESP_OK) {
+                // 伸長エラー
+                e_rcv_sts = COM_BLE_MSG_RCV_DECOMPRESS_ERR;
+                break;
+            }
+            ps_data = ps_rx_msg->ps_data;
+        }
+
+        //======================================================================
+        // コンテンツ種別の分離（合意している暗号文のみ）
+        //======================================================================
+        if (ps_rx_msg->e_type == COM_BLE_MSG_TYP_CIPHERTEXT && ps_ticket->b_content) {
+            if (ps_data == NULL || ps_data->t_size < MSG_SIZE_CONTENT_TYPE ||
+                ps_data->pu8_values[0] >= COM_BLE_MSG_CONTENT_CNT) {
+                // 未定義のコンテンツ種別
+                e_rcv_sts = COM_BLE_MSG_RCV_TYPE_ERR;
+                break;
+            }
+            ps_rx_msg->e_content = ps_data->pu8_values[0];
+            v_msg_rx_data_skip(ps_data, MSG_SIZE_CONTENT_TYPE);
+        }
+
+        //======================================================================
+        // 受信SEQの更新
+        //======================================================================
+        if (b_rx_seq_update) {
+            // 受信シーケンス更新
+            uint32_t u32_bef_rx_seq_no = ps_ticket->u32_rx_seq_no;
+            ps_ticket->u32_rx_seq_no = ps_rx_msg->u32_seq_no;
+            if (sts_msg_ticket_rx_update(ps_ticket) != ESP_OK) {
+                // 永続化出来なかった受信は受理しないので、受信シーケンス番号を戻す
+                ps_ticket->u32_rx_seq_no = u32_bef_rx_seq_no;
+                // シーケンス番号エラーとする
+                e_rcv_sts = COM_BLE_MSG_RCV_SEQ_ERR;
+                // 異常終了
+                break;
+            }
+            // 受信シーケンス番号の同期済み
+            s_msg_ctrl_sts.b_rx_seq_sync = true;
+        }
+
+#ifdef COM_BLE_MSG_DEBUG
+        if (ps_rx_msg->e_type != COM_BLE_MSG_TYP_RESPONSE) {
+            ESP_LOGW(LOG_TAG, "%s L#%d rx type=%d", __func__, __LINE__, ps_rx_msg->e_type);
+        } else {
+			unsigned long ul_tick = (unsigned long)(xTaskGetTickCount() * portTICK_PERIOD_MS);
+            ESP_LOGW(LOG_TAG, "%s L#%d rx rsp_type=%d tick=%lums", __func__, __LINE__, ps_rx_msg->ps_data->pu8_values[0], ul_tick);
+        }
+#endif
+    } while(false);
+
+    //==========================================================================
+    // 終了処理
+    //==========================================================================
+    // 受信エラー処理（重複受信と順序外受信は破棄のみ）
+    if (e_rcv_sts != COM_BLE_MSG_RCV_NORMAL && e_rcv_sts != COM_BLE_MSG_RCV_DUPLICATE &&
+        e_rcv_sts != COM_BLE_MSG_RCV_OUT_OF_ORDER) {
+        // 受信エラーの場合
+        // コネクションリセット
+        v_msg_ctrl_sts_connection_reset();
+    }
+
+    // 結果ステータスを返信
+    return e_rcv_sts;
+}
+
+/*******************************************************************************
+ *
+ * NAME: e_rx_msg_event
+ *
+ * DESCRIPTION:BLE Rx Message event processing
+ *
+ * PARAMETERS:                  Name        RW  Usage
+ * ts_com_msg_t*                ps_rx_msg   R   受信メッセージ
+ *
+ * RETURNS:
+ *   te_com_ble_msg_rcv_sts_t: 受信結果ステータス
+ *
+ * NOTES:
+ * None.
+ ******************************************************************************/
+static te_com_ble_msg_rcv_sts_t e_rx_msg_event(ts_com_msg_t* ps_rx_msg) {
+    // 結果ステータス
+    te_com_ble_msg_rcv_sts_t e_rcv_sts = COM_BLE_MSG_RCV_NORMAL;
+    // コールバックイベント
+    te_com_ble_msg_event e_cb_evt = COM_BLE_MSG_EVT_COUNT;
+    // 受信メッセージ本文
+    ts_u8_array_t* ps_rx_data = ps_rx_msg->ps_data;
+    // リモートデバイスチケット
+    ts_com_msg_auth_ticket_t* ps_ticket = &s_msg_ctrl_sts.s_rmt_ticket;
+    // トランザクション情報
+    ts_transaction_info_t* ps_tran = &s_msg_ctrl_sts.s_tran;
+    // ペアリング情報
+    ts_pairing_info_t* ps_pairing = &s_msg_ctrl_sts.s_pairing;
+    // ステータスチェック
+    ts_sts_check_info_t* ps_sts_chk = &s_msg_ctrl_sts.s_sts_chk;
+
+    do {
+        //======================================================================
+        // リモートデバイス情報の更新処理
+        //======================================================================
+        // リモートデバイスのBluetoothアドレス
+        v_com_ble_addr_cpy(s_msg_ctrl_sts.t_rmt_bda, ps_rx_msg->t_rcv_bda);
+        // 接続判定
+        if (s_msg_ctrl_sts.u64_rmt_device_id != ps_rx_msg->u64_device_id) {
+            // リモートデバイスID
+            s_msg_ctrl_sts.u64_rmt_device_id = ps_rx_msg->u64_device_id;
+            // 接続イベントエンキュー
+            v_msg_evt_enqueue(COM_BLE_MSG_EVT_OPEN_SUCCESS);
+        }
+
+        //======================================================================
+        // 受信処理
+        // ※メッセージタイプ毎の受信メッセージのハンドリング処理
+        //======================================================================
+        // 受信データ本文（ダイジェスト一致）
+        ts_msg_digest_match_t* ps_digest_match = NULL;
+        // 公開鍵（受信）
+        uint8_t u8_receive_key[CRYPTO_X25519_CLIENT_PUBLIC_KEY_SIZE];
+        // 送信メッセージ
+        ts_u8_array_t* ps_tx_msg = NULL;
+
+        //----------------------------------------------------------------------
+        // イベント判定
+        //----------------------------------------------------------------------
+        esp_err_t sts_val = ESP_OK;
+        switch (ps_rx_msg->e_type) {
+        case COM_BLE_MSG_TYP_RESPONSE:
+            //------------------------------------------------------------------
+            // 受信通知
+            //------------------------------------------------------------------
+            // 送信ウィンドウの確認応答処理
+            v_tx_window_ack(ps_rx_msg);
+            // イベントエンキュー
+            v_msg_evt_enqueue(COM_BLE_MSG_EVT_RX_RESPONSE);
+            break;
+        case COM_BLE_MSG_TYP_RESET:
+            //------------------------------------------------------------------
+            // リセット
+            //------------------------------------------------------------------
+            // コネクションリセット
+            v_msg_ctrl_sts_connection_reset();
+            // リモートデバイスIDを再設定
+            s_msg_ctrl_sts.u64_rmt_device_id = ps_rx_msg->u64_device_id;
+            // リモートデバイスのBluetoothアドレスを再設定
+            v_com_ble_addr_cpy(s_msg_ctrl_sts.t_rmt_bda, ps_rx_msg->t_rcv_bda);
+            // イベントエンキュー
+            v_msg_evt_enqueue(COM_BLE_MSG_EVT_RX_RESET);
+            break;
+        case COM_BLE_MSG_TYP_PING:
+            //------------------------------------------------------------------
+            // PING
+            //------------------------------------------------------------------
+            // イベントエンキュー
+            v_msg_evt_enqueue(COM_BLE_MSG_EVT_RX_PING);
+            break;
+        case COM_BLE_MSG_TYP_PAIRING_REQ:
+            //------------------------------------------------------------------
+            // ペアリング要求
+            //------------------------------------------------------------------
+            // ペアリングトランザクションの初期処理
+            if (sts_begin_pairing() != ESP_OK) {
+                // 受信ステータス
+                e_rcv_sts = COM_BLE_MSG_RCV_HANDLING_ERR;
+                // ユーザーイベント
+                e_cb_evt = COM_BLE_MSG_EVT_HANDLING_ERR;
+                break;
+            }
+            // 相手デバイス公開鍵を保存
+            // 受信した公開鍵（Curve25519を想定）を設定
+            u8_receive_key[0] = 0x03;
+            u8_receive_key[1] = 0x00;
+            u8_receive_key[2] = 0x1D;
+            u8_receive_key[3] = 0x20;
+            memcpy(&u8_receive_key[4], ps_rx_data->pu8_values, CRYPTO_X25519_KEY_SIZE);
+            // 認証モードと暗号スイートの合意（提案が無い場合は互換モード）
+            ps_pairing->b_auth_ext     = (ps_rx_data->t_size > CRYPTO_X25519_KEY_SIZE);
+            ps_pairing->b_win_ext      = (ps_rx_data->t_size > CRYPTO_X25519_KEY_SIZE + MSG_SIZE_AUTH_MODE);
+            ps_pairing->e_auth_mode    = COM_BLE_MSG_AUTH_HASH;
+            ps_pairing->e_cipher_suite = COM_BLE_MSG_CIPHER_AES_GCM;
+            ps_pairing->u8_tx_window   = 1;
+            ps_pairing->b_compress     = false;
+            ps_pairing->b_content      = false;
+            if (ps_pairing->b_win_ext) {
+                // 提案と自デバイスの設定の小さい方で合意
+                uint8_t u8_win_ext = ps_rx_data->pu8_values[CRYPTO_X25519_KEY_SIZE + MSG_SIZE_AUTH_MODE];
+                uint8_t u8_tx_window = MSG_EXT_TX_WINDOW(u8_win_ext);
+                if (u8_tx_window > s_msg_ctrl_cfg.u8_tx_window) {
+                    u8_tx_window = s_msg_ctrl_cfg.u8_tx_window;
+                }
+                if (u8_tx_window > 1) {
+                    ps_pairing->u8_tx_window = u8_tx_window;
+                }
+                // 圧縮は双方が有効な場合に合意
+                ps_pairing->b_compress = ((u8_win_ext & MSG_EXT_COMPRESS) != 0x00 &&
+                                          (s_msg_ctrl_cfg.s_func_ctl & MSG_FUNC_CTL_COMPRESS) != 0x00);
+                // コンテンツ種別も双方が有効な場合に合意
+                ps_pairing->b_content = ((u8_win_ext & MSG_EXT_CONTENT) != 0x00 &&
+                                         (s_msg_ctrl_cfg.s_func_ctl & (MSG_FUNC_CTL_CONTENT | MSG_FUNC_CTL_BATCH)) != 0x00);
+            }
+            if (ps_pairing->b_auth_ext) {
+                uint8_t u8_ext = ps_rx_data->pu8_values[CRYPTO_X25519_KEY_SIZE];
+                if (MSG_EXT_AUTH_MODE(u8_ext) == COM_BLE_MSG_AUTH_HMAC &&
+                    s_msg_ctrl_cfg.e_auth_mode == COM_BLE_MSG_AUTH_HMAC) {
+                    ps_pairing->e_auth_mode = COM_BLE_MSG_AUTH_HMAC;
+                }
+                if (MSG_EXT_CIPHER(u8_ext) == COM_BLE_MSG_CIPHER_CHACHA20_POLY1305 &&
+                    s_msg_ctrl_cfg.e_cipher_suite == COM_BLE_MSG_CIPHER_CHACHA20_POLY1305) {
+                    ps_pairing->e_cipher_suite = COM_BLE_MSG_CIPHER_CHACHA20_POLY1305;
+                }
+            }
+            // サーバー側のX25519コンテキストを生成
+            ps_pairing->ps_x25519_ctx = ps_crypto_x25519_server_context(u8_receive_key);
+            // コンテキストの生成を確認
+            if (ps_pairing->ps_x25519_ctx == NULL) {
+                // 受信ステータス
+                e_rcv_sts = COM_BLE_MSG_RCV_NO_MEM_ERR;
+                // ユーザーイベント
+                e_cb_evt = COM_BLE_MSG_EVT_HANDLING_ERR;
+                break;
+            }
+            // 共通鍵のコピー
+            memcpy(ps_pairing->u8_com_key, ps_pairing->ps_x25519_ctx->u8_key, CRYPTO_X25519_KEY_SIZE);
+#ifdef COM_BLE_MSG_DEBUG
+            do {
                 uint32_t u32_key_len = (COM_MSG_SIZE_CIPHER_KEY * 2) + 1;
                 char c_key_str[u32_key_len];
                 v_vutil_u8_to_hex_string(ps_pairing->u8_com_key, COM_MSG_SIZE_CIPHER_KEY, c_key_str);
                 ESP_LOGW(LOG_TAG, "%s L#%d com_key=%s", __func__, __LINE__, c_key_str);
             } while(false);
 #endif
-            // ペアリング応答メッセージ生成
-            ps_tx_msg = ps_create_msg_data(COM_BLE_MSG_TYP_PAIRING_RSP, NULL);
-            if (ps_tx_msg == NULL) {
-                // 受信ステータス
-                e_rcv_sts = COM_BLE_MSG_RCV_HANDLING_ERR;
-                // ユーザーイベント
-                e_cb_evt = COM_BLE_MSG_EVT_HANDLING_ERR;
-                break;
-            }
-            // ペアリング応答送信
-            sts_val = s_msg_ctrl_cfg.pf_tx_msg(ps_tx_msg);
-            // 送信済みデータを解放
-            sts_mdl_delete_u8_array(ps_tx_msg);
-            if (sts_val != ESP_OK) {
-                // 受信ステータス
-                e_rcv_sts = COM_BLE_MSG_RCV_HANDLING_ERR;
-                // ユーザーイベント
-                e_cb_evt = COM_BLE_MSG_EVT_HANDLING_ERR;
-                break;
-            }
-            // イベントエンキュー
-            v_msg_evt_enqueue(COM_BLE_MSG_EVT_PAIRING_START);
-            break;
-        case COM_BLE_MSG_TYP_PAIRING_RSP:
-            //------------------------------------------------------------------
-            // ペアリング応答
-            //------------------------------------------------------------------
-            if (ps_pairing->ps_x25519_ctx == NULL) {
-                // ペアリングエラー
-                e_rcv_sts = COM_BLE_MSG_RCV_PAIRING_ERR;
-                // ユーザーイベント
-                e_cb_evt = COM_BLE_MSG_EVT_HANDLING_ERR;
-                break;
-            }
-            // 受信した公開鍵（Curve25519を想定）を設定
-            u8_receive_key[0] = 0x20;
-            memcpy(&u8_receive_key[1], ps_rx_data->pu8_values, ps_rx_data->t_size);
-            // 共通鍵を生成
-            sts_val = sts_crypto_x25519_client_secret(ps_pairing->ps_x25519_ctx, u8_receive_key);
-            if (sts_val != ESP_OK) {
-                // 受信ステータス
-                e_rcv_sts = COM_BLE_MSG_RCV_NO_MEM_ERR;
-                // ユーザーイベント
-                e_cb_evt = COM_BLE_MSG_EVT_HANDLING_ERR;
-                break;
-            }
-            // 共通鍵をコピー
-            memcpy(ps_pairing->u8_com_key, ps_pairing->ps_x25519_ctx->u8_key, CRYPTO_X25519_KEY_SIZE);
-            // イベントエンキュー
-            v_msg_evt_enqueue(COM_BLE_MSG_EVT_PAIRING_START);
-            break;
-        case COM_BLE_MSG_TYP_DIGEST_MATCH:
-            //------------------------------------------------------------------
-            // ダイジェスト一致
-            //------------------------------------------------------------------
-            ps_digest_match = (ts_msg_digest_match_t*)ps_rx_data->pu8_values;
-            // 相手ステータスハッシュ
-            memcpy(ps_pairing->u8_rmt_sts_hash, ps_digest_match->u8_sts_hash, COM_MSG_SIZE_TICKET_STS);
-            // 最大シーケンス番号
-            ps_pairing->u32_max_seq_no = ps_digest_match->u32_max_seq_no;
+            // ペアリング応答メッセージ生成
+            ps_tx_msg = ps_create_msg_data(COM_BLE_MSG_TYP_PAIRING_RSP, NULL);
+            if (ps_tx_msg == NULL) {
+                // 受信ステータス
+                e_rcv_sts = COM_BLE_MSG_RCV_HANDLING_ERR;
+                // ユーザーイベント
+                e_cb_evt = COM_BLE_MSG_EVT_HANDLING_ERR;
+                break;
+            }
+            // ペアリング応答送信
+            sts_val = s_msg_ctrl_cfg.pf_tx_msg(ps_tx_msg);
+            // 送信済みデータを解放
+            sts_mdl_delete_u8_array(ps_tx_msg);
+            if (sts_val != ESP_OK) {
+                // 受信ステータス
+                e_rcv_sts = COM_BLE_MSG_RCV_HANDLING_ERR;
+                // ユーザーイベント
+                e_cb_evt = COM_BLE_MSG_EVT_HANDLING_ERR;
+                break;
+            }
+            // イベントエンキュー
+            v_msg_evt_enqueue(COM_BLE_MSG_EVT_PAIRING_START);
+            break;
+        case COM_BLE_MSG_TYP_PAIRING_RSP:
+            //------------------------------------------------------------------
+            // ペアリング応答
+            //------------------------------------------------------------------
+            if (ps_pairing->ps_x25519_ctx == NULL) {
+                // ペアリングエラー
+                e_rcv_sts = COM_BLE_MSG_RCV_PAIRING_ERR;
+                // ユーザーイベント
+                e_cb_evt = COM_BLE_MSG_EVT_HANDLING_ERR;
+                break;
+            }
+            // 受信した公開鍵（Curve25519を想定）を設定
+            u8_receive_key[0] = 0x20;
+            memcpy(&u8_receive_key[1], ps_rx_data->pu8_values, CRYPTO_X25519_KEY_SIZE);
+            // 合意した認証モードと暗号スイート（拡張が無い場合は互換モード）
+            if (ps_rx_data->t_size > CRYPTO_X25519_KEY_SIZE) {
+                uint8_t u8_ext = ps_rx_data->pu8_values[CRYPTO_X25519_KEY_SIZE];
+                te_com_ble_msg_auth_mode_t e_auth_mode = MSG_EXT_AUTH_MODE(u8_ext);
+                te_com_ble_msg_cipher_suite_t e_cipher_suite = MSG_EXT_CIPHER(u8_ext);
+                if ((e_auth_mode != COM_BLE_MSG_AUTH_HASH && e_auth_mode != ps_pairing->e_auth_mode) ||
+                    (e_cipher_suite != COM_BLE_MSG_CIPHER_AES_GCM && e_cipher_suite != ps_pairing->e_cipher_suite)) {
+                    // 提案していない認証モードもしくは暗号スイート
+                    e_rcv_sts = COM_BLE_MSG_RCV_PAIRING_ERR;
+                    // ユーザーイベント
+                    e_cb_evt = COM_BLE_MSG_EVT_PAIRING_ERR;
+                    break;
+                }
+                // 合意した送信ウィンドウサイズ（拡張が無い場合はストップアンドウェイト）
+                uint8_t u8_tx_window = 1;
+                bool b_compress = false;
+                bool b_content = false;
+                if (ps_rx_data->t_size > CRYPTO_X25519_KEY_SIZE + MSG_SIZE_AUTH_MODE) {
+                    uint8_t u8_win_ext = ps_rx_data->pu8_values[CRYPTO_X25519_KEY_SIZE + MSG_SIZE_AUTH_MODE];
+                    u8_tx_window = MSG_EXT_TX_WINDOW(u8_win_ext);
+                    b_compress   = ((u8_win_ext & MSG_EXT_COMPRESS) != 0x00);
+                    b_content    = ((u8_win_ext & MSG_EXT_CONTENT) != 0x00);
+                    if (!ps_pairing->b_win_ext || u8_tx_window < 1 || u8_tx_window > ps_pairing->u8_tx_window ||
+                        (b_compress && !ps_pairing->b_compress) || (b_content && !ps_pairing->b_content)) {
+                        // 提案していない送信ウィンドウサイズもしくは圧縮、コンテンツ種別
+                        e_rcv_sts = COM_BLE_MSG_RCV_PAIRING_ERR;
+                        // ユーザーイベント
+                        e_cb_evt = COM_BLE_MSG_EVT_PAIRING_ERR;
+                        break;
+                    }
+                }
+                ps_pairing->e_auth_mode    = e_auth_mode;
+                ps_pairing->e_cipher_suite = e_cipher_suite;
+                ps_pairing->u8_tx_window   = u8_tx_window;
+                ps_pairing->b_compress     = b_compress;
+                ps_pairing->b_content      = b_content;
+            } else {
+                ps_pairing->e_auth_mode    = COM_BLE_MSG_AUTH_HASH;
+                ps_pairing->e_cipher_suite = COM_BLE_MSG_CIPHER_AES_GCM;
+                ps_pairing->u8_tx_window   = 1;
+                ps_pairing->b_compress     = false;
+                ps_pairing->b_content      = false;
+            }
+            // 共通鍵を生成
+            sts_val = sts_crypto_x25519_client_secret(ps_pairing->ps_x25519_ctx, u8_receive_key);
+            if (sts_val != ESP_OK) {
+                // 受信ステータス
+                e_rcv_sts = COM_BLE_MSG_RCV_NO_MEM_ERR;
+                // ユーザーイベント
+                e_cb_evt = COM_BLE_MSG_EVT_HANDLING_ERR;
+                break;
+            }
+            // 共通鍵をコピー
+            memcpy(ps_pairing->u8_com_key, ps_pairing->ps_x25519_ctx->u8_key, CRYPTO_X25519_KEY_SIZE);
+            // イベントエンキュー
+            v_msg_evt_enqueue(COM_BLE_MSG_EVT_PAIRING_START);
+            break;
+        case COM_BLE_MSG_TYP_DIGEST_MATCH:
+            //------------------------------------------------------------------
+            // ダイジェスト一致
+            //------------------------------------------------------------------
+            ps_digest_match = (ts_msg_digest_match_t*)ps_rx_data->pu8_values;
+            // 相手ステータスハッシュ
+            memcpy(ps_pairing->u8_rmt_sts_hash, ps_digest_match->u8_sts_hash, COM_MSG_SIZE_TICKET_STS);
+            // 最大シーケンス番号
+            ps_pairing->u32_max_seq_no = ps_digest_match->u32_max_seq_no;
+#ifdef COM_BLE_MSG_DEBUG
+            do {
+                char sts_txt[(COM_MSG_SIZE_TICKET_STS * 2) + 1];
+                v_vutil_u8_to_hex_string(ps_pairing->u8_rmt_sts_hash, COM_MSG_SIZE_TICKET_STS, sts_txt);
+                ESP_LOGW(LOG_TAG, "%s L#%d rx_hash=%s", __func__, __LINE__, sts_txt);
+                ESP_LOGW(LOG_TAG, "%s L#%d rx_no=%lu", __func__, __LINE__, (unsigned long)ps_pairing->u32_max_seq_no);
+            } while(false);
+#endif
+            // 相互認証チェック
+            if (ps_pairing->e_sts == MSG_PAIRING_CHK_LOCAL) {
+                // 相互認証完了
+                // チケットの書き込み
+                if (sts_create_ticket(ps_tran, ps_pairing) != ESP_OK) {
+                    // ペアリングエラー
+                    // 受信ステータス
+                    e_rcv_sts = COM_BLE_MSG_RCV_HANDLING_ERR;
+                    // ユーザーイベント
+                    e_cb_evt = COM_BLE_MSG_EVT_HANDLING_ERR;
+                    break;
+                }
+                // イベントエンキュー
+                v_msg_evt_enqueue(COM_BLE_MSG_EVT_PAIRING_SUCCESS);
+                // トランザクション終了
+                v_msg_ctrl_sts_transaction_reset();
+                break;
+            }
+            // 既に受信しているか判定
+            if (ps_pairing->e_sts == MSG_PAIRING_CHK_REMOTE) {
+                // ダイジェスト一致を複数回受信
+                // 受信ステータス
+                e_rcv_sts = COM_BLE_MSG_RCV_PAIRING_ERR;
+                // ユーザーイベント
+                e_cb_evt = COM_BLE_MSG_EVT_PAIRING_ERR;
+                break;
+            }
+            // リモートダイジェスト一致
+            ps_pairing->e_sts = MSG_PAIRING_CHK_REMOTE;
+            break;
+        case COM_BLE_MSG_TYP_DIGEST_ERR:
+            //------------------------------------------------------------------
+            // ダイジェスト不一致
+            //------------------------------------------------------------------
+            // 受信ステータス
+            e_rcv_sts = COM_BLE_MSG_RCV_PAIRING_ERR;
+            // ユーザーイベント
+            e_cb_evt = COM_BLE_MSG_EVT_PAIRING_ERR;
+            break;
+        case COM_BLE_MSG_TYP_STATUS_REQ:
+            //------------------------------------------------------------------
+            // ステータス要求
+            //------------------------------------------------------------------
+            // ステータスチェックトランザクション開始
+            if (sts_begin_sts_chk() != ESP_OK) {
+#ifdef COM_BLE_MSG_DEBUG
+                ESP_LOGW(LOG_TAG, "%s L#%d Evt=COM_BLE_MSG_EVT_STATUS_ERR", __func__, __LINE__);
+#endif
+                // 受信ステータス
+                e_rcv_sts = COM_BLE_MSG_RCV_STS_CHK_ERR;
+                // ユーザーイベント
+                e_cb_evt = COM_BLE_MSG_EVT_STATUS_ERR;
+                break;
+            }
+            // 受信したチェック乱数を保存
+            memcpy(ps_sts_chk->u8_rx_rand, ps_rx_data->pu8_values, COM_MSG_SIZE_TICKET_STS);
+#ifdef COM_BLE_MSG_DEBUG
+            do {
+                char sts_txt[(COM_MSG_SIZE_TICKET_STS * 2) + 1];
+                v_vutil_u8_to_hex_string(ps_sts_chk->u8_rx_rand, COM_MSG_SIZE_TICKET_STS, sts_txt);
+                ESP_LOGW(LOG_TAG, "%s L#%d rx_rand=%s", __func__, __LINE__, sts_txt);
+            } while(false);
+#endif
+            // 応答メッセージを生成
+            ps_tx_msg = ps_create_msg_data(COM_BLE_MSG_TYP_STATUS_RSP1, NULL);
+            if (ps_tx_msg == NULL) {
+                // 受信ステータス
+                e_rcv_sts = COM_BLE_MSG_RCV_HANDLING_ERR;
+                // ユーザーイベント
+                e_cb_evt = COM_BLE_MSG_EVT_HANDLING_ERR;
+                break;
+            }
+            // ステータス応答１を返信する
+            sts_val = s_msg_ctrl_cfg.pf_tx_msg(ps_tx_msg);
+            // 送信済みデータを解放
+            sts_mdl_delete_u8_array(ps_tx_msg);
+            if (sts_val != ESP_OK) {
+                // 受信ステータス
+                e_rcv_sts = COM_BLE_MSG_RCV_HANDLING_ERR;
+                // ユーザーイベント
+                e_cb_evt = COM_BLE_MSG_EVT_HANDLING_ERR;
+                break;
+            }
+            // イベントエンキュー
+            v_msg_evt_enqueue(COM_BLE_MSG_EVT_STATUS_CHK);
+            break;
+        case COM_BLE_MSG_TYP_STATUS_RSP1:
+            //------------------------------------------------------------------
+            // ステータス応答１
+            //------------------------------------------------------------------
+            // 受信したチェック乱数を保存
+            memcpy(ps_sts_chk->u8_rx_rand, &ps_rx_data->pu8_values[MSG_SIZE_CHECK_CODE], MSG_SIZE_CHECK_RANDOM);
+#ifdef COM_BLE_MSG_DEBUG
+            do {
+                char sts_txt[(COM_MSG_SIZE_TICKET_STS * 2) + 1];
+                v_vutil_u8_to_hex_string(ps_sts_chk->u8_rx_rand, COM_MSG_SIZE_TICKET_STS, sts_txt);
+                ESP_LOGW(LOG_TAG, "%s L#%d rx_rand=%s", __func__, __LINE__, sts_txt);
+            } while(false);
+#endif
+            // 応答メッセージを生成
+            ps_tx_msg = ps_create_msg_data(COM_BLE_MSG_TYP_STATUS_RSP2, NULL);
+            if (ps_tx_msg == NULL) {
+                // 受信ステータス
+                e_rcv_sts = COM_BLE_MSG_RCV_HANDLING_ERR;
+                // ユーザーイベント
+                e_cb_evt = COM_BLE_MSG_EVT_HANDLING_ERR;
+                break;
+            }
+            // ステータス応答２を返信する
+            sts_val = s_msg_ctrl_cfg.pf_tx_msg(ps_tx_msg);
+            // 送信済みデータを解放
+            sts_mdl_delete_u8_array(ps_tx_msg);
+            if (sts_val != ESP_OK) {
+                // 受信ステータス
+                e_rcv_sts = COM_BLE_MSG_RCV_HANDLING_ERR;
+                // ユーザーイベント
+                e_cb_evt = COM_BLE_MSG_EVT_HANDLING_ERR;
+                break;
+            }
+            // チェックコードの検証
+            if (sts_status_check(ps_rx_msg->u64_device_id, ps_rx_data->pu8_values, ps_ticket) == ESP_OK) {
+                // イベントエンキュー
+                v_msg_evt_enqueue(COM_BLE_MSG_EVT_STATUS_OK);
+            } else {
+                // 受信ステータス
+                e_rcv_sts = COM_BLE_MSG_RCV_STS_CHK_ERR;
+                // ユーザーイベント
+                e_cb_evt = COM_BLE_MSG_EVT_STATUS_ERR;
+            }
+            // トランザクション終了
+            v_msg_ctrl_sts_transaction_reset();
+            break;
+        case COM_BLE_MSG_TYP_STATUS_RSP2:
+            //------------------------------------------------------------------
+            // ステータス応答２
+            //------------------------------------------------------------------
+            // チェックコードの検証
+            if (sts_status_check(ps_rx_msg->u64_device_id, ps_rx_data->pu8_values, ps_ticket) == ESP_OK) {
+                // イベントエンキュー
+                v_msg_evt_enqueue(COM_BLE_MSG_EVT_STATUS_OK);
+            } else {
+                // 受信ステータス
+                e_rcv_sts = COM_BLE_MSG_RCV_STS_CHK_ERR;
+                // ユーザーイベント
+                e_cb_evt = COM_BLE_MSG_EVT_STATUS_ERR;
+            }
+            // トランザクション終了
+            v_msg_ctrl_sts_transaction_reset();
+            break;
+        case COM_BLE_MSG_TYP_DATA:
+            //------------------------------------------------------------------
+            // データ
+            //------------------------------------------------------------------
+            // イベントエンキュー
+            v_msg_evt_enqueue(COM_BLE_MSG_EVT_RX_DATA);
+            break;
+        case COM_BLE_MSG_TYP_CIPHERTEXT:
+            //------------------------------------------------------------------
+            // 暗号データ
+            //------------------------------------------------------------------
+            // イベントエンキュー
+            v_msg_evt_enqueue(COM_BLE_MSG_EVT_RX_CIPHERTEXT);
+            break;
+        default:
+            // 受信ステータス
+            e_rcv_sts = COM_BLE_MSG_RCV_HANDLING_ERR;
+            // ユーザーイベント
+            e_cb_evt = COM_BLE_MSG_EVT_HANDLING_ERR;
+        }
+    } while(false);
+
+    //==========================================================================
+    // 終了処理
+    //==========================================================================
+
+    //--------------------------------------------------------------------------
+    // 受信応答処理
+    //--------------------------------------------------------------------------
+    // メッセージ定義の取得
+    const ts_msg_definition_t* ps_rx_def = &MSG_DEF[ps_rx_msg->e_type];
+    // 受信通知判定
+    if (ps_rx_def->b_response) {
+        // 受信応答が必要なメッセージの場合
+        // 受信応答を送信
+        sts_tx_response(ps_rx_msg->e_type, e_rcv_sts, ps_rx_msg->u32_seq_no);
+    }
+
+    //--------------------------------------------------------------------------
+    // 受信ステータス処理
+    //--------------------------------------------------------------------------
+    if (e_rcv_sts != COM_BLE_MSG_RCV_NORMAL) {
+        // 受信エラーの場合
+        // ユーザーイベント判定
+        if (e_cb_evt != COM_BLE_MSG_EVT_COUNT) {
+            // イベントエンキュー
+            v_msg_evt_enqueue(e_cb_evt);
+        }
+        // コネクションリセット
+        if (e_rcv_sts != COM_BLE_MSG_RCV_STS_CHK_ERR) {
+            v_msg_ctrl_sts_connection_reset();
+        }
+        // 異常終了
+        return e_rcv_sts;
+    }
+
+    //--------------------------------------------------------------------------
+    // 正常受信処理
+    //--------------------------------------------------------------------------
+    // 受信カウンタの更新
+    s_msg_ctrl_sts.u64_rx_count++;
+    // 受信履歴の更新
+    ts_msg_history_t* ps_bef_rx_msg = NULL;
+    if (ps_rx_msg->e_type != COM_BLE_MSG_TYP_RESPONSE) {
+        // 受信メッセージ
+        ps_bef_rx_msg = &s_msg_ctrl_sts.s_bef_rx_msg;
+    } else {
+        // 受信応答メッセージ
+        ps_bef_rx_msg = &s_msg_ctrl_sts.s_bef_rx_rsp;
+    }
+    v_com_ble_addr_cpy(ps_bef_rx_msg->t_bda, ps_rx_msg->t_rcv_bda);
+    ps_bef_rx_msg->u32_tick_ms    = ps_rx_msg->u32_rcv_tick_ms;
+    ps_bef_rx_msg->u64_device_id  = ps_rx_msg->u64_device_id;
+    ps_bef_rx_msg->u32_seq_no     = ps_rx_msg->u32_seq_no;
+    ps_bef_rx_msg->e_type         = ps_rx_msg->e_type;
+
+    // 結果ステータスを返信
+    return e_rcv_sts;
+}
+
+/*******************************************************************************
+ *
+ * NAME: sts_tx_response
+ *
+ * DESCRIPTION:BLEの受信応答の送信処理
+ *
+ * PARAMETERS:              Name            RW  Usage
+ * te_com_ble_msg_type_t    e_rx_type       R   受信メッセージタイプ
+ * te_com_ble_msg_rcv_sts_t e_rx_sts        R   受信ステータス
+ * uint32_t                 u32_seq_no      R   メッセージSEQ番号
+ *
+ * RETURNS:
+ *   esp_err_t 結果ステータス
+ *
+ * NOTES:
+ * None.
+ ******************************************************************************/
+static esp_err_t sts_tx_response(te_com_ble_msg_type_t e_rx_type,
+                                  te_com_ble_msg_rcv_sts_t e_rx_sts,
+                                  uint32_t u32_seq_no) {
+    //==========================================================================
+    // 受信通知メッセージ生成
+    //==========================================================================
+#ifdef COM_BLE_MSG_DEBUG
+    ESP_LOGW(LOG_TAG, "%s L#%d rcv_type=%d rx_sts=%02x seq=%lu", __func__, __LINE__, e_rx_type, e_rx_sts, (unsigned long)u32_seq_no);
+#endif
+    // メッセージ定義の取得
+    const ts_msg_definition_t* ps_def = &MSG_DEF[COM_BLE_MSG_TYP_RESPONSE];
+    // 累積確認応答の有無（ウィンドウ制御を合意した相手の暗号文への応答のみ）
+    ts_com_msg_auth_ticket_t* ps_ticket = &s_msg_ctrl_sts.s_rmt_ticket;
+    bool b_cum_ack = (e_rx_type == COM_BLE_MSG_TYP_CIPHERTEXT &&
+                      ps_ticket->u64_rmt_device_id == s_msg_ctrl_sts.u64_rmt_device_id &&
+                      ps_ticket->u8_tx_window > 1);
+    // メッセージ長
+    uint16_t u16_length = ps_def->u16_length + (b_cum_ack ? MSG_SIZE_CUM_ACK : 0);
+    // メッセージデータ
+    ts_u8_array_t* ps_msg = ps_mdl_empty_u8_array(u16_length);
+    if (ps_msg == NULL) {
+        return ESP_ERR_NO_MEM;
+    }
+
+    //--------------------------------------------------------------------------
+    // ヘッダー編集
+    //--------------------------------------------------------------------------
+    // 編集：デバイスID
+    uint8_t* pu8_value = ps_msg->pu8_values;
+    tu_type_converter_t u_conv;
+    u_conv.u64_value = s_msg_ctrl_cfg.u64_device_id;
+    pu8_value[MSG_POS_DEVICE_ID]     = u_conv.u8_values[0];
+    pu8_value[MSG_POS_DEVICE_ID + 1] = u_conv.u8_values[1];
+    pu8_value[MSG_POS_DEVICE_ID + 2] = u_conv.u8_values[2];
+    pu8_value[MSG_POS_DEVICE_ID + 3] = u_conv.u8_values[3];
+    pu8_value[MSG_POS_DEVICE_ID + 4] = u_conv.u8_values[4];
+    pu8_value[MSG_POS_DEVICE_ID + 5] = u_conv.u8_values[5];
+    pu8_value[MSG_POS_DEVICE_ID + 6] = u_conv.u8_values[6];
+    pu8_value[MSG_POS_DEVICE_ID + 7] = u_conv.u8_values[7];
+    // 編集：メッセージタイプ
+    pu8_value[MSG_POS_TYPE] = COM_BLE_MSG_TYP_RESPONSE;
+    // 編集：メッセージ長
+    u_conv.u16_values[0] = u16_length;
+    pu8_value[MSG_POS_MSG_LEN]     = u_conv.u8_values[0];
+    pu8_value[MSG_POS_MSG_LEN + 1] = u_conv.u8_values[1];
+    // 編集：シーケンス番号
+    u_conv.u32_values[0] = u32_seq_no;
+    pu8_value[MSG_POS_SEQ_NO]     = u_conv.u8_values[0];
+    pu8_value[MSG_POS_SEQ_NO + 1] = u_conv.u8_values[1];
+    pu8_value[MSG_POS_SEQ_NO + 2] = u_conv.u8_values[2];
+    pu8_value[MSG_POS_SEQ_NO + 3] = u_conv.u8_values[3];
+
+    //--------------------------------------------------------------------------
+    // 本文編集
+    //--------------------------------------------------------------------------
+    // 受信メッセージタイプ
+    pu8_value[MSG_POS_BODY] = e_rx_type;
+    // 受信ステータス
+    pu8_value[MSG_POS_BODY + 1] = e_rx_sts;
+    // 累積確認応答（順序通りに受信済みの最大シーケンス番号）
+    uint16_t u16_footer_pos = MSG_POS_RSP_CUM_ACK;
+    if (b_cum_ack) {
+        u_conv.u32_values[0] = ps_ticket->u32_rx_seq_no;
+        pu8_value[MSG_POS_RSP_CUM_ACK]     = u_conv.u8_values[0];
+        pu8_value[MSG_POS_RSP_CUM_ACK + 1] = u_conv.u8_values[1];
+        pu8_value[MSG_POS_RSP_CUM_ACK + 2] = u_conv.u8_values[2];
+        pu8_value[MSG_POS_RSP_CUM_ACK + 3] = u_conv.u8_values[3];
+        u16_footer_pos += MSG_SIZE_CUM_ACK;
+    }
+
+    //--------------------------------------------------------------------------
+    // フッター編集
+    //--------------------------------------------------------------------------
+    // 乱数
+    b_vutil_set_u8_rand_array(&pu8_value[u16_footer_pos], MSG_SIZE_RANDOM);
+    // ストップトークン
+    u_conv.u16_values[0] = u32_seq_no;
+    pu8_value[u16_length - 2] = u_conv.u8_values[0];
+    pu8_value[u16_length - 1] = u_conv.u8_values[1];
+
+    //==========================================================================
+    // レスポンス送信処理
+    //==========================================================================
+    // レスポンスを返信
+    esp_err_t sts_val = s_msg_ctrl_cfg.pf_tx_msg(ps_msg);
+    // レスポンスデータクリア
+    sts_mdl_delete_u8_array(ps_msg);
+
+    // 結果返信
+    return sts_val;
+}
+
+/*******************************************************************************
+ *
+ * NAME: sts_tx_reset_msg
+ *
+ * DESCRIPTION:BLE Tx reset message
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *
+ * RETURNS:
+ * esp_err_t:送信結果
+ *
+ * NOTES:
+ * None.
+ ******************************************************************************/
+static esp_err_t sts_tx_reset_msg() {
+    //----------------------------------------------------------------------
+    // 接続判定
+    //----------------------------------------------------------------------
+    if (s_msg_ctrl_cfg.pf_connect_sts() != COM_BLE_MSG_CON_CONNECTED) {
+        // 未接続
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    //----------------------------------------------------------------------
+    // メッセージ生成
+    //----------------------------------------------------------------------
+    ts_u8_array_t* ps_msg = ps_create_msg_data(COM_BLE_MSG_TYP_RESET, NULL);
+    if (ps_msg == NULL) {
+        return ESP_ERR_NO_MEM;
+    }
+
+    //----------------------------------------------------------------------
+    // メッセージの送信
+    //----------------------------------------------------------------------
+    esp_err_t sts_val = s_msg_ctrl_cfg.pf_tx_msg(ps_msg);
+
+    //----------------------------------------------------------------------
+    // 送信メッセージ解放
+    //----------------------------------------------------------------------
+    sts_mdl_delete_u8_array(ps_msg);
+
+    // 結果返信
+    return sts_val;
+}
+
+/*******************************************************************************
+ *
+ * NAME: sts_tx_ping_msg
+ *
+ * DESCRIPTION:BLE Tx ping message
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *
+ * RETURNS:
+ * esp_err_t:送信結果
+ *
+ * NOTES:
+ * None.
+ ******************************************************************************/
+static esp_err_t sts_tx_ping_msg() {
+    //----------------------------------------------------------------------
+    // 接続判定
+    //----------------------------------------------------------------------
+    if (s_msg_ctrl_cfg.pf_connect_sts() != COM_BLE_MSG_CON_CONNECTED) {
+        // 未接続
+        return  ESP_ERR_INVALID_STATE;
+    }
+
+    //----------------------------------------------------------------------
+    // メッセージ生成
+    //----------------------------------------------------------------------
+    ts_u8_array_t* ps_msg = ps_create_msg_data(COM_BLE_MSG_TYP_PING, NULL);
+    if (ps_msg == NULL) {
+        return  ESP_ERR_NO_MEM;
+    }
+
+    //----------------------------------------------------------------------
+    // メッセージの送信
+    //----------------------------------------------------------------------
+    esp_err_t sts_val = s_msg_ctrl_cfg.pf_tx_msg(ps_msg);
+
+    //----------------------------------------------------------------------
+    // 送信メッセージ解放
+    //----------------------------------------------------------------------
+    sts_mdl_delete_u8_array(ps_msg);
+
+    // 結果返信
+    return sts_val;
+}
+
+/*******************************************************************************
+ *
+ * NAME: v_upd_tx_history
+ *
+ * DESCRIPTION:送信履歴の更新処理
+ *
+ * PARAMETERS:      Name        RW  Usage
+ * ts_u8_array_t*   ps_msg      R   送信メッセージ
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * None.
+ ******************************************************************************/
+static void v_upd_tx_history(ts_u8_array_t* ps_msg) {
+    //==========================================================================
+    // 送信カウンタの更新
+    //==========================================================================
+    s_msg_ctrl_sts.u64_tx_count++;
+
+    //==========================================================================
+    // 送信履歴の更新
+    //==========================================================================
+    uint8_t* pu8_value = ps_msg->pu8_values;
+    if (pu8_value[MSG_POS_TYPE] == COM_BLE_MSG_TYP_RESPONSE) {
+        // 受信通知の場合は履歴を更新しない
+        return;
+    }
+
+    //==========================================================================
+    // 送信履歴の更新
+    //==========================================================================
+    // 受信通知以外の場合　※送信履歴のBLEアドレスは使用しない
+    ts_msg_history_t* ps_bef_tx_msg = &s_msg_ctrl_sts.s_bef_tx_msg;
+    // デバイスID
+    tu_type_converter_t u_conv;
+    u_conv.u8_values[0] = pu8_value[MSG_POS_DEVICE_ID];
+    u_conv.u8_values[1] = pu8_value[MSG_POS_DEVICE_ID + 1];
+    u_conv.u8_values[2] = pu8_value[MSG_POS_DEVICE_ID + 2];
+    u_conv.u8_values[3] = pu8_value[MSG_POS_DEVICE_ID + 3];
+    u_conv.u8_values[4] = pu8_value[MSG_POS_DEVICE_ID + 4];
+    u_conv.u8_values[5] = pu8_value[MSG_POS_DEVICE_ID + 5];
+    u_conv.u8_values[6] = pu8_value[MSG_POS_DEVICE_ID + 6];
+    u_conv.u8_values[7] = pu8_value[MSG_POS_DEVICE_ID + 7];
+    ps_bef_tx_msg->u64_device_id = u_conv.u64_value;
+    // シーケンス番号
+    u_conv.u8_values[0] = pu8_value[MSG_POS_SEQ_NO];
+    u_conv.u8_values[1] = pu8_value[MSG_POS_SEQ_NO + 1];
+    u_conv.u8_values[2] = pu8_value[MSG_POS_SEQ_NO + 2];
+    u_conv.u8_values[3] = pu8_value[MSG_POS_SEQ_NO + 3];
+    ps_bef_tx_msg->u32_seq_no = u_conv.u32_values[0];
+    // 送信時間
+    ps_bef_tx_msg->u32_tick_ms = xTaskGetTickCountMSec();
+    // タイプ
+    ps_bef_tx_msg->e_type = pu8_value[MSG_POS_TYPE];
+}
+
+/*******************************************************************************
+ *
+ * NAME: b_is_public_key_received
+ *
+ * DESCRIPTION:Public key received check
+ *
+ * PARAMETERS:  Name            RW  Usage
+ *
+ * RETURNS:
+ *   true:公開鍵受信済み
+ *
+ * NOTES:
+ * None.
+ ******************************************************************************/
+static bool b_is_public_key_received() {
+    //----------------------------------------------------------------------
+    // 公開鍵の受信済み判定
+    //----------------------------------------------------------------------
+    ts_pairing_info_t* ps_pairing = &s_msg_ctrl_sts.s_pairing;
+    // X25519コンテキスト
+    ts_crypto_x25519_context_t* ps_x25519_ctx = ps_pairing->ps_x25519_ctx;
+    if (ps_x25519_ctx == NULL) {
+        return false;
+    }
+    // 公開鍵（サーバー）
+    uint8_t* pu8_svr_key = ps_x25519_ctx->u8_svr_public_key;
+    if (pu8_svr_key[0] != 0x20) {
+        return false;
+    }
+    // 公開鍵（クライアント）
+    uint8_t* pu8_cli_key = ps_x25519_ctx->u8_cli_public_key;
+    tu_type_converter_t u_type_conv;
+    u_type_conv.u8_values[0] = pu8_cli_key[0];
+    u_type_conv.u8_values[1] = pu8_cli_key[1];
+    u_type_conv.u8_values[2] = pu8_cli_key[2];
+    u_type_conv.u8_values[3] = pu8_cli_key[3];
+    // 公開鍵受信済み
+    return (u_type_conv.u32_values[0] == 0x201D0003);
+}
+
+/*******************************************************************************
+ *
+ * NAME: b_is_paired
+ *
+ * DESCRIPTION:pairing check
+ *
+ * PARAMETERS:  Name            RW  Usage
+ * uint64_t     u64_device_id   R   対象デバイスID
+ *
+ * RETURNS:
+ *   true:ペアリング済み
+ *
+ * NOTES:
+ * None.
+ ******************************************************************************/
+static bool b_is_paired(uint64_t u64_device_id) {
+    //==========================================================================
+    // 入力チェック
+    //==========================================================================
+    // リモートデバイスの有無を判定
+    if (u64_device_id == s_msg_ctrl_cfg.u64_device_id) {
+        return false;
+    }
+
+    //==========================================================================
+    // チケット取得
+    //==========================================================================
+    // チケット取得
+    ts_com_msg_auth_ticket_t s_ticket;
+    ts_com_msg_auth_ticket_t* ps_ticket = ps_read_ticket(u64_device_id, &s_ticket);
+    // チケットの有効判定
+    if (ps_ticket == NULL) {
+        return false;
+    }
+    // シーケンス番号の有効判定
+    if (ps_ticket->u32_tx_seq_no >= ps_ticket->u32_max_seq_no) {
+        return false;
+    }
+    // 結果返信
+    return true;
+}
+
+/*******************************************************************************
+ *
+ * NAME: sts_begin_open
+ *
+ * DESCRIPTION:オープントランザクションの開始
+ *
+ * PARAMETERS:      Name            RW  Usage
+ * esp_bd_addr_t    t_bda           R   接続先BLEアドレス
+ * uint32_t*        pu32_timeout_ms W   トランザクションタイムアウトの編集先
+ *
+ * RETURNS:
+ *   esp_err_t 結果ステータス
+ *
+ * NOTES:
+ * None.
+ ******************************************************************************/
+static esp_err_t sts_begin_open(esp_bd_addr_t t_bda, uint32_t* pu32_timeout_ms) {
+    //==========================================================================
+    // トランザクション開始チェック
+    //==========================================================================
+    // 現在の接続先を判定
+    if (l_com_ble_addr_cmp(t_bda, s_msg_ctrl_sts.t_rmt_bda) == 0) {
+        // 既に接続済み
+        return ESP_ERR_INVALID_STATE;
+    }
+    // トランザクション状態チェック
+    ts_transaction_info_t* ps_tran = &s_msg_ctrl_sts.s_tran;
+    if (ps_tran->e_sts != COM_BLE_MSG_TRN_NONE) {
+        // トランザクション実行中
+        return ESP_ERR_INVALID_STATE;
+    }
+    // 接続状態チェック
+    if (s_msg_ctrl_cfg.pf_connect_sts() != COM_BLE_MSG_CON_DISCONNECTED) {
+        // 接続中もしくは接続済み
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    //==========================================================================
+    // オープントランザクションの開始処理
+    //==========================================================================
+    // オープントランザクション開始
+    ps_tran->e_sts = COM_BLE_MSG_TRN_OPEN;
+    // 相手デバイスIDクリア
+    ps_tran->u64_device_id = s_msg_ctrl_cfg.u64_device_id;
+    // BLEのアドレスコピー
+    v_com_ble_addr_cpy(ps_tran->t_bda, t_bda);
+    // トランザクションタイムアウト
+    *pu32_timeout_ms = xTaskGetTickCountMSec() + COM_MSG_TRN_TIMEOUT_MS_OPEN;
+    ps_tran->u32_timeout_ms = *pu32_timeout_ms;
+    sts_tmw_start(&s_msg_deamon_sts.s_tran_timer, COM_MSG_TRN_TIMEOUT_MS_OPEN, 0);
+
+    // 正常終了
+    return ESP_OK;
+}
+
+/*******************************************************************************
+ *
+ * NAME: sts_begin_pairing
+ *
+ * DESCRIPTION:ペアリングトランザクションの開始
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *
+ * RETURNS:
+ *   esp_err_t 結果ステータス
+ *
+ * NOTES:
+ * None.
+ ******************************************************************************/
+static esp_err_t sts_begin_pairing() {
+    //==========================================================================
+    // トランザクション開始チェック
+    //==========================================================================
+    //--------------------------------------------------------------------------
+    // ペアリング機能の有効チェック
+    //--------------------------------------------------------------------------
+    if ((s_msg_ctrl_cfg.s_func_ctl & MSG_FUNC_CTL_PAIRING) == 0x00) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    //--------------------------------------------------------------------------
+    // トランザクション状態チェック
+    //--------------------------------------------------------------------------
+    ts_transaction_info_t* ps_tran = &s_msg_ctrl_sts.s_tran;
+    if (ps_tran->e_sts != COM_BLE_MSG_TRN_NONE) {
+        // トランザクション実行中
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    //--------------------------------------------------------------------------
+    // 接続チェック
+    //--------------------------------------------------------------------------
+    if (s_msg_ctrl_cfg.pf_connect_sts() != COM_BLE_MSG_CON_CONNECTED) {
+        // 未接続
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    //==========================================================================
+    // ペアリングトランザクションの開始処理
+    //==========================================================================
+    //--------------------------------------------------------------------------
+    // トランザクション情報を編集
+    //--------------------------------------------------------------------------
+    // ペアリングトランザクション開始
+    ps_tran->e_sts = COM_BLE_MSG_TRN_PAIRING;
+    // 相手デバイスID
+    ps_tran->u64_device_id = s_msg_ctrl_sts.u64_rmt_device_id;
+    // BLEのアドレスコピー
+    v_com_ble_addr_cpy(ps_tran->t_bda, s_msg_ctrl_sts.t_rmt_bda);
+    // トランザクションタイムアウト
+    ps_tran->u32_timeout_ms = xTaskGetTickCountMSec() + COM_MSG_TRN_TIMEOUT_MS_PAIRING;
+    sts_tmw_start(&s_msg_deamon_sts.s_tran_timer, COM_MSG_TRN_TIMEOUT_MS_PAIRING, 0);
+
+    //--------------------------------------------------------------------------
+    // ペアリングステータスを編集
+    //--------------------------------------------------------------------------
+    ts_pairing_info_t* ps_pairing = &s_msg_ctrl_sts.s_pairing;
+    // ペアリングステータス
+    ps_pairing->e_sts = MSG_PAIRING_CHK_NONE;
+    // 共通鍵
+    memset(ps_pairing->u8_com_key, 0x00, COM_MSG_SIZE_CIPHER_KEY);
+    // X25519コンテキストを削除
+    v_crypto_x25519_delete_context(ps_pairing->ps_x25519_ctx);
+    ps_pairing->ps_x25519_ctx = NULL;
+    // 自デバイスステータス
+    b_vutil_set_u8_rand_array(ps_pairing->u8_dev_status, COM_MSG_SIZE_TICKET_STS);
+    // 相手デバイスステータスハッシュ
+    memset(ps_pairing->u8_rmt_sts_hash, 0x00, COM_MSG_SIZE_TICKET_STS);
+    // 最大シーケンス番号
+    ps_pairing->u32_max_seq_no = 0;
+    // 正常終了
+    return ESP_OK;
+}
+
+/*******************************************************************************
+ *
+ * NAME: sts_begin_sts_chk
+ *
+ * DESCRIPTION:ステータスチェックトランザクションの開始
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *
+ * RETURNS:
+ *   esp_err_t 結果ステータス
+ *
+ * NOTES:
+ * None.
+ ******************************************************************************/
+static esp_err_t sts_begin_sts_chk() {
+    //==========================================================================
+    // トランザクション開始チェック
+    //==========================================================================
+    //--------------------------------------------------------------------------
+    // 機能の有効判定
+    //--------------------------------------------------------------------------
+    if ((s_msg_ctrl_cfg.s_func_ctl & MSG_FUNC_CTL_STS_CHK) == 0x00) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    //--------------------------------------------------------------------------
+    // トランザクション状態チェック
+    //--------------------------------------------------------------------------
+    ts_transaction_info_t* ps_tran = &s_msg_ctrl_sts.s_tran;
+    if (ps_tran->e_sts != COM_BLE_MSG_TRN_NONE) {
+        // トランザクション実行中
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    //--------------------------------------------------------------------------
+    // ペアリング済み判定
+    //--------------------------------------------------------------------------
+    if (!b_is_paired(s_msg_ctrl_sts.u64_rmt_device_id)) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    //--------------------------------------------------------------------------
+    // 接続判定
+    //--------------------------------------------------------------------------
+    if (s_msg_ctrl_cfg.pf_connect_sts() != COM_BLE_MSG_CON_CONNECTED) {
+#ifdef COM_BLE_MSG_DEBUG
+        ESP_LOGE(LOG_TAG, "%s L#%d Err=ESP_ERR_INVALID_STATE", __func__, __LINE__);
+#endif
+        // 未接続
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    //==========================================================================
+    // ステータスチェックトランザクションの開始処理
+    //==========================================================================
+    // ステータスチェックトランザクション開始
+    ps_tran->e_sts = COM_BLE_MSG_TRN_STS_CHK;
+    // 相手デバイスID
+    ps_tran->u64_device_id = s_msg_ctrl_sts.u64_rmt_device_id;
+    // BLEのアドレスコピー
+    v_com_ble_addr_cpy(ps_tran->t_bda, s_msg_ctrl_sts.t_rmt_bda);
+    // トランザクションタイムアウト
+    ps_tran->u32_timeout_ms = xTaskGetTickCountMSec() + COM_MSG_TRN_TIMEOUT_MS_STS_CHK;
+    sts_tmw_start(&s_msg_deamon_sts.s_tran_timer, COM_MSG_TRN_TIMEOUT_MS_STS_CHK, 0);
+
+    //--------------------------------------------------------------------------
+    // ステータスチェックを初期化
+    //--------------------------------------------------------------------------
+    ts_sts_check_info_t* ps_sts_chk = &s_msg_ctrl_sts.s_sts_chk;
+    // 送信ステータスチェック乱数
+    memset(ps_sts_chk->u8_tx_rand, 0x00, COM_MSG_SIZE_TICKET_STS);
+    // 受信ステータスチェック乱数
+    memset(ps_sts_chk->u8_rx_rand, 0x00, COM_MSG_SIZE_TICKET_STS);
+
+    // 正常終了
+    return ESP_OK;
+}
+
+/*******************************************************************************
+ *
+ * NAME: sts_status_check
+ *
+ * DESCRIPTION:ステータスチェック
+ *
+ * PARAMETERS:                  Name            RW  Usage
+ * uint64_t                     u64_device_id   R   デバイスID
+ * uint8_t*                     pu8_chk_code    R   チェックコード
+ * ts_com_msg_auth_ticket_t*    ps_ticket       R   チケット
+ *
+ * RETURNS:
+ *   esp_err_t:結果ステータス
+ *
+ * NOTES:
+ * None.
+ ******************************************************************************/
+static esp_err_t sts_status_check(uint64_t u64_device_id, uint8_t* pu8_chk_code, ts_com_msg_auth_ticket_t* ps_ticket) {
+    // 自デバイスの１次ステータスハッシュ生成
+    ts_u8_array_t* ps_own_sts = ps_mdl_create_u8_array(ps_ticket->u8_own_sts, COM_MSG_SIZE_TICKET_STS);
+    if (ps_own_sts == NULL) {
+        return ESP_ERR_NO_MEM;
+    }
+    uint8_t u8_own_hash[COM_MSG_SIZE_TICKET_STS];
+    esp_err_t sts_val = sts_crypto_sha256(ps_own_sts, COM_MSG_AUTH_STRETCHING, u8_own_hash);
+    sts_mdl_delete_u8_array(ps_own_sts);
+    if (sts_val != ESP_OK) {
+        return sts_val;
+    }
+    // １次ステータスハッシュに送信したチェック乱数を排他的論理和
+    ts_sts_check_info_t* ps_sts_chk = &s_msg_ctrl_sts.s_sts_chk;
+    v_vutil_xor_into(u8_own_hash, ps_sts_chk->u8_tx_rand, COM_MSG_SIZE_TICKET_STS);
+    // ２次ステータスコードハッシュを生成
+    ts_u8_array_t* ps_own_hash = ps_mdl_create_u8_array(u8_own_hash, COM_MSG_SIZE_TICKET_STS);
+    if (ps_own_hash == NULL) {
+        return ESP_ERR_NO_MEM;
+    }
+    uint8_t u8_chk_code[COM_MSG_SIZE_TICKET_STS];
+    sts_val = sts_crypto_sha256(ps_own_hash, COM_MSG_AUTH_STRETCHING, u8_chk_code);
+    sts_mdl_delete_u8_array(ps_own_hash);
+    if (sts_val != ESP_OK) {
+        return sts_val;
+    }
+#ifdef COM_BLE_MSG_DEBUG
+    char sts_txt[(COM_MSG_SIZE_TICKET_STS * 2) + 1];
+    v_vutil_u8_to_hex_string(ps_ticket->u8_own_sts, COM_MSG_SIZE_TICKET_STS, sts_txt);
+    ESP_LOGW(LOG_TAG, "%s L#%d tkt sts_code=%s", __func__, __LINE__, sts_txt);
+    v_vutil_u8_to_hex_string(ps_sts_chk->u8_tx_rand, COM_MSG_SIZE_TICKET_STS, sts_txt);
+    ESP_LOGW(LOG_TAG, "%s L#%d tkt sts_rand=%s", __func__, __LINE__, sts_txt);
+    v_vutil_u8_to_hex_string(u8_chk_code, COM_MSG_SIZE_TICKET_STS, sts_txt);
+    ESP_LOGW(LOG_TAG, "%s L#%d tkt sts_hash=%s", __func__, __LINE__, sts_txt);
+    v_vutil_u8_to_hex_string(pu8_chk_code, COM_MSG_SIZE_TICKET_STS, sts_txt);
+    ESP_LOGW(LOG_TAG, "%s L#%d rmt sts_hash=%s", __func__, __LINE__, sts_txt);
+#endif
+    // チェックコードを比較（定数時間比較）
+    if (!b_vutil_ct_equal(pu8_chk_code, u8_chk_code, COM_MSG_SIZE_TICKET_STS)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    // チェックOK
+    return ESP_OK;
+}
+
+/*******************************************************************************
+ *
+ * NAME: sts_msg_encryption
+ *
+ * DESCRIPTION:メッセージの暗号化
+ *
+ * PARAMETERS:                      Name            RW  Usage
+ * ts_u8_array_t*                   ps_msg          RW  メッセージ
+ * uint16_t                         u16_data_len    R   データ長
+ * uint8_t*                         pu8_key*        R   共通鍵
+ * te_com_ble_msg_cipher_suite_t    e_cipher_suite  R   暗号スイート
+ *
+ * RETURNS:
+ *   esp_err_t 結果ステータス
+ *
+ * NOTES:
+ * AES GCMモードの鍵スケジュールはセッション暗号コンテキストのものを再利用する。
+ * ChaCha20-Poly1305のナンスはIVの先頭4バイトにシーケンス番号をXORした値。
+ ******************************************************************************/
+static esp_err_t sts_msg_encryption(ts_u8_array_t* ps_msg,
+                                     uint16_t u16_data_len,
+                                     uint8_t* pu8_key,
+                                     te_com_ble_msg_cipher_suite_t e_cipher_suite) {
+    //==========================================================================
+    // 初期ベクトルの編集
+    //==========================================================================
+    // 型変換
+    tu_type_converter_t u_conv;
+    // メッセージ
+    uint8_t* pu8_msg = ps_msg->pu8_values;
+    // IVの生成
+    b_vutil_set_u8_rand_array(&pu8_msg[MSG_POS_CIPHER_IV], MSG_SIZE_CIPHER_IV);
+    // IVの取得
+    ts_msg_edit_iv_t s_edit_iv;
+    u_conv.u8_values[0] = pu8_msg[MSG_POS_SEQ_NO];
+    u_conv.u8_values[1] = pu8_msg[MSG_POS_SEQ_NO + 1];
+    u_conv.u8_values[2] = pu8_msg[MSG_POS_SEQ_NO + 2];
+    u_conv.u8_values[3] = pu8_msg[MSG_POS_SEQ_NO + 3];
+    s_edit_iv.u32_seq_no = u_conv.u32_values[0];
+    memcpy(s_edit_iv.u8_iv, &pu8_msg[MSG_POS_CIPHER_IV], MSG_SIZE_CIPHER_IV);
+    DBG_TRACE_BEGIN(DBG_TRACE_EVT_MSG_ENCRYPT, s_edit_iv.u32_seq_no);
+    PROF_BEGIN(DBG_PROF_SITE_MSG_ENCRYPT);
 #ifdef COM_BLE_MSG_DEBUG
-            do {
-                char sts_txt[(COM_MSG_SIZE_TICKET_STS * 2) + 1];
-                v_vutil_u8_to_hex_string(ps_pairing->u8_rmt_sts_hash, COM_MSG_SIZE_TICKET_STS, sts_txt);
-                ESP_LOGW(LOG_TAG, "%s L#%d rx_hash=%s", __func__, __LINE__, sts_txt);
-                ESP_LOGW(LOG_TAG, "%s L#%d rx_no=%lu", __func__, __LINE__, (unsigned long)ps_pairing->u32_max_seq_no);
-            } while(false);
+    do {
+        char c_txt_str[(u16_data_len * 2) + 1];
+        v_vutil_u8_to_hex_string(&pu8_msg[MSG_POS_CIPHER_DATA], u16_data_len, c_txt_str);
+        ESP_LOGW(LOG_TAG, "%s L#%d plane=%s", __func__, __LINE__, c_txt_str);
+    } while(false);
 #endif
-            // 相互認証チェック
-            if (ps_pairing->e_sts == MSG_PAIRING_CHK_LOCAL) {
-                // 相互認証完了
-                // チケットの書き込み
-                if (sts_create_ticket(ps_tran, ps_pairing) != ESP_OK) {
-                    // ペアリングエラー
-                    // 受信ステータス
-                    e_rcv_sts = COM_BLE_MSG_RCV_HANDLING_ERR;
-                    // ユーザーイベント
-                    e_cb_evt = COM_BLE_MSG_EVT_HANDLING_ERR;
-                    break;
-                }
-                // イベントエンキュー
-                v_msg_evt_enqueue(COM_BLE_MSG_EVT_PAIRING_SUCCESS);
-                // トランザクション終了
-                v_msg_ctrl_sts_transaction_reset();
-                break;
-            }
-            // 既に受信しているか判定
-            if (ps_pairing->e_sts == MSG_PAIRING_CHK_REMOTE) {
-                // ダイジェスト一致を複数回受信
-                // 受信ステータス
-                e_rcv_sts = COM_BLE_MSG_RCV_PAIRING_ERR;
-                // ユーザーイベント
-                e_cb_evt = COM_BLE_MSG_EVT_PAIRING_ERR;
-                break;
-            }
-            // リモートダイジェスト一致
-            ps_pairing->e_sts = MSG_PAIRING_CHK_REMOTE;
-            break;
-        case COM_BLE_MSG_TYP_DIGEST_ERR:
-            //------------------------------------------------------------------
-            // ダイジェスト不一致
-            //------------------------------------------------------------------
-            // 受信ステータス
-            e_rcv_sts = COM_BLE_MSG_RCV_PAIRING_ERR;
-            // ユーザーイベント
-            e_cb_evt = COM_BLE_MSG_EVT_PAIRING_ERR;
-            break;
-        case COM_BLE_MSG_TYP_STATUS_REQ:
-            //------------------------------------------------------------------
-            // ステータス要求
-            //------------------------------------------------------------------
-            // ステータスチェックトランザクション開始
-            if (sts_begin_sts_chk() != ESP_OK) {
+
+    //==========================================================================
+    // 暗号化(AES GCMモード、ChaCha20-Poly1305)
+    // ※フレーム内の平文を直接暗号文に置き換え、認証タグもフレームに直接編集
+    //==========================================================================
+    esp_err_t sts_val = ESP_FAIL;
+    if (e_cipher_suite == COM_BLE_MSG_CIPHER_CHACHA20_POLY1305) {
+        uint8_t u8_nonce[CRYPTO_CHACHAPOLY_NONCE_SIZE];
+        v_msg_edit_nonce(u8_nonce, &s_edit_iv);
+        sts_val = sts_crypto_chacha20_poly1305_enc_in_place(pu8_key, u8_nonce,
+                                                            MSG_CIPHER_AAD, MSG_SIZE_CIPHER_TAG,
+                                                            &pu8_msg[MSG_POS_CIPHER_DATA], u16_data_len,
+                                                            &pu8_msg[MSG_POS_CIPHER_TAG]);
+    } else {
+        ts_crypto_gcm_context_t* ps_gcm_ctx = ps_session_gcm_context(pu8_key);
+        if (ps_gcm_ctx != NULL) {
+            sts_val = sts_crypto_gcm_enc_in_place(ps_gcm_ctx,
+                                                  (uint8_t*)&s_edit_iv, IV_BYTES,
+                                                  MSG_CIPHER_AAD, MSG_SIZE_CIPHER_TAG,
+                                                  &pu8_msg[MSG_POS_CIPHER_DATA], u16_data_len,
+                                                  &pu8_msg[MSG_POS_CIPHER_TAG], MSG_SIZE_CIPHER_TAG);
+        }
+    }
 #ifdef COM_BLE_MSG_DEBUG
-                ESP_LOGW(LOG_TAG, "%s L#%d Evt=COM_BLE_MSG_EVT_STATUS_ERR", __func__, __LINE__);
+    do {
+        char c_key_str[(COM_MSG_SIZE_CIPHER_KEY * 2) + 1];
+        v_vutil_u8_to_hex_string(pu8_key, COM_MSG_SIZE_CIPHER_KEY, c_key_str);
+        ESP_LOGW(LOG_TAG, "%s L#%d key=%s", __func__, __LINE__, c_key_str);
+        char c_cipher_str[(u16_data_len * 2) + 1];
+        v_vutil_u8_to_hex_string(&pu8_msg[MSG_POS_CIPHER_DATA], u16_data_len, c_cipher_str);
+        ESP_LOGW(LOG_TAG, "%s L#%d cipher=%s", __func__, __LINE__, c_cipher_str);
+        char c_tag_str[(MSG_SIZE_CIPHER_TAG * 2) + 1];
+        v_vutil_u8_to_hex_string(&pu8_msg[MSG_POS_CIPHER_TAG], MSG_SIZE_CIPHER_TAG, c_tag_str);
+        ESP_LOGW(LOG_TAG, "%s L#%d tag=%s", __func__, __LINE__, c_tag_str);
+    } while(false);
 #endif
-                // 受信ステータス
-                e_rcv_sts = COM_BLE_MSG_RCV_STS_CHK_ERR;
-                // ユーザーイベント
-                e_cb_evt = COM_BLE_MSG_EVT_STATUS_ERR;
-                break;
-            }
-            // 受信したチェック乱数を保存
-            memcpy(ps_sts_chk->u8_rx_rand, ps_rx_data->pu8_values, COM_MSG_SIZE_TICKET_STS);
+    DBG_TRACE_END_EVT(DBG_TRACE_EVT_MSG_ENCRYPT, s_edit_iv.u32_seq_no, u16_data_len);
+    PROF_END(DBG_PROF_SITE_MSG_ENCRYPT);
+
+    // 結果返信
+    return sts_val;
+}
+
+/*******************************************************************************
+ *
+ * NAME: v_msg_edit_nonce
+ *
+ * DESCRIPTION:ChaCha20-Poly1305のナンス編集
+ *
+ * PARAMETERS:          Name            RW  Usage
+ * uint8_t*             pu8_nonce       W   ナンス（12バイト）
+ * ts_msg_edit_iv_t*    ps_edit_iv      R   初期ベクトル（シーケンス番号とIV）
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * 12バイトのIVの先頭4バイトにシーケンス番号をXORする。
+ ******************************************************************************/
+static void v_msg_edit_nonce(uint8_t* pu8_nonce, ts_msg_edit_iv_t* ps_edit_iv) {
+    tu_type_converter_t u_conv;
+    u_conv.u32_values[0] = ps_edit_iv->u32_seq_no;
+    memcpy(pu8_nonce, ps_edit_iv->u8_iv, CRYPTO_CHACHAPOLY_NONCE_SIZE);
+    pu8_nonce[0] ^= u_conv.u8_values[0];
+    pu8_nonce[1] ^= u_conv.u8_values[1];
+    pu8_nonce[2] ^= u_conv.u8_values[2];
+    pu8_nonce[3] ^= u_conv.u8_values[3];
+}
+
+/*******************************************************************************
+ *
+ * NAME: sts_msg_decryption
+ *
+ * DESCRIPTION:メッセージの復号
+ *
+ * PARAMETERS:                      Name            RW  Usage
+ * ts_com_msg_t*                    ps_rx_msg       RW  メッセージ
+ * uint8_t*                         pu8_key         R   共通鍵
+ * te_com_ble_msg_cipher_suite_t    e_cipher_suite  R   暗号スイート
+ *
+ * RETURNS:
+ *   esp_err_t:結果ステータス
+ *
+ * NOTES:
+ * 本文（認証タグ、IV、暗号文）をインプレースで復号し、本文を平文に置き換える。
+ * パディングは除去しない。鍵スケジュールはセッション暗号コンテキストのものを再利用する。
+ ******************************************************************************/
+static esp_err_t sts_msg_decryption(ts_com_msg_t* ps_rx_msg, uint8_t* pu8_key, te_com_ble_msg_cipher_suite_t e_cipher_suite) {
+    //==========================================================================
+    // 入力チェック
+    //==========================================================================
+    // サイズチェック
+    const size_t t_min_size = (MSG_SIZE_HEADER + MSG_SIZE_CIPHER_HEADER + MSG_SIZE_FOOTER);
+    if (ps_rx_msg->u16_length <= t_min_size) {
+        return ESP_ERR_INVALID_SIZE;
+    }
+
+    //==========================================================================
+    // 復号処理(AES GCMモード)
+    //==========================================================================
+    DBG_TRACE_BEGIN(DBG_TRACE_EVT_MSG_DECRYPT, ps_rx_msg->u32_seq_no);
+    // 本文
+    ts_u8_array_t* ps_data = ps_rx_msg->ps_data;
+    uint8_t* pu8_data = ps_data->pu8_values;
+    // 初期ベクトル
+    ts_msg_edit_iv_t s_edit_iv;
+    s_edit_iv.u32_seq_no = ps_rx_msg->u32_seq_no;
+    memcpy(s_edit_iv.u8_iv, &pu8_data[MSG_SIZE_CIPHER_TAG], MSG_SIZE_CIPHER_IV);
+    // 暗号文を直接復号し、認証タグを検証
+    uint8_t* pu8_cipher = &pu8_data[MSG_SIZE_CIPHER_HEADER];
+    size_t t_data_len = ps_data->t_size - MSG_SIZE_CIPHER_HEADER;
+    esp_err_t sts_val = ESP_FAIL;
+    if (e_cipher_suite == COM_BLE_MSG_CIPHER_CHACHA20_POLY1305) {
+        uint8_t u8_nonce[CRYPTO_CHACHAPOLY_NONCE_SIZE];
+        v_msg_edit_nonce(u8_nonce, &s_edit_iv);
+        sts_val = sts_crypto_chacha20_poly1305_dec_in_place(pu8_key, u8_nonce,
+                                                            MSG_CIPHER_AAD, MSG_SIZE_CIPHER_TAG,
+                                                            pu8_cipher, t_data_len,
+                                                            pu8_data);
+    } else {
+        ts_crypto_gcm_context_t* ps_gcm_ctx = ps_session_gcm_context(pu8_key);
+        if (ps_gcm_ctx != NULL) {
+            sts_val = sts_crypto_gcm_dec_in_place(ps_gcm_ctx,
+                                                  (uint8_t*)&s_edit_iv, IV_BYTES,
+                                                  MSG_CIPHER_AAD, MSG_SIZE_CIPHER_TAG,
+                                                  pu8_cipher, t_data_len,
+                                                  pu8_data, MSG_SIZE_CIPHER_TAG);
+        }
+    }
 #ifdef COM_BLE_MSG_DEBUG
-            do {
-                char sts_txt[(COM_MSG_SIZE_TICKET_STS * 2) + 1];
-                v_vutil_u8_to_hex_string(ps_sts_chk->u8_rx_rand, COM_MSG_SIZE_TICKET_STS, sts_txt);
-                ESP_LOGW(LOG_TAG, "%s L#%d rx_rand=%s", __func__, __LINE__, sts_txt);
-            } while(false);
+    do {
+        char c_key_str[(COM_MSG_SIZE_CIPHER_KEY * 2) + 1];
+        v_vutil_u8_to_hex_string(pu8_key, COM_MSG_SIZE_CIPHER_KEY, c_key_str);
+        ESP_LOGW(LOG_TAG, "%s L#%d key=%s", __func__, __LINE__, c_key_str);
+        char c_plane_str[(t_data_len * 2) + 1];
+        v_vutil_u8_to_hex_string(pu8_cipher, t_data_len, c_plane_str);
+        ESP_LOGW(LOG_TAG, "%s L#%d plane=%s sts=%d", __func__, __LINE__, c_plane_str, sts_val);
+    } while(false);
 #endif
-            // 応答メッセージを生成
-            ps_tx_msg = ps_create_msg_data(COM_BLE_MSG_TYP_STATUS_RSP1, NULL);
-            if (ps_tx_msg == NULL) {
-                // 受信ステータス
-                e_rcv_sts = COM_BLE_MSG_RCV_HANDLING_ERR;
-                // ユーザーイベント
-                e_cb_evt = COM_BLE_MSG_EVT_HANDLING_ERR;
-                break;
-            }
-            // ステータス応答１を返信する
-            sts_val = s_msg_ctrl_cfg.pf_tx_msg(ps_tx_msg);
-            // 送信済みデータを解放
-            sts_mdl_delete_u8_array(ps_tx_msg);
-            if (sts_val != ESP_OK) {
-                // 受信ステータス
-                e_rcv_sts = COM_BLE_MSG_RCV_HANDLING_ERR;
-                // ユーザーイベント
-                e_cb_evt = COM_BLE_MSG_EVT_HANDLING_ERR;
-                break;
-            }
-            // イベントエンキュー
-            v_msg_evt_enqueue(COM_BLE_MSG_EVT_STATUS_CHK);
-            break;
-        case COM_BLE_MSG_TYP_STATUS_RSP1:
-            //------------------------------------------------------------------
-            // ステータス応答１
-            //------------------------------------------------------------------
-            // 受信したチェック乱数を保存
-            memcpy(ps_sts_chk->u8_rx_rand, &ps_rx_data->pu8_values[MSG_SIZE_CHECK_CODE], MSG_SIZE_CHECK_RANDOM);
-#ifdef COM_BLE_MSG_DEBUG
-            do {
-                char sts_txt[(COM_MSG_SIZE_TICKET_STS * 2) + 1];
-                v_vutil_u8_to_hex_string(ps_sts_chk->u8_rx_rand, COM_MSG_SIZE_TICKET_STS, sts_txt);
-                ESP_LOGW(LOG_TAG, "%s L#%d rx_rand=%s", __func__, __LINE__, sts_txt);
-            } while(false);
+    // 本文を平文に置き換え
+    if (sts_val == ESP_OK) {
+        v_msg_rx_data_skip(ps_data, MSG_SIZE_CIPHER_HEADER);
+    }
+    DBG_TRACE_END_EVT(DBG_TRACE_EVT_MSG_DECRYPT, ps_rx_msg->u32_seq_no, (sts_val == ESP_OK));
+
+    // 結果を返信
+    return sts_val;
+}
+
+/*******************************************************************************
+ *
+ * NAME: e_edit_rx_header
+ *
+ * DESCRIPTION:BLE edit Rx message header
+ *
+ * PARAMETERS:                  Name        RW  Usage
+ * ts_com_msg_t*                ps_rx_msg   W   編集対象のメッセージ
+ * ts_com_ble_gatt_rx_data_t*   ps_rx_data  R   受信データ
+ *
+ * RETURNS:
+ *   te_com_ble_msg_rcv_sts_t 受信ステータス
+ *
+ * NOTES:
+ *   単項目チェック（定義ごとのチェックも含む）も実施
+ * None.
+ ******************************************************************************/
+static te_com_ble_msg_rcv_sts_t e_edit_rx_header(ts_com_msg_t* ps_rx_msg, ts_com_ble_gatt_rx_data_t* ps_rx_data) {
+    //==========================================================================
+    // 受信データサイズチェック
+    //==========================================================================
+    // 受信データ
+    ts_u8_array_t* ps_array = ps_rx_data->ps_array;
+    if (ps_array == NULL) {
+        // 受信データサイズエラー
+        return COM_BLE_MSG_RCV_LENGTH_ERR;
+    }
+    if (ps_array->t_size < MSG_SIZE_HEADER) {
+        // 受信データサイズエラー
+        return COM_BLE_MSG_RCV_LENGTH_ERR;
+    }
+
+    //==========================================================================
+    // 項目編集
+    //==========================================================================
+    // BLEアドレス
+    v_com_ble_addr_cpy(ps_rx_msg->t_rcv_bda, ps_rx_data->t_bda);
+    // 受信ティック（ミリ秒）
+    ps_rx_msg->u32_rcv_tick_ms = xTaskGetTickCountMSec();
+    // 送信デバイスID
+    tu_type_converter_t u_conv;
+    u_conv.u8_values[0] = ps_array->pu8_values[MSG_POS_DEVICE_ID];
+    u_conv.u8_values[1] = ps_array->pu8_values[MSG_POS_DEVICE_ID + 1];
+    u_conv.u8_values[2] = ps_array->pu8_values[MSG_POS_DEVICE_ID + 2];
+    u_conv.u8_values[3] = ps_array->pu8_values[MSG_POS_DEVICE_ID + 3];
+    u_conv.u8_values[4] = ps_array->pu8_values[MSG_POS_DEVICE_ID + 4];
+    u_conv.u8_values[5] = ps_array->pu8_values[MSG_POS_DEVICE_ID + 5];
+    u_conv.u8_values[6] = ps_array->pu8_values[MSG_POS_DEVICE_ID + 6];
+    u_conv.u8_values[7] = ps_array->pu8_values[MSG_POS_DEVICE_ID + 7];
+    ps_rx_msg->u64_device_id = u_conv.u64_value;
+    // タイプ編集
+    ps_rx_msg->e_type = ps_array->pu8_values[MSG_POS_TYPE];
+    // コンテンツ種別（暗号文の本文から分離するまではアプリケーションデータ）
+    ps_rx_msg->e_content = COM_BLE_MSG_CONTENT_APP;
+    // メッセージ長
+    u_conv.u8_values[0] = ps_array->pu8_values[MSG_POS_MSG_LEN];
+    u_conv.u8_values[1] = ps_array->pu8_values[MSG_POS_MSG_LEN + 1];
+    ps_rx_msg->u16_length = u_conv.u16_values[0];
+    // シーケンス番号
+    u_conv.u8_values[0] = ps_array->pu8_values[MSG_POS_SEQ_NO];
+    u_conv.u8_values[1] = ps_array->pu8_values[MSG_POS_SEQ_NO + 1];
+    u_conv.u8_values[2] = ps_array->pu8_values[MSG_POS_SEQ_NO + 2];
+    u_conv.u8_values[3] = ps_array->pu8_values[MSG_POS_SEQ_NO + 3];
+    ps_rx_msg->u32_seq_no = u_conv.u32_values[0];
+    // 認証タグサイズ
+    memcpy(ps_rx_msg->u8_auth_tag, &ps_array->pu8_values[MSG_POS_AUTH_TAG], COM_MSG_SIZE_AUTH_TAG);
+
+    //==========================================================================
+    // タイプチェック
+    //==========================================================================
+    if (ps_rx_msg->e_type >= COM_BLE_MSG_TYP_CNT) {
+        // 受信タイプエラー
+        return COM_BLE_MSG_RCV_TYPE_ERR;
+    }
+
+    //==========================================================================
+    // メッセージ長チェック
+    //==========================================================================
+    // メッセージ定義の取得
+    const ts_msg_definition_t* ps_rx_def = &MSG_DEF[ps_rx_msg->e_type];
+    // 最大データ長チェック
+    if (ps_rx_msg->u16_length > s_msg_ctrl_cfg.u32_max_length) {
+        // 受信データサイズエラー
+        return COM_BLE_MSG_RCV_LENGTH_ERR;
+    }
+    // 既定データ長チェック
+    if (ps_rx_def->b_fixed_length) {
+        // 固定長メッセージの場合
+        // ※ペアリング要求と応答は認証モード拡張（＋送信ウィンドウ拡張）付きの長さも許容
+        bool b_auth_ext = (ps_rx_msg->e_type == COM_BLE_MSG_TYP_PAIRING_REQ ||
+                           ps_rx_msg->e_type == COM_BLE_MSG_TYP_PAIRING_RSP) &&
+                          (ps_rx_msg->u16_length == ps_rx_def->u16_length + MSG_SIZE_AUTH_MODE ||
+                           ps_rx_msg->u16_length == ps_rx_def->u16_length + MSG_SIZE_AUTH_MODE + MSG_SIZE_TX_WINDOW);
+        // ※受信通知は累積確認応答付きの長さも許容
+        bool b_cum_ack = (ps_rx_msg->e_type == COM_BLE_MSG_TYP_RESPONSE) &&
+                         (ps_rx_msg->u16_length == ps_rx_def->u16_length + MSG_SIZE_CUM_ACK);
+        if (ps_rx_msg->u16_length != ps_rx_def->u16_length && !b_auth_ext && !b_cum_ack) {
+            // 受信データサイズエラー
+            return COM_BLE_MSG_RCV_LENGTH_ERR;
+        }
+    } else {
+        // 可変長メッセージの場合
+        if (ps_rx_msg->u16_length < ps_rx_def->u16_length) {
+            // 可変長メッセージで、最小メッセージ長より短い場合
+            // 受信データサイズエラー
+            return COM_BLE_MSG_RCV_LENGTH_ERR;
+        }
+    }
+    // 受信データサイズが既にメッセージ長を超えている場合はエラー
+    if (ps_rx_msg->u16_length < ps_array->t_size) {
+        // 受信データサイズエラー
+        return COM_BLE_MSG_RCV_LENGTH_ERR;
+    }
+
+    //==========================================================================
+    // シーケンス番号チェック
+    //==========================================================================
+    // シーケンス番号チェック
+    // 受信通知以外の場合
+    if (ps_rx_def->b_fixed_seq && ps_rx_msg->u32_seq_no != ps_rx_def->u32_seq_no) {
+        // SEQ番号が既定値では無い
+        return COM_BLE_MSG_RCV_SEQ_ERR;
+    }
+
+    //==========================================================================
+    // 結果返信
+    //==========================================================================
+    // 正常終了
+    return COM_BLE_MSG_RCV_NORMAL;
+}
+
+/*******************************************************************************
+ *
+ * NAME: sts_edit_auth_tag
+ *
+ * DESCRIPTION:認証タグの編集処理
+ *
+ * PARAMETERS:      Name                RW  Usage
+ * uint8_t*         pu8_tag             W   認証タグの編集先
+ * ts_u8_array_t*   ps_msg              R   メッセージ
+ * uint64_t         u64_rmt_device_id   R   相手デバイスID
+ *
+ * RETURNS:
+ *   esp_err_t 結果ステータス
+ *
+ * NOTES:
+ * ペアリング必須のメッセージで、相手デバイスのチケットがHMACモードの場合は
+ * HMAC-SHA256、それ以外はハッシュストレッチングで認証タグを算出する。
+ ******************************************************************************/
+static esp_err_t sts_edit_auth_tag(uint8_t* pu8_tag, ts_u8_array_t* ps_msg, uint64_t u64_rmt_device_id) {
+    PROF_BEGIN(DBG_PROF_SITE_MSG_AUTH);
+    // メッセージヘッダー
+    uint8_t* pu8_value = ps_msg->pu8_values;
+#ifdef DBG_TRACE_ENABLED
+    // トレース用のシーケンス番号
+    tu_type_converter_t u_conv;
+    memcpy(u_conv.u8_values, &pu8_value[MSG_POS_SEQ_NO], sizeof(uint32_t));
+    DBG_TRACE_BEGIN(DBG_TRACE_EVT_MSG_AUTH, u_conv.u32_values[0]);
 #endif
-            // 応答メッセージを生成
-            ps_tx_msg = ps_create_msg_data(COM_BLE_MSG_TYP_STATUS_RSP2, NULL);
-            if (ps_tx_msg == NULL) {
-                // 受信ステータス
-                e_rcv_sts = COM_BLE_MSG_RCV_HANDLING_ERR;
-                // ユーザーイベント
-                e_cb_evt = COM_BLE_MSG_EVT_HANDLING_ERR;
-                break;
+    // 認証タグの退避
+    uint8_t u8_origin_tag[COM_MSG_SIZE_AUTH_TAG];
+    memcpy(u8_origin_tag, &pu8_value[MSG_POS_AUTH_TAG], COM_MSG_SIZE_AUTH_TAG);
+    // 認証タグの初期化
+    memset(&pu8_value[MSG_POS_AUTH_TAG], COM_MSG_AUTH_CHECK_VALUE, COM_MSG_SIZE_AUTH_TAG);
+    // HMACモード判定
+    bool b_hmac = false;
+    // 結果ステータス
+    esp_err_t sts_val = ESP_ERR_TIMEOUT;
+    // チケットと認証コンテキストの参照はクリティカルセクション内で実施
+    if (xSemaphoreTakeRecursive(s_mutex_sts, portMAX_DELAY) == pdTRUE) {
+        // 認証モードの判定
+        ts_crypto_hmac_context_t* ps_hmac_ctx = NULL;
+        sts_val = sts_auth_hmac_context(pu8_value[MSG_POS_TYPE], u64_rmt_device_id, &ps_hmac_ctx);
+        if (sts_val == ESP_OK && ps_hmac_ctx != NULL) {
+            // HMAC-SHA256（ipad/opad適用済みの状態から１パスで算出）
+            b_hmac = true;
+            sts_val = sts_crypto_hmac_update(ps_hmac_ctx, pu8_value, ps_msg->t_size);
+            if (sts_val == ESP_OK) {
+                sts_val = sts_crypto_hmac_finish(ps_hmac_ctx, pu8_tag);
+            } else {
+                sts_crypto_hmac_reset(ps_hmac_ctx);
             }
-            // ステータス応答２を返信する
-            sts_val = s_msg_ctrl_cfg.pf_tx_msg(ps_tx_msg);
-            // 送信済みデータを解放
-            sts_mdl_delete_u8_array(ps_tx_msg);
-            if (sts_val != ESP_OK) {
-                // 受信ステータス
-                e_rcv_sts = COM_BLE_MSG_RCV_HANDLING_ERR;
-                // ユーザーイベント
-                e_cb_evt = COM_BLE_MSG_EVT_HANDLING_ERR;
-                break;
+        }
+        xSemaphoreGiveRecursive(s_mutex_sts);
+    }
+    // ハッシュストレッチング（互換モード）
+    if (sts_val == ESP_OK && !b_hmac) {
+        sts_val = sts_crypto_sha256(ps_msg, COM_MSG_AUTH_STRETCHING, pu8_tag);
+    }
+    // 認証タグを元に戻す
+    memcpy(&pu8_value[MSG_POS_AUTH_TAG], u8_origin_tag, COM_MSG_SIZE_AUTH_TAG);
+    DBG_TRACE_END_EVT(DBG_TRACE_EVT_MSG_AUTH, u_conv.u32_values[0], ps_msg->t_size);
+    PROF_END(DBG_PROF_SITE_MSG_AUTH);
+    // 結果返信
+    return sts_val;
+}
+
+/*******************************************************************************
+ *
+ * NAME: sts_rx_auth_begin
+ *
+ * DESCRIPTION:受信メッセージの逐次認証の開始
+ *
+ * PARAMETERS:          Name                RW  Usage
+ * ts_msg_rx_auth_t*    ps_auth             W   逐次認証コンテキスト
+ * uint8_t              u8_type             R   メッセージタイプ
+ * uint64_t             u64_rmt_device_id   R   相手デバイスID
+ *
+ * RETURNS:
+ *   esp_err_t 結果ステータス
+ *
+ * NOTES:
+ * HMACモードの場合はセッションのHMACコンテキストを複製し、受信中はs_mutex_stsを保持しない。
+ * 算出する認証タグはsts_edit_auth_tagと同一。
+ ******************************************************************************/
+static esp_err_t sts_rx_auth_begin(ts_msg_rx_auth_t* ps_auth, uint8_t u8_type, uint64_t u64_rmt_device_id) {
+    // 結果ステータス
+    esp_err_t sts_val = ESP_ERR_TIMEOUT;
+    ps_auth->b_hmac = false;
+    ps_auth->u32_pos = 0;
+    // チケットと認証コンテキストの参照はクリティカルセクション内で実施
+    if (xSemaphoreTakeRecursive(s_mutex_sts, portMAX_DELAY) == pdTRUE) {
+        // 認証モードの判定
+        ts_crypto_hmac_context_t* ps_hmac_ctx = NULL;
+        sts_val = sts_auth_hmac_context(u8_type, u64_rmt_device_id, &ps_hmac_ctx);
+        if (sts_val == ESP_OK && ps_hmac_ctx != NULL) {
+            // HMAC-SHA256（ipad/opad適用済みの状態を複製）
+            sts_val = sts_crypto_hmac_clone(&ps_auth->s_hmac_ctx, ps_hmac_ctx);
+            ps_auth->b_hmac = true;
+        }
+        xSemaphoreGiveRecursive(s_mutex_sts);
+    }
+    if (sts_val != ESP_OK) {
+        return sts_val;
+    }
+    // ハッシュストレッチング（互換モード）
+    if (!ps_auth->b_hmac) {
+        sts_val = sts_crypto_hash_init(&ps_auth->s_hash_ctx, CRYPTO_HASH_SHA256);
+        if (sts_val != ESP_OK) {
+            return sts_val;
+        }
+    }
+    ps_auth->b_ready = true;
+    // 結果返信
+    return ESP_OK;
+}
+
+/*******************************************************************************
+ *
+ * NAME: sts_rx_auth_update
+ *
+ * DESCRIPTION:受信メッセージの逐次認証（受信データの追加）
+ *
+ * PARAMETERS:          Name        RW  Usage
+ * ts_msg_rx_auth_t*    ps_auth     RW  逐次認証コンテキスト
+ * const uint8_t*       pu8_data    R   受信データ（メッセージ上で連続する断片）
+ * size_t               t_len       R   受信データサイズ
+ *
+ * RETURNS:
+ *   esp_err_t 結果ステータス
+ *
+ * NOTES:
+ * 認証タグの領域は初期値（COM_MSG_AUTH_CHECK_VALUE）に置き換えて計算する
+ ******************************************************************************/
+static esp_err_t sts_rx_auth_update(ts_msg_rx_auth_t* ps_auth, const uint8_t* pu8_data, size_t t_len) {
+    // 入力チェック
+    if (!ps_auth->b_ready) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    // 認証タグの初期値
+    uint8_t u8_init_tag[COM_MSG_SIZE_AUTH_TAG];
+    memset(u8_init_tag, COM_MSG_AUTH_CHECK_VALUE, COM_MSG_SIZE_AUTH_TAG);
+    // 結果ステータス
+    esp_err_t sts_val = ESP_OK;
+    while (t_len > 0 && sts_val == ESP_OK) {
+        //----------------------------------------------------------------------
+        // 認証タグの前後で分割
+        //----------------------------------------------------------------------
+        uint32_t u32_pos = ps_auth->u32_pos;
+        const uint8_t* pu8_src = pu8_data;
+        size_t t_size = t_len;
+        if (u32_pos < MSG_POS_AUTH_TAG) {
+            // 認証タグの手前まで
+            if (t_size > MSG_POS_AUTH_TAG - u32_pos) {
+                t_size = MSG_POS_AUTH_TAG - u32_pos;
             }
-            // チェックコードの検証
-            if (sts_status_check(ps_rx_msg->u64_device_id, ps_rx_data->pu8_values, ps_ticket) == ESP_OK) {
-                // イベントエンキュー
-                v_msg_evt_enqueue(COM_BLE_MSG_EVT_STATUS_OK);
-            } else {
-                // 受信ステータス
-                e_rcv_sts = COM_BLE_MSG_RCV_STS_CHK_ERR;
-                // ユーザーイベント
-                e_cb_evt = COM_BLE_MSG_EVT_STATUS_ERR;
+        } else if (u32_pos < MSG_POS_AUTH_TAG + COM_MSG_SIZE_AUTH_TAG) {
+            // 認証タグは初期値に置き換え
+            if (t_size > MSG_POS_AUTH_TAG + COM_MSG_SIZE_AUTH_TAG - u32_pos) {
+                t_size = MSG_POS_AUTH_TAG + COM_MSG_SIZE_AUTH_TAG - u32_pos;
             }
-            // トランザクション終了
-            v_msg_ctrl_sts_transaction_reset();
-            break;
-        case COM_BLE_MSG_TYP_STATUS_RSP2:
-            //------------------------------------------------------------------
-            // ステータス応答２
-            //------------------------------------------------------------------
-            // チェックコードの検証
-            if (sts_status_check(ps_rx_msg->u64_device_id, ps_rx_data->pu8_values, ps_ticket) == ESP_OK) {
-                // イベントエンキュー
-                v_msg_evt_enqueue(COM_BLE_MSG_EVT_STATUS_OK);
-            } else {
-                // 受信ステータス
-                e_rcv_sts = COM_BLE_MSG_RCV_STS_CHK_ERR;
-                // ユーザーイベント
-                e_cb_evt = COM_BLE_MSG_EVT_STATUS_ERR;
+            pu8_src = u8_init_tag;
+        }
+
+        //----------------------------------------------------------------------
+        // ハッシュ値の逐次計算
+        //----------------------------------------------------------------------
+        if (ps_auth->b_hmac) {
+            sts_val = sts_crypto_hmac_update(&ps_auth->s_hmac_ctx, pu8_src, t_size);
+        } else {
+            sts_val = sts_crypto_hash_update(&ps_auth->s_hash_ctx, pu8_src, t_size);
+        }
+        pu8_data += t_size;
+        t_len    -= t_size;
+        ps_auth->u32_pos += t_size;
+    }
+    // 結果返信
+    return sts_val;
+}
+
+/*******************************************************************************
+ *
+ * NAME: sts_rx_auth_finish
+ *
+ * DESCRIPTION:受信メッセージの逐次認証の終了（認証タグの書き出し）
+ *
+ * PARAMETERS:          Name        RW  Usage
+ * ts_msg_rx_auth_t*    ps_auth     RW  逐次認証コンテキスト
+ * uint8_t*             pu8_tag     W   認証タグの編集先
+ *
+ * RETURNS:
+ *   esp_err_t 結果ステータス
+ *
+ * NOTES:
+ * 互換モードの場合は書き出したハッシュ値にストレッチングを適用する
+ ******************************************************************************/
+static esp_err_t sts_rx_auth_finish(ts_msg_rx_auth_t* ps_auth, uint8_t* pu8_tag) {
+    // 入力チェック
+    if (!ps_auth->b_ready) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    PROF_BEGIN(DBG_PROF_SITE_MSG_AUTH);
+    // 結果ステータス
+    esp_err_t sts_val;
+    if (ps_auth->b_hmac) {
+        // HMAC-SHA256
+        sts_val = sts_crypto_hmac_finish(&ps_auth->s_hmac_ctx, pu8_tag);
+    } else {
+        // ハッシュストレッチング（互換モード）
+        sts_val = sts_crypto_hash_finish(&ps_auth->s_hash_ctx, pu8_tag);
+        uint32_t u32_cnt;
+        for (u32_cnt = 0; u32_cnt < COM_MSG_AUTH_STRETCHING && sts_val == ESP_OK; u32_cnt++) {
+            sts_val = sts_crypto_hash_update(&ps_auth->s_hash_ctx, pu8_tag, COM_MSG_SIZE_AUTH_TAG);
+            if (sts_val == ESP_OK) {
+                sts_val = sts_crypto_hash_finish(&ps_auth->s_hash_ctx, pu8_tag);
             }
-            // トランザクション終了
-            v_msg_ctrl_sts_transaction_reset();
-            break;
-        case COM_BLE_MSG_TYP_DATA:
-            //------------------------------------------------------------------
-            // データ
-            //------------------------------------------------------------------
-            // イベントエンキュー
-            v_msg_evt_enqueue(COM_BLE_MSG_EVT_RX_DATA);
-            break;
-        case COM_BLE_MSG_TYP_CIPHERTEXT:
-            //------------------------------------------------------------------
-            // 暗号データ
-            //------------------------------------------------------------------
-            // イベントエンキュー
-            v_msg_evt_enqueue(COM_BLE_MSG_EVT_RX_CIPHERTEXT);
+        }
+    }
+    v_rx_auth_free(ps_auth);
+    PROF_END(DBG_PROF_SITE_MSG_AUTH);
+    // 結果返信
+    return sts_val;
+}
+
+/*******************************************************************************
+ *
+ * NAME: v_rx_auth_free
+ *
+ * DESCRIPTION:受信メッセージの逐次認証コンテキストの解放
+ *
+ * PARAMETERS:          Name        RW  Usage
+ * ts_msg_rx_auth_t*    ps_auth     RW  逐次認証コンテキスト
+ *
+ * RETURNS:
+ *
+ ******************************************************************************/
+static void v_rx_auth_free(ts_msg_rx_auth_t* ps_auth) {
+    if (!ps_auth->b_ready) {
+        return;
+    }
+    if (ps_auth->b_hmac) {
+        v_crypto_hmac_free(&ps_auth->s_hmac_ctx);
+    } else {
+        v_crypto_hash_free(&ps_auth->s_hash_ctx);
+    }
+    ps_auth->b_ready = false;
+}
+
+/*******************************************************************************
+ *
+ * NAME: sts_auth_hmac_context
+ *
+ * DESCRIPTION:メッセージ認証用のHMACコンテキスト取得
+ *
+ * PARAMETERS:                  Name                RW  Usage
+ * uint8_t                      u8_type             R   メッセージタイプ
+ * uint64_t                     u64_rmt_device_id   R   相手デバイスID
+ * ts_crypto_hmac_context_t**   pps_ctx             W   HMACコンテキスト（互換モードの場合はNULL）
+ *
+ * RETURNS:
+ *   esp_err_t:結果ステータス
+ *
+ * NOTES:
+ * 認証鍵はチケットの暗号鍵から導出し、暗号鍵が変わるまでコンテキストを再利用する。
+ * s_mutex_stsを取得した状態で呼び出す事。
+ ******************************************************************************/
+static esp_err_t sts_auth_hmac_context(uint8_t u8_type, uint64_t u64_rmt_device_id, ts_crypto_hmac_context_t** pps_ctx) {
+    //==========================================================================
+    // 認証モードの判定
+    //==========================================================================
+    *pps_ctx = NULL;
+    // ペアリング必須のメッセージのみ対象
+    if (u8_type >= COM_BLE_MSG_TYP_CNT || !MSG_DEF[u8_type].b_pairing) {
+        return ESP_OK;
+    }
+    // チケットの認証モード判定
+    ts_com_msg_auth_ticket_t* ps_ticket = ps_read_ticket(u64_rmt_device_id, &s_msg_ctrl_sts.s_rmt_ticket);
+    if (ps_ticket == NULL || ps_ticket->e_auth_mode != COM_BLE_MSG_AUTH_HMAC) {
+        return ESP_OK;
+    }
+    // 生成済みのコンテキスト判定
+    ts_msg_session_ctx_t* ps_session = &s_msg_ctrl_sts.s_session;
+    ts_crypto_hmac_context_t* ps_hmac_ctx = &ps_session->s_hmac_ctx;
+    if (ps_session->b_auth_ready) {
+        if (memcmp(ps_session->u8_auth_src_key, ps_ticket->u8_enc_key, COM_MSG_SIZE_CIPHER_KEY) == 0) {
+            *pps_ctx = ps_hmac_ctx;
+            return ESP_OK;
+        }
+        // 暗号鍵が変わった場合は再生成
+        v_crypto_hmac_free(ps_hmac_ctx);
+        ps_session->b_auth_ready = false;
+    }
+
+    //==========================================================================
+    // 認証鍵の導出（暗号鍵とは別の鍵を利用）
+    //==========================================================================
+    uint8_t u8_auth_key[COM_MSG_SIZE_AUTH_TAG];
+    esp_err_t sts_val = sts_crypto_hmac_init(ps_hmac_ctx, CRYPTO_HASH_SHA256, ps_ticket->u8_enc_key, COM_MSG_SIZE_CIPHER_KEY);
+    if (sts_val != ESP_OK) {
+        return sts_val;
+    }
+    sts_val = sts_crypto_hmac_update(ps_hmac_ctx, (const uint8_t*)MSG_AUTH_KEY_LABEL, strlen(MSG_AUTH_KEY_LABEL));
+    if (sts_val == ESP_OK) {
+        sts_val = sts_crypto_hmac_finish(ps_hmac_ctx, u8_auth_key);
+    }
+    v_crypto_hmac_free(ps_hmac_ctx);
+    if (sts_val != ESP_OK) {
+        memset(u8_auth_key, 0x00, COM_MSG_SIZE_AUTH_TAG);
+        return sts_val;
+    }
+
+    //==========================================================================
+    // 認証鍵によるコンテキストの生成
+    //==========================================================================
+    sts_val = sts_crypto_hmac_init(ps_hmac_ctx, CRYPTO_HASH_SHA256, u8_auth_key, COM_MSG_SIZE_AUTH_TAG);
+    memset(u8_auth_key, 0x00, COM_MSG_SIZE_AUTH_TAG);
+    if (sts_val != ESP_OK) {
+        return sts_val;
+    }
+    memcpy(ps_session->u8_auth_src_key, ps_ticket->u8_enc_key, COM_MSG_SIZE_CIPHER_KEY);
+    ps_session->b_auth_ready = true;
+    *pps_ctx = ps_hmac_ctx;
+    // 結果返信
+    return ESP_OK;
+}
+
+/*******************************************************************************
+ *
+ * NAME: ps_session_gcm_context
+ *
+ * DESCRIPTION:セッションのGCMコンテキスト取得
+ *
+ * PARAMETERS:          Name            RW  Usage
+ * uint8_t*             pu8_key         R   共通鍵
+ *
+ * RETURNS:
+ *   ts_crypto_gcm_context_t*:GCMコンテキスト、エラー時はNULL
+ *
+ * NOTES:
+ * 共通鍵が変わった場合のみ鍵スケジュールを再展開し、切断までコンテキストを再利用する。
+ * s_mutex_stsを取得した状態で呼び出す事。
+ ******************************************************************************/
+static ts_crypto_gcm_context_t* ps_session_gcm_context(uint8_t* pu8_key) {
+    //==========================================================================
+    // 生成済みのコンテキスト判定
+    //==========================================================================
+    ts_msg_session_ctx_t* ps_session = &s_msg_ctrl_sts.s_session;
+    ts_crypto_gcm_context_t* ps_gcm_ctx = &ps_session->s_gcm_ctx;
+    if (ps_gcm_ctx->b_ready) {
+        if (memcmp(ps_session->u8_gcm_key, pu8_key, COM_MSG_SIZE_CIPHER_KEY) == 0) {
+            return ps_gcm_ctx;
+        }
+        // 共通鍵が変わった場合は再生成
+        v_crypto_gcm_free(ps_gcm_ctx);
+    }
+
+    //==========================================================================
+    // 鍵スケジュールの展開
+    //==========================================================================
+    if (sts_crypto_gcm_init(ps_gcm_ctx, pu8_key, COM_MSG_SIZE_CIPHER_KEY) != ESP_OK) {
+        v_crypto_gcm_free(ps_gcm_ctx);
+        memset(ps_session->u8_gcm_key, 0x00, COM_MSG_SIZE_CIPHER_KEY);
+        return NULL;
+    }
+    memcpy(ps_session->u8_gcm_key, pu8_key, COM_MSG_SIZE_CIPHER_KEY);
+    // 結果返信
+    return ps_gcm_ctx;
+}
+
+/*******************************************************************************
+ *
+ * NAME: v_msg_session_clear
+ *
+ * DESCRIPTION:セッション暗号コンテキストのクリア
+ *
+ * PARAMETERS:          Name            RW  Usage
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * 展開済みの鍵スケジュールと鍵のコピーを破棄する。
+ * s_mutex_stsを取得した状態で呼び出す事。
+ ******************************************************************************/
+static void v_msg_session_clear() {
+    ts_msg_session_ctx_t* ps_session = &s_msg_ctrl_sts.s_session;
+    // HMACコンテキスト
+    if (ps_session->b_auth_ready) {
+        v_crypto_hmac_free(&ps_session->s_hmac_ctx);
+        ps_session->b_auth_ready = false;
+    }
+    memset(ps_session->u8_auth_src_key, 0x00, COM_MSG_SIZE_CIPHER_KEY);
+    // GCMコンテキスト
+    if (ps_session->s_gcm_ctx.b_ready) {
+        v_crypto_gcm_free(&ps_session->s_gcm_ctx);
+    }
+    memset(ps_session->u8_gcm_key, 0x00, COM_MSG_SIZE_CIPHER_KEY);
+}
+
+/*******************************************************************************
+ *
+ * NAME: u8_tx_window_size
+ *
+ * DESCRIPTION:送信ウィンドウサイズの取得
+ *
+ * PARAMETERS:          Name            RW  Usage
+ *
+ * RETURNS:
+ *   uint8_t:送信ウィンドウサイズ（1:ストップアンドウェイト）
+ *
+ * NOTES:
+ * ペアリング時に合意したサイズと自デバイスの設定の小さい方を返す。
+ * s_mutex_stsを取得した状態で呼び出す事。
+ ******************************************************************************/
+static uint8_t u8_tx_window_size() {
+    // チケット読み込み
+    ts_com_msg_auth_ticket_t s_ticket;
+    ts_com_msg_auth_ticket_t* ps_ticket = ps_read_ticket(s_msg_ctrl_sts.u64_rmt_device_id, &s_ticket);
+    if (ps_ticket == NULL) {
+        return 1;
+    }
+    // 合意したサイズと設定の小さい方
+    uint8_t u8_window = ps_ticket->u8_tx_window;
+    if (u8_window > s_msg_ctrl_cfg.u8_tx_window) {
+        u8_window = s_msg_ctrl_cfg.u8_tx_window;
+    }
+    if (u8_window > COM_MSG_TX_WINDOW_MAX) {
+        u8_window = COM_MSG_TX_WINDOW_MAX;
+    }
+    if (u8_window < 1) {
+        u8_window = 1;
+    }
+    // 結果返信
+    return u8_window;
+}
+
+/*******************************************************************************
+ *
+ * NAME: b_msg_content_enabled
+ *
+ * DESCRIPTION:暗号文のコンテンツ種別の合意判定
+ *
+ * PARAMETERS:          Name            RW  Usage
+ *
+ * RETURNS:
+ *   true:接続中のデバイスとコンテンツ種別を合意済み
+ *
+ * NOTES:
+ * s_mutex_stsを取得した状態で呼び出す事。
+ ******************************************************************************/
+static bool b_msg_content_enabled() {
+    ts_com_msg_auth_ticket_t s_ticket;
+    ts_com_msg_auth_ticket_t* ps_ticket = ps_read_ticket(s_msg_ctrl_sts.u64_rmt_device_id, &s_ticket);
+    return (ps_ticket != NULL && ps_ticket->b_content);
+}
+
+/*******************************************************************************
+ *
+ * NAME: sts_tx_window_acquire
+ *
+ * DESCRIPTION:送信ウィンドウの空き待ち
+ *
+ * PARAMETERS:          Name            RW  Usage
+ *
+ * RETURNS:
+ *   esp_err_t:結果ステータス（ESP_ERR_TIMEOUT:空き待ちタイムアウト、
+ *             ESP_ERR_INVALID_STATE:s_mutex_stsを再帰取得した状態での空き待ち）
+ *
+ * NOTES:
+ * s_mutex_stsを1回だけ取得した状態で呼び出す事。
+ * 待機中は確認応答を受信出来る様にs_mutex_stsを解放し、待機後に再取得する。
+ * 呼び出し元がs_mutex_stsを再帰取得している場合は解放しきれず確認応答を受信出来ない為、
+ * 待機せずにESP_ERR_INVALID_STATEを返す。
+ ******************************************************************************/
+static esp_err_t sts_tx_window_acquire() {
+    ts_msg_tx_window_t* ps_window = &s_msg_ctrl_sts.s_tx_window;
+    TaskHandle_t t_own_task = xTaskGetCurrentTaskHandle();
+    TickType_t t_start = xTaskGetTickCount();
+    while (ps_window->u8_count >= u8_tx_window_size()) {
+        // 待機時間の判定
+        TickType_t t_elapsed = xTaskGetTickCount() - t_start;
+        if (t_elapsed >= COM_MSG_TX_WINDOW_TIMEOUT) {
+            return ESP_ERR_TIMEOUT;
+        }
+        // クリティカルセクションを一時的に解放
+        xSemaphoreGiveRecursive(s_mutex_sts);
+        if (xSemaphoreGetMutexHolder(s_mutex_sts) == t_own_task) {
+            // 再帰取得されている（呼び出し元がクリティカルセクション内）
+            xSemaphoreTakeRecursive(s_mutex_sts, portMAX_DELAY);
+            return ESP_ERR_INVALID_STATE;
+        }
+        // 確認応答による空き通知を待機
+        xSemaphoreTake(s_msg_deamon_sts.s_tx_window_sem, COM_MSG_TX_WINDOW_TIMEOUT - t_elapsed);
+        // クリティカルセクションを再取得
+        if (xSemaphoreTakeRecursive(s_mutex_sts, portMAX_DELAY) != pdTRUE) {
+            return ESP_ERR_INVALID_STATE;
+        }
+    }
+    // 結果返信
+    return ESP_OK;
+}
+
+/*******************************************************************************
+ *
+ * NAME: sts_tx_window_push
+ *
+ * DESCRIPTION:送信ウィンドウへの追加
+ *
+ * PARAMETERS:          Name            RW  Usage
+ * ts_u8_array_t*       ps_msg          R   送信済みの暗号文メッセージ
+ *
+ * RETURNS:
+ *   esp_err_t:結果ステータス
+ *
+ * NOTES:
+ * メッセージの所有権は送信ウィンドウに移り、追加出来ない場合は解放する。
+ * s_mutex_stsを取得した状態で呼び出す事。
+ ******************************************************************************/
+static esp_err_t sts_tx_window_push(ts_u8_array_t* ps_msg) {
+    ts_msg_tx_window_t* ps_window = &s_msg_ctrl_sts.s_tx_window;
+    // 空きスロット判定
+    if (ps_window->u8_count >= COM_MSG_TX_WINDOW_MAX) {
+        sts_mdl_delete_u8_array(ps_msg);
+        return ESP_ERR_INVALID_STATE;
+    }
+    // スロットの編集（シーケンス番号は送信済みの最新値）
+    uint8_t u8_idx = (ps_window->u8_head + ps_window->u8_count) % COM_MSG_TX_WINDOW_MAX;
+    ts_msg_tx_slot_t* ps_slot = &ps_window->s_slot[u8_idx];
+    ps_slot->u32_seq_no     = s_msg_ctrl_sts.s_rmt_ticket.u32_tx_seq_no;
+    ps_slot->u32_tx_tick_ms = xTaskGetTickCountMSec();
+    ps_slot->u8_retry       = 0;
+    ps_slot->b_acked        = false;
+    ps_slot->ps_msg         = ps_msg;
+    ps_window->u8_count++;
+    // 再送タイマー開始
+    if (!b_tmw_is_active(&s_msg_deamon_sts.s_retx_timer)) {
+        sts_tmw_start(&s_msg_deamon_sts.s_retx_timer, COM_MSG_TX_RETX_TIMEOUT_MS, 0);
+    }
+    // 結果返信
+    return ESP_OK;
+}
+
+/*******************************************************************************
+ *
+ * NAME: v_tx_window_ack
+ *
+ * DESCRIPTION:送信ウィンドウの確認応答処理
+ *
+ * PARAMETERS:          Name            RW  Usage
+ * ts_com_msg_t*        ps_rx_msg       R   受信した受信通知
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * 応答のシーケンス番号のスロットを個別に確認し（選択的確認応答）、
+ * 累積確認応答が有る場合はその値以下の全スロットを確認済みとする。
+ * 先頭から連続する確認済みスロットを解放してウィンドウを進める。
+ * s_mutex_stsを取得した状態で呼び出す事。
+ ******************************************************************************/
+static void v_tx_window_ack(ts_com_msg_t* ps_rx_msg) {
+    ts_msg_tx_window_t* ps_window = &s_msg_ctrl_sts.s_tx_window;
+    // 暗号文への応答のみが対象
+    ts_u8_array_t* ps_data = ps_rx_msg->ps_data;
+    if (ps_window->u8_count == 0 || ps_data == NULL || ps_data->t_size < 2) {
+        return;
+    }
+    uint8_t* pu8_body = ps_data->pu8_values;
+    if (pu8_body[0] != COM_BLE_MSG_TYP_CIPHERTEXT) {
+        return;
+    }
+    // 受信エラーの応答の場合は送信ウィンドウを破棄
+    if (pu8_body[1] != COM_BLE_MSG_RCV_NORMAL) {
+        v_tx_window_clear();
+        return;
+    }
+    // 累積確認応答
+    bool b_cum_ack = (ps_data->t_size >= 2 + MSG_SIZE_CUM_ACK);
+    uint32_t u32_cum_ack = 0;
+    if (b_cum_ack) {
+        tu_type_converter_t u_conv;
+        u_conv.u8_values[0] = pu8_body[2];
+        u_conv.u8_values[1] = pu8_body[3];
+        u_conv.u8_values[2] = pu8_body[4];
+        u_conv.u8_values[3] = pu8_body[5];
+        u32_cum_ack = u_conv.u32_values[0];
+    }
+    // 確認済みスロットの判定
+    uint8_t u8_idx;
+    ts_msg_tx_slot_t* ps_slot;
+    for (uint8_t u8_cnt = 0; u8_cnt < ps_window->u8_count; u8_cnt++) {
+        u8_idx = (ps_window->u8_head + u8_cnt) % COM_MSG_TX_WINDOW_MAX;
+        ps_slot = &ps_window->s_slot[u8_idx];
+        if (ps_slot->u32_seq_no == ps_rx_msg->u32_seq_no ||
+            (b_cum_ack && ps_slot->u32_seq_no <= u32_cum_ack)) {
+            ps_slot->b_acked = true;
+        }
+    }
+    // 先頭から連続する確認済みスロットの解放
+    while (ps_window->u8_count > 0) {
+        ps_slot = &ps_window->s_slot[ps_window->u8_head];
+        if (!ps_slot->b_acked) {
             break;
-        default:
-            // 受信ステータス
-            e_rcv_sts = COM_BLE_MSG_RCV_HANDLING_ERR;
-            // ユーザーイベント
-            e_cb_evt = COM_BLE_MSG_EVT_HANDLING_ERR;
         }
-    } while(false);
+        sts_mdl_delete_u8_array(ps_slot->ps_msg);
+        ps_slot->ps_msg  = NULL;
+        ps_window->u8_head = (ps_window->u8_head + 1) % COM_MSG_TX_WINDOW_MAX;
+        ps_window->u8_count--;
+    }
+    // 全て確認済みの場合は再送タイマー停止
+    if (ps_window->u8_count == 0) {
+        sts_tmw_stop(&s_msg_deamon_sts.s_retx_timer);
+    }
+    // 空き通知
+    xSemaphoreGive(s_msg_deamon_sts.s_tx_window_sem);
+}
+
+/*******************************************************************************
+ *
+ * NAME: v_tx_window_clear
+ *
+ * DESCRIPTION:送信ウィンドウのクリア
+ *
+ * PARAMETERS:          Name            RW  Usage
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * s_mutex_stsを取得した状態で呼び出す事。
+ ******************************************************************************/
+static void v_tx_window_clear() {
+    ts_msg_tx_window_t* ps_window = &s_msg_ctrl_sts.s_tx_window;
+    // 保持メッセージの解放
+    uint8_t u8_idx;
+    for (uint8_t u8_cnt = 0; u8_cnt < ps_window->u8_count; u8_cnt++) {
+        u8_idx = (ps_window->u8_head + u8_cnt) % COM_MSG_TX_WINDOW_MAX;
+        sts_mdl_delete_u8_array(ps_window->s_slot[u8_idx].ps_msg);
+        ps_window->s_slot[u8_idx].ps_msg = NULL;
+    }
+    ps_window->u8_head  = 0;
+    ps_window->u8_count = 0;
+    // 再送タイマー停止
+    if (b_tmw_is_active(&s_msg_deamon_sts.s_retx_timer)) {
+        sts_tmw_stop(&s_msg_deamon_sts.s_retx_timer);
+    }
+    // 空き待ちの解除
+    if (s_msg_deamon_sts.s_tx_window_sem != NULL) {
+        xSemaphoreGive(s_msg_deamon_sts.s_tx_window_sem);
+    }
+}
 
+/*******************************************************************************
+ *
+ * NAME: v_tx_window_timer_cb
+ *
+ * DESCRIPTION:送信ウィンドウの再送タイマーコールバック
+ *
+ * PARAMETERS:  Name            RW  Usage
+ * void*        pv_arg          R   コールバック引数
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * タイマーサービスタスクから呼び出される。
+ * 応答待ちのスロットをシーケンス番号順に再送し、再送回数の上限を超えた場合は
+ * 送信タイムアウトを通知してコネクションをリセットする。
+ ******************************************************************************/
+static void v_tx_window_timer_cb(void* pv_arg) {
     //==========================================================================
-    // 終了処理
+    // クリティカルセクション開始
     //==========================================================================
-
-    //--------------------------------------------------------------------------
-    // 受信応答処理
-    //--------------------------------------------------------------------------
-    // メッセージ定義の取得
-    const ts_msg_definition_t* ps_rx_def = &MSG_DEF[ps_rx_msg->e_type];
-    // 受信通知判定
-    if (ps_rx_def->b_response) {
-        // 受信応答が必要なメッセージの場合
-        // 受信応答を送信
-        sts_tx_response(ps_rx_msg->e_type, e_rcv_sts, ps_rx_msg->u32_seq_no);
+    if (xSemaphoreTakeRecursive(s_mutex_sts, portMAX_DELAY) != pdTRUE) {
+        return;
     }
 
-    //--------------------------------------------------------------------------
-    // 受信ステータス処理
-    //--------------------------------------------------------------------------
-    if (e_rcv_sts != COM_BLE_MSG_RCV_NORMAL) {
-        // 受信エラーの場合
-        // ユーザーイベント判定
-        if (e_cb_evt != COM_BLE_MSG_EVT_COUNT) {
-            // イベントエンキュー
-            v_msg_evt_enqueue(e_cb_evt);
+    //==========================================================================
+    // 再送処理
+    //==========================================================================
+    ts_msg_tx_window_t* ps_window = &s_msg_ctrl_sts.s_tx_window;
+    uint32_t u32_now_ms  = xTaskGetTickCountMSec();
+    uint32_t u32_next_ms = COM_MSG_TX_RETX_TIMEOUT_MS;
+    bool b_timeout = false;
+    uint8_t u8_idx;
+    ts_msg_tx_slot_t* ps_slot;
+    for (uint8_t u8_cnt = 0; u8_cnt < ps_window->u8_count; u8_cnt++) {
+        u8_idx = (ps_window->u8_head + u8_cnt) % COM_MSG_TX_WINDOW_MAX;
+        ps_slot = &ps_window->s_slot[u8_idx];
+        if (ps_slot->b_acked) {
+            continue;
         }
-        // コネクションリセット
-        if (e_rcv_sts != COM_BLE_MSG_RCV_STS_CHK_ERR) {
-            v_msg_ctrl_sts_connection_reset();
+        // 再送時刻の判定
+        uint32_t u32_elapsed_ms = u32_now_ms - ps_slot->u32_tx_tick_ms;
+        if (u32_elapsed_ms < COM_MSG_TX_RETX_TIMEOUT_MS) {
+            if (COM_MSG_TX_RETX_TIMEOUT_MS - u32_elapsed_ms < u32_next_ms) {
+                u32_next_ms = COM_MSG_TX_RETX_TIMEOUT_MS - u32_elapsed_ms;
+            }
+            continue;
         }
-        // 異常終了
-        return e_rcv_sts;
+        // 再送回数の判定
+        if (ps_slot->u8_retry >= COM_MSG_TX_RETX_MAX_CNT) {
+            b_timeout = true;
+            break;
+        }
+        // 再送（認証タグ等は送信済みのメッセージのまま）
+        s_msg_ctrl_cfg.pf_tx_msg(ps_slot->ps_msg);
+        ps_slot->u32_tx_tick_ms = u32_now_ms;
+        ps_slot->u8_retry++;
     }
 
-    //--------------------------------------------------------------------------
-    // 正常受信処理
-    //--------------------------------------------------------------------------
-    // 受信カウンタの更新
-    s_msg_ctrl_sts.u64_rx_count++;
-    // 受信履歴の更新
-    ts_msg_history_t* ps_bef_rx_msg = NULL;
-    if (ps_rx_msg->e_type != COM_BLE_MSG_TYP_RESPONSE) {
-        // 受信メッセージ
-        ps_bef_rx_msg = &s_msg_ctrl_sts.s_bef_rx_msg;
-    } else {
-        // 受信応答メッセージ
-        ps_bef_rx_msg = &s_msg_ctrl_sts.s_bef_rx_rsp;
+    //==========================================================================
+    // 送信タイムアウト判定
+    //==========================================================================
+    if (b_timeout) {
+        // イベントエンキュー
+        v_msg_evt_enqueue(COM_BLE_MSG_EVT_TX_TIMEOUT);
+        // コネクションリセット（送信ウィンドウもクリア）
+        v_msg_ctrl_sts_connection_reset();
+    } else if (ps_window->u8_count > 0) {
+        // 再送タイマー再開
+        sts_tmw_start(&s_msg_deamon_sts.s_retx_timer, u32_next_ms, 0);
     }
-    v_com_ble_addr_cpy(ps_bef_rx_msg->t_bda, ps_rx_msg->t_rcv_bda);
-    ps_bef_rx_msg->u32_tick_ms    = ps_rx_msg->u32_rcv_tick_ms;
-    ps_bef_rx_msg->u64_device_id  = ps_rx_msg->u64_device_id;
-    ps_bef_rx_msg->u32_seq_no     = ps_rx_msg->u32_seq_no;
-    ps_bef_rx_msg->e_type         = ps_rx_msg->e_type;
 
-    // 結果ステータスを返信
-    return e_rcv_sts;
+    //==========================================================================
+    // クリティカルセクション終了
+    //==========================================================================
+    xSemaphoreGiveRecursive(s_mutex_sts);
 }
 
 /*******************************************************************************
  *
- * NAME: sts_tx_response
+ * NAME: u32_msg_batch_limit
  *
- * DESCRIPTION:BLEの受信応答の送信処理
+ * DESCRIPTION:バッチ送信のコンテナの最大サイズ
  *
- * PARAMETERS:              Name            RW  Usage
- * te_com_ble_msg_type_t    e_rx_type       R   受信メッセージタイプ
- * te_com_ble_msg_rcv_sts_t e_rx_sts        R   受信ステータス
- * uint32_t                 u32_seq_no      R   メッセージSEQ番号
+ * PARAMETERS:          Name            RW  Usage
  *
  * RETURNS:
- *   esp_err_t 結果ステータス
+ *   uint32_t:コンテナの最大サイズ
  *
  * NOTES:
- * None.
+ * 設定値と暗号メッセージの平文の最大サイズの小さい方を返す。
  ******************************************************************************/
-static esp_err_t sts_tx_response(te_com_ble_msg_type_t e_rx_type,
-                                  te_com_ble_msg_rcv_sts_t e_rx_sts,
-                                  uint32_t u32_seq_no) {
+static uint32_t u32_msg_batch_limit() {
+    uint32_t u32_limit = u32_com_msg_max_cipher_size();
+    if (s_msg_ctrl_cfg.u16_batch_max_size > 0 && s_msg_ctrl_cfg.u16_batch_max_size < u32_limit) {
+        u32_limit = s_msg_ctrl_cfg.u16_batch_max_size;
+    }
+    return u32_limit;
+}
+
+/*******************************************************************************
+ *
+ * NAME: ps_msg_batch_detach
+ *
+ * DESCRIPTION:集約中のコンテナの取り出し
+ *
+ * PARAMETERS:          Name            RW  Usage
+ * uint64_t*            pu64_device_id  W   送信先デバイスID（NULL可）
+ *
+ * RETURNS:
+ *   ts_u8_array_t*:集約中のコンテナ（t_sizeは使用サイズ、無い場合はNULL）
+ *
+ * NOTES:
+ * バッチ送信タイマーも停止する。
+ * s_mutex_stsを取得した状態で呼び出す事。
+ ******************************************************************************/
+static ts_u8_array_t* ps_msg_batch_detach(uint64_t* pu64_device_id) {
+    ts_msg_batch_t* ps_batch = &s_msg_ctrl_sts.s_batch;
+    // バッチ送信タイマー停止
+    if (b_tmw_is_active(&s_msg_deamon_sts.s_batch_timer)) {
+        sts_tmw_stop(&s_msg_deamon_sts.s_batch_timer);
+    }
+    // 集約済みのデータが無い場合
+    if (ps_batch->u8_count == 0) {
+        return NULL;
+    }
+    // コンテナの取り出し
+    ts_u8_array_t* ps_container = ps_batch->ps_container;
+    ps_container->t_size = ps_batch->u16_length;
+    if (pu64_device_id != NULL) {
+        *pu64_device_id = ps_batch->u64_device_id;
+    }
+    ps_batch->ps_container = NULL;
+    ps_batch->u8_count     = 0;
+    ps_batch->u16_length   = 0;
+    // 結果返信
+    return ps_container;
+}
+
+/*******************************************************************************
+ *
+ * NAME: sts_msg_batch_send
+ *
+ * DESCRIPTION:コンテナの送信
+ *
+ * PARAMETERS:          Name            RW  Usage
+ * uint64_t             u64_device_id   R   送信先デバイスID
+ * ts_u8_array_t*       ps_container    R   コンテナ
+ *
+ * RETURNS:
+ *   esp_err_t:結果ステータス
+ *
+ * NOTES:
+ * コンテナはコンテンツ種別（バッチ）を付与して送信し、送信後に解放する。
+ * 送信ウィンドウの空き待ちが有るので、s_mutex_stsを取得していない状態で呼び出す事。
+ ******************************************************************************/
+static esp_err_t sts_msg_batch_send(uint64_t u64_device_id, ts_u8_array_t* ps_container) {
+    esp_err_t sts_val = sts_com_msg_tx_cipher_content(u64_device_id, COM_BLE_MSG_CONTENT_BATCH, ps_container);
+    sts_mdl_delete_u8_array(ps_container);
+    return sts_val;
+}
+
+/*******************************************************************************
+ *
+ * NAME: v_msg_batch_timer_cb
+ *
+ * DESCRIPTION:バッチ送信タイマーコールバック
+ *
+ * PARAMETERS:  Name            RW  Usage
+ * void*        pv_arg          R   コールバック引数
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * タイマーサービスタスクから呼び出される。
+ * タイマーサービスを停止させない様に、送信ウィンドウに空きが無い場合は送信を延期する。
+ ******************************************************************************/
+static void v_msg_batch_timer_cb(void* pv_arg) {
     //==========================================================================
-    // 受信通知メッセージ生成
+    // クリティカルセクション開始
     //==========================================================================
-#ifdef COM_BLE_MSG_DEBUG
-    ESP_LOGW(LOG_TAG, "%s L#%d rcv_type=%d rx_sts=%02x seq=%lu", __func__, __LINE__, e_rx_type, e_rx_sts, (unsigned long)u32_seq_no);
-#endif
-    // メッセージ定義の取得
-    const ts_msg_definition_t* ps_def = &MSG_DEF[COM_BLE_MSG_TYP_RESPONSE];
-    // メッセージデータ
-    ts_u8_array_t* ps_msg = ps_mdl_empty_u8_array(ps_def->u16_length);
-    if (ps_msg == NULL) {
-        return ESP_ERR_NO_MEM;
+    if (xSemaphoreTakeRecursive(s_mutex_sts, portMAX_DELAY) != pdTRUE) {
+        return;
     }
 
-    //--------------------------------------------------------------------------
-    // ヘッダー編集
-    //--------------------------------------------------------------------------
-    // 編集：デバイスID
-    uint8_t* pu8_value = ps_msg->pu8_values;
-    tu_type_converter_t u_conv;
-    u_conv.u64_value = s_msg_ctrl_cfg.u64_device_id;
-    pu8_value[MSG_POS_DEVICE_ID]     = u_conv.u8_values[0];
-    pu8_value[MSG_POS_DEVICE_ID + 1] = u_conv.u8_values[1];
-    pu8_value[MSG_POS_DEVICE_ID + 2] = u_conv.u8_values[2];
-    pu8_value[MSG_POS_DEVICE_ID + 3] = u_conv.u8_values[3];
-    pu8_value[MSG_POS_DEVICE_ID + 4] = u_conv.u8_values[4];
-    pu8_value[MSG_POS_DEVICE_ID + 5] = u_conv.u8_values[5];
-    pu8_value[MSG_POS_DEVICE_ID + 6] = u_conv.u8_values[6];
-    pu8_value[MSG_POS_DEVICE_ID + 7] = u_conv.u8_values[7];
-    // 編集：メッセージタイプ
-    pu8_value[MSG_POS_TYPE] = COM_BLE_MSG_TYP_RESPONSE;
-    // 編集：メッセージ長
-    u_conv.u16_values[0] = ps_def->u16_length;
-    pu8_value[MSG_POS_MSG_LEN]     = u_conv.u8_values[0];
-    pu8_value[MSG_POS_MSG_LEN + 1] = u_conv.u8_values[1];
-    // 編集：シーケンス番号
-    u_conv.u32_values[0] = u32_seq_no;
-    pu8_value[MSG_POS_SEQ_NO]     = u_conv.u8_values[0];
-    pu8_value[MSG_POS_SEQ_NO + 1] = u_conv.u8_values[1];
-    pu8_value[MSG_POS_SEQ_NO + 2] = u_conv.u8_values[2];
-    pu8_value[MSG_POS_SEQ_NO + 3] = u_conv.u8_values[3];
-
-    //--------------------------------------------------------------------------
-    // 本文編集
-    //--------------------------------------------------------------------------
-    // 受信メッセージタイプ
-    pu8_value[MSG_POS_BODY] = e_rx_type;
-    // 受信ステータス
-    pu8_value[MSG_POS_BODY + 1] = e_rx_sts;
+    //==========================================================================
+    // 集約中のコンテナを取り出し
+    //==========================================================================
+    uint64_t u64_device_id = 0;
+    ts_u8_array_t* ps_container = NULL;
+    if (s_msg_ctrl_sts.s_tx_window.u8_count < u8_tx_window_size()) {
+        ps_container = ps_msg_batch_detach(&u64_device_id);
+    } else if (s_msg_ctrl_sts.s_batch.u8_count > 0) {
+        // 送信ウィンドウに空きが無いので延期
+        sts_tmw_start(&s_msg_deamon_sts.s_batch_timer, s_msg_ctrl_cfg.u32_batch_delay_ms, 0);
+    }
 
-    //--------------------------------------------------------------------------
-    // フッター編集
-    //--------------------------------------------------------------------------
-    // 乱数
-    b_vutil_set_u8_rand_array(&pu8_value[MSG_POS_BODY + 2], MSG_SIZE_RANDOM);
-    // ストップトークン
-    u_conv.u16_values[0] = u32_seq_no;
-    pu8_value[ps_def->u16_length - 2] = u_conv.u8_values[0];
-    pu8_value[ps_def->u16_length - 1] = u_conv.u8_values[1];
+    //==========================================================================
+    // クリティカルセクション終了
+    //==========================================================================
+    xSemaphoreGiveRecursive(s_mutex_sts);
 
     //==========================================================================
-    // レスポンス送信処理
+    // 送信処理
     //==========================================================================
-    // レスポンスを返信
-    esp_err_t sts_val = s_msg_ctrl_cfg.pf_tx_msg(ps_msg);
-    // レスポンスデータクリア
-    sts_mdl_delete_u8_array(ps_msg);
+    if (ps_container != NULL) {
+        sts_msg_batch_send(u64_device_id, ps_container);
+    }
+}
 
-    // 結果返信
-    return sts_val;
+/*******************************************************************************
+ *
+ * NAME: b_msg_batch_is_container
+ *
+ * DESCRIPTION:バッチ送信のコンテナの整合性判定
+ *
+ * PARAMETERS:          Name            RW  Usage
+ * ts_u8_array_t*       ps_data         R   受信した暗号メッセージの本文（復号済み）
+ *
+ * RETURNS:
+ *   true:全ての要素の長さが整合するコンテナ
+ *
+ * NOTES:
+ * None.
+ ******************************************************************************/
+static bool b_msg_batch_is_container(ts_u8_array_t* ps_data) {
+    // ヘッダー判定
+    if (ps_data == NULL || ps_data->t_size < MSG_SIZE_BATCH_HEADER) {
+        return false;
+    }
+    uint8_t* pu8_container = ps_data->pu8_values;
+    if (pu8_container[0] == 0) {
+        return false;
+    }
+    // 要素の長さの整合性判定
+    tu_type_converter_t u_conv;
+    size_t t_pos = MSG_SIZE_BATCH_HEADER;
+    for (uint8_t u8_idx = 0; u8_idx < pu8_container[0]; u8_idx++) {
+        if (t_pos + MSG_SIZE_BATCH_ELEMENT > ps_data->t_size) {
+            return false;
+        }
+        u_conv.u8_values[0] = pu8_container[t_pos];
+        u_conv.u8_values[1] = pu8_container[t_pos + 1];
+        t_pos += MSG_SIZE_BATCH_ELEMENT + u_conv.u16_values[0];
+    }
+    return (t_pos == ps_data->t_size);
 }
 
 /*******************************************************************************
  *
- * NAME: sts_tx_reset_msg
+ * NAME: ps_msg_compress
  *
- * DESCRIPTION:BLE Tx reset message
+ * DESCRIPTION:本文の圧縮
  *
- * PARAMETERS:      Name            RW  Usage
+ * PARAMETERS:          Name            RW  Usage
+ * ts_u8_array_t*       ps_data         R   本文データ
  *
  * RETURNS:
- * esp_err_t:送信結果
+ *   ts_u8_array_t*:圧縮形式の本文（NULL:メモリ不足）
  *
  * NOTES:
- * None.
+ * 圧縮形式は圧縮タイプ（1byte）に続けて、LZの場合は圧縮前のサイズ（2byte）と圧縮データ、
+ * 無圧縮の場合は元のデータを格納する。
+ * 圧縮後のサイズが元のデータ以上となる場合は途中で打ち切って無圧縮で格納する。
  ******************************************************************************/
-static esp_err_t sts_tx_reset_msg() {
-    //----------------------------------------------------------------------
-    // 接続判定
-    //----------------------------------------------------------------------
-    if (s_msg_ctrl_cfg.pf_connect_sts() != COM_BLE_MSG_CON_CONNECTED) {
-        // 未接続
-        return ESP_ERR_INVALID_STATE;
+static ts_u8_array_t* ps_msg_compress(ts_u8_array_t* ps_data) {
+    // 元データのサイズ
+    size_t t_src_len = 0;
+    if (ps_data != NULL) {
+        t_src_len = ps_data->t_size;
     }
-
-    //----------------------------------------------------------------------
-    // メッセージ生成
-    //----------------------------------------------------------------------
-    ts_u8_array_t* ps_msg = ps_create_msg_data(COM_BLE_MSG_TYP_RESET, NULL);
-    if (ps_msg == NULL) {
-        return ESP_ERR_NO_MEM;
+    // 圧縮形式の本文（最大は無圧縮の場合）
+    ts_u8_array_t* ps_packed = ps_mdl_empty_u8_array(MSG_SIZE_COMPRESS_TYPE + t_src_len);
+    if (ps_packed == NULL) {
+        return NULL;
+    }
+    uint8_t* pu8_packed = ps_packed->pu8_values;
+    // LZ圧縮（圧縮前のサイズを含めて元データより縮む場合のみ）
+    size_t t_cmp_len = 0;
+    if (t_src_len > MSG_SIZE_COMPRESS_LEN + 1 && t_src_len <= COM_LZ_MAX_SIZE) {
+        t_cmp_len = t_lz_compress(ps_data->pu8_values, t_src_len,
+                                  &pu8_packed[MSG_SIZE_COMPRESS_TYPE + MSG_SIZE_COMPRESS_LEN],
+                                  t_src_len - MSG_SIZE_COMPRESS_LEN - 1);
+    }
+    if (t_cmp_len > 0) {
+        // LZ圧縮
+        tu_type_converter_t u_conv;
+        u_conv.u16_values[0] = t_src_len;
+        pu8_packed[0] = MSG_COMPRESS_TYPE_LZ;
+        pu8_packed[MSG_SIZE_COMPRESS_TYPE]     = u_conv.u8_values[0];
+        pu8_packed[MSG_SIZE_COMPRESS_TYPE + 1] = u_conv.u8_values[1];
+        ps_packed->t_size = MSG_SIZE_COMPRESS_TYPE + MSG_SIZE_COMPRESS_LEN + t_cmp_len;
+    } else {
+        // 無圧縮
+        pu8_packed[0] = MSG_COMPRESS_TYPE_RAW;
+        if (t_src_len > 0) {
+            memcpy(&pu8_packed[MSG_SIZE_COMPRESS_TYPE], ps_data->pu8_values, t_src_len);
+        }
     }
-
-    //----------------------------------------------------------------------
-    // メッセージの送信
-    //----------------------------------------------------------------------
-    esp_err_t sts_val = s_msg_ctrl_cfg.pf_tx_msg(ps_msg);
-
-    //----------------------------------------------------------------------
-    // 送信メッセージ解放
-    //----------------------------------------------------------------------
-    sts_mdl_delete_u8_array(ps_msg);
-
     // 結果返信
-    return sts_val;
+    return ps_packed;
 }
 
 /*******************************************************************************
  *
- * NAME: sts_tx_ping_msg
+ * NAME: sts_msg_decompress
  *
- * DESCRIPTION:BLE Tx ping message
+ * DESCRIPTION:本文の伸長
  *
- * PARAMETERS:      Name            RW  Usage
+ * PARAMETERS:          Name            RW  Usage
+ * ts_com_msg_t*        ps_rx_msg       RW  受信メッセージ（本文は伸長後のデータに置き換わる）
  *
  * RETURNS:
- * esp_err_t:送信結果
+ *   ESP_OK:正常終了
+ *   ESP_ERR_INVALID_SIZE:不正な圧縮形式
+ *   ESP_ERR_INVALID_RESPONSE:不正な圧縮前のサイズ（0又は最大メッセージサイズ超過）
+ *   ESP_ERR_NO_MEM:メモリ不足
  *
  * NOTES:
- * None.
+ * 圧縮前のサイズは送信側が自由に指定出来るので、伸長先の確保前に最大メッセージサイズで制限する。
  ******************************************************************************/
-static esp_err_t sts_tx_ping_msg() {
-    //----------------------------------------------------------------------
-    // 接続判定
-    //----------------------------------------------------------------------
-    if (s_msg_ctrl_cfg.pf_connect_sts() != COM_BLE_MSG_CON_CONNECTED) {
-        // 未接続
-        return  ESP_ERR_INVALID_STATE;
+static esp_err_t sts_msg_decompress(ts_com_msg_t* ps_rx_msg) {
+    // 入力チェック
+    ts_u8_array_t* ps_packed = ps_rx_msg->ps_data;
+    if (ps_packed == NULL || ps_packed->t_size < MSG_SIZE_COMPRESS_TYPE) {
+        return ESP_ERR_INVALID_SIZE;
     }
-
-    //----------------------------------------------------------------------
-    // メッセージ生成
-    //----------------------------------------------------------------------
-    ts_u8_array_t* ps_msg = ps_create_msg_data(COM_BLE_MSG_TYP_PING, NULL);
-    if (ps_msg == NULL) {
-        return  ESP_ERR_NO_MEM;
+    uint8_t* pu8_packed = ps_packed->pu8_values;
+    // 無圧縮の場合は圧縮タイプを除く（インプレース）
+    if (pu8_packed[0] == MSG_COMPRESS_TYPE_RAW) {
+        v_msg_rx_data_skip(ps_packed, MSG_SIZE_COMPRESS_TYPE);
+        return ESP_OK;
     }
-
-    //----------------------------------------------------------------------
-    // メッセージの送信
-    //----------------------------------------------------------------------
-    esp_err_t sts_val = s_msg_ctrl_cfg.pf_tx_msg(ps_msg);
-
-    //----------------------------------------------------------------------
-    // 送信メッセージ解放
-    //----------------------------------------------------------------------
-    sts_mdl_delete_u8_array(ps_msg);
-
+    // 圧縮タイプと圧縮前のサイズを判定
+    if (pu8_packed[0] != MSG_COMPRESS_TYPE_LZ ||
+        ps_packed->t_size <= MSG_SIZE_COMPRESS_TYPE + MSG_SIZE_COMPRESS_LEN) {
+        return ESP_ERR_INVALID_SIZE;
+    }
+    tu_type_converter_t u_conv;
+    u_conv.u8_values[0] = pu8_packed[MSG_SIZE_COMPRESS_TYPE];
+    u_conv.u8_values[1] = pu8_packed[MSG_SIZE_COMPRESS_TYPE + 1];
+    size_t t_org_len = u_conv.u16_values[0];
+    if (t_org_len == 0 || t_org_len > s_msg_ctrl_cfg.u32_max_length) {
+        return ESP_ERR_INVALID_RESPONSE;
+    }
+    // 伸長先の確保（受信フレームが無い場合は動的に確保）
+    ts_u8_array_t* ps_data = NULL;
+    ts_msg_rx_frame_t* ps_frame = ps_msg_rx_frame_take();
+    if (ps_frame != NULL) {
+        ps_data = &ps_frame->s_data;
+        ps_data->t_size = t_org_len;
+    } else {
+        ps_data = ps_mdl_empty_u8_array(t_org_len);
+        if (ps_data == NULL) {
+            return ESP_ERR_NO_MEM;
+        }
+    }
+    // LZ伸長
+    size_t t_dec_len = 0;
+    if (!b_lz_decompress(&pu8_packed[MSG_SIZE_COMPRESS_TYPE + MSG_SIZE_COMPRESS_LEN],
+                         ps_packed->t_size - MSG_SIZE_COMPRESS_TYPE - MSG_SIZE_COMPRESS_LEN,
+                         ps_data->pu8_values, t_org_len, &t_dec_len) || t_dec_len != t_org_len) {
+        sts_com_msg_delete_data(ps_data);
+        return ESP_ERR_INVALID_SIZE;
+    }
+    // 本文を置き換え
+    sts_com_msg_delete_data(ps_packed);
+    ps_rx_msg->ps_data = ps_data;
     // 結果返信
-    return sts_val;
+    return ESP_OK;
 }
 
 /*******************************************************************************
  *
- * NAME: v_upd_tx_history
+ * NAME: v_msg_ticket_persist_reset
  *
- * DESCRIPTION:送信履歴の更新処理
+ * DESCRIPTION:チケット更新の遅延状態の初期化
  *
- * PARAMETERS:      Name        RW  Usage
- * ts_u8_array_t*   ps_msg      R   送信メッセージ
+ * PARAMETERS:                  Name        RW  Usage
+ * ts_msg_ticket_persist_t*     ps_persist  W   遅延状態
+ * ts_com_msg_auth_ticket_t*    ps_ticket   R   書き込み済みのチケット（NULL:遅延状態の無効化）
  *
  * RETURNS:
  *
  * NOTES:
- * None.
+ * チケットを読み込み、もしくは作成した直後に呼び出す事。
  ******************************************************************************/
-static void v_upd_tx_history(ts_u8_array_t* ps_msg) {
-    //==========================================================================
-    // 送信カウンタの更新
-    //==========================================================================
-    s_msg_ctrl_sts.u64_tx_count++;
-
-    //==========================================================================
-    // 送信履歴の更新
-    //==========================================================================
-    uint8_t* pu8_value = ps_msg->pu8_values;
-    if (pu8_value[MSG_POS_TYPE] == COM_BLE_MSG_TYP_RESPONSE) {
-        // 受信通知の場合は履歴を更新しない
+static void v_msg_ticket_persist_reset(ts_msg_ticket_persist_t* ps_persist, ts_com_msg_auth_ticket_t* ps_ticket) {
+    if (ps_ticket == NULL) {
+        ps_persist->b_valid = false;
         return;
     }
-
-    //==========================================================================
-    // 送信履歴の更新
-    //==========================================================================
-    // 受信通知以外の場合　※送信履歴のBLEアドレスは使用しない
-    ts_msg_history_t* ps_bef_tx_msg = &s_msg_ctrl_sts.s_bef_tx_msg;
-    // デバイスID
-    tu_type_converter_t u_conv;
-    u_conv.u8_values[0] = pu8_value[MSG_POS_DEVICE_ID];
-    u_conv.u8_values[1] = pu8_value[MSG_POS_DEVICE_ID + 1];
-    u_conv.u8_values[2] = pu8_value[MSG_POS_DEVICE_ID + 2];
-    u_conv.u8_values[3] = pu8_value[MSG_POS_DEVICE_ID + 3];
-    u_conv.u8_values[4] = pu8_value[MSG_POS_DEVICE_ID + 4];
-    u_conv.u8_values[5] = pu8_value[MSG_POS_DEVICE_ID + 5];
-    u_conv.u8_values[6] = pu8_value[MSG_POS_DEVICE_ID + 6];
-    u_conv.u8_values[7] = pu8_value[MSG_POS_DEVICE_ID + 7];
-    ps_bef_tx_msg->u64_device_id = u_conv.u64_value;
-    // シーケンス番号
-    u_conv.u8_values[0] = pu8_value[MSG_POS_SEQ_NO];
-    u_conv.u8_values[1] = pu8_value[MSG_POS_SEQ_NO + 1];
-    u_conv.u8_values[2] = pu8_value[MSG_POS_SEQ_NO + 2];
-    u_conv.u8_values[3] = pu8_value[MSG_POS_SEQ_NO + 3];
-    ps_bef_tx_msg->u32_seq_no = u_conv.u32_values[0];
-    // 送信時間
-    ps_bef_tx_msg->u32_tick_ms = xTaskGetTickCountMSec();
-    // タイプ
-    ps_bef_tx_msg->e_type = pu8_value[MSG_POS_TYPE];
+    ps_persist->b_valid         = true;
+    ps_persist->u64_device_id   = ps_ticket->u64_rmt_device_id;
+    ps_persist->u32_tx_reserved = ps_ticket->u32_tx_seq_no;
+    ps_persist->u32_rx_flushed  = ps_ticket->u32_rx_seq_no;
 }
 
 /*******************************************************************************
  *
- * NAME: b_is_public_key_received
+ * NAME: ps_msg_ticket_persist
  *
- * DESCRIPTION:Public key received check
+ * DESCRIPTION:チケット更新の遅延状態の取得
  *
- * PARAMETERS:  Name            RW  Usage
+ * PARAMETERS:                  Name        RW  Usage
+ * ts_com_msg_auth_ticket_t*    ps_ticket   R   対象チケット
  *
  * RETURNS:
- *   true:公開鍵受信済み
+ *   ts_msg_ticket_persist_t*:遅延状態（NULL:遅延更新の対象外）
  *
  * NOTES:
- * None.
+ * 遅延更新の対象はリモートデバイスチケットとチケットキャッシュのエントリのみとする。
  ******************************************************************************/
-static bool b_is_public_key_received() {
-    //----------------------------------------------------------------------
-    // 公開鍵の受信済み判定
-    //----------------------------------------------------------------------
-    ts_pairing_info_t* ps_pairing = &s_msg_ctrl_sts.s_pairing;
-    // X25519コンテキスト
-    ts_crypto_x25519_context_t* ps_x25519_ctx = ps_pairing->ps_x25519_ctx;
-    if (ps_x25519_ctx == NULL) {
-        return false;
+static ts_msg_ticket_persist_t* ps_msg_ticket_persist(ts_com_msg_auth_ticket_t* ps_ticket) {
+    // 遅延状態の検索
+    ts_msg_ticket_persist_t* ps_persist = NULL;
+    if (ps_ticket == &s_msg_ctrl_sts.s_rmt_ticket) {
+        ps_persist = &s_msg_ctrl_sts.s_tkt_persist;
+    } else {
+        ts_msg_ticket_entry_t* ps_entry = s_msg_ctrl_sts.s_tkt_cache.s_entry;
+        for (uint8_t u8_idx = 0; u8_idx < COM_MSG_TICKET_CACHE_SIZE; u8_idx++) {
+            if (ps_ticket == &ps_entry[u8_idx].s_ticket) {
+                ps_persist = &ps_entry[u8_idx].s_persist;
+                break;
+            }
+        }
     }
-    // 公開鍵（サーバー）
-    uint8_t* pu8_svr_key = ps_x25519_ctx->u8_svr_public_key;
-    if (pu8_svr_key[0] != 0x20) {
-        return false;
+    // 有効判定
+    if (ps_persist == NULL || !ps_persist->b_valid || ps_persist->u64_device_id != ps_ticket->u64_rmt_device_id) {
+        return NULL;
     }
-    // 公開鍵（クライアント）
-    uint8_t* pu8_cli_key = ps_x25519_ctx->u8_cli_public_key;
-    tu_type_converter_t u_type_conv;
-    u_type_conv.u8_values[0] = pu8_cli_key[0];
-    u_type_conv.u8_values[1] = pu8_cli_key[1];
-    u_type_conv.u8_values[2] = pu8_cli_key[2];
-    u_type_conv.u8_values[3] = pu8_cli_key[3];
-    // 公開鍵受信済み
-    return (u_type_conv.u32_values[0] == 0x201D0003);
+    return ps_persist;
 }
 
 /*******************************************************************************
  *
- * NAME: b_is_paired
+ * NAME: sts_msg_ticket_write
  *
- * DESCRIPTION:pairing check
+ * DESCRIPTION:チケットの書き込み
  *
- * PARAMETERS:  Name            RW  Usage
- * uint64_t     u64_device_id   R   対象デバイスID
+ * PARAMETERS:                  Name        RW  Usage
+ * ts_com_msg_auth_ticket_t*    ps_ticket   R   対象チケット
  *
  * RETURNS:
- *   true:ペアリング済み
+ *   esp_err_t 結果ステータス
  *
  * NOTES:
- * None.
+ * 送信シーケンス番号は予約済みのブロックの上限で書き込む。
  ******************************************************************************/
-static bool b_is_paired(uint64_t u64_device_id) {
-    //==========================================================================
-    // 入力チェック
-    //==========================================================================
-    // リモートデバイスの有無を判定
-    if (u64_device_id == s_msg_ctrl_cfg.u64_device_id) {
-        return false;
+static esp_err_t sts_msg_ticket_write(ts_com_msg_auth_ticket_t* ps_ticket) {
+    // 遅延更新の対象外の場合はそのまま書き込み
+    ts_msg_ticket_persist_t* ps_persist = ps_msg_ticket_persist(ps_ticket);
+    if (ps_persist == NULL) {
+        return s_msg_ctrl_cfg.pf_tkt_cb(COM_BLE_MSG_TICKET_EVT_UPDATE, ps_ticket);
     }
-
-    //==========================================================================
-    // チケット取得
-    //==========================================================================
-    // チケット取得
-    ts_com_msg_auth_ticket_t s_ticket;
-    ts_com_msg_auth_ticket_t* ps_ticket = ps_read_ticket(u64_device_id, &s_ticket);
-    // チケットの有効判定
-    if (ps_ticket == NULL) {
-        return false;
+    // 送信シーケンス番号を予約済みのブロックの上限に置き換えて書き込み
+    ts_com_msg_auth_ticket_t s_write_ticket = *ps_ticket;
+    if (s_write_ticket.u32_tx_seq_no < ps_persist->u32_tx_reserved) {
+        s_write_ticket.u32_tx_seq_no = ps_persist->u32_tx_reserved;
     }
-    // シーケンス番号の有効判定
-    if (ps_ticket->u32_tx_seq_no >= ps_ticket->u32_max_seq_no) {
-        return false;
+    esp_err_t sts_val = s_msg_ctrl_cfg.pf_tkt_cb(COM_BLE_MSG_TICKET_EVT_UPDATE, &s_write_ticket);
+    if (sts_val == ESP_OK) {
+        // 書き込み済みの値を更新
+        ps_persist->u32_tx_reserved = s_write_ticket.u32_tx_seq_no;
+        ps_persist->u32_rx_flushed  = s_write_ticket.u32_rx_seq_no;
     }
+    // 書き込み用のチケットをクリア
+    v_init_ticket(&s_write_ticket);
     // 結果返信
-    return true;
+    return sts_val;
 }
 
 /*******************************************************************************
  *
- * NAME: sts_begin_open
+ * NAME: sts_msg_ticket_tx_update
  *
- * DESCRIPTION:オープントランザクションの開始
+ * DESCRIPTION:チケットの送信シーケンス番号の更新
  *
- * PARAMETERS:      Name            RW  Usage
- * esp_bd_addr_t    t_bda           R   接続先BLEアドレス
- * uint32_t*        pu32_timeout_ms W   トランザクションタイムアウトの編集先
+ * PARAMETERS:                  Name        RW  Usage
+ * ts_com_msg_auth_ticket_t*    ps_ticket   R   送信シーケンス番号を更新したチケット
  *
  * RETURNS:
  *   esp_err_t 結果ステータス
  *
  * NOTES:
- * None.
+ * 予約済みのブロックを使い切った場合のみ、次のブロックを予約して書き込む。
  ******************************************************************************/
-static esp_err_t sts_begin_open(esp_bd_addr_t t_bda, uint32_t* pu32_timeout_ms) {
-    //==========================================================================
-    // トランザクション開始チェック
-    //==========================================================================
-    // 現在の接続先を判定
-    if (l_com_ble_addr_cmp(t_bda, s_msg_ctrl_sts.t_rmt_bda) == 0) {
-        // 既に接続済み
-        return ESP_ERR_INVALID_STATE;
+static esp_err_t sts_msg_ticket_tx_update(ts_com_msg_auth_ticket_t* ps_ticket) {
+    // 遅延更新の対象判定
+    ts_msg_ticket_persist_t* ps_persist = ps_msg_ticket_persist(ps_ticket);
+    if (ps_persist == NULL) {
+        return s_msg_ctrl_cfg.pf_tkt_cb(COM_BLE_MSG_TICKET_EVT_UPDATE, ps_ticket);
     }
-    // トランザクション状態チェック
-    ts_transaction_info_t* ps_tran = &s_msg_ctrl_sts.s_tran;
-    if (ps_tran->e_sts != COM_BLE_MSG_TRN_NONE) {
-        // トランザクション実行中
-        return ESP_ERR_INVALID_STATE;
+    // 予約済みのブロック内の場合は書き込み無し
+    if (ps_ticket->u32_tx_seq_no <= ps_persist->u32_tx_reserved) {
+        return ESP_OK;
     }
-    // 接続状態チェック
-    if (s_msg_ctrl_cfg.pf_connect_sts() != COM_BLE_MSG_CON_DISCONNECTED) {
-        // 接続中もしくは接続済み
-        return ESP_ERR_INVALID_STATE;
+    // 次のブロックを予約（最大シーケンス番号まで）
+    uint32_t u32_bef_reserved = ps_persist->u32_tx_reserved;
+    uint32_t u32_reserved = ps_ticket->u32_tx_seq_no + (s_msg_ctrl_cfg.u32_tkt_seq_block - 1);
+    if (u32_reserved < ps_ticket->u32_tx_seq_no || u32_reserved > ps_ticket->u32_max_seq_no) {
+        u32_reserved = ps_ticket->u32_max_seq_no;
     }
+    ps_persist->u32_tx_reserved = u32_reserved;
+    esp_err_t sts_val = sts_msg_ticket_write(ps_ticket);
+    if (sts_val != ESP_OK) {
+        ps_persist->u32_tx_reserved = u32_bef_reserved;
+    }
+    // 結果返信
+    return sts_val;
+}
 
-    //==========================================================================
-    // オープントランザクションの開始処理
-    //==========================================================================
-    // オープントランザクション開始
-    ps_tran->e_sts = COM_BLE_MSG_TRN_OPEN;
-    // 相手デバイスIDクリア
-    ps_tran->u64_device_id = s_msg_ctrl_cfg.u64_device_id;
-    // BLEのアドレスコピー
-    v_com_ble_addr_cpy(ps_tran->t_bda, t_bda);
-    // トランザクションタイムアウト
-    *pu32_timeout_ms = xTaskGetTickCountMSec() + COM_MSG_TRN_TIMEOUT_MS_OPEN;
-    ps_tran->u32_timeout_ms = *pu32_timeout_ms;
-
-    // 正常終了
+/*******************************************************************************
+ *
+ * NAME: sts_msg_ticket_rx_update
+ *
+ * DESCRIPTION:チケットの受信シーケンス番号の更新
+ *
+ * PARAMETERS:                  Name        RW  Usage
+ * ts_com_msg_auth_ticket_t*    ps_ticket   R   受信シーケンス番号を更新したチケット
+ *
+ * RETURNS:
+ *   esp_err_t 結果ステータス
+ *
+ * NOTES:
+ * 遅延更新時間が0の場合は即時に書き込む（再起動後のリプレイを防ぐ為、受理する前に永続化する）。
+ * それ以外の場合は、未書き込みの受信数がブロックサイズに達した場合は即時に書き込み、
+ * それ以外の場合は遅延更新タイマーで書き込む。
+ ******************************************************************************/
+static esp_err_t sts_msg_ticket_rx_update(ts_com_msg_auth_ticket_t* ps_ticket) {
+    // 遅延更新の対象判定
+    ts_msg_ticket_persist_t* ps_persist = ps_msg_ticket_persist(ps_ticket);
+    if (ps_persist == NULL) {
+        return s_msg_ctrl_cfg.pf_tkt_cb(COM_BLE_MSG_TICKET_EVT_UPDATE, ps_ticket);
+    }
+    // 即時更新の判定
+    if (s_msg_ctrl_cfg.u32_tkt_flush_ms == 0) {
+        return sts_msg_ticket_write(ps_ticket);
+    }
+    // 未書き込みの受信数の判定
+    if (ps_ticket->u32_rx_seq_no - ps_persist->u32_rx_flushed >= s_msg_ctrl_cfg.u32_tkt_seq_block) {
+        return sts_msg_ticket_write(ps_ticket);
+    }
+    // 遅延更新タイマーの開始
+    if (b_tmw_is_active(&s_msg_deamon_sts.s_tkt_timer)) {
+        return ESP_OK;
+    }
+    if (sts_tmw_start(&s_msg_deamon_sts.s_tkt_timer, s_msg_ctrl_cfg.u32_tkt_flush_ms, 0) != ESP_OK) {
+        return sts_msg_ticket_write(ps_ticket);
+    }
+    // 結果返信
     return ESP_OK;
 }
 
 /*******************************************************************************
  *
- * NAME: sts_begin_pairing
+ * NAME: sts_msg_ticket_flush
+ *
+ * DESCRIPTION:遅延中のチケット更新の書き込み
+ *
+ * PARAMETERS:                  Name        RW  Usage
+ * ts_com_msg_auth_ticket_t*    ps_ticket   R   対象チケット
+ *
+ * RETURNS:
+ *   esp_err_t 結果ステータス
+ *
+ * NOTES:
+ * s_mutex_stsを取得した状態で呼び出す事。
+ ******************************************************************************/
+static esp_err_t sts_msg_ticket_flush(ts_com_msg_auth_ticket_t* ps_ticket) {
+    // 遅延中の更新（ダーティ）の判定
+    ts_msg_ticket_persist_t* ps_persist = ps_msg_ticket_persist(ps_ticket);
+    if (ps_persist == NULL || ps_ticket->u32_rx_seq_no == ps_persist->u32_rx_flushed) {
+        return ESP_OK;
+    }
+    // チケットの書き込み
+    return sts_msg_ticket_write(ps_ticket);
+}
+
+/*******************************************************************************
+ *
+ * NAME: sts_msg_ticket_flush_all
  *
- * DESCRIPTION:ペアリングトランザクションの開始
+ * DESCRIPTION:全ての遅延中のチケット更新の書き込み
  *
  * PARAMETERS:      Name            RW  Usage
  *
  * RETURNS:
- *   esp_err_t 結果ステータス
+ *   esp_err_t 結果ステータス（最初のエラー）
  *
  * NOTES:
- * None.
+ * s_mutex_stsを取得した状態で呼び出す事。
  ******************************************************************************/
-static esp_err_t sts_begin_pairing() {
-    //==========================================================================
-    // トランザクション開始チェック
-    //==========================================================================
-    //--------------------------------------------------------------------------
-    // ペアリング機能の有効チェック
-    //--------------------------------------------------------------------------
-    if ((s_msg_ctrl_cfg.s_func_ctl & MSG_FUNC_CTL_PAIRING) == 0x00) {
-        return ESP_ERR_INVALID_STATE;
-    }
-
-    //--------------------------------------------------------------------------
-    // トランザクション状態チェック
-    //--------------------------------------------------------------------------
-    ts_transaction_info_t* ps_tran = &s_msg_ctrl_sts.s_tran;
-    if (ps_tran->e_sts != COM_BLE_MSG_TRN_NONE) {
-        // トランザクション実行中
-        return ESP_ERR_INVALID_STATE;
-    }
-
-    //--------------------------------------------------------------------------
-    // 接続チェック
-    //--------------------------------------------------------------------------
-    if (s_msg_ctrl_cfg.pf_connect_sts() != COM_BLE_MSG_CON_CONNECTED) {
-        // 未接続
-        return ESP_ERR_INVALID_STATE;
+static esp_err_t sts_msg_ticket_flush_all() {
+    // リモートデバイスチケット
+    esp_err_t sts_result = sts_msg_ticket_flush(&s_msg_ctrl_sts.s_rmt_ticket);
+    // チケットキャッシュ
+    ts_msg_ticket_entry_t* ps_entry = s_msg_ctrl_sts.s_tkt_cache.s_entry;
+    for (uint8_t u8_idx = 0; u8_idx < COM_MSG_TICKET_CACHE_SIZE; u8_idx++) {
+        esp_err_t sts_val = sts_msg_ticket_flush(&ps_entry[u8_idx].s_ticket);
+        if (sts_result == ESP_OK) {
+            sts_result = sts_val;
+        }
     }
-
-    //==========================================================================
-    // ペアリングトランザクションの開始処理
-    //==========================================================================
-    //--------------------------------------------------------------------------
-    // トランザクション情報を編集
-    //--------------------------------------------------------------------------
-    // ペアリングトランザクション開始
-    ps_tran->e_sts = COM_BLE_MSG_TRN_PAIRING;
-    // 相手デバイスID
-    ps_tran->u64_device_id = s_msg_ctrl_sts.u64_rmt_device_id;
-    // BLEのアドレスコピー
-    v_com_ble_addr_cpy(ps_tran->t_bda, s_msg_ctrl_sts.t_rmt_bda);
-    // トランザクションタイムアウト
-    ps_tran->u32_timeout_ms = xTaskGetTickCountMSec() + COM_MSG_TRN_TIMEOUT_MS_PAIRING;
-
-    //--------------------------------------------------------------------------
-    // ペアリングステータスを編集
-    //--------------------------------------------------------------------------
-    ts_pairing_info_t* ps_pairing = &s_msg_ctrl_sts.s_pairing;
-    // ペアリングステータス
-    ps_pairing->e_sts = MSG_PAIRING_CHK_NONE;
-    // 共通鍵
-    memset(ps_pairing->u8_com_key, 0x00, COM_MSG_SIZE_CIPHER_KEY);
-    // X25519コンテキストを削除
-    v_crypto_x25519_delete_context(ps_pairing->ps_x25519_ctx);
-    ps_pairing->ps_x25519_ctx = NULL;
-    // 自デバイスステータス
-    b_vutil_set_u8_rand_array(ps_pairing->u8_dev_status, COM_MSG_SIZE_TICKET_STS);
-    // 相手デバイスステータスハッシュ
-    memset(ps_pairing->u8_rmt_sts_hash, 0x00, COM_MSG_SIZE_TICKET_STS);
-    // 最大シーケンス番号
-    ps_pairing->u32_max_seq_no = 0;
-    // 正常終了
-    return ESP_OK;
+    // 結果返信
+    return sts_result;
 }
 
 /*******************************************************************************
  *
- * NAME: sts_begin_sts_chk
+ * NAME: v_msg_ticket_timer_cb
  *
- * DESCRIPTION:ステータスチェックトランザクションの開始
+ * DESCRIPTION:チケット更新タイマーコールバック
  *
- * PARAMETERS:      Name            RW  Usage
+ * PARAMETERS:  Name            RW  Usage
+ * void*        pv_arg          R   コールバック引数
  *
  * RETURNS:
- *   esp_err_t 結果ステータス
  *
  * NOTES:
- * None.
+ * タイマーサービスタスクから呼び出される。書き込みに失敗した場合は再試行する。
  ******************************************************************************/
-static esp_err_t sts_begin_sts_chk() {
+static void v_msg_ticket_timer_cb(void* pv_arg) {
     //==========================================================================
-    // トランザクション開始チェック
+    // クリティカルセクション開始
     //==========================================================================
-    //--------------------------------------------------------------------------
-    // 機能の有効判定
-    //--------------------------------------------------------------------------
-    if ((s_msg_ctrl_cfg.s_func_ctl & MSG_FUNC_CTL_STS_CHK) == 0x00) {
-        return ESP_ERR_INVALID_STATE;
-    }
-
-    //--------------------------------------------------------------------------
-    // トランザクション状態チェック
-    //--------------------------------------------------------------------------
-    ts_transaction_info_t* ps_tran = &s_msg_ctrl_sts.s_tran;
-    if (ps_tran->e_sts != COM_BLE_MSG_TRN_NONE) {
-        // トランザクション実行中
-        return ESP_ERR_INVALID_STATE;
-    }
-
-    //--------------------------------------------------------------------------
-    // ペアリング済み判定
-    //--------------------------------------------------------------------------
-    if (!b_is_paired(s_msg_ctrl_sts.u64_rmt_device_id)) {
-        return ESP_ERR_INVALID_STATE;
+    if (xSemaphoreTakeRecursive(s_mutex_sts, portMAX_DELAY) != pdTRUE) {
+        return;
     }
 
-    //--------------------------------------------------------------------------
-    // 接続判定
-    //--------------------------------------------------------------------------
-    if (s_msg_ctrl_cfg.pf_connect_sts() != COM_BLE_MSG_CON_CONNECTED) {
-#ifdef COM_BLE_MSG_DEBUG
-        ESP_LOGE(LOG_TAG, "%s L#%d Err=ESP_ERR_INVALID_STATE", __func__, __LINE__);
-#endif
-        // 未接続
-        return ESP_ERR_INVALID_STATE;
+    //==========================================================================
+    // 遅延中のチケット更新の書き込み
+    //==========================================================================
+    if (sts_msg_ticket_flush_all() != ESP_OK) {
+        sts_tmw_start(&s_msg_deamon_sts.s_tkt_timer, s_msg_ctrl_cfg.u32_tkt_flush_ms, 0);
     }
 
     //==========================================================================
-    // ステータスチェックトランザクションの開始処理
+    // クリティカルセクション終了
     //==========================================================================
-    // ステータスチェックトランザクション開始
-    ps_tran->e_sts = COM_BLE_MSG_TRN_STS_CHK;
-    // 相手デバイスID
-    ps_tran->u64_device_id = s_msg_ctrl_sts.u64_rmt_device_id;
-    // BLEのアドレスコピー
-    v_com_ble_addr_cpy(ps_tran->t_bda, s_msg_ctrl_sts.t_rmt_bda);
-    // トランザクションタイムアウト
-    ps_tran->u32_timeout_ms = xTaskGetTickCountMSec() + COM_MSG_TRN_TIMEOUT_MS_STS_CHK;
-
-    //--------------------------------------------------------------------------
-    // ステータスチェックを初期化
-    //--------------------------------------------------------------------------
-    ts_sts_check_info_t* ps_sts_chk = &s_msg_ctrl_sts.s_sts_chk;
-    // 送信ステータスチェック乱数
-    memset(ps_sts_chk->u8_tx_rand, 0x00, COM_MSG_SIZE_TICKET_STS);
-    // 受信ステータスチェック乱数
-    memset(ps_sts_chk->u8_rx_rand, 0x00, COM_MSG_SIZE_TICKET_STS);
-
-    // 正常終了
-    return ESP_OK;
+    xSemaphoreGiveRecursive(s_mutex_sts);
 }
 
 /*******************************************************************************
  *
- * NAME: sts_status_check
+ * NAME: ps_msg_ticket_cache_find
  *
- * DESCRIPTION:ステータスチェック
+ * DESCRIPTION:チケットキャッシュの検索
  *
- * PARAMETERS:                  Name            RW  Usage
- * uint64_t                     u64_device_id   R   デバイスID
- * uint8_t*                     pu8_chk_code    R   チェックコード
- * ts_com_msg_auth_ticket_t*    ps_ticket       R   チケット
+ * PARAMETERS:      Name            RW  Usage
+ * uint64_t         u64_device_id   R   相手デバイスID
  *
  * RETURNS:
- *   esp_err_t:結果ステータス
+ *   ts_msg_ticket_entry_t*:エントリ（NULL:キャッシュ無し）
  *
  * NOTES:
- * None.
+ * 該当したエントリは最終参照カウンタを更新する。
  ******************************************************************************/
-static esp_err_t sts_status_check(uint64_t u64_device_id, uint8_t* pu8_chk_code, ts_com_msg_auth_ticket_t* ps_ticket) {
-    // 自デバイスの１次ステータスハッシュ生成
-    ts_u8_array_t* ps_own_sts = ps_mdl_create_u8_array(ps_ticket->u8_own_sts, COM_MSG_SIZE_TICKET_STS);
-    if (ps_own_sts == NULL) {
-        return ESP_ERR_NO_MEM;
-    }
-    uint8_t u8_own_hash[COM_MSG_SIZE_TICKET_STS];
-    esp_err_t sts_val = sts_crypto_sha256(ps_own_sts, COM_MSG_AUTH_STRETCHING, u8_own_hash);
-    sts_mdl_delete_u8_array(ps_own_sts);
-    if (sts_val != ESP_OK) {
-        return sts_val;
-    }
-    // １次ステータスハッシュに送信したチェック乱数を排他的論理和
-    ts_sts_check_info_t* ps_sts_chk = &s_msg_ctrl_sts.s_sts_chk;
-    uint8_t* pu8_rand = ps_sts_chk->u8_tx_rand;
-    uint8_t u8_idx;
-    for (u8_idx = 0; u8_idx < COM_MSG_SIZE_TICKET_STS; u8_idx++) {
-        u8_own_hash[u8_idx] ^= pu8_rand[u8_idx];
-    }
-    // ２次ステータスコードハッシュを生成
-    ts_u8_array_t* ps_own_hash = ps_mdl_create_u8_array(u8_own_hash, COM_MSG_SIZE_TICKET_STS);
-    if (ps_own_sts == NULL) {
-        return ESP_ERR_NO_MEM;
-    }
-    uint8_t u8_chk_code[COM_MSG_SIZE_TICKET_STS];
-    sts_val = sts_crypto_sha256(ps_own_hash, COM_MSG_AUTH_STRETCHING, u8_chk_code);
-    sts_mdl_delete_u8_array(ps_own_hash);
-    if (sts_val != ESP_OK) {
-        return sts_val;
-    }
-#ifdef COM_BLE_MSG_DEBUG
-    char sts_txt[(COM_MSG_SIZE_TICKET_STS * 2) + 1];
-    v_vutil_u8_to_hex_string(ps_ticket->u8_own_sts, COM_MSG_SIZE_TICKET_STS, sts_txt);
-    ESP_LOGW(LOG_TAG, "%s L#%d tkt sts_code=%s", __func__, __LINE__, sts_txt);
-    v_vutil_u8_to_hex_string(ps_sts_chk->u8_tx_rand, COM_MSG_SIZE_TICKET_STS, sts_txt);
-    ESP_LOGW(LOG_TAG, "%s L#%d tkt sts_rand=%s", __func__, __LINE__, sts_txt);
-    v_vutil_u8_to_hex_string(u8_chk_code, COM_MSG_SIZE_TICKET_STS, sts_txt);
-    ESP_LOGW(LOG_TAG, "%s L#%d tkt sts_hash=%s", __func__, __LINE__, sts_txt);
-    v_vutil_u8_to_hex_string(pu8_chk_code, COM_MSG_SIZE_TICKET_STS, sts_txt);
-    ESP_LOGW(LOG_TAG, "%s L#%d rmt sts_hash=%s", __func__, __LINE__, sts_txt);
-#endif
-    // チェックコードを比較
-    if (memcmp(pu8_chk_code, u8_chk_code, COM_MSG_SIZE_TICKET_STS) != 0) {
-        return ESP_ERR_INVALID_ARG;
+static ts_msg_ticket_entry_t* ps_msg_ticket_cache_find(uint64_t u64_device_id) {
+    ts_msg_ticket_cache_t* ps_cache = &s_msg_ctrl_sts.s_tkt_cache;
+    for (uint8_t u8_idx = 0; u8_idx < COM_MSG_TICKET_CACHE_SIZE; u8_idx++) {
+        ts_msg_ticket_entry_t* ps_entry = &ps_cache->s_entry[u8_idx];
+        if (ps_entry->s_persist.b_valid && ps_entry->s_ticket.u64_rmt_device_id == u64_device_id) {
+            ps_entry->u32_last_ref = ++ps_cache->u32_ref_cnt;
+            return ps_entry;
+        }
     }
-    // チェックOK
-    return ESP_OK;
+    return NULL;
 }
 
 /*******************************************************************************
  *
- * NAME: sts_msg_encryption
+ * NAME: ps_msg_ticket_cache_alloc
  *
- * DESCRIPTION:メッセージの暗号化
+ * DESCRIPTION:チケットキャッシュのエントリの確保
  *
- * PARAMETERS:          Name            RW  Usage
- * ts_u8_array_t*       ps_msg          RW  メッセージ
- * uint16_t             u16_data_len    R   データ長
- * uint8_t*             pu8_key*        R   共通鍵
+ * PARAMETERS:      Name            RW  Usage
  *
  * RETURNS:
- *   esp_err_t 結果ステータス
+ *   ts_msg_ticket_entry_t*:未使用のエントリ（NULL:追い出すエントリの書き込みエラー）
  *
  * NOTES:
- * None.
+ * 空きが無い場合は最も長く参照されていないエントリを書き込んだ上で追い出す。
+ * 書き込みに失敗した場合は遅延中の更新を失わない様に追い出さない。
  ******************************************************************************/
-static esp_err_t sts_msg_encryption(ts_u8_array_t* ps_msg,
-                                     uint16_t u16_data_len,
-                                     uint8_t* pu8_key) {
-    //==========================================================================
-    // 初期処理
-    //==========================================================================
-    // 結果ステータス
-    esp_err_t sts_val = ESP_OK;
-    // キーセット
-    ts_crypto_keyset_t* ps_keyset = NULL;
-    // 認証タグ
-    ts_u8_array_t* ps_auth_tag = NULL;
-    // 平文データ
-    ts_u8_array_t* ps_plane = NULL;
-    // 暗号データ
-    ts_u8_array_t* ps_cipher = NULL;
-    // 型変換
-    tu_type_converter_t u_conv;
-
-    //==========================================================================
-    // 主処理
-    //==========================================================================
-    do {
-        // メッセージ
-        uint8_t* pu8_msg = ps_msg->pu8_values;
-        // IVの生成
-        b_vutil_set_u8_rand_array(&pu8_msg[MSG_POS_CIPHER_IV], MSG_SIZE_CIPHER_IV);
-        // IVの取得
-        ts_msg_edit_iv_t s_edit_iv;
-        u_conv.u8_values[0] = pu8_msg[MSG_POS_SEQ_NO];
-        u_conv.u8_values[1] = pu8_msg[MSG_POS_SEQ_NO + 1];
-        u_conv.u8_values[2] = pu8_msg[MSG_POS_SEQ_NO + 2];
-        u_conv.u8_values[3] = pu8_msg[MSG_POS_SEQ_NO + 3];
-        s_edit_iv.u32_seq_no = u_conv.u32_values[0];
-        memcpy(s_edit_iv.u8_iv, &pu8_msg[MSG_POS_CIPHER_IV], MSG_SIZE_CIPHER_IV);
-        // キーの生成
-        ps_keyset = ps_crypto_create_keyset();
-        if (ps_keyset == NULL) {
-            sts_val = ESP_ERR_NO_MEM;
-            break;
-        }
-        // 共通鍵
-        ps_keyset->ps_key = ps_mdl_create_u8_array(pu8_key, COM_MSG_SIZE_CIPHER_KEY);
-        if (ps_keyset->ps_key == NULL) {
-            break;
-        }
-        // 初期ベクトル
-        ps_keyset->ps_key_iv = ps_mdl_create_u8_array((uint8_t*)&s_edit_iv, IV_BYTES);
-        if (ps_keyset->ps_key_iv == NULL) {
+static ts_msg_ticket_entry_t* ps_msg_ticket_cache_alloc() {
+    ts_msg_ticket_cache_t* ps_cache = &s_msg_ctrl_sts.s_tkt_cache;
+    // 空きエントリもしくは最も古いエントリの検索
+    ts_msg_ticket_entry_t* ps_victim = &ps_cache->s_entry[0];
+    for (uint8_t u8_idx = 0; u8_idx < COM_MSG_TICKET_CACHE_SIZE; u8_idx++) {
+        ts_msg_ticket_entry_t* ps_entry = &ps_cache->s_entry[u8_idx];
+        if (!ps_entry->s_persist.b_valid) {
+            ps_victim = ps_entry;
             break;
         }
-        // ナンス
-        ps_keyset->ps_nonce = NULL;
-        // 認証タグ初期ベクトル
-        ps_keyset->ps_auth_iv  = ps_mdl_empty_u8_array(MSG_SIZE_CIPHER_TAG);
-        if (ps_keyset->ps_auth_iv == NULL) {
-            break;
+        if ((ps_cache->u32_ref_cnt - ps_entry->u32_last_ref) > (ps_cache->u32_ref_cnt - ps_victim->u32_last_ref)) {
+            ps_victim = ps_entry;
         }
-        // 認証タグ
-        ps_auth_tag = ps_mdl_empty_u8_array(MSG_SIZE_CIPHER_TAG);
-        if (ps_auth_tag == NULL) {
-            break;
+    }
+    // 追い出し（遅延中の更新を書き込み）
+    if (ps_victim->s_persist.b_valid) {
+        if (sts_msg_ticket_flush(&ps_victim->s_ticket) != ESP_OK) {
+            return NULL;
         }
-        // 平文の取得
-        ps_plane = ps_mdl_create_u8_array(&pu8_msg[MSG_POS_CIPHER_DATA], u16_data_len);
-        if (ps_plane == NULL) {
-            sts_val = ESP_ERR_NO_MEM;
-            break;
+        ps_victim->s_persist.b_valid = false;
+        v_init_ticket(&ps_victim->s_ticket);
+    }
+    ps_victim->u32_last_ref = ++ps_cache->u32_ref_cnt;
+    return ps_victim;
+}
+
+/*******************************************************************************
+ *
+ * NAME: sts_msg_ticket_cache_park
+ *
+ * DESCRIPTION:リモートデバイスチケットのチケットキャッシュへの退避
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *
+ * RETURNS:
+ *   esp_err_t 結果ステータス（ESP_FAIL:エントリを確保出来ない）
+ *
+ * NOTES:
+ * 遅延中の更新はダーティのまま退避し、遅延更新タイマーか追い出し時に書き込む。
+ * 退避後のリモートデバイスチケットの遅延状態は無効となる。
+ * エラーの場合はリモートデバイスチケットと遅延状態をそのまま残す。
+ ******************************************************************************/
+static esp_err_t sts_msg_ticket_cache_park() {
+    ts_com_msg_auth_ticket_t* ps_ticket = &s_msg_ctrl_sts.s_rmt_ticket;
+    ts_msg_ticket_persist_t* ps_persist = ps_msg_ticket_persist(ps_ticket);
+    if (ps_persist != NULL) {
+        // 同一デバイスのエントリを置き換え
+        ts_msg_ticket_entry_t* ps_entry = ps_msg_ticket_cache_find(ps_ticket->u64_rmt_device_id);
+        if (ps_entry == NULL) {
+            ps_entry = ps_msg_ticket_cache_alloc();
         }
-#ifdef COM_BLE_MSG_DEBUG
-        do {
-            char c_txt_str[(ps_plane->t_size * 2) + 1];
-            v_vutil_u8_to_hex_string(ps_plane->pu8_values, ps_plane->t_size, c_txt_str);
-            ESP_LOGW(LOG_TAG, "%s L#%d plane=%s", __func__, __LINE__, c_txt_str);
-        } while(false);
-#endif
-        // 暗号(AES GCMモード)の生成
-        ps_cipher = ps_crypto_aes_gcm_enc(ps_keyset, ps_plane, ps_auth_tag);
-        if (ps_cipher == NULL) {
-            sts_val = ESP_ERR_NO_MEM;
-            break;
+        if (ps_entry == NULL) {
+            return ESP_FAIL;
         }
-#ifdef COM_BLE_MSG_DEBUG
-        do {
-            char c_key_str[(COM_MSG_SIZE_CIPHER_KEY * 2) + 1];
-            v_vutil_u8_to_hex_string(pu8_key, COM_MSG_SIZE_CIPHER_KEY, c_key_str);
-            ESP_LOGW(LOG_TAG, "%s L#%d key=%s", __func__, __LINE__, c_key_str);
-            char c_cipher_str[(ps_cipher->t_size * 2) + 1];
-            v_vutil_u8_to_hex_string(ps_cipher->pu8_values, ps_cipher->t_size, c_cipher_str);
-            ESP_LOGW(LOG_TAG, "%s L#%d cipher=%s", __func__, __LINE__, c_cipher_str);
-            char c_tag_str[(ps_auth_tag->t_size * 2) + 1];
-            v_vutil_u8_to_hex_string(ps_auth_tag->pu8_values, ps_auth_tag->t_size, c_tag_str);
-            ESP_LOGW(LOG_TAG, "%s L#%d tag=%s", __func__, __LINE__, c_tag_str);
-        } while(false);
-#endif
-        // 認証タグを編集
-        memcpy(&pu8_msg[MSG_POS_CIPHER_TAG], ps_auth_tag->pu8_values, ps_auth_tag->t_size);
-        // 平文を暗号に更新
-        memcpy(&pu8_msg[MSG_POS_CIPHER_DATA], ps_cipher->pu8_values, ps_cipher->t_size);
-    } while(false);
-
-    //==========================================================================
-    // 後処理
-    //==========================================================================
-    // 暗号文の解放
-    sts_mdl_delete_u8_array(ps_cipher);
-    // 平文の解放
-    sts_mdl_delete_u8_array(ps_plane);
-    // 認証タグの解放
-    sts_mdl_delete_u8_array(ps_auth_tag);
-    // キーの解放
-    sts_crypto_delete_keyset(ps_keyset);
+        ps_entry->s_ticket  = *ps_ticket;
+        ps_entry->s_persist = *ps_persist;
+    }
+    v_msg_ticket_persist_reset(&s_msg_ctrl_sts.s_tkt_persist, NULL);
+    return ESP_OK;
+}
 
-    // 結果返信
-    return sts_val;
+/*******************************************************************************
+ *
+ * NAME: v_msg_ticket_cache_remove
+ *
+ * DESCRIPTION:チケットキャッシュのエントリの破棄
+ *
+ * PARAMETERS:      Name            RW  Usage
+ * uint64_t         u64_device_id   R   相手デバイスID
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * 遅延中の更新は書き込まずに破棄する。
+ ******************************************************************************/
+static void v_msg_ticket_cache_remove(uint64_t u64_device_id) {
+    ts_msg_ticket_entry_t* ps_entry = ps_msg_ticket_cache_find(u64_device_id);
+    if (ps_entry != NULL) {
+        ps_entry->s_persist.b_valid = false;
+        v_init_ticket(&ps_entry->s_ticket);
+    }
 }
 
 /*******************************************************************************
  *
- * NAME: ps_msg_decryption
+ * NAME: v_msg_rx_frame_alloc
  *
- * DESCRIPTION:メッセージの復号
+ * DESCRIPTION:受信フレームプールの確保
  *
- * PARAMETERS:          Name            RW  Usage
- * ts_com_msg_t*        ps_rx_msg       RW  メッセージ
- * uint8_t*             pu8_key         R   共通鍵
+ * PARAMETERS:      Name            RW  Usage
  *
  * RETURNS:
- *   ts_u8_array_t*:正常終了時はプレーンテキスト、異常時はNULL
  *
  * NOTES:
- * None.
+ * 各フレームに最大メッセージサイズのバッファを確保する。確保済みのフレームは
+ * そのまま利用し、確保出来なかったフレームは受信時に利用しない。
  ******************************************************************************/
-static ts_u8_array_t* ps_msg_decryption(ts_com_msg_t* ps_rx_msg, uint8_t* pu8_key) {
-    //==========================================================================
-    // 初期処理
-    //==========================================================================
-    //--------------------------------------------------------------------------
-    // 入力チェック
-    //--------------------------------------------------------------------------
-    // サイズチェック
-    const size_t t_min_size = (MSG_SIZE_HEADER + MSG_SIZE_CIPHER_HEADER + MSG_SIZE_FOOTER);
-    if (ps_rx_msg->u16_length <= t_min_size) {
-        return NULL;
+static void v_msg_rx_frame_alloc() {
+    ts_msg_rx_frame_t* ps_frame = s_msg_deamon_sts.s_rx_frame;
+    for (uint8_t u8_idx = 0; u8_idx < COM_MSG_RX_FRAME_COUNT; u8_idx++) {
+        if (ps_frame[u8_idx].pu8_buff != NULL) {
+            continue;
+        }
+        ps_frame[u8_idx].b_used   = false;
+        ps_frame[u8_idx].pu8_buff = pv_mem_calloc(s_msg_ctrl_cfg.u32_max_length);
+        ps_frame[u8_idx].s_data.b_clone    = false;
+        ps_frame[u8_idx].s_data.t_size     = 0;
+        ps_frame[u8_idx].s_data.pu8_values = ps_frame[u8_idx].pu8_buff;
     }
+}
 
-    //--------------------------------------------------------------------------
-    // 変数宣言
-    //--------------------------------------------------------------------------
-    // キーセット
-    ts_crypto_keyset_t* ps_keyset = NULL;
-    // 認証タグ
-    ts_u8_array_t* ps_auth_tag = NULL;
-    // 暗号データ
-    ts_u8_array_t* ps_cipher = NULL;
-    // 復号データ
-    ts_u8_array_t* ps_plane  = NULL;
-
-    //==========================================================================
-    // 主処理
-    //==========================================================================
-    do {
-        //----------------------------------------------------------------------
-        // 復号処理
-        //----------------------------------------------------------------------
-        // キー情報の生成
-        ps_keyset = ps_crypto_create_keyset();
-        if (ps_keyset == NULL) {
-            break;
-        }
-        // 共通鍵
-        ps_keyset->ps_key = ps_mdl_create_u8_array(pu8_key, COM_MSG_SIZE_CIPHER_KEY);
-        if (ps_keyset->ps_key == NULL) {
-            break;
-        }
-        // 初期ベクトル
-        ts_u8_array_t* ps_data = ps_rx_msg->ps_data;
-        uint8_t* pu8_data = ps_data->pu8_values;
-        ts_msg_edit_iv_t s_edit_iv;
-        s_edit_iv.u32_seq_no = ps_rx_msg->u32_seq_no;
-        memcpy(s_edit_iv.u8_iv, &pu8_data[MSG_SIZE_CIPHER_TAG], MSG_SIZE_CIPHER_IV);
-        ps_keyset->ps_key_iv = ps_mdl_create_u8_array((uint8_t*)&s_edit_iv, IV_BYTES);
-        if (ps_keyset->ps_key_iv == NULL) {
-            break;
-        }
-        // ナンス
-        ps_keyset->ps_nonce    = NULL;
-        // 認証タグ初期ベクトル
-        ps_keyset->ps_auth_iv  = ps_mdl_empty_u8_array(MSG_SIZE_CIPHER_TAG);
-        if (ps_keyset->ps_auth_iv == NULL) {
-            break;
-        }
-        // 認証タグ
-        ps_auth_tag = ps_mdl_empty_u8_array(MSG_SIZE_CIPHER_TAG);
-        if (ps_auth_tag == NULL) {
-            break;
-        }
-        uint8_t* pu8_auth_tag = ps_auth_tag->pu8_values;
-        memcpy(pu8_auth_tag, pu8_data, MSG_SIZE_CIPHER_TAG);
-        // 暗号の取得
-        uint32_t u32_data_len = ps_data->t_size - MSG_SIZE_CIPHER_HEADER;
-        ps_cipher = ps_mdl_create_u8_array(&pu8_data[MSG_SIZE_CIPHER_HEADER], u32_data_len);
-        if (ps_cipher == NULL) {
-            break;
-        }
-        // 復号処理(AES GCMモード)
-        ps_plane = ps_crypto_aes_gcm_dec(ps_keyset, ps_cipher, ps_auth_tag);
-        if (ps_plane == NULL) {
-            break;
-        }
-        // 認証タグの検証
-        if (memcmp(ps_auth_tag->pu8_values, pu8_data, MSG_SIZE_CIPHER_TAG) != 0) {
-            sts_mdl_delete_u8_array(ps_plane);
-            ps_plane = NULL;
+/*******************************************************************************
+ *
+ * NAME: ps_msg_rx_frame_take
+ *
+ * DESCRIPTION:受信フレームの取得
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *
+ * RETURNS:
+ *   ts_msg_rx_frame_t*:受信フレーム（NULL:空き無し）
+ *
+ * NOTES:
+ * 本文のビューはバッファの先頭を参照した状態で返す。
+ ******************************************************************************/
+static ts_msg_rx_frame_t* ps_msg_rx_frame_take() {
+    ts_msg_rx_frame_t* ps_frame = s_msg_deamon_sts.s_rx_frame;
+    ts_msg_rx_frame_t* ps_result = NULL;
+    taskENTER_CRITICAL(&s_rx_frame_spinlock);
+    for (uint8_t u8_idx = 0; u8_idx < COM_MSG_RX_FRAME_COUNT; u8_idx++) {
+        if (!ps_frame[u8_idx].b_used && ps_frame[u8_idx].pu8_buff != NULL) {
+            ps_frame[u8_idx].b_used = true;
+            ps_result = &ps_frame[u8_idx];
             break;
         }
-#ifdef COM_BLE_MSG_DEBUG
-        do {
-            char c_key_str[(COM_MSG_SIZE_CIPHER_KEY * 2) + 1];
-            v_vutil_u8_to_hex_string(pu8_key, COM_MSG_SIZE_CIPHER_KEY, c_key_str);
-            ESP_LOGW(LOG_TAG, "%s L#%d key=%s", __func__, __LINE__, c_key_str);
-            char c_cipher_str[(ps_cipher->t_size * 2) + 1];
-            v_vutil_u8_to_hex_string(ps_cipher->pu8_values, ps_cipher->t_size, c_cipher_str);
-            ESP_LOGW(LOG_TAG, "%s L#%d cipher=%s", __func__, __LINE__, c_cipher_str);
-            char c_plane_str[(ps_plane->t_size * 2) + 1];
-            v_vutil_u8_to_hex_string(ps_plane->pu8_values, ps_plane->t_size, c_plane_str);
-            ESP_LOGW(LOG_TAG, "%s L#%d plane=%s", __func__, __LINE__, c_plane_str);
-            char c_tag_str[(ps_auth_tag->t_size * 2) + 1];
-            v_vutil_u8_to_hex_string(ps_auth_tag->pu8_values, ps_auth_tag->t_size, c_tag_str);
-            ESP_LOGW(LOG_TAG, "%s L#%d tagA=%s", __func__, __LINE__, c_tag_str);
-            v_vutil_u8_to_hex_string(pu8_data, ps_auth_tag->t_size, c_tag_str);
-            ESP_LOGW(LOG_TAG, "%s L#%d tagB=%s", __func__, __LINE__, c_tag_str);
-        } while(false);
-#endif
-    } while(false);
-
-    //==========================================================================
-    // 後処理
-    //==========================================================================
-    // 暗号の解放
-    sts_mdl_delete_u8_array(ps_cipher);
-    // 認証タグ
-    sts_mdl_delete_u8_array(ps_auth_tag);
-    // キーの解放
-    sts_crypto_delete_keyset(ps_keyset);
+    }
+    taskEXIT_CRITICAL(&s_rx_frame_spinlock);
+    if (ps_result != NULL) {
+        ps_result->s_data.t_size     = 0;
+        ps_result->s_data.pu8_values = ps_result->pu8_buff;
+    }
+    return ps_result;
+}
 
-    // 結果を返信
-    return ps_plane;
+/*******************************************************************************
+ *
+ * NAME: v_msg_rx_frame_give
+ *
+ * DESCRIPTION:受信フレームの返却
+ *
+ * PARAMETERS:          Name        RW  Usage
+ * ts_msg_rx_frame_t*   ps_frame    RW  受信フレーム
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * 復号済みの本文が残らない様にバッファをクリアしてから返却する。
+ ******************************************************************************/
+static void v_msg_rx_frame_give(ts_msg_rx_frame_t* ps_frame) {
+    // 本文のクリア
+    memset(ps_frame->s_data.pu8_values, 0x00, ps_frame->s_data.t_size);
+    ps_frame->s_data.t_size     = 0;
+    ps_frame->s_data.pu8_values = ps_frame->pu8_buff;
+    ps_frame->s_msg.ps_data     = NULL;
+    // 返却
+    taskENTER_CRITICAL(&s_rx_frame_spinlock);
+    ps_frame->b_used = false;
+    taskEXIT_CRITICAL(&s_rx_frame_spinlock);
 }
 
 /*******************************************************************************
  *
- * NAME: e_edit_rx_header
+ * NAME: ps_msg_rx_frame_of_data
  *
- * DESCRIPTION:BLE edit Rx message header
+ * DESCRIPTION:本文を保持する受信フレームの取得
  *
- * PARAMETERS:                  Name        RW  Usage
- * ts_com_msg_t*                ps_rx_msg   W   編集対象のメッセージ
- * ts_com_ble_gatt_rx_data_t*   ps_rx_data  R   受信データ
+ * PARAMETERS:      Name        RW  Usage
+ * ts_u8_array_t*   ps_data     R   本文
  *
  * RETURNS:
- *   te_com_ble_msg_rcv_sts_t 受信ステータス
+ *   ts_msg_rx_frame_t*:受信フレーム（NULL:受信フレーム以外）
  *
  * NOTES:
- *   単項目チェック（定義ごとのチェックも含む）も実施
  * None.
  ******************************************************************************/
-static te_com_ble_msg_rcv_sts_t e_edit_rx_header(ts_com_msg_t* ps_rx_msg, ts_com_ble_gatt_rx_data_t* ps_rx_data) {
-    //==========================================================================
-    // 受信データサイズチェック
-    //==========================================================================
-    // 受信データ
-    ts_u8_array_t* ps_array = ps_rx_data->ps_array;
-    if (ps_array == NULL) {
-        // 受信データサイズエラー
-        return COM_BLE_MSG_RCV_LENGTH_ERR;
-    }
-    if (ps_array->t_size < MSG_SIZE_HEADER) {
-        // 受信データサイズエラー
-        return COM_BLE_MSG_RCV_LENGTH_ERR;
-    }
-
-    //==========================================================================
-    // 項目編集
-    //==========================================================================
-    // BLEアドレス
-    v_com_ble_addr_cpy(ps_rx_msg->t_rcv_bda, ps_rx_data->t_bda);
-    // 受信ティック（ミリ秒）
-    ps_rx_msg->u32_rcv_tick_ms = xTaskGetTickCountMSec();
-    // 送信デバイスID
-    tu_type_converter_t u_conv;
-    u_conv.u8_values[0] = ps_array->pu8_values[MSG_POS_DEVICE_ID];
-    u_conv.u8_values[1] = ps_array->pu8_values[MSG_POS_DEVICE_ID + 1];
-    u_conv.u8_values[2] = ps_array->pu8_values[MSG_POS_DEVICE_ID + 2];
-    u_conv.u8_values[3] = ps_array->pu8_values[MSG_POS_DEVICE_ID + 3];
-    u_conv.u8_values[4] = ps_array->pu8_values[MSG_POS_DEVICE_ID + 4];
-    u_conv.u8_values[5] = ps_array->pu8_values[MSG_POS_DEVICE_ID + 5];
-    u_conv.u8_values[6] = ps_array->pu8_values[MSG_POS_DEVICE_ID + 6];
-    u_conv.u8_values[7] = ps_array->pu8_values[MSG_POS_DEVICE_ID + 7];
-    ps_rx_msg->u64_device_id = u_conv.u64_value;
-    // タイプ編集
-    ps_rx_msg->e_type = ps_array->pu8_values[MSG_POS_TYPE];
-    // メッセージ長
-    u_conv.u8_values[0] = ps_array->pu8_values[MSG_POS_MSG_LEN];
-    u_conv.u8_values[1] = ps_array->pu8_values[MSG_POS_MSG_LEN + 1];
-    ps_rx_msg->u16_length = u_conv.u16_values[0];
-    // シーケンス番号
-    u_conv.u8_values[0] = ps_array->pu8_values[MSG_POS_SEQ_NO];
-    u_conv.u8_values[1] = ps_array->pu8_values[MSG_POS_SEQ_NO + 1];
-    u_conv.u8_values[2] = ps_array->pu8_values[MSG_POS_SEQ_NO + 2];
-    u_conv.u8_values[3] = ps_array->pu8_values[MSG_POS_SEQ_NO + 3];
-    ps_rx_msg->u32_seq_no = u_conv.u32_values[0];
-    // 認証タグサイズ
-    memcpy(ps_rx_msg->u8_auth_tag, &ps_array->pu8_values[MSG_POS_AUTH_TAG], COM_MSG_SIZE_AUTH_TAG);
-
-    //==========================================================================
-    // タイプチェック
-    //==========================================================================
-    if (ps_rx_msg->e_type >= COM_BLE_MSG_TYP_CNT) {
-        // 受信タイプエラー
-        return COM_BLE_MSG_RCV_TYPE_ERR;
-    }
-
-    //==========================================================================
-    // メッセージ長チェック
-    //==========================================================================
-    // メッセージ定義の取得
-    const ts_msg_definition_t* ps_rx_def = &MSG_DEF[ps_rx_msg->e_type];
-    // 最大データ長チェック
-    if (ps_rx_msg->u16_length > s_msg_ctrl_cfg.u32_max_length) {
-        // 受信データサイズエラー
-        return COM_BLE_MSG_RCV_LENGTH_ERR;
-    }
-    // 既定データ長チェック
-    if (ps_rx_def->b_fixed_length) {
-        // 固定長メッセージの場合
-        if (ps_rx_msg->u16_length != ps_rx_def->u16_length) {
-            // 受信データサイズエラー
-            return COM_BLE_MSG_RCV_LENGTH_ERR;
-        }
-    } else {
-        // 可変長メッセージの場合
-        if (ps_rx_msg->u16_length < ps_rx_def->u16_length) {
-            // 可変長メッセージで、最小メッセージ長より短い場合
-            // 受信データサイズエラー
-            return COM_BLE_MSG_RCV_LENGTH_ERR;
+static ts_msg_rx_frame_t* ps_msg_rx_frame_of_data(ts_u8_array_t* ps_data) {
+    ts_msg_rx_frame_t* ps_frame = s_msg_deamon_sts.s_rx_frame;
+    for (uint8_t u8_idx = 0; u8_idx < COM_MSG_RX_FRAME_COUNT; u8_idx++) {
+        if (ps_data == &ps_frame[u8_idx].s_data) {
+            return &ps_frame[u8_idx];
         }
     }
-    // 受信データサイズが既にメッセージ長を超えている場合はエラー
-    if (ps_rx_msg->u16_length < ps_array->t_size) {
-        // 受信データサイズエラー
-        return COM_BLE_MSG_RCV_LENGTH_ERR;
-    }
+    return NULL;
+}
 
-    //==========================================================================
-    // シーケンス番号チェック
-    //==========================================================================
-    // シーケンス番号チェック
-    // 受信通知以外の場合
-    if (ps_rx_def->b_fixed_seq && ps_rx_msg->u32_seq_no != ps_rx_def->u32_seq_no) {
-        // SEQ番号が既定値では無い
-        return COM_BLE_MSG_RCV_SEQ_ERR;
+/*******************************************************************************
+ *
+ * NAME: ps_msg_rx_frame_of_msg
+ *
+ * DESCRIPTION:メッセージを保持する受信フレームの取得
+ *
+ * PARAMETERS:      Name        RW  Usage
+ * ts_com_msg_t*    ps_msg      R   メッセージ
+ *
+ * RETURNS:
+ *   ts_msg_rx_frame_t*:受信フレーム（NULL:受信フレーム以外）
+ *
+ * NOTES:
+ * None.
+ ******************************************************************************/
+static ts_msg_rx_frame_t* ps_msg_rx_frame_of_msg(ts_com_msg_t* ps_msg) {
+    ts_msg_rx_frame_t* ps_frame = s_msg_deamon_sts.s_rx_frame;
+    for (uint8_t u8_idx = 0; u8_idx < COM_MSG_RX_FRAME_COUNT; u8_idx++) {
+        if (ps_msg == &ps_frame[u8_idx].s_msg) {
+            return &ps_frame[u8_idx];
+        }
     }
-
-    //==========================================================================
-    // 結果返信
-    //==========================================================================
-    // 正常終了
-    return COM_BLE_MSG_RCV_NORMAL;
+    return NULL;
 }
 
 /*******************************************************************************
  *
- * NAME: sts_edit_auth_tag
+ * NAME: v_msg_rx_data_skip
  *
- * DESCRIPTION:認証タグの編集処理
+ * DESCRIPTION:本文の先頭の読み飛ばし
  *
  * PARAMETERS:      Name        RW  Usage
- * uint8_t*         pu8_tag     W   認証タグの編集先
- * ts_u8_array_t*   ps_msg      R   メッセージ
+ * ts_u8_array_t*   ps_data     RW  本文
+ * size_t           t_skip      R   読み飛ばすサイズ
  *
  * RETURNS:
- *   esp_err_t 結果ステータス
  *
  * NOTES:
- * None.
+ * 受信フレームの本文はビューの移動のみで、複写しない。
  ******************************************************************************/
-static esp_err_t sts_edit_auth_tag(uint8_t* pu8_tag, ts_u8_array_t* ps_msg) {
-    // メッセージヘッダー
-    uint8_t* pu8_value = ps_msg->pu8_values;
-    // 認証タグの退避
-    uint8_t u8_origin_tag[COM_MSG_SIZE_AUTH_TAG];
-    memcpy(u8_origin_tag, &pu8_value[MSG_POS_AUTH_TAG], COM_MSG_SIZE_AUTH_TAG);
-    // 認証タグの初期化
-    memset(&pu8_value[MSG_POS_AUTH_TAG], COM_MSG_AUTH_CHECK_VALUE, COM_MSG_SIZE_AUTH_TAG);
-    // ハッシュ値の算出
-    esp_err_t sts_val = sts_crypto_sha256(ps_msg, COM_MSG_AUTH_STRETCHING, pu8_tag);
-    // 認証タグを元に戻す
-    memcpy(&pu8_value[MSG_POS_AUTH_TAG], u8_origin_tag, COM_MSG_SIZE_AUTH_TAG);
-    // 結果返信
-    return sts_val;
+static void v_msg_rx_data_skip(ts_u8_array_t* ps_data, size_t t_skip) {
+    ps_data->t_size -= t_skip;
+    if (ps_msg_rx_frame_of_data(ps_data) != NULL) {
+        // 受信フレームはビューを移動
+        ps_data->pu8_values = &ps_data->pu8_values[t_skip];
+    } else {
+        // 動的に確保した本文は先頭に詰める
+        memmove(ps_data->pu8_values, &ps_data->pu8_values[t_skip], ps_data->t_size);
+    }
 }
 
 /*******************************************************************************
@@ -4696,10 +7619,7 @@ static esp_err_t sts_edit_check_code(ts_com_msg_auth_ticket_t* ps_ticket, uint8_
     //==========================================================================
     uint8_t u8_token[COM_MSG_SIZE_TICKET_STS];
     memcpy(u8_token, ps_ticket->u8_rmt_sts_hash, COM_MSG_SIZE_TICKET_STS);
-    uint8_t u8_idx;
-    for (u8_idx = 0; u8_idx < COM_MSG_SIZE_TICKET_STS; u8_idx++) {
-        u8_token[u8_idx] ^= pu8_rand[u8_idx];
-    }
+    v_vutil_xor_into(u8_token, pu8_rand, COM_MSG_SIZE_TICKET_STS);
 
     //==========================================================================
     // 再度ハッシュ関数を通す
@@ -4753,9 +7673,9 @@ static ts_u8_array_t* ps_create_msg_data(te_com_ble_msg_type_t e_type,
         if (ps_ticket->u32_tx_seq_no >= ps_ticket->u32_max_seq_no) {
             return NULL;
         }
-        // チケットを更新
+        // チケットを更新（予約済みのブロック内の場合は書き込み無し）
         ps_ticket->u32_tx_seq_no++;
-        if (s_msg_ctrl_cfg.pf_tkt_cb(COM_BLE_MSG_TICKET_EVT_UPDATE, ps_ticket) != ESP_OK) {
+        if (sts_msg_ticket_tx_update(ps_ticket) != ESP_OK) {
             // チケット初期化
             v_init_ticket(ps_ticket);
             // 結果返信
@@ -4764,6 +7684,16 @@ static ts_u8_array_t* ps_create_msg_data(te_com_ble_msg_type_t e_type,
         // 送信シーケンス番号
         u32_seq_no = ps_ticket->u32_tx_seq_no;
     }
+    // 本文の圧縮（圧縮を合意したセッションのデータと暗号データ）
+    ts_u8_array_t* ps_packed = NULL;
+    if (ps_ticket != NULL && ps_ticket->b_compress &&
+        (e_type == COM_BLE_MSG_TYP_DATA || e_type == COM_BLE_MSG_TYP_CIPHERTEXT)) {
+        ps_packed = ps_msg_compress(ps_data);
+        if (ps_packed == NULL) {
+            return NULL;
+        }
+        ps_data = ps_packed;
+    }
 
     //==========================================================================
     // メッセージ生成
@@ -4796,6 +7726,17 @@ static ts_u8_array_t* ps_create_msg_data(te_com_ble_msg_type_t e_type,
         // メッセージ長
         u32_msg_len = MSG_SIZE_HEADER + u32_body_len + MSG_SIZE_FOOTER;
     }
+    // 認証モード拡張判定（ペアリング要求と応答）
+    if ((e_type == COM_BLE_MSG_TYP_PAIRING_REQ || e_type == COM_BLE_MSG_TYP_PAIRING_RSP) &&
+        s_msg_ctrl_sts.s_pairing.b_auth_ext) {
+        u32_body_len += MSG_SIZE_AUTH_MODE;
+        u32_msg_len  += MSG_SIZE_AUTH_MODE;
+        // 送信ウィンドウ拡張判定
+        if (s_msg_ctrl_sts.s_pairing.b_win_ext) {
+            u32_body_len += MSG_SIZE_TX_WINDOW;
+            u32_msg_len  += MSG_SIZE_TX_WINDOW;
+        }
+    }
 #ifdef COM_BLE_MSG_DEBUG
     ESP_LOGW(LOG_TAG, "%s L#%d own_id       = %llu", __func__, __LINE__, s_msg_ctrl_cfg.u64_device_id);
     ESP_LOGW(LOG_TAG, "%s L#%d MSG Type     = %d", __func__, __LINE__, e_type);
@@ -4806,6 +7747,7 @@ static ts_u8_array_t* ps_create_msg_data(te_com_ble_msg_type_t e_type,
     // メッセージ長チェック
     //--------------------------------------------------------------------------
     if (u32_msg_len > s_msg_ctrl_cfg.u32_max_length) {
+        sts_mdl_delete_u8_array(ps_packed);
         return NULL;
     }
 
@@ -4814,6 +7756,7 @@ static ts_u8_array_t* ps_create_msg_data(te_com_ble_msg_type_t e_type,
     //--------------------------------------------------------------------------
     ts_u8_array_t* ps_msg = ps_mdl_empty_u8_array(u32_msg_len);
     if (ps_msg == NULL) {
+        sts_mdl_delete_u8_array(ps_packed);
         return NULL;
     }
 
@@ -4895,6 +7838,16 @@ static ts_u8_array_t* ps_create_msg_data(te_com_ble_msg_type_t e_type,
         }
         // 公開鍵
         memcpy(&pu8_values[MSG_POS_BODY], &ps_x25519_ctx->u8_cli_public_key[4], CRYPTO_X25519_CLIENT_PUBLIC_KEY_SIZE - 4);
+        // 提案する認証モードと暗号スイート
+        if (ps_pairing->b_auth_ext) {
+            pu8_values[MSG_POS_BODY + CRYPTO_X25519_KEY_SIZE] = MSG_EXT_VALUE(ps_pairing->e_auth_mode, ps_pairing->e_cipher_suite);
+        }
+        // 提案する送信ウィンドウサイズと圧縮、コンテンツ種別
+        if (ps_pairing->b_auth_ext && ps_pairing->b_win_ext) {
+            pu8_values[MSG_POS_BODY + CRYPTO_X25519_KEY_SIZE + MSG_SIZE_AUTH_MODE] =
+                MSG_EXT_TX_WINDOW(ps_pairing->u8_tx_window) |
+                (ps_pairing->b_compress ? MSG_EXT_COMPRESS : 0x00) | (ps_pairing->b_content ? MSG_EXT_CONTENT : 0x00);
+        }
         break;
     case COM_BLE_MSG_TYP_PAIRING_RSP:
         // ペアリング応答
@@ -4905,6 +7858,16 @@ static ts_u8_array_t* ps_create_msg_data(te_com_ble_msg_type_t e_type,
         }
         // 公開鍵
         memcpy(&pu8_values[MSG_POS_BODY], &ps_x25519_ctx->u8_svr_public_key[1], CRYPTO_X25519_SERVER_PUBLIC_KEY_SIZE - 1);
+        // 合意した認証モードと暗号スイート
+        if (ps_pairing->b_auth_ext) {
+            pu8_values[MSG_POS_BODY + CRYPTO_X25519_KEY_SIZE] = MSG_EXT_VALUE(ps_pairing->e_auth_mode, ps_pairing->e_cipher_suite);
+        }
+        // 合意した送信ウィンドウサイズと圧縮、コンテンツ種別
+        if (ps_pairing->b_auth_ext && ps_pairing->b_win_ext) {
+            pu8_values[MSG_POS_BODY + CRYPTO_X25519_KEY_SIZE + MSG_SIZE_AUTH_MODE] =
+                MSG_EXT_TX_WINDOW(ps_pairing->u8_tx_window) |
+                (ps_pairing->b_compress ? MSG_EXT_COMPRESS : 0x00) | (ps_pairing->b_content ? MSG_EXT_CONTENT : 0x00);
+        }
         break;
     case COM_BLE_MSG_TYP_DIGEST_MATCH:
         // ダイジェスト一致
@@ -4927,7 +7890,7 @@ static ts_u8_array_t* ps_create_msg_data(te_com_ble_msg_type_t e_type,
         // 本文：最大送信SEQ番号
         ps_digest_match->u32_max_seq_no = ps_pairing->u32_max_seq_no;
         // ステータスハッシュ以降を暗号化
-        sts_val = sts_msg_encryption(ps_msg, MSG_SIZE_DIGEST_MATCH_DATA, ps_pairing->u8_com_key);
+        sts_val = sts_msg_encryption(ps_msg, MSG_SIZE_DIGEST_MATCH_DATA, ps_pairing->u8_com_key, COM_BLE_MSG_CIPHER_AES_GCM);
         break;
     case COM_BLE_MSG_TYP_DIGEST_ERR:
         // ダイジェスト不一致
@@ -4972,11 +7935,13 @@ static ts_u8_array_t* ps_create_msg_data(te_com_ble_msg_type_t e_type,
             break;
         }
         // 本文の暗号化
-        sts_val = sts_msg_encryption(ps_msg, u32_data_len, ps_ticket->u8_enc_key);
+        sts_val = sts_msg_encryption(ps_msg, u32_data_len, ps_ticket->u8_enc_key, ps_ticket->e_cipher_suite);
         break;
     default:
         break;
     }
+    // 圧縮形式の本文の解放
+    sts_mdl_delete_u8_array(ps_packed);
     // エラー判定
     if (sts_val != ESP_OK) {
         // メッセージクリア
@@ -5017,6 +7982,11 @@ static void v_init_ticket(ts_com_msg_auth_ticket_t* ps_ticket) {
     ps_ticket->u32_max_seq_no = 0;      // 最大シーケンス番号
     ps_ticket->u32_tx_seq_no  = 0;      // 送信シーケンス番号
     ps_ticket->u32_rx_seq_no  = 0;      // 受信シーケンス番号
+    ps_ticket->e_auth_mode    = COM_BLE_MSG_AUTH_HASH;  // メッセージ認証モード
+    ps_ticket->e_cipher_suite = COM_BLE_MSG_CIPHER_AES_GCM; // 暗号スイート
+    ps_ticket->u8_tx_window   = 1;      // 送信ウィンドウサイズ
+    ps_ticket->b_compress     = false;  // 本文の圧縮の有無
+    ps_ticket->b_content      = false;  // 暗号文のコンテンツ種別の有無
 }
 
 /*******************************************************************************
@@ -5036,6 +8006,15 @@ static void v_init_ticket(ts_com_msg_auth_ticket_t* ps_ticket) {
  * None.
  ******************************************************************************/
 static esp_err_t sts_create_ticket(ts_transaction_info_t* ps_tran, ts_pairing_info_t* ps_pairing) {
+    // 他のデバイスのチケットはチケットキャッシュに退避し、同じデバイスの古いチケットは破棄
+    if (s_msg_ctrl_sts.s_rmt_ticket.u64_rmt_device_id != ps_tran->u64_device_id) {
+        esp_err_t sts_park = sts_msg_ticket_cache_park();
+        if (sts_park != ESP_OK) {
+            return sts_park;
+        }
+    }
+    v_msg_ticket_persist_reset(&s_msg_ctrl_sts.s_tkt_persist, NULL);
+    v_msg_ticket_cache_remove(ps_tran->u64_device_id);
     // チケット作成
     ts_com_msg_auth_ticket_t* ps_ticket = &s_msg_ctrl_sts.s_rmt_ticket;
     // 自デバイスID
@@ -5054,6 +8033,16 @@ static esp_err_t sts_create_ticket(ts_transaction_info_t* ps_tran, ts_pairing_in
     ps_ticket->u32_tx_seq_no = 0;
     // 受信シーケンス番号
     ps_ticket->u32_rx_seq_no = 0;
+    // メッセージ認証モード
+    ps_ticket->e_auth_mode = ps_pairing->e_auth_mode;
+    // 暗号スイート
+    ps_ticket->e_cipher_suite = ps_pairing->e_cipher_suite;
+    // 送信ウィンドウサイズ
+    ps_ticket->u8_tx_window = ps_pairing->u8_tx_window;
+    // 本文の圧縮の有無
+    ps_ticket->b_compress = ps_pairing->b_compress;
+    // 暗号文のコンテンツ種別の有無
+    ps_ticket->b_content = ps_pairing->b_content;
 #ifdef COM_BLE_MSG_DEBUG
     char sts_txt[(COM_MSG_SIZE_TICKET_STS * 2) + 1];
     v_vutil_u8_to_hex_string(ps_ticket->u8_own_sts, COM_MSG_SIZE_TICKET_STS, sts_txt);
@@ -5067,7 +8056,10 @@ static esp_err_t sts_create_ticket(ts_transaction_info_t* ps_tran, ts_pairing_in
     if (sts_val != ESP_OK) {
         // チケット初期化
         v_init_ticket(ps_ticket);
+        return sts_val;
     }
+    // チケット更新の遅延状態を初期化
+    v_msg_ticket_persist_reset(&s_msg_ctrl_sts.s_tkt_persist, ps_ticket);
     return sts_val;
 }
 
@@ -5082,10 +8074,14 @@ static esp_err_t sts_create_ticket(ts_transaction_info_t* ps_tran, ts_pairing_in
  * ts_com_msg_auth_ticket_t*    ps_cache_ticket W   キャッシュ用チケット
  *
  * RETURNS:
- *   ts_com_msg_auth_ticket_t* 読み込んだチケット
+ *   ts_com_msg_auth_ticket_t* 読み込んだチケット（NULL:読み込みエラー、又はチケットキャッシュの追い出しエラー）
  *
  * NOTES:
- * None.
+ * リモートデバイスチケット、チケットキャッシュの順に検索し、
+ * 何れにも無い場合のみチケットアクセスコールバック関数で読み込む。
+ * キャッシュ用チケットにリモートデバイスチケットを指定した場合は、
+ * 直前のリモートデバイスチケットをチケットキャッシュに退避して入れ替える。
+ * それ以外の場合はチケットキャッシュのエントリを返す事が有る。
  ******************************************************************************/
 static ts_com_msg_auth_ticket_t* ps_read_ticket(uint64_t u64_device_id,
                                                  ts_com_msg_auth_ticket_t* ps_cache_ticket) {
@@ -5093,13 +8089,72 @@ static ts_com_msg_auth_ticket_t* ps_read_ticket(uint64_t u64_device_id,
     if (s_msg_ctrl_cfg.u64_device_id == u64_device_id) {
         return NULL;
     }
-    // チケットキャッシュの判定
+    // リモートデバイスチケットの判定
     ts_com_msg_auth_ticket_t* ps_ticket = &s_msg_ctrl_sts.s_rmt_ticket;
     if (ps_ticket->u64_rmt_device_id == u64_device_id) {
         return ps_ticket;
     }
-    // チケットキャッシュと一致しない場合
-    ps_ticket = ps_cache_ticket;
+    // チケットキャッシュの検索
+    ts_msg_ticket_entry_t* ps_entry = ps_msg_ticket_cache_find(u64_device_id);
+
+    //==========================================================================
+    // リモートデバイスチケット以外への読み込み
+    //==========================================================================
+    if (ps_cache_ticket != ps_ticket) {
+        // チケットキャッシュに有る場合
+        if (ps_entry != NULL) {
+            return &ps_entry->s_ticket;
+        }
+        // チケット読み込み
+        ps_cache_ticket->u64_own_device_id = s_msg_ctrl_cfg.u64_device_id;
+        ps_cache_ticket->u64_rmt_device_id = u64_device_id;
+        if (s_msg_ctrl_cfg.pf_tkt_cb(COM_BLE_MSG_TICKET_EVT_READ, ps_cache_ticket) != ESP_OK) {
+            // チケット初期化
+            v_init_ticket(ps_cache_ticket);
+            // 読み込みエラー
+            return NULL;
+        }
+        // チケットキャッシュに追加
+        ps_entry = ps_msg_ticket_cache_alloc();
+        if (ps_entry == NULL) {
+            // チケット初期化
+            v_init_ticket(ps_cache_ticket);
+            // 追い出しエラー
+            return NULL;
+        }
+        ps_entry->s_ticket = *ps_cache_ticket;
+        v_msg_ticket_persist_reset(&ps_entry->s_persist, &ps_entry->s_ticket);
+        v_init_ticket(ps_cache_ticket);
+        // 結果返信
+        return &ps_entry->s_ticket;
+    }
+
+    //==========================================================================
+    // リモートデバイスチケットの入れ替え
+    //==========================================================================
+    if (ps_entry != NULL) {
+        // チケットキャッシュから取り出し、直前のリモートデバイスチケットを退避
+        ts_msg_ticket_entry_t s_hit = *ps_entry;
+        ps_entry->s_persist.b_valid = false;
+        v_init_ticket(&ps_entry->s_ticket);
+        if (sts_msg_ticket_cache_park() != ESP_OK) {
+            // 取り出したエントリを戻す
+            *ps_entry = s_hit;
+            v_init_ticket(&s_hit.s_ticket);
+            // 退避エラー
+            return NULL;
+        }
+        *ps_ticket = s_hit.s_ticket;
+        s_msg_ctrl_sts.s_tkt_persist = s_hit.s_persist;
+        v_init_ticket(&s_hit.s_ticket);
+        // 結果返信
+        return ps_ticket;
+    }
+    // 直前のリモートデバイスチケットを退避
+    if (sts_msg_ticket_cache_park() != ESP_OK) {
+        // 退避エラー
+        return NULL;
+    }
     // 自デバイスID
     ps_ticket->u64_own_device_id = s_msg_ctrl_cfg.u64_device_id;
     // 相手デバイスID
@@ -5111,6 +8166,8 @@ static ts_com_msg_auth_ticket_t* ps_read_ticket(uint64_t u64_device_id,
         // 読み込みエラー
         return NULL;
     }
+    // チケット更新の遅延状態を初期化
+    v_msg_ticket_persist_reset(&s_msg_ctrl_sts.s_tkt_persist, ps_ticket);
     // 結果返信
     return ps_ticket;
 }
@@ -5596,12 +8653,18 @@ static void v_ble_rx_through_cli(size_t t_len) {
  * None.
  ******************************************************************************/
 static esp_err_t sts_ble_tx_msg_svr(ts_u8_array_t* ps_msg) {
+#ifdef DBG_TRACE_ENABLED
+    // トレース用のシーケンス番号
+    tu_type_converter_t u_conv;
+    memcpy(u_conv.u8_values, &ps_msg->pu8_values[MSG_POS_SEQ_NO], sizeof(uint32_t));
+    DBG_TRACE_BEGIN(DBG_TRACE_EVT_MSG_TX, u_conv.u32_values[0]);
+#endif
     //==========================================================================
     // 認証タグ編集
     //==========================================================================
     // 認証タグの生成
     uint8_t u8_auth_tag[COM_MSG_SIZE_AUTH_TAG];
-    esp_err_t sts_val = sts_edit_auth_tag(u8_auth_tag, ps_msg);
+    esp_err_t sts_val = sts_edit_auth_tag(u8_auth_tag, ps_msg, s_msg_ctrl_sts.u64_rmt_device_id);
     if (sts_val != ESP_OK) {
         return sts_val;
     }
@@ -5628,6 +8691,7 @@ static esp_err_t sts_ble_tx_msg_svr(ts_u8_array_t* ps_msg) {
     // 送信履歴の更新
     //==========================================================================
     v_upd_tx_history(ps_msg);
+    DBG_TRACE_END_EVT(DBG_TRACE_EVT_MSG_TX, u_conv.u32_values[0], ps_msg->t_size);
 
     // 結果返信
     return sts_val;
@@ -5649,12 +8713,18 @@ static esp_err_t sts_ble_tx_msg_svr(ts_u8_array_t* ps_msg) {
  * None.
  ******************************************************************************/
 static esp_err_t sts_ble_tx_msg_cli(ts_u8_array_t* ps_msg) {
+#ifdef DBG_TRACE_ENABLED
+    // トレース用のシーケンス番号
+    tu_type_converter_t u_conv;
+    memcpy(u_conv.u8_values, &ps_msg->pu8_values[MSG_POS_SEQ_NO], sizeof(uint32_t));
+    DBG_TRACE_BEGIN(DBG_TRACE_EVT_MSG_TX, u_conv.u32_values[0]);
+#endif
     //==========================================================================
     // 認証タグ編集
     //==========================================================================
     // 認証タグの生成
     uint8_t u8_auth_tag[COM_MSG_SIZE_AUTH_TAG];
-    esp_err_t sts_val = sts_edit_auth_tag(u8_auth_tag, ps_msg);
+    esp_err_t sts_val = sts_edit_auth_tag(u8_auth_tag, ps_msg, s_msg_ctrl_sts.u64_rmt_device_id);
     if (sts_val != ESP_OK) {
         return sts_val;
     }
@@ -5684,6 +8754,7 @@ static esp_err_t sts_ble_tx_msg_cli(ts_u8_array_t* ps_msg) {
     // 送信履歴の更新
     //==========================================================================
     v_upd_tx_history(ps_msg);
+    DBG_TRACE_END_EVT(DBG_TRACE_EVT_MSG_TX, u_conv.u32_values[0], ps_msg->t_size);
 
     // 結果返信
     return sts_val;
@@ -0,0 +1,902 @@
+/*******************************************************************************
+ *
+ * COMPONENT:Nano Toolkit Framework
+ *
+ * MODULE :BLE message stream function source file
+ *
+ * CREATED:2024/11/24 10:00:00
+ * AUTHOR :Kakuheiki.Nakanohito
+ *
+ * DESCRIPTION:セキュアメッセージング（暗号メッセージ）上のバルク転送ストリーム
+ *   ストリームのコンテンツ種別の暗号メッセージで、平文の先頭にストリームヘッダーを付与した
+ *   フレームを送受信する（ペアリング時にコンテンツ種別を合意している事）。
+ *   受信フレームはメッセージの受信フィルターでコンテンツ種別により受信キューから分離し、
+ *   確認応答は受信デーモンタスク内で、その他のフレームはストリーム受信デーモンタスクで処理する。
+ *
+ *   フレーム形式（リトルエンディアン）
+ *     [0]フレーム種別 [1]ストリームID [2-5]オフセット [6-]ペイロード
+ *     OPEN :ペイロードは総サイズ（4byte、0:不明）
+ *     DATA :ペイロードはオフセット位置のデータ
+ *     ACK  :オフセットは受信済みサイズ、ペイロードはクレジット（2byte）
+ *     CLOSE:オフセットは総送信サイズ
+ *     ABORT:ペイロード無し
+ *
+ * CHANGE HISTORY:
+ *
+ * LAST MODIFIED BY:
+ *
+ *******************************************************************************
+ *
+ * Copyright (c) 2024 Kakuheiki.Nakanohito
+ * Released under the MIT license
+ * https://opensource.org/licenses/mit-license.php
+ *
+ ******************************************************************************/
+/******************************************************************************/
+/***      Include files                                                     ***/
+/******************************************************************************/
+#include <ntfw_ble_stream.h>
+
+#include <string.h>
+#include <esp_log.h>
+#include <ntfw_com_mem_alloc.h>
+#include <ntfw_com_value_util.h>
+
+/******************************************************************************/
+/***      Macro Definitions                                                 ***/
+/******************************************************************************/
+/** ログ接頭辞 */
+#define LOG_TAG "COM_BLE_STREAM"
+
+/** uint32_t max value */
+#define U32_MAX             (0xffffffff)
+
+/** frame position */
+#define STREAM_POS_TYPE     (0)
+#define STREAM_POS_ID       (1)
+#define STREAM_POS_OFFSET   (2)
+#define STREAM_POS_PAYLOAD  (6)
+/** frame header size */
+#define STREAM_SIZE_HEADER  (STREAM_POS_PAYLOAD)
+/** open payload size */
+#define STREAM_SIZE_OPEN    (4)
+/** ack payload size */
+#define STREAM_SIZE_ACK     (2)
+
+/******************************************************************************/
+/***      Type Definitions                                                  ***/
+/******************************************************************************/
+/**
+ * フレーム種別
+ */
+typedef enum {
+    STREAM_FRM_OPEN = 0x01,                 // オープン
+    STREAM_FRM_DATA,                        // データ
+    STREAM_FRM_ACK,                         // 確認応答
+    STREAM_FRM_CLOSE,                       // クローズ
+    STREAM_FRM_ABORT,                       // 中断
+} te_stream_frame_t;
+
+/**
+ * 送信ストリームステータス
+ */
+typedef struct {
+    bool b_open;                            // オープン済みフラグ
+    uint64_t u64_device_id;                 // 送信先デバイスID
+    uint8_t u8_stream_id;                   // ストリームID
+    uint32_t u32_size;                      // 総サイズ（0:不明）
+    uint32_t u32_offset;                    // 送信済みサイズ
+    uint32_t u32_chunk;                     // フラグメントのデータサイズ
+    bool b_ack_rcv;                         // 確認応答の受信フラグ
+    uint32_t u32_acked;                     // 確認応答済みサイズ
+    uint16_t u16_credit;                    // クレジット（フラグメント数）
+} ts_stream_tx_sts_t;
+
+/**
+ * 受信ストリームステータス
+ */
+typedef struct {
+    bool b_open;                            // オープン済みフラグ
+    uint64_t u64_device_id;                 // 送信元デバイスID
+    uint8_t u8_stream_id;                   // ストリームID
+    uint32_t u32_size;                      // 総サイズ（0:不明）
+    uint32_t u32_offset;                    // 受信済みサイズ
+    uint16_t u16_unacked;                   // 確認応答していないフラグメント数
+} ts_stream_rx_sts_t;
+
+/******************************************************************************/
+/***      Local Function Prototypes                                         ***/
+/******************************************************************************/
+/** stream receive filter */
+static bool b_stream_rx_filter(ts_com_msg_t* ps_msg);
+/** stream receive daemon task */
+static void v_stream_rx_daemon_task(void* pv_parameters);
+/** stream receive frame */
+static void v_stream_rx_frame(ts_com_msg_t* ps_msg);
+/** transmit frame */
+static esp_err_t sts_stream_tx_frame(uint64_t u64_device_id,
+                                     te_stream_frame_t e_type,
+                                     uint8_t u8_stream_id,
+                                     uint32_t u32_offset,
+                                     const uint8_t* pu8_payload,
+                                     size_t t_len);
+/** transmit ack */
+static esp_err_t sts_stream_tx_ack();
+/** wait ack */
+static esp_err_t sts_stream_wait_ack(uint32_t u32_in_flight);
+/** read u32 value */
+static uint32_t u32_stream_read_u32(const uint8_t* pu8_src);
+/** write u32 value */
+static void v_stream_write_u32(uint8_t* pu8_dst, uint32_t u32_value);
+/** dummy receive callback */
+static void v_stream_dmy_rx_cb(te_com_stream_evt_t e_evt,
+                               uint64_t u64_device_id,
+                               uint8_t u8_stream_id,
+                               uint32_t u32_offset,
+                               const uint8_t* pu8_data,
+                               size_t t_len);
+
+/******************************************************************************/
+/***      Exported Variables                                                ***/
+/******************************************************************************/
+
+/******************************************************************************/
+/***      Local Variables                                                   ***/
+/******************************************************************************/
+/** 送信ステータスのミューテックス */
+static SemaphoreHandle_t s_mutex_stream = NULL;
+/** 確認応答の受信通知 */
+static SemaphoreHandle_t s_ack_sem = NULL;
+/** ストリーム受信キュー */
+static QueueHandle_t s_rx_queue_handle = NULL;
+/** ストリーム受信デーモンタスク */
+static TaskHandle_t s_rx_deamon_handle = NULL;
+/** 受信コールバック関数 */
+static tf_com_stream_rx_cb_t s_pf_rx_cb = v_stream_dmy_rx_cb;
+/** 送信ストリームステータス */
+static ts_stream_tx_sts_t s_stream_tx_sts = {
+    .b_open        = false,                 // オープン済みフラグ
+    .u64_device_id = 0,                     // 送信先デバイスID
+    .u8_stream_id  = 0,                     // ストリームID
+    .u32_size      = 0,                     // 総サイズ
+    .u32_offset    = 0,                     // 送信済みサイズ
+    .u32_chunk     = 0,                     // フラグメントのデータサイズ
+    .b_ack_rcv     = false,                 // 確認応答の受信フラグ
+    .u32_acked     = 0,                     // 確認応答済みサイズ
+    .u16_credit    = 1,                     // クレジット
+};
+/** 受信ストリームステータス（ストリーム受信デーモンタスクのみが更新） */
+static ts_stream_rx_sts_t s_stream_rx_sts = {
+    .b_open        = false,                 // オープン済みフラグ
+    .u64_device_id = 0,                     // 送信元デバイスID
+    .u8_stream_id  = 0,                     // ストリームID
+    .u32_size      = 0,                     // 総サイズ
+    .u32_offset    = 0,                     // 受信済みサイズ
+    .u16_unacked   = 0,                     // 確認応答していないフラグメント数
+};
+
+/******************************************************************************/
+/***      Exported Functions                                                ***/
+/******************************************************************************/
+
+/*******************************************************************************
+ *
+ * NAME: sts_com_stream_init
+ *
+ * DESCRIPTION:ストリームの初期処理
+ *
+ * PARAMETERS:              Name        RW  Usage
+ * tf_com_stream_rx_cb_t    pf_rx_cb    R   受信コールバック関数（NULL:受信しない）
+ *
+ * RETURNS:
+ *   esp_err_t:結果ステータス
+ *
+ * NOTES:
+ * メッセージサーバー又はクライアントの初期処理後、ペアリング前に呼び出す事。
+ * 暗号メッセージのコンテンツ種別を有効化し、受信フィルターでストリームのフレームを受信キューから分離する。
+ * 受信コールバック関数はストリーム受信デーモンタスクから呼び出される。
+ ******************************************************************************/
+esp_err_t sts_com_stream_init(tf_com_stream_rx_cb_t pf_rx_cb) {
+    //==========================================================================
+    // 同期オブジェクトの生成
+    //==========================================================================
+    if (s_mutex_stream == NULL) {
+        s_mutex_stream = xSemaphoreCreateMutex();
+    }
+    if (s_ack_sem == NULL) {
+        s_ack_sem = xSemaphoreCreateBinary();
+    }
+    if (s_mutex_stream == NULL || s_ack_sem == NULL) {
+        return ESP_ERR_NO_MEM;
+    }
+
+    //==========================================================================
+    // ストリーム受信デーモンタスクの開始
+    //==========================================================================
+    if (s_rx_queue_handle == NULL) {
+        s_rx_queue_handle = xQueueCreate(COM_STREAM_RX_QUEUE_SIZE, sizeof(ts_com_msg_t*));
+    }
+    if (s_rx_queue_handle == NULL) {
+        return ESP_ERR_NO_MEM;
+    }
+    if (s_rx_deamon_handle == NULL) {
+        portBASE_TYPE b_type = xTaskCreatePinnedToCore(v_stream_rx_daemon_task,
+                                                       "stream_rx_deamon_task",
+                                                       COM_STREAM_DEAMON_STACK_DEPTH,
+                                                       (void*)s_rx_queue_handle,
+                                                       COM_STREAM_DEAMON_PRIORITIES,
+                                                       &s_rx_deamon_handle,
+                                                       tskNO_AFFINITY);
+        if (b_type != pdPASS) {
+            return ESP_FAIL;
+        }
+    }
+
+    //==========================================================================
+    // 受信コールバックと受信フィルターの設定
+    //==========================================================================
+    s_pf_rx_cb = (pf_rx_cb != NULL) ? pf_rx_cb : v_stream_dmy_rx_cb;
+    v_com_msg_config_content(true);
+    v_com_msg_config_rx_filter(b_stream_rx_filter);
+
+    // 正常終了
+    return ESP_OK;
+}
+
+/*******************************************************************************
+ *
+ * NAME: sts_com_stream_open
+ *
+ * DESCRIPTION:送信ストリームのオープン
+ *
+ * PARAMETERS:      Name            RW  Usage
+ * uint64_t         u64_device_id   R   送信先デバイスID
+ * uint8_t          u8_stream_id    R   ストリームID
+ * uint32_t         u32_size        R   総サイズ（0:不明）
+ * uint32_t*        pu32_offset     W   書き込みを開始するオフセット
+ *
+ * RETURNS:
+ *   esp_err_t:結果ステータス
+ *
+ * NOTES:
+ * 受信側に同一デバイスの同一ストリームIDの受信途中のストリームが有る場合は、
+ * 受信済みのオフセットから再開する。呼び出し元は*pu32_offsetの位置から書き込む事。
+ * コンテンツ種別を合意していない相手の場合はESP_ERR_NOT_SUPPORTEDを返す。
+ ******************************************************************************/
+esp_err_t sts_com_stream_open(uint64_t u64_device_id,
+                              uint8_t u8_stream_id,
+                              uint32_t u32_size,
+                              uint32_t* pu32_offset) {
+    // 入力チェック
+    if (pu32_offset == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    // 初期処理判定
+    if (s_mutex_stream == NULL) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    // フラグメントのデータサイズ
+    uint32_t u32_max_size = u32_com_msg_max_cipher_size();
+    if (u32_max_size <= STREAM_SIZE_HEADER + STREAM_SIZE_OPEN) {
+        return ESP_ERR_INVALID_SIZE;
+    }
+
+    //==========================================================================
+    // 送信ステータスの初期化
+    //==========================================================================
+    if (xSemaphoreTake(s_mutex_stream, portMAX_DELAY) != pdTRUE) {
+        return ESP_ERR_TIMEOUT;
+    }
+    ts_stream_tx_sts_t* ps_tx = &s_stream_tx_sts;
+    ps_tx->b_open        = false;
+    ps_tx->u64_device_id = u64_device_id;
+    ps_tx->u8_stream_id  = u8_stream_id;
+    ps_tx->u32_size      = u32_size;
+    ps_tx->u32_offset    = 0;
+    ps_tx->u32_chunk     = u32_max_size - STREAM_SIZE_HEADER;
+    ps_tx->b_ack_rcv     = false;
+    ps_tx->u32_acked     = 0;
+    ps_tx->u16_credit    = 1;
+    xSemaphoreGive(s_mutex_stream);
+    // 過去の受信通知をクリア
+    xSemaphoreTake(s_ack_sem, 0);
+
+    //==========================================================================
+    // オープンの送信と確認応答待ち
+    //==========================================================================
+    uint8_t u8_payload[STREAM_SIZE_OPEN];
+    v_stream_write_u32(u8_payload, u32_size);
+    esp_err_t sts_val = sts_stream_tx_frame(u64_device_id, STREAM_FRM_OPEN, u8_stream_id, 0, u8_payload, STREAM_SIZE_OPEN);
+    if (sts_val != ESP_OK) {
+        return sts_val;
+    }
+    // 確認応答の受信のみを待つ
+    sts_val = sts_stream_wait_ack(U32_MAX);
+    if (sts_val != ESP_OK) {
+        return sts_val;
+    }
+
+    //==========================================================================
+    // 再開オフセットの反映
+    //==========================================================================
+    if (xSemaphoreTake(s_mutex_stream, portMAX_DELAY) != pdTRUE) {
+        return ESP_ERR_TIMEOUT;
+    }
+    if (u32_size == 0 || ps_tx->u32_acked <= u32_size) {
+        ps_tx->u32_offset = ps_tx->u32_acked;
+        ps_tx->b_open     = true;
+        *pu32_offset      = ps_tx->u32_offset;
+    } else {
+        sts_val = ESP_ERR_INVALID_RESPONSE;
+    }
+    xSemaphoreGive(s_mutex_stream);
+
+    // 結果返信
+    return sts_val;
+}
+
+/*******************************************************************************
+ *
+ * NAME: sts_com_stream_write
+ *
+ * DESCRIPTION:送信ストリームへの書き込み
+ *
+ * PARAMETERS:      Name            RW  Usage
+ * uint8_t*         pu8_data        R   データ
+ * size_t           t_len           R   データサイズ
+ *
+ * RETURNS:
+ *   esp_err_t:結果ステータス
+ *
+ * NOTES:
+ * フラグメントに分割して送信し、受信側のクレジットを使い切った場合は確認応答を待機する。
+ * 送信エラーやタイムアウトの場合はストリームをクローズするので、再接続後にオープンから再開する事。
+ ******************************************************************************/
+esp_err_t sts_com_stream_write(const uint8_t* pu8_data, size_t t_len) {
+    // 入力チェック
+    if (pu8_data == NULL && t_len > 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    // 初期処理判定
+    if (s_mutex_stream == NULL) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    ts_stream_tx_sts_t* ps_tx = &s_stream_tx_sts;
+
+    //==========================================================================
+    // フラグメント送信
+    // ※送信と確認応答待ちの間は受信フィルターが更新出来る様にミューテックスを解放する
+    //==========================================================================
+    esp_err_t sts_val = ESP_OK;
+    size_t t_pos = 0;
+    do {
+        // 送信ステータスの参照
+        if (xSemaphoreTake(s_mutex_stream, portMAX_DELAY) != pdTRUE) {
+            return ESP_ERR_TIMEOUT;
+        }
+        bool b_open             = ps_tx->b_open;
+        uint64_t u64_device_id  = ps_tx->u64_device_id;
+        uint8_t u8_stream_id    = ps_tx->u8_stream_id;
+        uint32_t u32_offset     = ps_tx->u32_offset;
+        uint32_t u32_chunk      = ps_tx->u32_chunk;
+        uint32_t u32_window     = ps_tx->u16_credit * ps_tx->u32_chunk;
+        bool b_over = (ps_tx->u32_size > 0 && (uint64_t)ps_tx->u32_offset + (t_len - t_pos) > ps_tx->u32_size);
+        xSemaphoreGive(s_mutex_stream);
+        // オープン判定
+        if (!b_open) {
+            return ESP_ERR_INVALID_STATE;
+        }
+        // サイズ判定
+        if (b_over) {
+            return ESP_ERR_INVALID_SIZE;
+        }
+        // 書き込み完了判定
+        if (t_pos >= t_len) {
+            break;
+        }
+        // フラグメントサイズ
+        uint32_t u32_frag = t_len - t_pos;
+        if (u32_frag > u32_chunk) {
+            u32_frag = u32_chunk;
+        }
+        // クレジットの範囲内になるまで確認応答を待機
+        sts_val = sts_stream_wait_ack(u32_window - u32_frag);
+        if (sts_val != ESP_OK) {
+            break;
+        }
+        // データの送信
+        sts_val = sts_stream_tx_frame(u64_device_id, STREAM_FRM_DATA, u8_stream_id,
+                                      u32_offset, &pu8_data[t_pos], u32_frag);
+        if (sts_val != ESP_OK) {
+            break;
+        }
+        // 送信済みサイズの更新
+        if (xSemaphoreTake(s_mutex_stream, portMAX_DELAY) != pdTRUE) {
+            return ESP_ERR_TIMEOUT;
+        }
+        ps_tx->u32_offset = u32_offset + u32_frag;
+        xSemaphoreGive(s_mutex_stream);
+        t_pos += u32_frag;
+    } while (true);
+    // エラー時はクローズ
+    if (sts_val != ESP_OK && xSemaphoreTake(s_mutex_stream, portMAX_DELAY) == pdTRUE) {
+        ps_tx->b_open = false;
+        xSemaphoreGive(s_mutex_stream);
+    }
+
+    // 結果返信
+    return sts_val;
+}
+
+/*******************************************************************************
+ *
+ * NAME: sts_com_stream_close
+ *
+ * DESCRIPTION:送信ストリームのクローズ
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *
+ * RETURNS:
+ *   esp_err_t:結果ステータス
+ *
+ * NOTES:
+ * 全データの確認応答を受信するまで待機する。
+ ******************************************************************************/
+esp_err_t sts_com_stream_close() {
+    // 初期処理判定
+    if (s_mutex_stream == NULL) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    // 送信ステータスの参照とクローズ
+    if (xSemaphoreTake(s_mutex_stream, portMAX_DELAY) != pdTRUE) {
+        return ESP_ERR_TIMEOUT;
+    }
+    ts_stream_tx_sts_t* ps_tx = &s_stream_tx_sts;
+    bool b_open            = ps_tx->b_open;
+    uint64_t u64_device_id = ps_tx->u64_device_id;
+    uint8_t u8_stream_id   = ps_tx->u8_stream_id;
+    uint32_t u32_offset    = ps_tx->u32_offset;
+    bool b_short           = (ps_tx->u32_size > 0 && ps_tx->u32_offset != ps_tx->u32_size);
+    ps_tx->b_open = false;
+    xSemaphoreGive(s_mutex_stream);
+    // オープン判定
+    if (!b_open) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    // サイズ判定
+    if (b_short) {
+        return ESP_ERR_INVALID_SIZE;
+    }
+    // クローズの送信
+    esp_err_t sts_val = sts_stream_tx_frame(u64_device_id, STREAM_FRM_CLOSE, u8_stream_id,
+                                            u32_offset, NULL, 0);
+    if (sts_val != ESP_OK) {
+        return sts_val;
+    }
+    // 全データの確認応答待ち
+    return sts_stream_wait_ack(0);
+}
+
+/*******************************************************************************
+ *
+ * NAME: sts_com_stream_abort
+ *
+ * DESCRIPTION:送信ストリームの中断
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *
+ * RETURNS:
+ *   esp_err_t:結果ステータス
+ *
+ * NOTES:
+ * 受信側の受信途中のストリームも破棄され、以降は再開出来ない。
+ ******************************************************************************/
+esp_err_t sts_com_stream_abort() {
+    // 初期処理判定
+    if (s_mutex_stream == NULL) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    // 送信ステータスの参照とクローズ
+    if (xSemaphoreTake(s_mutex_stream, portMAX_DELAY) != pdTRUE) {
+        return ESP_ERR_TIMEOUT;
+    }
+    ts_stream_tx_sts_t* ps_tx = &s_stream_tx_sts;
+    uint64_t u64_device_id = ps_tx->u64_device_id;
+    uint8_t u8_stream_id   = ps_tx->u8_stream_id;
+    uint32_t u32_offset    = ps_tx->u32_offset;
+    ps_tx->b_open = false;
+    xSemaphoreGive(s_mutex_stream);
+    // 中断の送信
+    return sts_stream_tx_frame(u64_device_id, STREAM_FRM_ABORT, u8_stream_id, u32_offset, NULL, 0);
+}
+
+/******************************************************************************/
+/***      Local Functions                                                   ***/
+/******************************************************************************/
+
+/*******************************************************************************
+ *
+ * NAME: b_stream_rx_filter
+ *
+ * DESCRIPTION:ストリームの受信フィルター
+ *
+ * PARAMETERS:      Name        RW  Usage
+ * ts_com_msg_t*    ps_msg      R   受信した暗号メッセージ（復号済み）
+ *
+ * RETURNS:
+ *   true:ストリームのフレームとして消費
+ *
+ * NOTES:
+ * メッセージの受信デーモンタスクから呼び出される為、送信処理は行わない。
+ * ストリームのコンテンツ種別のメッセージのみを消費し、ヘッダー長に満たないフレームは破棄する。
+ * 確認応答はここで送信ステータスに反映し、その他のフレームはストリーム受信キューに投入する。
+ ******************************************************************************/
+static bool b_stream_rx_filter(ts_com_msg_t* ps_msg) {
+    //==========================================================================
+    // フレーム判定
+    //==========================================================================
+    if (ps_msg->e_content != COM_BLE_MSG_CONTENT_STREAM) {
+        return false;
+    }
+    ts_u8_array_t* ps_data = ps_msg->ps_data;
+    if (ps_data == NULL || ps_data->t_size < STREAM_SIZE_HEADER) {
+        sts_com_msg_delete_data(ps_data);
+        return true;
+    }
+    uint8_t* pu8_frame = ps_data->pu8_values;
+
+    //==========================================================================
+    // 確認応答
+    //==========================================================================
+    if (pu8_frame[STREAM_POS_TYPE] == STREAM_FRM_ACK) {
+        if (ps_data->t_size >= STREAM_SIZE_HEADER + STREAM_SIZE_ACK &&
+            xSemaphoreTake(s_mutex_stream, portMAX_DELAY) == pdTRUE) {
+            ts_stream_tx_sts_t* ps_tx = &s_stream_tx_sts;
+            if (ps_tx->u64_device_id == ps_msg->u64_device_id && ps_tx->u8_stream_id == pu8_frame[STREAM_POS_ID]) {
+                tu_type_converter_t u_conv;
+                u_conv.u8_values[0] = pu8_frame[STREAM_POS_PAYLOAD];
+                u_conv.u8_values[1] = pu8_frame[STREAM_POS_PAYLOAD + 1];
+                ps_tx->u32_acked  = u32_stream_read_u32(&pu8_frame[STREAM_POS_OFFSET]);
+                ps_tx->u16_credit = (u_conv.u16_values[0] > 0) ? u_conv.u16_values[0] : 1;
+                ps_tx->b_ack_rcv  = true;
+            }
+            xSemaphoreGive(s_mutex_stream);
+            // 受信通知
+            xSemaphoreGive(s_ack_sem);
+        }
+        sts_com_msg_delete_data(ps_data);
+        return true;
+    }
+
+    //==========================================================================
+    // その他のフレームはストリーム受信キューに投入
+    //==========================================================================
+    ts_com_msg_t* ps_rx_msg = (ts_com_msg_t*)pv_mem_clone((void*)ps_msg, sizeof(ts_com_msg_t));
+    if (ps_rx_msg == NULL) {
+        sts_com_msg_delete_data(ps_data);
+        return true;
+    }
+    // クレジットの範囲内であれば空きが有るので待たない
+    if (xQueueSendToBack(s_rx_queue_handle, &ps_rx_msg, 0) != pdPASS) {
+        ESP_LOGW(LOG_TAG, "%s L#%d stream rx queue full", __func__, __LINE__);
+        sts_com_msg_delete_msg(ps_rx_msg);
+    }
+    return true;
+}
+
+/*******************************************************************************
+ *
+ * NAME: v_stream_rx_daemon_task
+ *
+ * DESCRIPTION:stream receiving daemon task
+ *
+ * PARAMETERS:  Name            RW  Usage
+ * void*        pv_parameters   R   パラメータ
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * None.
+ ******************************************************************************/
+static void v_stream_rx_daemon_task(void* pv_parameters) {
+    // パラメータから受信キューハンドルを取得
+    QueueHandle_t s_queue_handle = (QueueHandle_t)pv_parameters;
+    // 受信メッセージ
+    ts_com_msg_t* ps_msg = NULL;
+    // デーモンプロセスの無限ループ
+    while (true) {
+        // フレームの受信
+        if (xQueueReceive(s_queue_handle, &ps_msg, portMAX_DELAY) != pdTRUE) {
+            continue;
+        }
+        // フレームの処理
+        v_stream_rx_frame(ps_msg);
+        // メッセージ解放
+        sts_com_msg_delete_msg(ps_msg);
+    }
+}
+
+/*******************************************************************************
+ *
+ * NAME: v_stream_rx_frame
+ *
+ * DESCRIPTION:受信フレームの処理
+ *
+ * PARAMETERS:      Name        RW  Usage
+ * ts_com_msg_t*    ps_msg      R   受信したフレーム
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * 受信ストリームは１件のみ保持し、異なるストリームのオープンで受信途中のストリームは中断する。
+ ******************************************************************************/
+static void v_stream_rx_frame(ts_com_msg_t* ps_msg) {
+    //==========================================================================
+    // フレームの読み込み
+    //==========================================================================
+    ts_stream_rx_sts_t* ps_rx = &s_stream_rx_sts;
+    uint8_t* pu8_frame     = ps_msg->ps_data->pu8_values;
+    uint8_t u8_type        = pu8_frame[STREAM_POS_TYPE];
+    uint8_t u8_stream_id   = pu8_frame[STREAM_POS_ID];
+    uint32_t u32_offset    = u32_stream_read_u32(&pu8_frame[STREAM_POS_OFFSET]);
+    uint8_t* pu8_payload   = &pu8_frame[STREAM_POS_PAYLOAD];
+    size_t t_payload_len   = ps_msg->ps_data->t_size - STREAM_SIZE_HEADER;
+    // 受信途中のストリームと一致するか判定
+    bool b_match = (ps_rx->b_open &&
+                    ps_rx->u64_device_id == ps_msg->u64_device_id &&
+                    ps_rx->u8_stream_id == u8_stream_id);
+
+    //==========================================================================
+    // フレーム種別毎の処理
+    //==========================================================================
+    switch (u8_type) {
+    case STREAM_FRM_OPEN:
+        // オープン
+        if (t_payload_len < STREAM_SIZE_OPEN) {
+            break;
+        }
+        if (!b_match) {
+            // 受信途中の別ストリームは中断
+            if (ps_rx->b_open) {
+                s_pf_rx_cb(COM_STREAM_EVT_ABORT, ps_rx->u64_device_id, ps_rx->u8_stream_id, ps_rx->u32_offset, NULL, 0);
+            }
+            ps_rx->u64_device_id = ps_msg->u64_device_id;
+            ps_rx->u8_stream_id  = u8_stream_id;
+            ps_rx->u32_size      = u32_stream_read_u32(pu8_payload);
+            ps_rx->u32_offset    = 0;
+        }
+        ps_rx->b_open      = true;
+        ps_rx->u16_unacked = 0;
+        // オープン通知（再開時は受信済みのオフセット）
+        s_pf_rx_cb(COM_STREAM_EVT_OPEN, ps_rx->u64_device_id, u8_stream_id, ps_rx->u32_offset, NULL, ps_rx->u32_size);
+        sts_stream_tx_ack();
+        break;
+    case STREAM_FRM_DATA:
+        // データ
+        if (!b_match) {
+            break;
+        }
+        if (u32_offset != ps_rx->u32_offset ||
+            (ps_rx->u32_size > 0 && (uint64_t)u32_offset + t_payload_len > ps_rx->u32_size)) {
+            // 受信済みのオフセットと不一致の場合は確認応答で再同期
+            sts_stream_tx_ack();
+            break;
+        }
+        s_pf_rx_cb(COM_STREAM_EVT_DATA, ps_rx->u64_device_id, u8_stream_id, u32_offset, pu8_payload, t_payload_len);
+        ps_rx->u32_offset += t_payload_len;
+        ps_rx->u16_unacked++;
+        // 確認応答の間隔に達した場合か、総サイズを受信した場合に送信
+        if (ps_rx->u16_unacked >= COM_STREAM_ACK_INTERVAL || ps_rx->u32_offset == ps_rx->u32_size) {
+            sts_stream_tx_ack();
+        }
+        break;
+    case STREAM_FRM_CLOSE:
+        // クローズ
+        if (!b_match) {
+            break;
+        }
+        if (u32_offset != ps_rx->u32_offset) {
+            sts_stream_tx_ack();
+            break;
+        }
+        s_pf_rx_cb(COM_STREAM_EVT_CLOSE, ps_rx->u64_device_id, u8_stream_id, ps_rx->u32_offset, NULL, 0);
+        sts_stream_tx_ack();
+        ps_rx->b_open = false;
+        break;
+    case STREAM_FRM_ABORT:
+        // 中断
+        if (!b_match) {
+            break;
+        }
+        s_pf_rx_cb(COM_STREAM_EVT_ABORT, ps_rx->u64_device_id, u8_stream_id, ps_rx->u32_offset, NULL, 0);
+        ps_rx->b_open = false;
+        break;
+    default:
+        break;
+    }
+}
+
+/*******************************************************************************
+ *
+ * NAME: sts_stream_tx_frame
+ *
+ * DESCRIPTION:フレームの送信
+ *
+ * PARAMETERS:          Name            RW  Usage
+ * uint64_t             u64_device_id   R   送信先デバイスID
+ * te_stream_frame_t    e_type          R   フレーム種別
+ * uint8_t              u8_stream_id    R   ストリームID
+ * uint32_t             u32_offset      R   オフセット
+ * uint8_t*             pu8_payload     R   ペイロード
+ * size_t               t_len           R   ペイロードサイズ
+ *
+ * RETURNS:
+ *   esp_err_t:結果ステータス
+ *
+ * NOTES:
+ * None.
+ ******************************************************************************/
+static esp_err_t sts_stream_tx_frame(uint64_t u64_device_id,
+                                     te_stream_frame_t e_type,
+                                     uint8_t u8_stream_id,
+                                     uint32_t u32_offset,
+                                     const uint8_t* pu8_payload,
+                                     size_t t_len) {
+    // フレーム生成
+    ts_u8_array_t* ps_frame = ps_mdl_empty_u8_array(STREAM_SIZE_HEADER + t_len);
+    if (ps_frame == NULL) {
+        return ESP_ERR_NO_MEM;
+    }
+    uint8_t* pu8_frame = ps_frame->pu8_values;
+    pu8_frame[STREAM_POS_TYPE]      = e_type;
+    pu8_frame[STREAM_POS_ID]        = u8_stream_id;
+    v_stream_write_u32(&pu8_frame[STREAM_POS_OFFSET], u32_offset);
+    if (t_len > 0) {
+        memcpy(&pu8_frame[STREAM_POS_PAYLOAD], pu8_payload, t_len);
+    }
+    // ストリームのコンテンツ種別の暗号メッセージとして送信
+    esp_err_t sts_val = sts_com_msg_tx_cipher_content(u64_device_id, COM_BLE_MSG_CONTENT_STREAM, ps_frame);
+    // フレーム解放
+    sts_mdl_delete_u8_array(ps_frame);
+    // 結果返信
+    return sts_val;
+}
+
+/*******************************************************************************
+ *
+ * NAME: sts_stream_tx_ack
+ *
+ * DESCRIPTION:受信ストリームの確認応答の送信
+ *
+ * PARAMETERS:      Name        RW  Usage
+ *
+ * RETURNS:
+ *   esp_err_t:結果ステータス
+ *
+ * NOTES:
+ * ストリーム受信デーモンタスクから呼び出す事。
+ ******************************************************************************/
+static esp_err_t sts_stream_tx_ack() {
+    ts_stream_rx_sts_t* ps_rx = &s_stream_rx_sts;
+    // クレジット
+    tu_type_converter_t u_conv;
+    u_conv.u16_values[0] = COM_STREAM_RX_CREDIT;
+    uint8_t u8_payload[STREAM_SIZE_ACK] = {u_conv.u8_values[0], u_conv.u8_values[1]};
+    ps_rx->u16_unacked = 0;
+    return sts_stream_tx_frame(ps_rx->u64_device_id, STREAM_FRM_ACK, ps_rx->u8_stream_id,
+                               ps_rx->u32_offset, u8_payload, STREAM_SIZE_ACK);
+}
+
+/*******************************************************************************
+ *
+ * NAME: sts_stream_wait_ack
+ *
+ * DESCRIPTION:確認応答待ち
+ *
+ * PARAMETERS:      Name            RW  Usage
+ * uint32_t         u32_in_flight   R   確認応答待ちとして許容するサイズ
+ *
+ * RETURNS:
+ *   esp_err_t:結果ステータス（ESP_ERR_TIMEOUT:確認応答タイムアウト）
+ *
+ * NOTES:
+ * 確認応答を１件以上受信し、且つ確認応答待ちのサイズが許容範囲内になるまで待機する。
+ ******************************************************************************/
+static esp_err_t sts_stream_wait_ack(uint32_t u32_in_flight) {
+    ts_stream_tx_sts_t* ps_tx = &s_stream_tx_sts;
+    while (true) {
+        // 確認応答の判定
+        if (xSemaphoreTake(s_mutex_stream, portMAX_DELAY) != pdTRUE) {
+            return ESP_ERR_TIMEOUT;
+        }
+        bool b_done = (ps_tx->b_ack_rcv && (ps_tx->u32_offset - ps_tx->u32_acked) <= u32_in_flight);
+        xSemaphoreGive(s_mutex_stream);
+        if (b_done) {
+            return ESP_OK;
+        }
+        // 確認応答の受信通知を待機（受信毎にタイムアウトを延長）
+        if (xSemaphoreTake(s_ack_sem, COM_STREAM_ACK_TIMEOUT) != pdTRUE) {
+            return ESP_ERR_TIMEOUT;
+        }
+    }
+}
+
+/*******************************************************************************
+ *
+ * NAME: u32_stream_read_u32
+ *
+ * DESCRIPTION:32bit値の読み込み（リトルエンディアン）
+ *
+ * PARAMETERS:      Name        RW  Usage
+ * uint8_t*         pu8_src     R   読み込み位置
+ *
+ * RETURNS:
+ *   uint32_t:読み込んだ値
+ *
+ * NOTES:
+ * None.
+ ******************************************************************************/
+static uint32_t u32_stream_read_u32(const uint8_t* pu8_src) {
+    tu_type_converter_t u_conv;
+    u_conv.u8_values[0] = pu8_src[0];
+    u_conv.u8_values[1] = pu8_src[1];
+    u_conv.u8_values[2] = pu8_src[2];
+    u_conv.u8_values[3] = pu8_src[3];
+    return u_conv.u32_values[0];
+}
+
+/*******************************************************************************
+ *
+ * NAME: v_stream_write_u32
+ *
+ * DESCRIPTION:32bit値の書き込み（リトルエンディアン）
+ *
+ * PARAMETERS:      Name        RW  Usage
+ * uint8_t*         pu8_dst     W   書き込み位置
+ * uint32_t         u32_value   R   書き込む値
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * None.
+ ******************************************************************************/
+static void v_stream_write_u32(uint8_t* pu8_dst, uint32_t u32_value) {
+    tu_type_converter_t u_conv;
+    u_conv.u32_values[0] = u32_value;
+    pu8_dst[0] = u_conv.u8_values[0];
+    pu8_dst[1] = u_conv.u8_values[1];
+    pu8_dst[2] = u_conv.u8_values[2];
+    pu8_dst[3] = u_conv.u8_values[3];
+}
+
+/*******************************************************************************
+ *
+ * NAME: v_stream_dmy_rx_cb
+ *
+ * DESCRIPTION:ダミーの受信コールバック関数
+ *
+ * PARAMETERS:      Name            RW  Usage
+ * te_com_stream_evt_t e_evt        R   受信イベント
+ * uint64_t         u64_device_id   R   送信元デバイスID
+ * uint8_t          u8_stream_id    R   ストリームID
+ * uint32_t         u32_offset      R   オフセット
+ * uint8_t*         pu8_data        R   データ
+ * size_t           t_len           R   データサイズ
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * None.
+ ******************************************************************************/
+static void v_stream_dmy_rx_cb(te_com_stream_evt_t e_evt,
+                               uint64_t u64_device_id,
+                               uint8_t u8_stream_id,
+                               uint32_t u32_offset,
+                               const uint8_t* pu8_data,
+                               size_t t_len) {
+    return;
+}
+
+/******************************************************************************/
+/***      END OF FILE                                                       ***/
+/******************************************************************************/
@@ -35,16 +35,203 @@ extern "C" {
 #include <string.h>
 #include <sys/unistd.h>
 #include <sys/stat.h>
+#include <esp_err.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
 #include "ntfw_com_value_util.h"
 #include "ntfw_com_date_time.h"
+#if defined(__XTENSA__) || defined(__riscv)
+#include <esp_cpu.h>
+#endif
 
 /******************************************************************************/
 /***      Macro Definitions                                                 ***/
 /******************************************************************************/
+//==============================================================================
+// トレースバッファ
+//==============================================================================
+/** トレース機能の有効化　※未定義の場合はトレースマクロを空に展開 */
+//#define DBG_TRACE_ENABLED
+
+/** コア毎のトレースレコード数（２のべき乗） */
+#ifndef DBG_TRACE_RECORD_CNT
+    #define DBG_TRACE_RECORD_CNT    (512)
+#endif
+
+/** トレースファイルのマジックナンバー("NTTR") */
+#define DBG_TRACE_MAGIC         (0x5254544E)
+/** トレースファイルのバージョン（2:時刻同期レコード付き） */
+#define DBG_TRACE_VERSION       (2)
+/** 時刻同期レコードの最大間隔（サイクル数、桁溢れ前に再同期） */
+#define DBG_TRACE_SYNC_CYCLES   (0x40000000)
+/** トレースのログ出力接頭辞 */
+#define DBG_TRACE_LOG_PREFIX    "NTTR:"
+/** イベントIDの区間終了フラグ（区間開始はフラグ無し） */
+#define DBG_TRACE_END           (0x8000)
+
+/** トレースの記録 */
+#ifdef DBG_TRACE_ENABLED
+    #define DBG_TRACE(evt_id, arg1, arg2)   v_dbg_trace_record((evt_id), (uint32_t)(arg1), (uint32_t)(arg2))
+#else
+    #define DBG_TRACE(evt_id, arg1, arg2)
+#endif
+/** トレースの記録（区間開始） */
+#define DBG_TRACE_BEGIN(evt_id, arg1)       DBG_TRACE((evt_id), (arg1), 0)
+/** トレースの記録（区間終了） */
+#define DBG_TRACE_END_EVT(evt_id, arg1, arg2)   DBG_TRACE(((evt_id) | DBG_TRACE_END), (arg1), (arg2))
+
+//==============================================================================
+// 区間プロファイラー
+//==============================================================================
+/** 区間プロファイラーの有効化　※未定義の場合はプロファイルマクロを空に展開 */
+//#define DBG_PROF_ENABLED
+
+/** 計測サイトの最大数 */
+#ifndef DBG_PROF_SITE_MAX
+    #define DBG_PROF_SITE_MAX       (32)
+#endif
+/** ヒストグラムのビン数（log2） */
+#define DBG_PROF_HIST_BINS      (32)
+
+/** 計測カウンタ（デバイス：サイクルカウント、Linux：ナノ秒） */
+#if defined(__XTENSA__) || defined(__riscv)
+    #define DBG_PROF_COUNTER()      esp_cpu_get_cycle_count()
+#else
+    #define DBG_PROF_COUNTER()      u32_dbg_prof_clock_ns()
+#endif
+
+/** 区間計測の開始と終了（同一スコープ内で対で利用） */
+#ifdef DBG_PROF_ENABLED
+    #define PROF_BEGIN(site_id) uint32_t u32_prof_begin_##site_id = DBG_PROF_COUNTER()
+    #define PROF_END(site_id)   v_dbg_prof_record((site_id), DBG_PROF_COUNTER() - u32_prof_begin_##site_id)
+#else
+    #define PROF_BEGIN(site_id)
+    #define PROF_END(site_id)
+#endif
+
+//==============================================================================
+// プロファイリングサンプラー
+//==============================================================================
+/** サンプラータスクのスタックサイズ */
+#ifndef DBG_SAMPLER_STACK_DEPTH
+    #define DBG_SAMPLER_STACK_DEPTH     (3072)
+#endif
+/** サンプラータスクの優先度 */
+#ifndef DBG_SAMPLER_PRIORITIES
+    #define DBG_SAMPLER_PRIORITIES      (configMAX_PRIORITIES - 3)
+#endif
+/** サンプルの保持数（リングバッファ） */
+#ifndef DBG_SAMPLER_RING_SIZE
+    #define DBG_SAMPLER_RING_SIZE       (16)
+#endif
+/** サンプル毎の最大タスク数 */
+#ifndef DBG_SAMPLER_TASK_MAX
+    #define DBG_SAMPLER_TASK_MAX        (20)
+#endif
+/** 監視対象の最大キュー数 */
+#ifndef DBG_SAMPLER_QUEUE_MAX
+    #define DBG_SAMPLER_QUEUE_MAX       (4)
+#endif
 
 /******************************************************************************/
 /***      Type Definitions                                                  ***/
 /******************************************************************************/
+/**
+ * トレースイベントID
+ *   フレームワークの予約領域、アプリケーションはDBG_TRACE_EVT_APPから利用する
+ *   ※tools/trace_decoderの名称テーブルと一致させる事
+ */
+typedef enum {
+    DBG_TRACE_EVT_NONE = 0x0000,        // 未定義
+    DBG_TRACE_EVT_MSG_RX,               // メッセージ受信（先頭データ受信～受信完了）
+    DBG_TRACE_EVT_MSG_AUTH,             // 認証タグの生成
+    DBG_TRACE_EVT_MSG_CHECK,            // 受信メッセージチェック
+    DBG_TRACE_EVT_MSG_EVENT,            // 受信メッセージイベント処理
+    DBG_TRACE_EVT_MSG_ENCRYPT,          // メッセージの暗号化
+    DBG_TRACE_EVT_MSG_DECRYPT,          // メッセージの復号
+    DBG_TRACE_EVT_MSG_TX,               // メッセージ送信
+    DBG_TRACE_EVT_MSG_ENQUEUE,          // 受信メッセージのキューイング
+    DBG_TRACE_EVT_SYNC,                 // 時刻同期（引数１:esp_timerの下位32bit、引数２:上位32bit）
+    DBG_TRACE_EVT_APP = 0x0100,         // アプリケーション定義の先頭
+} te_dbg_trace_evt_t;
+
+/**
+ * トレースレコード（16バイト）
+ */
+typedef struct {
+    uint32_t u32_ccount;                // サイクルカウント
+    uint16_t u16_evt_id;                // イベントID
+    uint8_t u8_core_id;                 // コアID
+    uint8_t u8_seq;                     // 記録連番（下位８ビット）
+    uint32_t u32_arg1;                  // 引数１
+    uint32_t u32_arg2;                  // 引数２
+} ts_dbg_trace_record_t;
+
+/**
+ * トレースファイルのブロックヘッダー（コア毎に出力）
+ */
+typedef struct {
+    uint32_t u32_magic;                 // マジックナンバー
+    uint16_t u16_version;               // バージョン
+    uint8_t u8_core_id;                 // コアID
+    uint8_t u8_reserved;                // 予約
+    uint32_t u32_cpu_freq_hz;           // CPU周波数（サイクルカウントの単位）
+    uint32_t u32_record_cnt;            // 後続のレコード数
+    uint32_t u32_lost_cnt;              // 上書きにより失われたレコード数
+} ts_dbg_trace_header_t;
+
+/**
+ * 区間プロファイラーの計測サイトID
+ *   フレームワークの予約領域、アプリケーションはDBG_PROF_SITE_APPから利用する
+ */
+typedef enum {
+    DBG_PROF_SITE_MSG_RX = 0,           // メッセージ受信（e_rx_message）
+    DBG_PROF_SITE_MSG_AUTH,             // 認証タグの生成（sts_edit_auth_tag）
+    DBG_PROF_SITE_MSG_ENCRYPT,          // メッセージの暗号化（sts_msg_encryption）
+    DBG_PROF_SITE_I2C_READ_STOP,        // I2Cの読み込みとストップ（sts_io_i2c_mst_read_stop）
+    DBG_PROF_SITE_APP = 8,              // アプリケーション定義の先頭
+} te_dbg_prof_site_t;
+
+/**
+ * 区間プロファイラーの計測サイト毎の統計
+ *   計測値の単位はDBG_PROF_COUNTERのカウント
+ */
+typedef struct {
+    uint32_t u32_cnt;                   // 計測回数
+    uint32_t u32_min;                   // 最小値
+    uint32_t u32_max;                   // 最大値
+    uint64_t u64_sum;                   // 合計値
+    uint32_t u32_hist[DBG_PROF_HIST_BINS];  // ヒストグラム（ビンnは[2^n, 2^(n+1))、ビン0は0と1）
+} ts_dbg_prof_stat_t;
+
+/**
+ * タスク毎のサンプル（8バイト）
+ */
+typedef struct {
+    uint16_t u16_task_no;               // タスク番号（名称はb_dbg_sampler_task_nameで取得）
+    uint8_t u8_priority;                // 現在の優先度
+    uint8_t u8_state;                   // タスク状態（eTaskState）
+    uint16_t u16_cpu_permille;          // 前回サンプルからのCPU使用率（１コア当たりの千分率）
+    uint16_t u16_stack_hwm;             // スタックの最小空き容量（high water mark）
+} ts_dbg_task_sample_t;
+
+/**
+ * プロファイリングサンプル
+ */
+typedef struct {
+    TickType_t t_tick;                  // 取得時刻（ティック）
+    uint32_t u32_elapsed;               // 前回サンプルからの経過時間（実行時間カウンタ、実行時間統計の無効時は０）
+    uint32_t u32_heap_free;             // ヒープの空き容量
+    uint32_t u32_heap_min_free;         // ヒープの最小空き容量
+    uint32_t u32_heap_largest;          // ヒープの最大空きブロック
+    uint32_t u32_mem_alloc_size;        // メモリ貯蔵域の割り当て済みサイズ
+    uint32_t u32_mem_unused_size;       // メモリ貯蔵域の空き容量
+    uint16_t u16_mem_unused_cnt;        // メモリ貯蔵域の空き領域数
+    uint8_t u8_queue_cnt;               // キュー数
+    uint8_t u8_task_cnt;                // タスク数
+    uint16_t u16_queue_depth[DBG_SAMPLER_QUEUE_MAX];        // キュー毎の滞留数
+    ts_dbg_task_sample_t s_tasks[DBG_SAMPLER_TASK_MAX];     // タスク毎のサンプル
+} ts_dbg_sample_t;
 
 /******************************************************************************/
 /***      Exported Variables                                                ***/
@@ -77,6 +264,56 @@ extern void v_dbg_file_list(char* pc_path);
 /** ファイル情報 */
 extern void v_dbg_file_info(const char* pc_path);
 
+//==============================================================================
+// トレース関数
+//==============================================================================
+/** トレース記録の有効化／無効化 */
+extern void v_dbg_trace_enabled(bool b_enabled);
+/** トレースの記録 */
+extern void v_dbg_trace_record(uint16_t u16_evt_id, uint32_t u32_arg1, uint32_t u32_arg2);
+/** トレースバッファのクリア */
+extern void v_dbg_trace_clear();
+/** トレースバッファをバイナリ形式でファイル出力（SDカード等） */
+extern uint32_t u32_dbg_trace_drain_file(FILE* ps_file);
+/** トレースバッファを１６進数文字列でログ出力（UART） */
+extern uint32_t u32_dbg_trace_drain_log();
+
+//==============================================================================
+// 区間プロファイラー関数
+//==============================================================================
+/** 計測サイトの名称設定 */
+extern esp_err_t sts_dbg_prof_set_name(uint16_t u16_site_id, const char* pc_name);
+/** 計測値の記録 */
+extern void v_dbg_prof_record(uint16_t u16_site_id, uint32_t u32_elapsed);
+/** 計測サイト毎の統計の取得 */
+extern esp_err_t sts_dbg_prof_get(uint16_t u16_site_id, ts_dbg_prof_stat_t* ps_stat);
+/** 全計測サイトの統計のクリア */
+extern void v_dbg_prof_clear();
+/** 計測カウンタの周波数（デバイス：CPUクロック、Linux：1GHz） */
+extern uint32_t u32_dbg_prof_counter_hz();
+/** 単調増加時刻の取得（ナノ秒、Linux用の計測カウンタ） */
+extern uint32_t u32_dbg_prof_clock_ns();
+/** 全計測サイトの統計の表示 */
+extern void v_dbg_prof_disp(const char* pc_pref);
+
+//==============================================================================
+// プロファイリングサンプラー関数
+//==============================================================================
+/** サンプラーの開始（開始済みの場合はサンプリング間隔を更新） */
+extern esp_err_t sts_dbg_sampler_begin(uint32_t u32_interval_ms);
+/** サンプラーの監視対象キューの登録 */
+extern esp_err_t sts_dbg_sampler_add_queue(const char* pc_name, QueueHandle_t s_queue);
+/** 保持しているサンプル数 */
+extern uint32_t u32_dbg_sampler_cnt();
+/** サンプルの取得（インデックス０が最新） */
+extern esp_err_t sts_dbg_sampler_get(uint32_t u32_idx, ts_dbg_sample_t* ps_sample);
+/** タスク名の取得 */
+extern bool b_dbg_sampler_task_name(uint16_t u16_task_no, char* pc_name);
+/** 監視対象キュー名の取得 */
+extern const char* pc_dbg_sampler_queue_name(uint8_t u8_queue_idx);
+/** サンプルの表示 */
+extern void v_dbg_sampler_disp(const char* pc_pref, uint32_t u32_idx);
+
 #ifdef __cplusplus
 }
 #endif
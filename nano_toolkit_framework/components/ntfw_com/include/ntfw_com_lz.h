@@ -0,0 +1,86 @@
+/*******************************************************************************
+ *
+ * COMPONENT:Nano Toolkit Framework
+ *
+ * MODULE :common LZ compression functions header file
+ *
+ * CREATED:2024/11/25 20:00:00
+ * AUTHOR :Kakuheiki.Nakanohito
+ *
+ * DESCRIPTION:省メモリのLZ系圧縮（LZSS形式、スライド窓4KB）
+ *   圧縮はハッシュテーブル（2^COM_LZ_HASH_BITS * 2byte）をスタック上に確保し、
+ *   伸長は出力バッファ以外のメモリを利用しない。
+ *   ESP-IDFに依存しない（Linux上でもビルド可能）
+ *
+ *   圧縮形式：制御バイト（LSBから8要素分のフラグ、1:一致）に続けて各要素を格納する
+ *     リテラル:1byte
+ *     一致    :2byte（距離-1の下位8bit、距離-1の上位4bit<<4 | 長さ-3）
+ *
+ * CHANGE HISTORY:
+ *
+ * LAST MODIFIED BY:
+ *
+ *******************************************************************************
+ *
+ * Copyright (c) 2024 Kakuheiki.Nakanohito
+ * Released under the MIT license
+ * https://opensource.org/licenses/mit-license.php
+ *
+ ******************************************************************************/
+#ifndef  __NTFW_COM_LZ_H__
+#define  __NTFW_COM_LZ_H__
+
+#if defined __cplusplus
+extern "C" {
+#endif
+
+/******************************************************************************/
+/***      Include files                                                     ***/
+/******************************************************************************/
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+/******************************************************************************/
+/***      Macro Definitions                                                 ***/
+/******************************************************************************/
+/** 圧縮時のハッシュテーブルのビット数（スタック使用量は2^n * 2byte） */
+#ifndef COM_LZ_HASH_BITS
+    #define COM_LZ_HASH_BITS    (9)
+#endif
+
+/** スライド窓のサイズ（圧縮形式で固定） */
+#define COM_LZ_WINDOW_SIZE      (4096)
+
+/** 圧縮対象の最大サイズ */
+#define COM_LZ_MAX_SIZE         (0xFFFF)
+
+/** 圧縮後の最大サイズ（圧縮出来ないデータの場合） */
+#define COM_LZ_BOUND(len)       ((len) + (((len) + 7) / 8))
+
+/******************************************************************************/
+/***      Type Definitions                                                  ***/
+/******************************************************************************/
+
+/******************************************************************************/
+/***      Exported Variables                                                ***/
+/******************************************************************************/
+
+/******************************************************************************/
+/***      Exported Functions                                                ***/
+/******************************************************************************/
+/** LZ圧縮（0:出力バッファに収まらない） */
+extern size_t t_lz_compress(const uint8_t* pu8_src, size_t t_src_len, uint8_t* pu8_dst, size_t t_dst_cap);
+/** LZ伸長 */
+extern bool b_lz_decompress(const uint8_t* pu8_src, size_t t_src_len,
+                            uint8_t* pu8_dst, size_t t_dst_cap, size_t* pt_dst_len);
+
+#if defined __cplusplus
+}
+#endif
+
+#endif /* __NTFW_COM_LZ_H__ */
+
+/******************************************************************************/
+/***      END OF FILE                                                       ***/
+/******************************************************************************/
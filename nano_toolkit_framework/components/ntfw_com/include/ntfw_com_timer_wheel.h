@@ -0,0 +1,107 @@
+/*******************************************************************************
+ *
+ * COMPONENT:Nano Toolkit Framework
+ *
+ * MODULE :common timer wheel service header file
+ *
+ * CREATED:2024/11/02 10:00:00
+ * AUTHOR :Kakuheiki.Nakanohito
+ *
+ * DESCRIPTION:階層型タイマーホイールによるタイマーサービス
+ *
+ * CHANGE HISTORY:
+ *
+ * LAST MODIFIED BY:
+ *
+ *******************************************************************************
+ *
+ * Copyright (c) 2024 Kakuheiki.Nakanohito
+ * Released under the MIT license
+ * https://opensource.org/licenses/mit-license.php
+ *
+ ******************************************************************************/
+#ifndef  __NTFW_COM_TIMER_WHEEL_H__
+#define  __NTFW_COM_TIMER_WHEEL_H__
+
+#if defined __cplusplus
+extern "C" {
+#endif
+
+/******************************************************************************/
+/***      Include files                                                     ***/
+/******************************************************************************/
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <esp_err.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+/******************************************************************************/
+/***      Macro Definitions                                                 ***/
+/******************************************************************************/
+/** タイマーサービスタスクのスタックサイズ */
+#ifndef TMW_SERVICE_STACK_DEPTH
+    #define TMW_SERVICE_STACK_DEPTH     (4096)
+#endif
+/** タイマーサービスタスクの優先度 */
+#ifndef TMW_SERVICE_PRIORITIES
+    #define TMW_SERVICE_PRIORITIES      (configMAX_PRIORITIES - 2)
+#endif
+
+/** ホイールの階層数 */
+#define TMW_WHEEL_LEVELS        (4)
+/** 階層毎のスロット数（ビット数） */
+#define TMW_WHEEL_SLOT_BITS     (6)
+/** 階層毎のスロット数 */
+#define TMW_WHEEL_SLOTS         (1 << TMW_WHEEL_SLOT_BITS)
+
+/******************************************************************************/
+/***      Type Definitions                                                  ***/
+/******************************************************************************/
+/** タイマーコールバック関数 */
+typedef void (*tf_tmw_timer_cb_t)(void* pv_arg);
+
+/**
+ * タイマー情報
+ *   領域は利用者が確保し、v_tmw_init_timerで初期化して利用する
+ */
+typedef struct s_tmw_timer_t {
+    struct s_tmw_timer_t* ps_prev;  // 前のタイマー（同一スロット内）
+    struct s_tmw_timer_t* ps_next;  // 次のタイマー（同一スロット内）
+    TickType_t t_expire;            // 満了ティック
+    TickType_t t_period;            // 周期ティック（0:ワンショット）
+    tf_tmw_timer_cb_t pf_cb;        // コールバック関数
+    void* pv_arg;                   // コールバック引数
+    uint8_t u8_level;               // 登録先の階層
+    uint8_t u8_slot;                // 登録先のスロット
+    bool b_active;                  // 登録済みフラグ
+} ts_tmw_timer_t;
+
+/******************************************************************************/
+/***      Exported Variables                                                ***/
+/******************************************************************************/
+
+/******************************************************************************/
+/***      Exported Functions Prototypes                                     ***/
+/******************************************************************************/
+/** タイマーサービスの開始（開始済みの場合は何もしない） */
+extern esp_err_t sts_tmw_begin_service();
+/** タイマー情報の初期化 */
+extern void v_tmw_init_timer(ts_tmw_timer_t* ps_timer, tf_tmw_timer_cb_t pf_cb, void* pv_arg);
+/** タイマーの開始（登録済みの場合は再設定） */
+extern esp_err_t sts_tmw_start(ts_tmw_timer_t* ps_timer, uint32_t u32_delay_ms, uint32_t u32_period_ms);
+/** タイマーの停止 */
+extern esp_err_t sts_tmw_stop(ts_tmw_timer_t* ps_timer);
+/** タイマーの登録判定 */
+extern bool b_tmw_is_active(ts_tmw_timer_t* ps_timer);
+
+#if defined __cplusplus
+}
+#endif
+
+#endif  /* __NTFW_COM_TIMER_WHEEL_H__ */
+
+/******************************************************************************/
+/***      END OF FILE                                                       ***/
+/******************************************************************************/
@@ -0,0 +1,71 @@
+/*******************************************************************************
+ *
+ * COMPONENT:Nano Toolkit Framework
+ *
+ * MODULE :common value kernel functions header file
+ *
+ * CREATED:2024/11/20 21:00:00
+ * AUTHOR :Kakuheiki.Nakanohito
+ *
+ * DESCRIPTION:バイト列の一括演算（XOR、マスキング、パターン埋め、定数時間比較）
+ *   アドレスの境界が揃う範囲は32bit単位で処理し、ESP-IDFに依存しない（Linux上でもビルド可能）
+ *   ntfw_com_value_util.hから公開する
+ *
+ * CHANGE HISTORY:
+ *
+ * LAST MODIFIED BY:
+ *
+ *******************************************************************************
+ *
+ * Copyright (c) 2024 Kakuheiki.Nakanohito
+ * Released under the MIT license
+ * https://opensource.org/licenses/mit-license.php
+ *
+ ******************************************************************************/
+#ifndef  __NTFW_COM_VAL_KERNEL_H__
+#define  __NTFW_COM_VAL_KERNEL_H__
+
+#if defined __cplusplus
+extern "C" {
+#endif
+
+/******************************************************************************/
+/***      Include files                                                     ***/
+/******************************************************************************/
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+/******************************************************************************/
+/***      Macro Definitions                                                 ***/
+/******************************************************************************/
+
+/******************************************************************************/
+/***      Type Definitions                                                  ***/
+/******************************************************************************/
+
+/******************************************************************************/
+/***      Exported Variables                                                ***/
+/******************************************************************************/
+
+/******************************************************************************/
+/***      Exported Functions                                                ***/
+/******************************************************************************/
+/** 一括演算：排他的論理和（pu8_dst ^= pu8_src） */
+extern void v_vutil_xor_into(uint8_t* pu8_dst, const uint8_t* pu8_src, size_t t_len);
+/** 一括演算：排他的論理和の畳み込み（4byte毎のリトルエンディアン値のXOR） */
+extern uint32_t u32_vutil_xor_fold(const uint8_t* pu8_src, size_t t_len);
+/** 一括演算：32bitパターンによる埋め込み（リトルエンディアン順） */
+extern void v_vutil_fill_u32(uint8_t* pu8_dst, uint32_t u32_pattern, size_t t_len);
+/** 一括演算：定数時間比較 */
+extern bool b_vutil_ct_equal(const uint8_t* pu8_val1, const uint8_t* pu8_val2, size_t t_len);
+
+#if defined __cplusplus
+}
+#endif
+
+#endif /* __NTFW_COM_VAL_KERNEL_H__ */
+
+/******************************************************************************/
+/***      END OF FILE                                                       ***/
+/******************************************************************************/
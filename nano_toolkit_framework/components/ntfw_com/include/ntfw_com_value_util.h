@@ -33,6 +33,7 @@ extern "C" {
 #include <stdio.h>
 #include <stdint.h>
 #include <driver/gpio.h>
+#include "ntfw_com_value_kernel.h"
 
 
 /******************************************************************************/
@@ -27,14 +27,19 @@
 #include "ntfw_com_debug_util.h"
 
 #include <dirent.h>
+#include <time.h>
 #include <sys/stat.h>
 #include <sys/unistd.h>
 #include <esp_system.h>
 #include <esp_heap_caps.h>
 #include <esp_idf_version.h>
 #include <esp_log.h>
+#include <esp_cpu.h>
+#include <esp_rom_sys.h>
+#include <esp_timer.h>
 #include <freertos/FreeRTOS.h>
 #include <freertos/task.h>
+#include <freertos/semphr.h>
 
 #include "ntfw_com_value_util.h"
 #include "ntfw_com_mem_alloc.h"
@@ -43,9 +48,64 @@
 /***      Macro Definitions                                                 ***/
 /******************************************************************************/
 
+/** トレースレコードインデックスのマスク */
+#define DBG_TRACE_IDX_MASK      (DBG_TRACE_RECORD_CNT - 1)
+
+/** タスク毎のCPU使用率の取得可否（ヒープとキューの統計は常に取得） */
+#if defined(CONFIG_FREERTOS_USE_TRACE_FACILITY) && defined(CONFIG_FREERTOS_GENERATE_RUN_TIME_STATS)
+    #define DBG_SAMPLER_TASK_CPU
+#endif
+
 /******************************************************************************/
 /***      Type Definitions                                                  ***/
 /******************************************************************************/
+/**
+ * トレースバッファ（コア毎）
+ *   書き込みは自コアの割り込み禁止区間でのみ行い、コア間のロックは使用しない
+ */
+typedef struct {
+    volatile uint32_t u32_head;                             // 書き込み位置（累積）
+    uint32_t u32_tail;                                      // 読み出し位置（累積）
+    uint32_t u32_lost;                                      // 失われたレコード数
+    volatile bool b_sync;                                   // 時刻同期レコードの記録済みフラグ
+    uint32_t u32_sync_head;                                 // 時刻同期レコードの書き込み位置
+    uint32_t u32_sync_ccount;                               // 時刻同期レコードのサイクルカウント
+    ts_dbg_trace_record_t s_records[DBG_TRACE_RECORD_CNT];  // レコード
+} ts_dbg_trace_buffer_t;
+
+/**
+ * タスク名（タスク番号との対応表）
+ */
+typedef struct {
+    uint16_t u16_task_no;                                   // タスク番号（0:未使用）
+    char c_name[configMAX_TASK_NAME_LEN];                   // タスク名
+} ts_dbg_task_name_t;
+
+/**
+ * タスク毎の累積実行時間（前回サンプル）
+ */
+typedef struct {
+    uint16_t u16_task_no;                                   // タスク番号
+    configRUN_TIME_COUNTER_TYPE t_runtime;                  // 累積実行時間
+} ts_dbg_task_runtime_t;
+
+/**
+ * プロファイリングサンプラーの状態
+ */
+typedef struct {
+    TaskHandle_t s_task_handle;                             // サンプラータスク
+    uint32_t u32_interval_ms;                               // サンプリング間隔
+    ts_dbg_sample_t* ps_ring;                               // サンプルのリングバッファ
+    uint32_t u32_head;                                      // 書き込み位置（累積）
+    uint8_t u8_queue_cnt;                                   // 監視対象キュー数
+    const char* pc_queue_name[DBG_SAMPLER_QUEUE_MAX];       // 監視対象キュー名
+    QueueHandle_t s_queue[DBG_SAMPLER_QUEUE_MAX];           // 監視対象キュー
+    uint32_t u32_name_idx;                                  // タスク名の次の登録位置
+    ts_dbg_task_name_t s_names[DBG_SAMPLER_TASK_MAX * 2];   // タスク名
+    uint32_t u32_prev_cnt;                                  // 前回サンプルのタスク数
+    ts_dbg_task_runtime_t s_prev[DBG_SAMPLER_TASK_MAX * 2]; // 前回サンプルの累積実行時間
+    configRUN_TIME_COUNTER_TYPE t_prev_total;               // 前回サンプルの実行時間カウンタ
+} ts_dbg_sampler_t;
 
 /******************************************************************************/
 /***      Exported Variables                                                ***/
@@ -57,11 +117,70 @@
 /** ログ出力タグ */
 static const char* LOG_TAG = "Debug";
 
+#ifdef DBG_TRACE_ENABLED
+/** トレース記録の有効フラグ */
+static volatile bool s_trace_enabled = true;
+/** トレースバッファ */
+static ts_dbg_trace_buffer_t s_trace_buff[portNUM_PROCESSORS];
+#endif
+
+#ifdef DBG_PROF_ENABLED
+/** 区間プロファイラーのスピンロック */
+static portMUX_TYPE s_prof_spinlock = portMUX_INITIALIZER_UNLOCKED;
+/** 計測サイトの名称 */
+static const char* s_prof_name[DBG_PROF_SITE_MAX] = {
+    [DBG_PROF_SITE_MSG_RX]        = "msg_rx",
+    [DBG_PROF_SITE_MSG_AUTH]      = "msg_auth",
+    [DBG_PROF_SITE_MSG_ENCRYPT]   = "msg_encrypt",
+    [DBG_PROF_SITE_I2C_READ_STOP] = "i2c_read_stop",
+};
+/** 計測サイト毎の統計 */
+static ts_dbg_prof_stat_t s_prof_stat[DBG_PROF_SITE_MAX];
+#endif
+
+/** サンプラーのミューテックス生成用のスピンロック */
+static portMUX_TYPE s_sampler_spinlock = portMUX_INITIALIZER_UNLOCKED;
+/** サンプラーのミューテックス領域 */
+static StaticSemaphore_t s_sampler_mutex_buffer;
+/** サンプラーのミューテックス */
+static SemaphoreHandle_t s_sampler_mutex = NULL;
+/** サンプラーの状態 */
+static ts_dbg_sampler_t s_sampler = {
+    .s_task_handle   = NULL,
+    .u32_interval_ms = 0,
+    .ps_ring         = NULL,
+    .u32_head        = 0,
+    .u8_queue_cnt    = 0,
+    .u32_name_idx    = 0,
+    .u32_prev_cnt    = 0,
+    .t_prev_total    = 0,
+};
+
 /******************************************************************************/
 /***      Local Function Prototypes                                         ***/
 /******************************************************************************/
 /** 動的メモリ確保のエラー情報表示用のフック関数 */
 static void v_disp_alloc_faild_hook(size_t size, uint32_t caps, const char *function_name);
+/** トレースバッファの出力 */
+static uint32_t u32_trace_drain(FILE* ps_file, bool b_hex);
+/** トレースデータの出力 */
+static void v_trace_write(FILE* ps_file, bool b_hex, const void* pv_data, size_t t_size);
+#ifdef DBG_PROF_ENABLED
+/** 計測値をナノ秒に変換 */
+static uint64_t u64_prof_to_ns(uint64_t u64_count);
+#endif
+/** サンプラーのミューテックス生成 */
+static void v_sampler_mutex_init();
+/** サンプラータスク */
+static void v_sampler_task(void* pv_parameters);
+/** サンプルの取得 */
+static void v_sampler_collect(ts_dbg_sample_t* ps_sample);
+/** タスク毎のサンプル編集 */
+static void v_sampler_collect_task(ts_dbg_sample_t* ps_sample);
+#ifdef DBG_SAMPLER_TASK_CPU
+/** タスク名の登録 */
+static void v_sampler_put_name(uint16_t u16_task_no, const char* pc_name);
+#endif
 
 /******************************************************************************/
 /***      Exported Functions                                                ***/
@@ -339,6 +458,700 @@ void v_dbg_file_info(const char* pc_path) {
     ESP_LOGI(LOG_TAG, "File Mode :%lu", statBuf.st_mode);
 }
 
+/*******************************************************************************
+ *
+ * NAME: v_dbg_trace_enabled
+ *
+ * DESCRIPTION:トレース記録の有効化／無効化
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   bool           b_enabled       R   有効化フラグ
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * DBG_TRACE_ENABLEDが未定義の場合は何もしない
+ ******************************************************************************/
+void v_dbg_trace_enabled(bool b_enabled) {
+#ifdef DBG_TRACE_ENABLED
+    s_trace_enabled = b_enabled;
+#endif
+}
+
+/*******************************************************************************
+ *
+ * NAME: v_dbg_trace_record
+ *
+ * DESCRIPTION:トレースの記録
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   uint16_t       u16_evt_id      R   イベントID
+ *   uint32_t       u32_arg1        R   引数１
+ *   uint32_t       u32_arg2        R   引数２
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * 自コアのバッファにのみ書き込む為、コア間のロックは不要。
+ * バッファが一杯の場合は古いレコードから上書きする。
+ * コア間でサイクルカウントを揃える為、出力範囲に必ず含まれる間隔で
+ * 時刻同期レコード（サイクルカウントとesp_timerの組）を記録する。
+ ******************************************************************************/
+void v_dbg_trace_record(uint16_t u16_evt_id, uint32_t u32_arg1, uint32_t u32_arg2) {
+#ifdef DBG_TRACE_ENABLED
+    // 有効判定
+    if (!s_trace_enabled) {
+        return;
+    }
+    // 自コアの割り込み禁止（同一コア上のタスク切り替えと割り込みを抑止）
+    UBaseType_t ux_mask = portSET_INTERRUPT_MASK_FROM_ISR();
+    // 自コアのバッファ
+    uint8_t u8_core_id = (uint8_t)xPortGetCoreID();
+    ts_dbg_trace_buffer_t* ps_buff = &s_trace_buff[u8_core_id];
+    uint32_t u32_head = ps_buff->u32_head;
+    uint32_t u32_ccount = esp_cpu_get_cycle_count();
+    ts_dbg_trace_record_t* ps_rec;
+    // 時刻同期レコードの記録判定（未記録、バッファの半分を消費、又は桁溢れ前）
+    if (!ps_buff->b_sync ||
+        (u32_head - ps_buff->u32_sync_head) >= (DBG_TRACE_RECORD_CNT / 2) ||
+        (u32_ccount - ps_buff->u32_sync_ccount) >= DBG_TRACE_SYNC_CYCLES) {
+        uint64_t u64_now_us = (uint64_t)esp_timer_get_time();
+        ps_rec = &ps_buff->s_records[u32_head & DBG_TRACE_IDX_MASK];
+        ps_rec->u32_ccount = u32_ccount;
+        ps_rec->u16_evt_id = DBG_TRACE_EVT_SYNC;
+        ps_rec->u8_core_id = u8_core_id;
+        ps_rec->u8_seq     = (uint8_t)u32_head;
+        ps_rec->u32_arg1   = (uint32_t)u64_now_us;
+        ps_rec->u32_arg2   = (uint32_t)(u64_now_us >> 32);
+        ps_buff->b_sync          = true;
+        ps_buff->u32_sync_head   = u32_head;
+        ps_buff->u32_sync_ccount = u32_ccount;
+        u32_head++;
+    }
+    // レコード編集
+    ps_rec = &ps_buff->s_records[u32_head & DBG_TRACE_IDX_MASK];
+    ps_rec->u32_ccount = u32_ccount;
+    ps_rec->u16_evt_id = u16_evt_id;
+    ps_rec->u8_core_id = u8_core_id;
+    ps_rec->u8_seq     = (uint8_t)u32_head;
+    ps_rec->u32_arg1   = u32_arg1;
+    ps_rec->u32_arg2   = u32_arg2;
+    // 書き込み位置を更新
+    ps_buff->u32_head = u32_head + 1;
+    // 割り込み禁止解除
+    portCLEAR_INTERRUPT_MASK_FROM_ISR(ux_mask);
+#endif
+}
+
+/*******************************************************************************
+ *
+ * NAME: v_dbg_trace_clear
+ *
+ * DESCRIPTION:トレースバッファのクリア
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * None.
+ ******************************************************************************/
+void v_dbg_trace_clear() {
+#ifdef DBG_TRACE_ENABLED
+    uint8_t u8_core_id;
+    for (u8_core_id = 0; u8_core_id < portNUM_PROCESSORS; u8_core_id++) {
+        ts_dbg_trace_buffer_t* ps_buff = &s_trace_buff[u8_core_id];
+        ps_buff->u32_tail = ps_buff->u32_head;
+        ps_buff->u32_lost = 0;
+        // 次の記録時に時刻同期レコードを記録
+        ps_buff->b_sync   = false;
+    }
+#endif
+}
+
+/*******************************************************************************
+ *
+ * NAME: u32_dbg_trace_drain_file
+ *
+ * DESCRIPTION:トレースバッファをバイナリ形式でファイル出力
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   FILE*          ps_file         RW  出力先ファイル（SDカード等）
+ *
+ * RETURNS:
+ *   uint32_t:出力したレコード数
+ *
+ * NOTES:
+ * コア毎にブロックヘッダーとレコードを出力し、出力済みのレコードは破棄する。
+ * 厳密な結果が必要な場合は、トレース記録を無効化してから出力する事。
+ ******************************************************************************/
+uint32_t u32_dbg_trace_drain_file(FILE* ps_file) {
+    if (ps_file == NULL) {
+        return 0;
+    }
+    return u32_trace_drain(ps_file, false);
+}
+
+/*******************************************************************************
+ *
+ * NAME: u32_dbg_trace_drain_log
+ *
+ * DESCRIPTION:トレースバッファを１６進数文字列でログ出力
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *
+ * RETURNS:
+ *   uint32_t:出力したレコード数
+ *
+ * NOTES:
+ * バイナリ形式と同じ内容を接頭辞"NTTR:"付きの１６進数文字列で標準出力へ出力する。
+ * UARTの改行コード変換の影響を受けない為、コンソールログからの復元が可能。
+ ******************************************************************************/
+uint32_t u32_dbg_trace_drain_log() {
+    return u32_trace_drain(stdout, true);
+}
+
+/*******************************************************************************
+ *
+ * NAME: sts_dbg_prof_set_name
+ *
+ * DESCRIPTION:計測サイトの名称設定
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   uint16_t       u16_site_id     R   計測サイトID
+ *   const char*    pc_name         R   名称（静的な文字列）
+ *
+ * RETURNS:
+ *   esp_err_t:結果ステータス
+ *
+ * NOTES:
+ * DBG_PROF_ENABLEDが未定義の場合はESP_ERR_NOT_SUPPORTEDを返す
+ ******************************************************************************/
+esp_err_t sts_dbg_prof_set_name(uint16_t u16_site_id, const char* pc_name) {
+#ifdef DBG_PROF_ENABLED
+    // 入力チェック
+    if (u16_site_id >= DBG_PROF_SITE_MAX || pc_name == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    s_prof_name[u16_site_id] = pc_name;
+    return ESP_OK;
+#else
+    return ESP_ERR_NOT_SUPPORTED;
+#endif
+}
+
+/*******************************************************************************
+ *
+ * NAME: v_dbg_prof_record
+ *
+ * DESCRIPTION:計測値の記録
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   uint16_t       u16_site_id     R   計測サイトID
+ *   uint32_t       u32_elapsed     R   計測値（DBG_PROF_COUNTERの差分）
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * 通常はPROF_ENDマクロから呼び出される
+ ******************************************************************************/
+void v_dbg_prof_record(uint16_t u16_site_id, uint32_t u32_elapsed) {
+#ifdef DBG_PROF_ENABLED
+    // 入力チェック
+    if (u16_site_id >= DBG_PROF_SITE_MAX) {
+        return;
+    }
+    // ヒストグラムのビン（最上位ビットの位置）
+    uint32_t u32_bin = (u32_elapsed > 1) ? (31 - __builtin_clz(u32_elapsed)) : 0;
+    // 統計の更新
+    taskENTER_CRITICAL(&s_prof_spinlock);
+    ts_dbg_prof_stat_t* ps_stat = &s_prof_stat[u16_site_id];
+    if (ps_stat->u32_cnt == 0 || u32_elapsed < ps_stat->u32_min) {
+        ps_stat->u32_min = u32_elapsed;
+    }
+    if (u32_elapsed > ps_stat->u32_max) {
+        ps_stat->u32_max = u32_elapsed;
+    }
+    ps_stat->u32_cnt++;
+    ps_stat->u64_sum += u32_elapsed;
+    ps_stat->u32_hist[u32_bin]++;
+    taskEXIT_CRITICAL(&s_prof_spinlock);
+#endif
+}
+
+/*******************************************************************************
+ *
+ * NAME: sts_dbg_prof_get
+ *
+ * DESCRIPTION:計測サイト毎の統計の取得
+ *
+ * PARAMETERS:              Name            RW  Usage
+ *   uint16_t               u16_site_id     R   計測サイトID
+ *   ts_dbg_prof_stat_t*    ps_stat         W   統計
+ *
+ * RETURNS:
+ *   esp_err_t:結果ステータス
+ *
+ * NOTES:
+ * None.
+ ******************************************************************************/
+esp_err_t sts_dbg_prof_get(uint16_t u16_site_id, ts_dbg_prof_stat_t* ps_stat) {
+#ifdef DBG_PROF_ENABLED
+    // 入力チェック
+    if (u16_site_id >= DBG_PROF_SITE_MAX || ps_stat == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    taskENTER_CRITICAL(&s_prof_spinlock);
+    *ps_stat = s_prof_stat[u16_site_id];
+    taskEXIT_CRITICAL(&s_prof_spinlock);
+    return ESP_OK;
+#else
+    return ESP_ERR_NOT_SUPPORTED;
+#endif
+}
+
+/*******************************************************************************
+ *
+ * NAME: v_dbg_prof_clear
+ *
+ * DESCRIPTION:全計測サイトの統計のクリア
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * None.
+ ******************************************************************************/
+void v_dbg_prof_clear() {
+#ifdef DBG_PROF_ENABLED
+    taskENTER_CRITICAL(&s_prof_spinlock);
+    memset(s_prof_stat, 0x00, sizeof(s_prof_stat));
+    taskEXIT_CRITICAL(&s_prof_spinlock);
+#endif
+}
+
+/*******************************************************************************
+ *
+ * NAME: u32_dbg_prof_counter_hz
+ *
+ * DESCRIPTION:計測カウンタの周波数
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *
+ * RETURNS:
+ *   uint32_t:DBG_PROF_COUNTERの１秒当たりのカウント数
+ *
+ * NOTES:
+ * None.
+ ******************************************************************************/
+uint32_t u32_dbg_prof_counter_hz() {
+#if defined(__XTENSA__) || defined(__riscv)
+    return esp_rom_get_cpu_ticks_per_us() * 1000000;
+#else
+    return 1000000000;
+#endif
+}
+
+/*******************************************************************************
+ *
+ * NAME: u32_dbg_prof_clock_ns
+ *
+ * DESCRIPTION:単調増加時刻の取得
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *
+ * RETURNS:
+ *   uint32_t:単調増加時刻（ナノ秒、下位３２ビット）
+ *
+ * NOTES:
+ * Linux上の計測カウンタ、差分のみ意味を持つ
+ ******************************************************************************/
+uint32_t u32_dbg_prof_clock_ns() {
+    struct timespec s_ts;
+    clock_gettime(CLOCK_MONOTONIC, &s_ts);
+    return (uint32_t)((uint64_t)s_ts.tv_sec * 1000000000 + s_ts.tv_nsec);
+}
+
+/*******************************************************************************
+ *
+ * NAME: v_dbg_prof_disp
+ *
+ * DESCRIPTION:全計測サイトの統計の表示
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   const char*    pc_pref         R   プレフィックス
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * 計測回数が０のサイトは表示しない
+ ******************************************************************************/
+void v_dbg_prof_disp(const char* pc_pref) {
+    // 入力チェック
+    if (pc_pref == NULL) {
+        ESP_LOGI(LOG_TAG, "Prefix Not Found");
+        return;
+    }
+#ifdef DBG_PROF_ENABLED
+    ESP_LOGI(LOG_TAG, "%s //==========================================================================", pc_pref);
+    ESP_LOGI(LOG_TAG, "%s // Profiling Statistics counter=%luHz", pc_pref, u32_dbg_prof_counter_hz());
+    ESP_LOGI(LOG_TAG, "%s //==========================================================================", pc_pref);
+    ts_dbg_prof_stat_t s_stat;
+    char c_hist[DBG_PROF_HIST_BINS * 20 + 1];
+    uint16_t u16_site_id;
+    for (u16_site_id = 0; u16_site_id < DBG_PROF_SITE_MAX; u16_site_id++) {
+        // 統計の取得
+        sts_dbg_prof_get(u16_site_id, &s_stat);
+        if (s_stat.u32_cnt == 0) {
+            continue;
+        }
+        // 統計（ナノ秒）
+        uint64_t u64_min  = u64_prof_to_ns(s_stat.u32_min);
+        uint64_t u64_mean = u64_prof_to_ns(s_stat.u64_sum / s_stat.u32_cnt);
+        uint64_t u64_max  = u64_prof_to_ns(s_stat.u32_max);
+        ESP_LOGI(LOG_TAG, "%s %-16s cnt=%lu min=%llu.%03lluus mean=%llu.%03lluus max=%llu.%03lluus", pc_pref,
+                 (s_prof_name[u16_site_id] != NULL) ? s_prof_name[u16_site_id] : "-", s_stat.u32_cnt,
+                 u64_min / 1000, u64_min % 1000, u64_mean / 1000, u64_mean % 1000, u64_max / 1000, u64_max % 1000);
+        // ヒストグラム（ビンの下限カウント:回数）
+        size_t t_len = 0;
+        c_hist[0] = '\0';
+        uint32_t u32_bin;
+        for (u32_bin = 0; u32_bin < DBG_PROF_HIST_BINS; u32_bin++) {
+            if (s_stat.u32_hist[u32_bin] == 0) {
+                continue;
+            }
+            t_len += snprintf(&c_hist[t_len], sizeof(c_hist) - t_len, " 2^%lu:%lu", u32_bin, s_stat.u32_hist[u32_bin]);
+            if (t_len >= sizeof(c_hist)) {
+                break;
+            }
+        }
+        ESP_LOGI(LOG_TAG, "%s %-16s hist%s", pc_pref, "", c_hist);
+    }
+#endif
+}
+
+/*******************************************************************************
+ *
+ * NAME: sts_dbg_sampler_begin
+ *
+ * DESCRIPTION:プロファイリングサンプラーの開始
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   uint32_t       u32_interval_ms R   サンプリング間隔（ミリ秒）
+ *
+ * RETURNS:
+ *   esp_err_t:結果ステータス
+ *
+ * NOTES:
+ * 開始済みの場合はサンプリング間隔のみ更新する。
+ * ヒープとキューの統計は常に取得し、タスク毎のCPU使用率の取得には
+ * CONFIG_FREERTOS_USE_TRACE_FACILITYとCONFIG_FREERTOS_GENERATE_RUN_TIME_STATSの
+ * 有効化が必要（無効の場合はタスク数と経過時間が０）。
+ ******************************************************************************/
+esp_err_t sts_dbg_sampler_begin(uint32_t u32_interval_ms) {
+    // 入力チェック
+    if (u32_interval_ms == 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    //==========================================================================
+    // クリティカルセクション開始
+    //==========================================================================
+    v_sampler_mutex_init();
+    if (xSemaphoreTakeRecursive(s_sampler_mutex, portMAX_DELAY) != pdTRUE) {
+        return ESP_ERR_TIMEOUT;
+    }
+
+    //==========================================================================
+    // サンプラータスクの開始
+    //==========================================================================
+    esp_err_t sts_val = ESP_OK;
+    do {
+        // サンプリング間隔の更新
+        s_sampler.u32_interval_ms = u32_interval_ms;
+        // 開始済み判定
+        if (s_sampler.s_task_handle != NULL) {
+            break;
+        }
+        // リングバッファの生成
+        if (s_sampler.ps_ring == NULL) {
+            s_sampler.ps_ring = pv_mem_calloc(sizeof(ts_dbg_sample_t) * DBG_SAMPLER_RING_SIZE);
+            if (s_sampler.ps_ring == NULL) {
+                sts_val = ESP_ERR_NO_MEM;
+                break;
+            }
+        }
+        // タスク生成
+        portBASE_TYPE b_type = xTaskCreatePinnedToCore(v_sampler_task,
+                                                       "dbg_sampler_task",
+                                                       DBG_SAMPLER_STACK_DEPTH,
+                                                       NULL,
+                                                       DBG_SAMPLER_PRIORITIES,
+                                                       &s_sampler.s_task_handle,
+                                                       tskNO_AFFINITY);
+        if (b_type != pdPASS) {
+            s_sampler.s_task_handle = NULL;
+            sts_val = ESP_FAIL;
+        }
+    } while(false);
+
+    //==========================================================================
+    // クリティカルセクション終了
+    //==========================================================================
+    xSemaphoreGiveRecursive(s_sampler_mutex);
+
+    // 結果返信
+    return sts_val;
+}
+
+/*******************************************************************************
+ *
+ * NAME: sts_dbg_sampler_add_queue
+ *
+ * DESCRIPTION:サンプラーの監視対象キューの登録
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   const char*    pc_name         R   キュー名（静的な文字列）
+ *   QueueHandle_t  s_queue         R   監視対象キュー
+ *
+ * RETURNS:
+ *   esp_err_t:結果ステータス
+ *
+ * NOTES:
+ * サンプラーの開始前でも登録可能、登録済みのキューは名称のみ更新する
+ ******************************************************************************/
+esp_err_t sts_dbg_sampler_add_queue(const char* pc_name, QueueHandle_t s_queue) {
+    // 入力チェック
+    if (pc_name == NULL || s_queue == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    //==========================================================================
+    // クリティカルセクション開始
+    //==========================================================================
+    v_sampler_mutex_init();
+    if (xSemaphoreTakeRecursive(s_sampler_mutex, portMAX_DELAY) != pdTRUE) {
+        return ESP_ERR_TIMEOUT;
+    }
+
+    //==========================================================================
+    // キューの登録
+    //==========================================================================
+    esp_err_t sts_val = ESP_OK;
+    uint8_t u8_idx;
+    for (u8_idx = 0; u8_idx < s_sampler.u8_queue_cnt; u8_idx++) {
+        if (s_sampler.s_queue[u8_idx] == s_queue) {
+            break;
+        }
+    }
+    if (u8_idx < DBG_SAMPLER_QUEUE_MAX) {
+        s_sampler.pc_queue_name[u8_idx] = pc_name;
+        s_sampler.s_queue[u8_idx] = s_queue;
+        if (u8_idx == s_sampler.u8_queue_cnt) {
+            s_sampler.u8_queue_cnt++;
+        }
+    } else {
+        sts_val = ESP_ERR_NO_MEM;
+    }
+
+    //==========================================================================
+    // クリティカルセクション終了
+    //==========================================================================
+    xSemaphoreGiveRecursive(s_sampler_mutex);
+
+    // 結果返信
+    return sts_val;
+}
+
+/*******************************************************************************
+ *
+ * NAME: u32_dbg_sampler_cnt
+ *
+ * DESCRIPTION:保持しているサンプル数
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *
+ * RETURNS:
+ *   uint32_t:サンプル数
+ *
+ * NOTES:
+ * None.
+ ******************************************************************************/
+uint32_t u32_dbg_sampler_cnt() {
+    v_sampler_mutex_init();
+    if (xSemaphoreTakeRecursive(s_sampler_mutex, portMAX_DELAY) != pdTRUE) {
+        return 0;
+    }
+    uint32_t u32_cnt = s_sampler.u32_head;
+    if (u32_cnt > DBG_SAMPLER_RING_SIZE) {
+        u32_cnt = DBG_SAMPLER_RING_SIZE;
+    }
+    xSemaphoreGiveRecursive(s_sampler_mutex);
+    return u32_cnt;
+}
+
+/*******************************************************************************
+ *
+ * NAME: sts_dbg_sampler_get
+ *
+ * DESCRIPTION:サンプルの取得
+ *
+ * PARAMETERS:          Name            RW  Usage
+ *   uint32_t           u32_idx         R   インデックス（０が最新）
+ *   ts_dbg_sample_t*   ps_sample       W   取得したサンプル
+ *
+ * RETURNS:
+ *   esp_err_t:結果ステータス
+ *
+ * NOTES:
+ * None.
+ ******************************************************************************/
+esp_err_t sts_dbg_sampler_get(uint32_t u32_idx, ts_dbg_sample_t* ps_sample) {
+    // 入力チェック
+    if (ps_sample == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    //==========================================================================
+    // クリティカルセクション開始
+    //==========================================================================
+    v_sampler_mutex_init();
+    if (xSemaphoreTakeRecursive(s_sampler_mutex, portMAX_DELAY) != pdTRUE) {
+        return ESP_ERR_TIMEOUT;
+    }
+
+    //==========================================================================
+    // サンプルの複製
+    //==========================================================================
+    esp_err_t sts_val = ESP_OK;
+    if (u32_idx < s_sampler.u32_head && u32_idx < DBG_SAMPLER_RING_SIZE) {
+        uint32_t u32_pos = (s_sampler.u32_head - 1 - u32_idx) % DBG_SAMPLER_RING_SIZE;
+        *ps_sample = s_sampler.ps_ring[u32_pos];
+    } else {
+        sts_val = ESP_ERR_NOT_FOUND;
+    }
+
+    //==========================================================================
+    // クリティカルセクション終了
+    //==========================================================================
+    xSemaphoreGiveRecursive(s_sampler_mutex);
+
+    // 結果返信
+    return sts_val;
+}
+
+/*******************************************************************************
+ *
+ * NAME: b_dbg_sampler_task_name
+ *
+ * DESCRIPTION:タスク名の取得
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   uint16_t       u16_task_no     R   タスク番号
+ *   char*          pc_name         W   タスク名（configMAX_TASK_NAME_LEN以上の領域）
+ *
+ * RETURNS:
+ *   bool:取得結果
+ *
+ * NOTES:
+ * 削除済みのタスクは名称が破棄されている場合がある
+ ******************************************************************************/
+bool b_dbg_sampler_task_name(uint16_t u16_task_no, char* pc_name) {
+    // 入力チェック
+    if (u16_task_no == 0 || pc_name == NULL) {
+        return false;
+    }
+    v_sampler_mutex_init();
+    if (xSemaphoreTakeRecursive(s_sampler_mutex, portMAX_DELAY) != pdTRUE) {
+        return false;
+    }
+    bool b_result = false;
+    uint32_t u32_idx;
+    for (u32_idx = 0; u32_idx < (DBG_SAMPLER_TASK_MAX * 2); u32_idx++) {
+        if (s_sampler.s_names[u32_idx].u16_task_no == u16_task_no) {
+            memcpy(pc_name, s_sampler.s_names[u32_idx].c_name, configMAX_TASK_NAME_LEN);
+            b_result = true;
+            break;
+        }
+    }
+    xSemaphoreGiveRecursive(s_sampler_mutex);
+    return b_result;
+}
+
+/*******************************************************************************
+ *
+ * NAME: pc_dbg_sampler_queue_name
+ *
+ * DESCRIPTION:監視対象キュー名の取得
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   uint8_t        u8_queue_idx    R   キューのインデックス（登録順）
+ *
+ * RETURNS:
+ *   const char*:キュー名（未登録の場合はNULL）
+ *
+ * NOTES:
+ * None.
+ ******************************************************************************/
+const char* pc_dbg_sampler_queue_name(uint8_t u8_queue_idx) {
+    if (u8_queue_idx >= s_sampler.u8_queue_cnt) {
+        return NULL;
+    }
+    return s_sampler.pc_queue_name[u8_queue_idx];
+}
+
+/*******************************************************************************
+ *
+ * NAME: v_dbg_sampler_disp
+ *
+ * DESCRIPTION:サンプルの表示
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   const char*    pc_pref         R   プレフィックス
+ *   uint32_t       u32_idx         R   インデックス（０が最新）
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * None.
+ ******************************************************************************/
+void v_dbg_sampler_disp(const char* pc_pref, uint32_t u32_idx) {
+    // 入力チェック
+    if (pc_pref == NULL) {
+        ESP_LOGI(LOG_TAG, "Prefix Not Found");
+        return;
+    }
+    // サンプルの取得
+    ts_dbg_sample_t s_sample;
+    if (sts_dbg_sampler_get(u32_idx, &s_sample) != ESP_OK) {
+        ESP_LOGI(LOG_TAG, "%s Sample Not Found idx=%lu", pc_pref, u32_idx);
+        return;
+    }
+    ESP_LOGI(LOG_TAG, "%s //==========================================================================", pc_pref);
+    ESP_LOGI(LOG_TAG, "%s // Profiling Sample idx=%lu tick=%lu elapsed=%lu", pc_pref, u32_idx, s_sample.t_tick, s_sample.u32_elapsed);
+    ESP_LOGI(LOG_TAG, "%s //==========================================================================", pc_pref);
+    ESP_LOGI(LOG_TAG, "%s heap free=%lu min_free=%lu largest=%lu", pc_pref,
+             s_sample.u32_heap_free, s_sample.u32_heap_min_free, s_sample.u32_heap_largest);
+    ESP_LOGI(LOG_TAG, "%s mem  alloc=%lu unused=%lu unused_cnt=%u", pc_pref,
+             s_sample.u32_mem_alloc_size, s_sample.u32_mem_unused_size, s_sample.u16_mem_unused_cnt);
+    uint8_t u8_idx;
+    for (u8_idx = 0; u8_idx < s_sample.u8_queue_cnt; u8_idx++) {
+        const char* pc_name = pc_dbg_sampler_queue_name(u8_idx);
+        ESP_LOGI(LOG_TAG, "%s queue %-16s depth=%u", pc_pref, (pc_name != NULL) ? pc_name : "-", s_sample.u16_queue_depth[u8_idx]);
+    }
+    char c_name[configMAX_TASK_NAME_LEN];
+    for (u8_idx = 0; u8_idx < s_sample.u8_task_cnt; u8_idx++) {
+        ts_dbg_task_sample_t* ps_task = &s_sample.s_tasks[u8_idx];
+        if (!b_dbg_sampler_task_name(ps_task->u16_task_no, c_name)) {
+            strcpy(c_name, "-");
+        }
+        ESP_LOGI(LOG_TAG, "%s task  %-16s cpu=%3u.%u%% stack_hwm=%5u prio=%2u state=%u", pc_pref,
+                 c_name, ps_task->u16_cpu_permille / 10, ps_task->u16_cpu_permille % 10,
+                 ps_task->u16_stack_hwm, ps_task->u8_priority, ps_task->u8_state);
+    }
+}
+
 /******************************************************************************/
 /***      Local Functions                                                   ***/
 /******************************************************************************/
@@ -347,6 +1160,373 @@ static void v_disp_alloc_faild_hook(size_t size, uint32_t caps, const char *func
     ESP_LOGE(LOG_TAG, "// Allocation Error func=%s size=%d caps=%lu", function_name, size, caps);
 }
 
+/*******************************************************************************
+ *
+ * NAME: u32_trace_drain
+ *
+ * DESCRIPTION:トレースバッファの出力
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   FILE*          ps_file         RW  出力先
+ *   bool           b_hex           R   １６進数文字列出力フラグ
+ *
+ * RETURNS:
+ *   uint32_t:出力したレコード数
+ *
+ * NOTES:
+ * None.
+ ******************************************************************************/
+static uint32_t u32_trace_drain(FILE* ps_file, bool b_hex) {
+    // 出力レコード数
+    uint32_t u32_total = 0;
+#ifdef DBG_TRACE_ENABLED
+    // ブロックヘッダー
+    ts_dbg_trace_header_t s_header = {
+        .u32_magic       = DBG_TRACE_MAGIC,
+        .u16_version     = DBG_TRACE_VERSION,
+        .u8_core_id      = 0,
+        .u8_reserved     = 0,
+        .u32_cpu_freq_hz = esp_rom_get_cpu_ticks_per_us() * 1000000,
+        .u32_record_cnt  = 0,
+        .u32_lost_cnt    = 0,
+    };
+    // コア毎に出力
+    uint8_t u8_core_id;
+    for (u8_core_id = 0; u8_core_id < portNUM_PROCESSORS; u8_core_id++) {
+        //----------------------------------------------------------------------
+        // 出力範囲の決定
+        //----------------------------------------------------------------------
+        ts_dbg_trace_buffer_t* ps_buff = &s_trace_buff[u8_core_id];
+        uint32_t u32_head = ps_buff->u32_head;
+        uint32_t u32_tail = ps_buff->u32_tail;
+        // 上書きされたレコードは読み飛ばす
+        if ((u32_head - u32_tail) > DBG_TRACE_RECORD_CNT) {
+            ps_buff->u32_lost += (u32_head - u32_tail) - DBG_TRACE_RECORD_CNT;
+            u32_tail = u32_head - DBG_TRACE_RECORD_CNT;
+        }
+
+        //----------------------------------------------------------------------
+        // ブロックヘッダーの出力
+        //----------------------------------------------------------------------
+        s_header.u8_core_id     = u8_core_id;
+        s_header.u32_record_cnt = u32_head - u32_tail;
+        s_header.u32_lost_cnt   = ps_buff->u32_lost;
+        v_trace_write(ps_file, b_hex, &s_header, sizeof(ts_dbg_trace_header_t));
+
+        //----------------------------------------------------------------------
+        // レコードの出力
+        //----------------------------------------------------------------------
+        for (; u32_tail != u32_head; u32_tail++) {
+            v_trace_write(ps_file, b_hex, &ps_buff->s_records[u32_tail & DBG_TRACE_IDX_MASK], sizeof(ts_dbg_trace_record_t));
+            u32_total++;
+        }
+        // 読み出し位置を更新
+        ps_buff->u32_tail = u32_head;
+        ps_buff->u32_lost = 0;
+        // 次の出力範囲の先頭で時刻同期レコードを記録
+        ps_buff->b_sync   = false;
+    }
+    fflush(ps_file);
+#endif
+    // 結果返信
+    return u32_total;
+}
+
+/*******************************************************************************
+ *
+ * NAME: v_trace_write
+ *
+ * DESCRIPTION:トレースデータの出力
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   FILE*          ps_file         RW  出力先
+ *   bool           b_hex           R   １６進数文字列出力フラグ
+ *   const void*    pv_data         R   出力データ
+ *   size_t         t_size          R   出力データサイズ
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * None.
+ ******************************************************************************/
+static void v_trace_write(FILE* ps_file, bool b_hex, const void* pv_data, size_t t_size) {
+    // バイナリ出力
+    if (!b_hex) {
+        fwrite(pv_data, 1, t_size, ps_file);
+        return;
+    }
+    // １６進数文字列出力
+    const uint8_t* pu8_data = (const uint8_t*)pv_data;
+    fputs(DBG_TRACE_LOG_PREFIX, ps_file);
+    size_t t_idx;
+    for (t_idx = 0; t_idx < t_size; t_idx++) {
+        fprintf(ps_file, "%02X", pu8_data[t_idx]);
+    }
+    fputc('\n', ps_file);
+}
+
+/*******************************************************************************
+ *
+ * NAME: u64_prof_to_ns
+ *
+ * DESCRIPTION:計測値をナノ秒に変換
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   uint64_t       u64_count       R   計測値
+ *
+ * RETURNS:
+ *   uint64_t:ナノ秒
+ *
+ * NOTES:
+ * None.
+ ******************************************************************************/
+#ifdef DBG_PROF_ENABLED
+static uint64_t u64_prof_to_ns(uint64_t u64_count) {
+    return (u64_count * 1000000000) / u32_dbg_prof_counter_hz();
+}
+#endif
+
+/*******************************************************************************
+ *
+ * NAME: v_sampler_mutex_init
+ *
+ * DESCRIPTION:サンプラーのミューテックス生成
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * 静的領域を利用する為、クリティカルセクション内で生成
+ ******************************************************************************/
+static void v_sampler_mutex_init() {
+    taskENTER_CRITICAL(&s_sampler_spinlock);
+    if (s_sampler_mutex == NULL) {
+        s_sampler_mutex = xSemaphoreCreateRecursiveMutexStatic(&s_sampler_mutex_buffer);
+    }
+    taskEXIT_CRITICAL(&s_sampler_spinlock);
+}
+
+/*******************************************************************************
+ *
+ * NAME: v_sampler_task
+ *
+ * DESCRIPTION:サンプラータスク
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   void*          pv_parameters   R   パラメータ
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * None.
+ ******************************************************************************/
+static void v_sampler_task(void* pv_parameters) {
+    // 前回の実行時刻
+    TickType_t t_last_wake = xTaskGetTickCount();
+    // サンプリング間隔
+    TickType_t t_interval;
+    while (true) {
+        //----------------------------------------------------------------------
+        // サンプリング間隔までウェイト
+        //----------------------------------------------------------------------
+        t_interval = pdMS_TO_TICKS(s_sampler.u32_interval_ms);
+        if (t_interval == 0) {
+            t_interval = 1;
+        }
+        vTaskDelayUntil(&t_last_wake, t_interval);
+
+        //----------------------------------------------------------------------
+        // サンプルの取得
+        //----------------------------------------------------------------------
+        if (xSemaphoreTakeRecursive(s_sampler_mutex, portMAX_DELAY) != pdTRUE) {
+            continue;
+        }
+        v_sampler_collect(&s_sampler.ps_ring[s_sampler.u32_head % DBG_SAMPLER_RING_SIZE]);
+        s_sampler.u32_head++;
+        xSemaphoreGiveRecursive(s_sampler_mutex);
+    }
+    // タスク削除
+    vTaskDelete(NULL);
+}
+
+/*******************************************************************************
+ *
+ * NAME: v_sampler_collect
+ *
+ * DESCRIPTION:サンプルの取得
+ *
+ * PARAMETERS:          Name            RW  Usage
+ *   ts_dbg_sample_t*   ps_sample       W   編集対象のサンプル
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * サンプラーのクリティカルセクション内で呼び出す事
+ ******************************************************************************/
+static void v_sampler_collect(ts_dbg_sample_t* ps_sample) {
+    //==========================================================================
+    // ヒープ情報
+    //==========================================================================
+    ps_sample->t_tick            = xTaskGetTickCount();
+    ps_sample->u32_heap_free     = esp_get_free_heap_size();
+    ps_sample->u32_heap_min_free = esp_get_minimum_free_heap_size();
+    ps_sample->u32_heap_largest  = heap_caps_get_largest_free_block(MALLOC_CAP_8BIT);
+
+    //==========================================================================
+    // メモリ貯蔵域の情報
+    //==========================================================================
+    ps_sample->u32_mem_alloc_size  = u32_mem_alloc_size();
+    ps_sample->u32_mem_unused_size = u32_mem_unused_size();
+    ps_sample->u16_mem_unused_cnt  = (uint16_t)u32_mem_unused_cnt();
+
+    //==========================================================================
+    // キューの滞留数
+    //==========================================================================
+    uint8_t u8_idx;
+    for (u8_idx = 0; u8_idx < s_sampler.u8_queue_cnt; u8_idx++) {
+        ps_sample->u16_queue_depth[u8_idx] = (uint16_t)uxQueueMessagesWaiting(s_sampler.s_queue[u8_idx]);
+    }
+    ps_sample->u8_queue_cnt = s_sampler.u8_queue_cnt;
+
+    //==========================================================================
+    // タスク情報
+    //==========================================================================
+    v_sampler_collect_task(ps_sample);
+}
+
+/*******************************************************************************
+ *
+ * NAME: v_sampler_collect_task
+ *
+ * DESCRIPTION:タスク毎のサンプル編集
+ *
+ * PARAMETERS:          Name            RW  Usage
+ *   ts_dbg_sample_t*   ps_sample       W   編集対象のサンプル
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * CPU使用率は前回サンプルからの累積実行時間の差分で算出し、
+ * タスク数がDBG_SAMPLER_TASK_MAXを超える場合は使用率の高い順に保持する
+ ******************************************************************************/
+static void v_sampler_collect_task(ts_dbg_sample_t* ps_sample) {
+    ps_sample->u32_elapsed = 0;
+    ps_sample->u8_task_cnt = 0;
+#ifdef DBG_SAMPLER_TASK_CPU
+    //==========================================================================
+    // タスク状態の取得
+    //==========================================================================
+    // 取得中に生成されたタスク分の余裕を持たせる
+    UBaseType_t ux_task_cnt = uxTaskGetNumberOfTasks() + 2;
+    TaskStatus_t* ps_status = pv_mem_malloc(sizeof(TaskStatus_t) * ux_task_cnt);
+    if (ps_status == NULL) {
+        return;
+    }
+    configRUN_TIME_COUNTER_TYPE t_total = 0;
+    ux_task_cnt = uxTaskGetSystemState(ps_status, ux_task_cnt, &t_total);
+    uint32_t u32_elapsed = (uint32_t)(t_total - s_sampler.t_prev_total);
+    ps_sample->u32_elapsed = u32_elapsed;
+
+    //==========================================================================
+    // タスク毎のサンプル編集（使用率の降順に挿入）
+    //==========================================================================
+    ts_dbg_task_sample_t s_task;
+    UBaseType_t ux_idx;
+    uint32_t u32_pos;
+    for (ux_idx = 0; ux_idx < ux_task_cnt; ux_idx++) {
+        TaskStatus_t* ps_sts = &ps_status[ux_idx];
+        // 前回サンプルからの実行時間
+        configRUN_TIME_COUNTER_TYPE t_prev = 0;
+        for (u32_pos = 0; u32_pos < s_sampler.u32_prev_cnt; u32_pos++) {
+            if (s_sampler.s_prev[u32_pos].u16_task_no == (uint16_t)ps_sts->xTaskNumber) {
+                t_prev = s_sampler.s_prev[u32_pos].t_runtime;
+                break;
+            }
+        }
+        uint64_t u64_permille = 0;
+        if (u32_elapsed > 0) {
+            u64_permille = ((uint64_t)(uint32_t)(ps_sts->ulRunTimeCounter - t_prev) * 1000) / u32_elapsed;
+        }
+        s_task.u16_task_no      = (uint16_t)ps_sts->xTaskNumber;
+        s_task.u8_priority      = (uint8_t)ps_sts->uxCurrentPriority;
+        s_task.u8_state         = (uint8_t)ps_sts->eCurrentState;
+        s_task.u16_cpu_permille = (u64_permille > 1000) ? 1000 : (uint16_t)u64_permille;
+        s_task.u16_stack_hwm    = (ps_sts->usStackHighWaterMark > UINT16_MAX) ? UINT16_MAX : (uint16_t)ps_sts->usStackHighWaterMark;
+        // 挿入位置の検索
+        u32_pos = ps_sample->u8_task_cnt;
+        while (u32_pos > 0 && ps_sample->s_tasks[u32_pos - 1].u16_cpu_permille < s_task.u16_cpu_permille) {
+            u32_pos--;
+        }
+        if (u32_pos >= DBG_SAMPLER_TASK_MAX) {
+            continue;
+        }
+        // 後続をずらして挿入
+        uint32_t u32_tail = ps_sample->u8_task_cnt;
+        if (u32_tail >= DBG_SAMPLER_TASK_MAX) {
+            u32_tail = DBG_SAMPLER_TASK_MAX - 1;
+        } else {
+            ps_sample->u8_task_cnt++;
+        }
+        memmove(&ps_sample->s_tasks[u32_pos + 1], &ps_sample->s_tasks[u32_pos], sizeof(ts_dbg_task_sample_t) * (u32_tail - u32_pos));
+        ps_sample->s_tasks[u32_pos] = s_task;
+        // タスク名の登録
+        v_sampler_put_name(s_task.u16_task_no, ps_sts->pcTaskName);
+    }
+
+    //==========================================================================
+    // 累積実行時間の退避
+    //==========================================================================
+    s_sampler.u32_prev_cnt = 0;
+    for (ux_idx = 0; ux_idx < ux_task_cnt && s_sampler.u32_prev_cnt < (DBG_SAMPLER_TASK_MAX * 2); ux_idx++) {
+        ts_dbg_task_runtime_t* ps_prev = &s_sampler.s_prev[s_sampler.u32_prev_cnt++];
+        ps_prev->u16_task_no = (uint16_t)ps_status[ux_idx].xTaskNumber;
+        ps_prev->t_runtime   = ps_status[ux_idx].ulRunTimeCounter;
+    }
+    s_sampler.t_prev_total = t_total;
+
+    // タスク状態の解放
+    l_mem_free(ps_status);
+#endif
+}
+
+#ifdef DBG_SAMPLER_TASK_CPU
+/*******************************************************************************
+ *
+ * NAME: v_sampler_put_name
+ *
+ * DESCRIPTION:タスク名の登録
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *   uint16_t       u16_task_no     R   タスク番号
+ *   const char*    pc_name         R   タスク名
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * 登録領域が一杯の場合は古い登録から上書きする
+ ******************************************************************************/
+static void v_sampler_put_name(uint16_t u16_task_no, const char* pc_name) {
+    // 登録済み判定
+    ts_dbg_task_name_t* ps_name = NULL;
+    uint32_t u32_idx;
+    for (u32_idx = 0; u32_idx < (DBG_SAMPLER_TASK_MAX * 2); u32_idx++) {
+        if (s_sampler.s_names[u32_idx].u16_task_no == u16_task_no) {
+            ps_name = &s_sampler.s_names[u32_idx];
+            break;
+        }
+    }
+    // 未登録の場合は次の登録位置に上書き
+    if (ps_name == NULL) {
+        ps_name = &s_sampler.s_names[s_sampler.u32_name_idx % (DBG_SAMPLER_TASK_MAX * 2)];
+        s_sampler.u32_name_idx++;
+    }
+    ps_name->u16_task_no = u16_task_no;
+    strncpy(ps_name->c_name, pc_name, configMAX_TASK_NAME_LEN - 1);
+    ps_name->c_name[configMAX_TASK_NAME_LEN - 1] = '\0';
+}
+#endif
+
 /******************************************************************************/
 /***      END OF FILE                                                       ***/
 /******************************************************************************/
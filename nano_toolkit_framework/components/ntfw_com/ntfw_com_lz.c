@@ -0,0 +1,243 @@
+/*******************************************************************************
+ *
+ * COMPONENT:Nano Toolkit Framework
+ *
+ * MODULE :common LZ compression functions source file
+ *
+ * CREATED:2024/11/25 20:00:00
+ * AUTHOR :Kakuheiki.Nakanohito
+ *
+ * DESCRIPTION:省メモリのLZ系圧縮（LZSS形式、スライド窓4KB）
+ *   圧縮は3byteのハッシュで直近の出現位置のみを候補とする貪欲法で、
+ *   BLEメッセージの様な数百byte～数KBのデータを対象とする
+ *
+ * CHANGE HISTORY:
+ *
+ * LAST MODIFIED BY:
+ *
+ *******************************************************************************
+ *
+ * Copyright (c) 2024 Kakuheiki.Nakanohito
+ * Released under the MIT license
+ * https://opensource.org/licenses/mit-license.php
+ *
+ ******************************************************************************/
+
+/******************************************************************************/
+/***      Include files                                                     ***/
+/******************************************************************************/
+#include "ntfw_com_lz.h"
+
+#include <string.h>
+
+/******************************************************************************/
+/***      Macro Definitions                                                 ***/
+/******************************************************************************/
+/** ハッシュテーブルサイズ */
+#define LZ_HASH_SIZE        (1 << COM_LZ_HASH_BITS)
+/** 最小一致長 */
+#define LZ_MIN_MATCH        (3)
+/** 最大一致長 */
+#define LZ_MAX_MATCH        (LZ_MIN_MATCH + 0x0F)
+/** 一致要素のサイズ */
+#define LZ_SIZE_MATCH       (2)
+/** 3byteのハッシュ値 */
+#define u32_lz_hash(pu8) \
+    (((((uint32_t)(pu8)[0]) | ((uint32_t)(pu8)[1] << 8) | ((uint32_t)(pu8)[2] << 16)) * 2654435761u) >> (32 - COM_LZ_HASH_BITS))
+
+/******************************************************************************/
+/***      Type Definitions                                                  ***/
+/******************************************************************************/
+
+/******************************************************************************/
+/***      Exported Variables                                                ***/
+/******************************************************************************/
+
+/******************************************************************************/
+/***      Local Variables                                                   ***/
+/******************************************************************************/
+
+/******************************************************************************/
+/***      Local Function Prototypes                                         ***/
+/******************************************************************************/
+
+/******************************************************************************/
+/***      Exported Functions                                                ***/
+/******************************************************************************/
+
+/*******************************************************************************
+ *
+ * NAME: t_lz_compress
+ *
+ * DESCRIPTION:LZ圧縮
+ *
+ * PARAMETERS:      Name        RW  Usage
+ *   uint8_t*       pu8_src     R   圧縮対象
+ *   size_t         t_src_len   R   圧縮対象のサイズ（COM_LZ_MAX_SIZE以下）
+ *   uint8_t*       pu8_dst     W   出力バッファ
+ *   size_t         t_dst_cap   R   出力バッファのサイズ
+ *
+ * RETURNS:
+ *   size_t:圧縮後のサイズ（0:出力バッファに収まらない、又は入力エラー）
+ *
+ * NOTES:
+ * t_dst_capに圧縮前のサイズ未満を指定すると、縮まないデータは途中で打ち切って0を返す。
+ * 全てのデータを出力する場合はCOM_LZ_BOUND(t_src_len)以上を指定する事。
+ ******************************************************************************/
+size_t t_lz_compress(const uint8_t* pu8_src, size_t t_src_len, uint8_t* pu8_dst, size_t t_dst_cap) {
+    // 入力チェック
+    if (pu8_src == NULL || pu8_dst == NULL || t_src_len == 0 || t_src_len > COM_LZ_MAX_SIZE) {
+        return 0;
+    }
+    // ハッシュテーブル（出現位置+1、0:無し）
+    uint16_t u16_table[LZ_HASH_SIZE];
+    memset(u16_table, 0x00, sizeof(u16_table));
+    // 入出力位置
+    size_t t_src_pos = 0;
+    size_t t_dst_pos = 0;
+    // 制御バイトの位置とビット
+    size_t t_ctl_pos = 0;
+    uint8_t u8_ctl_bit = 0;
+    while (t_src_pos < t_src_len) {
+        //----------------------------------------------------------------------
+        // 制御バイトの確保
+        //----------------------------------------------------------------------
+        if (u8_ctl_bit == 0) {
+            if (t_dst_pos >= t_dst_cap) {
+                return 0;
+            }
+            t_ctl_pos = t_dst_pos++;
+            pu8_dst[t_ctl_pos] = 0x00;
+            u8_ctl_bit = 0x01;
+        }
+
+        //----------------------------------------------------------------------
+        // 一致の探索（直近の同一ハッシュ位置）
+        //----------------------------------------------------------------------
+        size_t t_match_len = 0;
+        size_t t_match_dist = 0;
+        if (t_src_pos + LZ_MIN_MATCH <= t_src_len) {
+            uint32_t u32_hash = u32_lz_hash(&pu8_src[t_src_pos]);
+            size_t t_cand = u16_table[u32_hash];
+            u16_table[u32_hash] = (uint16_t)(t_src_pos + 1);
+            if (t_cand > 0 && t_src_pos - (t_cand - 1) <= COM_LZ_WINDOW_SIZE) {
+                t_cand--;
+                size_t t_max = t_src_len - t_src_pos;
+                if (t_max > LZ_MAX_MATCH) {
+                    t_max = LZ_MAX_MATCH;
+                }
+                while (t_match_len < t_max && pu8_src[t_cand + t_match_len] == pu8_src[t_src_pos + t_match_len]) {
+                    t_match_len++;
+                }
+                t_match_dist = t_src_pos - t_cand;
+            }
+        }
+
+        //----------------------------------------------------------------------
+        // 要素の出力
+        //----------------------------------------------------------------------
+        if (t_match_len >= LZ_MIN_MATCH) {
+            // 一致
+            if (t_dst_pos + LZ_SIZE_MATCH > t_dst_cap) {
+                return 0;
+            }
+            size_t t_code = t_match_dist - 1;
+            pu8_dst[t_dst_pos]     = (uint8_t)(t_code & 0xFF);
+            pu8_dst[t_dst_pos + 1] = (uint8_t)(((t_code >> 8) << 4) | (t_match_len - LZ_MIN_MATCH));
+            t_dst_pos += LZ_SIZE_MATCH;
+            pu8_dst[t_ctl_pos] |= u8_ctl_bit;
+            // 一致範囲内の位置もハッシュテーブルに登録
+            size_t t_end = t_src_pos + t_match_len;
+            for (t_src_pos++; t_src_pos < t_end; t_src_pos++) {
+                if (t_src_pos + LZ_MIN_MATCH <= t_src_len) {
+                    u16_table[u32_lz_hash(&pu8_src[t_src_pos])] = (uint16_t)(t_src_pos + 1);
+                }
+            }
+        } else {
+            // リテラル
+            if (t_dst_pos >= t_dst_cap) {
+                return 0;
+            }
+            pu8_dst[t_dst_pos++] = pu8_src[t_src_pos++];
+        }
+        u8_ctl_bit <<= 1;
+    }
+    // 結果返信
+    return t_dst_pos;
+}
+
+/*******************************************************************************
+ *
+ * NAME: b_lz_decompress
+ *
+ * DESCRIPTION:LZ伸長
+ *
+ * PARAMETERS:      Name        RW  Usage
+ *   uint8_t*       pu8_src     R   圧縮データ
+ *   size_t         t_src_len   R   圧縮データのサイズ
+ *   uint8_t*       pu8_dst     W   出力バッファ
+ *   size_t         t_dst_cap   R   出力バッファのサイズ
+ *   size_t*        pt_dst_len  W   伸長後のサイズ
+ *
+ * RETURNS:
+ *   true:正常終了
+ *
+ * NOTES:
+ * 不正な圧縮データ（範囲外の距離、出力バッファ超過）の場合はfalseを返す。
+ ******************************************************************************/
+bool b_lz_decompress(const uint8_t* pu8_src, size_t t_src_len,
+                     uint8_t* pu8_dst, size_t t_dst_cap, size_t* pt_dst_len) {
+    // 入力チェック
+    if (pu8_src == NULL || pu8_dst == NULL || pt_dst_len == NULL) {
+        return false;
+    }
+    // 入出力位置
+    size_t t_src_pos = 0;
+    size_t t_dst_pos = 0;
+    // 制御バイトとビット
+    uint8_t u8_ctl = 0;
+    uint8_t u8_ctl_bit = 0;
+    while (t_src_pos < t_src_len) {
+        // 制御バイトの読み込み
+        if (u8_ctl_bit == 0) {
+            u8_ctl = pu8_src[t_src_pos++];
+            u8_ctl_bit = 0x01;
+            if (t_src_pos >= t_src_len) {
+                // 末尾の制御バイトのみは不正
+                return false;
+            }
+        }
+        if ((u8_ctl & u8_ctl_bit) == 0x00) {
+            // リテラル
+            if (t_dst_pos >= t_dst_cap) {
+                return false;
+            }
+            pu8_dst[t_dst_pos++] = pu8_src[t_src_pos++];
+        } else {
+            // 一致
+            if (t_src_pos + LZ_SIZE_MATCH > t_src_len) {
+                return false;
+            }
+            size_t t_dist = (((size_t)(pu8_src[t_src_pos + 1] >> 4) << 8) | pu8_src[t_src_pos]) + 1;
+            size_t t_len  = (pu8_src[t_src_pos + 1] & 0x0F) + LZ_MIN_MATCH;
+            t_src_pos += LZ_SIZE_MATCH;
+            if (t_dist > t_dst_pos || t_dst_pos + t_len > t_dst_cap) {
+                return false;
+            }
+            // 重複する範囲が有るのでバイト単位で複写
+            const uint8_t* pu8_ref = &pu8_dst[t_dst_pos - t_dist];
+            for (size_t t_idx = 0; t_idx < t_len; t_idx++) {
+                pu8_dst[t_dst_pos + t_idx] = pu8_ref[t_idx];
+            }
+            t_dst_pos += t_len;
+        }
+        u8_ctl_bit <<= 1;
+    }
+    // 結果返信
+    *pt_dst_len = t_dst_pos;
+    return true;
+}
+
+/******************************************************************************/
+/***      END OF FILE                                                       ***/
+/******************************************************************************/
@@ -0,0 +1,732 @@
+/*******************************************************************************
+ *
+ * COMPONENT:Nano Toolkit Framework
+ *
+ * MODULE :common timer wheel service source file
+ *
+ * CREATED:2024/11/02 10:00:00
+ * AUTHOR :Kakuheiki.Nakanohito
+ *
+ * DESCRIPTION:階層型タイマーホイールによるタイマーサービス
+ *   タイマーの開始・停止はO(1)で処理し、満了したタイマーのコールバックは
+ *   単一のサービスタスクから呼び出す。サービスタスクは次の満了時刻まで
+ *   タスク通知待ちで休止し、タイマーが無い場合は無期限に休止する。
+ *
+ * CHANGE HISTORY:
+ *
+ * LAST MODIFIED BY:
+ *
+ *******************************************************************************
+ *
+ * Copyright (c) 2024 Kakuheiki.Nakanohito
+ * Released under the MIT license
+ * https://opensource.org/licenses/mit-license.php
+ *
+ ******************************************************************************/
+/******************************************************************************/
+/***      Include files                                                     ***/
+/******************************************************************************/
+#include "ntfw_com_timer_wheel.h"
+
+#include <string.h>
+#include <freertos/semphr.h>
+
+
+/******************************************************************************/
+/***      Macro Definitions                                                 ***/
+/******************************************************************************/
+/** スロットインデックスのマスク */
+#define TMW_SLOT_MASK       (TMW_WHEEL_SLOTS - 1)
+/** ホイール全体で表現可能なティック数 */
+#define TMW_WHEEL_SPAN      ((TickType_t)1 << (TMW_WHEEL_SLOT_BITS * TMW_WHEEL_LEVELS))
+/** 満了待ちリストを示す階層番号 */
+#define TMW_LEVEL_PENDING   (TMW_WHEEL_LEVELS)
+
+/******************************************************************************/
+/***      Type Definitions                                                  ***/
+/******************************************************************************/
+/**
+ * タイマーホイール
+ */
+typedef struct {
+    TickType_t t_now;                                               // 処理済みティック
+    uint32_t u32_count;                                             // ホイール上のタイマー数
+    uint64_t u64_bitmap[TMW_WHEEL_LEVELS];                          // スロット使用状況
+    ts_tmw_timer_t* ps_slot[TMW_WHEEL_LEVELS][TMW_WHEEL_SLOTS];     // スロット
+    ts_tmw_timer_t* ps_pending;                                     // 満了待ちリスト
+} ts_tmw_wheel_t;
+
+/******************************************************************************/
+/***      Exported Variables                                                ***/
+/******************************************************************************/
+
+/******************************************************************************/
+/***      Local Variables                                                   ***/
+/******************************************************************************/
+/** 初期化用スピンロック */
+static portMUX_TYPE s_spinlock = portMUX_INITIALIZER_UNLOCKED;
+/** ミューテックスの領域 */
+static StaticSemaphore_t s_mutex_buffer;
+/** ミューテックス */
+static SemaphoreHandle_t s_mutex = NULL;
+/** サービスタスクハンドル */
+static TaskHandle_t s_service_handle = NULL;
+/** タイマーホイール */
+static ts_tmw_wheel_t s_wheel;
+
+/******************************************************************************/
+/***      Local Function Prototypes                                         ***/
+/******************************************************************************/
+/** サービスタスク */
+static void v_tmw_service_task(void* pv_parameters);
+/** ミリ秒からティックへの変換 */
+static TickType_t t_tmw_msec_to_tick(uint32_t u32_msec);
+/** ホイールへのタイマー登録 */
+static void v_tmw_insert(ts_tmw_timer_t* ps_timer);
+/** リストへのタイマー追加 */
+static void v_tmw_link(ts_tmw_timer_t** pps_head, ts_tmw_timer_t* ps_timer);
+/** ホイールもしくは満了待ちリストからのタイマー削除 */
+static void v_tmw_unlink(ts_tmw_timer_t* ps_timer);
+/** 次に処理が必要なティックの取得 */
+static bool b_tmw_next_tick(TickType_t* pt_next);
+/** 指定ティックまでホイールを進める */
+static void v_tmw_advance(TickType_t t_target);
+/** 現在ティックのカスケード及び満了処理 */
+static void v_tmw_process_tick();
+/** 満了待ちタイマーのコールバック実行 */
+static void v_tmw_dispatch();
+
+/******************************************************************************/
+/***      Exported Functions                                                ***/
+/******************************************************************************/
+
+/*******************************************************************************
+ *
+ * NAME: sts_tmw_begin_service
+ *
+ * DESCRIPTION:タイマーサービスの開始
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *
+ * RETURNS:
+ *   esp_err_t:結果ステータス
+ *
+ * NOTES:
+ * 開始済みの場合には何もせずに正常終了する
+ ******************************************************************************/
+esp_err_t sts_tmw_begin_service() {
+    //==========================================================================
+    // ミューテックスの生成（静的領域を利用する為、クリティカルセクション内で生成）
+    //==========================================================================
+    taskENTER_CRITICAL(&s_spinlock);
+    if (s_mutex == NULL) {
+        s_mutex = xSemaphoreCreateRecursiveMutexStatic(&s_mutex_buffer);
+    }
+    taskEXIT_CRITICAL(&s_spinlock);
+
+    //==========================================================================
+    // クリティカルセクション開始
+    //==========================================================================
+    if (xSemaphoreTakeRecursive(s_mutex, portMAX_DELAY) != pdTRUE) {
+        return ESP_ERR_TIMEOUT;
+    }
+
+    //==========================================================================
+    // サービスタスクの開始
+    //==========================================================================
+    esp_err_t sts_val = ESP_OK;
+    if (s_service_handle == NULL) {
+        // ホイールの初期化
+        memset(&s_wheel, 0x00, sizeof(ts_tmw_wheel_t));
+        s_wheel.t_now = xTaskGetTickCount();
+        // タスク生成
+        portBASE_TYPE b_type = xTaskCreatePinnedToCore(v_tmw_service_task,
+                                                       "tmw_service_task",
+                                                       TMW_SERVICE_STACK_DEPTH,
+                                                       NULL,
+                                                       TMW_SERVICE_PRIORITIES,
+                                                       &s_service_handle,
+                                                       tskNO_AFFINITY);
+        if (b_type != pdPASS) {
+            s_service_handle = NULL;
+            sts_val = ESP_FAIL;
+        }
+    }
+
+    //==========================================================================
+    // クリティカルセクション終了
+    //==========================================================================
+    xSemaphoreGiveRecursive(s_mutex);
+
+    // 結果返信
+    return sts_val;
+}
+
+/*******************************************************************************
+ *
+ * NAME: v_tmw_init_timer
+ *
+ * DESCRIPTION:タイマー情報の初期化
+ *
+ * PARAMETERS:          Name        RW  Usage
+ *   ts_tmw_timer_t*    ps_timer    W   対象タイマー
+ *   tf_tmw_timer_cb_t  pf_cb       R   コールバック関数
+ *   void*              pv_arg      R   コールバック引数
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * 登録中のタイマーに対しては実行しない事
+ ******************************************************************************/
+void v_tmw_init_timer(ts_tmw_timer_t* ps_timer, tf_tmw_timer_cb_t pf_cb, void* pv_arg) {
+    if (ps_timer == NULL) {
+        return;
+    }
+    memset(ps_timer, 0x00, sizeof(ts_tmw_timer_t));
+    ps_timer->pf_cb  = pf_cb;
+    ps_timer->pv_arg = pv_arg;
+}
+
+/*******************************************************************************
+ *
+ * NAME: sts_tmw_start
+ *
+ * DESCRIPTION:タイマーの開始
+ *
+ * PARAMETERS:          Name            RW  Usage
+ *   ts_tmw_timer_t*    ps_timer        RW  対象タイマー
+ *   uint32_t           u32_delay_ms    R   満了までの時間（ミリ秒）
+ *   uint32_t           u32_period_ms   R   周期（ミリ秒、0はワンショット）
+ *
+ * RETURNS:
+ *   esp_err_t:結果ステータス
+ *
+ * NOTES:
+ * 登録済みのタイマーは一旦停止してから再登録する
+ ******************************************************************************/
+esp_err_t sts_tmw_start(ts_tmw_timer_t* ps_timer, uint32_t u32_delay_ms, uint32_t u32_period_ms) {
+    //==========================================================================
+    // 入力チェック
+    //==========================================================================
+    if (ps_timer == NULL || ps_timer->pf_cb == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (s_service_handle == NULL) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    //==========================================================================
+    // クリティカルセクション開始
+    //==========================================================================
+    if (xSemaphoreTakeRecursive(s_mutex, portMAX_DELAY) != pdTRUE) {
+        return ESP_ERR_TIMEOUT;
+    }
+
+    //==========================================================================
+    // タイマー登録
+    //==========================================================================
+    // 登録済みの場合は削除
+    if (ps_timer->b_active) {
+        v_tmw_unlink(ps_timer);
+    }
+    // ホイールが空の場合は処理済みティックを現在に合わせる
+    TickType_t t_tick = xTaskGetTickCount();
+    if (s_wheel.u32_count == 0 && s_wheel.ps_pending == NULL) {
+        s_wheel.t_now = t_tick;
+    }
+    // 満了ティック　※処理済みティック以前は次のティックに丸める
+    ps_timer->t_expire = t_tick + t_tmw_msec_to_tick(u32_delay_ms);
+    if ((int32_t)(ps_timer->t_expire - s_wheel.t_now) <= 0) {
+        ps_timer->t_expire = s_wheel.t_now + 1;
+    }
+    // 周期ティック
+    ps_timer->t_period = t_tmw_msec_to_tick(u32_period_ms);
+    if (u32_period_ms > 0 && ps_timer->t_period == 0) {
+        ps_timer->t_period = 1;
+    }
+    // 登録
+    v_tmw_insert(ps_timer);
+
+    //==========================================================================
+    // クリティカルセクション終了
+    //==========================================================================
+    xSemaphoreGiveRecursive(s_mutex);
+
+    //==========================================================================
+    // サービスタスクへ通知（待ち時間の再計算）
+    //==========================================================================
+    xTaskNotifyGive(s_service_handle);
+
+    // 正常終了
+    return ESP_OK;
+}
+
+/*******************************************************************************
+ *
+ * NAME: sts_tmw_stop
+ *
+ * DESCRIPTION:タイマーの停止
+ *
+ * PARAMETERS:          Name        RW  Usage
+ *   ts_tmw_timer_t*    ps_timer    RW  対象タイマー
+ *
+ * RETURNS:
+ *   esp_err_t:結果ステータス
+ *
+ * NOTES:
+ * 停止時点で既に実行中のコールバックは中断しない
+ ******************************************************************************/
+esp_err_t sts_tmw_stop(ts_tmw_timer_t* ps_timer) {
+    //==========================================================================
+    // 入力チェック
+    //==========================================================================
+    if (ps_timer == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (s_mutex == NULL) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    //==========================================================================
+    // クリティカルセクション開始
+    //==========================================================================
+    if (xSemaphoreTakeRecursive(s_mutex, portMAX_DELAY) != pdTRUE) {
+        return ESP_ERR_TIMEOUT;
+    }
+
+    //==========================================================================
+    // タイマー削除
+    //==========================================================================
+    if (ps_timer->b_active) {
+        v_tmw_unlink(ps_timer);
+    }
+
+    //==========================================================================
+    // クリティカルセクション終了
+    //==========================================================================
+    xSemaphoreGiveRecursive(s_mutex);
+
+    // 正常終了
+    return ESP_OK;
+}
+
+/*******************************************************************************
+ *
+ * NAME: b_tmw_is_active
+ *
+ * DESCRIPTION:タイマーの登録判定
+ *
+ * PARAMETERS:          Name        RW  Usage
+ *   ts_tmw_timer_t*    ps_timer    R   対象タイマー
+ *
+ * RETURNS:
+ *   bool:登録中（満了待ちを含む）の場合はtrue
+ *
+ * NOTES:
+ * None.
+ ******************************************************************************/
+bool b_tmw_is_active(ts_tmw_timer_t* ps_timer) {
+    if (ps_timer == NULL) {
+        return false;
+    }
+    return ps_timer->b_active;
+}
+
+/******************************************************************************/
+/***      Local Functions                                                   ***/
+/******************************************************************************/
+
+/*******************************************************************************
+ *
+ * NAME: v_tmw_service_task
+ *
+ * DESCRIPTION:タイマーサービスタスク
+ *
+ * PARAMETERS:  Name            RW  Usage
+ * void*        pv_parameters   R   パラメータ
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * None.
+ ******************************************************************************/
+static void v_tmw_service_task(void* pv_parameters) {
+    // 次回処理ティック
+    TickType_t t_next = 0;
+    // 待ち時間
+    TickType_t t_wait = portMAX_DELAY;
+    // サービスタスクの無限ループ
+    while (true) {
+        //======================================================================
+        // ホイールを現在ティックまで進める
+        //======================================================================
+        if (xSemaphoreTakeRecursive(s_mutex, portMAX_DELAY) == pdTRUE) {
+            v_tmw_advance(xTaskGetTickCount());
+            xSemaphoreGiveRecursive(s_mutex);
+        }
+
+        //======================================================================
+        // 満了したタイマーのコールバックを実行
+        //======================================================================
+        v_tmw_dispatch();
+
+        //======================================================================
+        // 待ち時間の算出　※タイマーが無い場合は無期限
+        //======================================================================
+        t_wait = portMAX_DELAY;
+        if (xSemaphoreTakeRecursive(s_mutex, portMAX_DELAY) == pdTRUE) {
+            if (b_tmw_next_tick(&t_next)) {
+                t_wait = t_next - xTaskGetTickCount();
+                if ((int32_t)t_wait < 0) {
+                    t_wait = 0;
+                }
+            }
+            xSemaphoreGiveRecursive(s_mutex);
+        }
+
+        //======================================================================
+        // 次の満了時刻もしくはタイマー操作の通知まで休止
+        //======================================================================
+        ulTaskNotifyTake(pdTRUE, t_wait);
+    }
+
+    //==========================================================================
+    // タスク削除
+    //==========================================================================
+    vTaskDelete(NULL);
+}
+
+/*******************************************************************************
+ *
+ * NAME: t_tmw_msec_to_tick
+ *
+ * DESCRIPTION:ミリ秒からティックへの変換
+ *
+ * PARAMETERS:  Name        RW  Usage
+ * uint32_t     u32_msec    R   ミリ秒
+ *
+ * RETURNS:
+ *   TickType_t:ティック数
+ *
+ * NOTES:
+ * pdMS_TO_TICKSは大きな値で桁溢れする為、64bitで演算する
+ ******************************************************************************/
+static TickType_t t_tmw_msec_to_tick(uint32_t u32_msec) {
+    return (TickType_t)(((uint64_t)u32_msec * configTICK_RATE_HZ) / 1000);
+}
+
+/*******************************************************************************
+ *
+ * NAME: v_tmw_insert
+ *
+ * DESCRIPTION:ホイールへのタイマー登録
+ *
+ * PARAMETERS:          Name        RW  Usage
+ *   ts_tmw_timer_t*    ps_timer    RW  対象タイマー
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * 満了までの残りティック数で階層を決定し、満了ティックでスロットを決定する。
+ * ホイールの範囲を超える場合は最上位階層の末尾に登録し、満了時に再登録する。
+ ******************************************************************************/
+static void v_tmw_insert(ts_tmw_timer_t* ps_timer) {
+    //==========================================================================
+    // 登録位置の決定
+    //==========================================================================
+    // 残りティック数
+    TickType_t t_pos   = ps_timer->t_expire;
+    TickType_t t_delta = t_pos - s_wheel.t_now;
+    if ((int32_t)t_delta < 0) {
+        // 満了済み
+        t_pos   = s_wheel.t_now;
+        t_delta = 0;
+    } else if (t_delta >= TMW_WHEEL_SPAN) {
+        // ホイールの範囲外
+        t_pos   = s_wheel.t_now + TMW_WHEEL_SPAN - 1;
+        t_delta = TMW_WHEEL_SPAN - 1;
+    }
+    // 階層
+    uint8_t u8_level = 0;
+    while (u8_level < (TMW_WHEEL_LEVELS - 1) &&
+           t_delta >= ((TickType_t)1 << (TMW_WHEEL_SLOT_BITS * (u8_level + 1)))) {
+        u8_level++;
+    }
+    // スロット
+    uint8_t u8_slot = (t_pos >> (TMW_WHEEL_SLOT_BITS * u8_level)) & TMW_SLOT_MASK;
+
+    //==========================================================================
+    // スロットへ追加
+    //==========================================================================
+    ps_timer->u8_level = u8_level;
+    ps_timer->u8_slot  = u8_slot;
+    v_tmw_link(&s_wheel.ps_slot[u8_level][u8_slot], ps_timer);
+    s_wheel.u64_bitmap[u8_level] |= ((uint64_t)1 << u8_slot);
+    s_wheel.u32_count++;
+}
+
+/*******************************************************************************
+ *
+ * NAME: v_tmw_link
+ *
+ * DESCRIPTION:リストの先頭へタイマーを追加
+ *
+ * PARAMETERS:          Name        RW  Usage
+ *   ts_tmw_timer_t**   pps_head    RW  リストの先頭
+ *   ts_tmw_timer_t*    ps_timer    RW  対象タイマー
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * None.
+ ******************************************************************************/
+static void v_tmw_link(ts_tmw_timer_t** pps_head, ts_tmw_timer_t* ps_timer) {
+    ps_timer->ps_prev = NULL;
+    ps_timer->ps_next = *pps_head;
+    if (*pps_head != NULL) {
+        (*pps_head)->ps_prev = ps_timer;
+    }
+    *pps_head = ps_timer;
+    ps_timer->b_active = true;
+}
+
+/*******************************************************************************
+ *
+ * NAME: v_tmw_unlink
+ *
+ * DESCRIPTION:ホイールもしくは満了待ちリストからのタイマー削除
+ *
+ * PARAMETERS:          Name        RW  Usage
+ *   ts_tmw_timer_t*    ps_timer    RW  対象タイマー
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * None.
+ ******************************************************************************/
+static void v_tmw_unlink(ts_tmw_timer_t* ps_timer) {
+    // 所属リストの先頭
+    ts_tmw_timer_t** pps_head = &s_wheel.ps_pending;
+    if (ps_timer->u8_level < TMW_LEVEL_PENDING) {
+        pps_head = &s_wheel.ps_slot[ps_timer->u8_level][ps_timer->u8_slot];
+    }
+    // リストから削除
+    if (ps_timer->ps_prev != NULL) {
+        ps_timer->ps_prev->ps_next = ps_timer->ps_next;
+    } else {
+        *pps_head = ps_timer->ps_next;
+    }
+    if (ps_timer->ps_next != NULL) {
+        ps_timer->ps_next->ps_prev = ps_timer->ps_prev;
+    }
+    ps_timer->ps_prev  = NULL;
+    ps_timer->ps_next  = NULL;
+    ps_timer->b_active = false;
+    // ホイール上のタイマーの場合は使用状況を更新
+    if (ps_timer->u8_level < TMW_LEVEL_PENDING) {
+        if (*pps_head == NULL) {
+            s_wheel.u64_bitmap[ps_timer->u8_level] &= ~((uint64_t)1 << ps_timer->u8_slot);
+        }
+        s_wheel.u32_count--;
+    }
+}
+
+/*******************************************************************************
+ *
+ * NAME: b_tmw_next_tick
+ *
+ * DESCRIPTION:次に処理（カスケードもしくは満了）が必要なティックの取得
+ *
+ * PARAMETERS:      Name        RW  Usage
+ *   TickType_t*    pt_next     W   次に処理が必要なティック
+ *
+ * RETURNS:
+ *   bool:ホイールにタイマーが存在しない場合はfalse
+ *
+ * NOTES:
+ * 階層毎の使用状況ビットマップから求める為、タイマー数に依存しない
+ ******************************************************************************/
+static bool b_tmw_next_tick(TickType_t* pt_next) {
+    // 判定結果
+    bool b_found = false;
+    // 処理済みティックからの最小の差分
+    TickType_t t_min_delta = 0;
+    // 階層毎に判定
+    uint8_t u8_level;
+    for (u8_level = 0; u8_level < TMW_WHEEL_LEVELS; u8_level++) {
+        // 使用状況
+        uint64_t u64_bitmap = s_wheel.u64_bitmap[u8_level];
+        if (u64_bitmap == 0) {
+            continue;
+        }
+        // 現在のスロットと周回の起点
+        uint32_t u32_shift = TMW_WHEEL_SLOT_BITS * u8_level;
+        uint32_t u32_idx   = (s_wheel.t_now >> u32_shift) & TMW_SLOT_MASK;
+        TickType_t t_round = (TickType_t)1 << (u32_shift + TMW_WHEEL_SLOT_BITS);
+        TickType_t t_base  = s_wheel.t_now & ~(t_round - 1);
+        // 現在のスロットより後ろの使用スロット
+        uint64_t u64_after = 0;
+        if (u32_idx < TMW_SLOT_MASK) {
+            u64_after = u64_bitmap & (~(uint64_t)0 << (u32_idx + 1));
+        }
+        // 処理ティックの算出　※後ろに無い場合は次の周回
+        TickType_t t_tick;
+        if (u64_after != 0) {
+            t_tick = t_base + ((TickType_t)__builtin_ctzll(u64_after) << u32_shift);
+        } else {
+            t_tick = t_base + t_round + ((TickType_t)__builtin_ctzll(u64_bitmap) << u32_shift);
+        }
+        // 最小値の判定
+        TickType_t t_delta = t_tick - s_wheel.t_now;
+        if (!b_found || t_delta < t_min_delta) {
+            t_min_delta = t_delta;
+            b_found = true;
+        }
+    }
+    // 結果返信
+    *pt_next = s_wheel.t_now + t_min_delta;
+    return b_found;
+}
+
+/*******************************************************************************
+ *
+ * NAME: v_tmw_advance
+ *
+ * DESCRIPTION:指定ティックまでホイールを進める
+ *
+ * PARAMETERS:      Name        RW  Usage
+ *   TickType_t     t_target    R   目標ティック
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * 処理が必要なティックのみを辿る為、休止期間の長さに依存しない
+ ******************************************************************************/
+static void v_tmw_advance(TickType_t t_target) {
+    TickType_t t_next;
+    while (s_wheel.t_now != t_target) {
+        // 目標ティックまでに処理が必要なティックが無い場合
+        if (!b_tmw_next_tick(&t_next) ||
+            (TickType_t)(t_next - s_wheel.t_now) > (TickType_t)(t_target - s_wheel.t_now)) {
+            s_wheel.t_now = t_target;
+            break;
+        }
+        // 次の処理ティックへ移動
+        s_wheel.t_now = t_next;
+        v_tmw_process_tick();
+    }
+}
+
+/*******************************************************************************
+ *
+ * NAME: v_tmw_process_tick
+ *
+ * DESCRIPTION:処理済みティックにおけるカスケード及び満了処理
+ *
+ * PARAMETERS:      Name        RW  Usage
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * 満了したタイマーは満了待ちリストへ移動する
+ ******************************************************************************/
+static void v_tmw_process_tick() {
+    //==========================================================================
+    // 上位階層のカスケード
+    //==========================================================================
+    ts_tmw_timer_t* ps_list;
+    ts_tmw_timer_t* ps_timer;
+    uint8_t u8_level;
+    for (u8_level = 1; u8_level < TMW_WHEEL_LEVELS; u8_level++) {
+        // 下位階層が周回していない場合は終了
+        uint32_t u32_shift = TMW_WHEEL_SLOT_BITS * u8_level;
+        if ((s_wheel.t_now & (((TickType_t)1 << u32_shift) - 1)) != 0) {
+            break;
+        }
+        // スロットのタイマーを残り時間に応じて再登録
+        uint8_t u8_slot = (s_wheel.t_now >> u32_shift) & TMW_SLOT_MASK;
+        ps_list = s_wheel.ps_slot[u8_level][u8_slot];
+        s_wheel.ps_slot[u8_level][u8_slot] = NULL;
+        s_wheel.u64_bitmap[u8_level] &= ~((uint64_t)1 << u8_slot);
+        while (ps_list != NULL) {
+            ps_timer = ps_list;
+            ps_list  = ps_list->ps_next;
+            s_wheel.u32_count--;
+            v_tmw_insert(ps_timer);
+        }
+    }
+
+    //==========================================================================
+    // 最下位階層の満了処理
+    //==========================================================================
+    uint8_t u8_slot = s_wheel.t_now & TMW_SLOT_MASK;
+    ps_list = s_wheel.ps_slot[0][u8_slot];
+    s_wheel.ps_slot[0][u8_slot] = NULL;
+    s_wheel.u64_bitmap[0] &= ~((uint64_t)1 << u8_slot);
+    while (ps_list != NULL) {
+        ps_timer = ps_list;
+        ps_list  = ps_list->ps_next;
+        s_wheel.u32_count--;
+        if ((int32_t)(ps_timer->t_expire - s_wheel.t_now) > 0) {
+            // ホイールの範囲外だったタイマーは再登録
+            v_tmw_insert(ps_timer);
+        } else {
+            // 満了待ちリストへ移動
+            ps_timer->u8_level = TMW_LEVEL_PENDING;
+            v_tmw_link(&s_wheel.ps_pending, ps_timer);
+        }
+    }
+}
+
+/*******************************************************************************
+ *
+ * NAME: v_tmw_dispatch
+ *
+ * DESCRIPTION:満了待ちタイマーのコールバック実行
+ *
+ * PARAMETERS:      Name        RW  Usage
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * コールバック内からのタイマー操作を可能にする為、
+ * コールバックはミューテックスを解放した状態で呼び出す
+ ******************************************************************************/
+static void v_tmw_dispatch() {
+    tf_tmw_timer_cb_t pf_cb;
+    void* pv_arg;
+    while (true) {
+        //======================================================================
+        // 満了待ちタイマーの取り出し
+        //======================================================================
+        if (xSemaphoreTakeRecursive(s_mutex, portMAX_DELAY) != pdTRUE) {
+            return;
+        }
+        ts_tmw_timer_t* ps_timer = s_wheel.ps_pending;
+        if (ps_timer == NULL) {
+            xSemaphoreGiveRecursive(s_mutex);
+            return;
+        }
+        v_tmw_unlink(ps_timer);
+        // 周期タイマーは再登録　※遅延時は位相を保ったまま次のティックに丸める
+        if (ps_timer->t_period > 0) {
+            ps_timer->t_expire += ps_timer->t_period;
+            if ((int32_t)(ps_timer->t_expire - s_wheel.t_now) <= 0) {
+                ps_timer->t_expire = s_wheel.t_now + 1;
+            }
+            v_tmw_insert(ps_timer);
+        }
+        pf_cb  = ps_timer->pf_cb;
+        pv_arg = ps_timer->pv_arg;
+        xSemaphoreGiveRecursive(s_mutex);
+
+        //======================================================================
+        // コールバック実行
+        //======================================================================
+        pf_cb(pv_arg);
+    }
+}
+
+/******************************************************************************/
+/***      END OF FILE                                                       ***/
+/******************************************************************************/
@@ -0,0 +1,256 @@
+/*******************************************************************************
+ *
+ * COMPONENT:Nano Toolkit Framework
+ *
+ * MODULE :common value kernel functions source file
+ *
+ * CREATED:2024/11/20 21:00:00
+ * AUTHOR :Kakuheiki.Nakanohito
+ *
+ * DESCRIPTION:バイト列の一括演算（XOR、マスキング、パターン埋め、定数時間比較）
+ *   先頭の端数をバイト単位で処理してアドレスを4byte境界に揃え、以降を32bit単位で処理する。
+ *   ESP32（Xtensa）は非整列の32bitアクセスが例外となる為、境界が揃わない組み合わせは
+ *   バイト単位で処理する
+ *
+ * CHANGE HISTORY:
+ *
+ * LAST MODIFIED BY:
+ *
+ *******************************************************************************
+ *
+ * Copyright (c) 2024 Kakuheiki.Nakanohito
+ * Released under the MIT license
+ * https://opensource.org/licenses/mit-license.php
+ *
+ ******************************************************************************/
+
+/******************************************************************************/
+/***      Include files                                                     ***/
+/******************************************************************************/
+#include "ntfw_com_value_kernel.h"
+
+/******************************************************************************/
+/***      Macro Definitions                                                 ***/
+/******************************************************************************/
+/** 32bitアクセスのアドレス境界マスク */
+#define VUTIL_WORD_MASK         (0x03)
+/** リトルエンディアン判定（バイト位置に依存する演算のワード処理可否） */
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+    #define VUTIL_WORD_LE       (1)
+#else
+    #define VUTIL_WORD_LE       (0)
+#endif
+/** アドレスの境界判定 */
+#define b_word_aligned(pv)      ((((uintptr_t)(pv)) & VUTIL_WORD_MASK) == 0)
+/** 32bit左ローテート（u32_bitsは0～31） */
+#define u32_rotl(u32_val, u32_bits) \
+    (((u32_bits) == 0) ? (u32_val) : (((u32_val) << (u32_bits)) | ((u32_val) >> (32 - (u32_bits)))))
+
+/******************************************************************************/
+/***      Type Definitions                                                  ***/
+/******************************************************************************/
+/** バイト列を参照する32bitワード（型エイリアス規則の対象外） */
+typedef uint32_t __attribute__((__may_alias__)) tu32_word_t;
+
+/******************************************************************************/
+/***      Exported Variables                                                ***/
+/******************************************************************************/
+
+/******************************************************************************/
+/***      Local Variables                                                   ***/
+/******************************************************************************/
+
+/******************************************************************************/
+/***      Local Function Prototypes                                         ***/
+/******************************************************************************/
+
+/******************************************************************************/
+/***      Exported Functions                                                ***/
+/******************************************************************************/
+
+/*******************************************************************************
+ *
+ * NAME: v_vutil_xor_into
+ *
+ * DESCRIPTION:一括演算：排他的論理和（pu8_dst ^= pu8_src）
+ *
+ * PARAMETERS:      Name        RW  Usage
+ *   uint8_t*       pu8_dst     RW  演算対象
+ *   uint8_t*       pu8_src     R   演算値
+ *   size_t         t_len       R   演算サイズ
+ *
+ * RETURNS:
+ *
+ ******************************************************************************/
+void v_vutil_xor_into(uint8_t* pu8_dst, const uint8_t* pu8_src, size_t t_len) {
+    // 入力チェック
+    if (pu8_dst == NULL || pu8_src == NULL) {
+        return;
+    }
+    // 双方のアドレス境界が揃う場合はワード単位
+    if ((((uintptr_t)pu8_dst ^ (uintptr_t)pu8_src) & VUTIL_WORD_MASK) == 0) {
+        // 先頭の端数
+        while (t_len > 0 && !b_word_aligned(pu8_dst)) {
+            *pu8_dst++ ^= *pu8_src++;
+            t_len--;
+        }
+        tu32_word_t* pu32_dst = (tu32_word_t*)pu8_dst;
+        const tu32_word_t* pu32_src = (const tu32_word_t*)pu8_src;
+        while (t_len >= 16) {
+            pu32_dst[0] ^= pu32_src[0];
+            pu32_dst[1] ^= pu32_src[1];
+            pu32_dst[2] ^= pu32_src[2];
+            pu32_dst[3] ^= pu32_src[3];
+            pu32_dst += 4;
+            pu32_src += 4;
+            t_len    -= 16;
+        }
+        while (t_len >= 4) {
+            *pu32_dst++ ^= *pu32_src++;
+            t_len -= 4;
+        }
+        pu8_dst = (uint8_t*)pu32_dst;
+        pu8_src = (const uint8_t*)pu32_src;
+    }
+    // 末尾の端数（又は境界が揃わない場合の全体）
+    while (t_len > 0) {
+        *pu8_dst++ ^= *pu8_src++;
+        t_len--;
+    }
+}
+
+/*******************************************************************************
+ *
+ * NAME: u32_vutil_xor_fold
+ *
+ * DESCRIPTION:一括演算：排他的論理和の畳み込み
+ *
+ * PARAMETERS:      Name        RW  Usage
+ *   uint8_t*       pu8_src     R   演算対象
+ *   size_t         t_len       R   演算サイズ
+ *
+ * RETURNS:
+ *   uint32_t:pu8_src[i]を(8 * (i % 4))bit左シフトした値の排他的論理和
+ *
+ * NOTES:
+ * 先頭の端数でアドレス境界を揃えた場合は、ワード単位の畳み込み結果をローテートして
+ * バイト位置を補正する
+ ******************************************************************************/
+uint32_t u32_vutil_xor_fold(const uint8_t* pu8_src, size_t t_len) {
+    // 入力チェック
+    if (pu8_src == NULL) {
+        return 0;
+    }
+    uint32_t u32_acc = 0;
+    size_t t_idx = 0;
+#if VUTIL_WORD_LE
+    // 先頭の端数
+    while (t_idx < t_len && !b_word_aligned(&pu8_src[t_idx])) {
+        u32_acc ^= (uint32_t)pu8_src[t_idx] << (8 * (t_idx & VUTIL_WORD_MASK));
+        t_idx++;
+    }
+    // ワード単位の畳み込み
+    uint32_t u32_word = 0;
+    uint32_t u32_rot = 8 * (t_idx & VUTIL_WORD_MASK);
+    for (; t_idx + 4 <= t_len; t_idx += 4) {
+        u32_word ^= *(const tu32_word_t*)&pu8_src[t_idx];
+    }
+    u32_acc ^= u32_rotl(u32_word, u32_rot);
+#endif
+    // 末尾の端数
+    for (; t_idx < t_len; t_idx++) {
+        u32_acc ^= (uint32_t)pu8_src[t_idx] << (8 * (t_idx & VUTIL_WORD_MASK));
+    }
+    return u32_acc;
+}
+
+/*******************************************************************************
+ *
+ * NAME: v_vutil_fill_u32
+ *
+ * DESCRIPTION:一括演算：32bitパターンによる埋め込み
+ *
+ * PARAMETERS:      Name        RW  Usage
+ *   uint8_t*       pu8_dst     W   編集対象
+ *   uint32_t       u32_pattern R   パターン（pu8_dst[i]は(8 * (i % 4))bit目からの値）
+ *   size_t         t_len       R   編集サイズ
+ *
+ * RETURNS:
+ *
+ ******************************************************************************/
+void v_vutil_fill_u32(uint8_t* pu8_dst, uint32_t u32_pattern, size_t t_len) {
+    // 入力チェック
+    if (pu8_dst == NULL) {
+        return;
+    }
+    size_t t_idx = 0;
+#if VUTIL_WORD_LE
+    // 先頭の端数
+    while (t_idx < t_len && !b_word_aligned(&pu8_dst[t_idx])) {
+        pu8_dst[t_idx] = (uint8_t)(u32_pattern >> (8 * (t_idx & VUTIL_WORD_MASK)));
+        t_idx++;
+    }
+    // ワード単位の書き込み（バイト位置を補正したパターン）
+    uint32_t u32_rot = 8 * (t_idx & VUTIL_WORD_MASK);
+    uint32_t u32_word = u32_rotl(u32_pattern, (32 - u32_rot) & 0x1F);
+    for (; t_idx + 4 <= t_len; t_idx += 4) {
+        *(tu32_word_t*)&pu8_dst[t_idx] = u32_word;
+    }
+#endif
+    // 末尾の端数
+    for (; t_idx < t_len; t_idx++) {
+        pu8_dst[t_idx] = (uint8_t)(u32_pattern >> (8 * (t_idx & VUTIL_WORD_MASK)));
+    }
+}
+
+/*******************************************************************************
+ *
+ * NAME: b_vutil_ct_equal
+ *
+ * DESCRIPTION:一括演算：定数時間比較
+ *
+ * PARAMETERS:      Name        RW  Usage
+ *   uint8_t*       pu8_val1    R   比較値１
+ *   uint8_t*       pu8_val2    R   比較値２
+ *   size_t         t_len       R   比較サイズ
+ *
+ * RETURNS:
+ *   true:一致
+ *
+ * NOTES:
+ * 不一致の位置に依らず全体を比較する（処理時間はサイズとアドレス境界のみに依存）
+ * 認証タグ等の秘密情報の比較にはmemcmpではなく本関数を利用する事
+ ******************************************************************************/
+bool b_vutil_ct_equal(const uint8_t* pu8_val1, const uint8_t* pu8_val2, size_t t_len) {
+    // 入力チェック
+    if (pu8_val1 == NULL || pu8_val2 == NULL) {
+        return false;
+    }
+    uint32_t u32_diff = 0;
+    // 双方のアドレス境界が揃う場合はワード単位
+    if ((((uintptr_t)pu8_val1 ^ (uintptr_t)pu8_val2) & VUTIL_WORD_MASK) == 0) {
+        // 先頭の端数
+        while (t_len > 0 && !b_word_aligned(pu8_val1)) {
+            u32_diff |= (uint32_t)(*pu8_val1++ ^ *pu8_val2++);
+            t_len--;
+        }
+        const tu32_word_t* pu32_val1 = (const tu32_word_t*)pu8_val1;
+        const tu32_word_t* pu32_val2 = (const tu32_word_t*)pu8_val2;
+        while (t_len >= 4) {
+            u32_diff |= *pu32_val1++ ^ *pu32_val2++;
+            t_len -= 4;
+        }
+        pu8_val1 = (const uint8_t*)pu32_val1;
+        pu8_val2 = (const uint8_t*)pu32_val2;
+    }
+    // 末尾の端数（又は境界が揃わない場合の全体）
+    while (t_len > 0) {
+        u32_diff |= (uint32_t)(*pu8_val1++ ^ *pu8_val2++);
+        t_len--;
+    }
+    return (u32_diff == 0);
+}
+
+/******************************************************************************/
+/***      END OF FILE                                                       ***/
+/******************************************************************************/
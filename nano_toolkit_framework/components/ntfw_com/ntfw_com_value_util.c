@@ -1536,13 +1536,11 @@ uint8_t u8_vutil_masking(uint8_t u8_val,
     if (pu8_mask == NULL) {
         return 0;
     }
-    // マスキング処理
-    uint8_t u8_wk_val = u8_val;
-    uint8_t u8_idx;
-    for (u8_idx = 0; u8_idx < u8_len; u8_idx++) {
-        u8_wk_val = u8_wk_val ^ pu8_mask[u8_idx];
-    }
-    return u8_wk_val;
+    // マスキング処理（ワード単位で畳み込み、1byteに縮約）
+    uint32_t u32_fold = u32_vutil_xor_fold(pu8_mask, u8_len);
+    u32_fold ^= u32_fold >> 16;
+    u32_fold ^= u32_fold >> 8;
+    return u8_val ^ (uint8_t)u32_fold;
 }
 
 /*******************************************************************************
@@ -1567,13 +1565,8 @@ uint32_t u32_vutil_masking(uint32_t u32_val,
     if (pu8_mask == NULL) {
         return 0;
     }
-    // マスキング処理
-    uint32_t u32_wk_val = u32_val;
-    uint8_t u8Idx;
-    for (u8Idx = 0; u8Idx < u8_len; u8Idx++) {
-        u32_wk_val = u32_wk_val ^ ((uint32_t)pu8_mask[u8Idx] << (8 * (u8Idx % 4)));
-    }
-    return u32_wk_val;
+    // マスキング処理（ワード単位で畳み込み）
+    return u32_val ^ u32_vutil_xor_fold(pu8_mask, u8_len);
 }
 
 /*******************************************************************************
@@ -1597,11 +1590,8 @@ void v_vutil_masking(uint8_t* pu8_token,
     if (pu8_token == NULL || pu8_mask == NULL || u8_len == 0) {
         return;
     }
-    // マスキング処理
-    uint8_t u8Idx;
-    for (u8Idx = 0; u8Idx < u8_len; u8Idx++) {
-        pu8_token[u8Idx] = pu8_token[u8Idx] ^ pu8_mask[u8Idx];
-    }
+    // マスキング処理（ワード単位）
+    v_vutil_xor_into(pu8_token, pu8_mask, u8_len);
 }
 
 /*******************************************************************************
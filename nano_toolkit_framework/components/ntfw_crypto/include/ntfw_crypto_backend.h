@@ -0,0 +1,160 @@
+/*******************************************************************************
+ *
+ * COMPONENT:Nano Toolkit Framework
+ *
+ * MODULE :Cryptography backend header file
+ *
+ * CREATED:2024/11/18 21:00:00
+ * AUTHOR :Kakuheiki.Nakanohito
+ *
+ * DESCRIPTION:暗号プリミティブのバックエンド選択（コンパイル時）
+ *   CRYPTO_BACKEND_MBEDTLS :mbedtls（ESP32ではCONFIG_MBEDTLS_HARDWARE_*によりHWアクセラレータ）
+ *   CRYPTO_BACKEND_PORTABLE:ESP-IDFに依存しないソフトウェア実装（Linux上でもビルド可能）
+ *   選択されたバックエンドのみをstatic inlineで展開する為、呼び出しのオーバーヘッドは無い
+ *
+ * CHANGE HISTORY:
+ *
+ * LAST MODIFIED BY:
+ *
+ *******************************************************************************
+ *
+ * Copyright (c) 2024 Kakuheiki.Nakanohito
+ * Released under the MIT license
+ * https://opensource.org/licenses/mit-license.php
+ *
+ ******************************************************************************/
+#ifndef  __NTFW_CRYPTO_BACKEND_H__
+#define  __NTFW_CRYPTO_BACKEND_H__
+
+
+#if defined __cplusplus
+extern "C" {
+#endif
+
+/******************************************************************************/
+/***      Include files                                                     ***/
+/******************************************************************************/
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+/******************************************************************************/
+/***      Macro Definitions                                                 ***/
+/******************************************************************************/
+/** バックエンド：mbedtls（ESP32ではHWアクセラレータ） */
+#define CRYPTO_BACKEND_MBEDTLS      (0)
+/** バックエンド：ポータブル実装 */
+#define CRYPTO_BACKEND_PORTABLE     (1)
+
+/** SHA-224/SHA-256のバックエンド */
+#ifndef CRYPTO_BACKEND_SHA256
+    #define CRYPTO_BACKEND_SHA256   (CRYPTO_BACKEND_MBEDTLS)
+#endif
+
+#if (CRYPTO_BACKEND_SHA256 == CRYPTO_BACKEND_MBEDTLS)
+    #include <mbedtls/sha256.h>
+#elif (CRYPTO_BACKEND_SHA256 == CRYPTO_BACKEND_PORTABLE)
+    #include "ntfw_crypto_sha256.h"
+#else
+    #error "CRYPTO_BACKEND_SHA256 is invalid"
+#endif
+
+/******************************************************************************/
+/***      Type Definitions                                                  ***/
+/******************************************************************************/
+/** SHA-224/SHA-256のバックエンドコンテキスト */
+#if (CRYPTO_BACKEND_SHA256 == CRYPTO_BACKEND_MBEDTLS)
+typedef mbedtls_sha256_context ts_crypto_be_sha256_t;
+#else
+typedef ts_crypto_sha256_context_t ts_crypto_be_sha256_t;
+#endif
+
+/******************************************************************************/
+/***      Exported Variables                                                ***/
+/******************************************************************************/
+
+/******************************************************************************/
+/***      Exported Function Prototypes                                      ***/
+/******************************************************************************/
+/**
+ * SHA-224/SHA-256：コンテキストの初期化
+ */
+static inline void v_crypto_be_sha256_init(ts_crypto_be_sha256_t* ps_ctx) {
+#if (CRYPTO_BACKEND_SHA256 == CRYPTO_BACKEND_MBEDTLS)
+    mbedtls_sha256_init(ps_ctx);
+#else
+    v_crypto_sha256_starts(ps_ctx, false);
+#endif
+}
+
+/**
+ * SHA-224/SHA-256：計算の開始（正常時は0を返却）
+ */
+static inline int i_crypto_be_sha256_starts(ts_crypto_be_sha256_t* ps_ctx, bool b_is224) {
+#if (CRYPTO_BACKEND_SHA256 == CRYPTO_BACKEND_MBEDTLS)
+    return mbedtls_sha256_starts(ps_ctx, b_is224 ? 1 : 0);
+#else
+    v_crypto_sha256_starts(ps_ctx, b_is224);
+    return 0;
+#endif
+}
+
+/**
+ * SHA-224/SHA-256：逐次計算（正常時は0を返却）
+ */
+static inline int i_crypto_be_sha256_update(ts_crypto_be_sha256_t* ps_ctx,
+                                            const uint8_t* pu8_data,
+                                            size_t t_len) {
+#if (CRYPTO_BACKEND_SHA256 == CRYPTO_BACKEND_MBEDTLS)
+    return mbedtls_sha256_update(ps_ctx, pu8_data, t_len);
+#else
+    v_crypto_sha256_update(ps_ctx, pu8_data, t_len);
+    return 0;
+#endif
+}
+
+/**
+ * SHA-224/SHA-256：ハッシュ値の書き出し（正常時は0を返却）
+ */
+static inline int i_crypto_be_sha256_finish(ts_crypto_be_sha256_t* ps_ctx, uint8_t* pu8_hash) {
+#if (CRYPTO_BACKEND_SHA256 == CRYPTO_BACKEND_MBEDTLS)
+    return mbedtls_sha256_finish(ps_ctx, pu8_hash);
+#else
+    v_crypto_sha256_finish(ps_ctx, pu8_hash);
+    return 0;
+#endif
+}
+
+/**
+ * SHA-224/SHA-256：コンテキストの複製
+ */
+static inline void v_crypto_be_sha256_clone(ts_crypto_be_sha256_t* ps_dst,
+                                            const ts_crypto_be_sha256_t* ps_src) {
+#if (CRYPTO_BACKEND_SHA256 == CRYPTO_BACKEND_MBEDTLS)
+    mbedtls_sha256_clone(ps_dst, ps_src);
+#else
+    *ps_dst = *ps_src;
+#endif
+}
+
+/**
+ * SHA-224/SHA-256：コンテキストの解放
+ */
+static inline void v_crypto_be_sha256_free(ts_crypto_be_sha256_t* ps_ctx) {
+#if (CRYPTO_BACKEND_SHA256 == CRYPTO_BACKEND_MBEDTLS)
+    mbedtls_sha256_free(ps_ctx);
+#else
+    memset(ps_ctx, 0x00, sizeof(ts_crypto_be_sha256_t));
+#endif
+}
+
+#if defined __cplusplus
+}
+#endif
+
+#endif /* __NTFW_CRYPTO_BACKEND_H__ */
+
+/******************************************************************************/
+/***      END OF FILE                                                       ***/
+/******************************************************************************/
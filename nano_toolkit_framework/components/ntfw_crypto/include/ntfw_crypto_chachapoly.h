@@ -0,0 +1,95 @@
+/*******************************************************************************
+ *
+ * COMPONENT:Nano Toolkit Framework
+ *
+ * MODULE :ChaCha20-Poly1305 library header file
+ *
+ * CREATED:2024/11/10 21:00:00
+ * AUTHOR :Kakuheiki.Nakanohito
+ *
+ * DESCRIPTION:ChaCha20-Poly1305（RFC 8439）の認証付き暗号
+ *   32bit演算のみで実装し、ESP-IDFに依存しない（Linux上でもビルド可能）
+ *
+ * CHANGE HISTORY:
+ *
+ * LAST MODIFIED BY:
+ *
+ *******************************************************************************
+ *
+ * Copyright (c) 2024 Kakuheiki.Nakanohito
+ * Released under the MIT license
+ * https://opensource.org/licenses/mit-license.php
+ *
+ ******************************************************************************/
+#ifndef  __NTFW_CRYPTO_CHACHAPOLY_H__
+#define  __NTFW_CRYPTO_CHACHAPOLY_H__
+
+
+#if defined __cplusplus
+extern "C" {
+#endif
+
+/******************************************************************************/
+/***      Include files                                                     ***/
+/******************************************************************************/
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+/******************************************************************************/
+/***      Macro Definitions                                                 ***/
+/******************************************************************************/
+/** ChaCha20 key size */
+#define CRYPTO_CHACHAPOLY_KEY_SIZE      (32)
+/** ChaCha20 nonce size */
+#define CRYPTO_CHACHAPOLY_NONCE_SIZE    (12)
+/** Poly1305 tag size */
+#define CRYPTO_CHACHAPOLY_TAG_SIZE      (16)
+/** ChaCha20 block size */
+#define CRYPTO_CHACHA20_BLOCK_SIZE      (64)
+
+/******************************************************************************/
+/***      Type Definitions                                                  ***/
+/******************************************************************************/
+
+/******************************************************************************/
+/***      Exported Variables                                                ***/
+/******************************************************************************/
+
+/******************************************************************************/
+/***      Exported Function Prototypes                                      ***/
+/******************************************************************************/
+/** ChaCha20による鍵ストリームのXOR（インプレース可） */
+extern void v_crypto_chacha20_xor(const uint8_t* pu8_key,
+                                  const uint8_t* pu8_nonce,
+                                  uint32_t u32_counter,
+                                  uint8_t* pu8_output,
+                                  const uint8_t* pu8_input,
+                                  size_t t_len);
+/** Poly1305によるメッセージ認証コード生成 */
+extern void v_crypto_poly1305_mac(const uint8_t* pu8_key,
+                                  const uint8_t* pu8_msg,
+                                  size_t t_msg_len,
+                                  uint8_t* pu8_tag);
+/** 暗号化処理(ChaCha20-Poly1305、インプレース) */
+extern void v_crypto_chachapoly_enc_in_place(const uint8_t* pu8_key,
+                                             const uint8_t* pu8_nonce,
+                                             const uint8_t* pu8_add, size_t t_add_len,
+                                             uint8_t* pu8_data, size_t t_data_len,
+                                             uint8_t* pu8_tag);
+/** 復号処理(ChaCha20-Poly1305、インプレース、認証タグ検証) */
+extern bool b_crypto_chachapoly_dec_in_place(const uint8_t* pu8_key,
+                                             const uint8_t* pu8_nonce,
+                                             const uint8_t* pu8_add, size_t t_add_len,
+                                             uint8_t* pu8_data, size_t t_data_len,
+                                             const uint8_t* pu8_tag);
+
+#if defined __cplusplus
+}
+#endif
+
+#endif /* __NTFW_CRYPTO_CHACHAPOLY_H__ */
+
+/******************************************************************************/
+/***      END OF FILE                                                       ***/
+/******************************************************************************/
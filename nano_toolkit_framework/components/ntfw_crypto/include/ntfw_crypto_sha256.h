@@ -0,0 +1,86 @@
+/*******************************************************************************
+ *
+ * COMPONENT:Nano Toolkit Framework
+ *
+ * MODULE :SHA-256 library header file
+ *
+ * CREATED:2024/11/18 21:00:00
+ * AUTHOR :Kakuheiki.Nakanohito
+ *
+ * DESCRIPTION:SHA-224/SHA-256（FIPS 180-4）のソフトウェア実装
+ *   ESP-IDFに依存しない（Linux上でもビルド可能）
+ *
+ * CHANGE HISTORY:
+ *
+ * LAST MODIFIED BY:
+ *
+ *******************************************************************************
+ *
+ * Copyright (c) 2024 Kakuheiki.Nakanohito
+ * Released under the MIT license
+ * https://opensource.org/licenses/mit-license.php
+ *
+ ******************************************************************************/
+#ifndef  __NTFW_CRYPTO_SHA256_H__
+#define  __NTFW_CRYPTO_SHA256_H__
+
+
+#if defined __cplusplus
+extern "C" {
+#endif
+
+/******************************************************************************/
+/***      Include files                                                     ***/
+/******************************************************************************/
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+/******************************************************************************/
+/***      Macro Definitions                                                 ***/
+/******************************************************************************/
+/** SHA-256 digest size */
+#define CRYPTO_SHA256_DIGEST_SIZE   (32)
+/** SHA-224 digest size */
+#define CRYPTO_SHA224_DIGEST_SIZE   (28)
+/** SHA-256 message block size */
+#define CRYPTO_SHA256_MSG_BLOCK     (64)
+
+/******************************************************************************/
+/***      Type Definitions                                                  ***/
+/******************************************************************************/
+/**
+ * SHA-256コンテキスト
+ */
+typedef struct {
+    uint32_t u32_state[8];                          // 中間ハッシュ値
+    uint64_t u64_total;                             // 入力済みバイト数
+    uint8_t u8_buff[CRYPTO_SHA256_MSG_BLOCK];       // 未処理ブロック
+    bool b_is224;                                   // SHA-224判定
+} ts_crypto_sha256_context_t;
+
+/******************************************************************************/
+/***      Exported Variables                                                ***/
+/******************************************************************************/
+
+/******************************************************************************/
+/***      Exported Function Prototypes                                      ***/
+/******************************************************************************/
+/** SHA-256（SHA-224）計算の開始 */
+extern void v_crypto_sha256_starts(ts_crypto_sha256_context_t* ps_ctx, bool b_is224);
+/** SHA-256（SHA-224）の逐次計算 */
+extern void v_crypto_sha256_update(ts_crypto_sha256_context_t* ps_ctx,
+                                   const uint8_t* pu8_data,
+                                   size_t t_len);
+/** SHA-256（SHA-224）の書き出し */
+extern void v_crypto_sha256_finish(ts_crypto_sha256_context_t* ps_ctx, uint8_t* pu8_hash);
+
+#if defined __cplusplus
+}
+#endif
+
+#endif /* __NTFW_CRYPTO_SHA256_H__ */
+
+/******************************************************************************/
+/***      END OF FILE                                                       ***/
+/******************************************************************************/
@@ -0,0 +1,72 @@
+/*******************************************************************************
+ *
+ * COMPONENT:Nano Toolkit Framework
+ *
+ * MODULE :X25519 library header file
+ *
+ * CREATED:2024/11/17 21:00:00
+ * AUTHOR :Kakuheiki.Nakanohito
+ *
+ * DESCRIPTION:X25519（RFC 7748）の鍵共有
+ *   32bit演算のみで実装し、ESP-IDFに依存しない（Linux上でもビルド可能）
+ *
+ * CHANGE HISTORY:
+ *
+ * LAST MODIFIED BY:
+ *
+ *******************************************************************************
+ *
+ * Copyright (c) 2024 Kakuheiki.Nakanohito
+ * Released under the MIT license
+ * https://opensource.org/licenses/mit-license.php
+ *
+ ******************************************************************************/
+#ifndef  __NTFW_CRYPTO_X25519_H__
+#define  __NTFW_CRYPTO_X25519_H__
+
+
+#if defined __cplusplus
+extern "C" {
+#endif
+
+/******************************************************************************/
+/***      Include files                                                     ***/
+/******************************************************************************/
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+/******************************************************************************/
+/***      Macro Definitions                                                 ***/
+/******************************************************************************/
+/** X25519 scalar and u-coordinate size */
+#define CRYPTO_X25519_BYTES     (32)
+
+/******************************************************************************/
+/***      Type Definitions                                                  ***/
+/******************************************************************************/
+
+/******************************************************************************/
+/***      Exported Variables                                                ***/
+/******************************************************************************/
+
+/******************************************************************************/
+/***      Exported Function Prototypes                                      ***/
+/******************************************************************************/
+/** X25519のスカラー倍算（共有鍵の算出） */
+extern bool b_crypto_x25519_scalarmult(uint8_t* pu8_out,
+                                       const uint8_t* pu8_scalar,
+                                       const uint8_t* pu8_point);
+/** X25519の公開鍵算出（ベースポイントのスカラー倍算） */
+extern void v_crypto_x25519_public_key(uint8_t* pu8_pub_key,
+                                       const uint8_t* pu8_scalar);
+
+#if defined __cplusplus
+}
+#endif
+
+#endif /* __NTFW_CRYPTO_X25519_H__ */
+
+/******************************************************************************/
+/***      END OF FILE                                                       ***/
+/******************************************************************************/
@@ -37,23 +37,50 @@ extern "C" {
 #define CRYPTO_X25519_CLIENT_PUBLIC_KEY_SIZE    (36)
 /** Curve25519 public key size(Server) */
 #define CRYPTO_X25519_SERVER_PUBLIC_KEY_SIZE    (33)
+/** ハッシュ値の最大サイズ（SHA512） */
+#define CRYPTO_HASH_MAX_SIZE                    (64)
 
 /******************************************************************************/
 /***      Include files                                                     ***/
 /******************************************************************************/
 #include <stdio.h>
 #include <stdint.h>
+#include <stdbool.h>
 #include <esp_system.h>
 #include <mbedtls/entropy.h>
 #include <mbedtls/ctr_drbg.h>
 #include <mbedtls/md.h>
+#include <mbedtls/sha512.h>
 #include <mbedtls/aes.h>
-#include <mbedtls/ecdh.h>
+#include <mbedtls/gcm.h>
 #include "ntfw_com_data_model.h"
+#include "ntfw_crypto_backend.h"
+#include "ntfw_crypto_chachapoly.h"
+#include "ntfw_crypto_x25519.h"
 
 /******************************************************************************/
 /***      Macro Definitions                                                 ***/
 /******************************************************************************/
+/** 疑似乱数生成器の再シード間隔（生成要求回数） */
+#ifndef CRYPTO_DRBG_RESEED_INTERVAL
+    #define CRYPTO_DRBG_RESEED_INTERVAL         (MBEDTLS_CTR_DRBG_RESEED_INTERVAL)
+#endif
+/** 疑似乱数生成器の予測困難性（true:生成毎に再シード） */
+#ifndef CRYPTO_DRBG_PREDICTION_RESISTANCE
+    #define CRYPTO_DRBG_PREDICTION_RESISTANCE   (false)
+#endif
+/** X25519鍵ペアプールのサイズ */
+#ifndef CRYPTO_X25519_POOL_SIZE
+    #define CRYPTO_X25519_POOL_SIZE             (2)
+#endif
+/** X25519鍵ペアプール補充タスクのスタックサイズ */
+#ifndef CRYPTO_X25519_POOL_STACK_DEPTH
+    #define CRYPTO_X25519_POOL_STACK_DEPTH      (3072)
+#endif
+/** X25519鍵ペアプール補充タスクの優先度 */
+#ifndef CRYPTO_X25519_POOL_PRIORITIES
+    #define CRYPTO_X25519_POOL_PRIORITIES       (tskIDLE_PRIORITY)
+#endif
 
 /******************************************************************************/
 /***      Type Definitions                                                  ***/
@@ -78,7 +105,7 @@ typedef struct {
 
 /** 構造体：X25519鍵共有コンテキスト */
 typedef struct {
-    mbedtls_ecdh_context s_ecdh_ctx;    // ECDHコンテキスト
+    uint8_t u8_private_key[CRYPTO_X25519_KEY_SIZE];                   // 秘密鍵
     uint8_t u8_cli_public_key[CRYPTO_X25519_CLIENT_PUBLIC_KEY_SIZE];  // 公開鍵（クライアント）
     uint8_t u8_svr_public_key[CRYPTO_X25519_SERVER_PUBLIC_KEY_SIZE];  // 公開鍵（サーバー）
     uint8_t u8_key[CRYPTO_X25519_KEY_SIZE];                           // 共有鍵
@@ -87,6 +114,38 @@ typedef struct {
 //==============================================================================
 // ハッシュ関数関連処理
 //==============================================================================
+/** 列挙型：ハッシュアルゴリズム（SHA-2） */
+typedef enum {
+    CRYPTO_HASH_SHA224 = 0,     // SHA224
+    CRYPTO_HASH_SHA256,         // SHA256
+    CRYPTO_HASH_SHA384,         // SHA384
+    CRYPTO_HASH_SHA512,         // SHA512
+} te_crypto_hash_type_t;
+
+/** 構造体：ハッシュコンテキスト（逐次処理、再利用可能） */
+typedef struct {
+    te_crypto_hash_type_t e_type;               // ハッシュアルゴリズム
+    union {
+        ts_crypto_be_sha256_t s_sha256;         // SHA224/SHA256
+        mbedtls_sha512_context s_sha512;        // SHA384/SHA512
+    } u_ctx;
+} ts_crypto_hash_context_t;
+
+/** 構造体：HMACコンテキスト（ipad/opad適用済みの鍵状態を保持、再利用可能） */
+typedef struct {
+    ts_crypto_hash_context_t s_inner;           // 内側ハッシュ（計算中）
+    ts_crypto_hash_context_t s_ipad;            // ipad適用済みの内側ハッシュ状態
+    ts_crypto_hash_context_t s_opad;            // opad適用済みの外側ハッシュ状態
+} ts_crypto_hmac_context_t;
+
+//==============================================================================
+// 共通鍵暗号関連処理
+//==============================================================================
+/** 構造体：AES GCMコンテキスト（鍵スケジュール展開済み、再利用可能） */
+typedef struct {
+    bool b_ready;                               // 鍵設定済みフラグ
+    mbedtls_gcm_context s_gcm_ctx;              // GCMコンテキスト
+} ts_crypto_gcm_context_t;
 
 /******************************************************************************/
 /***      Exported Variables                                                ***/
@@ -118,6 +177,20 @@ extern esp_err_t sts_crypto_pkcs7_unpadding(uint8_t* pu8_edit, ts_u8_array_t* ps
 /** アンパディング処理（PKCS#7） */
 extern ts_u8_array_t* ps_crypto_pkcs7_unpadding(ts_u8_array_t* ps_data, uint8_t u8_block_size);
 
+//==============================================================================
+// 疑似乱数生成器
+//==============================================================================
+/** 疑似乱数の生成処理（mbedtlsの乱数生成関数互換） */
+extern int i_crypto_drbg_random(void* pv_rng, unsigned char* puc_output, size_t t_len);
+/** 疑似乱数による一括編集処理 */
+extern esp_err_t sts_crypto_random_fill(uint8_t* pu8_buff, size_t t_len);
+/** 文字セットからの乱数文字列の一括編集処理（偏り無し） */
+extern esp_err_t sts_crypto_random_charset(const char* pc_charset, uint8_t* pu8_buff, size_t t_len);
+/** 疑似乱数生成器の再シードポリシーの設定処理 */
+extern esp_err_t sts_crypto_drbg_policy(uint32_t u32_reseed_interval, bool b_prediction_resistance);
+/** 疑似乱数生成器の再シード処理 */
+extern esp_err_t sts_crypto_drbg_reseed();
+
 //==============================================================================
 // ハッシュ関数関連処理
 //==============================================================================
@@ -131,6 +204,18 @@ extern esp_err_t sts_crypto_sha256(ts_u8_array_t* ps_token, uint32_t u32_stretch
 extern esp_err_t sts_crypto_sha384(ts_u8_array_t* ps_token, uint32_t u32_stretching, uint8_t* pu8_hash);
 /** ハッシュ関数(SHA512) */
 extern esp_err_t sts_crypto_sha512(ts_u8_array_t* ps_token, uint32_t u32_stretching, uint8_t* pu8_hash);
+/** ハッシュ値のサイズ */
+extern uint32_t u32_crypto_hash_size(te_crypto_hash_type_t e_type);
+/** ハッシュコンテキストの初期化（逐次処理の開始） */
+extern esp_err_t sts_crypto_hash_init(ts_crypto_hash_context_t* ps_ctx, te_crypto_hash_type_t e_type);
+/** ハッシュコンテキストのリセット */
+extern esp_err_t sts_crypto_hash_reset(ts_crypto_hash_context_t* ps_ctx);
+/** ハッシュ値の逐次計算 */
+extern esp_err_t sts_crypto_hash_update(ts_crypto_hash_context_t* ps_ctx, const uint8_t* pu8_data, size_t t_len);
+/** ハッシュ値の書き出し（書き出し後はリセット状態） */
+extern esp_err_t sts_crypto_hash_finish(ts_crypto_hash_context_t* ps_ctx, uint8_t* pu8_hash);
+/** ハッシュコンテキストの解放 */
+extern void v_crypto_hash_free(ts_crypto_hash_context_t* ps_ctx);
 
 //==============================================================================
 // メッセージ認証符号
@@ -139,6 +224,19 @@ extern esp_err_t sts_crypto_sha512(ts_u8_array_t* ps_token, uint32_t u32_stretch
 extern esp_err_t sts_crypto_mac(mbedtls_md_type_t e_type, ts_u8_array_t* ps_data, uint8_t* pu8_digest);
 /** HMAC関数 */
 extern esp_err_t sts_crypto_hmac(mbedtls_md_type_t e_type, ts_u8_array_t* ps_key, ts_u8_array_t* ps_data, uint8_t* pu8_digest);
+/** HMACコンテキストの初期化（ipad/opadの事前計算） */
+extern esp_err_t sts_crypto_hmac_init(ts_crypto_hmac_context_t* ps_ctx, te_crypto_hash_type_t e_type,
+                                      const uint8_t* pu8_key, size_t t_key_len);
+/** HMACコンテキストのリセット */
+extern esp_err_t sts_crypto_hmac_reset(ts_crypto_hmac_context_t* ps_ctx);
+/** HMACコンテキストの複製 */
+extern esp_err_t sts_crypto_hmac_clone(ts_crypto_hmac_context_t* ps_dst, const ts_crypto_hmac_context_t* ps_src);
+/** HMACの逐次計算 */
+extern esp_err_t sts_crypto_hmac_update(ts_crypto_hmac_context_t* ps_ctx, const uint8_t* pu8_data, size_t t_len);
+/** HMACの書き出し（書き出し後はリセット状態） */
+extern esp_err_t sts_crypto_hmac_finish(ts_crypto_hmac_context_t* ps_ctx, uint8_t* pu8_digest);
+/** HMACコンテキストの解放 */
+extern void v_crypto_hmac_free(ts_crypto_hmac_context_t* ps_ctx);
 
 //==============================================================================
 // 共通鍵暗号
@@ -161,6 +259,50 @@ extern ts_u8_array_t* ps_crypto_aes_ctr(const ts_u8_array_t* ps_key,
 extern ts_u8_array_t* ps_crypto_aes_gcm_enc(const ts_crypto_keyset_t* ps_keyset, const ts_u8_array_t* ps_plane, ts_u8_array_t* ps_auth_tag);
 /** 復号処理(AES GCMモード) */
 extern ts_u8_array_t* ps_crypto_aes_gcm_dec(const ts_crypto_keyset_t* ps_keyset, const ts_u8_array_t* ps_cipher, ts_u8_array_t* ps_auth_tag);
+/** 暗号化処理(AES GCMモード、インプレース) */
+extern esp_err_t sts_crypto_aes_gcm_enc_in_place(const uint8_t* pu8_key, size_t t_key_len,
+                                                 const uint8_t* pu8_iv, size_t t_iv_len,
+                                                 const uint8_t* pu8_add, size_t t_add_len,
+                                                 uint8_t* pu8_data, size_t t_data_len,
+                                                 uint8_t* pu8_tag, size_t t_tag_len);
+/** 復号処理(AES GCMモード、インプレース、認証タグ検証) */
+extern esp_err_t sts_crypto_aes_gcm_dec_in_place(const uint8_t* pu8_key, size_t t_key_len,
+                                                 const uint8_t* pu8_iv, size_t t_iv_len,
+                                                 const uint8_t* pu8_add, size_t t_add_len,
+                                                 uint8_t* pu8_data, size_t t_data_len,
+                                                 const uint8_t* pu8_tag, size_t t_tag_len);
+/** AES GCMコンテキストの初期化（鍵スケジュール展開） */
+extern esp_err_t sts_crypto_gcm_init(ts_crypto_gcm_context_t* ps_ctx, const uint8_t* pu8_key, size_t t_key_len);
+/** AES GCMコンテキストの解放 */
+extern void v_crypto_gcm_free(ts_crypto_gcm_context_t* ps_ctx);
+/** 暗号化処理(AES GCMコンテキスト、インプレース) */
+extern esp_err_t sts_crypto_gcm_enc_in_place(ts_crypto_gcm_context_t* ps_ctx,
+                                             const uint8_t* pu8_iv, size_t t_iv_len,
+                                             const uint8_t* pu8_add, size_t t_add_len,
+                                             uint8_t* pu8_data, size_t t_data_len,
+                                             uint8_t* pu8_tag, size_t t_tag_len);
+/** 復号処理(AES GCMコンテキスト、インプレース、認証タグ検証) */
+extern esp_err_t sts_crypto_gcm_dec_in_place(ts_crypto_gcm_context_t* ps_ctx,
+                                             const uint8_t* pu8_iv, size_t t_iv_len,
+                                             const uint8_t* pu8_add, size_t t_add_len,
+                                             uint8_t* pu8_data, size_t t_data_len,
+                                             const uint8_t* pu8_tag, size_t t_tag_len);
+/** 暗号化処理(ChaCha20-Poly1305) */
+extern ts_u8_array_t* ps_crypto_chacha20_poly1305_enc(const ts_crypto_keyset_t* ps_keyset, const ts_u8_array_t* ps_plane, ts_u8_array_t* ps_auth_tag);
+/** 復号処理(ChaCha20-Poly1305、認証タグ検証) */
+extern ts_u8_array_t* ps_crypto_chacha20_poly1305_dec(const ts_crypto_keyset_t* ps_keyset, const ts_u8_array_t* ps_cipher, const ts_u8_array_t* ps_auth_tag);
+/** 暗号化処理(ChaCha20-Poly1305、インプレース) */
+extern esp_err_t sts_crypto_chacha20_poly1305_enc_in_place(const uint8_t* pu8_key,
+                                                           const uint8_t* pu8_nonce,
+                                                           const uint8_t* pu8_add, size_t t_add_len,
+                                                           uint8_t* pu8_data, size_t t_data_len,
+                                                           uint8_t* pu8_tag);
+/** 復号処理(ChaCha20-Poly1305、インプレース、認証タグ検証) */
+extern esp_err_t sts_crypto_chacha20_poly1305_dec_in_place(const uint8_t* pu8_key,
+                                                           const uint8_t* pu8_nonce,
+                                                           const uint8_t* pu8_add, size_t t_add_len,
+                                                           uint8_t* pu8_data, size_t t_data_len,
+                                                           const uint8_t* pu8_tag);
 
 //==============================================================================
 // 共通鍵共有(X25519)
@@ -173,6 +315,10 @@ extern ts_crypto_x25519_context_t* ps_crypto_x25519_server_context(uint8_t* pu8_
 extern esp_err_t sts_crypto_x25519_client_secret(ts_crypto_x25519_context_t* ps_client_ctx, uint8_t* pu8_server_pub_key);
 /** X25519コンテキストの削除処理 */
 extern void v_crypto_x25519_delete_context(ts_crypto_x25519_context_t* ps_ctx);
+/** X25519鍵ペアプールの補充開始 */
+extern esp_err_t sts_crypto_x25519_pool_begin();
+/** X25519鍵ペアプールの在庫数 */
+extern uint32_t u32_crypto_x25519_pool_count();
 
 #if defined __cplusplus
 }
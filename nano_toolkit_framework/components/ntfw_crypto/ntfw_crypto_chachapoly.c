@@ -0,0 +1,718 @@
+/*******************************************************************************
+ *
+ * COMPONENT:Nano Toolkit Framework
+ *
+ * MODULE :ChaCha20-Poly1305 library source file
+ *
+ * CREATED:2024/11/10 21:00:00
+ * AUTHOR :Kakuheiki.Nakanohito
+ *
+ * DESCRIPTION:ChaCha20-Poly1305（RFC 8439）の認証付き暗号
+ *   ChaCha20は32bitワード単位、Poly1305は26bitリム×5（32bit×32bit乗算）で演算する
+ *
+ * CHANGE HISTORY:
+ *
+ * LAST MODIFIED BY:
+ *
+ *******************************************************************************
+ *
+ * Copyright (c) 2024 Kakuheiki.Nakanohito
+ * Released under the MIT license
+ * https://opensource.org/licenses/mit-license.php
+ *
+ ******************************************************************************/
+
+/******************************************************************************/
+/***      Include files                                                     ***/
+/******************************************************************************/
+#include "ntfw_crypto_chachapoly.h"
+
+#include <string.h>
+
+/******************************************************************************/
+/***      Macro Definitions                                                 ***/
+/******************************************************************************/
+/** Poly1305 block size */
+#define POLY1305_BLOCK_SIZE     (16)
+/** Poly1305 key size */
+#define POLY1305_KEY_SIZE       (32)
+/** Poly1305 26bit limb mask */
+#define POLY1305_LIMB_MASK      (0x3FFFFFF)
+
+/** 32bit左ローテート */
+#define CHACHA20_ROTL(v, n)     (((v) << (n)) | ((v) >> (32 - (n))))
+/** ChaCha20 quarter round */
+#define CHACHA20_QR(a, b, c, d) \
+    a += b; d ^= a; d = CHACHA20_ROTL(d, 16); \
+    c += d; b ^= c; b = CHACHA20_ROTL(b, 12); \
+    a += b; d ^= a; d = CHACHA20_ROTL(d, 8);  \
+    c += d; b ^= c; b = CHACHA20_ROTL(b, 7);
+
+/******************************************************************************/
+/***      Type Definitions                                                  ***/
+/******************************************************************************/
+/**
+ * Poly1305コンテキスト
+ */
+typedef struct {
+    uint32_t u32_r[5];                          // 鍵r（26bitリム）
+    uint32_t u32_h[5];                          // アキュムレータ（26bitリム）
+    uint32_t u32_pad[4];                        // 鍵s
+    uint8_t u8_buff[POLY1305_BLOCK_SIZE];       // 端数バッファ
+    size_t t_buff_len;                          // 端数バッファのデータ長
+} ts_poly1305_context_t;
+
+/******************************************************************************/
+/***      Exported Variables                                                ***/
+/******************************************************************************/
+
+/******************************************************************************/
+/***      Local Variables                                                   ***/
+/******************************************************************************/
+
+/******************************************************************************/
+/***      Local Function Prototypes                                         ***/
+/******************************************************************************/
+/** リトルエンディアン読み込み */
+static uint32_t u32_load_le(const uint8_t* pu8_src);
+/** リトルエンディアン書き込み */
+static void v_store_le(uint8_t* pu8_dst, uint32_t u32_val);
+/** ChaCha20ブロック関数 */
+static void v_chacha20_block(const uint32_t* pu32_input, uint8_t* pu8_output);
+/** ChaCha20入力状態の初期化 */
+static void v_chacha20_init_state(uint32_t* pu32_state, const uint8_t* pu8_key, const uint8_t* pu8_nonce, uint32_t u32_counter);
+/** Poly1305の初期化 */
+static void v_poly1305_init(ts_poly1305_context_t* ps_ctx, const uint8_t* pu8_key);
+/** Poly1305のブロック処理 */
+static void v_poly1305_blocks(ts_poly1305_context_t* ps_ctx, const uint8_t* pu8_msg, size_t t_len, uint32_t u32_hibit);
+/** Poly1305の更新 */
+static void v_poly1305_update(ts_poly1305_context_t* ps_ctx, const uint8_t* pu8_msg, size_t t_len);
+/** Poly1305の16バイト境界までゼロ埋め */
+static void v_poly1305_pad16(ts_poly1305_context_t* ps_ctx, size_t t_len);
+/** Poly1305の完了 */
+static void v_poly1305_finish(ts_poly1305_context_t* ps_ctx, uint8_t* pu8_tag);
+/** AEADの認証タグ生成 */
+static void v_chachapoly_tag(const uint8_t* pu8_key, const uint8_t* pu8_nonce,
+                             const uint8_t* pu8_add, size_t t_add_len,
+                             const uint8_t* pu8_cipher, size_t t_cipher_len,
+                             uint8_t* pu8_tag);
+
+/******************************************************************************/
+/***      Exported Functions                                                ***/
+/******************************************************************************/
+
+/*******************************************************************************
+ *
+ * NAME: v_crypto_chacha20_xor
+ *
+ * DESCRIPTION:ChaCha20による鍵ストリームのXOR
+ *
+ * PARAMETERS:      Name            RW  Usage
+ * const uint8_t*   pu8_key         R   鍵（32バイト）
+ * const uint8_t*   pu8_nonce       R   ナンス（12バイト）
+ * uint32_t         u32_counter     R   初期ブロックカウンタ
+ * uint8_t*         pu8_output      W   出力
+ * const uint8_t*   pu8_input       R   入力
+ * size_t           t_len           R   入力サイズ
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * 入力と出力に同じバッファを指定可能
+ ******************************************************************************/
+void v_crypto_chacha20_xor(const uint8_t* pu8_key,
+                           const uint8_t* pu8_nonce,
+                           uint32_t u32_counter,
+                           uint8_t* pu8_output,
+                           const uint8_t* pu8_input,
+                           size_t t_len) {
+    uint32_t u32_state[16];
+    uint8_t u8_stream[CRYPTO_CHACHA20_BLOCK_SIZE];
+    v_chacha20_init_state(u32_state, pu8_key, pu8_nonce, u32_counter);
+    size_t t_idx;
+    size_t t_blk_len;
+    while (t_len > 0) {
+        // 鍵ストリームの生成
+        v_chacha20_block(u32_state, u8_stream);
+        u32_state[12]++;
+        // XOR
+        t_blk_len = (t_len < CRYPTO_CHACHA20_BLOCK_SIZE) ? t_len : CRYPTO_CHACHA20_BLOCK_SIZE;
+        for (t_idx = 0; t_idx < t_blk_len; t_idx++) {
+            pu8_output[t_idx] = pu8_input[t_idx] ^ u8_stream[t_idx];
+        }
+        pu8_output += t_blk_len;
+        pu8_input  += t_blk_len;
+        t_len      -= t_blk_len;
+    }
+    // 鍵ストリームと鍵を含む状態をクリア
+    memset(u8_stream, 0x00, sizeof(u8_stream));
+    memset(u32_state, 0x00, sizeof(u32_state));
+}
+
+/*******************************************************************************
+ *
+ * NAME: v_crypto_poly1305_mac
+ *
+ * DESCRIPTION:Poly1305によるメッセージ認証コード生成
+ *
+ * PARAMETERS:      Name            RW  Usage
+ * const uint8_t*   pu8_key         R   ワンタイム鍵（32バイト）
+ * const uint8_t*   pu8_msg         R   メッセージ
+ * size_t           t_msg_len       R   メッセージサイズ
+ * uint8_t*         pu8_tag         W   認証タグ（16バイト）
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * None.
+ ******************************************************************************/
+void v_crypto_poly1305_mac(const uint8_t* pu8_key,
+                           const uint8_t* pu8_msg,
+                           size_t t_msg_len,
+                           uint8_t* pu8_tag) {
+    ts_poly1305_context_t s_ctx;
+    v_poly1305_init(&s_ctx, pu8_key);
+    v_poly1305_update(&s_ctx, pu8_msg, t_msg_len);
+    v_poly1305_finish(&s_ctx, pu8_tag);
+}
+
+/*******************************************************************************
+ *
+ * NAME: v_crypto_chachapoly_enc_in_place
+ *
+ * DESCRIPTION:暗号化処理(ChaCha20-Poly1305、インプレース)
+ *
+ * PARAMETERS:      Name            RW  Usage
+ * const uint8_t*   pu8_key         R   鍵（32バイト）
+ * const uint8_t*   pu8_nonce       R   ナンス（12バイト）
+ * const uint8_t*   pu8_add         R   追加認証データ（NULL可）
+ * size_t           t_add_len       R   追加認証データサイズ
+ * uint8_t*         pu8_data        RW  平文（暗号文で上書き）
+ * size_t           t_data_len      R   平文サイズ
+ * uint8_t*         pu8_tag         W   認証タグ（16バイト）
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * 同一鍵でナンスを再利用しない事
+ ******************************************************************************/
+void v_crypto_chachapoly_enc_in_place(const uint8_t* pu8_key,
+                                      const uint8_t* pu8_nonce,
+                                      const uint8_t* pu8_add, size_t t_add_len,
+                                      uint8_t* pu8_data, size_t t_data_len,
+                                      uint8_t* pu8_tag) {
+    // 暗号化（ブロックカウンタ1から）
+    v_crypto_chacha20_xor(pu8_key, pu8_nonce, 1, pu8_data, pu8_data, t_data_len);
+    // 暗号文の認証タグを生成
+    v_chachapoly_tag(pu8_key, pu8_nonce, pu8_add, t_add_len, pu8_data, t_data_len, pu8_tag);
+}
+
+/*******************************************************************************
+ *
+ * NAME: b_crypto_chachapoly_dec_in_place
+ *
+ * DESCRIPTION:復号処理(ChaCha20-Poly1305、インプレース)
+ *
+ * PARAMETERS:      Name            RW  Usage
+ * const uint8_t*   pu8_key         R   鍵（32バイト）
+ * const uint8_t*   pu8_nonce       R   ナンス（12バイト）
+ * const uint8_t*   pu8_add         R   追加認証データ（NULL可）
+ * size_t           t_add_len       R   追加認証データサイズ
+ * uint8_t*         pu8_data        RW  暗号文（平文で上書き）
+ * size_t           t_data_len      R   暗号文サイズ
+ * const uint8_t*   pu8_tag         R   認証タグ（16バイト）
+ *
+ * RETURNS:
+ *   true:認証成功
+ *
+ * NOTES:
+ * 認証タグは復号前に定数時間で検証し、不一致の場合はバッファを変更しない
+ ******************************************************************************/
+bool b_crypto_chachapoly_dec_in_place(const uint8_t* pu8_key,
+                                      const uint8_t* pu8_nonce,
+                                      const uint8_t* pu8_add, size_t t_add_len,
+                                      uint8_t* pu8_data, size_t t_data_len,
+                                      const uint8_t* pu8_tag) {
+    //==========================================================================
+    // 認証タグの検証
+    //==========================================================================
+    uint8_t u8_tag[CRYPTO_CHACHAPOLY_TAG_SIZE];
+    v_chachapoly_tag(pu8_key, pu8_nonce, pu8_add, t_add_len, pu8_data, t_data_len, u8_tag);
+    uint8_t u8_diff = 0x00;
+    uint8_t u8_idx;
+    for (u8_idx = 0; u8_idx < CRYPTO_CHACHAPOLY_TAG_SIZE; u8_idx++) {
+        u8_diff |= u8_tag[u8_idx] ^ pu8_tag[u8_idx];
+    }
+    memset(u8_tag, 0x00, sizeof(u8_tag));
+    if (u8_diff != 0x00) {
+        return false;
+    }
+
+    //==========================================================================
+    // 復号（ブロックカウンタ1から）
+    //==========================================================================
+    v_crypto_chacha20_xor(pu8_key, pu8_nonce, 1, pu8_data, pu8_data, t_data_len);
+    // 認証成功
+    return true;
+}
+
+/******************************************************************************/
+/***      Local Functions                                                   ***/
+/******************************************************************************/
+
+/*******************************************************************************
+ *
+ * NAME: u32_load_le
+ *
+ * DESCRIPTION:リトルエンディアン読み込み
+ *
+ * PARAMETERS:      Name            RW  Usage
+ * const uint8_t*   pu8_src         R   読み込み元（アライメント不問）
+ *
+ * RETURNS:
+ *   uint32_t:読み込み値
+ *
+ * NOTES:
+ * None.
+ ******************************************************************************/
+static uint32_t u32_load_le(const uint8_t* pu8_src) {
+    return ((uint32_t)pu8_src[0]) |
+           ((uint32_t)pu8_src[1] << 8) |
+           ((uint32_t)pu8_src[2] << 16) |
+           ((uint32_t)pu8_src[3] << 24);
+}
+
+/*******************************************************************************
+ *
+ * NAME: v_store_le
+ *
+ * DESCRIPTION:リトルエンディアン書き込み
+ *
+ * PARAMETERS:      Name            RW  Usage
+ * uint8_t*         pu8_dst         W   書き込み先（アライメント不問）
+ * uint32_t         u32_val         R   書き込み値
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * None.
+ ******************************************************************************/
+static void v_store_le(uint8_t* pu8_dst, uint32_t u32_val) {
+    pu8_dst[0] = (uint8_t)u32_val;
+    pu8_dst[1] = (uint8_t)(u32_val >> 8);
+    pu8_dst[2] = (uint8_t)(u32_val >> 16);
+    pu8_dst[3] = (uint8_t)(u32_val >> 24);
+}
+
+/*******************************************************************************
+ *
+ * NAME: v_chacha20_block
+ *
+ * DESCRIPTION:ChaCha20ブロック関数
+ *
+ * PARAMETERS:      Name            RW  Usage
+ * const uint32_t*  pu32_input      R   入力状態（16ワード）
+ * uint8_t*         pu8_output      W   鍵ストリーム（64バイト）
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * 作業変数はレジスタ割り当てを想定してローカル変数で保持する
+ ******************************************************************************/
+static void v_chacha20_block(const uint32_t* pu32_input, uint8_t* pu8_output) {
+    uint32_t x0  = pu32_input[0];
+    uint32_t x1  = pu32_input[1];
+    uint32_t x2  = pu32_input[2];
+    uint32_t x3  = pu32_input[3];
+    uint32_t x4  = pu32_input[4];
+    uint32_t x5  = pu32_input[5];
+    uint32_t x6  = pu32_input[6];
+    uint32_t x7  = pu32_input[7];
+    uint32_t x8  = pu32_input[8];
+    uint32_t x9  = pu32_input[9];
+    uint32_t x10 = pu32_input[10];
+    uint32_t x11 = pu32_input[11];
+    uint32_t x12 = pu32_input[12];
+    uint32_t x13 = pu32_input[13];
+    uint32_t x14 = pu32_input[14];
+    uint32_t x15 = pu32_input[15];
+    int i_round;
+    for (i_round = 0; i_round < 10; i_round++) {
+        // column round
+        CHACHA20_QR(x0, x4, x8,  x12)
+        CHACHA20_QR(x1, x5, x9,  x13)
+        CHACHA20_QR(x2, x6, x10, x14)
+        CHACHA20_QR(x3, x7, x11, x15)
+        // diagonal round
+        CHACHA20_QR(x0, x5, x10, x15)
+        CHACHA20_QR(x1, x6, x11, x12)
+        CHACHA20_QR(x2, x7, x8,  x13)
+        CHACHA20_QR(x3, x4, x9,  x14)
+    }
+    v_store_le(&pu8_output[0],  x0  + pu32_input[0]);
+    v_store_le(&pu8_output[4],  x1  + pu32_input[1]);
+    v_store_le(&pu8_output[8],  x2  + pu32_input[2]);
+    v_store_le(&pu8_output[12], x3  + pu32_input[3]);
+    v_store_le(&pu8_output[16], x4  + pu32_input[4]);
+    v_store_le(&pu8_output[20], x5  + pu32_input[5]);
+    v_store_le(&pu8_output[24], x6  + pu32_input[6]);
+    v_store_le(&pu8_output[28], x7  + pu32_input[7]);
+    v_store_le(&pu8_output[32], x8  + pu32_input[8]);
+    v_store_le(&pu8_output[36], x9  + pu32_input[9]);
+    v_store_le(&pu8_output[40], x10 + pu32_input[10]);
+    v_store_le(&pu8_output[44], x11 + pu32_input[11]);
+    v_store_le(&pu8_output[48], x12 + pu32_input[12]);
+    v_store_le(&pu8_output[52], x13 + pu32_input[13]);
+    v_store_le(&pu8_output[56], x14 + pu32_input[14]);
+    v_store_le(&pu8_output[60], x15 + pu32_input[15]);
+}
+
+/*******************************************************************************
+ *
+ * NAME: v_chacha20_init_state
+ *
+ * DESCRIPTION:ChaCha20入力状態の初期化
+ *
+ * PARAMETERS:      Name            RW  Usage
+ * uint32_t*        pu32_state      W   入力状態（16ワード）
+ * const uint8_t*   pu8_key         R   鍵（32バイト）
+ * const uint8_t*   pu8_nonce       R   ナンス（12バイト）
+ * uint32_t         u32_counter     R   ブロックカウンタ
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * None.
+ ******************************************************************************/
+static void v_chacha20_init_state(uint32_t* pu32_state, const uint8_t* pu8_key, const uint8_t* pu8_nonce, uint32_t u32_counter) {
+    // 定数"expand 32-byte k"
+    pu32_state[0] = 0x61707865;
+    pu32_state[1] = 0x3320646E;
+    pu32_state[2] = 0x79622D32;
+    pu32_state[3] = 0x6B206574;
+    // 鍵
+    uint8_t u8_idx;
+    for (u8_idx = 0; u8_idx < 8; u8_idx++) {
+        pu32_state[4 + u8_idx] = u32_load_le(&pu8_key[u8_idx * 4]);
+    }
+    // ブロックカウンタ
+    pu32_state[12] = u32_counter;
+    // ナンス
+    pu32_state[13] = u32_load_le(&pu8_nonce[0]);
+    pu32_state[14] = u32_load_le(&pu8_nonce[4]);
+    pu32_state[15] = u32_load_le(&pu8_nonce[8]);
+}
+
+/*******************************************************************************
+ *
+ * NAME: v_poly1305_init
+ *
+ * DESCRIPTION:Poly1305の初期化
+ *
+ * PARAMETERS:              Name        RW  Usage
+ * ts_poly1305_context_t*   ps_ctx      W   コンテキスト
+ * const uint8_t*           pu8_key     R   ワンタイム鍵（32バイト）
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * 鍵rはクランプした上で26bitリムに分割する
+ ******************************************************************************/
+static void v_poly1305_init(ts_poly1305_context_t* ps_ctx, const uint8_t* pu8_key) {
+    // r &= 0x0ffffffc0ffffffc0ffffffc0fffffff
+    ps_ctx->u32_r[0] = (u32_load_le(&pu8_key[0])) & 0x3FFFFFF;
+    ps_ctx->u32_r[1] = (u32_load_le(&pu8_key[3]) >> 2) & 0x3FFFF03;
+    ps_ctx->u32_r[2] = (u32_load_le(&pu8_key[6]) >> 4) & 0x3FFC0FF;
+    ps_ctx->u32_r[3] = (u32_load_le(&pu8_key[9]) >> 6) & 0x3F03FFF;
+    ps_ctx->u32_r[4] = (u32_load_le(&pu8_key[12]) >> 8) & 0x00FFFFF;
+    // h = 0
+    memset(ps_ctx->u32_h, 0x00, sizeof(ps_ctx->u32_h));
+    // s
+    ps_ctx->u32_pad[0] = u32_load_le(&pu8_key[16]);
+    ps_ctx->u32_pad[1] = u32_load_le(&pu8_key[20]);
+    ps_ctx->u32_pad[2] = u32_load_le(&pu8_key[24]);
+    ps_ctx->u32_pad[3] = u32_load_le(&pu8_key[28]);
+    // 端数バッファ
+    ps_ctx->t_buff_len = 0;
+}
+
+/*******************************************************************************
+ *
+ * NAME: v_poly1305_blocks
+ *
+ * DESCRIPTION:Poly1305のブロック処理
+ *
+ * PARAMETERS:              Name        RW  Usage
+ * ts_poly1305_context_t*   ps_ctx      RW  コンテキスト
+ * const uint8_t*           pu8_msg     R   メッセージ（16バイト単位）
+ * size_t                   t_len       R   メッセージサイズ
+ * uint32_t                 u32_hibit   R   2^128のビット（最終端数ブロックは0）
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * h = (h + m) * r mod 2^130-5
+ ******************************************************************************/
+static void v_poly1305_blocks(ts_poly1305_context_t* ps_ctx, const uint8_t* pu8_msg, size_t t_len, uint32_t u32_hibit) {
+    const uint32_t r0 = ps_ctx->u32_r[0];
+    const uint32_t r1 = ps_ctx->u32_r[1];
+    const uint32_t r2 = ps_ctx->u32_r[2];
+    const uint32_t r3 = ps_ctx->u32_r[3];
+    const uint32_t r4 = ps_ctx->u32_r[4];
+    const uint32_t s1 = r1 * 5;
+    const uint32_t s2 = r2 * 5;
+    const uint32_t s3 = r3 * 5;
+    const uint32_t s4 = r4 * 5;
+    uint32_t h0 = ps_ctx->u32_h[0];
+    uint32_t h1 = ps_ctx->u32_h[1];
+    uint32_t h2 = ps_ctx->u32_h[2];
+    uint32_t h3 = ps_ctx->u32_h[3];
+    uint32_t h4 = ps_ctx->u32_h[4];
+    uint64_t d0, d1, d2, d3, d4;
+    uint32_t c;
+    while (t_len >= POLY1305_BLOCK_SIZE) {
+        // h += m
+        h0 += (u32_load_le(&pu8_msg[0])) & POLY1305_LIMB_MASK;
+        h1 += (u32_load_le(&pu8_msg[3]) >> 2) & POLY1305_LIMB_MASK;
+        h2 += (u32_load_le(&pu8_msg[6]) >> 4) & POLY1305_LIMB_MASK;
+        h3 += (u32_load_le(&pu8_msg[9]) >> 6) & POLY1305_LIMB_MASK;
+        h4 += (u32_load_le(&pu8_msg[12]) >> 8) | u32_hibit;
+        // h *= r
+        d0 = ((uint64_t)h0 * r0) + ((uint64_t)h1 * s4) + ((uint64_t)h2 * s3) + ((uint64_t)h3 * s2) + ((uint64_t)h4 * s1);
+        d1 = ((uint64_t)h0 * r1) + ((uint64_t)h1 * r0) + ((uint64_t)h2 * s4) + ((uint64_t)h3 * s3) + ((uint64_t)h4 * s2);
+        d2 = ((uint64_t)h0 * r2) + ((uint64_t)h1 * r1) + ((uint64_t)h2 * r0) + ((uint64_t)h3 * s4) + ((uint64_t)h4 * s3);
+        d3 = ((uint64_t)h0 * r3) + ((uint64_t)h1 * r2) + ((uint64_t)h2 * r1) + ((uint64_t)h3 * r0) + ((uint64_t)h4 * s4);
+        d4 = ((uint64_t)h0 * r4) + ((uint64_t)h1 * r3) + ((uint64_t)h2 * r2) + ((uint64_t)h3 * r1) + ((uint64_t)h4 * r0);
+        // (partial) h %= p
+        c = (uint32_t)(d0 >> 26); h0 = (uint32_t)d0 & POLY1305_LIMB_MASK;
+        d1 += c; c = (uint32_t)(d1 >> 26); h1 = (uint32_t)d1 & POLY1305_LIMB_MASK;
+        d2 += c; c = (uint32_t)(d2 >> 26); h2 = (uint32_t)d2 & POLY1305_LIMB_MASK;
+        d3 += c; c = (uint32_t)(d3 >> 26); h3 = (uint32_t)d3 & POLY1305_LIMB_MASK;
+        d4 += c; c = (uint32_t)(d4 >> 26); h4 = (uint32_t)d4 & POLY1305_LIMB_MASK;
+        h0 += c * 5; c = (h0 >> 26); h0 &= POLY1305_LIMB_MASK;
+        h1 += c;
+        // 次のブロック
+        pu8_msg += POLY1305_BLOCK_SIZE;
+        t_len   -= POLY1305_BLOCK_SIZE;
+    }
+    ps_ctx->u32_h[0] = h0;
+    ps_ctx->u32_h[1] = h1;
+    ps_ctx->u32_h[2] = h2;
+    ps_ctx->u32_h[3] = h3;
+    ps_ctx->u32_h[4] = h4;
+}
+
+/*******************************************************************************
+ *
+ * NAME: v_poly1305_update
+ *
+ * DESCRIPTION:Poly1305の更新
+ *
+ * PARAMETERS:              Name        RW  Usage
+ * ts_poly1305_context_t*   ps_ctx      RW  コンテキスト
+ * const uint8_t*           pu8_msg     R   メッセージ
+ * size_t                   t_len       R   メッセージサイズ
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * 16バイト未満の端数はバッファに保持する
+ ******************************************************************************/
+static void v_poly1305_update(ts_poly1305_context_t* ps_ctx, const uint8_t* pu8_msg, size_t t_len) {
+    // 端数バッファの補完
+    if (ps_ctx->t_buff_len > 0) {
+        size_t t_fill = POLY1305_BLOCK_SIZE - ps_ctx->t_buff_len;
+        if (t_fill > t_len) {
+            t_fill = t_len;
+        }
+        memcpy(&ps_ctx->u8_buff[ps_ctx->t_buff_len], pu8_msg, t_fill);
+        ps_ctx->t_buff_len += t_fill;
+        pu8_msg += t_fill;
+        t_len   -= t_fill;
+        if (ps_ctx->t_buff_len < POLY1305_BLOCK_SIZE) {
+            return;
+        }
+        v_poly1305_blocks(ps_ctx, ps_ctx->u8_buff, POLY1305_BLOCK_SIZE, (1UL << 24));
+        ps_ctx->t_buff_len = 0;
+    }
+    // ブロック単位の処理
+    size_t t_blk_len = t_len & ~((size_t)POLY1305_BLOCK_SIZE - 1);
+    if (t_blk_len > 0) {
+        v_poly1305_blocks(ps_ctx, pu8_msg, t_blk_len, (1UL << 24));
+        pu8_msg += t_blk_len;
+        t_len   -= t_blk_len;
+    }
+    // 端数を保持
+    if (t_len > 0) {
+        memcpy(ps_ctx->u8_buff, pu8_msg, t_len);
+        ps_ctx->t_buff_len = t_len;
+    }
+}
+
+/*******************************************************************************
+ *
+ * NAME: v_poly1305_pad16
+ *
+ * DESCRIPTION:Poly1305の16バイト境界までゼロ埋め
+ *
+ * PARAMETERS:              Name        RW  Usage
+ * ts_poly1305_context_t*   ps_ctx      RW  コンテキスト
+ * size_t                   t_len       R   直前に入力したデータサイズ
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * None.
+ ******************************************************************************/
+static void v_poly1305_pad16(ts_poly1305_context_t* ps_ctx, size_t t_len) {
+    static const uint8_t u8_zero[POLY1305_BLOCK_SIZE] = {0x00};
+    size_t t_rem = t_len % POLY1305_BLOCK_SIZE;
+    if (t_rem > 0) {
+        v_poly1305_update(ps_ctx, u8_zero, POLY1305_BLOCK_SIZE - t_rem);
+    }
+}
+
+/*******************************************************************************
+ *
+ * NAME: v_poly1305_finish
+ *
+ * DESCRIPTION:Poly1305の完了
+ *
+ * PARAMETERS:              Name        RW  Usage
+ * ts_poly1305_context_t*   ps_ctx      RW  コンテキスト
+ * uint8_t*                 pu8_tag     W   認証タグ（16バイト）
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * 完了後にコンテキストはゼロクリアされる
+ ******************************************************************************/
+static void v_poly1305_finish(ts_poly1305_context_t* ps_ctx, uint8_t* pu8_tag) {
+    //==========================================================================
+    // 端数ブロックの処理
+    //==========================================================================
+    if (ps_ctx->t_buff_len > 0) {
+        size_t t_idx = ps_ctx->t_buff_len;
+        ps_ctx->u8_buff[t_idx++] = 0x01;
+        for (; t_idx < POLY1305_BLOCK_SIZE; t_idx++) {
+            ps_ctx->u8_buff[t_idx] = 0x00;
+        }
+        v_poly1305_blocks(ps_ctx, ps_ctx->u8_buff, POLY1305_BLOCK_SIZE, 0);
+    }
+
+    //==========================================================================
+    // h %= p（完全な剰余）
+    //==========================================================================
+    uint32_t h0 = ps_ctx->u32_h[0];
+    uint32_t h1 = ps_ctx->u32_h[1];
+    uint32_t h2 = ps_ctx->u32_h[2];
+    uint32_t h3 = ps_ctx->u32_h[3];
+    uint32_t h4 = ps_ctx->u32_h[4];
+    uint32_t c;
+    c = h1 >> 26; h1 &= POLY1305_LIMB_MASK;
+    h2 += c; c = h2 >> 26; h2 &= POLY1305_LIMB_MASK;
+    h3 += c; c = h3 >> 26; h3 &= POLY1305_LIMB_MASK;
+    h4 += c; c = h4 >> 26; h4 &= POLY1305_LIMB_MASK;
+    h0 += c * 5; c = h0 >> 26; h0 &= POLY1305_LIMB_MASK;
+    h1 += c;
+    // g = h + -p
+    uint32_t g0 = h0 + 5; c = g0 >> 26; g0 &= POLY1305_LIMB_MASK;
+    uint32_t g1 = h1 + c; c = g1 >> 26; g1 &= POLY1305_LIMB_MASK;
+    uint32_t g2 = h2 + c; c = g2 >> 26; g2 &= POLY1305_LIMB_MASK;
+    uint32_t g3 = h3 + c; c = g3 >> 26; g3 &= POLY1305_LIMB_MASK;
+    uint32_t g4 = h4 + c - (1UL << 26);
+    // h >= p の場合はgを選択（分岐無し）
+    uint32_t u32_mask = (g4 >> 31) - 1;
+    g0 &= u32_mask;
+    g1 &= u32_mask;
+    g2 &= u32_mask;
+    g3 &= u32_mask;
+    g4 &= u32_mask;
+    u32_mask = ~u32_mask;
+    h0 = (h0 & u32_mask) | g0;
+    h1 = (h1 & u32_mask) | g1;
+    h2 = (h2 & u32_mask) | g2;
+    h3 = (h3 & u32_mask) | g3;
+    h4 = (h4 & u32_mask) | g4;
+
+    //==========================================================================
+    // tag = (h + s) % 2^128
+    //==========================================================================
+    h0 = (h0 | (h1 << 26));
+    h1 = ((h1 >> 6) | (h2 << 20));
+    h2 = ((h2 >> 12) | (h3 << 14));
+    h3 = ((h3 >> 18) | (h4 << 8));
+    uint64_t f;
+    f = (uint64_t)h0 + ps_ctx->u32_pad[0];             h0 = (uint32_t)f;
+    f = (uint64_t)h1 + ps_ctx->u32_pad[1] + (f >> 32); h1 = (uint32_t)f;
+    f = (uint64_t)h2 + ps_ctx->u32_pad[2] + (f >> 32); h2 = (uint32_t)f;
+    f = (uint64_t)h3 + ps_ctx->u32_pad[3] + (f >> 32); h3 = (uint32_t)f;
+    v_store_le(&pu8_tag[0],  h0);
+    v_store_le(&pu8_tag[4],  h1);
+    v_store_le(&pu8_tag[8],  h2);
+    v_store_le(&pu8_tag[12], h3);
+    // コンテキストのクリア
+    memset(ps_ctx, 0x00, sizeof(ts_poly1305_context_t));
+}
+
+/*******************************************************************************
+ *
+ * NAME: v_chachapoly_tag
+ *
+ * DESCRIPTION:AEADの認証タグ生成
+ *
+ * PARAMETERS:      Name            RW  Usage
+ * const uint8_t*   pu8_key         R   鍵（32バイト）
+ * const uint8_t*   pu8_nonce       R   ナンス（12バイト）
+ * const uint8_t*   pu8_add         R   追加認証データ（NULL可）
+ * size_t           t_add_len       R   追加認証データサイズ
+ * const uint8_t*   pu8_cipher      R   暗号文
+ * size_t           t_cipher_len    R   暗号文サイズ
+ * uint8_t*         pu8_tag         W   認証タグ（16バイト）
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * Poly1305の鍵はブロックカウンタ0の鍵ストリームから生成する
+ ******************************************************************************/
+static void v_chachapoly_tag(const uint8_t* pu8_key, const uint8_t* pu8_nonce,
+                             const uint8_t* pu8_add, size_t t_add_len,
+                             const uint8_t* pu8_cipher, size_t t_cipher_len,
+                             uint8_t* pu8_tag) {
+    //==========================================================================
+    // ワンタイム鍵の生成
+    //==========================================================================
+    uint32_t u32_state[16];
+    uint8_t u8_block[CRYPTO_CHACHA20_BLOCK_SIZE];
+    v_chacha20_init_state(u32_state, pu8_key, pu8_nonce, 0);
+    v_chacha20_block(u32_state, u8_block);
+    ts_poly1305_context_t s_ctx;
+    v_poly1305_init(&s_ctx, u8_block);
+    memset(u8_block, 0x00, sizeof(u8_block));
+    memset(u32_state, 0x00, sizeof(u32_state));
+
+    //==========================================================================
+    // MAC(AAD || pad16 || 暗号文 || pad16 || len(AAD) || len(暗号文))
+    //==========================================================================
+    if (t_add_len > 0) {
+        v_poly1305_update(&s_ctx, pu8_add, t_add_len);
+        v_poly1305_pad16(&s_ctx, t_add_len);
+    }
+    if (t_cipher_len > 0) {
+        v_poly1305_update(&s_ctx, pu8_cipher, t_cipher_len);
+        v_poly1305_pad16(&s_ctx, t_cipher_len);
+    }
+    uint8_t u8_len[POLY1305_BLOCK_SIZE];
+    uint64_t u64_add_len    = t_add_len;
+    uint64_t u64_cipher_len = t_cipher_len;
+    v_store_le(&u8_len[0],  (uint32_t)u64_add_len);
+    v_store_le(&u8_len[4],  (uint32_t)(u64_add_len >> 32));
+    v_store_le(&u8_len[8],  (uint32_t)u64_cipher_len);
+    v_store_le(&u8_len[12], (uint32_t)(u64_cipher_len >> 32));
+    v_poly1305_update(&s_ctx, u8_len, POLY1305_BLOCK_SIZE);
+    v_poly1305_finish(&s_ctx, pu8_tag);
+}
+
+/******************************************************************************/
+/***      END OF FILE                                                       ***/
+/******************************************************************************/
@@ -0,0 +1,273 @@
+/*******************************************************************************
+ *
+ * COMPONENT:Nano Toolkit Framework
+ *
+ * MODULE :SHA-256 library source file
+ *
+ * CREATED:2024/11/18 21:00:00
+ * AUTHOR :Kakuheiki.Nakanohito
+ *
+ * DESCRIPTION:SHA-224/SHA-256（FIPS 180-4）のソフトウェア実装
+ *   メッセージスケジュールを16ワードのリングバッファで展開し、
+ *   ブロック単位の入力はバッファへコピーせずに直接圧縮する
+ *
+ * CHANGE HISTORY:
+ *
+ * LAST MODIFIED BY:
+ *
+ *******************************************************************************
+ *
+ * Copyright (c) 2024 Kakuheiki.Nakanohito
+ * Released under the MIT license
+ * https://opensource.org/licenses/mit-license.php
+ *
+ ******************************************************************************/
+
+/******************************************************************************/
+/***      Include files                                                     ***/
+/******************************************************************************/
+#include "ntfw_crypto_sha256.h"
+
+#include <string.h>
+
+/******************************************************************************/
+/***      Macro Definitions                                                 ***/
+/******************************************************************************/
+/** 右ローテート */
+#define SHA256_ROTR(x, n)       (((x) >> (n)) | ((x) << (32 - (n))))
+/** 選択関数 */
+#define SHA256_CH(x, y, z)      ((z) ^ ((x) & ((y) ^ (z))))
+/** 多数決関数 */
+#define SHA256_MAJ(x, y, z)     (((x) & (y)) | ((z) & ((x) | (y))))
+/** Σ0 */
+#define SHA256_EP0(x)           (SHA256_ROTR(x, 2) ^ SHA256_ROTR(x, 13) ^ SHA256_ROTR(x, 22))
+/** Σ1 */
+#define SHA256_EP1(x)           (SHA256_ROTR(x, 6) ^ SHA256_ROTR(x, 11) ^ SHA256_ROTR(x, 25))
+/** σ0 */
+#define SHA256_SIG0(x)          (SHA256_ROTR(x, 7) ^ SHA256_ROTR(x, 18) ^ ((x) >> 3))
+/** σ1 */
+#define SHA256_SIG1(x)          (SHA256_ROTR(x, 17) ^ SHA256_ROTR(x, 19) ^ ((x) >> 10))
+/** 長さ情報を書き込む位置 */
+#define SHA256_LEN_POS          (CRYPTO_SHA256_MSG_BLOCK - 8)
+
+/******************************************************************************/
+/***      Type Definitions                                                  ***/
+/******************************************************************************/
+
+/******************************************************************************/
+/***      Exported Variables                                                ***/
+/******************************************************************************/
+
+/******************************************************************************/
+/***      Local Variables                                                   ***/
+/******************************************************************************/
+/** ラウンド定数 */
+static const uint32_t s_u32_k[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+/** 初期ハッシュ値（SHA-256） */
+static const uint32_t s_u32_iv256[8] = {
+    0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+};
+/** 初期ハッシュ値（SHA-224） */
+static const uint32_t s_u32_iv224[8] = {
+    0xc1059ed8, 0x367cd507, 0x3070dd17, 0xf70e5939, 0xffc00b31, 0x68581511, 0x64f98fa7, 0xbefa4fa4
+};
+
+/******************************************************************************/
+/***      Local Function Prototypes                                         ***/
+/******************************************************************************/
+/** ブロックの圧縮処理 */
+static void v_sha256_block(uint32_t* pu32_state, const uint8_t* pu8_block);
+
+/******************************************************************************/
+/***      Exported Functions                                                ***/
+/******************************************************************************/
+
+/*******************************************************************************
+ *
+ * NAME: v_crypto_sha256_starts
+ *
+ * DESCRIPTION:SHA-256（SHA-224）計算の開始
+ *
+ * PARAMETERS:                  Name        RW  Usage
+ * ts_crypto_sha256_context_t*  ps_ctx      W   コンテキスト
+ * bool                         b_is224     R   SHA-224判定
+ *
+ * RETURNS:
+ *
+ ******************************************************************************/
+void v_crypto_sha256_starts(ts_crypto_sha256_context_t* ps_ctx, bool b_is224) {
+    memcpy(ps_ctx->u32_state, b_is224 ? s_u32_iv224 : s_u32_iv256, sizeof(ps_ctx->u32_state));
+    ps_ctx->u64_total = 0;
+    ps_ctx->b_is224   = b_is224;
+}
+
+/*******************************************************************************
+ *
+ * NAME: v_crypto_sha256_update
+ *
+ * DESCRIPTION:SHA-256（SHA-224）の逐次計算
+ *
+ * PARAMETERS:                  Name        RW  Usage
+ * ts_crypto_sha256_context_t*  ps_ctx      RW  コンテキスト
+ * const uint8_t*               pu8_data    R   対象データ
+ * size_t                       t_len       R   対象データサイズ
+ *
+ * RETURNS:
+ *
+ ******************************************************************************/
+void v_crypto_sha256_update(ts_crypto_sha256_context_t* ps_ctx,
+                            const uint8_t* pu8_data,
+                            size_t t_len) {
+    size_t t_fill = (size_t)(ps_ctx->u64_total % CRYPTO_SHA256_MSG_BLOCK);
+    ps_ctx->u64_total += t_len;
+    // 未処理ブロックの補充
+    if (t_fill > 0) {
+        size_t t_cpy = CRYPTO_SHA256_MSG_BLOCK - t_fill;
+        if (t_len < t_cpy) {
+            memcpy(&ps_ctx->u8_buff[t_fill], pu8_data, t_len);
+            return;
+        }
+        memcpy(&ps_ctx->u8_buff[t_fill], pu8_data, t_cpy);
+        v_sha256_block(ps_ctx->u32_state, ps_ctx->u8_buff);
+        pu8_data += t_cpy;
+        t_len    -= t_cpy;
+    }
+    // ブロック単位の直接圧縮
+    while (t_len >= CRYPTO_SHA256_MSG_BLOCK) {
+        v_sha256_block(ps_ctx->u32_state, pu8_data);
+        pu8_data += CRYPTO_SHA256_MSG_BLOCK;
+        t_len    -= CRYPTO_SHA256_MSG_BLOCK;
+    }
+    // 端数の退避
+    if (t_len > 0) {
+        memcpy(ps_ctx->u8_buff, pu8_data, t_len);
+    }
+}
+
+/*******************************************************************************
+ *
+ * NAME: v_crypto_sha256_finish
+ *
+ * DESCRIPTION:SHA-256（SHA-224）の書き出し
+ *
+ * PARAMETERS:                  Name        RW  Usage
+ * ts_crypto_sha256_context_t*  ps_ctx      RW  コンテキスト
+ * uint8_t*                     pu8_hash    W   ハッシュ値（32byte、SHA-224は28byte）
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * 書き出し後に再利用する場合はv_crypto_sha256_startsを呼び出す事
+ ******************************************************************************/
+void v_crypto_sha256_finish(ts_crypto_sha256_context_t* ps_ctx, uint8_t* pu8_hash) {
+    //==========================================================================
+    // パディング
+    //==========================================================================
+    uint64_t u64_bits = ps_ctx->u64_total << 3;
+    size_t t_fill = (size_t)(ps_ctx->u64_total % CRYPTO_SHA256_MSG_BLOCK);
+    ps_ctx->u8_buff[t_fill++] = 0x80;
+    if (t_fill > SHA256_LEN_POS) {
+        memset(&ps_ctx->u8_buff[t_fill], 0x00, CRYPTO_SHA256_MSG_BLOCK - t_fill);
+        v_sha256_block(ps_ctx->u32_state, ps_ctx->u8_buff);
+        t_fill = 0;
+    }
+    memset(&ps_ctx->u8_buff[t_fill], 0x00, SHA256_LEN_POS - t_fill);
+    uint8_t u8_idx;
+    for (u8_idx = 0; u8_idx < 8; u8_idx++) {
+        ps_ctx->u8_buff[CRYPTO_SHA256_MSG_BLOCK - 1 - u8_idx] = (uint8_t)(u64_bits >> (u8_idx * 8));
+    }
+    v_sha256_block(ps_ctx->u32_state, ps_ctx->u8_buff);
+
+    //==========================================================================
+    // ハッシュ値の書き出し（ビッグエンディアン）
+    //==========================================================================
+    uint8_t u8_words = ps_ctx->b_is224 ? 7 : 8;
+    for (u8_idx = 0; u8_idx < u8_words; u8_idx++) {
+        uint32_t u32_val = ps_ctx->u32_state[u8_idx];
+        pu8_hash[u8_idx * 4]     = (uint8_t)(u32_val >> 24);
+        pu8_hash[u8_idx * 4 + 1] = (uint8_t)(u32_val >> 16);
+        pu8_hash[u8_idx * 4 + 2] = (uint8_t)(u32_val >> 8);
+        pu8_hash[u8_idx * 4 + 3] = (uint8_t)u32_val;
+    }
+    // 入力データの残骸をクリア
+    memset(ps_ctx->u8_buff, 0x00, sizeof(ps_ctx->u8_buff));
+}
+
+/******************************************************************************/
+/***      Local Functions                                                   ***/
+/******************************************************************************/
+
+/*******************************************************************************
+ *
+ * NAME: v_sha256_block
+ *
+ * DESCRIPTION:ブロックの圧縮処理
+ *
+ * PARAMETERS:      Name        RW  Usage
+ * uint32_t*        pu32_state  RW  中間ハッシュ値
+ * const uint8_t*   pu8_block   R   メッセージブロック（64byte）
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * メッセージスケジュールは直近16ワードのみを保持する
+ ******************************************************************************/
+static void v_sha256_block(uint32_t* pu32_state, const uint8_t* pu8_block) {
+    uint32_t u32_w[16];
+    uint32_t u32_a = pu32_state[0];
+    uint32_t u32_b = pu32_state[1];
+    uint32_t u32_c = pu32_state[2];
+    uint32_t u32_d = pu32_state[3];
+    uint32_t u32_e = pu32_state[4];
+    uint32_t u32_f = pu32_state[5];
+    uint32_t u32_g = pu32_state[6];
+    uint32_t u32_h = pu32_state[7];
+    uint32_t u32_t1;
+    uint32_t u32_t2;
+    uint32_t u32_idx;
+    for (u32_idx = 0; u32_idx < 64; u32_idx++) {
+        // メッセージスケジュールの展開
+        if (u32_idx < 16) {
+            const uint8_t* pu8_w = &pu8_block[u32_idx * 4];
+            u32_w[u32_idx] = ((uint32_t)pu8_w[0] << 24) | ((uint32_t)pu8_w[1] << 16) |
+                             ((uint32_t)pu8_w[2] << 8)  |  (uint32_t)pu8_w[3];
+        } else {
+            u32_w[u32_idx & 0x0F] += SHA256_SIG1(u32_w[(u32_idx - 2) & 0x0F]) +
+                                     u32_w[(u32_idx - 7) & 0x0F] +
+                                     SHA256_SIG0(u32_w[(u32_idx - 15) & 0x0F]);
+        }
+        // ラウンド処理
+        u32_t1 = u32_h + SHA256_EP1(u32_e) + SHA256_CH(u32_e, u32_f, u32_g) +
+                 s_u32_k[u32_idx] + u32_w[u32_idx & 0x0F];
+        u32_t2 = SHA256_EP0(u32_a) + SHA256_MAJ(u32_a, u32_b, u32_c);
+        u32_h = u32_g;
+        u32_g = u32_f;
+        u32_f = u32_e;
+        u32_e = u32_d + u32_t1;
+        u32_d = u32_c;
+        u32_c = u32_b;
+        u32_b = u32_a;
+        u32_a = u32_t1 + u32_t2;
+    }
+    pu32_state[0] += u32_a;
+    pu32_state[1] += u32_b;
+    pu32_state[2] += u32_c;
+    pu32_state[3] += u32_d;
+    pu32_state[4] += u32_e;
+    pu32_state[5] += u32_f;
+    pu32_state[6] += u32_g;
+    pu32_state[7] += u32_h;
+}
+
+/******************************************************************************/
+/***      END OF FILE                                                       ***/
+/******************************************************************************/
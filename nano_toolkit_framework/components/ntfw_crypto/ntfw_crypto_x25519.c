@@ -0,0 +1,559 @@
+/*******************************************************************************
+ *
+ * COMPONENT:Nano Toolkit Framework
+ *
+ * MODULE :X25519 library source file
+ *
+ * CREATED:2024/11/17 21:00:00
+ * AUTHOR :Kakuheiki.Nakanohito
+ *
+ * DESCRIPTION:X25519（RFC 7748）の鍵共有
+ *   体演算は2^25.5基数の10リム（26bit/25bitの交互）で表現し、
+ *   モンゴメリラダーを条件付き交換で実行する事で秘密鍵に依存しない定数時間で演算する
+ *
+ * CHANGE HISTORY:
+ *
+ * LAST MODIFIED BY:
+ *
+ *******************************************************************************
+ *
+ * Copyright (c) 2024 Kakuheiki.Nakanohito
+ * Released under the MIT license
+ * https://opensource.org/licenses/mit-license.php
+ *
+ ******************************************************************************/
+
+/******************************************************************************/
+/***      Include files                                                     ***/
+/******************************************************************************/
+#include "ntfw_crypto_x25519.h"
+
+#include <string.h>
+
+/******************************************************************************/
+/***      Macro Definitions                                                 ***/
+/******************************************************************************/
+/** 体要素のリム数 */
+#define FE_LIMB_CNT             (10)
+/** リムのビット幅（偶数:26bit、奇数:25bit） */
+#define FE_LIMB_BITS(i)         (((i) & 0x01) ? 25 : 26)
+/** モンゴメリラダーの定数 (A - 2) / 4 */
+#define X25519_A24              (121665)
+
+/******************************************************************************/
+/***      Type Definitions                                                  ***/
+/******************************************************************************/
+/**
+ * 体要素（GF(2^255-19)、2^25.5基数）
+ */
+typedef struct {
+    int32_t i32_v[FE_LIMB_CNT];
+} ts_fe_t;
+
+/******************************************************************************/
+/***      Exported Variables                                                ***/
+/******************************************************************************/
+
+/******************************************************************************/
+/***      Local Variables                                                   ***/
+/******************************************************************************/
+/** ベースポイント（u=9） */
+static const uint8_t s_base_point[CRYPTO_X25519_BYTES] = {9};
+/** 各リムの開始ビット位置 */
+static const uint8_t s_limb_offset[FE_LIMB_CNT] = {0, 26, 51, 77, 102, 128, 153, 179, 204, 230};
+
+/******************************************************************************/
+/***      Local Function Prototypes                                         ***/
+/******************************************************************************/
+/** 体要素の読み込み */
+static void v_fe_from_bytes(ts_fe_t* ps_h, const uint8_t* pu8_src);
+/** 体要素の書き込み（完全剰余） */
+static void v_fe_to_bytes(uint8_t* pu8_dst, const ts_fe_t* ps_h);
+/** 体要素の桁上げ */
+static void v_fe_carry(ts_fe_t* ps_h, int64_t* pi64_h);
+/** 体要素の加算 */
+static void v_fe_add(ts_fe_t* ps_h, const ts_fe_t* ps_f, const ts_fe_t* ps_g);
+/** 体要素の減算 */
+static void v_fe_sub(ts_fe_t* ps_h, const ts_fe_t* ps_f, const ts_fe_t* ps_g);
+/** 体要素の乗算 */
+static void v_fe_mul(ts_fe_t* ps_h, const ts_fe_t* ps_f, const ts_fe_t* ps_g);
+/** 体要素の二乗の繰り返し */
+static void v_fe_sq_n(ts_fe_t* ps_h, const ts_fe_t* ps_f, uint32_t u32_cnt);
+/** 体要素とA24の乗算 */
+static void v_fe_mul_a24(ts_fe_t* ps_h, const ts_fe_t* ps_f);
+/** 体要素の逆元 */
+static void v_fe_invert(ts_fe_t* ps_h, const ts_fe_t* ps_z);
+/** 体要素の条件付き交換 */
+static void v_fe_cswap(ts_fe_t* ps_f, ts_fe_t* ps_g, uint32_t u32_swap);
+
+/******************************************************************************/
+/***      Exported Functions                                                ***/
+/******************************************************************************/
+
+/*******************************************************************************
+ *
+ * NAME: b_crypto_x25519_scalarmult
+ *
+ * DESCRIPTION:X25519のスカラー倍算
+ *
+ * PARAMETERS:      Name            RW  Usage
+ * uint8_t*         pu8_out         W   演算結果（32バイト）
+ * const uint8_t*   pu8_scalar      R   スカラー（秘密鍵、32バイト）
+ * const uint8_t*   pu8_point       R   u座標（相手の公開鍵、32バイト）
+ *
+ * RETURNS:
+ *   true:正常終了（演算結果が全て0の場合はfalse）
+ *
+ * NOTES:
+ * スカラーはRFC 7748の通りクランプし、u座標の最上位ビットは無視する
+ ******************************************************************************/
+bool b_crypto_x25519_scalarmult(uint8_t* pu8_out,
+                                const uint8_t* pu8_scalar,
+                                const uint8_t* pu8_point) {
+    //==========================================================================
+    // スカラーのクランプ
+    //==========================================================================
+    uint8_t u8_e[CRYPTO_X25519_BYTES];
+    memcpy(u8_e, pu8_scalar, CRYPTO_X25519_BYTES);
+    u8_e[0]  &= 0xF8;
+    u8_e[31] &= 0x7F;
+    u8_e[31] |= 0x40;
+
+    //==========================================================================
+    // モンゴメリラダー
+    //==========================================================================
+    ts_fe_t s_x1;
+    ts_fe_t s_x2 = {{1}};
+    ts_fe_t s_z2 = {{0}};
+    ts_fe_t s_x3;
+    ts_fe_t s_z3 = {{1}};
+    ts_fe_t s_a;
+    ts_fe_t s_aa;
+    ts_fe_t s_b;
+    ts_fe_t s_bb;
+    ts_fe_t s_e;
+    ts_fe_t s_c;
+    ts_fe_t s_d;
+    ts_fe_t s_da;
+    ts_fe_t s_cb;
+    v_fe_from_bytes(&s_x1, pu8_point);
+    s_x3 = s_x1;
+    uint32_t u32_swap = 0;
+    int i_pos;
+    for (i_pos = 254; i_pos >= 0; i_pos--) {
+        uint32_t u32_bit = (u8_e[i_pos >> 3] >> (i_pos & 0x07)) & 0x01;
+        u32_swap ^= u32_bit;
+        v_fe_cswap(&s_x2, &s_x3, u32_swap);
+        v_fe_cswap(&s_z2, &s_z3, u32_swap);
+        u32_swap = u32_bit;
+        // 点の加算と2倍算
+        v_fe_add(&s_a, &s_x2, &s_z2);
+        v_fe_mul(&s_aa, &s_a, &s_a);
+        v_fe_sub(&s_b, &s_x2, &s_z2);
+        v_fe_mul(&s_bb, &s_b, &s_b);
+        v_fe_sub(&s_e, &s_aa, &s_bb);
+        v_fe_add(&s_c, &s_x3, &s_z3);
+        v_fe_sub(&s_d, &s_x3, &s_z3);
+        v_fe_mul(&s_da, &s_d, &s_a);
+        v_fe_mul(&s_cb, &s_c, &s_b);
+        v_fe_add(&s_x3, &s_da, &s_cb);
+        v_fe_mul(&s_x3, &s_x3, &s_x3);
+        v_fe_sub(&s_z3, &s_da, &s_cb);
+        v_fe_mul(&s_z3, &s_z3, &s_z3);
+        v_fe_mul(&s_z3, &s_z3, &s_x1);
+        v_fe_mul(&s_x2, &s_aa, &s_bb);
+        v_fe_mul_a24(&s_a, &s_e);
+        v_fe_add(&s_a, &s_a, &s_aa);
+        v_fe_mul(&s_z2, &s_e, &s_a);
+    }
+    v_fe_cswap(&s_x2, &s_x3, u32_swap);
+    v_fe_cswap(&s_z2, &s_z3, u32_swap);
+
+    //==========================================================================
+    // アフィン座標への変換
+    //==========================================================================
+    v_fe_invert(&s_z2, &s_z2);
+    v_fe_mul(&s_x2, &s_x2, &s_z2);
+    v_fe_to_bytes(pu8_out, &s_x2);
+
+    //==========================================================================
+    // 演算結果のチェック（小位数点の排除）
+    //==========================================================================
+    uint8_t u8_acc = 0x00;
+    uint8_t u8_idx;
+    for (u8_idx = 0; u8_idx < CRYPTO_X25519_BYTES; u8_idx++) {
+        u8_acc |= pu8_out[u8_idx];
+    }
+    // 秘密情報のクリア
+    memset(u8_e, 0x00, sizeof(u8_e));
+    memset(&s_x2, 0x00, sizeof(ts_fe_t));
+    memset(&s_z2, 0x00, sizeof(ts_fe_t));
+    memset(&s_x3, 0x00, sizeof(ts_fe_t));
+    memset(&s_z3, 0x00, sizeof(ts_fe_t));
+    // 結果返信
+    return (u8_acc != 0x00);
+}
+
+/*******************************************************************************
+ *
+ * NAME: v_crypto_x25519_public_key
+ *
+ * DESCRIPTION:X25519の公開鍵算出
+ *
+ * PARAMETERS:      Name            RW  Usage
+ * uint8_t*         pu8_pub_key     W   公開鍵（32バイト）
+ * const uint8_t*   pu8_scalar      R   スカラー（秘密鍵、32バイト）
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * None.
+ ******************************************************************************/
+void v_crypto_x25519_public_key(uint8_t* pu8_pub_key,
+                                const uint8_t* pu8_scalar) {
+    // ベースポイントとのスカラー倍算（クランプ済みスカラーの結果は0にならない）
+    b_crypto_x25519_scalarmult(pu8_pub_key, pu8_scalar, s_base_point);
+}
+
+/******************************************************************************/
+/***      Local Functions                                                   ***/
+/******************************************************************************/
+
+/*******************************************************************************
+ *
+ * NAME: v_fe_from_bytes
+ *
+ * DESCRIPTION:体要素の読み込み
+ *
+ * PARAMETERS:      Name            RW  Usage
+ * ts_fe_t*         ps_h            W   体要素
+ * const uint8_t*   pu8_src         R   リトルエンディアンの値（32バイト）
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * 最上位ビットは無視する
+ ******************************************************************************/
+static void v_fe_from_bytes(ts_fe_t* ps_h, const uint8_t* pu8_src) {
+    uint32_t u32_idx;
+    for (u32_idx = 0; u32_idx < FE_LIMB_CNT; u32_idx++) {
+        uint32_t u32_offset = s_limb_offset[u32_idx];
+        uint32_t u32_byte = u32_offset >> 3;
+        uint64_t u64_val = 0;
+        uint32_t u32_cnt;
+        for (u32_cnt = 0; u32_cnt < 5 && (u32_byte + u32_cnt) < CRYPTO_X25519_BYTES; u32_cnt++) {
+            u64_val |= (uint64_t)pu8_src[u32_byte + u32_cnt] << (u32_cnt * 8);
+        }
+        u64_val >>= (u32_offset & 0x07);
+        ps_h->i32_v[u32_idx] = (int32_t)(u64_val & (((uint64_t)1 << FE_LIMB_BITS(u32_idx)) - 1));
+    }
+}
+
+/*******************************************************************************
+ *
+ * NAME: v_fe_to_bytes
+ *
+ * DESCRIPTION:体要素の書き込み
+ *
+ * PARAMETERS:      Name            RW  Usage
+ * uint8_t*         pu8_dst         W   リトルエンディアンの値（32バイト）
+ * const ts_fe_t*   ps_h            R   体要素（桁上げ済み）
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * 2^255-19未満に完全剰余してから書き込む
+ ******************************************************************************/
+static void v_fe_to_bytes(uint8_t* pu8_dst, const ts_fe_t* ps_h) {
+    //==========================================================================
+    // 完全剰余（h - q * p、qは0か1）
+    //==========================================================================
+    int32_t i32_h[FE_LIMB_CNT];
+    memcpy(i32_h, ps_h->i32_v, sizeof(i32_h));
+    int32_t i32_q = (19 * i32_h[9] + ((int32_t)1 << 24)) >> 25;
+    uint32_t u32_idx;
+    for (u32_idx = 0; u32_idx < FE_LIMB_CNT; u32_idx++) {
+        i32_q = (i32_h[u32_idx] + i32_q) >> FE_LIMB_BITS(u32_idx);
+    }
+    i32_h[0] += 19 * i32_q;
+    for (u32_idx = 0; u32_idx < FE_LIMB_CNT; u32_idx++) {
+        int32_t i32_carry = i32_h[u32_idx] >> FE_LIMB_BITS(u32_idx);
+        i32_h[u32_idx] -= i32_carry * ((int32_t)1 << FE_LIMB_BITS(u32_idx));
+        if (u32_idx < FE_LIMB_CNT - 1) {
+            i32_h[u32_idx + 1] += i32_carry;
+        }
+    }
+
+    //==========================================================================
+    // バイト列に変換
+    //==========================================================================
+    uint64_t u64_acc = 0;
+    uint32_t u32_bits = 0;
+    uint32_t u32_pos = 0;
+    for (u32_idx = 0; u32_idx < FE_LIMB_CNT; u32_idx++) {
+        u64_acc |= (uint64_t)(uint32_t)i32_h[u32_idx] << u32_bits;
+        u32_bits += FE_LIMB_BITS(u32_idx);
+        while (u32_bits >= 8) {
+            pu8_dst[u32_pos++] = (uint8_t)u64_acc;
+            u64_acc >>= 8;
+            u32_bits -= 8;
+        }
+    }
+    pu8_dst[u32_pos] = (uint8_t)u64_acc;
+}
+
+/*******************************************************************************
+ *
+ * NAME: v_fe_carry
+ *
+ * DESCRIPTION:体要素の桁上げ
+ *
+ * PARAMETERS:      Name            RW  Usage
+ * ts_fe_t*         ps_h            W   桁上げ後の体要素
+ * int64_t*         pi64_h          RW  桁上げ前の各リム
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * 最上位リムの桁上げは2^255≡19として最下位リムに還元する
+ ******************************************************************************/
+static void v_fe_carry(ts_fe_t* ps_h, int64_t* pi64_h) {
+    int64_t i64_carry;
+    uint32_t u32_idx;
+    for (u32_idx = 0; u32_idx < FE_LIMB_CNT; u32_idx++) {
+        uint32_t u32_bits = FE_LIMB_BITS(u32_idx);
+        i64_carry = (pi64_h[u32_idx] + ((int64_t)1 << (u32_bits - 1))) >> u32_bits;
+        pi64_h[u32_idx] -= i64_carry * ((int64_t)1 << u32_bits);
+        if (u32_idx < FE_LIMB_CNT - 1) {
+            pi64_h[u32_idx + 1] += i64_carry;
+        } else {
+            pi64_h[0] += i64_carry * 19;
+        }
+    }
+    i64_carry = (pi64_h[0] + ((int64_t)1 << 25)) >> 26;
+    pi64_h[0] -= i64_carry * ((int64_t)1 << 26);
+    pi64_h[1] += i64_carry;
+    for (u32_idx = 0; u32_idx < FE_LIMB_CNT; u32_idx++) {
+        ps_h->i32_v[u32_idx] = (int32_t)pi64_h[u32_idx];
+    }
+}
+
+/*******************************************************************************
+ *
+ * NAME: v_fe_add
+ *
+ * DESCRIPTION:体要素の加算
+ *
+ * PARAMETERS:      Name            RW  Usage
+ * ts_fe_t*         ps_h            W   演算結果
+ * const ts_fe_t*   ps_f            R   被加数
+ * const ts_fe_t*   ps_g            R   加数
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * 桁上げはしない
+ ******************************************************************************/
+static void v_fe_add(ts_fe_t* ps_h, const ts_fe_t* ps_f, const ts_fe_t* ps_g) {
+    uint32_t u32_idx;
+    for (u32_idx = 0; u32_idx < FE_LIMB_CNT; u32_idx++) {
+        ps_h->i32_v[u32_idx] = ps_f->i32_v[u32_idx] + ps_g->i32_v[u32_idx];
+    }
+}
+
+/*******************************************************************************
+ *
+ * NAME: v_fe_sub
+ *
+ * DESCRIPTION:体要素の減算
+ *
+ * PARAMETERS:      Name            RW  Usage
+ * ts_fe_t*         ps_h            W   演算結果
+ * const ts_fe_t*   ps_f            R   被減数
+ * const ts_fe_t*   ps_g            R   減数
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * 桁上げはしない
+ ******************************************************************************/
+static void v_fe_sub(ts_fe_t* ps_h, const ts_fe_t* ps_f, const ts_fe_t* ps_g) {
+    uint32_t u32_idx;
+    for (u32_idx = 0; u32_idx < FE_LIMB_CNT; u32_idx++) {
+        ps_h->i32_v[u32_idx] = ps_f->i32_v[u32_idx] - ps_g->i32_v[u32_idx];
+    }
+}
+
+/*******************************************************************************
+ *
+ * NAME: v_fe_mul
+ *
+ * DESCRIPTION:体要素の乗算
+ *
+ * PARAMETERS:      Name            RW  Usage
+ * ts_fe_t*         ps_h            W   演算結果
+ * const ts_fe_t*   ps_f            R   被乗数
+ * const ts_fe_t*   ps_g            R   乗数
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * 奇数リム同士の積は基数の端数（2^0.5の2乗）分を2倍し、
+ * 2^255以上の桁は19倍して下位に還元する
+ ******************************************************************************/
+static void v_fe_mul(ts_fe_t* ps_h, const ts_fe_t* ps_f, const ts_fe_t* ps_g) {
+    int64_t i64_h[FE_LIMB_CNT] = {0};
+    uint32_t u32_i;
+    uint32_t u32_j;
+    for (u32_i = 0; u32_i < FE_LIMB_CNT; u32_i++) {
+        int64_t i64_f = ps_f->i32_v[u32_i];
+        int64_t i64_f2 = i64_f * ((u32_i & 0x01) + 1);
+        for (u32_j = 0; u32_j < FE_LIMB_CNT; u32_j++) {
+            int64_t i64_g = ps_g->i32_v[u32_j];
+            int64_t i64_p = ((u32_j & 0x01) ? i64_f2 : i64_f) * i64_g;
+            uint32_t u32_k = u32_i + u32_j;
+            if (u32_k < FE_LIMB_CNT) {
+                i64_h[u32_k] += i64_p;
+            } else {
+                i64_h[u32_k - FE_LIMB_CNT] += i64_p * 19;
+            }
+        }
+    }
+    v_fe_carry(ps_h, i64_h);
+}
+
+/*******************************************************************************
+ *
+ * NAME: v_fe_sq_n
+ *
+ * DESCRIPTION:体要素の二乗の繰り返し
+ *
+ * PARAMETERS:      Name            RW  Usage
+ * ts_fe_t*         ps_h            W   演算結果
+ * const ts_fe_t*   ps_f            R   体要素
+ * uint32_t         u32_cnt         R   二乗の回数
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * None.
+ ******************************************************************************/
+static void v_fe_sq_n(ts_fe_t* ps_h, const ts_fe_t* ps_f, uint32_t u32_cnt) {
+    v_fe_mul(ps_h, ps_f, ps_f);
+    while (--u32_cnt > 0) {
+        v_fe_mul(ps_h, ps_h, ps_h);
+    }
+}
+
+/*******************************************************************************
+ *
+ * NAME: v_fe_mul_a24
+ *
+ * DESCRIPTION:体要素とA24の乗算
+ *
+ * PARAMETERS:      Name            RW  Usage
+ * ts_fe_t*         ps_h            W   演算結果
+ * const ts_fe_t*   ps_f            R   体要素
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * None.
+ ******************************************************************************/
+static void v_fe_mul_a24(ts_fe_t* ps_h, const ts_fe_t* ps_f) {
+    int64_t i64_h[FE_LIMB_CNT];
+    uint32_t u32_idx;
+    for (u32_idx = 0; u32_idx < FE_LIMB_CNT; u32_idx++) {
+        i64_h[u32_idx] = (int64_t)ps_f->i32_v[u32_idx] * X25519_A24;
+    }
+    v_fe_carry(ps_h, i64_h);
+}
+
+/*******************************************************************************
+ *
+ * NAME: v_fe_invert
+ *
+ * DESCRIPTION:体要素の逆元
+ *
+ * PARAMETERS:      Name            RW  Usage
+ * ts_fe_t*         ps_h            W   演算結果
+ * const ts_fe_t*   ps_z            R   体要素
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * フェルマーの小定理によりz^(2^255-21)を254回の二乗と11回の乗算で求める
+ ******************************************************************************/
+static void v_fe_invert(ts_fe_t* ps_h, const ts_fe_t* ps_z) {
+    ts_fe_t s_z2;
+    ts_fe_t s_z9;
+    ts_fe_t s_z11;
+    ts_fe_t s_z2_5_0;
+    ts_fe_t s_z2_10_0;
+    ts_fe_t s_z2_20_0;
+    ts_fe_t s_z2_50_0;
+    ts_fe_t s_z2_100_0;
+    ts_fe_t s_t;
+    // z^2, z^9, z^11
+    v_fe_mul(&s_z2, ps_z, ps_z);
+    v_fe_sq_n(&s_t, &s_z2, 2);
+    v_fe_mul(&s_z9, &s_t, ps_z);
+    v_fe_mul(&s_z11, &s_z9, &s_z2);
+    // z^(2^5-1)
+    v_fe_mul(&s_t, &s_z11, &s_z11);
+    v_fe_mul(&s_z2_5_0, &s_t, &s_z9);
+    // z^(2^10-1)
+    v_fe_sq_n(&s_t, &s_z2_5_0, 5);
+    v_fe_mul(&s_z2_10_0, &s_t, &s_z2_5_0);
+    // z^(2^20-1)
+    v_fe_sq_n(&s_t, &s_z2_10_0, 10);
+    v_fe_mul(&s_z2_20_0, &s_t, &s_z2_10_0);
+    // z^(2^40-1)
+    v_fe_sq_n(&s_t, &s_z2_20_0, 20);
+    v_fe_mul(&s_t, &s_t, &s_z2_20_0);
+    // z^(2^50-1)
+    v_fe_sq_n(&s_t, &s_t, 10);
+    v_fe_mul(&s_z2_50_0, &s_t, &s_z2_10_0);
+    // z^(2^100-1)
+    v_fe_sq_n(&s_t, &s_z2_50_0, 50);
+    v_fe_mul(&s_z2_100_0, &s_t, &s_z2_50_0);
+    // z^(2^200-1)
+    v_fe_sq_n(&s_t, &s_z2_100_0, 100);
+    v_fe_mul(&s_t, &s_t, &s_z2_100_0);
+    // z^(2^250-1)
+    v_fe_sq_n(&s_t, &s_t, 50);
+    v_fe_mul(&s_t, &s_t, &s_z2_50_0);
+    // z^(2^255-21)
+    v_fe_sq_n(&s_t, &s_t, 5);
+    v_fe_mul(ps_h, &s_t, &s_z11);
+}
+
+/*******************************************************************************
+ *
+ * NAME: v_fe_cswap
+ *
+ * DESCRIPTION:体要素の条件付き交換
+ *
+ * PARAMETERS:      Name            RW  Usage
+ * ts_fe_t*         ps_f            RW  体要素
+ * ts_fe_t*         ps_g            RW  体要素
+ * uint32_t         u32_swap        R   交換フラグ（0 or 1）
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * 分岐を使わずにマスク演算で交換する
+ ******************************************************************************/
+static void v_fe_cswap(ts_fe_t* ps_f, ts_fe_t* ps_g, uint32_t u32_swap) {
+    int32_t i32_mask = -(int32_t)u32_swap;
+    uint32_t u32_idx;
+    for (u32_idx = 0; u32_idx < FE_LIMB_CNT; u32_idx++) {
+        int32_t i32_x = i32_mask & (ps_f->i32_v[u32_idx] ^ ps_g->i32_v[u32_idx]);
+        ps_f->i32_v[u32_idx] ^= i32_x;
+        ps_g->i32_v[u32_idx] ^= i32_x;
+    }
+}
+
+/******************************************************************************/
+/***      END OF FILE                                                       ***/
+/******************************************************************************/
@@ -29,10 +29,11 @@
 #include <string.h>
 #include <esp_log.h>
 #include <esp_random.h>
+#include <freertos/task.h>
 #include <mbedtls/sha1.h>
-#include <mbedtls/sha256.h>
 #include <mbedtls/sha512.h>
 #include <mbedtls/gcm.h>
+#include <mbedtls/platform_util.h>
 #include "ntfw_com_mem_alloc.h"
 #include "ntfw_com_value_util.h"
 
@@ -41,6 +42,8 @@
 /******************************************************************************/
 // Personalization data length
 #define CRYPTO_PERSONAL_DATA_LEN    (16)
+// Random block size for charset mapping
+#define CRYPTO_RANDOM_BLOCK_SIZE    (64)
 
 //==============================================================================
 // SHA
@@ -55,6 +58,12 @@
 #define CRYPTO_SHA384_SIZE  (48)
 // hash size:SHA512
 #define CRYPTO_SHA512_SIZE  (64)
+// block size:SHA224/SHA256
+#define CRYPTO_SHA256_BLOCK_SIZE    (64)
+// block size:SHA384/SHA512
+#define CRYPTO_SHA512_BLOCK_SIZE    (128)
+// block size:max
+#define CRYPTO_HASH_MAX_BLOCK_SIZE  (CRYPTO_SHA512_BLOCK_SIZE)
 
 //==============================================================================
 // ECDH
@@ -63,15 +72,20 @@
 #define CRYPTO_CURVE25519_CLIENT_PUBLIC_KEY_LEN (36)
 // CURVE25519 server public key size
 #define CRYPTO_CURVE25519_SERVER_PUBLIC_KEY_LEN (33)
+// CURVE25519 public key header size（ECParameters + ECPoint length）
+#define CRYPTO_CURVE25519_PUBLIC_KEY_HEADER_LEN (4)
 
 /******************************************************************************/
 /***      Type Definitions                                                  ***/
 /******************************************************************************/
 /**
- * 疑似乱数生成器のコンテキスト
+ * 疑似乱数生成器のコンテキスト（コア毎に常駐）
  */
 typedef struct {
-    mbedtls_entropy_context s_entropy_ctx;      // エントロピーコンテキスト
+    SemaphoreHandle_t s_mutex;                  // ミューテックス
+    StaticSemaphore_t s_mutex_buffer;           // ミューテックス領域
+    bool b_seeded;                              // シード済みフラグ
+    uint32_t u32_policy_ver;                    // 適用済みの再シードポリシーのバージョン
     mbedtls_ctr_drbg_context s_ctr_drbg_ctx;    // カウンタ使用の疑似乱数生成器のコンテキスト
 } ts_crypto_drbg_context_t;
 
@@ -93,10 +107,30 @@ typedef void (*tf_ble_rx_data_t)(TickType_t t_tick);
 /******************************************************************************/
 /***      Local Variables                                                   ***/
 /******************************************************************************/
-/** ミューテックス（乱数生成器等を排他制御） */
-static SemaphoreHandle_t s_mutex = NULL;
+/** 初期処理用のスピンロック */
+static portMUX_TYPE s_init_spinlock = portMUX_INITIALIZER_UNLOCKED;
 /** drbg context */
-static ts_crypto_drbg_context_t s_drbg_context;
+static ts_crypto_drbg_context_t s_drbg_context[portNUM_PROCESSORS];
+/** 再シード間隔 */
+static uint32_t s_drbg_reseed_interval = CRYPTO_DRBG_RESEED_INTERVAL;
+/** 予測困難性（生成毎の再シード） */
+static bool s_drbg_prediction_resistance = CRYPTO_DRBG_PREDICTION_RESISTANCE;
+/** 再シードポリシーのバージョン（ポリシー変更時に更新） */
+static volatile uint32_t s_drbg_policy_ver = 1;
+/** X25519公開鍵のヘッダ（ECParameters:named_curve x25519、ECPoint長） */
+static const uint8_t s_x25519_pub_key_header[CRYPTO_CURVE25519_PUBLIC_KEY_HEADER_LEN] = {
+    0x03, 0x00, 0x1D, CRYPTO_X25519_BYTES
+};
+/** X25519鍵ペアプールのスピンロック */
+static portMUX_TYPE s_x25519_pool_spinlock = portMUX_INITIALIZER_UNLOCKED;
+/** X25519鍵ペアプール（未使用の鍵ペア） */
+static ts_crypto_x25519_context_t* s_x25519_pool[CRYPTO_X25519_POOL_SIZE];
+/** X25519鍵ペアプールの在庫数 */
+static uint32_t s_x25519_pool_cnt = 0;
+/** X25519鍵ペアプールの補充タスク */
+static TaskHandle_t s_x25519_pool_handle = NULL;
+/** X25519鍵ペアプールの補充開始済みフラグ */
+static bool s_x25519_pool_started = false;
 
 /******************************************************************************/
 /***      Local Function Prototypes                                         ***/
@@ -108,14 +142,31 @@ static void v_crypto_init_dmy();
 /** 初期化関数 */
 static v_crypto_init_t f_crypto_init = v_crypto_init;
 
-/** drbg transaction start */
-static esp_err_t sts_drbg_transaction_start();
-/** drbg transaction end */
-static void v_drbg_transaction_end();
-
+/** 自コアの疑似乱数生成器の取得（排他制御開始） */
+static ts_crypto_drbg_context_t* ps_drbg_acquire();
+/** 疑似乱数生成器の解放（排他制御終了） */
+static void v_drbg_release(ts_crypto_drbg_context_t* ps_drbg);
+/** 疑似乱数生成器の初期シード */
+static esp_err_t sts_drbg_seed(ts_crypto_drbg_context_t* ps_drbg);
+
+/** SHA512系のハッシュアルゴリズム判定 */
+static bool b_hash_is_sha512(te_crypto_hash_type_t e_type);
+/** ハッシュアルゴリズムのブロックサイズ */
+static uint32_t u32_hash_block_size(te_crypto_hash_type_t e_type);
+/** ハッシュコンテキストの複製 */
+static void v_hash_clone(ts_crypto_hash_context_t* ps_dst, const ts_crypto_hash_context_t* ps_src);
+/** HMACのパッド適用済みハッシュ状態の生成 */
+static esp_err_t sts_hmac_pad_state(ts_crypto_hash_context_t* ps_dst, const uint8_t* pu8_pad, uint32_t u32_size);
+
+/** X25519鍵ペアの生成 */
+static ts_crypto_x25519_context_t* ps_x25519_keypair();
+/** X25519鍵ペアの取得（プールに無い場合は生成） */
+static ts_crypto_x25519_context_t* ps_x25519_pool_take();
+/** X25519鍵ペアプールの補充タスク */
+static void v_x25519_pool_task(void* pv_args);
 
 /** Entropy source with hardware random numbers */
-static int i_entropy_source_hw_random(void* pv_data, unsigned char* puc_output, size_t t_len, size_t* pt_outpu_len);
+static int i_entropy_source_hw_random(void* pv_data, unsigned char* puc_output, size_t t_len);
 
 /******************************************************************************/
 /***      Exported Functions                                                ***/
@@ -155,16 +206,10 @@ ts_u8_array_t* ps_crypto_random_token(char* pc_charset, uint32_t u32_len) {
         l_mem_free(ps_array);
         return NULL;
     }
-    // 乱数配列生成
-    uint8_t* pu8_value = ps_array->pu8_values;
-    b_vutil_set_u8_rand_array( pu8_value, u32_len);
     // 乱数文字列編集
-    uint32_t u32_ch_idx;
-    uint32_t u32_str_len = strlen(pc_charset);
-    uint32_t u32_idx;
-    for (u32_idx = 0; u32_idx < u32_len; u32_idx++) {
-        u32_ch_idx =  pu8_value[u32_idx] % u32_str_len;
-        pu8_value[u32_idx] = pc_charset[u32_ch_idx];
+    if (sts_crypto_random_charset(pc_charset, ps_array->pu8_values, u32_len) != ESP_OK) {
+        sts_mdl_delete_u8_array(ps_array);
+        return NULL;
     }
     // 結果返却
     return ps_array;
@@ -363,7 +408,7 @@ uint32_t u32_crypto_pkcs7_unpated_length(ts_u8_array_t* ps_data, uint8_t u8_bloc
     }
     // アンパディング後サイズ等を算出
     uint8_t  u8_padding   = ps_data->pu8_values[ps_data->t_size - 1];
-    if (u8_padding > u8_block_size || u8_padding < ps_data->t_size) {
+    if (u8_padding == 0 || u8_padding > u8_block_size) {
         return ps_data->t_size;
     }
     uint32_t u32_new_size = ps_data->t_size - u8_padding;
@@ -393,6 +438,9 @@ uint32_t u32_crypto_pkcs7_unpated_length(ts_u8_array_t* ps_data, uint8_t u8_bloc
  * RETURNS:
  *   esp_err_t:結果ステータス
  *
+ * NOTES:
+ * 結果編集対象にはパディング対象と同じバッファを指定可能。
+ * パディング値が0またはブロックサイズを超える場合はパディングエラー
  ******************************************************************************/
 esp_err_t sts_crypto_pkcs7_unpadding(uint8_t* pu8_edit, ts_u8_array_t* ps_data, uint8_t u8_block_size) {
     // 入力チェック
@@ -404,6 +452,10 @@ esp_err_t sts_crypto_pkcs7_unpadding(uint8_t* pu8_edit, ts_u8_array_t* ps_data,
     }
     // アンパディング後サイズ等を算出
     uint8_t  u8_padding   = ps_data->pu8_values[ps_data->t_size - 1];
+    if (u8_padding == 0 || u8_padding > u8_block_size) {
+        // パディングエラー
+        return ESP_ERR_INVALID_ARG;
+    }
     uint32_t u32_new_size = ps_data->t_size - u8_padding;
     // パディングのチェック
     uint32_t u32_idx;
@@ -413,8 +465,8 @@ esp_err_t sts_crypto_pkcs7_unpadding(uint8_t* pu8_edit, ts_u8_array_t* ps_data,
             return ESP_ERR_INVALID_ARG;
         }
     }
-    // アンパディング処理
-    memcpy(pu8_edit, ps_data->pu8_values, u32_new_size);
+    // アンパディング処理（編集対象と同じバッファも可）
+    memmove(pu8_edit, ps_data->pu8_values, u32_new_size);
     // 正常終了
     return ESP_OK;
 }
@@ -443,6 +495,10 @@ ts_u8_array_t* ps_crypto_pkcs7_unpadding(ts_u8_array_t* ps_data, uint8_t u8_bloc
     }
     // アンパディング後サイズ等を算出
     uint8_t  u8_padding   = ps_data->pu8_values[ps_data->t_size - 1];
+    if (u8_padding == 0 || u8_padding > u8_block_size) {
+        // パディングエラー
+        return NULL;
+    }
     uint32_t u32_new_size = ps_data->t_size - u8_padding;
     // パディングのチェック
     uint32_t u32_idx;
@@ -463,6 +519,225 @@ ts_u8_array_t* ps_crypto_pkcs7_unpadding(ts_u8_array_t* ps_data, uint8_t u8_bloc
     return ps_array;
 }
 
+//==============================================================================
+// 疑似乱数生成器
+//==============================================================================
+
+/*******************************************************************************
+ *
+ * NAME: i_crypto_drbg_random
+ *
+ * DESCRIPTION:疑似乱数の生成処理（mbedtlsの乱数生成関数互換）
+ *
+ * PARAMETERS:      Name            RW  Usage
+ * void*            pv_rng          R   未使用（NULLを指定）
+ * unsigned char*   puc_output      W   乱数の出力先
+ * size_t           t_len           R   生成サイズ
+ *
+ * RETURNS:
+ * int:0は正常終了、それ以外はmbedtlsのエラーコード
+ *
+ * NOTES:
+ * 自コアに常駐する疑似乱数生成器から生成する為、呼び出し毎のシードは行わない。
+ * mbedtlsのf_rng引数にそのまま指定可能。
+ ******************************************************************************/
+int i_crypto_drbg_random(void* pv_rng, unsigned char* puc_output, size_t t_len) {
+    //==========================================================================
+    // 入力チェック
+    //==========================================================================
+    if (puc_output == NULL) {
+        return MBEDTLS_ERR_CTR_DRBG_REQUEST_TOO_BIG;
+    }
+
+    //==========================================================================
+    // 疑似乱数生成器の取得
+    //==========================================================================
+    ts_crypto_drbg_context_t* ps_drbg = ps_drbg_acquire();
+    if (ps_drbg == NULL) {
+        return MBEDTLS_ERR_CTR_DRBG_ENTROPY_SOURCE_FAILED;
+    }
+
+    //==========================================================================
+    // 乱数生成（最大要求サイズ毎に分割）
+    //==========================================================================
+    int i_ret = 0;
+    size_t t_chunk;
+    while (t_len > 0) {
+        t_chunk = (t_len < MBEDTLS_CTR_DRBG_MAX_REQUEST) ? t_len : MBEDTLS_CTR_DRBG_MAX_REQUEST;
+        i_ret = mbedtls_ctr_drbg_random(&ps_drbg->s_ctr_drbg_ctx, puc_output, t_chunk);
+        if (i_ret != 0) {
+            break;
+        }
+        puc_output += t_chunk;
+        t_len -= t_chunk;
+    }
+
+    //==========================================================================
+    // 疑似乱数生成器の解放
+    //==========================================================================
+    v_drbg_release(ps_drbg);
+
+    // 結果返信
+    return i_ret;
+}
+
+/*******************************************************************************
+ *
+ * NAME: sts_crypto_random_fill
+ *
+ * DESCRIPTION:疑似乱数による一括編集処理
+ *
+ * PARAMETERS:      Name            RW  Usage
+ * uint8_t*         pu8_buff        W   編集対象
+ * size_t           t_len           R   編集サイズ
+ *
+ * RETURNS:
+ *   esp_err_t:結果ステータス
+ *
+ * NOTES:
+ * None.
+ ******************************************************************************/
+esp_err_t sts_crypto_random_fill(uint8_t* pu8_buff, size_t t_len) {
+    // 入力チェック
+    if (pu8_buff == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    // 乱数生成
+    if (i_crypto_drbg_random(NULL, pu8_buff, t_len) != 0) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    return ESP_OK;
+}
+
+/*******************************************************************************
+ *
+ * NAME: sts_crypto_random_charset
+ *
+ * DESCRIPTION:文字セットからの乱数文字列の一括編集処理
+ *
+ * PARAMETERS:      Name            RW  Usage
+ * const char*      pc_charset      R   文字セット（1～255文字）
+ * uint8_t*         pu8_buff        W   編集対象
+ * size_t           t_len           R   編集文字数
+ *
+ * RETURNS:
+ *   esp_err_t:結果ステータス
+ *
+ * NOTES:
+ * 乱数はCRYPTO_RANDOM_BLOCK_SIZE単位でまとめて生成し、文字セットの文字数の倍数未満の
+ * バイトのみを採用する（棄却サンプリング）事で剰余による偏りを排除する。
+ * 複数トークンは連続領域を一括編集し、呼び出し元で分割する事で生成要求を削減する。
+ * 終端文字は付与しない
+ ******************************************************************************/
+esp_err_t sts_crypto_random_charset(const char* pc_charset, uint8_t* pu8_buff, size_t t_len) {
+    // 入力チェック
+    if (pc_charset == NULL || pu8_buff == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    uint32_t u32_charset_len = strlen(pc_charset);
+    if (u32_charset_len == 0 || u32_charset_len > UINT8_MAX) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    // 採用するバイト値の上限（文字数の倍数）
+    uint32_t u32_limit = 256 - (256 % u32_charset_len);
+    //==========================================================================
+    // 乱数文字列編集
+    //==========================================================================
+    uint8_t u8_rand[CRYPTO_RANDOM_BLOCK_SIZE];
+    esp_err_t sts_val = ESP_OK;
+    size_t t_pos = 0;
+    size_t t_req;
+    size_t t_idx;
+    while (t_pos < t_len) {
+        // 棄却分を見込んだ生成サイズ
+        t_req = ((t_len - t_pos) * 256 + u32_limit - 1) / u32_limit + 4;
+        if (t_req > sizeof(u8_rand)) {
+            t_req = sizeof(u8_rand);
+        }
+        if (i_crypto_drbg_random(NULL, u8_rand, t_req) != 0) {
+            sts_val = ESP_ERR_INVALID_STATE;
+            break;
+        }
+        for (t_idx = 0; t_idx < t_req && t_pos < t_len; t_idx++) {
+            if (u8_rand[t_idx] < u32_limit) {
+                pu8_buff[t_pos++] = (uint8_t)pc_charset[u8_rand[t_idx] % u32_charset_len];
+            }
+        }
+    }
+    // 乱数のクリア
+    mbedtls_platform_zeroize(u8_rand, sizeof(u8_rand));
+    // 結果返信
+    return sts_val;
+}
+
+/*******************************************************************************
+ *
+ * NAME: sts_crypto_drbg_policy
+ *
+ * DESCRIPTION:疑似乱数生成器の再シードポリシーの設定処理
+ *
+ * PARAMETERS:      Name                    RW  Usage
+ * uint32_t         u32_reseed_interval     R   再シード間隔（生成要求回数）
+ * bool             b_prediction_resistance R   予測困難性（true:生成毎に再シード）
+ *
+ * RETURNS:
+ *   esp_err_t:結果ステータス
+ *
+ * NOTES:
+ * 各コアの生成器には次回の利用時に適用される
+ ******************************************************************************/
+esp_err_t sts_crypto_drbg_policy(uint32_t u32_reseed_interval, bool b_prediction_resistance) {
+    // 入力チェック
+    if (u32_reseed_interval == 0 || u32_reseed_interval > MBEDTLS_CTR_DRBG_RESEED_INTERVAL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    // 初期処理
+    v_crypto_init_t f_init = f_crypto_init;
+    f_init();
+    // ポリシーの更新
+    taskENTER_CRITICAL(&s_init_spinlock);
+    s_drbg_reseed_interval = u32_reseed_interval;
+    s_drbg_prediction_resistance = b_prediction_resistance;
+    s_drbg_policy_ver++;
+    taskEXIT_CRITICAL(&s_init_spinlock);
+    return ESP_OK;
+}
+
+/*******************************************************************************
+ *
+ * NAME: sts_crypto_drbg_reseed
+ *
+ * DESCRIPTION:疑似乱数生成器の再シード処理
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *
+ * RETURNS:
+ *   esp_err_t:結果ステータス
+ *
+ * NOTES:
+ * シード済みの全コアの生成器を即時に再シードする
+ ******************************************************************************/
+esp_err_t sts_crypto_drbg_reseed() {
+    // 初期処理
+    v_crypto_init_t f_init = f_crypto_init;
+    f_init();
+    // コア毎に再シード
+    esp_err_t sts_val = ESP_OK;
+    uint8_t u8_core_id;
+    for (u8_core_id = 0; u8_core_id < portNUM_PROCESSORS; u8_core_id++) {
+        ts_crypto_drbg_context_t* ps_drbg = &s_drbg_context[u8_core_id];
+        if (xSemaphoreTakeRecursive(ps_drbg->s_mutex, portMAX_DELAY) != pdTRUE) {
+            sts_val = ESP_ERR_TIMEOUT;
+            continue;
+        }
+        if (ps_drbg->b_seeded && mbedtls_ctr_drbg_reseed(&ps_drbg->s_ctr_drbg_ctx, NULL, 0) != 0) {
+            sts_val = ESP_ERR_INVALID_STATE;
+        }
+        xSemaphoreGiveRecursive(ps_drbg->s_mutex);
+    }
+    return sts_val;
+}
+
 //==============================================================================
 // ハッシュ関数関連処理
 //==============================================================================
@@ -556,9 +831,9 @@ esp_err_t sts_crypto_sha224(ts_u8_array_t* ps_token, uint32_t u32_stretching, ui
     // 結果ステータス
     esp_err_t sts_val = ESP_OK;
     // ハッシュ処理コンテキスト
-    mbedtls_sha256_context s_sha256_ctx;
+    ts_crypto_be_sha256_t s_sha256_ctx;
     // コンテキストの初期化
-    mbedtls_sha256_init(&s_sha256_ctx);
+    v_crypto_be_sha256_init(&s_sha256_ctx);
     // 対象トークン
     uint8_t* pu8_token = ps_token->pu8_values;
     size_t t_size = ps_token->t_size;
@@ -568,17 +843,17 @@ esp_err_t sts_crypto_sha224(ts_u8_array_t* ps_token, uint32_t u32_stretching, ui
     uint32_t u32_cnt;
     for (u32_cnt = 0; u32_cnt <= u32_stretching; u32_cnt++) {
         // 計算の開始(SHA256)
-        if (mbedtls_sha256_starts(&s_sha256_ctx, 1) != 0) {
+        if (i_crypto_be_sha256_starts(&s_sha256_ctx, true) != 0) {
             sts_val = ESP_ERR_INVALID_STATE;
             break;
         }
         // ハッシュ値の計算
-        if (mbedtls_sha256_update(&s_sha256_ctx, pu8_token, t_size) != 0) {
+        if (i_crypto_be_sha256_update(&s_sha256_ctx, pu8_token, t_size) != 0) {
             sts_val = ESP_ERR_INVALID_STATE;
             break;
         }
         // ハッシュ値の書き出し
-        if (mbedtls_sha256_finish(&s_sha256_ctx, u8_wk_hash) != 0) {
+        if (i_crypto_be_sha256_finish(&s_sha256_ctx, u8_wk_hash) != 0) {
             sts_val = ESP_ERR_INVALID_STATE;
             break;
         }
@@ -588,7 +863,7 @@ esp_err_t sts_crypto_sha224(ts_u8_array_t* ps_token, uint32_t u32_stretching, ui
     }
 
     // コンテキストの解放
-    mbedtls_sha256_free(&s_sha256_ctx);
+    v_crypto_be_sha256_free(&s_sha256_ctx);
 
     // 結果判定
     if (sts_val == ESP_OK) {
@@ -622,9 +897,9 @@ esp_err_t sts_crypto_sha256(ts_u8_array_t* ps_token, uint32_t u32_stretching, ui
     // 結果ステータス
     esp_err_t sts_val = ESP_OK;
     // ハッシュ処理コンテキスト
-    mbedtls_sha256_context s_sha256_ctx;
+    ts_crypto_be_sha256_t s_sha256_ctx;
     // コンテキストの初期化
-    mbedtls_sha256_init(&s_sha256_ctx);
+    v_crypto_be_sha256_init(&s_sha256_ctx);
     // 対象トークン
     uint8_t* pu8_token = ps_token->pu8_values;
     size_t t_size = ps_token->t_size;
@@ -634,17 +909,17 @@ esp_err_t sts_crypto_sha256(ts_u8_array_t* ps_token, uint32_t u32_stretching, ui
     uint32_t u32_cnt;
     for (u32_cnt = 0; u32_cnt <= u32_stretching; u32_cnt++) {
         // 計算の開始(SHA256)
-        if (mbedtls_sha256_starts(&s_sha256_ctx, 0) != 0) {
+        if (i_crypto_be_sha256_starts(&s_sha256_ctx, false) != 0) {
             sts_val = ESP_ERR_INVALID_STATE;
             break;
         }
         // ハッシュ値の計算
-        if (mbedtls_sha256_update(&s_sha256_ctx, pu8_token, t_size) != 0) {
+        if (i_crypto_be_sha256_update(&s_sha256_ctx, pu8_token, t_size) != 0) {
             sts_val = ESP_ERR_INVALID_STATE;
             break;
         }
         // ハッシュ値の書き出し
-        if (mbedtls_sha256_finish(&s_sha256_ctx, u8_wk_hash) != 0) {
+        if (i_crypto_be_sha256_finish(&s_sha256_ctx, u8_wk_hash) != 0) {
             sts_val = ESP_ERR_INVALID_STATE;
             break;
         }
@@ -654,7 +929,7 @@ esp_err_t sts_crypto_sha256(ts_u8_array_t* ps_token, uint32_t u32_stretching, ui
     }
 
     // コンテキストの解放
-    mbedtls_sha256_free(&s_sha256_ctx);
+    v_crypto_be_sha256_free(&s_sha256_ctx);
 
     // 結果判定
     if (sts_val == ESP_OK) {
@@ -797,6 +1072,202 @@ esp_err_t sts_crypto_sha512(ts_u8_array_t* ps_token, uint32_t u32_stretching, ui
     return sts_val;
 }
 
+/*******************************************************************************
+ *
+ * NAME: u32_crypto_hash_size
+ *
+ * DESCRIPTION:ハッシュ値のサイズ
+ *
+ * PARAMETERS:              Name        RW  Usage
+ * te_crypto_hash_type_t    e_type      R   ハッシュアルゴリズム
+ *
+ * RETURNS:
+ *   uint32_t:ハッシュ値のサイズ（不正なアルゴリズムの場合は０）
+ *
+ ******************************************************************************/
+uint32_t u32_crypto_hash_size(te_crypto_hash_type_t e_type) {
+    switch (e_type) {
+    case CRYPTO_HASH_SHA224:
+        return CRYPTO_SHA224_SIZE;
+    case CRYPTO_HASH_SHA256:
+        return CRYPTO_SHA256_SIZE;
+    case CRYPTO_HASH_SHA384:
+        return CRYPTO_SHA384_SIZE;
+    case CRYPTO_HASH_SHA512:
+        return CRYPTO_SHA512_SIZE;
+    default:
+        return 0;
+    }
+}
+
+/*******************************************************************************
+ *
+ * NAME: sts_crypto_hash_init
+ *
+ * DESCRIPTION:ハッシュコンテキストの初期化（逐次処理の開始）
+ *
+ * PARAMETERS:                  Name        RW  Usage
+ * ts_crypto_hash_context_t*    ps_ctx      W   ハッシュコンテキスト
+ * te_crypto_hash_type_t        e_type      R   ハッシュアルゴリズム
+ *
+ * RETURNS:
+ *   esp_err_t:結果ステータス
+ *
+ * NOTES:
+ * 利用後はv_crypto_hash_freeで解放する事
+ ******************************************************************************/
+esp_err_t sts_crypto_hash_init(ts_crypto_hash_context_t* ps_ctx, te_crypto_hash_type_t e_type) {
+    // 入力チェック
+    if (ps_ctx == NULL || u32_crypto_hash_size(e_type) == 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    // コンテキストの初期化
+    ps_ctx->e_type = e_type;
+    if (b_hash_is_sha512(e_type)) {
+        mbedtls_sha512_init(&ps_ctx->u_ctx.s_sha512);
+    } else {
+        v_crypto_be_sha256_init(&ps_ctx->u_ctx.s_sha256);
+    }
+    // 計算の開始
+    esp_err_t sts_val = sts_crypto_hash_reset(ps_ctx);
+    if (sts_val != ESP_OK) {
+        v_crypto_hash_free(ps_ctx);
+    }
+    // 結果返信
+    return sts_val;
+}
+
+/*******************************************************************************
+ *
+ * NAME: sts_crypto_hash_reset
+ *
+ * DESCRIPTION:ハッシュコンテキストのリセット
+ *
+ * PARAMETERS:                  Name        RW  Usage
+ * ts_crypto_hash_context_t*    ps_ctx      RW  ハッシュコンテキスト
+ *
+ * RETURNS:
+ *   esp_err_t:結果ステータス
+ *
+ ******************************************************************************/
+esp_err_t sts_crypto_hash_reset(ts_crypto_hash_context_t* ps_ctx) {
+    // 入力チェック
+    if (ps_ctx == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    // 計算の開始
+    int i_ret;
+    switch (ps_ctx->e_type) {
+    case CRYPTO_HASH_SHA224:
+        i_ret = i_crypto_be_sha256_starts(&ps_ctx->u_ctx.s_sha256, true);
+        break;
+    case CRYPTO_HASH_SHA256:
+        i_ret = i_crypto_be_sha256_starts(&ps_ctx->u_ctx.s_sha256, false);
+        break;
+    case CRYPTO_HASH_SHA384:
+        i_ret = mbedtls_sha512_starts(&ps_ctx->u_ctx.s_sha512, 1);
+        break;
+    case CRYPTO_HASH_SHA512:
+        i_ret = mbedtls_sha512_starts(&ps_ctx->u_ctx.s_sha512, 0);
+        break;
+    default:
+        return ESP_ERR_INVALID_ARG;
+    }
+    // 結果返信
+    return (i_ret == 0) ? ESP_OK : ESP_ERR_INVALID_STATE;
+}
+
+/*******************************************************************************
+ *
+ * NAME: sts_crypto_hash_update
+ *
+ * DESCRIPTION:ハッシュ値の逐次計算
+ *
+ * PARAMETERS:                  Name        RW  Usage
+ * ts_crypto_hash_context_t*    ps_ctx      RW  ハッシュコンテキスト
+ * const uint8_t*               pu8_data    R   対象データ
+ * size_t                       t_len       R   対象データサイズ
+ *
+ * RETURNS:
+ *   esp_err_t:結果ステータス
+ *
+ ******************************************************************************/
+esp_err_t sts_crypto_hash_update(ts_crypto_hash_context_t* ps_ctx, const uint8_t* pu8_data, size_t t_len) {
+    // 入力チェック
+    if (ps_ctx == NULL || (pu8_data == NULL && t_len > 0)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    // ハッシュ値の計算
+    int i_ret;
+    if (b_hash_is_sha512(ps_ctx->e_type)) {
+        i_ret = mbedtls_sha512_update(&ps_ctx->u_ctx.s_sha512, pu8_data, t_len);
+    } else {
+        i_ret = i_crypto_be_sha256_update(&ps_ctx->u_ctx.s_sha256, pu8_data, t_len);
+    }
+    // 結果返信
+    return (i_ret == 0) ? ESP_OK : ESP_ERR_INVALID_STATE;
+}
+
+/*******************************************************************************
+ *
+ * NAME: sts_crypto_hash_finish
+ *
+ * DESCRIPTION:ハッシュ値の書き出し
+ *
+ * PARAMETERS:                  Name        RW  Usage
+ * ts_crypto_hash_context_t*    ps_ctx      RW  ハッシュコンテキスト
+ * uint8_t*                     pu8_hash    W   ハッシュ値（u32_crypto_hash_sizeのサイズ）
+ *
+ * RETURNS:
+ *   esp_err_t:結果ステータス
+ *
+ * NOTES:
+ * 書き出し後はリセット状態となり、そのまま次の計算に再利用可能
+ ******************************************************************************/
+esp_err_t sts_crypto_hash_finish(ts_crypto_hash_context_t* ps_ctx, uint8_t* pu8_hash) {
+    // 入力チェック
+    if (ps_ctx == NULL || pu8_hash == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    // ハッシュ値の書き出し
+    int i_ret;
+    if (b_hash_is_sha512(ps_ctx->e_type)) {
+        i_ret = mbedtls_sha512_finish(&ps_ctx->u_ctx.s_sha512, pu8_hash);
+    } else {
+        i_ret = i_crypto_be_sha256_finish(&ps_ctx->u_ctx.s_sha256, pu8_hash);
+    }
+    if (i_ret != 0) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    // 次の計算の開始
+    return sts_crypto_hash_reset(ps_ctx);
+}
+
+/*******************************************************************************
+ *
+ * NAME: v_crypto_hash_free
+ *
+ * DESCRIPTION:ハッシュコンテキストの解放
+ *
+ * PARAMETERS:                  Name        RW  Usage
+ * ts_crypto_hash_context_t*    ps_ctx      RW  ハッシュコンテキスト
+ *
+ * RETURNS:
+ *
+ ******************************************************************************/
+void v_crypto_hash_free(ts_crypto_hash_context_t* ps_ctx) {
+    // 入力チェック
+    if (ps_ctx == NULL) {
+        return;
+    }
+    // コンテキストの解放
+    if (b_hash_is_sha512(ps_ctx->e_type)) {
+        mbedtls_sha512_free(&ps_ctx->u_ctx.s_sha512);
+    } else {
+        v_crypto_be_sha256_free(&ps_ctx->u_ctx.s_sha256);
+    }
+}
+
 //==============================================================================
 // メッセージ認証符号
 //==============================================================================
@@ -947,39 +1418,307 @@ esp_err_t sts_crypto_hmac(mbedtls_md_type_t e_type,
     return sts_val;
 }
 
-//==============================================================================
-// 共通鍵暗号
-//==============================================================================
-
 /*******************************************************************************
  *
- * NAME: ps_crypto_aes_ecb_enc
+ * NAME: sts_crypto_hmac_init
  *
- * DESCRIPTION:暗号化処理(AES)
+ * DESCRIPTION:HMACコンテキストの初期化
  *
- * PARAMETERS:          Name        RW  Usage
- * ts_u8_array_t*       ps_key      R   共通鍵
- * const ts_u8_array_t* ps_plane    R   平文
+ * PARAMETERS:                  Name        RW  Usage
+ * ts_crypto_hmac_context_t*    ps_ctx      W   HMACコンテキスト
+ * te_crypto_hash_type_t        e_type      R   ハッシュアルゴリズム
+ * const uint8_t*               pu8_key     R   キー
+ * size_t                       t_key_len   R   キーサイズ
  *
  * RETURNS:
- *   ts_u8_array_t*:暗号文
+ *   esp_err_t:結果ステータス
  *
+ * NOTES:
+ * キーにipad/opadを適用したハッシュ状態を事前計算して保持する為、
+ * 同一キーでの計算はsts_crypto_hmac_resetから開始できる。
+ * 保持する状態は複製であり、SHAのハードウェアエンジンは占有しない。
+ * 利用後はv_crypto_hmac_freeで解放する事。
  ******************************************************************************/
-ts_u8_array_t* ps_crypto_aes_ecb_enc(const ts_u8_array_t* ps_key, const ts_u8_array_t* ps_plane) {
+esp_err_t sts_crypto_hmac_init(ts_crypto_hmac_context_t* ps_ctx, te_crypto_hash_type_t e_type,
+                               const uint8_t* pu8_key, size_t t_key_len) {
     //==========================================================================
     // 入力チェック
     //==========================================================================
-    // 鍵情報
-    if (ps_key == NULL || ps_plane == NULL) {
-        return NULL;
+    if (ps_ctx == NULL || (pu8_key == NULL && t_key_len > 0) || u32_crypto_hash_size(e_type) == 0) {
+        return ESP_ERR_INVALID_ARG;
     }
-    // データサイズチェック
-    if ((ps_plane->t_size % AES_BLOCK_BYTES) != 0) {
-        return NULL;
+
+    //==========================================================================
+    // コンテキストの初期化
+    //==========================================================================
+    esp_err_t sts_val = sts_crypto_hash_init(&ps_ctx->s_inner, e_type);
+    if (sts_val != ESP_OK) {
+        return sts_val;
+    }
+    sts_val = sts_crypto_hash_init(&ps_ctx->s_ipad, e_type);
+    if (sts_val != ESP_OK) {
+        v_crypto_hash_free(&ps_ctx->s_inner);
+        return sts_val;
+    }
+    sts_val = sts_crypto_hash_init(&ps_ctx->s_opad, e_type);
+    if (sts_val != ESP_OK) {
+        v_crypto_hash_free(&ps_ctx->s_inner);
+        v_crypto_hash_free(&ps_ctx->s_ipad);
+        return sts_val;
     }
 
     //==========================================================================
-    // 暗号化
+    // ipad/opadの事前計算
+    //==========================================================================
+    uint32_t u32_block_size = u32_hash_block_size(e_type);
+    uint8_t u8_key_block[CRYPTO_HASH_MAX_BLOCK_SIZE];
+    uint8_t u8_pad[CRYPTO_HASH_MAX_BLOCK_SIZE];
+    memset(u8_key_block, 0x00, sizeof(u8_key_block));
+    do {
+        //----------------------------------------------------------------------
+        // キーブロックの編集（ブロックサイズを超えるキーはハッシュ値を利用）
+        //----------------------------------------------------------------------
+        if (t_key_len > u32_block_size) {
+            sts_val = sts_crypto_hash_update(&ps_ctx->s_inner, pu8_key, t_key_len);
+            if (sts_val != ESP_OK) {
+                break;
+            }
+            sts_val = sts_crypto_hash_finish(&ps_ctx->s_inner, u8_key_block);
+            if (sts_val != ESP_OK) {
+                break;
+            }
+        } else if (t_key_len > 0) {
+            memcpy(u8_key_block, pu8_key, t_key_len);
+        }
+
+        //----------------------------------------------------------------------
+        // 内側と外側のハッシュ状態を生成
+        //----------------------------------------------------------------------
+        uint32_t u32_idx;
+        for (u32_idx = 0; u32_idx < u32_block_size; u32_idx++) {
+            u8_pad[u32_idx] = u8_key_block[u32_idx] ^ 0x36;
+        }
+        sts_val = sts_hmac_pad_state(&ps_ctx->s_ipad, u8_pad, u32_block_size);
+        if (sts_val != ESP_OK) {
+            break;
+        }
+        for (u32_idx = 0; u32_idx < u32_block_size; u32_idx++) {
+            u8_pad[u32_idx] = u8_key_block[u32_idx] ^ 0x5C;
+        }
+        sts_val = sts_hmac_pad_state(&ps_ctx->s_opad, u8_pad, u32_block_size);
+        if (sts_val != ESP_OK) {
+            break;
+        }
+
+        //----------------------------------------------------------------------
+        // 内側ハッシュの開始
+        //----------------------------------------------------------------------
+        v_hash_clone(&ps_ctx->s_inner, &ps_ctx->s_ipad);
+    } while(false);
+
+    // キー情報のクリア
+    mbedtls_platform_zeroize(u8_key_block, sizeof(u8_key_block));
+    mbedtls_platform_zeroize(u8_pad, sizeof(u8_pad));
+    // エラー時はコンテキストを解放
+    if (sts_val != ESP_OK) {
+        v_crypto_hmac_free(ps_ctx);
+    }
+
+    // 結果返信
+    return sts_val;
+}
+
+/*******************************************************************************
+ *
+ * NAME: sts_crypto_hmac_reset
+ *
+ * DESCRIPTION:HMACコンテキストのリセット
+ *
+ * PARAMETERS:                  Name        RW  Usage
+ * ts_crypto_hmac_context_t*    ps_ctx      RW  HMACコンテキスト
+ *
+ * RETURNS:
+ *   esp_err_t:結果ステータス
+ *
+ * NOTES:
+ * 事前計算したipad適用済みの状態から再開する
+ ******************************************************************************/
+esp_err_t sts_crypto_hmac_reset(ts_crypto_hmac_context_t* ps_ctx) {
+    // 入力チェック
+    if (ps_ctx == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    v_hash_clone(&ps_ctx->s_inner, &ps_ctx->s_ipad);
+    return ESP_OK;
+}
+
+/*******************************************************************************
+ *
+ * NAME: sts_crypto_hmac_clone
+ *
+ * DESCRIPTION:HMACコンテキストの複製
+ *
+ * PARAMETERS:                      Name        RW  Usage
+ * ts_crypto_hmac_context_t*        ps_dst      W   複製先（未初期化）
+ * const ts_crypto_hmac_context_t*  ps_src      R   複製元（初期化済み）
+ *
+ * RETURNS:
+ *   esp_err_t:結果ステータス
+ *
+ * NOTES:
+ * 計算途中の状態も含めて複製する。複製先はv_crypto_hmac_freeで解放する事
+ ******************************************************************************/
+esp_err_t sts_crypto_hmac_clone(ts_crypto_hmac_context_t* ps_dst, const ts_crypto_hmac_context_t* ps_src) {
+    // 入力チェック
+    if (ps_dst == NULL || ps_src == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    te_crypto_hash_type_t e_type = ps_src->s_ipad.e_type;
+    esp_err_t sts_val = sts_crypto_hash_init(&ps_dst->s_inner, e_type);
+    if (sts_val != ESP_OK) {
+        return sts_val;
+    }
+    sts_val = sts_crypto_hash_init(&ps_dst->s_ipad, e_type);
+    if (sts_val != ESP_OK) {
+        v_crypto_hash_free(&ps_dst->s_inner);
+        return sts_val;
+    }
+    sts_val = sts_crypto_hash_init(&ps_dst->s_opad, e_type);
+    if (sts_val != ESP_OK) {
+        v_crypto_hash_free(&ps_dst->s_inner);
+        v_crypto_hash_free(&ps_dst->s_ipad);
+        return sts_val;
+    }
+    v_hash_clone(&ps_dst->s_inner, &ps_src->s_inner);
+    v_hash_clone(&ps_dst->s_ipad, &ps_src->s_ipad);
+    v_hash_clone(&ps_dst->s_opad, &ps_src->s_opad);
+    // 結果返信
+    return ESP_OK;
+}
+
+/*******************************************************************************
+ *
+ * NAME: sts_crypto_hmac_update
+ *
+ * DESCRIPTION:HMACの逐次計算
+ *
+ * PARAMETERS:                  Name        RW  Usage
+ * ts_crypto_hmac_context_t*    ps_ctx      RW  HMACコンテキスト
+ * const uint8_t*               pu8_data    R   対象データ
+ * size_t                       t_len       R   対象データサイズ
+ *
+ * RETURNS:
+ *   esp_err_t:結果ステータス
+ *
+ ******************************************************************************/
+esp_err_t sts_crypto_hmac_update(ts_crypto_hmac_context_t* ps_ctx, const uint8_t* pu8_data, size_t t_len) {
+    // 入力チェック
+    if (ps_ctx == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    return sts_crypto_hash_update(&ps_ctx->s_inner, pu8_data, t_len);
+}
+
+/*******************************************************************************
+ *
+ * NAME: sts_crypto_hmac_finish
+ *
+ * DESCRIPTION:HMACの書き出し
+ *
+ * PARAMETERS:                  Name        RW  Usage
+ * ts_crypto_hmac_context_t*    ps_ctx      RW  HMACコンテキスト
+ * uint8_t*                     pu8_digest  W   メッセージダイジェスト（u32_crypto_hash_sizeのサイズ）
+ *
+ * RETURNS:
+ *   esp_err_t:結果ステータス
+ *
+ * NOTES:
+ * 書き出し後はリセット状態となり、同一キーでそのまま再利用可能
+ ******************************************************************************/
+esp_err_t sts_crypto_hmac_finish(ts_crypto_hmac_context_t* ps_ctx, uint8_t* pu8_digest) {
+    // 入力チェック
+    if (ps_ctx == NULL || pu8_digest == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    // 内側ハッシュの書き出し
+    uint8_t u8_inner[CRYPTO_HASH_MAX_SIZE];
+    esp_err_t sts_val = sts_crypto_hash_finish(&ps_ctx->s_inner, u8_inner);
+    if (sts_val != ESP_OK) {
+        return sts_val;
+    }
+    // 外側ハッシュの計算（opad適用済みの状態から）
+    ts_crypto_hash_context_t s_outer;
+    sts_val = sts_crypto_hash_init(&s_outer, ps_ctx->s_opad.e_type);
+    if (sts_val == ESP_OK) {
+        v_hash_clone(&s_outer, &ps_ctx->s_opad);
+        sts_val = sts_crypto_hash_update(&s_outer, u8_inner, u32_crypto_hash_size(s_outer.e_type));
+        if (sts_val == ESP_OK) {
+            sts_val = sts_crypto_hash_finish(&s_outer, pu8_digest);
+        }
+        v_crypto_hash_free(&s_outer);
+    }
+    mbedtls_platform_zeroize(u8_inner, sizeof(u8_inner));
+    // 内側ハッシュのリセット
+    v_hash_clone(&ps_ctx->s_inner, &ps_ctx->s_ipad);
+    // 結果返信
+    return sts_val;
+}
+
+/*******************************************************************************
+ *
+ * NAME: v_crypto_hmac_free
+ *
+ * DESCRIPTION:HMACコンテキストの解放
+ *
+ * PARAMETERS:                  Name        RW  Usage
+ * ts_crypto_hmac_context_t*    ps_ctx      RW  HMACコンテキスト
+ *
+ * RETURNS:
+ *
+ ******************************************************************************/
+void v_crypto_hmac_free(ts_crypto_hmac_context_t* ps_ctx) {
+    // 入力チェック
+    if (ps_ctx == NULL) {
+        return;
+    }
+    v_crypto_hash_free(&ps_ctx->s_inner);
+    v_crypto_hash_free(&ps_ctx->s_ipad);
+    v_crypto_hash_free(&ps_ctx->s_opad);
+}
+
+//==============================================================================
+// 共通鍵暗号
+//==============================================================================
+
+/*******************************************************************************
+ *
+ * NAME: ps_crypto_aes_ecb_enc
+ *
+ * DESCRIPTION:暗号化処理(AES)
+ *
+ * PARAMETERS:          Name        RW  Usage
+ * ts_u8_array_t*       ps_key      R   共通鍵
+ * const ts_u8_array_t* ps_plane    R   平文
+ *
+ * RETURNS:
+ *   ts_u8_array_t*:暗号文
+ *
+ ******************************************************************************/
+ts_u8_array_t* ps_crypto_aes_ecb_enc(const ts_u8_array_t* ps_key, const ts_u8_array_t* ps_plane) {
+    //==========================================================================
+    // 入力チェック
+    //==========================================================================
+    // 鍵情報
+    if (ps_key == NULL || ps_plane == NULL) {
+        return NULL;
+    }
+    // データサイズチェック
+    if ((ps_plane->t_size % AES_BLOCK_BYTES) != 0) {
+        return NULL;
+    }
+
+    //==========================================================================
+    // 暗号化
     //==========================================================================
     // 暗号データの編集先を生成
     ts_u8_array_t* ps_cipher = NULL;
@@ -1594,149 +2333,569 @@ ts_u8_array_t* ps_crypto_aes_gcm_dec(const ts_crypto_keyset_t* ps_keyset,
 }
 
 
-//==============================================================================
-// ECDH関連処理
-//==============================================================================
-
 /*******************************************************************************
  *
- * NAME: ps_crypto_x25519_client_context
+ * NAME: sts_crypto_aes_gcm_enc_in_place
  *
- * DESCRIPTION:ECDHコンテキストの生成処理
+ * DESCRIPTION:暗号化処理(AES GCMモード、インプレース)
  *
  * PARAMETERS:      Name            RW  Usage
+ * const uint8_t*   pu8_key         R   共通鍵
+ * size_t           t_key_len       R   共通鍵サイズ
+ * const uint8_t*   pu8_iv          R   初期ベクトル
+ * size_t           t_iv_len        R   初期ベクトルサイズ
+ * const uint8_t*   pu8_add         R   追加認証データ（NULL可）
+ * size_t           t_add_len       R   追加認証データサイズ
+ * uint8_t*         pu8_data        RW  平文（暗号文で上書き）
+ * size_t           t_data_len      R   平文サイズ
+ * uint8_t*         pu8_tag         W   認証タグ
+ * size_t           t_tag_len       R   認証タグサイズ
  *
  * RETURNS:
- *   ts_crypto_ecdh_context_t*:ECDHコンテキスト
+ *   esp_err_t:結果ステータス
  *
+ * NOTES:
+ * 呼び出し元のバッファを直接暗号化する為、ヒープ領域を確保しない
  ******************************************************************************/
-ts_crypto_x25519_context_t* ps_crypto_x25519_client_context() {
-    //==========================================================================
-    // 初期処理
-    //==========================================================================
-    v_crypto_init_t f_init = f_crypto_init;
-    f_init();
-
+esp_err_t sts_crypto_aes_gcm_enc_in_place(const uint8_t* pu8_key, size_t t_key_len,
+                                          const uint8_t* pu8_iv, size_t t_iv_len,
+                                          const uint8_t* pu8_add, size_t t_add_len,
+                                          uint8_t* pu8_data, size_t t_data_len,
+                                          uint8_t* pu8_tag, size_t t_tag_len) {
     //==========================================================================
-    // クリティカルセクション開始
+    // 入力チェック
     //==========================================================================
-    if (xSemaphoreTakeRecursive(s_mutex, portMAX_DELAY) != pdTRUE) {
-        return NULL;
+    if (pu8_key == NULL || pu8_iv == NULL || t_iv_len == 0 || pu8_tag == NULL) {
+        return ESP_ERR_INVALID_ARG;
     }
-
-    //==========================================================================
-    // 乱数生成器のトランザクション開始
-    //==========================================================================
-    if (sts_drbg_transaction_start() != ESP_OK) {
-        // クリティカルセクション終了
-        xSemaphoreGiveRecursive(s_mutex);
-        return NULL;
+    if (t_key_len != AES_128_KEY_BYTES &&
+        t_key_len != AES_192_KEY_BYTES &&
+        t_key_len != AES_256_KEY_BYTES) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if ((pu8_add == NULL && t_add_len > 0) || (pu8_data == NULL && t_data_len > 0)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (t_tag_len < 4 || t_tag_len > 16) {
+        return ESP_ERR_INVALID_ARG;
     }
 
     //==========================================================================
-    // ECDHコンテキストの生成
+    // 暗号化処理
     //==========================================================================
-    ts_crypto_x25519_context_t* ps_ctx = NULL;
-    do {
-        //----------------------------------------------------------------------
-        // X25519コンテキストの生成
-        //----------------------------------------------------------------------
-        // X25519コンテキストの確保
-        ps_ctx = pv_mem_calloc(sizeof(ts_crypto_x25519_context_t));
-        if (ps_ctx == NULL) {
-            break;
-        }
-        // プロパティ初期化
-        memset(ps_ctx->u8_svr_public_key, 0x00, CRYPTO_X25519_SERVER_PUBLIC_KEY_SIZE);
-        memset(ps_ctx->u8_key, 0x00, CRYPTO_X25519_KEY_SIZE);
-
-        //----------------------------------------------------------------------
-        // X25519コンテキストの初期化
-        //----------------------------------------------------------------------
-        // X25519コンテキストを初期化
-        mbedtls_ecdh_init(&ps_ctx->s_ecdh_ctx);
-        // X25519コンテキストに暗号方式を設定
-        int i_ret = mbedtls_ecdh_setup(&ps_ctx->s_ecdh_ctx, MBEDTLS_ECP_DP_CURVE25519);
-        if (i_ret != 0) {
-            // コンテキストを解放
-            v_crypto_x25519_delete_context(ps_ctx);
-            ps_ctx = NULL;
-            break;
-        }
+    ts_crypto_gcm_context_t s_gcm_ctx;
+    esp_err_t sts_val = sts_crypto_gcm_init(&s_gcm_ctx, pu8_key, t_key_len);
+    if (sts_val == ESP_OK) {
+        sts_val = sts_crypto_gcm_enc_in_place(&s_gcm_ctx, pu8_iv, t_iv_len, pu8_add, t_add_len,
+                                              pu8_data, t_data_len, pu8_tag, t_tag_len);
+    }
+    v_crypto_gcm_free(&s_gcm_ctx);
 
-        //----------------------------------------------------------------------
-        // X25519公開鍵を生成
-        //----------------------------------------------------------------------
-        // 公開鍵の生成
-        size_t t_out_len;
-        i_ret = mbedtls_ecdh_make_params(&ps_ctx->s_ecdh_ctx, &t_out_len,
-                                         ps_ctx->u8_cli_public_key,
-                                         CRYPTO_CURVE25519_CLIENT_PUBLIC_KEY_LEN,
-                                         mbedtls_ctr_drbg_random,
-                                         &s_drbg_context.s_ctr_drbg_ctx);
-        if (i_ret != 0 || t_out_len != CRYPTO_CURVE25519_CLIENT_PUBLIC_KEY_LEN) {
-            // コンテキストを解放
-            v_crypto_x25519_delete_context(ps_ctx);
-            ps_ctx = NULL;
-            break;
-        }
-    } while(false);
+    // 結果返信
+    return sts_val;
+}
 
+/*******************************************************************************
+ *
+ * NAME: sts_crypto_aes_gcm_dec_in_place
+ *
+ * DESCRIPTION:復号処理(AES GCMモード、インプレース)
+ *
+ * PARAMETERS:      Name            RW  Usage
+ * const uint8_t*   pu8_key         R   共通鍵
+ * size_t           t_key_len       R   共通鍵サイズ
+ * const uint8_t*   pu8_iv          R   初期ベクトル
+ * size_t           t_iv_len        R   初期ベクトルサイズ
+ * const uint8_t*   pu8_add         R   追加認証データ（NULL可）
+ * size_t           t_add_len       R   追加認証データサイズ
+ * uint8_t*         pu8_data        RW  暗号文（平文で上書き）
+ * size_t           t_data_len      R   暗号文サイズ
+ * const uint8_t*   pu8_tag         R   認証タグ
+ * size_t           t_tag_len       R   認証タグサイズ
+ *
+ * RETURNS:
+ *   esp_err_t:結果ステータス、認証タグの不一致はESP_ERR_INVALID_RESPONSE
+ *
+ * NOTES:
+ * 認証タグは定数時間で検証し、不一致の場合はバッファをゼロクリアする
+ ******************************************************************************/
+esp_err_t sts_crypto_aes_gcm_dec_in_place(const uint8_t* pu8_key, size_t t_key_len,
+                                          const uint8_t* pu8_iv, size_t t_iv_len,
+                                          const uint8_t* pu8_add, size_t t_add_len,
+                                          uint8_t* pu8_data, size_t t_data_len,
+                                          const uint8_t* pu8_tag, size_t t_tag_len) {
     //==========================================================================
-    // 乱数生成器のトランザクション終了
+    // 入力チェック
     //==========================================================================
-    v_drbg_transaction_end();
+    if (pu8_key == NULL || pu8_iv == NULL || t_iv_len == 0 || pu8_tag == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (t_key_len != AES_128_KEY_BYTES &&
+        t_key_len != AES_192_KEY_BYTES &&
+        t_key_len != AES_256_KEY_BYTES) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if ((pu8_add == NULL && t_add_len > 0) || (pu8_data == NULL && t_data_len > 0)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (t_tag_len < 4 || t_tag_len > 16) {
+        return ESP_ERR_INVALID_ARG;
+    }
 
     //==========================================================================
-    // クリティカルセクション終了
+    // 復号処理
     //==========================================================================
-    xSemaphoreGiveRecursive(s_mutex);
+    ts_crypto_gcm_context_t s_gcm_ctx;
+    esp_err_t sts_val = sts_crypto_gcm_init(&s_gcm_ctx, pu8_key, t_key_len);
+    if (sts_val == ESP_OK) {
+        sts_val = sts_crypto_gcm_dec_in_place(&s_gcm_ctx, pu8_iv, t_iv_len, pu8_add, t_add_len,
+                                              pu8_data, t_data_len, pu8_tag, t_tag_len);
+    }
+    v_crypto_gcm_free(&s_gcm_ctx);
 
     // 結果返信
-    return ps_ctx;
+    return sts_val;
 }
 
 /*******************************************************************************
  *
- * NAME: ps_crypto_x25519_server_context
+ * NAME: sts_crypto_gcm_init
  *
- * DESCRIPTION:ECDHコンテキストの生成処理（サーバー側）
+ * DESCRIPTION:AES GCMコンテキストの初期化
  *
- * PARAMETERS:      Name                RW  Usage
- * uint8_t*         pu8_client_pub_key  R   受信した公開鍵
+ * PARAMETERS:              Name            RW  Usage
+ * ts_crypto_gcm_context_t* ps_ctx          W   GCMコンテキスト
+ * const uint8_t*           pu8_key         R   共通鍵
+ * size_t                   t_key_len       R   共通鍵サイズ
  *
  * RETURNS:
- *   ts_crypto_ecdh_context_t*:ECDHコンテキスト
+ *   esp_err_t:結果ステータス
  *
+ * NOTES:
+ * 鍵スケジュールを一度だけ展開し、以降の暗号化・復号で再利用する
+ * 失敗した場合でもv_crypto_gcm_freeの呼び出しは可能
  ******************************************************************************/
-ts_crypto_x25519_context_t* ps_crypto_x25519_server_context(uint8_t* pu8_client_pub_key) {
-    //==========================================================================
-    // 初期処理
-    //==========================================================================
-    v_crypto_init_t f_init = f_crypto_init;
-    f_init();
-
+esp_err_t sts_crypto_gcm_init(ts_crypto_gcm_context_t* ps_ctx, const uint8_t* pu8_key, size_t t_key_len) {
     //==========================================================================
     // 入力チェック
     //==========================================================================
-    if (pu8_client_pub_key == NULL) {
-        return NULL;
+    if (ps_ctx == NULL) {
+        return ESP_ERR_INVALID_ARG;
     }
-
-    //==========================================================================
-    // クリティカルセクション開始
-    //==========================================================================
-    if (xSemaphoreTakeRecursive(s_mutex, portMAX_DELAY) != pdTRUE) {
-        return NULL;
+    mbedtls_gcm_init(&ps_ctx->s_gcm_ctx);
+    ps_ctx->b_ready = false;
+    if (pu8_key == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (t_key_len != AES_128_KEY_BYTES &&
+        t_key_len != AES_192_KEY_BYTES &&
+        t_key_len != AES_256_KEY_BYTES) {
+        return ESP_ERR_INVALID_ARG;
     }
 
     //==========================================================================
-    // 乱数生成器のトランザクション開始
+    // 鍵スケジュール展開
     //==========================================================================
-    if (sts_drbg_transaction_start() != ESP_OK) {
-        // クリティカルセクション終了
-        xSemaphoreGiveRecursive(s_mutex);
-        return NULL;
+    if (mbedtls_gcm_setkey(&ps_ctx->s_gcm_ctx, MBEDTLS_CIPHER_ID_AES, pu8_key, t_key_len * 8) != 0) {
+        return ESP_FAIL;
+    }
+    ps_ctx->b_ready = true;
+    // 正常終了
+    return ESP_OK;
+}
+
+/*******************************************************************************
+ *
+ * NAME: v_crypto_gcm_free
+ *
+ * DESCRIPTION:AES GCMコンテキストの解放
+ *
+ * PARAMETERS:              Name            RW  Usage
+ * ts_crypto_gcm_context_t* ps_ctx          RW  GCMコンテキスト
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * 展開済みの鍵スケジュールはゼロクリアされる
+ ******************************************************************************/
+void v_crypto_gcm_free(ts_crypto_gcm_context_t* ps_ctx) {
+    if (ps_ctx == NULL) {
+        return;
+    }
+    mbedtls_gcm_free(&ps_ctx->s_gcm_ctx);
+    ps_ctx->b_ready = false;
+}
+
+/*******************************************************************************
+ *
+ * NAME: sts_crypto_gcm_enc_in_place
+ *
+ * DESCRIPTION:暗号化処理(AES GCMコンテキスト、インプレース)
+ *
+ * PARAMETERS:              Name            RW  Usage
+ * ts_crypto_gcm_context_t* ps_ctx          RW  GCMコンテキスト
+ * const uint8_t*           pu8_iv          R   初期ベクトル
+ * size_t                   t_iv_len        R   初期ベクトルサイズ
+ * const uint8_t*           pu8_add         R   追加認証データ（NULL可）
+ * size_t                   t_add_len       R   追加認証データサイズ
+ * uint8_t*                 pu8_data        RW  平文（暗号文で上書き）
+ * size_t                   t_data_len      R   平文サイズ
+ * uint8_t*                 pu8_tag         W   認証タグ
+ * size_t                   t_tag_len       R   認証タグサイズ
+ *
+ * RETURNS:
+ *   esp_err_t:結果ステータス
+ *
+ * NOTES:
+ * 鍵スケジュールの展開とヒープ領域の確保を行わない
+ ******************************************************************************/
+esp_err_t sts_crypto_gcm_enc_in_place(ts_crypto_gcm_context_t* ps_ctx,
+                                      const uint8_t* pu8_iv, size_t t_iv_len,
+                                      const uint8_t* pu8_add, size_t t_add_len,
+                                      uint8_t* pu8_data, size_t t_data_len,
+                                      uint8_t* pu8_tag, size_t t_tag_len) {
+    //==========================================================================
+    // 入力チェック
+    //==========================================================================
+    if (ps_ctx == NULL || !ps_ctx->b_ready) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    if (pu8_iv == NULL || t_iv_len == 0 || pu8_tag == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if ((pu8_add == NULL && t_add_len > 0) || (pu8_data == NULL && t_data_len > 0)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (t_tag_len < 4 || t_tag_len > 16) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    //==========================================================================
+    // 暗号化処理
+    //==========================================================================
+    // 入力と出力に同じバッファを指定して暗号化
+    int i_ret = mbedtls_gcm_crypt_and_tag(&ps_ctx->s_gcm_ctx, MBEDTLS_GCM_ENCRYPT, t_data_len,
+                                          pu8_iv, t_iv_len, pu8_add, t_add_len,
+                                          pu8_data, pu8_data, t_tag_len, pu8_tag);
+    // 結果返信
+    return (i_ret == 0) ? ESP_OK : ESP_FAIL;
+}
+
+/*******************************************************************************
+ *
+ * NAME: sts_crypto_gcm_dec_in_place
+ *
+ * DESCRIPTION:復号処理(AES GCMコンテキスト、インプレース)
+ *
+ * PARAMETERS:              Name            RW  Usage
+ * ts_crypto_gcm_context_t* ps_ctx          RW  GCMコンテキスト
+ * const uint8_t*           pu8_iv          R   初期ベクトル
+ * size_t                   t_iv_len        R   初期ベクトルサイズ
+ * const uint8_t*           pu8_add         R   追加認証データ（NULL可）
+ * size_t                   t_add_len       R   追加認証データサイズ
+ * uint8_t*                 pu8_data        RW  暗号文（平文で上書き）
+ * size_t                   t_data_len      R   暗号文サイズ
+ * const uint8_t*           pu8_tag         R   認証タグ
+ * size_t                   t_tag_len       R   認証タグサイズ
+ *
+ * RETURNS:
+ *   esp_err_t:結果ステータス、認証タグの不一致はESP_ERR_INVALID_RESPONSE
+ *
+ * NOTES:
+ * 認証タグは定数時間で検証し、不一致の場合はバッファをゼロクリアする
+ ******************************************************************************/
+esp_err_t sts_crypto_gcm_dec_in_place(ts_crypto_gcm_context_t* ps_ctx,
+                                      const uint8_t* pu8_iv, size_t t_iv_len,
+                                      const uint8_t* pu8_add, size_t t_add_len,
+                                      uint8_t* pu8_data, size_t t_data_len,
+                                      const uint8_t* pu8_tag, size_t t_tag_len) {
+    //==========================================================================
+    // 入力チェック
+    //==========================================================================
+    if (ps_ctx == NULL || !ps_ctx->b_ready) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    if (pu8_iv == NULL || t_iv_len == 0 || pu8_tag == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if ((pu8_add == NULL && t_add_len > 0) || (pu8_data == NULL && t_data_len > 0)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (t_tag_len < 4 || t_tag_len > 16) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    //==========================================================================
+    // 復号処理
+    //==========================================================================
+    // 入力と出力に同じバッファを指定して復号と認証タグの検証
+    int i_ret = mbedtls_gcm_auth_decrypt(&ps_ctx->s_gcm_ctx, t_data_len,
+                                         pu8_iv, t_iv_len, pu8_add, t_add_len,
+                                         pu8_tag, t_tag_len, pu8_data, pu8_data);
+    // 結果返信
+    if (i_ret == MBEDTLS_ERR_GCM_AUTH_FAILED) {
+        return ESP_ERR_INVALID_RESPONSE;
+    }
+    return (i_ret == 0) ? ESP_OK : ESP_FAIL;
+}
+
+
+//==============================================================================
+// ChaCha20-Poly1305関連処理
+//==============================================================================
+
+/*******************************************************************************
+ *
+ * NAME: ps_crypto_chacha20_poly1305_enc
+ *
+ * DESCRIPTION:暗号化処理(ChaCha20-Poly1305)
+ *
+ * PARAMETERS:          Name            RW  Usage
+ * ts_crypto_keyset_t*  ps_keyset       R   共通鍵セット（鍵、ナンス、追加認証データ）
+ * const ts_u8_array_t* ps_plane        R   平文
+ * ts_u8_array_t*       ps_auth_tag     W   認証タグ
+ *
+ * RETURNS:
+ *   ts_u8_array_t*:暗号文
+ *
+ * NOTES:
+ * 追加認証データにはキーセットの認証タグ初期ベクトルを利用する
+ ******************************************************************************/
+ts_u8_array_t* ps_crypto_chacha20_poly1305_enc(const ts_crypto_keyset_t* ps_keyset,
+                                               const ts_u8_array_t* ps_plane,
+                                               ts_u8_array_t* ps_auth_tag) {
+    //==========================================================================
+    // 入力チェック
+    //==========================================================================
+    if (ps_keyset == NULL || ps_keyset->ps_key == NULL || ps_keyset->ps_nonce == NULL) {
+        return NULL;
+    }
+    if (ps_plane == NULL || ps_auth_tag == NULL) {
+        return NULL;
+    }
+    if (ps_keyset->ps_key->t_size != CRYPTO_CHACHAPOLY_KEY_SIZE ||
+        ps_keyset->ps_nonce->t_size != CRYPTO_CHACHAPOLY_NONCE_SIZE ||
+        ps_auth_tag->t_size != CRYPTO_CHACHAPOLY_TAG_SIZE) {
+        return NULL;
+    }
+    // 追加認証データ
+    const ts_u8_array_t* ps_add = ps_keyset->ps_auth_iv;
+    const uint8_t* pu8_add = (ps_add != NULL) ? ps_add->pu8_values : NULL;
+    size_t t_add_size      = (ps_add != NULL) ? ps_add->t_size : 0;
+
+    //==========================================================================
+    // 暗号化処理
+    //==========================================================================
+    ts_u8_array_t* ps_cipher = ps_mdl_clone_u8_array(ps_plane->pu8_values, ps_plane->t_size);
+    if (ps_cipher == NULL) {
+        return NULL;
+    }
+    v_crypto_chachapoly_enc_in_place(ps_keyset->ps_key->pu8_values,
+                                     ps_keyset->ps_nonce->pu8_values,
+                                     pu8_add, t_add_size,
+                                     ps_cipher->pu8_values, ps_cipher->t_size,
+                                     ps_auth_tag->pu8_values);
+    // 結果を返却
+    return ps_cipher;
+}
+
+/*******************************************************************************
+ *
+ * NAME: ps_crypto_chacha20_poly1305_dec
+ *
+ * DESCRIPTION:復号処理(ChaCha20-Poly1305)
+ *
+ * PARAMETERS:          Name            RW  Usage
+ * ts_crypto_keyset_t*  ps_keyset       R   共通鍵セット（鍵、ナンス、追加認証データ）
+ * const ts_u8_array_t* ps_cipher       R   暗号文
+ * const ts_u8_array_t* ps_auth_tag     R   認証タグ
+ *
+ * RETURNS:
+ *   ts_u8_array_t*:復号文、認証タグの不一致の場合はNULL
+ *
+ * NOTES:
+ * 認証タグは定数時間で検証する
+ ******************************************************************************/
+ts_u8_array_t* ps_crypto_chacha20_poly1305_dec(const ts_crypto_keyset_t* ps_keyset,
+                                               const ts_u8_array_t* ps_cipher,
+                                               const ts_u8_array_t* ps_auth_tag) {
+    //==========================================================================
+    // 入力チェック
+    //==========================================================================
+    if (ps_keyset == NULL || ps_keyset->ps_key == NULL || ps_keyset->ps_nonce == NULL) {
+        return NULL;
+    }
+    if (ps_cipher == NULL || ps_auth_tag == NULL) {
+        return NULL;
+    }
+    if (ps_keyset->ps_key->t_size != CRYPTO_CHACHAPOLY_KEY_SIZE ||
+        ps_keyset->ps_nonce->t_size != CRYPTO_CHACHAPOLY_NONCE_SIZE ||
+        ps_auth_tag->t_size != CRYPTO_CHACHAPOLY_TAG_SIZE) {
+        return NULL;
+    }
+    // 追加認証データ
+    const ts_u8_array_t* ps_add = ps_keyset->ps_auth_iv;
+    const uint8_t* pu8_add = (ps_add != NULL) ? ps_add->pu8_values : NULL;
+    size_t t_add_size      = (ps_add != NULL) ? ps_add->t_size : 0;
+
+    //==========================================================================
+    // 復号処理
+    //==========================================================================
+    ts_u8_array_t* ps_plane = ps_mdl_clone_u8_array(ps_cipher->pu8_values, ps_cipher->t_size);
+    if (ps_plane == NULL) {
+        return NULL;
+    }
+    if (!b_crypto_chachapoly_dec_in_place(ps_keyset->ps_key->pu8_values,
+                                          ps_keyset->ps_nonce->pu8_values,
+                                          pu8_add, t_add_size,
+                                          ps_plane->pu8_values, ps_plane->t_size,
+                                          ps_auth_tag->pu8_values)) {
+        // 認証エラー
+        sts_mdl_delete_u8_array(ps_plane);
+        return NULL;
+    }
+    // 結果を返却
+    return ps_plane;
+}
+
+/*******************************************************************************
+ *
+ * NAME: sts_crypto_chacha20_poly1305_enc_in_place
+ *
+ * DESCRIPTION:暗号化処理(ChaCha20-Poly1305、インプレース)
+ *
+ * PARAMETERS:      Name            RW  Usage
+ * const uint8_t*   pu8_key         R   共通鍵（32バイト）
+ * const uint8_t*   pu8_nonce       R   ナンス（12バイト）
+ * const uint8_t*   pu8_add         R   追加認証データ（NULL可）
+ * size_t           t_add_len       R   追加認証データサイズ
+ * uint8_t*         pu8_data        RW  平文（暗号文で上書き）
+ * size_t           t_data_len      R   平文サイズ
+ * uint8_t*         pu8_tag         W   認証タグ（16バイト）
+ *
+ * RETURNS:
+ *   esp_err_t:結果ステータス
+ *
+ * NOTES:
+ * ヒープ領域を確保しない
+ ******************************************************************************/
+esp_err_t sts_crypto_chacha20_poly1305_enc_in_place(const uint8_t* pu8_key,
+                                                    const uint8_t* pu8_nonce,
+                                                    const uint8_t* pu8_add, size_t t_add_len,
+                                                    uint8_t* pu8_data, size_t t_data_len,
+                                                    uint8_t* pu8_tag) {
+    // 入力チェック
+    if (pu8_key == NULL || pu8_nonce == NULL || pu8_tag == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if ((pu8_add == NULL && t_add_len > 0) || (pu8_data == NULL && t_data_len > 0)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    // 暗号化処理
+    v_crypto_chachapoly_enc_in_place(pu8_key, pu8_nonce, pu8_add, t_add_len, pu8_data, t_data_len, pu8_tag);
+    // 正常終了
+    return ESP_OK;
+}
+
+/*******************************************************************************
+ *
+ * NAME: sts_crypto_chacha20_poly1305_dec_in_place
+ *
+ * DESCRIPTION:復号処理(ChaCha20-Poly1305、インプレース)
+ *
+ * PARAMETERS:      Name            RW  Usage
+ * const uint8_t*   pu8_key         R   共通鍵（32バイト）
+ * const uint8_t*   pu8_nonce       R   ナンス（12バイト）
+ * const uint8_t*   pu8_add         R   追加認証データ（NULL可）
+ * size_t           t_add_len       R   追加認証データサイズ
+ * uint8_t*         pu8_data        RW  暗号文（平文で上書き）
+ * size_t           t_data_len      R   暗号文サイズ
+ * const uint8_t*   pu8_tag         R   認証タグ（16バイト）
+ *
+ * RETURNS:
+ *   esp_err_t:結果ステータス、認証タグの不一致はESP_ERR_INVALID_RESPONSE
+ *
+ * NOTES:
+ * 認証タグは定数時間で検証し、不一致の場合はバッファを変更しない
+ ******************************************************************************/
+esp_err_t sts_crypto_chacha20_poly1305_dec_in_place(const uint8_t* pu8_key,
+                                                    const uint8_t* pu8_nonce,
+                                                    const uint8_t* pu8_add, size_t t_add_len,
+                                                    uint8_t* pu8_data, size_t t_data_len,
+                                                    const uint8_t* pu8_tag) {
+    // 入力チェック
+    if (pu8_key == NULL || pu8_nonce == NULL || pu8_tag == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if ((pu8_add == NULL && t_add_len > 0) || (pu8_data == NULL && t_data_len > 0)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    // 復号と認証タグの検証
+    if (!b_crypto_chachapoly_dec_in_place(pu8_key, pu8_nonce, pu8_add, t_add_len, pu8_data, t_data_len, pu8_tag)) {
+        return ESP_ERR_INVALID_RESPONSE;
+    }
+    // 正常終了
+    return ESP_OK;
+}
+
+//==============================================================================
+// ECDH関連処理
+//==============================================================================
+
+/*******************************************************************************
+ *
+ * NAME: ps_crypto_x25519_client_context
+ *
+ * DESCRIPTION:ECDHコンテキストの生成処理
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *
+ * RETURNS:
+ *   ts_crypto_ecdh_context_t*:ECDHコンテキスト
+ *
+ * NOTES:
+ * 鍵ペアプールに在庫がある場合は事前生成した鍵ペアを利用する
+ ******************************************************************************/
+ts_crypto_x25519_context_t* ps_crypto_x25519_client_context() {
+    //==========================================================================
+    // 初期処理
+    //==========================================================================
+    v_crypto_init_t f_init = f_crypto_init;
+    f_init();
+
+    //==========================================================================
+    // ECDHコンテキストの生成（公開鍵の生成済みの鍵ペアを取得）
+    //==========================================================================
+    return ps_x25519_pool_take();
+}
+
+/*******************************************************************************
+ *
+ * NAME: ps_crypto_x25519_server_context
+ *
+ * DESCRIPTION:ECDHコンテキストの生成処理（サーバー側）
+ *
+ * PARAMETERS:      Name                RW  Usage
+ * uint8_t*         pu8_client_pub_key  R   受信した公開鍵
+ *
+ * RETURNS:
+ *   ts_crypto_ecdh_context_t*:ECDHコンテキスト
+ *
+ * NOTES:
+ * 鍵ペアプールに在庫がある場合は事前生成した鍵ペアを利用し、共通鍵の算出のみ行う
+ ******************************************************************************/
+ts_crypto_x25519_context_t* ps_crypto_x25519_server_context(uint8_t* pu8_client_pub_key) {
+    //==========================================================================
+    // 初期処理
+    //==========================================================================
+    v_crypto_init_t f_init = f_crypto_init;
+    f_init();
+
+    //==========================================================================
+    // 入力チェック
+    //==========================================================================
+    if (pu8_client_pub_key == NULL) {
+        return NULL;
     }
 
     //==========================================================================
@@ -1745,61 +2904,30 @@ ts_crypto_x25519_context_t* ps_crypto_x25519_server_context(uint8_t* pu8_client_
     ts_crypto_x25519_context_t* ps_ctx = NULL;
     do {
         //----------------------------------------------------------------------
-        // X25519コンテキストの生成
-        //----------------------------------------------------------------------
-        // X25519コンテキストの確保
-        ps_ctx = pv_mem_calloc(sizeof(ts_crypto_x25519_context_t));
-        if (ps_ctx == NULL) {
-            break;
-        }
-        // プロパティ初期化
-        memset(ps_ctx->u8_svr_public_key, 0x00, CRYPTO_X25519_SERVER_PUBLIC_KEY_SIZE);
-        memset(ps_ctx->u8_key, 0x00, CRYPTO_X25519_KEY_SIZE);
-
-        //----------------------------------------------------------------------
-        // ECDHコンテキストの初期化
+        // 受信した公開鍵の曲線（ECParameters）とECPoint長をチェック
         //----------------------------------------------------------------------
-        // ECDHコンテキストを初期化
-        mbedtls_ecdh_init(&ps_ctx->s_ecdh_ctx);
-        // 受信した公開鍵を読み込み
-        const unsigned char* pc_client_pub_key = (const unsigned char*)pu8_client_pub_key;
-        int i_ret = mbedtls_ecdh_read_params(&ps_ctx->s_ecdh_ctx,
-                                             &pc_client_pub_key,
-                                             pu8_client_pub_key + CRYPTO_CURVE25519_CLIENT_PUBLIC_KEY_LEN);
-        if (i_ret != 0) {
-            // コンテキストを解放
-            v_crypto_x25519_delete_context(ps_ctx);
-            ps_ctx = NULL;
+        if (memcmp(pu8_client_pub_key, s_x25519_pub_key_header, CRYPTO_CURVE25519_PUBLIC_KEY_HEADER_LEN) != 0) {
             break;
         }
 
         //----------------------------------------------------------------------
-        // X25519公開鍵を生成
+        // 鍵ペアの取得
         //----------------------------------------------------------------------
-        size_t t_out_len;
-        i_ret = mbedtls_ecdh_make_public(&ps_ctx->s_ecdh_ctx,
-                                         &t_out_len,
-                                         ps_ctx->u8_svr_public_key,
-                                         CRYPTO_CURVE25519_SERVER_PUBLIC_KEY_LEN,
-                                         mbedtls_ctr_drbg_random,
-                                         &s_drbg_context.s_ctr_drbg_ctx);
-        if (i_ret != 0 || t_out_len != CRYPTO_CURVE25519_SERVER_PUBLIC_KEY_LEN) {
-            // コンテキストを解放
-            v_crypto_x25519_delete_context(ps_ctx);
-            ps_ctx = NULL;
+        ps_ctx = ps_x25519_pool_take();
+        if (ps_ctx == NULL) {
             break;
         }
+        // 自公開鍵（ECPoint）をサーバー側の公開鍵に設定
+        memcpy(ps_ctx->u8_svr_public_key,
+               &ps_ctx->u8_cli_public_key[CRYPTO_CURVE25519_CLIENT_PUBLIC_KEY_LEN - CRYPTO_CURVE25519_SERVER_PUBLIC_KEY_LEN],
+               CRYPTO_CURVE25519_SERVER_PUBLIC_KEY_LEN);
 
         //----------------------------------------------------------------------
         // 共通鍵の生成
         //----------------------------------------------------------------------
-        i_ret = mbedtls_ecdh_calc_secret(&ps_ctx->s_ecdh_ctx,
-                                         &t_out_len,
-                                         ps_ctx->u8_key,
-                                         CRYPTO_X25519_KEY_SIZE,
-                                         mbedtls_ctr_drbg_random,
-                                         &s_drbg_context.s_ctr_drbg_ctx);
-        if (i_ret != 0) {
+        if (!b_crypto_x25519_scalarmult(ps_ctx->u8_key,
+                                        ps_ctx->u8_private_key,
+                                        &pu8_client_pub_key[CRYPTO_CURVE25519_PUBLIC_KEY_HEADER_LEN])) {
             // コンテキストを解放
             v_crypto_x25519_delete_context(ps_ctx);
             ps_ctx = NULL;
@@ -1813,16 +2941,6 @@ ts_crypto_x25519_context_t* ps_crypto_x25519_server_context(uint8_t* pu8_client_
 
     } while(false);
 
-    //==========================================================================
-    // 乱数生成器のトランザクション終了
-    //==========================================================================
-    v_drbg_transaction_end();
-
-    //==========================================================================
-    // クリティカルセクション終了
-    //==========================================================================
-    xSemaphoreGiveRecursive(s_mutex);
-
     // 結果返信
     return ps_ctx;
 }
@@ -1856,49 +2974,26 @@ esp_err_t sts_crypto_x25519_client_secret(ts_crypto_x25519_context_t* ps_client_
         return ESP_ERR_INVALID_ARG;
     }
 
-    //==========================================================================
-    // クリティカルセクション開始
-    //==========================================================================
-    if (xSemaphoreTakeRecursive(s_mutex, portMAX_DELAY) != pdTRUE) {
-        return ESP_ERR_TIMEOUT;
-    }
-
-    //==========================================================================
-    // 乱数生成器のトランザクション開始
-    //==========================================================================
-    if (sts_drbg_transaction_start() != ESP_OK) {
-        // クリティカルセクション終了
-        xSemaphoreGiveRecursive(s_mutex);
-        return ESP_ERR_INVALID_STATE;
-    }
-
     //==========================================================================
     // ECDHの共通鍵の生成処理
     //==========================================================================
     esp_err_t sts_val = ESP_OK;
     do {
         //----------------------------------------------------------------------
-        // ECDHコンテキストに受信した公開鍵を追加
+        // 受信した公開鍵のECPoint長をチェック
         //----------------------------------------------------------------------
-        int i_ret = mbedtls_ecdh_read_public(&ps_client_ctx->s_ecdh_ctx,
-                                             pu8_server_pub_key,
-                                             CRYPTO_CURVE25519_SERVER_PUBLIC_KEY_LEN);
-        if (i_ret != 0) {
+        if (pu8_server_pub_key[0] != CRYPTO_X25519_BYTES) {
             sts_val = ESP_ERR_INVALID_STATE;
             break;
         }
 
         //----------------------------------------------------------------------
-        // 共通鍵を生成して、ECDHコンテキストに設定
+        // 共通鍵を生成して、コンテキストに設定
         //----------------------------------------------------------------------
-        size_t t_out_len;
-        i_ret = mbedtls_ecdh_calc_secret(&ps_client_ctx->s_ecdh_ctx,
-                                         &t_out_len,
-                                         ps_client_ctx->u8_key,
-                                         CRYPTO_X25519_KEY_SIZE,
-                                         mbedtls_ctr_drbg_random,
-                                         &s_drbg_context.s_ctr_drbg_ctx);
-        if (i_ret != 0) {
+        if (!b_crypto_x25519_scalarmult(ps_client_ctx->u8_key,
+                                        ps_client_ctx->u8_private_key,
+                                        &pu8_server_pub_key[1])) {
+            memset(ps_client_ctx->u8_key, 0x00, CRYPTO_X25519_KEY_SIZE);
             sts_val = ESP_ERR_INVALID_STATE;
             break;
         }
@@ -1910,16 +3005,6 @@ esp_err_t sts_crypto_x25519_client_secret(ts_crypto_x25519_context_t* ps_client_
 
     } while(false);
 
-    //==========================================================================
-    // 乱数生成器のトランザクション終了
-    //==========================================================================
-    v_drbg_transaction_end();
-
-    //==========================================================================
-    // クリティカルセクション終了
-    //==========================================================================
-    xSemaphoreGiveRecursive(s_mutex);
-
     // 結果返信
     return sts_val;
 }
@@ -1941,9 +3026,8 @@ void v_crypto_x25519_delete_context(ts_crypto_x25519_context_t* ps_ctx) {
     if (ps_ctx == NULL) {
         return;
     }
-    // コンテキストの削除
-    mbedtls_ecdh_free(&ps_ctx->s_ecdh_ctx);
     // プロパティクリア
+    memset(ps_ctx->u8_private_key, 0x00, CRYPTO_X25519_KEY_SIZE);
     memset(ps_ctx->u8_cli_public_key, 0x00, CRYPTO_X25519_CLIENT_PUBLIC_KEY_SIZE);
     memset(ps_ctx->u8_svr_public_key, 0x00, CRYPTO_X25519_SERVER_PUBLIC_KEY_SIZE);
     memset(ps_ctx->u8_key, 0x00, CRYPTO_X25519_KEY_SIZE);
@@ -1951,6 +3035,80 @@ void v_crypto_x25519_delete_context(ts_crypto_x25519_context_t* ps_ctx) {
     l_mem_free(ps_ctx);
 }
 
+/*******************************************************************************
+ *
+ * NAME: sts_crypto_x25519_pool_begin
+ *
+ * DESCRIPTION:X25519鍵ペアプールの補充開始
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *
+ * RETURNS:
+ *   esp_err_t:結果ステータス
+ *
+ * NOTES:
+ * アイドル優先度の補充タスクを開始し、プールに空きが出来る度に鍵ペアを事前生成する。
+ * 開始済みの場合には何もせずに正常終了する
+ ******************************************************************************/
+esp_err_t sts_crypto_x25519_pool_begin() {
+    //==========================================================================
+    // 初期処理
+    //==========================================================================
+    v_crypto_init_t f_init = f_crypto_init;
+    f_init();
+
+    //==========================================================================
+    // 補充タスクの開始判定
+    //==========================================================================
+    taskENTER_CRITICAL(&s_x25519_pool_spinlock);
+    bool b_started = s_x25519_pool_started;
+    s_x25519_pool_started = true;
+    taskEXIT_CRITICAL(&s_x25519_pool_spinlock);
+    if (b_started) {
+        return ESP_OK;
+    }
+
+    //==========================================================================
+    // 補充タスクの生成
+    //==========================================================================
+    TaskHandle_t s_handle = NULL;
+    portBASE_TYPE b_type = xTaskCreatePinnedToCore(v_x25519_pool_task,
+                                                   "x25519_pool_task",
+                                                   CRYPTO_X25519_POOL_STACK_DEPTH,
+                                                   NULL,
+                                                   CRYPTO_X25519_POOL_PRIORITIES,
+                                                   &s_handle,
+                                                   tskNO_AFFINITY);
+    taskENTER_CRITICAL(&s_x25519_pool_spinlock);
+    if (b_type == pdPASS) {
+        s_x25519_pool_handle = s_handle;
+    } else {
+        s_x25519_pool_started = false;
+    }
+    taskEXIT_CRITICAL(&s_x25519_pool_spinlock);
+    // 結果返信
+    return (b_type == pdPASS) ? ESP_OK : ESP_FAIL;
+}
+
+/*******************************************************************************
+ *
+ * NAME: u32_crypto_x25519_pool_count
+ *
+ * DESCRIPTION:X25519鍵ペアプールの在庫数
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *
+ * RETURNS:
+ *   uint32_t:事前生成済みの鍵ペア数
+ *
+ ******************************************************************************/
+uint32_t u32_crypto_x25519_pool_count() {
+    taskENTER_CRITICAL(&s_x25519_pool_spinlock);
+    uint32_t u32_cnt = s_x25519_pool_cnt;
+    taskEXIT_CRITICAL(&s_x25519_pool_spinlock);
+    return u32_cnt;
+}
+
 
 /******************************************************************************/
 /***      Local Functions                                                   ***/
@@ -1970,12 +3128,18 @@ void v_crypto_x25519_delete_context(ts_crypto_x25519_context_t* ps_ctx) {
  *
  ******************************************************************************/
 static void v_crypto_init() {
-    // ミューテックスを生成
-    if (s_mutex == NULL) {
-        s_mutex = xSemaphoreCreateRecursiveMutex();
+    // コア毎の疑似乱数生成器のミューテックスを生成（静的領域を利用する為、クリティカルセクション内で生成）
+    taskENTER_CRITICAL(&s_init_spinlock);
+    uint8_t u8_core_id;
+    for (u8_core_id = 0; u8_core_id < portNUM_PROCESSORS; u8_core_id++) {
+        ts_crypto_drbg_context_t* ps_drbg = &s_drbg_context[u8_core_id];
+        if (ps_drbg->s_mutex == NULL) {
+            ps_drbg->s_mutex = xSemaphoreCreateRecursiveMutexStatic(&ps_drbg->s_mutex_buffer);
+        }
     }
     // 初期化関数を初期化
     f_crypto_init = v_crypto_init_dmy;
+    taskEXIT_CRITICAL(&s_init_spinlock);
 }
 
 /*******************************************************************************
@@ -1996,32 +3160,88 @@ static void v_crypto_init_dmy(){
 
 /*******************************************************************************
  *
- * NAME: v_drbg_transaction_start
+ * NAME: ps_drbg_acquire
  *
- * DESCRIPTION:drbg transaction start
+ * DESCRIPTION:自コアの疑似乱数生成器の取得（排他制御開始）
  *
  * PARAMETERS:      Name            RW  Usage
  *
  * RETURNS:
+ *   ts_crypto_drbg_context_t*:疑似乱数生成器（取得失敗時はNULL）
  *
- * RETURNS:
- * esp_err_t:結果ステータス
- *
+ * NOTES:
+ * コア毎に常駐する生成器を利用する為、ミューテックスは通常競合しない。
+ * 初回利用時にシードし、再シードポリシーが変更されていれば適用する。
  ******************************************************************************/
-static esp_err_t sts_drbg_transaction_start() {
+static ts_crypto_drbg_context_t* ps_drbg_acquire() {
     //==========================================================================
-    // エントロピーソース設定
+    // 初期処理
     //==========================================================================
-    // エントロピーコンテキストの初期化
-    mbedtls_entropy_init(&s_drbg_context.s_entropy_ctx);
-    // エントロピーソース（ハードウェアソース）の設定
-    int i_ret = mbedtls_entropy_add_source(&s_drbg_context.s_entropy_ctx,
-                                           i_entropy_source_hw_random, NULL,
-                                           32, MBEDTLS_ENTROPY_SOURCE_STRONG);
-    if (i_ret != 0) {
-        return ESP_ERR_INVALID_STATE;
+    v_crypto_init_t f_init = f_crypto_init;
+    f_init();
+
+    //==========================================================================
+    // 自コアの生成器の排他制御開始
+    //==========================================================================
+    ts_crypto_drbg_context_t* ps_drbg = &s_drbg_context[xPortGetCoreID()];
+    if (xSemaphoreTakeRecursive(ps_drbg->s_mutex, portMAX_DELAY) != pdTRUE) {
+        return NULL;
     }
 
+    //==========================================================================
+    // シード及びポリシーの適用
+    //==========================================================================
+    if (!ps_drbg->b_seeded) {
+        if (sts_drbg_seed(ps_drbg) != ESP_OK) {
+            xSemaphoreGiveRecursive(ps_drbg->s_mutex);
+            return NULL;
+        }
+    }
+    uint32_t u32_policy_ver = s_drbg_policy_ver;
+    if (ps_drbg->u32_policy_ver != u32_policy_ver) {
+        mbedtls_ctr_drbg_set_reseed_interval(&ps_drbg->s_ctr_drbg_ctx, (int)s_drbg_reseed_interval);
+        mbedtls_ctr_drbg_set_prediction_resistance(&ps_drbg->s_ctr_drbg_ctx,
+            s_drbg_prediction_resistance ? MBEDTLS_CTR_DRBG_PR_ON : MBEDTLS_CTR_DRBG_PR_OFF);
+        ps_drbg->u32_policy_ver = u32_policy_ver;
+    }
+    // 結果返信
+    return ps_drbg;
+}
+
+/*******************************************************************************
+ *
+ * NAME: v_drbg_release
+ *
+ * DESCRIPTION:疑似乱数生成器の解放（排他制御終了）
+ *
+ * PARAMETERS:                  Name        RW  Usage
+ * ts_crypto_drbg_context_t*    ps_drbg     RW  疑似乱数生成器
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * None.
+ ******************************************************************************/
+static void v_drbg_release(ts_crypto_drbg_context_t* ps_drbg) {
+    xSemaphoreGiveRecursive(ps_drbg->s_mutex);
+}
+
+/*******************************************************************************
+ *
+ * NAME: sts_drbg_seed
+ *
+ * DESCRIPTION:疑似乱数生成器の初期シード
+ *
+ * PARAMETERS:                  Name        RW  Usage
+ * ts_crypto_drbg_context_t*    ps_drbg     RW  疑似乱数生成器
+ *
+ * RETURNS:
+ * esp_err_t:結果ステータス
+ *
+ * NOTES:
+ * エントロピーはハードウェア乱数から直接取得する
+ ******************************************************************************/
+static esp_err_t sts_drbg_seed(ts_crypto_drbg_context_t* ps_drbg) {
     //==========================================================================
     // 乱数生成器の設定
     //==========================================================================
@@ -2029,41 +3249,258 @@ static esp_err_t sts_drbg_transaction_start() {
     uint8_t u8_personal_data[CRYPTO_PERSONAL_DATA_LEN];
     b_vutil_set_u8_rand_array(u8_personal_data,  CRYPTO_PERSONAL_DATA_LEN);
     // 疑似乱数生成器の初期処理
-    mbedtls_ctr_drbg_init(&s_drbg_context.s_ctr_drbg_ctx);
+    mbedtls_ctr_drbg_init(&ps_drbg->s_ctr_drbg_ctx);
     // 乱数シード生成
-    i_ret = mbedtls_ctr_drbg_seed(&s_drbg_context.s_ctr_drbg_ctx,
-                                  mbedtls_entropy_func,
-                                  &s_drbg_context.s_entropy_ctx,
-                                  u8_personal_data,
-                                  CRYPTO_PERSONAL_DATA_LEN);
+    int i_ret = mbedtls_ctr_drbg_seed(&ps_drbg->s_ctr_drbg_ctx,
+                                      i_entropy_source_hw_random,
+                                      NULL,
+                                      u8_personal_data,
+                                      CRYPTO_PERSONAL_DATA_LEN);
     if (i_ret != 0) {
-        // エントロピーコンテキストを解放
-        mbedtls_entropy_free(&s_drbg_context.s_entropy_ctx);
+        // 乱数生成器のコンテキストを解放
+        mbedtls_ctr_drbg_free(&ps_drbg->s_ctr_drbg_ctx);
         // エラーステータス
         return ESP_ERR_INVALID_STATE;
     }
+    // シード済み（ポリシーは未適用）
+    ps_drbg->b_seeded = true;
+    ps_drbg->u32_policy_ver = 0;
     // 正常終了
     return ESP_OK;
 }
 
 /*******************************************************************************
  *
- * NAME: v_drbg_transaction_end
+ * NAME: b_hash_is_sha512
+ *
+ * DESCRIPTION:SHA512系のハッシュアルゴリズム判定
  *
- * DESCRIPTION:drbg transaction end
+ * PARAMETERS:              Name        RW  Usage
+ * te_crypto_hash_type_t    e_type      R   ハッシュアルゴリズム
+ *
+ * RETURNS:
+ *   true:SHA384/SHA512
+ *
+ ******************************************************************************/
+static bool b_hash_is_sha512(te_crypto_hash_type_t e_type) {
+    return (e_type == CRYPTO_HASH_SHA384 || e_type == CRYPTO_HASH_SHA512);
+}
+
+/*******************************************************************************
+ *
+ * NAME: u32_hash_block_size
+ *
+ * DESCRIPTION:ハッシュアルゴリズムのブロックサイズ
+ *
+ * PARAMETERS:              Name        RW  Usage
+ * te_crypto_hash_type_t    e_type      R   ハッシュアルゴリズム
+ *
+ * RETURNS:
+ *   uint32_t:ブロックサイズ
+ *
+ ******************************************************************************/
+static uint32_t u32_hash_block_size(te_crypto_hash_type_t e_type) {
+    return b_hash_is_sha512(e_type) ? CRYPTO_SHA512_BLOCK_SIZE : CRYPTO_SHA256_BLOCK_SIZE;
+}
+
+/*******************************************************************************
+ *
+ * NAME: v_hash_clone
+ *
+ * DESCRIPTION:ハッシュコンテキストの複製
+ *
+ * PARAMETERS:                      Name        RW  Usage
+ * ts_crypto_hash_context_t*        ps_dst      W   複製先（初期化済み）
+ * const ts_crypto_hash_context_t*  ps_src      R   複製元
+ *
+ * RETURNS:
+ *
+ ******************************************************************************/
+static void v_hash_clone(ts_crypto_hash_context_t* ps_dst, const ts_crypto_hash_context_t* ps_src) {
+    ps_dst->e_type = ps_src->e_type;
+    if (b_hash_is_sha512(ps_src->e_type)) {
+        mbedtls_sha512_clone(&ps_dst->u_ctx.s_sha512, &ps_src->u_ctx.s_sha512);
+    } else {
+        v_crypto_be_sha256_clone(&ps_dst->u_ctx.s_sha256, &ps_src->u_ctx.s_sha256);
+    }
+}
+
+/*******************************************************************************
+ *
+ * NAME: sts_hmac_pad_state
+ *
+ * DESCRIPTION:HMACのパッド適用済みハッシュ状態の生成
+ *
+ * PARAMETERS:                  Name        RW  Usage
+ * ts_crypto_hash_context_t*    ps_dst      W   生成先（初期化済み）
+ * const uint8_t*               pu8_pad     R   キーブロックにipad/opadを適用した値
+ * uint32_t                     u32_size    R   ブロックサイズ
+ *
+ * RETURNS:
+ *   esp_err_t:結果ステータス
+ *
+ * NOTES:
+ * ESP32のSHAエンジンは計算途中のコンテキストに占有され続ける為、
+ * 一時コンテキストで計算した状態を複製して保持し、一時コンテキストは即時解放する。
+ * 複製された状態はソフトウェア計算の状態となり、エンジンを占有しない。
+ ******************************************************************************/
+static esp_err_t sts_hmac_pad_state(ts_crypto_hash_context_t* ps_dst, const uint8_t* pu8_pad, uint32_t u32_size) {
+    ts_crypto_hash_context_t s_work;
+    esp_err_t sts_val = sts_crypto_hash_init(&s_work, ps_dst->e_type);
+    if (sts_val != ESP_OK) {
+        return sts_val;
+    }
+    sts_val = sts_crypto_hash_update(&s_work, pu8_pad, u32_size);
+    if (sts_val == ESP_OK) {
+        v_hash_clone(ps_dst, &s_work);
+    }
+    // 一時コンテキストの解放（SHAエンジンの解放）
+    v_crypto_hash_free(&s_work);
+    // 結果返信
+    return sts_val;
+}
+
+/*******************************************************************************
+ *
+ * NAME: ps_x25519_keypair
+ *
+ * DESCRIPTION:X25519鍵ペアの生成
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *
+ * RETURNS:
+ *   ts_crypto_x25519_context_t*:公開鍵の生成済みのコンテキスト
+ *
+ * NOTES:
+ * 公開鍵はmbedTLSのECDHと同じECParametersとECPointの形式で自公開鍵（クライアント）に格納する
+ ******************************************************************************/
+static ts_crypto_x25519_context_t* ps_x25519_keypair() {
+    ts_crypto_x25519_context_t* ps_ctx = NULL;
+    do {
+        //----------------------------------------------------------------------
+        // X25519コンテキストの生成
+        //----------------------------------------------------------------------
+        // X25519コンテキストの確保
+        ps_ctx = pv_mem_calloc(sizeof(ts_crypto_x25519_context_t));
+        if (ps_ctx == NULL) {
+            break;
+        }
+        // プロパティ初期化
+        memset(ps_ctx->u8_svr_public_key, 0x00, CRYPTO_X25519_SERVER_PUBLIC_KEY_SIZE);
+        memset(ps_ctx->u8_key, 0x00, CRYPTO_X25519_KEY_SIZE);
+
+        //----------------------------------------------------------------------
+        // X25519秘密鍵を生成
+        //----------------------------------------------------------------------
+        if (i_crypto_drbg_random(NULL, ps_ctx->u8_private_key, CRYPTO_X25519_KEY_SIZE) != 0) {
+            // コンテキストを解放
+            v_crypto_x25519_delete_context(ps_ctx);
+            ps_ctx = NULL;
+            break;
+        }
+
+        //----------------------------------------------------------------------
+        // X25519公開鍵を生成
+        //----------------------------------------------------------------------
+        memcpy(ps_ctx->u8_cli_public_key, s_x25519_pub_key_header, CRYPTO_CURVE25519_PUBLIC_KEY_HEADER_LEN);
+        v_crypto_x25519_public_key(&ps_ctx->u8_cli_public_key[CRYPTO_CURVE25519_PUBLIC_KEY_HEADER_LEN],
+                                   ps_ctx->u8_private_key);
+    } while(false);
+
+    // 結果返信
+    return ps_ctx;
+}
+
+/*******************************************************************************
+ *
+ * NAME: ps_x25519_pool_take
+ *
+ * DESCRIPTION:X25519鍵ペアの取得
  *
  * PARAMETERS:      Name            RW  Usage
  *
  * RETURNS:
+ *   ts_crypto_x25519_context_t*:公開鍵の生成済みのコンテキスト
+ *
+ * NOTES:
+ * 取得した鍵ペアはプールから外れる為、一度だけ利用されて削除時に消去される。
+ * プールが空の場合はその場で生成する
+ ******************************************************************************/
+static ts_crypto_x25519_context_t* ps_x25519_pool_take() {
+    //==========================================================================
+    // プールから取得
+    //==========================================================================
+    ts_crypto_x25519_context_t* ps_ctx = NULL;
+    taskENTER_CRITICAL(&s_x25519_pool_spinlock);
+    if (s_x25519_pool_cnt > 0) {
+        s_x25519_pool_cnt--;
+        ps_ctx = s_x25519_pool[s_x25519_pool_cnt];
+        s_x25519_pool[s_x25519_pool_cnt] = NULL;
+    }
+    TaskHandle_t s_handle = s_x25519_pool_handle;
+    taskEXIT_CRITICAL(&s_x25519_pool_spinlock);
+    // 補充タスクに通知
+    if (s_handle != NULL) {
+        xTaskNotifyGive(s_handle);
+    }
+
+    //==========================================================================
+    // 在庫が無い場合は生成
+    //==========================================================================
+    if (ps_ctx == NULL) {
+        ps_ctx = ps_x25519_keypair();
+    }
+    // 結果返信
+    return ps_ctx;
+}
+
+/*******************************************************************************
+ *
+ * NAME: v_x25519_pool_task
+ *
+ * DESCRIPTION:X25519鍵ペアプールの補充タスク
+ *
+ * PARAMETERS:      Name            RW  Usage
+ * void*            pv_args         R   未使用
  *
  * RETURNS:
  *
+ * NOTES:
+ * プールが満杯の間は通知を待機し、空きがあれば1ペアずつ生成して格納する
  ******************************************************************************/
-static void v_drbg_transaction_end() {
-    // 乱数生成器のコンテキストを解放
-    mbedtls_ctr_drbg_free(&s_drbg_context.s_ctr_drbg_ctx);
-    // エントロピーコンテキストを解放
-    mbedtls_entropy_free(&s_drbg_context.s_entropy_ctx);
+static void v_x25519_pool_task(void* pv_args) {
+    while (true) {
+        //----------------------------------------------------------------------
+        // 空きの判定
+        //----------------------------------------------------------------------
+        taskENTER_CRITICAL(&s_x25519_pool_spinlock);
+        bool b_full = (s_x25519_pool_cnt >= CRYPTO_X25519_POOL_SIZE);
+        taskEXIT_CRITICAL(&s_x25519_pool_spinlock);
+        if (b_full) {
+            // 鍵ペアの取得を待機
+            ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+            continue;
+        }
+
+        //----------------------------------------------------------------------
+        // 鍵ペアの生成と格納
+        //----------------------------------------------------------------------
+        ts_crypto_x25519_context_t* ps_ctx = ps_x25519_keypair();
+        if (ps_ctx == NULL) {
+            // 生成エラー（メモリ不足等）の場合は次の取得まで待機
+            ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+            continue;
+        }
+        taskENTER_CRITICAL(&s_x25519_pool_spinlock);
+        if (s_x25519_pool_cnt < CRYPTO_X25519_POOL_SIZE) {
+            s_x25519_pool[s_x25519_pool_cnt] = ps_ctx;
+            s_x25519_pool_cnt++;
+            ps_ctx = NULL;
+        }
+        taskEXIT_CRITICAL(&s_x25519_pool_spinlock);
+        // 格納できなかった鍵ペアは消去
+        v_crypto_x25519_delete_context(ps_ctx);
+    }
 }
 
 /*******************************************************************************
@@ -2072,10 +3509,9 @@ static void v_drbg_transaction_end() {
  * DESCRIPTION:ハードウェア乱数によるエントロピーソース
  *
  * PARAMETERS:      Name            RW  Usage
- * void*            pv_data         R   ?
+ * void*            pv_data         R   未使用
  * unsigned char*   puc_output      W   乱数の出力先
  * size_t           t_len           R   生成サイズ
- * size_t*          pt_outpu_len    R   生成サイズ
  *
  * RETURNS:
  * 0:正常終了
@@ -2083,10 +3519,8 @@ static void v_drbg_transaction_end() {
  ******************************************************************************/
 static int i_entropy_source_hw_random(void* pv_data,
                                        unsigned char* puc_output,
-                                       size_t t_len,
-                                       size_t* pt_outpu_len) {
+                                       size_t t_len) {
     esp_fill_random(puc_output, t_len);
-    *pt_outpu_len = t_len;
     return 0;
 }
 
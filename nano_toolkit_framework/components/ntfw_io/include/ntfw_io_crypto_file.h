@@ -0,0 +1,114 @@
+/*******************************************************************************
+ *
+ * COMPONENT:Nano Toolkit Framework
+ *
+ * MODULE :Encrypted File Utility functions header file
+ *
+ * CREATED:2024/11/19 21:00:00
+ * AUTHOR :Kakuheiki.Nakanohito
+ *
+ * DESCRIPTION:チャンク分割した認証付き暗号（AES-GCM）ファイルのストリーム処理
+ *
+ *   ファイル形式（数値はビッグエンディアン）
+ *   +--------+--------------------------------------------------------------+
+ *   | 0 - 3  | マジックナンバー "NTCF"                                      |
+ *   | 4      | バージョン                                                   |
+ *   | 5      | 認証タグサイズ                                               |
+ *   | 6 - 7  | 予約（0x00）                                                 |
+ *   | 8 - 11 | チャンクサイズ（平文）                                       |
+ *   | 12 - 19| ナンスプレフィックス（ファイル毎の乱数）                     |
+ *   +--------+--------------------------------------------------------------+
+ *   | 以降   | チャンク[n]：暗号文（チャンクサイズ以下）＋認証タグ          |
+ *   +--------+--------------------------------------------------------------+
+ *   チャンク[n]の初期ベクトルはナンスプレフィックス＋n（4byte）、
+ *   追加認証データはヘッダ＋最終チャンクフラグ（1byte）とする。
+ *   チャンクサイズ未満のチャンクを最終チャンクとし（平文がチャンクサイズの倍数の場合は
+ *   空の最終チャンクを付与）、切り詰めやチャンクの入れ替えを検出する
+ *
+ * CHANGE HISTORY:
+ *
+ * LAST MODIFIED BY:
+ *
+ *******************************************************************************
+ *
+ * Copyright (c) 2024 Kakuheiki.Nakanohito
+ * Released under the MIT license
+ * https://opensource.org/licenses/mit-license.php
+ *
+ ******************************************************************************/
+#ifndef  __NTFW_IO_CRYPTO_FILE_H__
+#define  __NTFW_IO_CRYPTO_FILE_H__
+
+
+#if defined __cplusplus
+extern "C" {
+#endif
+
+/******************************************************************************/
+/***      Include files                                                     ***/
+/******************************************************************************/
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <esp_err.h>
+#include "ntfw_cryptography.h"
+
+/******************************************************************************/
+/***      Macro Definitions                                                 ***/
+/******************************************************************************/
+/** ファイルヘッダサイズ */
+#define IO_CFILE_HEADER_SIZE    (20)
+/** 認証タグサイズ */
+#define IO_CFILE_TAG_SIZE       (16)
+
+/** 暗号化時のチャンクサイズ（平文） */
+#ifndef IO_CFILE_CHUNK_SIZE
+    #define IO_CFILE_CHUNK_SIZE     (1024)
+#endif
+
+/** 復号時に許容する最大チャンクサイズ（平文） */
+#ifndef IO_CFILE_CHUNK_MAX
+    #define IO_CFILE_CHUNK_MAX      (16384)
+#endif
+
+/******************************************************************************/
+/***      Type Definitions                                                  ***/
+/******************************************************************************/
+/** 構造体：暗号化ファイルの読み込みコンテキスト */
+typedef struct {
+    FILE* ps_file;                                  // 対象ファイル
+    ts_crypto_gcm_context_t s_gcm_ctx;              // GCMコンテキスト（鍵スケジュール展開済み）
+    uint8_t u8_aad[IO_CFILE_HEADER_SIZE + 1];       // 追加認証データ（ヘッダ＋最終チャンクフラグ）
+    long l_base_pos;                                // ヘッダの位置（シーク不可の場合は負数）
+    uint32_t u32_chunk_size;                        // チャンクサイズ（平文）
+} ts_cfile_reader_t;
+
+/******************************************************************************/
+/***      Exported Variables                                                ***/
+/******************************************************************************/
+
+/******************************************************************************/
+/***      Exported Functions                                                ***/
+/******************************************************************************/
+/** ストリームの暗号化 */
+extern esp_err_t sts_cfile_encrypt(FILE* ps_src, FILE* ps_dst, const uint8_t* pu8_key, size_t t_key_len);
+/** ストリームの復号（全チャンクの認証タグ検証） */
+extern esp_err_t sts_cfile_decrypt(FILE* ps_src, FILE* ps_dst, const uint8_t* pu8_key, size_t t_key_len);
+/** 読み込みコンテキストの初期化（ヘッダの検証） */
+extern esp_err_t sts_cfile_reader_open(ts_cfile_reader_t* ps_reader, FILE* ps_file,
+                                       const uint8_t* pu8_key, size_t t_key_len);
+/** 任意チャンクの読み込み（認証タグ検証） */
+extern esp_err_t sts_cfile_read_chunk(ts_cfile_reader_t* ps_reader, uint32_t u32_idx,
+                                      uint8_t* pu8_buff, size_t* pt_len);
+/** 読み込みコンテキストの解放 */
+extern void v_cfile_reader_close(ts_cfile_reader_t* ps_reader);
+
+#if defined __cplusplus
+}
+#endif
+
+#endif /* __NTFW_IO_CRYPTO_FILE_H__ */
+
+/******************************************************************************/
+/***      END OF FILE                                                       ***/
+/******************************************************************************/
@@ -0,0 +1,474 @@
+/*******************************************************************************
+ *
+ * COMPONENT:Nano Toolkit Framework
+ *
+ * MODULE :Encrypted File Utility functions source file
+ *
+ * CREATED:2024/11/19 21:00:00
+ * AUTHOR :Kakuheiki.Nakanohito
+ *
+ * DESCRIPTION:チャンク分割した認証付き暗号（AES-GCM）ファイルのストリーム処理
+ *   ファイル全体をメモリに展開せず、チャンクサイズのバッファのみで暗号化と復号を行う
+ *
+ * CHANGE HISTORY:
+ *
+ * LAST MODIFIED BY:
+ *
+ *******************************************************************************
+ *
+ * Copyright (c) 2024 Kakuheiki.Nakanohito
+ * Released under the MIT license
+ * https://opensource.org/licenses/mit-license.php
+ *
+ ******************************************************************************/
+
+/******************************************************************************/
+/***      Include files                                                     ***/
+/******************************************************************************/
+#include "ntfw_io_crypto_file.h"
+
+#include <string.h>
+#include <limits.h>
+#include "ntfw_com_mem_alloc.h"
+
+/******************************************************************************/
+/***      Macro Definitions                                                 ***/
+/******************************************************************************/
+/** ファイル形式のバージョン */
+#define IO_CFILE_VERSION        (0x01)
+/** 初期ベクトルサイズ */
+#define IO_CFILE_IV_SIZE        (12)
+/** ナンスプレフィックスの位置 */
+#define IO_CFILE_PREFIX_POS     (12)
+/** ナンスプレフィックスサイズ */
+#define IO_CFILE_PREFIX_SIZE    (8)
+/** 最終チャンクフラグの位置（追加認証データ） */
+#define IO_CFILE_FINAL_POS      (IO_CFILE_HEADER_SIZE)
+
+/******************************************************************************/
+/***      Type Definitions                                                  ***/
+/******************************************************************************/
+
+/******************************************************************************/
+/***      Exported Variables                                                ***/
+/******************************************************************************/
+
+/******************************************************************************/
+/***      Local Variables                                                   ***/
+/******************************************************************************/
+/** マジックナンバー */
+static const uint8_t s_u8_magic[4] = {'N', 'T', 'C', 'F'};
+
+/******************************************************************************/
+/***      Local Function Prototypes                                         ***/
+/******************************************************************************/
+/** チャンクの初期ベクトルの編集 */
+static void v_chunk_iv(uint8_t* pu8_iv, const uint8_t* pu8_header, uint32_t u32_idx);
+/** 現在位置のチャンクの読み込み（認証タグ検証） */
+static esp_err_t sts_chunk_read(ts_cfile_reader_t* ps_reader, uint32_t u32_idx,
+                                uint8_t* pu8_buff, size_t* pt_len);
+
+/******************************************************************************/
+/***      Exported Functions                                                ***/
+/******************************************************************************/
+
+/*******************************************************************************
+ *
+ * NAME: sts_cfile_encrypt
+ *
+ * DESCRIPTION:ストリームの暗号化
+ *
+ * PARAMETERS:      Name            RW  Usage
+ * FILE*            ps_src          R   平文の入力ストリーム
+ * FILE*            ps_dst          W   暗号化ファイルの出力ストリーム
+ * const uint8_t*   pu8_key         R   共通鍵
+ * size_t           t_key_len       R   共通鍵サイズ（16/24/32byte）
+ *
+ * RETURNS:
+ *   esp_err_t:結果ステータス
+ *
+ * NOTES:
+ * 入力ストリームの終端まで、IO_CFILE_CHUNK_SIZE単位で暗号化して出力する
+ ******************************************************************************/
+esp_err_t sts_cfile_encrypt(FILE* ps_src, FILE* ps_dst, const uint8_t* pu8_key, size_t t_key_len) {
+    // 入力チェック
+    if (ps_src == NULL || ps_dst == NULL || pu8_key == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    //==========================================================================
+    // ヘッダの生成
+    //==========================================================================
+    uint8_t u8_aad[IO_CFILE_HEADER_SIZE + 1] = {0x00};
+    memcpy(u8_aad, s_u8_magic, sizeof(s_u8_magic));
+    u8_aad[4]  = IO_CFILE_VERSION;
+    u8_aad[5]  = IO_CFILE_TAG_SIZE;
+    u8_aad[8]  = (uint8_t)(IO_CFILE_CHUNK_SIZE >> 24);
+    u8_aad[9]  = (uint8_t)(IO_CFILE_CHUNK_SIZE >> 16);
+    u8_aad[10] = (uint8_t)(IO_CFILE_CHUNK_SIZE >> 8);
+    u8_aad[11] = (uint8_t)IO_CFILE_CHUNK_SIZE;
+    esp_err_t sts_val = sts_crypto_random_fill(&u8_aad[IO_CFILE_PREFIX_POS], IO_CFILE_PREFIX_SIZE);
+    if (sts_val != ESP_OK) {
+        return sts_val;
+    }
+    //==========================================================================
+    // GCMコンテキストとバッファの生成
+    //==========================================================================
+    ts_crypto_gcm_context_t s_gcm_ctx;
+    sts_val = sts_crypto_gcm_init(&s_gcm_ctx, pu8_key, t_key_len);
+    if (sts_val != ESP_OK) {
+        return sts_val;
+    }
+    uint8_t* pu8_buff = pv_mem_malloc(IO_CFILE_CHUNK_SIZE);
+    if (pu8_buff == NULL) {
+        v_crypto_gcm_free(&s_gcm_ctx);
+        return ESP_ERR_NO_MEM;
+    }
+    //==========================================================================
+    // チャンク単位の暗号化
+    //==========================================================================
+    uint8_t u8_iv[IO_CFILE_IV_SIZE];
+    uint8_t u8_tag[IO_CFILE_TAG_SIZE];
+    uint32_t u32_idx = 0;
+    do {
+        // ヘッダの書き込み
+        if (fwrite(u8_aad, 1, IO_CFILE_HEADER_SIZE, ps_dst) != IO_CFILE_HEADER_SIZE) {
+            sts_val = ESP_FAIL;
+            break;
+        }
+        while (true) {
+            // 平文の読み込み
+            size_t t_len = fread(pu8_buff, 1, IO_CFILE_CHUNK_SIZE, ps_src);
+            if (ferror(ps_src)) {
+                sts_val = ESP_FAIL;
+                break;
+            }
+            // チャンクサイズ未満を最終チャンクとする
+            bool b_final = (t_len < IO_CFILE_CHUNK_SIZE);
+            u8_aad[IO_CFILE_FINAL_POS] = b_final ? 0x01 : 0x00;
+            v_chunk_iv(u8_iv, u8_aad, u32_idx);
+            sts_val = sts_crypto_gcm_enc_in_place(&s_gcm_ctx, u8_iv, sizeof(u8_iv),
+                                                  u8_aad, sizeof(u8_aad),
+                                                  pu8_buff, t_len, u8_tag, sizeof(u8_tag));
+            if (sts_val != ESP_OK) {
+                break;
+            }
+            // 暗号文と認証タグの書き込み
+            if (fwrite(pu8_buff, 1, t_len, ps_dst) != t_len ||
+                fwrite(u8_tag, 1, sizeof(u8_tag), ps_dst) != sizeof(u8_tag)) {
+                sts_val = ESP_FAIL;
+                break;
+            }
+            if (b_final) {
+                break;
+            }
+            // チャンク番号（初期ベクトル）の枯渇
+            if (u32_idx == UINT32_MAX) {
+                sts_val = ESP_ERR_INVALID_SIZE;
+                break;
+            }
+            u32_idx++;
+        }
+    } while(false);
+    //==========================================================================
+    // 後処理
+    //==========================================================================
+    memset(pu8_buff, 0x00, IO_CFILE_CHUNK_SIZE);
+    l_mem_free(pu8_buff);
+    v_crypto_gcm_free(&s_gcm_ctx);
+    // 結果返信
+    return sts_val;
+}
+
+/*******************************************************************************
+ *
+ * NAME: sts_cfile_decrypt
+ *
+ * DESCRIPTION:ストリームの復号（全チャンクの認証タグ検証）
+ *
+ * PARAMETERS:      Name            RW  Usage
+ * FILE*            ps_src          R   暗号化ファイルの入力ストリーム
+ * FILE*            ps_dst          W   平文の出力ストリーム
+ * const uint8_t*   pu8_key         R   共通鍵
+ * size_t           t_key_len       R   共通鍵サイズ（16/24/32byte）
+ *
+ * RETURNS:
+ *   esp_err_t:結果ステータス
+ *     ESP_ERR_INVALID_RESPONSE:認証タグの不一致（改竄、チャンクの入れ替え）
+ *     ESP_ERR_INVALID_SIZE    :ファイルの切り詰め、又は最終チャンク以降のデータ
+ *
+ * NOTES:
+ * 出力済みのデータは検証済みのチャンクのみだが、エラー時は出力全体を破棄する事
+ ******************************************************************************/
+esp_err_t sts_cfile_decrypt(FILE* ps_src, FILE* ps_dst, const uint8_t* pu8_key, size_t t_key_len) {
+    // 入力チェック
+    if (ps_dst == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    // 読み込みコンテキストの初期化
+    ts_cfile_reader_t s_reader;
+    esp_err_t sts_val = sts_cfile_reader_open(&s_reader, ps_src, pu8_key, t_key_len);
+    if (sts_val != ESP_OK) {
+        return sts_val;
+    }
+    uint8_t* pu8_buff = pv_mem_malloc(s_reader.u32_chunk_size);
+    if (pu8_buff == NULL) {
+        v_cfile_reader_close(&s_reader);
+        return ESP_ERR_NO_MEM;
+    }
+    //==========================================================================
+    // チャンク単位の復号
+    //==========================================================================
+    size_t t_len;
+    uint32_t u32_idx = 0;
+    while (true) {
+        sts_val = sts_chunk_read(&s_reader, u32_idx, pu8_buff, &t_len);
+        if (sts_val != ESP_OK) {
+            // チャンク境界での途切れは切り詰め
+            if (sts_val == ESP_ERR_NOT_FOUND) {
+                sts_val = ESP_ERR_INVALID_SIZE;
+            }
+            break;
+        }
+        if (fwrite(pu8_buff, 1, t_len, ps_dst) != t_len) {
+            sts_val = ESP_FAIL;
+            break;
+        }
+        // 最終チャンク
+        if (t_len < s_reader.u32_chunk_size) {
+            if (fgetc(ps_src) != EOF) {
+                sts_val = ESP_ERR_INVALID_SIZE;
+            }
+            break;
+        }
+        if (u32_idx == UINT32_MAX) {
+            sts_val = ESP_ERR_INVALID_SIZE;
+            break;
+        }
+        u32_idx++;
+    }
+    //==========================================================================
+    // 後処理
+    //==========================================================================
+    memset(pu8_buff, 0x00, s_reader.u32_chunk_size);
+    l_mem_free(pu8_buff);
+    v_cfile_reader_close(&s_reader);
+    // 結果返信
+    return sts_val;
+}
+
+/*******************************************************************************
+ *
+ * NAME: sts_cfile_reader_open
+ *
+ * DESCRIPTION:読み込みコンテキストの初期化（ヘッダの検証）
+ *
+ * PARAMETERS:          Name            RW  Usage
+ * ts_cfile_reader_t*   ps_reader       W   読み込みコンテキスト
+ * FILE*                ps_file         R   暗号化ファイル（現在位置がヘッダの先頭）
+ * const uint8_t*       pu8_key         R   共通鍵
+ * size_t               t_key_len       R   共通鍵サイズ（16/24/32byte）
+ *
+ * RETURNS:
+ *   esp_err_t:結果ステータス、ファイル形式の不一致はESP_ERR_INVALID_VERSION
+ *
+ * NOTES:
+ * 利用後はv_cfile_reader_closeで解放する事（ファイルはクローズしない）
+ ******************************************************************************/
+esp_err_t sts_cfile_reader_open(ts_cfile_reader_t* ps_reader, FILE* ps_file,
+                                const uint8_t* pu8_key, size_t t_key_len) {
+    // 入力チェック
+    if (ps_reader == NULL || ps_file == NULL || pu8_key == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    //==========================================================================
+    // ヘッダの読み込みと検証
+    //==========================================================================
+    uint8_t* pu8_header = ps_reader->u8_aad;
+    if (fread(pu8_header, 1, IO_CFILE_HEADER_SIZE, ps_file) != IO_CFILE_HEADER_SIZE) {
+        return ferror(ps_file) ? ESP_FAIL : ESP_ERR_INVALID_SIZE;
+    }
+    if (memcmp(pu8_header, s_u8_magic, sizeof(s_u8_magic)) != 0 ||
+        pu8_header[4] != IO_CFILE_VERSION || pu8_header[5] != IO_CFILE_TAG_SIZE ||
+        pu8_header[6] != 0x00 || pu8_header[7] != 0x00) {
+        return ESP_ERR_INVALID_VERSION;
+    }
+    uint32_t u32_chunk_size = ((uint32_t)pu8_header[8] << 24) | ((uint32_t)pu8_header[9] << 16) |
+                              ((uint32_t)pu8_header[10] << 8) | (uint32_t)pu8_header[11];
+    if (u32_chunk_size < IO_CFILE_TAG_SIZE || u32_chunk_size > IO_CFILE_CHUNK_MAX) {
+        return ESP_ERR_INVALID_VERSION;
+    }
+    //==========================================================================
+    // コンテキストの編集
+    //==========================================================================
+    esp_err_t sts_val = sts_crypto_gcm_init(&ps_reader->s_gcm_ctx, pu8_key, t_key_len);
+    if (sts_val != ESP_OK) {
+        return sts_val;
+    }
+    ps_reader->ps_file = ps_file;
+    ps_reader->l_base_pos = ftell(ps_file);
+    if (ps_reader->l_base_pos >= 0) {
+        ps_reader->l_base_pos -= IO_CFILE_HEADER_SIZE;
+    }
+    ps_reader->u32_chunk_size = u32_chunk_size;
+    // 結果返信
+    return ESP_OK;
+}
+
+/*******************************************************************************
+ *
+ * NAME: sts_cfile_read_chunk
+ *
+ * DESCRIPTION:任意チャンクの読み込み（認証タグ検証）
+ *
+ * PARAMETERS:          Name            RW  Usage
+ * ts_cfile_reader_t*   ps_reader       RW  読み込みコンテキスト
+ * uint32_t             u32_idx         R   チャンク番号
+ * uint8_t*             pu8_buff        W   平文（u32_chunk_sizeのサイズ以上）
+ * size_t*              pt_len          W   平文サイズ
+ *
+ * RETURNS:
+ *   esp_err_t:結果ステータス
+ *     ESP_ERR_NOT_FOUND       :チャンク番号が範囲外
+ *     ESP_ERR_INVALID_RESPONSE:認証タグの不一致
+ *
+ * NOTES:
+ * 平文サイズがu32_chunk_size未満の場合は最終チャンク
+ ******************************************************************************/
+esp_err_t sts_cfile_read_chunk(ts_cfile_reader_t* ps_reader, uint32_t u32_idx,
+                               uint8_t* pu8_buff, size_t* pt_len) {
+    // 入力チェック
+    if (ps_reader == NULL || pu8_buff == NULL || pt_len == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    // シークできないストリーム
+    if (ps_reader->l_base_pos < 0) {
+        return ESP_ERR_NOT_SUPPORTED;
+    }
+    // チャンク位置へのシーク
+    uint64_t u64_pos = (uint64_t)ps_reader->l_base_pos + IO_CFILE_HEADER_SIZE +
+                       (uint64_t)u32_idx * (ps_reader->u32_chunk_size + IO_CFILE_TAG_SIZE);
+    if (u64_pos > LONG_MAX) {
+        return ESP_ERR_NOT_FOUND;
+    }
+    if (fseek(ps_reader->ps_file, (long)u64_pos, SEEK_SET) != 0) {
+        return ESP_FAIL;
+    }
+    // チャンクの読み込み
+    return sts_chunk_read(ps_reader, u32_idx, pu8_buff, pt_len);
+}
+
+/*******************************************************************************
+ *
+ * NAME: v_cfile_reader_close
+ *
+ * DESCRIPTION:読み込みコンテキストの解放
+ *
+ * PARAMETERS:          Name            RW  Usage
+ * ts_cfile_reader_t*   ps_reader       RW  読み込みコンテキスト
+ *
+ * RETURNS:
+ *
+ ******************************************************************************/
+void v_cfile_reader_close(ts_cfile_reader_t* ps_reader) {
+    // 入力チェック
+    if (ps_reader == NULL) {
+        return;
+    }
+    v_crypto_gcm_free(&ps_reader->s_gcm_ctx);
+    ps_reader->ps_file = NULL;
+}
+
+/******************************************************************************/
+/***      Local Functions                                                   ***/
+/******************************************************************************/
+
+/*******************************************************************************
+ *
+ * NAME: v_chunk_iv
+ *
+ * DESCRIPTION:チャンクの初期ベクトルの編集
+ *
+ * PARAMETERS:      Name            RW  Usage
+ * uint8_t*         pu8_iv          W   初期ベクトル（12byte）
+ * const uint8_t*   pu8_header      R   ファイルヘッダ
+ * uint32_t         u32_idx         R   チャンク番号
+ *
+ * RETURNS:
+ *
+ ******************************************************************************/
+static void v_chunk_iv(uint8_t* pu8_iv, const uint8_t* pu8_header, uint32_t u32_idx) {
+    memcpy(pu8_iv, &pu8_header[IO_CFILE_PREFIX_POS], IO_CFILE_PREFIX_SIZE);
+    pu8_iv[8]  = (uint8_t)(u32_idx >> 24);
+    pu8_iv[9]  = (uint8_t)(u32_idx >> 16);
+    pu8_iv[10] = (uint8_t)(u32_idx >> 8);
+    pu8_iv[11] = (uint8_t)u32_idx;
+}
+
+/*******************************************************************************
+ *
+ * NAME: sts_chunk_read
+ *
+ * DESCRIPTION:現在位置のチャンクの読み込み（認証タグ検証）
+ *
+ * PARAMETERS:          Name            RW  Usage
+ * ts_cfile_reader_t*   ps_reader       RW  読み込みコンテキスト
+ * uint32_t             u32_idx         R   チャンク番号
+ * uint8_t*             pu8_buff        W   平文（u32_chunk_sizeのサイズ以上）
+ * size_t*              pt_len          W   平文サイズ
+ *
+ * RETURNS:
+ *   esp_err_t:結果ステータス
+ *
+ * NOTES:
+ * 暗号文をバッファに、後続の認証タグをローカル領域に読み込み、
+ * 最終チャンクの場合はバッファ末尾の認証タグ部分を移し替える
+ ******************************************************************************/
+static esp_err_t sts_chunk_read(ts_cfile_reader_t* ps_reader, uint32_t u32_idx,
+                                uint8_t* pu8_buff, size_t* pt_len) {
+    //==========================================================================
+    // 暗号文と認証タグの読み込み
+    //==========================================================================
+    FILE* ps_file = ps_reader->ps_file;
+    uint32_t u32_chunk_size = ps_reader->u32_chunk_size;
+    uint8_t u8_tag[IO_CFILE_TAG_SIZE];
+    size_t t_len = fread(pu8_buff, 1, u32_chunk_size, ps_file);
+    size_t t_tag_len = 0;
+    if (t_len == u32_chunk_size) {
+        t_tag_len = fread(u8_tag, 1, IO_CFILE_TAG_SIZE, ps_file);
+    }
+    if (ferror(ps_file)) {
+        return ESP_FAIL;
+    }
+    if (t_len + t_tag_len == 0) {
+        return ESP_ERR_NOT_FOUND;
+    }
+    // 認証タグの不足分をバッファ末尾から移し替え
+    if (t_tag_len < IO_CFILE_TAG_SIZE) {
+        size_t t_need = IO_CFILE_TAG_SIZE - t_tag_len;
+        if (t_len < t_need) {
+            return ESP_ERR_INVALID_SIZE;
+        }
+        memmove(&u8_tag[t_need], u8_tag, t_tag_len);
+        memcpy(u8_tag, &pu8_buff[t_len - t_need], t_need);
+        t_len -= t_need;
+    }
+    //==========================================================================
+    // 復号と認証タグの検証
+    //==========================================================================
+    uint8_t u8_iv[IO_CFILE_IV_SIZE];
+    v_chunk_iv(u8_iv, ps_reader->u8_aad, u32_idx);
+    ps_reader->u8_aad[IO_CFILE_FINAL_POS] = (t_len < u32_chunk_size) ? 0x01 : 0x00;
+    esp_err_t sts_val = sts_crypto_gcm_dec_in_place(&ps_reader->s_gcm_ctx, u8_iv, sizeof(u8_iv),
+                                                    ps_reader->u8_aad, sizeof(ps_reader->u8_aad),
+                                                    pu8_buff, t_len, u8_tag, sizeof(u8_tag));
+    if (sts_val != ESP_OK) {
+        return sts_val;
+    }
+    *pt_len = t_len;
+    // 結果返信
+    return ESP_OK;
+}
+
+/******************************************************************************/
+/***      END OF FILE                                                       ***/
+/******************************************************************************/
@@ -83,6 +83,7 @@
 #include <freertos/FreeRTOS.h>
 #include "ntfw_com_date_time.h"
 #include "ntfw_com_value_util.h"
+#include "ntfw_com_debug_util.h"
 
 /******************************************************************************/
 /***      Macro Definitions                                                 ***/
@@ -596,6 +597,7 @@ esp_err_t sts_io_i2c_mst_read_stop(uint8_t* pu8_data, size_t t_data_len) {
 
     // 結果ステータス
     esp_err_t sts_val = ESP_OK;
+    PROF_BEGIN(DBG_PROF_SITE_I2C_READ_STOP);
     do {
         //======================================================================
         // チェック
@@ -649,6 +651,7 @@ esp_err_t sts_io_i2c_mst_read_stop(uint8_t* pu8_data, size_t t_data_len) {
         s_queue_info.b_order_flg[COM_I2C_MST_READ]  = false;
         s_queue_info.b_order_flg[COM_I2C_MST_WRITE] = false;
     } while(false);
+    PROF_END(DBG_PROF_SITE_I2C_READ_STOP);
 
     //==========================================================================
     // クリティカルセクション終了 ※開始はスタートに記述
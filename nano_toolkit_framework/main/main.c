@@ -60,7 +60,9 @@
 #include "ntfw_com_date_time.h"
 #include "ntfw_com_debug_util.h"
 #include "ntfw_cryptography.h"
+#include "ntfw_crypto_sha256.h"
 #include "ntfw_io_file_util.h"
+#include "ntfw_io_crypto_file.h"
 #include "ntfw_io_gpio_util.h"
 #include "ntfw_io_i2c_master.h"
 #include "ntfw_io_touchpad_fmwk.h"
@@ -140,6 +142,14 @@ static void v_task_chk_cryptography_03();
 static void v_task_chk_cryptography_04();
 static void v_task_chk_cryptography_05();
 static void v_task_chk_cryptography_06();
+static void v_task_chk_cryptography_07();
+static void v_task_chk_cryptography_08();
+static void v_task_chk_cryptography_09();
+static void v_task_chk_cryptography_10();
+static size_t t_task_chk_hex_to_bytes(const char* pc_hex, uint8_t* pu8_out);
+static bool b_task_chk_kat(const char* pc_name, const uint8_t* pu8_act, size_t t_len, const char* pc_exp_hex);
+static bool b_task_chk_kat_bool(const char* pc_name, bool b_result);
+static void v_task_chk_bench_disp(const char* pc_name, uint32_t u32_len, uint32_t u32_loop_cnt, int64_t i64_us);
 
 /** ADC Test Code */
 static void v_task_chk_adc(void* args);
@@ -155,6 +165,7 @@ static void v_task_chk_file_util_00();
 static void v_task_chk_file_util_01();
 static void v_task_chk_file_util_02(sdmmc_card_t* ps_card);
 static void v_task_chk_file_util_03();
+static void v_task_chk_file_util_04();
 /** Common Date Time Test Code */
 static void v_task_chk_com_date_time(void* args);
 static void v_task_chk_com_date_time_00();
@@ -1856,6 +1867,22 @@ static void v_task_chk_cryptography(void* args) {
     // 共通鍵共有(ECDH)
     //==========================================================================
     v_task_chk_cryptography_06();
+    //==========================================================================
+    // メッセージ認証モードのベンチマーク
+    //==========================================================================
+    v_task_chk_cryptography_07();
+    //==========================================================================
+    // 暗号スイートのベンチマーク(AES-256-GCM/ChaCha20-Poly1305)
+    //==========================================================================
+    v_task_chk_cryptography_08();
+    //==========================================================================
+    // 既知解テスト
+    //==========================================================================
+    v_task_chk_cryptography_09();
+    //==========================================================================
+    // アルゴリズム毎のベンチマーク
+    //==========================================================================
+    v_task_chk_cryptography_10();
 }
 
 /*******************************************************************************
@@ -1914,7 +1941,35 @@ static void v_task_chk_cryptography_00() {
     } else {
         ESP_LOGE(TAG, "sts_crypto_delete_key=ERR!");
     }
-    //
+    //==========================================================================
+    // 一括生成（6桁のチェックコード×16）と文字の出現頻度
+    //==========================================================================
+    uint8_t u8_codes[6 * 16];
+    uint32_t u32_hist[10] = {0};
+    uint32_t u32_round;
+    bool b_valid = true;
+    for (u32_round = 0; u32_round < 64 && b_valid; u32_round++) {
+        if (sts_crypto_random_charset(STR_DEC_NUMBER, u8_codes, sizeof(u8_codes)) != ESP_OK) {
+            b_valid = false;
+            break;
+        }
+        for (u32_col_idx = 0; u32_col_idx < sizeof(u8_codes); u32_col_idx++) {
+            if (u8_codes[u32_col_idx] < '0' || u8_codes[u32_col_idx] > '9') {
+                b_valid = false;
+                break;
+            }
+            u32_hist[u8_codes[u32_col_idx] - '0']++;
+        }
+    }
+    // 期待値（614）から±30%以内
+    for (u32_ch_idx = 0; u32_ch_idx < 10 && b_valid; u32_ch_idx++) {
+        b_valid = (u32_hist[u32_ch_idx] > 430 && u32_hist[u32_ch_idx] < 800);
+    }
+    if (b_valid) {
+        ESP_LOGI(TAG, "sts_crypto_random_charset=OK! code=%.6s", (char*)u8_codes);
+    } else {
+        ESP_LOGE(TAG, "sts_crypto_random_charset=ERR!");
+    }
 }
 
 /*******************************************************************************
@@ -2422,6 +2477,735 @@ static void v_task_chk_cryptography_06() {
 
 }
 
+/*******************************************************************************
+ *
+ * NAME: v_task_chk_cryptography_07
+ *
+ * DESCRIPTION:暗号処理のテストケース関数
+ * メッセージ認証モード毎の秒間処理メッセージ数
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * 互換モード（ハッシュストレッチング）とHMAC-SHA256の認証タグ生成を比較
+ ******************************************************************************/
+static void v_task_chk_cryptography_07() {
+    ESP_LOGI(TAG, "//===========================================================");
+    ESP_LOGI(TAG, "// TEST Message auth benchmark");
+    ESP_LOGI(TAG, "//===========================================================");
+    // 計測するメッセージ長
+    const uint32_t u32_msg_len[] = {64, 128, 256, 512};
+    // 計測回数
+    const uint32_t u32_loop_cnt = 200;
+    // 認証鍵
+    uint8_t u8_key[COM_MSG_SIZE_CIPHER_KEY];
+    b_vutil_set_u8_rand_array(u8_key, COM_MSG_SIZE_CIPHER_KEY);
+    // HMACコンテキスト
+    ts_crypto_hmac_context_t s_hmac_ctx;
+    if (sts_crypto_hmac_init(&s_hmac_ctx, CRYPTO_HASH_SHA256, u8_key, COM_MSG_SIZE_CIPHER_KEY) != ESP_OK) {
+        ESP_LOGE(TAG, "sts_crypto_hmac_init=ERR!");
+        return;
+    }
+    // 認証タグ
+    uint8_t u8_tag[COM_MSG_SIZE_AUTH_TAG];
+    uint32_t u32_len_idx;
+    uint32_t u32_cnt;
+    for (u32_len_idx = 0; u32_len_idx < sizeof(u32_msg_len) / sizeof(uint32_t); u32_len_idx++) {
+        // メッセージ生成
+        ts_u8_array_t* ps_msg = ps_mdl_empty_u8_array(u32_msg_len[u32_len_idx]);
+        if (ps_msg == NULL) {
+            ESP_LOGE(TAG, "ps_mdl_empty_u8_array=ERR!");
+            break;
+        }
+        b_vutil_set_u8_rand_array(ps_msg->pu8_values, ps_msg->t_size);
+        //----------------------------------------------------------------------
+        // 互換モード（ハッシュストレッチング）
+        //----------------------------------------------------------------------
+        int64_t i64_begin = esp_timer_get_time();
+        for (u32_cnt = 0; u32_cnt < u32_loop_cnt; u32_cnt++) {
+            if (sts_crypto_sha256(ps_msg, COM_MSG_AUTH_STRETCHING, u8_tag) != ESP_OK) {
+                ESP_LOGE(TAG, "sts_crypto_sha256=ERR!");
+                break;
+            }
+        }
+        int64_t i64_hash_us = esp_timer_get_time() - i64_begin;
+        //----------------------------------------------------------------------
+        // HMAC-SHA256
+        //----------------------------------------------------------------------
+        i64_begin = esp_timer_get_time();
+        for (u32_cnt = 0; u32_cnt < u32_loop_cnt; u32_cnt++) {
+            sts_crypto_hmac_update(&s_hmac_ctx, ps_msg->pu8_values, ps_msg->t_size);
+            if (sts_crypto_hmac_finish(&s_hmac_ctx, u8_tag) != ESP_OK) {
+                ESP_LOGE(TAG, "sts_crypto_hmac_finish=ERR!");
+                break;
+            }
+        }
+        int64_t i64_hmac_us = esp_timer_get_time() - i64_begin;
+        //----------------------------------------------------------------------
+        // 結果表示
+        //----------------------------------------------------------------------
+        ESP_LOGI(TAG, "len=%4lu hash=%6lu msg/s hmac=%6lu msg/s",
+                 (unsigned long)u32_msg_len[u32_len_idx],
+                 (unsigned long)((int64_t)u32_loop_cnt * 1000000 / (i64_hash_us > 0 ? i64_hash_us : 1)),
+                 (unsigned long)((int64_t)u32_loop_cnt * 1000000 / (i64_hmac_us > 0 ? i64_hmac_us : 1)));
+        // メッセージ解放
+        sts_mdl_delete_u8_array(ps_msg);
+    }
+    // HMACコンテキスト解放
+    v_crypto_hmac_free(&s_hmac_ctx);
+}
+
+/*******************************************************************************
+ *
+ * NAME: v_task_chk_cryptography_08
+ *
+ * DESCRIPTION:暗号処理のテストケース関数
+ * 暗号スイート毎のスループット
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * AES-256-GCM（鍵スケジュール展開済みコンテキスト）とChaCha20-Poly1305の
+ * インプレース暗号化を16B～2KBのメッセージ長で比較し、往復の復号結果も検証する
+ ******************************************************************************/
+static void v_task_chk_cryptography_08() {
+    ESP_LOGI(TAG, "//===========================================================");
+    ESP_LOGI(TAG, "// TEST Cipher suite benchmark");
+    ESP_LOGI(TAG, "//===========================================================");
+    // 計測するメッセージ長
+    const uint32_t u32_msg_len[] = {16, 64, 256, 512, 1024, 2048};
+    // 計測回数
+    const uint32_t u32_loop_cnt = 100;
+    // 共通鍵、IV、追加認証データ、認証タグ
+    uint8_t u8_key[CRYPTO_CHACHAPOLY_KEY_SIZE];
+    uint8_t u8_iv[CRYPTO_CHACHAPOLY_NONCE_SIZE];
+    uint8_t u8_add[16] = {0x00};
+    uint8_t u8_tag[CRYPTO_CHACHAPOLY_TAG_SIZE];
+    b_vutil_set_u8_rand_array(u8_key, sizeof(u8_key));
+    b_vutil_set_u8_rand_array(u8_iv, sizeof(u8_iv));
+    // GCMコンテキスト
+    ts_crypto_gcm_context_t s_gcm_ctx;
+    if (sts_crypto_gcm_init(&s_gcm_ctx, u8_key, sizeof(u8_key)) != ESP_OK) {
+        ESP_LOGE(TAG, "sts_crypto_gcm_init=ERR!");
+        v_crypto_gcm_free(&s_gcm_ctx);
+        return;
+    }
+    uint32_t u32_len_idx;
+    uint32_t u32_cnt;
+    for (u32_len_idx = 0; u32_len_idx < sizeof(u32_msg_len) / sizeof(uint32_t); u32_len_idx++) {
+        // メッセージ生成
+        uint32_t u32_len = u32_msg_len[u32_len_idx];
+        ts_u8_array_t* ps_plane = ps_mdl_empty_u8_array(u32_len);
+        ts_u8_array_t* ps_msg   = ps_mdl_empty_u8_array(u32_len);
+        if (ps_plane == NULL || ps_msg == NULL) {
+            ESP_LOGE(TAG, "ps_mdl_empty_u8_array=ERR!");
+            sts_mdl_delete_u8_array(ps_plane);
+            sts_mdl_delete_u8_array(ps_msg);
+            break;
+        }
+        b_vutil_set_u8_rand_array(ps_plane->pu8_values, u32_len);
+        memcpy(ps_msg->pu8_values, ps_plane->pu8_values, u32_len);
+        //----------------------------------------------------------------------
+        // AES-256-GCM
+        //----------------------------------------------------------------------
+        int64_t i64_begin = esp_timer_get_time();
+        for (u32_cnt = 0; u32_cnt < u32_loop_cnt; u32_cnt++) {
+            sts_crypto_gcm_enc_in_place(&s_gcm_ctx, u8_iv, sizeof(u8_iv), u8_add, sizeof(u8_add),
+                                        ps_msg->pu8_values, u32_len, u8_tag, sizeof(u8_tag));
+        }
+        int64_t i64_gcm_us = esp_timer_get_time() - i64_begin;
+        //----------------------------------------------------------------------
+        // ChaCha20-Poly1305
+        //----------------------------------------------------------------------
+        i64_begin = esp_timer_get_time();
+        for (u32_cnt = 0; u32_cnt < u32_loop_cnt; u32_cnt++) {
+            sts_crypto_chacha20_poly1305_enc_in_place(u8_key, u8_iv, u8_add, sizeof(u8_add),
+                                                      ps_msg->pu8_values, u32_len, u8_tag);
+        }
+        int64_t i64_chacha_us = esp_timer_get_time() - i64_begin;
+        //----------------------------------------------------------------------
+        // 往復の検証
+        //----------------------------------------------------------------------
+        bool b_gcm_ok = false;
+        bool b_chacha_ok = false;
+        memcpy(ps_msg->pu8_values, ps_plane->pu8_values, u32_len);
+        if (sts_crypto_gcm_enc_in_place(&s_gcm_ctx, u8_iv, sizeof(u8_iv), u8_add, sizeof(u8_add),
+                                        ps_msg->pu8_values, u32_len, u8_tag, sizeof(u8_tag)) == ESP_OK &&
+            sts_crypto_gcm_dec_in_place(&s_gcm_ctx, u8_iv, sizeof(u8_iv), u8_add, sizeof(u8_add),
+                                        ps_msg->pu8_values, u32_len, u8_tag, sizeof(u8_tag)) == ESP_OK) {
+            b_gcm_ok = (memcmp(ps_msg->pu8_values, ps_plane->pu8_values, u32_len) == 0);
+        }
+        if (sts_crypto_chacha20_poly1305_enc_in_place(u8_key, u8_iv, u8_add, sizeof(u8_add),
+                                                      ps_msg->pu8_values, u32_len, u8_tag) == ESP_OK &&
+            sts_crypto_chacha20_poly1305_dec_in_place(u8_key, u8_iv, u8_add, sizeof(u8_add),
+                                                      ps_msg->pu8_values, u32_len, u8_tag) == ESP_OK) {
+            b_chacha_ok = (memcmp(ps_msg->pu8_values, ps_plane->pu8_values, u32_len) == 0);
+        }
+        //----------------------------------------------------------------------
+        // 結果表示
+        //----------------------------------------------------------------------
+        ESP_LOGI(TAG, "len=%4lu gcm=%7lu KB/s(%s) chacha20-poly1305=%7lu KB/s(%s)",
+                 (unsigned long)u32_len,
+                 (unsigned long)((int64_t)u32_loop_cnt * u32_len * 1000000 / 1024 / (i64_gcm_us > 0 ? i64_gcm_us : 1)),
+                 b_gcm_ok ? "OK" : "NG",
+                 (unsigned long)((int64_t)u32_loop_cnt * u32_len * 1000000 / 1024 / (i64_chacha_us > 0 ? i64_chacha_us : 1)),
+                 b_chacha_ok ? "OK" : "NG");
+        // メッセージ解放
+        sts_mdl_delete_u8_array(ps_plane);
+        sts_mdl_delete_u8_array(ps_msg);
+    }
+    // GCMコンテキスト解放
+    v_crypto_gcm_free(&s_gcm_ctx);
+}
+
+/*******************************************************************************
+ *
+ * NAME: v_task_chk_cryptography_09
+ *
+ * DESCRIPTION:暗号処理のテストケース関数
+ * 既知解テスト（Known Answer Test）
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * 公開されたテストベクタ（FIPS 180、RFC 4231、FIPS 197、SP800-38A、
+ * GCM仕様書、RFC 7748）と照合し、NG件数を最後に表示する
+ ******************************************************************************/
+static void v_task_chk_cryptography_09() {
+    ESP_LOGI(TAG, "//===========================================================");
+    ESP_LOGI(TAG, "// TEST Crypto known answer test");
+    ESP_LOGI(TAG, "//===========================================================");
+    uint32_t u32_ng_cnt = 0;
+    uint8_t u8_key[CRYPTO_X25519_KEY_SIZE];
+    uint8_t u8_iv[AES_BLOCK_BYTES];
+    uint8_t u8_data[AES_BLOCK_BYTES];
+    uint8_t u8_out[CRYPTO_HASH_MAX_SIZE];
+    //==========================================================================
+    // SHA-1/SHA-2（FIPS 180 "abc"、ストレッチング）
+    //==========================================================================
+    ts_u8_array_t* ps_abc = ps_mdl_clone_u8_array((const uint8_t*)"abc", 3);
+    sts_crypto_sha1(ps_abc, 0, u8_out);
+    u32_ng_cnt += b_task_chk_kat("sha1", u8_out, 20,
+        "a9993e364706816aba3e25717850c26c9cd0d89d") ? 0 : 1;
+    sts_crypto_sha1(ps_abc, 2, u8_out);
+    u32_ng_cnt += b_task_chk_kat("sha1 stretching=2", u8_out, 20,
+        "65ba90ac47c0e09f83e6257ca0453aeb19df63cf") ? 0 : 1;
+    sts_crypto_sha224(ps_abc, 0, u8_out);
+    u32_ng_cnt += b_task_chk_kat("sha224", u8_out, 28,
+        "23097d223405d8228642a477bda255b32aadbce4bda0b3f7e36c9da7") ? 0 : 1;
+    sts_crypto_sha256(ps_abc, 0, u8_out);
+    u32_ng_cnt += b_task_chk_kat("sha256", u8_out, 32,
+        "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad") ? 0 : 1;
+    sts_crypto_sha256(ps_abc, 1, u8_out);
+    u32_ng_cnt += b_task_chk_kat("sha256 stretching=1", u8_out, 32,
+        "4f8b42c22dd3729b519ba6f68d2da7cc5b2d606d05daed5ad5128cc03e6c6358") ? 0 : 1;
+    sts_crypto_sha384(ps_abc, 0, u8_out);
+    u32_ng_cnt += b_task_chk_kat("sha384", u8_out, 48,
+        "cb00753f45a35e8bb5a03d699ac65007272c32ab0eded163"
+        "1a8b605a43ff5bed8086072ba1e7cc2358baeca134c825a7") ? 0 : 1;
+    sts_crypto_sha512(ps_abc, 0, u8_out);
+    u32_ng_cnt += b_task_chk_kat("sha512", u8_out, 64,
+        "ddaf35a193617abacc417349ae20413112e6fa4e89a97ea20a9eeee64b55d39a"
+        "2192992a274fc1a836ba3c23a3feebbd454d4423643ce80e2a9ac94fa54ca49f") ? 0 : 1;
+    // インクリメンタル（1バイト毎の更新）
+    ts_crypto_hash_context_t s_hash_ctx;
+    memset(u8_out, 0x00, sizeof(u8_out));
+    if (sts_crypto_hash_init(&s_hash_ctx, CRYPTO_HASH_SHA256) == ESP_OK) {
+        sts_crypto_hash_update(&s_hash_ctx, (const uint8_t*)"a", 1);
+        sts_crypto_hash_update(&s_hash_ctx, (const uint8_t*)"b", 1);
+        sts_crypto_hash_update(&s_hash_ctx, (const uint8_t*)"c", 1);
+        sts_crypto_hash_finish(&s_hash_ctx, u8_out);
+    }
+    v_crypto_hash_free(&s_hash_ctx);
+    u32_ng_cnt += b_task_chk_kat("sha256 incremental", u8_out, 32,
+        "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad") ? 0 : 1;
+    sts_mdl_delete_u8_array(ps_abc);
+
+    //==========================================================================
+    // HMAC（RFC 4231 Test Case 2）
+    //==========================================================================
+    const char* pc_hmac_key  = "Jefe";
+    const char* pc_hmac_data = "what do ya want for nothing?";
+    ts_u8_array_t* ps_hmac_key  = ps_mdl_clone_u8_array((const uint8_t*)pc_hmac_key, strlen(pc_hmac_key));
+    ts_u8_array_t* ps_hmac_data = ps_mdl_clone_u8_array((const uint8_t*)pc_hmac_data, strlen(pc_hmac_data));
+    memset(u8_out, 0x00, sizeof(u8_out));
+    sts_crypto_hmac(MBEDTLS_MD_SHA256, ps_hmac_key, ps_hmac_data, u8_out);
+    u32_ng_cnt += b_task_chk_kat("hmac-sha256", u8_out, 32,
+        "5bdcc146bf60754e6a042426089575c75a003f089d2739839dec58b964ec3843") ? 0 : 1;
+    memset(u8_out, 0x00, sizeof(u8_out));
+    sts_crypto_hmac(MBEDTLS_MD_SHA512, ps_hmac_key, ps_hmac_data, u8_out);
+    u32_ng_cnt += b_task_chk_kat("hmac-sha512", u8_out, 64,
+        "164b7a7bfcf819e2e395fbe73b56e0a387bd64222e831fd610270cd7ea250554"
+        "9758bf75c05a994a6d034f65f8f0e6fdcaeab1a34d4a6b4b636e070a38bce737") ? 0 : 1;
+    // インクリメンタル（鍵展開済みコンテキスト）
+    ts_crypto_hmac_context_t s_hmac_ctx;
+    memset(u8_out, 0x00, sizeof(u8_out));
+    if (sts_crypto_hmac_init(&s_hmac_ctx, CRYPTO_HASH_SHA256,
+                             ps_hmac_key->pu8_values, ps_hmac_key->t_size) == ESP_OK) {
+        sts_crypto_hmac_update(&s_hmac_ctx, ps_hmac_data->pu8_values, 10);
+        sts_crypto_hmac_update(&s_hmac_ctx, &ps_hmac_data->pu8_values[10], ps_hmac_data->t_size - 10);
+        sts_crypto_hmac_finish(&s_hmac_ctx, u8_out);
+    }
+    v_crypto_hmac_free(&s_hmac_ctx);
+    u32_ng_cnt += b_task_chk_kat("hmac-sha256 incremental", u8_out, 32,
+        "5bdcc146bf60754e6a042426089575c75a003f089d2739839dec58b964ec3843") ? 0 : 1;
+    sts_mdl_delete_u8_array(ps_hmac_key);
+    sts_mdl_delete_u8_array(ps_hmac_data);
+
+    //==========================================================================
+    // AES-256-ECB（FIPS 197 C.3）
+    //==========================================================================
+    t_task_chk_hex_to_bytes("000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f", u8_key);
+    t_task_chk_hex_to_bytes("00112233445566778899aabbccddeeff", u8_data);
+    ts_u8_array_t* ps_aes_key = ps_mdl_clone_u8_array(u8_key, AES_256_KEY_BYTES);
+    ts_u8_array_t* ps_plane   = ps_mdl_clone_u8_array(u8_data, AES_BLOCK_BYTES);
+    ts_u8_array_t* ps_cipher  = ps_crypto_aes_ecb_enc(ps_aes_key, ps_plane);
+    u32_ng_cnt += b_task_chk_kat("aes-256-ecb enc", (ps_cipher != NULL) ? ps_cipher->pu8_values : NULL,
+                                 AES_BLOCK_BYTES, "8ea2b7ca516745bfeafc49904b496089") ? 0 : 1;
+    ts_u8_array_t* ps_decrypt = (ps_cipher != NULL) ? ps_crypto_aes_ecb_dec(ps_aes_key, ps_cipher) : NULL;
+    u32_ng_cnt += b_task_chk_kat("aes-256-ecb dec", (ps_decrypt != NULL) ? ps_decrypt->pu8_values : NULL,
+                                 AES_BLOCK_BYTES, "00112233445566778899aabbccddeeff") ? 0 : 1;
+    sts_mdl_delete_u8_array(ps_aes_key);
+    sts_mdl_delete_u8_array(ps_plane);
+    sts_mdl_delete_u8_array(ps_cipher);
+    sts_mdl_delete_u8_array(ps_decrypt);
+
+    //==========================================================================
+    // AES-256-CBC（SP800-38A F.2.5）
+    //==========================================================================
+    t_task_chk_hex_to_bytes("603deb1015ca71be2b73aef0857d77811f352c073b6108d72d9810a30914dff4", u8_key);
+    t_task_chk_hex_to_bytes("000102030405060708090a0b0c0d0e0f", u8_iv);
+    t_task_chk_hex_to_bytes("6bc1bee22e409f96e93d7e117393172a", u8_data);
+    ts_crypto_keyset_t* ps_keyset = ps_crypto_create_keyset();
+    ps_keyset->ps_key    = ps_mdl_clone_u8_array(u8_key, AES_256_KEY_BYTES);
+    ps_keyset->ps_key_iv = ps_mdl_clone_u8_array(u8_iv, AES_BLOCK_BYTES);
+    ps_plane   = ps_mdl_clone_u8_array(u8_data, AES_BLOCK_BYTES);
+    ps_cipher  = ps_crypto_aes_cbc_enc(ps_keyset, ps_plane);
+    u32_ng_cnt += b_task_chk_kat("aes-256-cbc enc", (ps_cipher != NULL) ? ps_cipher->pu8_values : NULL,
+                                 AES_BLOCK_BYTES, "f58c4c04d6e5f1ba779eabfb5f7bfbd6") ? 0 : 1;
+    memcpy(ps_keyset->ps_key_iv->pu8_values, u8_iv, AES_BLOCK_BYTES);
+    ps_decrypt = (ps_cipher != NULL) ? ps_crypto_aes_cbc_dec(ps_keyset, ps_cipher) : NULL;
+    u32_ng_cnt += b_task_chk_kat("aes-256-cbc dec", (ps_decrypt != NULL) ? ps_decrypt->pu8_values : NULL,
+                                 AES_BLOCK_BYTES, "6bc1bee22e409f96e93d7e117393172a") ? 0 : 1;
+    sts_crypto_delete_keyset(ps_keyset);
+    sts_mdl_delete_u8_array(ps_plane);
+    sts_mdl_delete_u8_array(ps_cipher);
+    sts_mdl_delete_u8_array(ps_decrypt);
+
+    //==========================================================================
+    // AES-256-CTR（SP800-38A F.5.5）
+    //==========================================================================
+    t_task_chk_hex_to_bytes("f0f1f2f3f4f5f6f7f8f9fafbfcfdfeff", u8_iv);
+    uint8_t u8_stream[AES_BLOCK_BYTES];
+    size_t t_nc_off = 0;
+    ps_aes_key = ps_mdl_clone_u8_array(u8_key, AES_256_KEY_BYTES);
+    ps_plane   = ps_mdl_clone_u8_array(u8_data, AES_BLOCK_BYTES);
+    ps_cipher  = ps_crypto_aes_ctr(ps_aes_key, &t_nc_off, u8_iv, u8_stream, ps_plane);
+    u32_ng_cnt += b_task_chk_kat("aes-256-ctr", (ps_cipher != NULL) ? ps_cipher->pu8_values : NULL,
+                                 AES_BLOCK_BYTES, "601ec313775789a5b7a7f504bbf3d228") ? 0 : 1;
+    sts_mdl_delete_u8_array(ps_aes_key);
+    sts_mdl_delete_u8_array(ps_plane);
+    sts_mdl_delete_u8_array(ps_cipher);
+
+    //==========================================================================
+    // AES-256-GCM（GCM仕様書 Test Case 14）
+    //==========================================================================
+    memset(u8_key, 0x00, sizeof(u8_key));
+    memset(u8_iv, 0x00, sizeof(u8_iv));
+    memset(u8_data, 0x00, sizeof(u8_data));
+    uint8_t u8_tag[AES_BLOCK_BYTES];
+    sts_crypto_aes_gcm_enc_in_place(u8_key, AES_256_KEY_BYTES, u8_iv, 12, NULL, 0,
+                                    u8_data, sizeof(u8_data), u8_tag, sizeof(u8_tag));
+    u32_ng_cnt += b_task_chk_kat("aes-256-gcm enc", u8_data, AES_BLOCK_BYTES,
+        "cea7403d4d606b6e074ec5d3baf39d18") ? 0 : 1;
+    u32_ng_cnt += b_task_chk_kat("aes-256-gcm tag", u8_tag, AES_BLOCK_BYTES,
+        "d0d1c8a799996bf0265b98b5d48ab919") ? 0 : 1;
+    // 改ざん検出
+    u8_tag[0] ^= 0x01;
+    bool b_reject = (sts_crypto_aes_gcm_dec_in_place(u8_key, AES_256_KEY_BYTES, u8_iv, 12, NULL, 0,
+                                                     u8_data, sizeof(u8_data), u8_tag, sizeof(u8_tag)) == ESP_ERR_INVALID_RESPONSE);
+    u32_ng_cnt += b_task_chk_kat_bool("aes-256-gcm tamper", b_reject) ? 0 : 1;
+    u8_tag[0] ^= 0x01;
+    sts_crypto_aes_gcm_dec_in_place(u8_key, AES_256_KEY_BYTES, u8_iv, 12, NULL, 0,
+                                    u8_data, sizeof(u8_data), u8_tag, sizeof(u8_tag));
+    u32_ng_cnt += b_task_chk_kat("aes-256-gcm dec", u8_data, AES_BLOCK_BYTES,
+        "00000000000000000000000000000000") ? 0 : 1;
+
+    //==========================================================================
+    // PKCS#7パディング
+    //==========================================================================
+    memset(u8_data, 0xA5, sizeof(u8_data));
+    ps_plane = ps_mdl_clone_u8_array(u8_data, 13);
+    ts_u8_array_t* ps_padded = ps_crypto_pkcs7_padding(ps_plane, AES_BLOCK_BYTES);
+    u32_ng_cnt += b_task_chk_kat("pkcs7 padding(13)", (ps_padded != NULL) ? ps_padded->pu8_values : NULL,
+                                 AES_BLOCK_BYTES, "a5a5a5a5a5a5a5a5a5a5a5a5a5030303") ? 0 : 1;
+    ts_u8_array_t* ps_unpadded = (ps_padded != NULL) ? ps_crypto_pkcs7_unpadding(ps_padded, AES_BLOCK_BYTES) : NULL;
+    u32_ng_cnt += b_task_chk_kat_bool("pkcs7 unpadding(13)",
+                                      (ps_unpadded != NULL && ps_unpadded->t_size == 13 &&
+                                       memcmp(ps_unpadded->pu8_values, u8_data, 13) == 0)) ? 0 : 1;
+    sts_mdl_delete_u8_array(ps_plane);
+    sts_mdl_delete_u8_array(ps_padded);
+    sts_mdl_delete_u8_array(ps_unpadded);
+    // ブロック長ちょうどの場合は1ブロック追加
+    ps_plane  = ps_mdl_clone_u8_array(u8_data, AES_BLOCK_BYTES);
+    ps_padded = ps_crypto_pkcs7_padding(ps_plane, AES_BLOCK_BYTES);
+    u32_ng_cnt += b_task_chk_kat("pkcs7 padding(16)",
+                                 (ps_padded != NULL && ps_padded->t_size == AES_BLOCK_BYTES * 2) ?
+                                 &ps_padded->pu8_values[AES_BLOCK_BYTES] : NULL,
+                                 AES_BLOCK_BYTES, "10101010101010101010101010101010") ? 0 : 1;
+    sts_mdl_delete_u8_array(ps_plane);
+    sts_mdl_delete_u8_array(ps_padded);
+
+    //==========================================================================
+    // X25519（RFC 7748 6.1）
+    //==========================================================================
+    uint8_t u8_svr_pub_key[CRYPTO_X25519_SERVER_PUBLIC_KEY_SIZE];
+    ts_crypto_x25519_context_t* ps_client_ctx = ps_crypto_x25519_client_context();
+    if (ps_client_ctx != NULL) {
+        // Aliceの秘密鍵とBobの公開鍵で共有鍵を算出
+        t_task_chk_hex_to_bytes("77076d0a7318a57d3c16c17251b26645df4c2f87ebc0992ab177fba51db92c2a",
+                                ps_client_ctx->u8_private_key);
+        u8_svr_pub_key[0] = CRYPTO_X25519_KEY_SIZE;
+        t_task_chk_hex_to_bytes("de9edb7d7b7dc1b4d35b61c2ece435373f8343c85b78674dadfc7e146f882b4f",
+                                &u8_svr_pub_key[1]);
+        sts_crypto_x25519_client_secret(ps_client_ctx, u8_svr_pub_key);
+    }
+    u32_ng_cnt += b_task_chk_kat("x25519 shared", (ps_client_ctx != NULL) ? ps_client_ctx->u8_key : NULL,
+        CRYPTO_X25519_KEY_SIZE, "4a5d9d5ba4ce2de1728e3bf480350f25e07e21c947d19e3376f09b3c1e161742") ? 0 : 1;
+    v_crypto_x25519_delete_context(ps_client_ctx);
+    // クライアント・サーバー間の鍵共有
+    ps_client_ctx = ps_crypto_x25519_client_context();
+    ts_crypto_x25519_context_t* ps_server_ctx = NULL;
+    if (ps_client_ctx != NULL) {
+        ps_server_ctx = ps_crypto_x25519_server_context(ps_client_ctx->u8_cli_public_key);
+    }
+    bool b_agree = false;
+    if (ps_server_ctx != NULL &&
+        sts_crypto_x25519_client_secret(ps_client_ctx, ps_server_ctx->u8_svr_public_key) == ESP_OK) {
+        b_agree = (memcmp(ps_client_ctx->u8_key, ps_server_ctx->u8_key, CRYPTO_X25519_KEY_SIZE) == 0);
+    }
+    u32_ng_cnt += b_task_chk_kat_bool("x25519 agreement", b_agree) ? 0 : 1;
+    v_crypto_x25519_delete_context(ps_client_ctx);
+    v_crypto_x25519_delete_context(ps_server_ctx);
+
+    //==========================================================================
+    // 疑似乱数生成器（出力の健全性）
+    //==========================================================================
+    uint8_t u8_rand0[32] = {0x00};
+    uint8_t u8_rand1[32] = {0x00};
+    uint8_t u8_zero[32]  = {0x00};
+    bool b_drbg = (sts_crypto_random_fill(u8_rand0, sizeof(u8_rand0)) == ESP_OK &&
+                   sts_crypto_random_fill(u8_rand1, sizeof(u8_rand1)) == ESP_OK);
+    b_drbg = b_drbg && (memcmp(u8_rand0, u8_rand1, sizeof(u8_rand0)) != 0);
+    b_drbg = b_drbg && (memcmp(u8_rand0, u8_zero, sizeof(u8_zero)) != 0);
+    u32_ng_cnt += b_task_chk_kat_bool("drbg", b_drbg) ? 0 : 1;
+
+    //==========================================================================
+    // 結果表示
+    //==========================================================================
+    if (u32_ng_cnt == 0) {
+        ESP_LOGI(TAG, "crypto known answer test=OK!");
+    } else {
+        ESP_LOGE(TAG, "crypto known answer test=ERR! NG=%lu", (unsigned long)u32_ng_cnt);
+    }
+}
+
+/*******************************************************************************
+ *
+ * NAME: v_task_chk_cryptography_10
+ *
+ * DESCRIPTION:暗号処理のテストケース関数
+ * アルゴリズム毎のスループット
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * 16B～4KBのペイロード長で秒間処理数とKB/sを表示し、暗号処理の変更時の基準値とする。
+ * 計測回数はペイロード長に反比例させ、1計測あたりの処理量を揃える
+ ******************************************************************************/
+static void v_task_chk_cryptography_10() {
+    ESP_LOGI(TAG, "//===========================================================");
+    ESP_LOGI(TAG, "// TEST Crypto benchmark");
+    ESP_LOGI(TAG, "//===========================================================");
+    // 計測するペイロード長
+    const uint32_t u32_msg_len[] = {16, 64, 256, 1024, 4096};
+    // 1計測あたりの処理量
+    const uint32_t u32_total_len = 64 * 1024;
+    //==========================================================================
+    // 鍵情報の生成
+    //==========================================================================
+    uint8_t u8_key[AES_256_KEY_BYTES];
+    uint8_t u8_iv[AES_BLOCK_BYTES];
+    uint8_t u8_add[16] = {0x00};
+    uint8_t u8_tag[AES_BLOCK_BYTES];
+    uint8_t u8_digest[CRYPTO_HASH_MAX_SIZE];
+    uint8_t u8_stream[AES_BLOCK_BYTES];
+    b_vutil_set_u8_rand_array(u8_key, sizeof(u8_key));
+    b_vutil_set_u8_rand_array(u8_iv, sizeof(u8_iv));
+    ts_u8_array_t* ps_aes_key = ps_mdl_clone_u8_array(u8_key, sizeof(u8_key));
+    ts_crypto_keyset_t* ps_keyset = ps_crypto_create_keyset();
+    if (ps_aes_key == NULL || ps_keyset == NULL) {
+        ESP_LOGE(TAG, "crypto benchmark=ERR! no memory");
+        sts_mdl_delete_u8_array(ps_aes_key);
+        sts_crypto_delete_keyset(ps_keyset);
+        return;
+    }
+    ps_keyset->ps_key    = ps_mdl_clone_u8_array(u8_key, sizeof(u8_key));
+    ps_keyset->ps_key_iv = ps_mdl_clone_u8_array(u8_iv, sizeof(u8_iv));
+    ts_crypto_hmac_context_t s_hmac_ctx;
+    sts_crypto_hmac_init(&s_hmac_ctx, CRYPTO_HASH_SHA256, u8_key, sizeof(u8_key));
+    ts_crypto_gcm_context_t s_gcm_ctx;
+    sts_crypto_gcm_init(&s_gcm_ctx, u8_key, sizeof(u8_key));
+
+    //==========================================================================
+    // ペイロード長毎の計測
+    //==========================================================================
+    uint32_t u32_len_idx;
+    uint32_t u32_cnt;
+    int64_t i64_begin;
+    ts_u8_array_t* ps_result;
+    for (u32_len_idx = 0; u32_len_idx < sizeof(u32_msg_len) / sizeof(uint32_t); u32_len_idx++) {
+        uint32_t u32_len = u32_msg_len[u32_len_idx];
+        uint32_t u32_loop_cnt = u32_total_len / u32_len;
+        ts_u8_array_t* ps_msg = ps_mdl_empty_u8_array(u32_len);
+        if (ps_msg == NULL) {
+            ESP_LOGE(TAG, "ps_mdl_empty_u8_array=ERR!");
+            break;
+        }
+        b_vutil_set_u8_rand_array(ps_msg->pu8_values, u32_len);
+        ESP_LOGI(TAG, "//-----------------------------------------------------------");
+        // SHA-1
+        i64_begin = esp_timer_get_time();
+        for (u32_cnt = 0; u32_cnt < u32_loop_cnt; u32_cnt++) {
+            sts_crypto_sha1(ps_msg, 0, u8_digest);
+        }
+        v_task_chk_bench_disp("sha1", u32_len, u32_loop_cnt, esp_timer_get_time() - i64_begin);
+        // SHA-256（CRYPTO_BACKEND_SHA256で選択したバックエンド）
+        i64_begin = esp_timer_get_time();
+        for (u32_cnt = 0; u32_cnt < u32_loop_cnt; u32_cnt++) {
+            sts_crypto_sha256(ps_msg, 0, u8_digest);
+        }
+        v_task_chk_bench_disp("sha256", u32_len, u32_loop_cnt, esp_timer_get_time() - i64_begin);
+        // SHA-256（ポータブル実装、バックエンド選択の比較用）
+        ts_crypto_sha256_context_t s_sha256_ctx;
+        i64_begin = esp_timer_get_time();
+        for (u32_cnt = 0; u32_cnt < u32_loop_cnt; u32_cnt++) {
+            v_crypto_sha256_starts(&s_sha256_ctx, false);
+            v_crypto_sha256_update(&s_sha256_ctx, ps_msg->pu8_values, u32_len);
+            v_crypto_sha256_finish(&s_sha256_ctx, u8_digest);
+        }
+        v_task_chk_bench_disp("sha256(portable)", u32_len, u32_loop_cnt, esp_timer_get_time() - i64_begin);
+        // SHA-512
+        i64_begin = esp_timer_get_time();
+        for (u32_cnt = 0; u32_cnt < u32_loop_cnt; u32_cnt++) {
+            sts_crypto_sha512(ps_msg, 0, u8_digest);
+        }
+        v_task_chk_bench_disp("sha512", u32_len, u32_loop_cnt, esp_timer_get_time() - i64_begin);
+        // HMAC-SHA256（鍵展開済みコンテキスト）
+        i64_begin = esp_timer_get_time();
+        for (u32_cnt = 0; u32_cnt < u32_loop_cnt; u32_cnt++) {
+            sts_crypto_hmac_update(&s_hmac_ctx, ps_msg->pu8_values, u32_len);
+            sts_crypto_hmac_finish(&s_hmac_ctx, u8_digest);
+        }
+        v_task_chk_bench_disp("hmac-sha256", u32_len, u32_loop_cnt, esp_timer_get_time() - i64_begin);
+        // AES-256-ECB
+        i64_begin = esp_timer_get_time();
+        for (u32_cnt = 0; u32_cnt < u32_loop_cnt; u32_cnt++) {
+            ps_result = ps_crypto_aes_ecb_enc(ps_aes_key, ps_msg);
+            sts_mdl_delete_u8_array(ps_result);
+        }
+        v_task_chk_bench_disp("aes-256-ecb", u32_len, u32_loop_cnt, esp_timer_get_time() - i64_begin);
+        // AES-256-CBC
+        i64_begin = esp_timer_get_time();
+        for (u32_cnt = 0; u32_cnt < u32_loop_cnt; u32_cnt++) {
+            ps_result = ps_crypto_aes_cbc_enc(ps_keyset, ps_msg);
+            sts_mdl_delete_u8_array(ps_result);
+        }
+        v_task_chk_bench_disp("aes-256-cbc", u32_len, u32_loop_cnt, esp_timer_get_time() - i64_begin);
+        // AES-256-CTR
+        i64_begin = esp_timer_get_time();
+        for (u32_cnt = 0; u32_cnt < u32_loop_cnt; u32_cnt++) {
+            size_t t_nc_off = 0;
+            ps_result = ps_crypto_aes_ctr(ps_aes_key, &t_nc_off, u8_iv, u8_stream, ps_msg);
+            sts_mdl_delete_u8_array(ps_result);
+        }
+        v_task_chk_bench_disp("aes-256-ctr", u32_len, u32_loop_cnt, esp_timer_get_time() - i64_begin);
+        // AES-256-GCM（鍵スケジュール展開済みコンテキスト、インプレース）
+        i64_begin = esp_timer_get_time();
+        for (u32_cnt = 0; u32_cnt < u32_loop_cnt; u32_cnt++) {
+            sts_crypto_gcm_enc_in_place(&s_gcm_ctx, u8_iv, 12, u8_add, sizeof(u8_add),
+                                        ps_msg->pu8_values, u32_len, u8_tag, sizeof(u8_tag));
+        }
+        v_task_chk_bench_disp("aes-256-gcm", u32_len, u32_loop_cnt, esp_timer_get_time() - i64_begin);
+        // ChaCha20-Poly1305（インプレース）
+        i64_begin = esp_timer_get_time();
+        for (u32_cnt = 0; u32_cnt < u32_loop_cnt; u32_cnt++) {
+            sts_crypto_chacha20_poly1305_enc_in_place(u8_key, u8_iv, u8_add, sizeof(u8_add),
+                                                      ps_msg->pu8_values, u32_len, u8_tag);
+        }
+        v_task_chk_bench_disp("chacha20-poly1305", u32_len, u32_loop_cnt, esp_timer_get_time() - i64_begin);
+        // 疑似乱数生成器
+        i64_begin = esp_timer_get_time();
+        for (u32_cnt = 0; u32_cnt < u32_loop_cnt; u32_cnt++) {
+            sts_crypto_random_fill(ps_msg->pu8_values, u32_len);
+        }
+        v_task_chk_bench_disp("drbg", u32_len, u32_loop_cnt, esp_timer_get_time() - i64_begin);
+        // メッセージ解放
+        sts_mdl_delete_u8_array(ps_msg);
+    }
+
+    //==========================================================================
+    // X25519（共有鍵の算出）
+    //==========================================================================
+    ESP_LOGI(TAG, "//-----------------------------------------------------------");
+    const uint32_t u32_x25519_cnt = 20;
+    ts_crypto_x25519_context_t* ps_client_ctx = ps_crypto_x25519_client_context();
+    ts_crypto_x25519_context_t* ps_server_ctx = NULL;
+    if (ps_client_ctx != NULL) {
+        ps_server_ctx = ps_crypto_x25519_server_context(ps_client_ctx->u8_cli_public_key);
+    }
+    if (ps_server_ctx != NULL) {
+        i64_begin = esp_timer_get_time();
+        for (u32_cnt = 0; u32_cnt < u32_x25519_cnt; u32_cnt++) {
+            sts_crypto_x25519_client_secret(ps_client_ctx, ps_server_ctx->u8_svr_public_key);
+        }
+        v_task_chk_bench_disp("x25519", 0, u32_x25519_cnt, esp_timer_get_time() - i64_begin);
+    } else {
+        ESP_LOGE(TAG, "x25519 context=ERR!");
+    }
+    v_crypto_x25519_delete_context(ps_client_ctx);
+    v_crypto_x25519_delete_context(ps_server_ctx);
+
+    //==========================================================================
+    // 鍵情報の解放
+    //==========================================================================
+    v_crypto_gcm_free(&s_gcm_ctx);
+    v_crypto_hmac_free(&s_hmac_ctx);
+    sts_mdl_delete_u8_array(ps_aes_key);
+    sts_crypto_delete_keyset(ps_keyset);
+}
+
+/*******************************************************************************
+ *
+ * NAME: t_task_chk_hex_to_bytes
+ *
+ * DESCRIPTION:16進文字列の変換
+ *
+ * PARAMETERS:      Name            RW  Usage
+ * const char*      pc_hex          R   16進文字列
+ * uint8_t*         pu8_out         W   変換結果
+ *
+ * RETURNS:
+ *   size_t:変換後のバイト数
+ *
+ * NOTES:
+ * None.
+ ******************************************************************************/
+static size_t t_task_chk_hex_to_bytes(const char* pc_hex, uint8_t* pu8_out) {
+    size_t t_len = strlen(pc_hex) / 2;
+    size_t t_idx;
+    unsigned int u_val;
+    for (t_idx = 0; t_idx < t_len; t_idx++) {
+        sscanf(&pc_hex[t_idx * 2], "%2x", &u_val);
+        pu8_out[t_idx] = (uint8_t)u_val;
+    }
+    return t_len;
+}
+
+/*******************************************************************************
+ *
+ * NAME: b_task_chk_kat
+ *
+ * DESCRIPTION:既知解テストの判定
+ *
+ * PARAMETERS:      Name            RW  Usage
+ * const char*      pc_name         R   テスト名
+ * const uint8_t*   pu8_act         R   実行結果（NULLの場合はエラー）
+ * size_t           t_len           R   比較サイズ
+ * const char*      pc_exp_hex      R   期待値（16進文字列）
+ *
+ * RETURNS:
+ *   true:一致
+ *
+ * NOTES:
+ * 不一致の場合は実行結果を表示する
+ ******************************************************************************/
+static bool b_task_chk_kat(const char* pc_name, const uint8_t* pu8_act, size_t t_len, const char* pc_exp_hex) {
+    uint8_t u8_exp[CRYPTO_HASH_MAX_SIZE];
+    if (pu8_act == NULL || t_len > sizeof(u8_exp) || t_task_chk_hex_to_bytes(pc_exp_hex, u8_exp) != t_len) {
+        return b_task_chk_kat_bool(pc_name, false);
+    }
+    if (!b_task_chk_kat_bool(pc_name, memcmp(pu8_act, u8_exp, t_len) == 0)) {
+        v_dbg_disp_hex_data("Actual  =", pu8_act, t_len);
+        return false;
+    }
+    return true;
+}
+
+/*******************************************************************************
+ *
+ * NAME: b_task_chk_kat_bool
+ *
+ * DESCRIPTION:既知解テストの結果表示
+ *
+ * PARAMETERS:      Name            RW  Usage
+ * const char*      pc_name         R   テスト名
+ * bool             b_result        R   判定結果
+ *
+ * RETURNS:
+ *   true:一致
+ *
+ * NOTES:
+ * None.
+ ******************************************************************************/
+static bool b_task_chk_kat_bool(const char* pc_name, bool b_result) {
+    if (b_result) {
+        ESP_LOGI(TAG, "KAT %s=OK!", pc_name);
+    } else {
+        ESP_LOGE(TAG, "KAT %s=ERR!", pc_name);
+    }
+    return b_result;
+}
+
+/*******************************************************************************
+ *
+ * NAME: v_task_chk_bench_disp
+ *
+ * DESCRIPTION:ベンチマーク結果の表示
+ *
+ * PARAMETERS:      Name            RW  Usage
+ * const char*      pc_name         R   アルゴリズム名
+ * uint32_t         u32_len         R   ペイロード長（0の場合は秒間処理数のみ）
+ * uint32_t         u32_loop_cnt    R   計測回数
+ * int64_t          i64_us          R   経過時間（マイクロ秒）
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * None.
+ ******************************************************************************/
+static void v_task_chk_bench_disp(const char* pc_name, uint32_t u32_len, uint32_t u32_loop_cnt, int64_t i64_us) {
+    if (i64_us <= 0) {
+        i64_us = 1;
+    }
+    unsigned long ul_ops = (unsigned long)((int64_t)u32_loop_cnt * 1000000 / i64_us);
+    if (u32_len == 0) {
+        ESP_LOGI(TAG, "%-18s %7lu op/s %7lu us/op", pc_name, ul_ops,
+                 (unsigned long)(i64_us / u32_loop_cnt));
+        return;
+    }
+    ESP_LOGI(TAG, "%-18s len=%4lu %7lu op/s %7lu KB/s", pc_name, (unsigned long)u32_len, ul_ops,
+             (unsigned long)((int64_t)u32_loop_cnt * u32_len * 1000000 / 1024 / i64_us));
+}
+
 /*******************************************************************************
  *
  * NAME: v_task_chk_adc
@@ -2742,6 +3526,8 @@ static void v_task_chk_file_util(void* args) {
     v_task_chk_file_util_02(ps_card);
     // JSON関連関数
     v_task_chk_file_util_03();
+    // 暗号化ファイル関連関数
+    v_task_chk_file_util_04();
 
     //==========================================================================
     // SDカードをアンマウント
@@ -3592,6 +4378,124 @@ static void v_task_chk_file_util_03() {
 
 }
 
+/*******************************************************************************
+ *
+ * NAME: v_task_chk_file_util_04
+ *
+ * DESCRIPTION:File Utilityのチェックメソッドのテストケース関数
+ *   暗号化ファイル関連関数
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * チャンクサイズの倍数ではない平文で、暗号化・復号・任意チャンク読み込み・改竄検出を確認する
+ ******************************************************************************/
+static void v_task_chk_file_util_04() {
+    //==========================================================================
+    // 開始
+    //==========================================================================
+    ESP_LOGI(TAG, "\r\n");
+    ESP_LOGI(TAG, "//==========================================================================");
+    ESP_LOGI(TAG, "// FUTIL_04 Begin");
+    ESP_LOGI(TAG, "//==========================================================================");
+
+    //==========================================================================
+    // テストデータの作成
+    //==========================================================================
+    const uint32_t u32_plain_len = IO_CFILE_CHUNK_SIZE * 4 + 123;
+    uint8_t u8_key[AES_256_KEY_BYTES];
+    uint8_t u8_chunk[IO_CFILE_CHUNK_SIZE];
+    b_vutil_set_u8_rand_array(u8_key, sizeof(u8_key));
+    FILE* ps_file = fopen("/sdcard/plain.bin", "wb");
+    if (ps_file == NULL) {
+        ESP_LOGE(TAG, "File open NG:/sdcard/plain.bin");
+        return;
+    }
+    uint32_t u32_pos;
+    for (u32_pos = 0; u32_pos < u32_plain_len; u32_pos++) {
+        fputc((int)(u32_pos & 0xFF), ps_file);
+    }
+    fclose(ps_file);
+
+    //==========================================================================
+    // 暗号化と復号
+    //==========================================================================
+    FILE* ps_src = fopen("/sdcard/plain.bin", "rb");
+    FILE* ps_dst = fopen("/sdcard/cipher.bin", "wb");
+    esp_err_t sts_val = sts_cfile_encrypt(ps_src, ps_dst, u8_key, sizeof(u8_key));
+    fclose(ps_src);
+    fclose(ps_dst);
+    ESP_LOGI(TAG, "sts_cfile_encrypt=%s", (sts_val == ESP_OK) ? "OK" : "NG");
+    ps_src = fopen("/sdcard/cipher.bin", "rb");
+    ps_dst = fopen("/sdcard/decrypt.bin", "wb");
+    sts_val = sts_cfile_decrypt(ps_src, ps_dst, u8_key, sizeof(u8_key));
+    fclose(ps_src);
+    fclose(ps_dst);
+    long l_size = l_futil_file_size("/sdcard/decrypt.bin");
+    ESP_LOGI(TAG, "sts_cfile_decrypt=%s size=%ld",
+             (sts_val == ESP_OK && l_size == (long)u32_plain_len) ? "OK" : "NG", l_size);
+
+    //==========================================================================
+    // 任意チャンクの読み込み
+    //==========================================================================
+    ts_cfile_reader_t s_reader;
+    size_t t_len = 0;
+    ps_src = fopen("/sdcard/cipher.bin", "rb");
+    sts_val = sts_cfile_reader_open(&s_reader, ps_src, u8_key, sizeof(u8_key));
+    if (sts_val == ESP_OK) {
+        // 最終チャンク
+        sts_val = sts_cfile_read_chunk(&s_reader, 4, u8_chunk, &t_len);
+        ESP_LOGI(TAG, "sts_cfile_read_chunk(4)=%s len=%u",
+                 (sts_val == ESP_OK && t_len == 123 && u8_chunk[0] == ((IO_CFILE_CHUNK_SIZE * 4) & 0xFF)) ? "OK" : "NG",
+                 (unsigned)t_len);
+        // 途中のチャンク
+        sts_val = sts_cfile_read_chunk(&s_reader, 1, u8_chunk, &t_len);
+        ESP_LOGI(TAG, "sts_cfile_read_chunk(1)=%s len=%u",
+                 (sts_val == ESP_OK && t_len == IO_CFILE_CHUNK_SIZE) ? "OK" : "NG", (unsigned)t_len);
+        // 範囲外
+        sts_val = sts_cfile_read_chunk(&s_reader, 5, u8_chunk, &t_len);
+        ESP_LOGI(TAG, "sts_cfile_read_chunk(5)=%s", (sts_val == ESP_ERR_NOT_FOUND) ? "OK" : "NG");
+        v_cfile_reader_close(&s_reader);
+    } else {
+        ESP_LOGE(TAG, "sts_cfile_reader_open=NG");
+    }
+    fclose(ps_src);
+
+    //==========================================================================
+    // 改竄検出
+    //==========================================================================
+    ps_file = fopen("/sdcard/cipher.bin", "r+b");
+    fseek(ps_file, IO_CFILE_HEADER_SIZE + IO_CFILE_CHUNK_SIZE + IO_CFILE_TAG_SIZE + 10, SEEK_SET);
+    int i_ch = fgetc(ps_file);
+    fseek(ps_file, -1, SEEK_CUR);
+    fputc(i_ch ^ 0x01, ps_file);
+    fclose(ps_file);
+    ps_src = fopen("/sdcard/cipher.bin", "rb");
+    ps_dst = fopen("/sdcard/decrypt.bin", "wb");
+    sts_val = sts_cfile_decrypt(ps_src, ps_dst, u8_key, sizeof(u8_key));
+    fclose(ps_src);
+    fclose(ps_dst);
+    ESP_LOGI(TAG, "sts_cfile_decrypt(tampered)=%s", (sts_val == ESP_ERR_INVALID_RESPONSE) ? "OK" : "NG");
+
+    //==========================================================================
+    // テストファイルの削除
+    //==========================================================================
+    remove("/sdcard/plain.bin");
+    remove("/sdcard/cipher.bin");
+    remove("/sdcard/decrypt.bin");
+
+    //==========================================================================
+    // 終了
+    //==========================================================================
+    ESP_LOGI(TAG, "\r\n");
+    ESP_LOGI(TAG, "//==========================================================================");
+    ESP_LOGI(TAG, "// FUTIL_04 End");
+    ESP_LOGI(TAG, "//==========================================================================");
+
+}
+
 /*******************************************************************************
  *
  * NAME: s_com_dt_day_to_date
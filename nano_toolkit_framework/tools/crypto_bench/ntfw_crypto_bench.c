@@ -0,0 +1,514 @@
+/*******************************************************************************
+ *
+ * COMPONENT:Nano Toolkit Framework
+ *
+ * MODULE :cipher suite benchmark tool source file
+ *
+ * CREATED:2024/11/10 21:00:00
+ * AUTHOR :Kakuheiki.Nakanohito
+ *
+ * DESCRIPTION:メッセージ暗号スイートのLinux用ベンチマーク
+ *   ntfw_crypto_chachapoly.cのChaCha20-Poly1305（RFC 8439のテストベクタで検証）と、
+ *   -DBENCH_MBEDTLS_GCMを指定した場合はmbedTLSのAES-256-GCMを
+ *   16B～2KBのメッセージ長で計測する。
+ *   併せてntfw_crypto_x25519.cのX25519（RFC 7748のテストベクタで検証）の鍵共有と、
+ *   ntfw_crypto_sha256.cのSHA-256（FIPS 180-2のテストベクタで検証）を計測する。
+ *   -DBENCH_MBEDTLS_SHA256を指定した場合はmbedTLSのSHA-256も計測し、
+ *   ntfw_crypto_backend.hのCRYPTO_BACKEND_SHA256の選択材料とする
+ *
+ *   Build:gcc -O2 -I../../components/ntfw_crypto/include -o ntfw_crypto_bench
+ *             ntfw_crypto_bench.c ../../components/ntfw_crypto/ntfw_crypto_chachapoly.c
+ *             ../../components/ntfw_crypto/ntfw_crypto_x25519.c
+ *             ../../components/ntfw_crypto/ntfw_crypto_sha256.c
+ *         (AES-256-GCM:-DBENCH_MBEDTLS_GCM -lmbedcrypto を追加)
+ *         (mbedTLS SHA-256:-DBENCH_MBEDTLS_SHA256 -lmbedcrypto を追加)
+ *   Usage:ntfw_crypto_bench [loop count]
+ *
+ * CHANGE HISTORY:
+ *
+ * LAST MODIFIED BY:
+ *
+ *******************************************************************************
+ *
+ * Copyright (c) 2024 Kakuheiki.Nakanohito
+ * Released under the MIT license
+ * https://opensource.org/licenses/mit-license.php
+ *
+ ******************************************************************************/
+/******************************************************************************/
+/***      Include files                                                     ***/
+/******************************************************************************/
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "ntfw_crypto_chachapoly.h"
+#include "ntfw_crypto_x25519.h"
+#include "ntfw_crypto_sha256.h"
+#ifdef BENCH_MBEDTLS_GCM
+#include <mbedtls/gcm.h>
+#endif
+#ifdef BENCH_MBEDTLS_SHA256
+#include <mbedtls/sha256.h>
+#endif
+
+/******************************************************************************/
+/***      Macro Definitions                                                 ***/
+/******************************************************************************/
+/** 計測回数（デフォルト） */
+#define BENCH_LOOP_CNT_DEFAULT  (20000)
+/** 最大メッセージ長 */
+#define BENCH_MAX_MSG_LEN       (2048)
+/** 追加認証データ長（メッセージレイヤと同一） */
+#define BENCH_ADD_LEN           (16)
+/** X25519の計測回数の除数（計測回数 / 除数） */
+#define BENCH_X25519_LOOP_DIV   (20)
+
+/******************************************************************************/
+/***      Type Definitions                                                  ***/
+/******************************************************************************/
+
+/******************************************************************************/
+/***      Local Variables                                                   ***/
+/******************************************************************************/
+/** 計測するメッセージ長 */
+static const size_t s_msg_len[] = {16, 64, 256, 512, 1024, 2048};
+
+/******************************************************************************/
+/***      Local Function Prototypes                                         ***/
+/******************************************************************************/
+/** 16進文字列の変換 */
+static size_t t_hex_to_bytes(const char* pc_hex, uint8_t* pu8_out);
+/** 現在時刻（ナノ秒） */
+static int64_t i64_now_nsec();
+/** テストベクタの検証 */
+static bool b_check_vector();
+/** X25519テストベクタの検証 */
+static bool b_check_x25519_vector();
+/** SHA-256テストベクタの検証 */
+static bool b_check_sha256_vector();
+/** スループット表示 */
+static void v_print_rate(const char* pc_name, size_t t_len, uint32_t u32_loop_cnt, int64_t i64_nsec);
+
+/******************************************************************************/
+/***      Exported Functions                                                ***/
+/******************************************************************************/
+
+/*******************************************************************************
+ *
+ * NAME: main
+ *
+ * DESCRIPTION:ベンチマークのメイン処理
+ *
+ * PARAMETERS:      Name            RW  Usage
+ * int              argc            R   引数の数
+ * char*            argv[]          R   引数
+ *
+ * RETURNS:
+ *   int:終了コード
+ *
+ * NOTES:
+ * None.
+ ******************************************************************************/
+int main(int argc, char* argv[]) {
+    //==========================================================================
+    // 引数の解析
+    //==========================================================================
+    uint32_t u32_loop_cnt = BENCH_LOOP_CNT_DEFAULT;
+    if (argc > 1) {
+        u32_loop_cnt = (uint32_t)strtoul(argv[1], NULL, 10);
+        if (u32_loop_cnt == 0) {
+            fprintf(stderr, "Usage:%s [loop count]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    //==========================================================================
+    // テストベクタの検証
+    //==========================================================================
+    if (!b_check_vector()) {
+        fprintf(stderr, "ChaCha20-Poly1305 test vector:NG\n");
+        return 1;
+    }
+    printf("ChaCha20-Poly1305 test vector:OK\n");
+    if (!b_check_x25519_vector()) {
+        fprintf(stderr, "X25519 test vector:NG\n");
+        return 1;
+    }
+    printf("X25519 test vector:OK\n");
+    if (!b_check_sha256_vector()) {
+        fprintf(stderr, "SHA-256 test vector:NG\n");
+        return 1;
+    }
+    printf("SHA-256 test vector:OK\n");
+
+    //==========================================================================
+    // ベンチマーク
+    //==========================================================================
+    static uint8_t u8_msg[BENCH_MAX_MSG_LEN];
+    uint8_t u8_key[CRYPTO_CHACHAPOLY_KEY_SIZE];
+    uint8_t u8_iv[CRYPTO_CHACHAPOLY_NONCE_SIZE];
+    uint8_t u8_add[BENCH_ADD_LEN] = {0x00};
+    uint8_t u8_tag[CRYPTO_CHACHAPOLY_TAG_SIZE];
+    size_t t_idx;
+    for (t_idx = 0; t_idx < sizeof(u8_key); t_idx++) {
+        u8_key[t_idx] = (uint8_t)rand();
+    }
+    for (t_idx = 0; t_idx < sizeof(u8_iv); t_idx++) {
+        u8_iv[t_idx] = (uint8_t)rand();
+    }
+    for (t_idx = 0; t_idx < sizeof(u8_msg); t_idx++) {
+        u8_msg[t_idx] = (uint8_t)rand();
+    }
+#ifdef BENCH_MBEDTLS_GCM
+    // 鍵スケジュール展開済みのGCMコンテキスト（メッセージレイヤと同一の使い方）
+    mbedtls_gcm_context s_gcm_ctx;
+    mbedtls_gcm_init(&s_gcm_ctx);
+    if (mbedtls_gcm_setkey(&s_gcm_ctx, MBEDTLS_CIPHER_ID_AES, u8_key, sizeof(u8_key) * 8) != 0) {
+        fprintf(stderr, "mbedtls_gcm_setkey:NG\n");
+        return 1;
+    }
+#endif
+    printf("loop count:%u\n", (unsigned)u32_loop_cnt);
+    size_t t_len_idx;
+    uint32_t u32_cnt;
+    for (t_len_idx = 0; t_len_idx < sizeof(s_msg_len) / sizeof(size_t); t_len_idx++) {
+        size_t t_len = s_msg_len[t_len_idx];
+        //----------------------------------------------------------------------
+        // ChaCha20-Poly1305
+        //----------------------------------------------------------------------
+        int64_t i64_begin = i64_now_nsec();
+        for (u32_cnt = 0; u32_cnt < u32_loop_cnt; u32_cnt++) {
+            v_crypto_chachapoly_enc_in_place(u8_key, u8_iv, u8_add, sizeof(u8_add), u8_msg, t_len, u8_tag);
+        }
+        v_print_rate("chacha20-poly1305", t_len, u32_loop_cnt, i64_now_nsec() - i64_begin);
+#ifdef BENCH_MBEDTLS_GCM
+        //----------------------------------------------------------------------
+        // AES-256-GCM
+        //----------------------------------------------------------------------
+        i64_begin = i64_now_nsec();
+        for (u32_cnt = 0; u32_cnt < u32_loop_cnt; u32_cnt++) {
+            mbedtls_gcm_crypt_and_tag(&s_gcm_ctx, MBEDTLS_GCM_ENCRYPT, t_len,
+                                      u8_iv, sizeof(u8_iv), u8_add, sizeof(u8_add),
+                                      u8_msg, u8_msg, sizeof(u8_tag), u8_tag);
+        }
+        v_print_rate("aes-256-gcm", t_len, u32_loop_cnt, i64_now_nsec() - i64_begin);
+#endif
+        //----------------------------------------------------------------------
+        // SHA-256（ポータブル実装）
+        //----------------------------------------------------------------------
+        ts_crypto_sha256_context_t s_sha_ctx;
+        i64_begin = i64_now_nsec();
+        for (u32_cnt = 0; u32_cnt < u32_loop_cnt; u32_cnt++) {
+            v_crypto_sha256_starts(&s_sha_ctx, false);
+            v_crypto_sha256_update(&s_sha_ctx, u8_msg, t_len);
+            v_crypto_sha256_finish(&s_sha_ctx, u8_msg);
+        }
+        v_print_rate("sha256(portable)", t_len, u32_loop_cnt, i64_now_nsec() - i64_begin);
+#ifdef BENCH_MBEDTLS_SHA256
+        //----------------------------------------------------------------------
+        // SHA-256（mbedTLS）
+        //----------------------------------------------------------------------
+        mbedtls_sha256_context s_mbed_sha_ctx;
+        mbedtls_sha256_init(&s_mbed_sha_ctx);
+        i64_begin = i64_now_nsec();
+        for (u32_cnt = 0; u32_cnt < u32_loop_cnt; u32_cnt++) {
+            mbedtls_sha256_starts(&s_mbed_sha_ctx, 0);
+            mbedtls_sha256_update(&s_mbed_sha_ctx, u8_msg, t_len);
+            mbedtls_sha256_finish(&s_mbed_sha_ctx, u8_msg);
+        }
+        v_print_rate("sha256(mbedtls)", t_len, u32_loop_cnt, i64_now_nsec() - i64_begin);
+        mbedtls_sha256_free(&s_mbed_sha_ctx);
+#endif
+    }
+#ifdef BENCH_MBEDTLS_GCM
+    mbedtls_gcm_free(&s_gcm_ctx);
+#endif
+
+    //==========================================================================
+    // X25519（鍵ペア生成と共有鍵算出）
+    //==========================================================================
+    uint8_t u8_scalar[CRYPTO_X25519_BYTES];
+    uint8_t u8_point[CRYPTO_X25519_BYTES];
+    for (t_idx = 0; t_idx < sizeof(u8_scalar); t_idx++) {
+        u8_scalar[t_idx] = (uint8_t)rand();
+    }
+    v_crypto_x25519_public_key(u8_point, u8_scalar);
+    uint32_t u32_x25519_cnt = u32_loop_cnt / BENCH_X25519_LOOP_DIV;
+    if (u32_x25519_cnt == 0) {
+        u32_x25519_cnt = 1;
+    }
+    int64_t i64_begin = i64_now_nsec();
+    for (u32_cnt = 0; u32_cnt < u32_x25519_cnt; u32_cnt++) {
+        b_crypto_x25519_scalarmult(u8_point, u8_scalar, u8_point);
+    }
+    int64_t i64_nsec = i64_now_nsec() - i64_begin;
+    printf("%-18s %10.0f op/s %8.1f us/op\n", "x25519",
+           (double)u32_x25519_cnt * 1000000000.0 / (double)i64_nsec,
+           (double)i64_nsec / 1000.0 / (double)u32_x25519_cnt);
+    return 0;
+}
+
+/******************************************************************************/
+/***      Local Functions                                                   ***/
+/******************************************************************************/
+
+/*******************************************************************************
+ *
+ * NAME: t_hex_to_bytes
+ *
+ * DESCRIPTION:16進文字列の変換
+ *
+ * PARAMETERS:      Name            RW  Usage
+ * const char*      pc_hex          R   16進文字列
+ * uint8_t*         pu8_out         W   変換結果
+ *
+ * RETURNS:
+ *   size_t:変換後のバイト数
+ *
+ * NOTES:
+ * None.
+ ******************************************************************************/
+static size_t t_hex_to_bytes(const char* pc_hex, uint8_t* pu8_out) {
+    size_t t_len = strlen(pc_hex) / 2;
+    size_t t_idx;
+    unsigned int u_val;
+    for (t_idx = 0; t_idx < t_len; t_idx++) {
+        sscanf(&pc_hex[t_idx * 2], "%2x", &u_val);
+        pu8_out[t_idx] = (uint8_t)u_val;
+    }
+    return t_len;
+}
+
+/*******************************************************************************
+ *
+ * NAME: i64_now_nsec
+ *
+ * DESCRIPTION:現在時刻（ナノ秒）
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *
+ * RETURNS:
+ *   int64_t:単調増加時刻（ナノ秒）
+ *
+ * NOTES:
+ * None.
+ ******************************************************************************/
+static int64_t i64_now_nsec() {
+    struct timespec s_ts;
+    clock_gettime(CLOCK_MONOTONIC, &s_ts);
+    return ((int64_t)s_ts.tv_sec * 1000000000) + s_ts.tv_nsec;
+}
+
+/*******************************************************************************
+ *
+ * NAME: b_check_vector
+ *
+ * DESCRIPTION:テストベクタの検証
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *
+ * RETURNS:
+ *   true:一致
+ *
+ * NOTES:
+ * RFC 8439 2.8.2のAEADテストベクタで暗号文、認証タグ、復号結果を検証する
+ ******************************************************************************/
+static bool b_check_vector() {
+    static const char* pc_plane =
+        "Ladies and Gentlemen of the class of '99: If I could offer you only one tip for the future, sunscreen would be it.";
+    static const char* pc_cipher =
+        "d31a8d34648e60db7b86afbc53ef7ec2a4aded51296e08fea9e2b5a736ee62d6"
+        "3dbea45e8ca9671282fafb69da92728b1a71de0a9e060b2905d6a5b67ecd3b36"
+        "92ddbd7f2d778b8c9803aee328091b58fab324e4fad675945585808b4831d7bc"
+        "3ff4def08e4b7a9de576d26586cec64b6116";
+    uint8_t u8_key[CRYPTO_CHACHAPOLY_KEY_SIZE];
+    uint8_t u8_nonce[CRYPTO_CHACHAPOLY_NONCE_SIZE];
+    uint8_t u8_add[12];
+    uint8_t u8_tag[CRYPTO_CHACHAPOLY_TAG_SIZE];
+    uint8_t u8_exp_tag[CRYPTO_CHACHAPOLY_TAG_SIZE];
+    uint8_t u8_data[128];
+    uint8_t u8_exp_cipher[128];
+    t_hex_to_bytes("808182838485868788898a8b8c8d8e8f909192939495969798999a9b9c9d9e9f", u8_key);
+    t_hex_to_bytes("070000004041424344454647", u8_nonce);
+    t_hex_to_bytes("50515253c0c1c2c3c4c5c6c7", u8_add);
+    t_hex_to_bytes("1ae10b594f09e26a7e902ecbd0600691", u8_exp_tag);
+    size_t t_len = t_hex_to_bytes(pc_cipher, u8_exp_cipher);
+    memcpy(u8_data, pc_plane, t_len);
+    // 暗号化
+    v_crypto_chachapoly_enc_in_place(u8_key, u8_nonce, u8_add, sizeof(u8_add), u8_data, t_len, u8_tag);
+    if (memcmp(u8_data, u8_exp_cipher, t_len) != 0 || memcmp(u8_tag, u8_exp_tag, sizeof(u8_tag)) != 0) {
+        return false;
+    }
+    // 復号
+    if (!b_crypto_chachapoly_dec_in_place(u8_key, u8_nonce, u8_add, sizeof(u8_add), u8_data, t_len, u8_tag)) {
+        return false;
+    }
+    if (memcmp(u8_data, pc_plane, t_len) != 0) {
+        return false;
+    }
+    // 改ざん検出
+    u8_tag[0] ^= 0x01;
+    return !b_crypto_chachapoly_dec_in_place(u8_key, u8_nonce, u8_add, sizeof(u8_add), u8_data, t_len, u8_tag);
+}
+
+/*******************************************************************************
+ *
+ * NAME: b_check_x25519_vector
+ *
+ * DESCRIPTION:X25519テストベクタの検証
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *
+ * RETURNS:
+ *   true:一致
+ *
+ * NOTES:
+ * RFC 7748 5.2のスカラー倍算（1回と1,000回の反復）と6.1の鍵共有を検証する
+ ******************************************************************************/
+static bool b_check_x25519_vector() {
+    uint8_t u8_scalar[CRYPTO_X25519_BYTES];
+    uint8_t u8_point[CRYPTO_X25519_BYTES];
+    uint8_t u8_out[CRYPTO_X25519_BYTES];
+    uint8_t u8_exp[CRYPTO_X25519_BYTES];
+    //--------------------------------------------------------------------------
+    // スカラー倍算
+    //--------------------------------------------------------------------------
+    t_hex_to_bytes("a546e36bf0527c9d3b16154b82465edd62144c0ac1fc5a18506a2244ba449ac4", u8_scalar);
+    t_hex_to_bytes("e6db6867583030db3594c1a424b15f7c726624ec26b3353b10a903a6d0ab1c4c", u8_point);
+    t_hex_to_bytes("c3da55379de9c6908e94ea4df28d084f32eccf03491c71f754b4075577a28552", u8_exp);
+    if (!b_crypto_x25519_scalarmult(u8_out, u8_scalar, u8_point) || memcmp(u8_out, u8_exp, sizeof(u8_exp)) != 0) {
+        return false;
+    }
+    // 1,000回の反復（k = X25519(k, u)、u = 元のk）
+    memset(u8_scalar, 0x00, sizeof(u8_scalar));
+    u8_scalar[0] = 0x09;
+    memcpy(u8_point, u8_scalar, sizeof(u8_point));
+    uint32_t u32_cnt;
+    for (u32_cnt = 0; u32_cnt < 1000; u32_cnt++) {
+        b_crypto_x25519_scalarmult(u8_out, u8_scalar, u8_point);
+        memcpy(u8_point, u8_scalar, sizeof(u8_point));
+        memcpy(u8_scalar, u8_out, sizeof(u8_scalar));
+    }
+    t_hex_to_bytes("684cf59ba83309552800ef566f2f4d3c1c3887c49360e3875f2eb94d99532c51", u8_exp);
+    if (memcmp(u8_scalar, u8_exp, sizeof(u8_exp)) != 0) {
+        return false;
+    }
+    //--------------------------------------------------------------------------
+    // 鍵共有（Alice）
+    //--------------------------------------------------------------------------
+    t_hex_to_bytes("77076d0a7318a57d3c16c17251b26645df4c2f87ebc0992ab177fba51db92c2a", u8_scalar);
+    t_hex_to_bytes("8520f0098930a754748b7ddcb43ef75a0dbf3a0d26381af4eba4a98eaa9b4e6a", u8_exp);
+    v_crypto_x25519_public_key(u8_out, u8_scalar);
+    if (memcmp(u8_out, u8_exp, sizeof(u8_exp)) != 0) {
+        return false;
+    }
+    t_hex_to_bytes("de9edb7d7b7dc1b4d35b61c2ece435373f8343c85b78674dadfc7e146f882b4f", u8_point);
+    t_hex_to_bytes("4a5d9d5ba4ce2de1728e3bf480350f25e07e21c947d19e3376f09b3c1e161742", u8_exp);
+    if (!b_crypto_x25519_scalarmult(u8_out, u8_scalar, u8_point) || memcmp(u8_out, u8_exp, sizeof(u8_exp)) != 0) {
+        return false;
+    }
+    // 小位数点（u=0）の拒否
+    memset(u8_point, 0x00, sizeof(u8_point));
+    return !b_crypto_x25519_scalarmult(u8_out, u8_scalar, u8_point);
+}
+
+/*******************************************************************************
+ *
+ * NAME: b_check_sha256_vector
+ *
+ * DESCRIPTION:SHA-256テストベクタの検証
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *
+ * RETURNS:
+ *   true:一致
+ *
+ * NOTES:
+ * FIPS 180-2の"abc"（SHA-256/SHA-224）、2ブロックメッセージ、
+ * 100万文字の"a"（不揃いな分割での逐次計算）を検証する
+ ******************************************************************************/
+static bool b_check_sha256_vector() {
+    ts_crypto_sha256_context_t s_ctx;
+    uint8_t u8_out[CRYPTO_SHA256_DIGEST_SIZE];
+    uint8_t u8_exp[CRYPTO_SHA256_DIGEST_SIZE];
+    //--------------------------------------------------------------------------
+    // "abc"
+    //--------------------------------------------------------------------------
+    v_crypto_sha256_starts(&s_ctx, false);
+    v_crypto_sha256_update(&s_ctx, (const uint8_t*)"abc", 3);
+    v_crypto_sha256_finish(&s_ctx, u8_out);
+    t_hex_to_bytes("ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad", u8_exp);
+    if (memcmp(u8_out, u8_exp, CRYPTO_SHA256_DIGEST_SIZE) != 0) {
+        return false;
+    }
+    v_crypto_sha256_starts(&s_ctx, true);
+    v_crypto_sha256_update(&s_ctx, (const uint8_t*)"abc", 3);
+    v_crypto_sha256_finish(&s_ctx, u8_out);
+    t_hex_to_bytes("23097d223405d8228642a477bda255b32aadbce4bda0b3f7e36c9da7", u8_exp);
+    if (memcmp(u8_out, u8_exp, CRYPTO_SHA224_DIGEST_SIZE) != 0) {
+        return false;
+    }
+    //--------------------------------------------------------------------------
+    // 2ブロックメッセージ
+    //--------------------------------------------------------------------------
+    const char* pc_msg = "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq";
+    v_crypto_sha256_starts(&s_ctx, false);
+    v_crypto_sha256_update(&s_ctx, (const uint8_t*)pc_msg, strlen(pc_msg));
+    v_crypto_sha256_finish(&s_ctx, u8_out);
+    t_hex_to_bytes("248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1", u8_exp);
+    if (memcmp(u8_out, u8_exp, CRYPTO_SHA256_DIGEST_SIZE) != 0) {
+        return false;
+    }
+    //--------------------------------------------------------------------------
+    // 100万文字の"a"
+    //--------------------------------------------------------------------------
+    uint8_t u8_blk[97];
+    memset(u8_blk, 'a', sizeof(u8_blk));
+    v_crypto_sha256_starts(&s_ctx, false);
+    size_t t_rem = 1000000;
+    size_t t_len = 1;
+    while (t_rem > 0) {
+        size_t t_wk = (t_len < t_rem) ? t_len : t_rem;
+        v_crypto_sha256_update(&s_ctx, u8_blk, t_wk);
+        t_rem -= t_wk;
+        t_len = (t_len % sizeof(u8_blk)) + 1;
+    }
+    v_crypto_sha256_finish(&s_ctx, u8_out);
+    t_hex_to_bytes("cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0", u8_exp);
+    return (memcmp(u8_out, u8_exp, CRYPTO_SHA256_DIGEST_SIZE) == 0);
+}
+
+/*******************************************************************************
+ *
+ * NAME: v_print_rate
+ *
+ * DESCRIPTION:スループット表示
+ *
+ * PARAMETERS:      Name            RW  Usage
+ * const char*      pc_name         R   暗号スイート名
+ * size_t           t_len           R   メッセージ長
+ * uint32_t         u32_loop_cnt    R   計測回数
+ * int64_t          i64_nsec        R   経過時間（ナノ秒）
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * None.
+ ******************************************************************************/
+static void v_print_rate(const char* pc_name, size_t t_len, uint32_t u32_loop_cnt, int64_t i64_nsec) {
+    if (i64_nsec <= 0) {
+        i64_nsec = 1;
+    }
+    double d_sec = (double)i64_nsec / 1000000000.0;
+    printf("%-18s len=%4zu %10.0f msg/s %8.1f MB/s\n",
+           pc_name, t_len,
+           (double)u32_loop_cnt / d_sec,
+           ((double)u32_loop_cnt * t_len) / d_sec / (1024.0 * 1024.0));
+}
+
+/******************************************************************************/
+/***      END OF FILE                                                       ***/
+/******************************************************************************/
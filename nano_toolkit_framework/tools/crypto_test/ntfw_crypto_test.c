@@ -0,0 +1,2021 @@
+/*******************************************************************************
+ *
+ * COMPONENT:Nano Toolkit Framework
+ *
+ * MODULE :crypto known-answer test tool source file
+ *
+ * CREATED:2024/11/24 21:00:00
+ * AUTHOR :Kakuheiki.Nakanohito
+ *
+ * DESCRIPTION:暗号プリミティブのLinux用既知解テストとベンチマーク
+ *   ntfw_cryptography.cが利用する暗号プリミティブを公開されたテストベクタで検証し、
+ *   全件一致の場合は各ペイロード長でのスループット（op/sとMB/s）を計測する。
+ *   不一致が有る場合は計測せずに終了コード1を返す。
+ *   ntfw_crypto_sha256.c :SHA-224/SHA-256（FIPS 180-2）、逐次計算、状態の複製と再開
+ *   HMAC-SHA256          :RFC 4231（ntfw_cryptography.cのHMACコンテキストと同一の
+ *                         ipad/opad適用済み状態の複製方式で算出）
+ *   mbedTLS              :SHA-1/SHA-2（FIPS 180-2）とストレッチング、HMAC（RFC 4231）、
+ *                         AES-ECB/CBC/CTR（FIPS 197、SP 800-38A）、
+ *                         AES-GCM（McGrew/Viega）と改ざん検出、PKCS#7パディング、
+ *                         CTR-DRBG（SP 800-90A、AES-256、導出関数有り）
+ *   ntfw_crypto_chachapoly.c:ChaCha20、Poly1305、AEAD（RFC 8439）と改ざん検出
+ *   ntfw_crypto_x25519.c :X25519（RFC 7748）と小位数点の拒否
+ *   ntfw_cryptography.cはESP-IDFに依存する為、mbedTLSの呼び出しは同一のパラメータで行い、
+ *   ストレッチングとPKCS#7の判定規則は同一の処理で再現する。
+ *   ESP-IDF上のラッパー関数はデバイス上のv_task_chk_cryptography_09で検証する
+ *
+ *   Build:gcc -O2 -Wall -I../../components/ntfw_crypto/include -o ntfw_crypto_test
+ *             ntfw_crypto_test.c ../../components/ntfw_crypto/ntfw_crypto_chachapoly.c
+ *             ../../components/ntfw_crypto/ntfw_crypto_x25519.c
+ *             ../../components/ntfw_crypto/ntfw_crypto_sha256.c -lmbedcrypto
+ *   Usage:ntfw_crypto_test [loop count]（0:既知解テストのみ）
+ *
+ * CHANGE HISTORY:
+ *
+ * LAST MODIFIED BY:
+ *
+ *******************************************************************************
+ *
+ * Copyright (c) 2024 Kakuheiki.Nakanohito
+ * Released under the MIT license
+ * https://opensource.org/licenses/mit-license.php
+ *
+ ******************************************************************************/
+/******************************************************************************/
+/***      Include files                                                     ***/
+/******************************************************************************/
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <mbedtls/md.h>
+#include <mbedtls/aes.h>
+#include <mbedtls/gcm.h>
+#include <mbedtls/ctr_drbg.h>
+#include "ntfw_crypto_chachapoly.h"
+#include "ntfw_crypto_x25519.h"
+#include "ntfw_crypto_sha256.h"
+
+/******************************************************************************/
+/***      Macro Definitions                                                 ***/
+/******************************************************************************/
+/** 16進文字列から変換するデータの最大長 */
+#define TEST_MAX_DATA_LEN       (256)
+/** 要素数 */
+#define TEST_ARRAY_CNT(a)       (sizeof(a) / sizeof((a)[0]))
+/** ハッシュ値の最大長（SHA-512） */
+#define TEST_MAX_HASH_LEN       (64)
+/** AESのブロックサイズ */
+#define TEST_AES_BLOCK_SIZE     (16)
+/** GCMの認証タグ長 */
+#define TEST_GCM_TAG_LEN        (16)
+/** CTR-DRBGの1回の要求の最大長（MBEDTLS_CTR_DRBG_MAX_REQUEST） */
+#define TEST_DRBG_MAX_REQUEST   (1024)
+/** 計測回数（デフォルト） */
+#define TEST_LOOP_CNT_DEFAULT   (2000)
+/** 最大ペイロード長 */
+#define TEST_MAX_PAYLOAD_LEN    (4096)
+/** 追加認証データ長（メッセージレイヤと同一） */
+#define TEST_ADD_LEN            (16)
+/** X25519の計測回数の除数（計測回数 / 除数） */
+#define TEST_X25519_LOOP_DIV    (20)
+
+/******************************************************************************/
+/***      Type Definitions                                                  ***/
+/******************************************************************************/
+/** テストケース */
+typedef struct {
+    const char* pc_name;        // テスト名
+    bool (*pf_test)();          // テスト関数（true:一致）
+} ts_test_case_t;
+
+/** HMACのテストベクタ */
+typedef struct {
+    const char* pc_key;         // キー（16進文字列）
+    const char* pc_data;        // メッセージ（16進文字列）
+    const char* pc_mac256;      // HMAC-SHA256（16進文字列）
+    const char* pc_mac512;      // HMAC-SHA512（16進文字列）
+} ts_hmac_vector_t;
+
+/** ハッシュ関数のテストベクタ */
+typedef struct {
+    mbedtls_md_type_t e_type;   // ハッシュ関数
+    const char* pc_msg;         // メッセージ（文字列）
+    uint32_t u32_stretching;    // ストレッチング回数
+    const char* pc_hash;        // ハッシュ値（16進文字列）
+} ts_md_vector_t;
+
+/** AES-GCMのテストベクタ */
+typedef struct {
+    const char* pc_key;         // キー（16進文字列）
+    const char* pc_iv;          // 初期ベクトル（16進文字列）
+    const char* pc_add;         // 追加認証データ（16進文字列）
+    const char* pc_plain;       // 平文（16進文字列）
+    const char* pc_cipher;      // 暗号文（16進文字列）
+    const char* pc_tag;         // 認証タグ（16進文字列）
+} ts_gcm_vector_t;
+
+/** 既知のエントロピー源 */
+typedef struct {
+    uint8_t u8_pool[128];       // エントロピー
+    size_t t_pos;               // 読み出し位置
+} ts_test_entropy_t;
+
+/******************************************************************************/
+/***      Local Function Prototypes                                         ***/
+/******************************************************************************/
+/** 16進文字列の変換 */
+static size_t t_hex_to_bytes(const char* pc_hex, uint8_t* pu8_out);
+/** 16進文字列との比較 */
+static bool b_equals_hex(const uint8_t* pu8_data, const char* pc_hex);
+/** SHA-256の一括計算 */
+static void v_sha256(const uint8_t* pu8_data, size_t t_len, bool b_is224, uint8_t* pu8_hash);
+/** HMAC-SHA256（ipad/opad適用済み状態の複製方式） */
+static void v_hmac_sha256(const uint8_t* pu8_key, size_t t_key_len,
+                          const uint8_t* pu8_data, size_t t_len, uint8_t* pu8_mac);
+/** ストレッチング付きハッシュ（sts_crypto_sha1～sts_crypto_sha512と同一の処理） */
+static bool b_md_stretching(mbedtls_md_type_t e_type, const uint8_t* pu8_data, size_t t_len,
+                            uint32_t u32_stretching, uint8_t* pu8_hash);
+/** PKCS#7パディング（u32_crypto_pkcs7_padded_lengthと同一の長さ） */
+static size_t t_pkcs7_padding(uint8_t* pu8_data, size_t t_len, uint8_t u8_block_size);
+/** PKCS#7アンパディング（sts_crypto_pkcs7_unpaddingと同一の判定） */
+static bool b_pkcs7_unpadding(const uint8_t* pu8_data, size_t t_len, uint8_t u8_block_size, size_t* pt_len);
+/** 既知のエントロピー源（テストベクタの入力を順に返却） */
+static int i_test_entropy(void* pv_ctx, unsigned char* puc_output, size_t t_len);
+/** 計測用のエントロピー源 */
+static int i_bench_entropy(void* pv_ctx, unsigned char* puc_output, size_t t_len);
+/** 現在時刻（ナノ秒） */
+static int64_t i64_now_nsec();
+/** スループット表示 */
+static void v_print_rate(const char* pc_name, size_t t_len, uint32_t u32_loop_cnt, int64_t i64_nsec);
+/** ペイロード長毎のスループット計測 */
+static bool b_benchmark(uint32_t u32_loop_cnt);
+
+/** SHA-256：FIPS 180-2のテストベクタ */
+static bool b_test_sha256_vector();
+/** SHA-224：FIPS 180-2のテストベクタ */
+static bool b_test_sha224_vector();
+/** SHA-256：100万文字の"a"（不揃いな分割での逐次計算） */
+static bool b_test_sha256_million();
+/** SHA-256：ブロック境界前後の長さでの逐次計算 */
+static bool b_test_sha256_boundary();
+/** SHA-256：計算途中の状態の複製と再開 */
+static bool b_test_sha256_clone();
+/** HMAC-SHA256：RFC 4231のテストベクタ */
+static bool b_test_hmac_vector();
+/** SHA-1/SHA-2（mbedTLS）：FIPS 180-2のテストベクタ */
+static bool b_test_md_vector();
+/** SHA-1/SHA-2（mbedTLS）：ストレッチング */
+static bool b_test_md_stretching();
+/** HMAC-SHA256/SHA512（mbedTLS）：RFC 4231のテストベクタ */
+static bool b_test_md_hmac_vector();
+/** AES-ECB：FIPS 197 C.3とSP 800-38A F.1のテストベクタ */
+static bool b_test_aes_ecb_vector();
+/** AES-CBC：SP 800-38A F.2のテストベクタ */
+static bool b_test_aes_cbc_vector();
+/** AES-CTR：SP 800-38A F.5のテストベクタ */
+static bool b_test_aes_ctr_vector();
+/** AES-GCM：McGrew/Viegaのテストケースと改ざん検出 */
+static bool b_test_aes_gcm_vector();
+/** PKCS#7：AES-CBCと組み合わせたパディングとパディングエラーの検出 */
+static bool b_test_pkcs7_padding();
+/** CTR-DRBG：SP 800-90Aの生成、再シード、追加入力 */
+static bool b_test_ctr_drbg_vector();
+/** ChaCha20：RFC 8439 2.4.2のテストベクタ */
+static bool b_test_chacha20_vector();
+/** Poly1305：RFC 8439 2.5.2のテストベクタ */
+static bool b_test_poly1305_vector();
+/** ChaCha20-Poly1305：RFC 8439 2.8.2のテストベクタと改ざん検出 */
+static bool b_test_aead_vector();
+/** ChaCha20-Poly1305：各データ長での暗号化と復号の往復 */
+static bool b_test_aead_round_trip();
+/** X25519：RFC 7748 5.2のスカラー倍算 */
+static bool b_test_x25519_vector();
+/** X25519：RFC 7748 5.2の1,000回の反復 */
+static bool b_test_x25519_iterate();
+/** X25519：RFC 7748 6.1の鍵共有 */
+static bool b_test_x25519_agreement();
+/** X25519：小位数点の拒否 */
+static bool b_test_x25519_low_order();
+
+/******************************************************************************/
+/***      Local Variables                                                   ***/
+/******************************************************************************/
+/** テストケース一覧 */
+static const ts_test_case_t s_test_cases[] = {
+    {"sha256 fips180-2",            b_test_sha256_vector},
+    {"sha224 fips180-2",            b_test_sha224_vector},
+    {"sha256 million a",            b_test_sha256_million},
+    {"sha256 block boundary",       b_test_sha256_boundary},
+    {"sha256 clone and resume",     b_test_sha256_clone},
+    {"hmac-sha256 rfc4231",         b_test_hmac_vector},
+    {"sha1/sha2 fips180-2 mbedtls", b_test_md_vector},
+    {"sha1/sha2 stretching",        b_test_md_stretching},
+    {"hmac-sha256/512 rfc4231",     b_test_md_hmac_vector},
+    {"aes-ecb fips197 sp800-38a",   b_test_aes_ecb_vector},
+    {"aes-cbc sp800-38a",           b_test_aes_cbc_vector},
+    {"aes-ctr sp800-38a",           b_test_aes_ctr_vector},
+    {"aes-gcm mcgrew-viega",        b_test_aes_gcm_vector},
+    {"pkcs7 padding",               b_test_pkcs7_padding},
+    {"ctr-drbg sp800-90a",          b_test_ctr_drbg_vector},
+    {"chacha20 rfc8439 2.4.2",      b_test_chacha20_vector},
+    {"poly1305 rfc8439 2.5.2",      b_test_poly1305_vector},
+    {"aead rfc8439 2.8.2",          b_test_aead_vector},
+    {"aead round trip",             b_test_aead_round_trip},
+    {"x25519 rfc7748 5.2",          b_test_x25519_vector},
+    {"x25519 rfc7748 5.2 x1000",    b_test_x25519_iterate},
+    {"x25519 rfc7748 6.1",          b_test_x25519_agreement},
+    {"x25519 low order point",      b_test_x25519_low_order},
+};
+
+/** 計測するペイロード長 */
+static const size_t s_payload_len[] = {16, 64, 256, 1024, 4096};
+
+/** RFC 4231のテストケース1～4、6、7（テストケース5は切り詰めた出力の為除外） */
+static const ts_hmac_vector_t s_hmac_vectors[] = {
+    {
+        "0b0b0b0b0b0b0b0b0b0b0b0b0b0b0b0b0b0b0b0b",
+        "4869205468657265",
+        "b0344c61d8db38535ca8afceaf0bf12b881dc200c9833da726e9376c2e32cff7",
+        "87aa7cdea5ef619d4ff0b4241a1d6cb02379f4e2ce4ec2787ad0b30545e17cde"
+        "daa833b7d6b8a702038b274eaea3f4e4be9d914eeb61f1702e696c203a126854"
+    },
+    {
+        "4a656665",
+        "7768617420646f2079612077616e7420666f72206e6f7468696e673f",
+        "5bdcc146bf60754e6a042426089575c75a003f089d2739839dec58b964ec3843",
+        "164b7a7bfcf819e2e395fbe73b56e0a387bd64222e831fd610270cd7ea250554"
+        "9758bf75c05a994a6d034f65f8f0e6fdcaeab1a34d4a6b4b636e070a38bce737"
+    },
+    {
+        "aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa",
+        "dddddddddddddddddddddddddddddddddddddddddddddddddddddddddddddddd"
+        "dddddddddddddddddddddddddddddddddddd",
+        "773ea91e36800e46854db8ebd09181a72959098b3ef8c122d9635514ced565fe",
+        "fa73b0089d56a284efb0f0756c890be9b1b5dbdd8ee81a3655f83e33b2279d39"
+        "bf3e848279a722c806b485a47e67c807b946a337bee8942674278859e13292fb"
+    },
+    {
+        "0102030405060708090a0b0c0d0e0f10111213141516171819",
+        "cdcdcdcdcdcdcdcdcdcdcdcdcdcdcdcdcdcdcdcdcdcdcdcdcdcdcdcdcdcdcdcd"
+        "cdcdcdcdcdcdcdcdcdcdcdcdcdcdcdcdcdcd",
+        "82558a389a443c0ea4cc819899f2083a85f0faa3e578f8077a2e3ff46729665b",
+        "b0ba465637458c6990e5a8c5f61d4af7e576d97ff94b872de76f8050361ee3db"
+        "a91ca5c11aa25eb4d679275cc5788063a5f19741120c4f2de2adebeb10a298dd"
+    },
+    {
+        "aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa"
+        "aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa"
+        "aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa"
+        "aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa"
+        "aaaaaa",
+        "54657374205573696e67204c6172676572205468616e20426c6f636b2d53697a"
+        "65204b6579202d2048617368204b6579204669727374",
+        "60e431591ee0b67f0d8a26aacbf5b77f8e0bc6213728c5140546040f0ee37f54",
+        "80b24263c7c1a3ebb71493c1dd7be8b49b46d1f41b4aeec1121b013783f8f352"
+        "6b56d037e05f2598bd0fd2215d6a1e5295e64f73f63f0aec8b915a985d786598"
+    },
+    {
+        "aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa"
+        "aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa"
+        "aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa"
+        "aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa"
+        "aaaaaa",
+        "5468697320697320612074657374207573696e672061206c6172676572207468"
+        "616e20626c6f636b2d73697a65206b657920616e642061206c61726765722074"
+        "68616e20626c6f636b2d73697a6520646174612e20546865206b6579206e6565"
+        "647320746f20626520686173686564206265666f7265206265696e6720757365"
+        "642062792074686520484d414320616c676f726974686d2e",
+        "9b09ffa71b942fcb27635fbcd5b0e944bfdc63644f0713938a7f51535c3a35e2",
+        "e37b6a775dc87dbaa4dfa9f96e5e3ffddebd71f8867289865df5a32d20cdc944"
+        "b6022cac3c4982b10d5eeb55c3e4de15134676fb6de0446065c97440fa8c6a58"
+    },
+};
+
+
+/** FIPS 180-2のテストベクタ（ストレッチング無し）とストレッチングの既知解 */
+static const ts_md_vector_t s_md_vectors[] = {
+    {MBEDTLS_MD_SHA1,   "", 0, "da39a3ee5e6b4b0d3255bfef95601890afd80709"},
+    {MBEDTLS_MD_SHA1,   "abc", 0, "a9993e364706816aba3e25717850c26c9cd0d89d"},
+    {MBEDTLS_MD_SHA1,   "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq", 0,
+     "84983e441c3bd26ebaae4aa1f95129e5e54670f1"},
+    {MBEDTLS_MD_SHA224, "abc", 0, "23097d223405d8228642a477bda255b32aadbce4bda0b3f7e36c9da7"},
+    {MBEDTLS_MD_SHA224, "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq", 0,
+     "75388b16512776cc5dba5da1fd890150b0c6455cb4f58b1952522525"},
+    {MBEDTLS_MD_SHA256, "", 0, "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855"},
+    {MBEDTLS_MD_SHA256, "abc", 0, "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad"},
+    {MBEDTLS_MD_SHA256, "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq", 0,
+     "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1"},
+    {MBEDTLS_MD_SHA384, "abc", 0,
+     "cb00753f45a35e8bb5a03d699ac65007272c32ab0eded1631a8b605a43ff5bed"
+     "8086072ba1e7cc2358baeca134c825a7"},
+    {MBEDTLS_MD_SHA384,
+     "abcdefghbcdefghicdefghijdefghijkefghijklfghijklmghijklmnhijklmno"
+     "ijklmnopjklmnopqklmnopqrlmnopqrsmnopqrstnopqrstu", 0,
+     "09330c33f71147e83d192fc782cd1b4753111b173b3b05d22fa08086e3b0f712"
+     "fcc7c71a557e2db966c3e9fa91746039"},
+    {MBEDTLS_MD_SHA512, "", 0,
+     "cf83e1357eefb8bdf1542850d66d8007d620e4050b5715dc83f4a921d36ce9ce"
+     "47d0d13c5d85f2b0ff8318d2877eec2f63b931bd47417a81a538327af927da3e"},
+    {MBEDTLS_MD_SHA512, "abc", 0,
+     "ddaf35a193617abacc417349ae20413112e6fa4e89a97ea20a9eeee64b55d39a"
+     "2192992a274fc1a836ba3c23a3feebbd454d4423643ce80e2a9ac94fa54ca49f"},
+    {MBEDTLS_MD_SHA512,
+     "abcdefghbcdefghicdefghijdefghijkefghijklfghijklmghijklmnhijklmno"
+     "ijklmnopjklmnopqklmnopqrlmnopqrsmnopqrstnopqrstu", 0,
+     "8e959b75dae313da8cf4f72814fc143f8f7779c6eb9f7fa17299aeadb6889018"
+     "501d289e4900f7e4331b99dec4b5433ac7d329eeb6dd26545e96e55b874be909"},
+};
+
+/** ストレッチングの既知解（"abc"、Python hashlibで同一の反復を行い算出） */
+static const ts_md_vector_t s_stretching_vectors[] = {
+    {MBEDTLS_MD_SHA1,   "abc", 1, "0d3ced9bec10a777aec23ccc353a8c08a633045e"},
+    {MBEDTLS_MD_SHA1,   "abc", 1000, "a47b1f9fe970073e4c11984f34db4d2f8796e3e1"},
+    {MBEDTLS_MD_SHA224, "abc", 1, "2f6268de8b61017569d68593c00a7b442f9dcb898743f4262be4d444"},
+    {MBEDTLS_MD_SHA224, "abc", 1000, "a759bfc9f2c1ec77c0a4629a34399d698d2334c8eb2033e6c7010e9d"},
+    {MBEDTLS_MD_SHA256, "abc", 1, "4f8b42c22dd3729b519ba6f68d2da7cc5b2d606d05daed5ad5128cc03e6c6358"},
+    {MBEDTLS_MD_SHA256, "abc", 1000, "0a5afc0e280abf3d2254e6cf28d4cb5e3f93d6a4d716278c14303adfdd4deccf"},
+    {MBEDTLS_MD_SHA384, "abc", 1,
+     "73100f01cf258766906c34a30f9a486f07259c627ea0696d97c4582560447f59"
+     "a6df4a7cf960708271a30324b1481ef4"},
+    {MBEDTLS_MD_SHA384, "abc", 1000,
+     "dd935774a0e5830ec157a21b401f2f364f14c4ab4e606c5bd15125958b60bd73"
+     "11fd5408c0dd8da255260cac3c1811e0"},
+    {MBEDTLS_MD_SHA512, "abc", 1,
+     "373a9f3a902cf561003b513c94c5164ba4af135cbc4eb4d856b89ea5609523f1"
+     "30bbe5e453e6c645b2765a265aaeb1390c82c913130870636cd0c8ecf980d851"},
+    {MBEDTLS_MD_SHA512, "abc", 1000,
+     "15af50c596c7055e8fd4872b392cb6359858151849eb0626ac400466bed18192"
+     "89a2639487954c0bb09d410a9f70b16d284eb0f35724bcdbb31ac99a91bab6c1"},
+};
+
+/** SP 800-38Aのテストで利用する平文 */
+static const char* pc_sp800_38a_plain =
+    "6bc1bee22e409f96e93d7e117393172aae2d8a571e03ac9c9eb76fac45af8e51"
+    "30c81c46a35ce411e5fbc1191a0a52eff69f2445df4f9b17ad2b417be66c3710";
+/** SP 800-38AのAES-128のキー */
+static const char* pc_sp800_38a_key128 = "2b7e151628aed2a6abf7158809cf4f3c";
+/** SP 800-38AのAES-256のキー */
+static const char* pc_sp800_38a_key256 =
+    "603deb1015ca71be2b73aef0857d77811f352c073b6108d72d9810a30914dff4";
+
+/** McGrew/Viegaのテストケース2、4、14、16 */
+static const ts_gcm_vector_t s_gcm_vectors[] = {
+    {
+        "00000000000000000000000000000000",
+        "000000000000000000000000",
+        "",
+        "00000000000000000000000000000000",
+        "0388dace60b6a392f328c2b971b2fe78",
+        "ab6e47d42cec13bdf53a67b21257bddf"
+    },
+    {
+        "feffe9928665731c6d6a8f9467308308",
+        "cafebabefacedbaddecaf888",
+        "feedfacedeadbeeffeedfacedeadbeefabaddad2",
+        "d9313225f88406e5a55909c5aff5269a86a7a9531534f7da2e4c303d8a318a72"
+        "1c3c0c95956809532fcf0e2449a6b525b16aedf5aa0de657ba637b39",
+        "42831ec2217774244b7221b784d0d49ce3aa212f2c02a4e035c17e2329aca12e"
+        "21d514b25466931c7d8f6a5aac84aa051ba30b396a0aac973d58e091",
+        "5bc94fbc3221a5db94fae95ae7121a47"
+    },
+    {
+        "0000000000000000000000000000000000000000000000000000000000000000",
+        "000000000000000000000000",
+        "",
+        "00000000000000000000000000000000",
+        "cea7403d4d606b6e074ec5d3baf39d18",
+        "d0d1c8a799996bf0265b98b5d48ab919"
+    },
+    {
+        "feffe9928665731c6d6a8f9467308308feffe9928665731c6d6a8f9467308308",
+        "cafebabefacedbaddecaf888",
+        "feedfacedeadbeeffeedfacedeadbeefabaddad2",
+        "d9313225f88406e5a55909c5aff5269a86a7a9531534f7da2e4c303d8a318a72"
+        "1c3c0c95956809532fcf0e2449a6b525b16aedf5aa0de657ba637b39",
+        "522dc1f099567d07f47f37a32a84427d643a8cdcbfe5c0c97598a2bd2555d1aa"
+        "8cb08e48590dbb3da7b08b1056828838c5f61e6393ba7a0abcc9f662",
+        "76fc6ece0f4e1768cddf8853bb2d551b"
+    },
+};
+
+/** RFC 8439のテストで利用する平文 */
+static const char* pc_sunscreen =
+    "Ladies and Gentlemen of the class of '99: If I could offer you only one tip for the future, sunscreen would be it.";
+
+/******************************************************************************/
+/***      Exported Functions                                                ***/
+/******************************************************************************/
+
+/*******************************************************************************
+ *
+ * NAME: main
+ *
+ * DESCRIPTION:既知解テストとベンチマークのメイン処理
+ *
+ * PARAMETERS:      Name            RW  Usage
+ * int              argc            R   引数の数
+ * char*            argv[]          R   引数
+ *
+ * RETURNS:
+ *   int:終了コード（0:全件一致、1:不一致有り）
+ *
+ * NOTES:
+ * 不一致が有る場合は計測を行わない
+ ******************************************************************************/
+int main(int argc, char* argv[]) {
+    //==========================================================================
+    // 引数の解析
+    //==========================================================================
+    uint32_t u32_loop_cnt = TEST_LOOP_CNT_DEFAULT;
+    if (argc > 1) {
+        char* pc_end;
+        u32_loop_cnt = (uint32_t)strtoul(argv[1], &pc_end, 10);
+        if (*pc_end != '\0') {
+            fprintf(stderr, "Usage:%s [loop count]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    //==========================================================================
+    // 既知解テスト
+    //==========================================================================
+    uint32_t u32_ng_cnt = 0;
+    size_t t_idx;
+    for (t_idx = 0; t_idx < TEST_ARRAY_CNT(s_test_cases); t_idx++) {
+        bool b_result = s_test_cases[t_idx].pf_test();
+        printf("%-28s %s\n", s_test_cases[t_idx].pc_name, b_result ? "OK" : "NG");
+        if (!b_result) {
+            u32_ng_cnt++;
+        }
+    }
+    printf("total:%zu NG:%u\n", TEST_ARRAY_CNT(s_test_cases), (unsigned)u32_ng_cnt);
+    if (u32_ng_cnt > 0) {
+        return 1;
+    }
+
+    //==========================================================================
+    // ベンチマーク
+    //==========================================================================
+    if (u32_loop_cnt == 0) {
+        return 0;
+    }
+    return b_benchmark(u32_loop_cnt) ? 0 : 1;
+}
+
+/******************************************************************************/
+/***      Local Functions                                                   ***/
+/******************************************************************************/
+/*******************************************************************************
+ *
+ * NAME: t_hex_to_bytes
+ *
+ * DESCRIPTION:16進文字列の変換
+ *
+ * PARAMETERS:      Name            RW  Usage
+ * const char*      pc_hex          R   16進文字列
+ * uint8_t*         pu8_out         W   変換結果
+ *
+ * RETURNS:
+ *   size_t:変換後のバイト数
+ *
+ * NOTES:
+ * None.
+ ******************************************************************************/
+static size_t t_hex_to_bytes(const char* pc_hex, uint8_t* pu8_out) {
+    size_t t_len = strlen(pc_hex) / 2;
+    size_t t_idx;
+    unsigned int u_val;
+    for (t_idx = 0; t_idx < t_len; t_idx++) {
+        sscanf(&pc_hex[t_idx * 2], "%2x", &u_val);
+        pu8_out[t_idx] = (uint8_t)u_val;
+    }
+    return t_len;
+}
+
+/*******************************************************************************
+ *
+ * NAME: b_equals_hex
+ *
+ * DESCRIPTION:16進文字列との比較
+ *
+ * PARAMETERS:      Name            RW  Usage
+ * const uint8_t*   pu8_data        R   比較対象
+ * const char*      pc_hex          R   期待値（16進文字列）
+ *
+ * RETURNS:
+ *   true:一致
+ *
+ * NOTES:
+ * 比較する長さは期待値の長さ
+ ******************************************************************************/
+static bool b_equals_hex(const uint8_t* pu8_data, const char* pc_hex) {
+    uint8_t u8_exp[TEST_MAX_DATA_LEN];
+    size_t t_len = t_hex_to_bytes(pc_hex, u8_exp);
+    return (memcmp(pu8_data, u8_exp, t_len) == 0);
+}
+
+/*******************************************************************************
+ *
+ * NAME: v_sha256
+ *
+ * DESCRIPTION:SHA-256の一括計算
+ *
+ * PARAMETERS:      Name            RW  Usage
+ * const uint8_t*   pu8_data        R   対象データ
+ * size_t           t_len           R   対象データ長
+ * bool             b_is224         R   SHA-224判定
+ * uint8_t*         pu8_hash        W   ハッシュ値
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * None.
+ ******************************************************************************/
+static void v_sha256(const uint8_t* pu8_data, size_t t_len, bool b_is224, uint8_t* pu8_hash) {
+    ts_crypto_sha256_context_t s_ctx;
+    v_crypto_sha256_starts(&s_ctx, b_is224);
+    v_crypto_sha256_update(&s_ctx, pu8_data, t_len);
+    v_crypto_sha256_finish(&s_ctx, pu8_hash);
+}
+
+/*******************************************************************************
+ *
+ * NAME: v_hmac_sha256
+ *
+ * DESCRIPTION:HMAC-SHA256（ipad/opad適用済み状態の複製方式）
+ *
+ * PARAMETERS:      Name            RW  Usage
+ * const uint8_t*   pu8_key         R   キー
+ * size_t           t_key_len       R   キーサイズ
+ * const uint8_t*   pu8_data        R   メッセージ
+ * size_t           t_len           R   メッセージ長
+ * uint8_t*         pu8_mac         W   HMAC
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * sts_crypto_hmac_initと同様にipad/opadを適用した状態を事前計算し、
+ * 計算毎にその状態を複製して再開する（CRYPTO_BACKEND_PORTABLEの場合の処理と同一）
+ ******************************************************************************/
+static void v_hmac_sha256(const uint8_t* pu8_key, size_t t_key_len,
+                          const uint8_t* pu8_data, size_t t_len, uint8_t* pu8_mac) {
+    uint8_t u8_key_block[CRYPTO_SHA256_MSG_BLOCK];
+    uint8_t u8_pad[CRYPTO_SHA256_MSG_BLOCK];
+    uint8_t u8_inner[CRYPTO_SHA256_DIGEST_SIZE];
+    memset(u8_key_block, 0x00, sizeof(u8_key_block));
+    // キーブロックの編集（ブロックサイズを超えるキーはハッシュ値を利用）
+    if (t_key_len > CRYPTO_SHA256_MSG_BLOCK) {
+        v_sha256(pu8_key, t_key_len, false, u8_key_block);
+    } else {
+        memcpy(u8_key_block, pu8_key, t_key_len);
+    }
+    // 内側と外側のハッシュ状態を生成
+    ts_crypto_sha256_context_t s_ipad;
+    ts_crypto_sha256_context_t s_opad;
+    size_t t_idx;
+    for (t_idx = 0; t_idx < sizeof(u8_pad); t_idx++) {
+        u8_pad[t_idx] = u8_key_block[t_idx] ^ 0x36;
+    }
+    v_crypto_sha256_starts(&s_ipad, false);
+    v_crypto_sha256_update(&s_ipad, u8_pad, sizeof(u8_pad));
+    for (t_idx = 0; t_idx < sizeof(u8_pad); t_idx++) {
+        u8_pad[t_idx] = u8_key_block[t_idx] ^ 0x5C;
+    }
+    v_crypto_sha256_starts(&s_opad, false);
+    v_crypto_sha256_update(&s_opad, u8_pad, sizeof(u8_pad));
+    // 複製した状態から内側ハッシュと外側ハッシュを算出
+    ts_crypto_sha256_context_t s_work = s_ipad;
+    v_crypto_sha256_update(&s_work, pu8_data, t_len);
+    v_crypto_sha256_finish(&s_work, u8_inner);
+    s_work = s_opad;
+    v_crypto_sha256_update(&s_work, u8_inner, sizeof(u8_inner));
+    v_crypto_sha256_finish(&s_work, pu8_mac);
+}
+
+/*******************************************************************************
+ *
+ * NAME: b_md_stretching
+ *
+ * DESCRIPTION:ストレッチング付きハッシュ（sts_crypto_sha1～sts_crypto_sha512と同一の処理）
+ *
+ * PARAMETERS:          Name            RW  Usage
+ * mbedtls_md_type_t    e_type          R   ハッシュ関数
+ * const uint8_t*       pu8_data        R   対象データ
+ * size_t               t_len           R   対象データ長
+ * uint32_t             u32_stretching  R   ストレッチング回数
+ * uint8_t*             pu8_hash        W   ハッシュ値
+ *
+ * RETURNS:
+ *   true:正常終了
+ *
+ * NOTES:
+ * 対象データのハッシュ値を算出し、以降はストレッチング回数分、直前のハッシュ値を再計算する
+ ******************************************************************************/
+static bool b_md_stretching(mbedtls_md_type_t e_type, const uint8_t* pu8_data, size_t t_len,
+                            uint32_t u32_stretching, uint8_t* pu8_hash) {
+    const mbedtls_md_info_t* ps_info = mbedtls_md_info_from_type(e_type);
+    if (ps_info == NULL) {
+        return false;
+    }
+    uint8_t u8_wk_hash[TEST_MAX_HASH_LEN];
+    const uint8_t* pu8_token = pu8_data;
+    size_t t_size = t_len;
+    uint32_t u32_cnt;
+    for (u32_cnt = 0; u32_cnt <= u32_stretching; u32_cnt++) {
+        if (mbedtls_md(ps_info, pu8_token, t_size, u8_wk_hash) != 0) {
+            return false;
+        }
+        // 対象の更新
+        pu8_token = u8_wk_hash;
+        t_size = mbedtls_md_get_size(ps_info);
+    }
+    memcpy(pu8_hash, u8_wk_hash, t_size);
+    return true;
+}
+
+/*******************************************************************************
+ *
+ * NAME: t_pkcs7_padding
+ *
+ * DESCRIPTION:PKCS#7パディング（u32_crypto_pkcs7_padded_lengthと同一の長さ）
+ *
+ * PARAMETERS:      Name            RW  Usage
+ * uint8_t*         pu8_data        RW  パディング対象（パディング後の長さを確保済み）
+ * size_t           t_len           R   パディング対象の長さ
+ * uint8_t          u8_block_size   R   ブロックサイズ
+ *
+ * RETURNS:
+ *   size_t:パディング後の長さ
+ *
+ * NOTES:
+ * ブロックサイズの倍数の場合は1ブロック分のパディングを付加する
+ ******************************************************************************/
+static size_t t_pkcs7_padding(uint8_t* pu8_data, size_t t_len, uint8_t u8_block_size) {
+    size_t t_new_len = ((t_len / u8_block_size) + 1) * u8_block_size;
+    memset(&pu8_data[t_len], (int)(t_new_len - t_len), t_new_len - t_len);
+    return t_new_len;
+}
+
+/*******************************************************************************
+ *
+ * NAME: b_pkcs7_unpadding
+ *
+ * DESCRIPTION:PKCS#7アンパディング（sts_crypto_pkcs7_unpaddingと同一の判定）
+ *
+ * PARAMETERS:      Name            RW  Usage
+ * const uint8_t*   pu8_data        R   アンパディング対象
+ * size_t           t_len           R   アンパディング対象の長さ
+ * uint8_t          u8_block_size   R   ブロックサイズ
+ * size_t*          pt_len          W   アンパディング後の長さ
+ *
+ * RETURNS:
+ *   true:正常終了、false:パディングエラー
+ *
+ * NOTES:
+ * パディング値が0またはブロックサイズを超える場合はパディングエラー
+ ******************************************************************************/
+static bool b_pkcs7_unpadding(const uint8_t* pu8_data, size_t t_len, uint8_t u8_block_size, size_t* pt_len) {
+    if (t_len < u8_block_size || (t_len % u8_block_size) != 0) {
+        return false;
+    }
+    uint8_t u8_padding = pu8_data[t_len - 1];
+    if (u8_padding == 0 || u8_padding > u8_block_size) {
+        return false;
+    }
+    size_t t_idx;
+    for (t_idx = t_len - u8_padding; t_idx < t_len; t_idx++) {
+        if (pu8_data[t_idx] != u8_padding) {
+            return false;
+        }
+    }
+    *pt_len = t_len - u8_padding;
+    return true;
+}
+
+/*******************************************************************************
+ *
+ * NAME: i_test_entropy
+ *
+ * DESCRIPTION:既知のエントロピー源（テストベクタの入力を順に返却）
+ *
+ * PARAMETERS:      Name            RW  Usage
+ * void*            pv_ctx          RW  エントロピー源（ts_test_entropy_t）
+ * unsigned char*   puc_output      W   エントロピーの出力先
+ * size_t           t_len           R   要求サイズ
+ *
+ * RETURNS:
+ *   int:0（正常終了）、-1（エントロピー不足）
+ *
+ * NOTES:
+ * None.
+ ******************************************************************************/
+static int i_test_entropy(void* pv_ctx, unsigned char* puc_output, size_t t_len) {
+    ts_test_entropy_t* ps_entropy = (ts_test_entropy_t*)pv_ctx;
+    if (ps_entropy->t_pos + t_len > sizeof(ps_entropy->u8_pool)) {
+        return -1;
+    }
+    memcpy(puc_output, &ps_entropy->u8_pool[ps_entropy->t_pos], t_len);
+    ps_entropy->t_pos += t_len;
+    return 0;
+}
+
+/*******************************************************************************
+ *
+ * NAME: i_bench_entropy
+ *
+ * DESCRIPTION:計測用のエントロピー源
+ *
+ * PARAMETERS:      Name            RW  Usage
+ * void*            pv_ctx          R   未使用
+ * unsigned char*   puc_output      W   エントロピーの出力先
+ * size_t           t_len           R   要求サイズ
+ *
+ * RETURNS:
+ *   int:0（正常終了）
+ *
+ * NOTES:
+ * 計測専用の為、暗号論的な品質は持たない
+ ******************************************************************************/
+static int i_bench_entropy(void* pv_ctx, unsigned char* puc_output, size_t t_len) {
+    (void)pv_ctx;
+    size_t t_idx;
+    for (t_idx = 0; t_idx < t_len; t_idx++) {
+        puc_output[t_idx] = (unsigned char)rand();
+    }
+    return 0;
+}
+
+/*******************************************************************************
+ *
+ * NAME: i64_now_nsec
+ *
+ * DESCRIPTION:現在時刻（ナノ秒）
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *
+ * RETURNS:
+ *   int64_t:単調増加時刻（ナノ秒）
+ *
+ * NOTES:
+ * None.
+ ******************************************************************************/
+static int64_t i64_now_nsec() {
+    struct timespec s_ts;
+    clock_gettime(CLOCK_MONOTONIC, &s_ts);
+    return (int64_t)s_ts.tv_sec * 1000000000LL + (int64_t)s_ts.tv_nsec;
+}
+
+/*******************************************************************************
+ *
+ * NAME: v_print_rate
+ *
+ * DESCRIPTION:スループット表示
+ *
+ * PARAMETERS:      Name            RW  Usage
+ * const char*      pc_name         R   アルゴリズム名
+ * size_t           t_len           R   ペイロード長
+ * uint32_t         u32_loop_cnt    R   計測回数
+ * int64_t          i64_nsec        R   経過時間（ナノ秒）
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * None.
+ ******************************************************************************/
+static void v_print_rate(const char* pc_name, size_t t_len, uint32_t u32_loop_cnt, int64_t i64_nsec) {
+    if (i64_nsec <= 0) {
+        i64_nsec = 1;
+    }
+    double d_sec = (double)i64_nsec / 1000000000.0;
+    printf("%-20s len=%4zu %10.0f op/s %8.1f MB/s\n",
+           pc_name, t_len,
+           (double)u32_loop_cnt / d_sec,
+           ((double)u32_loop_cnt * t_len) / d_sec / (1024.0 * 1024.0));
+}
+
+/*******************************************************************************
+ *
+ * NAME: b_benchmark
+ *
+ * DESCRIPTION:ペイロード長毎のスループット計測
+ *
+ * PARAMETERS:      Name            RW  Usage
+ * uint32_t         u32_loop_cnt    R   計測回数
+ *
+ * RETURNS:
+ *   true:正常終了
+ *
+ * NOTES:
+ * 鍵スケジュール展開済みのコンテキストを使い回す（ntfw_cryptography.cと同一の使い方）。
+ * X25519はペイロード長に依存しない為、1回あたりの処理時間を表示する
+ ******************************************************************************/
+static bool b_benchmark(uint32_t u32_loop_cnt) {
+    //==========================================================================
+    // 計測データの生成
+    //==========================================================================
+    static uint8_t u8_msg[TEST_MAX_PAYLOAD_LEN];
+    uint8_t u8_key[32];
+    uint8_t u8_iv[TEST_AES_BLOCK_SIZE];
+    uint8_t u8_add[TEST_ADD_LEN] = {0x00};
+    uint8_t u8_tag[TEST_GCM_TAG_LEN];
+    uint8_t u8_hash[TEST_MAX_HASH_LEN];
+    size_t t_idx;
+    for (t_idx = 0; t_idx < sizeof(u8_key); t_idx++) {
+        u8_key[t_idx] = (uint8_t)rand();
+    }
+    for (t_idx = 0; t_idx < sizeof(u8_iv); t_idx++) {
+        u8_iv[t_idx] = (uint8_t)rand();
+    }
+    for (t_idx = 0; t_idx < sizeof(u8_msg); t_idx++) {
+        u8_msg[t_idx] = (uint8_t)rand();
+    }
+    //==========================================================================
+    // コンテキストの生成
+    //==========================================================================
+    const mbedtls_md_info_t* ps_sha1 = mbedtls_md_info_from_type(MBEDTLS_MD_SHA1);
+    const mbedtls_md_info_t* ps_sha256 = mbedtls_md_info_from_type(MBEDTLS_MD_SHA256);
+    const mbedtls_md_info_t* ps_sha512 = mbedtls_md_info_from_type(MBEDTLS_MD_SHA512);
+    mbedtls_aes_context s_aes_ctx;
+    mbedtls_gcm_context s_gcm_ctx;
+    mbedtls_ctr_drbg_context s_drbg_ctx;
+    mbedtls_aes_init(&s_aes_ctx);
+    mbedtls_gcm_init(&s_gcm_ctx);
+    mbedtls_ctr_drbg_init(&s_drbg_ctx);
+    bool b_result = false;
+    do {
+        if (ps_sha1 == NULL || ps_sha256 == NULL || ps_sha512 == NULL) {
+            break;
+        }
+        if (mbedtls_aes_setkey_enc(&s_aes_ctx, u8_key, sizeof(u8_key) * 8) != 0) {
+            break;
+        }
+        if (mbedtls_gcm_setkey(&s_gcm_ctx, MBEDTLS_CIPHER_ID_AES, u8_key, sizeof(u8_key) * 8) != 0) {
+            break;
+        }
+        if (mbedtls_ctr_drbg_seed(&s_drbg_ctx, i_bench_entropy, NULL, NULL, 0) != 0) {
+            break;
+        }
+        //======================================================================
+        // ペイロード長毎の計測
+        //======================================================================
+        printf("loop count:%u\n", (unsigned)u32_loop_cnt);
+        size_t t_len_idx;
+        uint32_t u32_cnt;
+        for (t_len_idx = 0; t_len_idx < TEST_ARRAY_CNT(s_payload_len); t_len_idx++) {
+            size_t t_len = s_payload_len[t_len_idx];
+            //------------------------------------------------------------------
+            // SHA-1/SHA-256/SHA-512（mbedTLS）
+            //------------------------------------------------------------------
+            int64_t i64_begin = i64_now_nsec();
+            for (u32_cnt = 0; u32_cnt < u32_loop_cnt; u32_cnt++) {
+                mbedtls_md(ps_sha1, u8_msg, t_len, u8_hash);
+            }
+            v_print_rate("sha1", t_len, u32_loop_cnt, i64_now_nsec() - i64_begin);
+            i64_begin = i64_now_nsec();
+            for (u32_cnt = 0; u32_cnt < u32_loop_cnt; u32_cnt++) {
+                mbedtls_md(ps_sha256, u8_msg, t_len, u8_hash);
+            }
+            v_print_rate("sha256(mbedtls)", t_len, u32_loop_cnt, i64_now_nsec() - i64_begin);
+            i64_begin = i64_now_nsec();
+            for (u32_cnt = 0; u32_cnt < u32_loop_cnt; u32_cnt++) {
+                mbedtls_md(ps_sha512, u8_msg, t_len, u8_hash);
+            }
+            v_print_rate("sha512", t_len, u32_loop_cnt, i64_now_nsec() - i64_begin);
+            //------------------------------------------------------------------
+            // SHA-256（ポータブル実装）
+            //------------------------------------------------------------------
+            i64_begin = i64_now_nsec();
+            for (u32_cnt = 0; u32_cnt < u32_loop_cnt; u32_cnt++) {
+                v_sha256(u8_msg, t_len, false, u8_hash);
+            }
+            v_print_rate("sha256(portable)", t_len, u32_loop_cnt, i64_now_nsec() - i64_begin);
+            //------------------------------------------------------------------
+            // HMAC-SHA256
+            //------------------------------------------------------------------
+            i64_begin = i64_now_nsec();
+            for (u32_cnt = 0; u32_cnt < u32_loop_cnt; u32_cnt++) {
+                mbedtls_md_hmac(ps_sha256, u8_key, sizeof(u8_key), u8_msg, t_len, u8_hash);
+            }
+            v_print_rate("hmac-sha256", t_len, u32_loop_cnt, i64_now_nsec() - i64_begin);
+            //------------------------------------------------------------------
+            // AES-256-ECB/CBC/CTR
+            //------------------------------------------------------------------
+            i64_begin = i64_now_nsec();
+            for (u32_cnt = 0; u32_cnt < u32_loop_cnt; u32_cnt++) {
+                for (t_idx = 0; t_idx < t_len; t_idx += TEST_AES_BLOCK_SIZE) {
+                    mbedtls_aes_crypt_ecb(&s_aes_ctx, MBEDTLS_AES_ENCRYPT, &u8_msg[t_idx], &u8_msg[t_idx]);
+                }
+            }
+            v_print_rate("aes-256-ecb", t_len, u32_loop_cnt, i64_now_nsec() - i64_begin);
+            i64_begin = i64_now_nsec();
+            for (u32_cnt = 0; u32_cnt < u32_loop_cnt; u32_cnt++) {
+                mbedtls_aes_crypt_cbc(&s_aes_ctx, MBEDTLS_AES_ENCRYPT, t_len, u8_iv, u8_msg, u8_msg);
+            }
+            v_print_rate("aes-256-cbc", t_len, u32_loop_cnt, i64_now_nsec() - i64_begin);
+            uint8_t u8_stream[TEST_AES_BLOCK_SIZE];
+            size_t t_nc_off = 0;
+            i64_begin = i64_now_nsec();
+            for (u32_cnt = 0; u32_cnt < u32_loop_cnt; u32_cnt++) {
+                mbedtls_aes_crypt_ctr(&s_aes_ctx, t_len, &t_nc_off, u8_iv, u8_stream, u8_msg, u8_msg);
+            }
+            v_print_rate("aes-256-ctr", t_len, u32_loop_cnt, i64_now_nsec() - i64_begin);
+            //------------------------------------------------------------------
+            // AES-256-GCM
+            //------------------------------------------------------------------
+            i64_begin = i64_now_nsec();
+            for (u32_cnt = 0; u32_cnt < u32_loop_cnt; u32_cnt++) {
+                mbedtls_gcm_crypt_and_tag(&s_gcm_ctx, MBEDTLS_GCM_ENCRYPT, t_len,
+                                          u8_iv, 12, u8_add, sizeof(u8_add),
+                                          u8_msg, u8_msg, sizeof(u8_tag), u8_tag);
+            }
+            v_print_rate("aes-256-gcm", t_len, u32_loop_cnt, i64_now_nsec() - i64_begin);
+            //------------------------------------------------------------------
+            // ChaCha20-Poly1305
+            //------------------------------------------------------------------
+            i64_begin = i64_now_nsec();
+            for (u32_cnt = 0; u32_cnt < u32_loop_cnt; u32_cnt++) {
+                v_crypto_chachapoly_enc_in_place(u8_key, u8_iv, u8_add, sizeof(u8_add), u8_msg, t_len, u8_tag);
+            }
+            v_print_rate("chacha20-poly1305", t_len, u32_loop_cnt, i64_now_nsec() - i64_begin);
+            //------------------------------------------------------------------
+            // CTR-DRBG（1回の要求の最大長毎に分割）
+            //------------------------------------------------------------------
+            i64_begin = i64_now_nsec();
+            for (u32_cnt = 0; u32_cnt < u32_loop_cnt; u32_cnt++) {
+                for (t_idx = 0; t_idx < t_len; t_idx += TEST_DRBG_MAX_REQUEST) {
+                    size_t t_chunk = t_len - t_idx;
+                    if (t_chunk > TEST_DRBG_MAX_REQUEST) {
+                        t_chunk = TEST_DRBG_MAX_REQUEST;
+                    }
+                    mbedtls_ctr_drbg_random(&s_drbg_ctx, &u8_msg[t_idx], t_chunk);
+                }
+            }
+            v_print_rate("ctr-drbg", t_len, u32_loop_cnt, i64_now_nsec() - i64_begin);
+        }
+        //======================================================================
+        // X25519（共有鍵算出）
+        //======================================================================
+        uint8_t u8_scalar[CRYPTO_X25519_BYTES];
+        uint8_t u8_point[CRYPTO_X25519_BYTES];
+        for (t_idx = 0; t_idx < sizeof(u8_scalar); t_idx++) {
+            u8_scalar[t_idx] = (uint8_t)rand();
+        }
+        v_crypto_x25519_public_key(u8_point, u8_scalar);
+        uint32_t u32_x25519_cnt = u32_loop_cnt / TEST_X25519_LOOP_DIV;
+        if (u32_x25519_cnt == 0) {
+            u32_x25519_cnt = 1;
+        }
+        int64_t i64_begin = i64_now_nsec();
+        for (u32_cnt = 0; u32_cnt < u32_x25519_cnt; u32_cnt++) {
+            b_crypto_x25519_scalarmult(u8_point, u8_scalar, u8_point);
+        }
+        int64_t i64_nsec = i64_now_nsec() - i64_begin;
+        if (i64_nsec <= 0) {
+            i64_nsec = 1;
+        }
+        printf("%-20s          %10.0f op/s %8.1f us/op\n", "x25519",
+               (double)u32_x25519_cnt * 1000000000.0 / (double)i64_nsec,
+               (double)i64_nsec / 1000.0 / (double)u32_x25519_cnt);
+        b_result = true;
+    } while (false);
+    // コンテキストの解放
+    mbedtls_ctr_drbg_free(&s_drbg_ctx);
+    mbedtls_gcm_free(&s_gcm_ctx);
+    mbedtls_aes_free(&s_aes_ctx);
+    if (!b_result) {
+        fprintf(stderr, "benchmark setup:NG\n");
+    }
+    return b_result;
+}
+
+/*******************************************************************************
+ *
+ * NAME: b_test_sha256_vector
+ *
+ * DESCRIPTION:SHA-256：FIPS 180-2のテストベクタ
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *
+ * RETURNS:
+ *   true:一致
+ *
+ * NOTES:
+ * 空文字列、"abc"、2ブロックメッセージを検証する
+ ******************************************************************************/
+static bool b_test_sha256_vector() {
+    uint8_t u8_out[CRYPTO_SHA256_DIGEST_SIZE];
+    v_sha256((const uint8_t*)"", 0, false, u8_out);
+    if (!b_equals_hex(u8_out, "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855")) {
+        return false;
+    }
+    v_sha256((const uint8_t*)"abc", 3, false, u8_out);
+    if (!b_equals_hex(u8_out, "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad")) {
+        return false;
+    }
+    const char* pc_msg = "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq";
+    v_sha256((const uint8_t*)pc_msg, strlen(pc_msg), false, u8_out);
+    return b_equals_hex(u8_out, "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1");
+}
+
+/*******************************************************************************
+ *
+ * NAME: b_test_sha224_vector
+ *
+ * DESCRIPTION:SHA-224：FIPS 180-2のテストベクタ
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *
+ * RETURNS:
+ *   true:一致
+ *
+ * NOTES:
+ * "abc"と2ブロックメッセージを検証する
+ ******************************************************************************/
+static bool b_test_sha224_vector() {
+    uint8_t u8_out[CRYPTO_SHA256_DIGEST_SIZE];
+    v_sha256((const uint8_t*)"abc", 3, true, u8_out);
+    if (!b_equals_hex(u8_out, "23097d223405d8228642a477bda255b32aadbce4bda0b3f7e36c9da7")) {
+        return false;
+    }
+    const char* pc_msg = "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq";
+    v_sha256((const uint8_t*)pc_msg, strlen(pc_msg), true, u8_out);
+    return b_equals_hex(u8_out, "75388b16512776cc5dba5da1fd890150b0c6455cb4f58b1952522525");
+}
+
+/*******************************************************************************
+ *
+ * NAME: b_test_sha256_million
+ *
+ * DESCRIPTION:SHA-256：100万文字の"a"（不揃いな分割での逐次計算）
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *
+ * RETURNS:
+ *   true:一致
+ *
+ * NOTES:
+ * None.
+ ******************************************************************************/
+static bool b_test_sha256_million() {
+    ts_crypto_sha256_context_t s_ctx;
+    uint8_t u8_out[CRYPTO_SHA256_DIGEST_SIZE];
+    uint8_t u8_blk[97];
+    memset(u8_blk, 'a', sizeof(u8_blk));
+    v_crypto_sha256_starts(&s_ctx, false);
+    size_t t_rem = 1000000;
+    size_t t_len = 1;
+    while (t_rem > 0) {
+        size_t t_wk = (t_len < t_rem) ? t_len : t_rem;
+        v_crypto_sha256_update(&s_ctx, u8_blk, t_wk);
+        t_rem -= t_wk;
+        t_len = (t_len % sizeof(u8_blk)) + 1;
+    }
+    v_crypto_sha256_finish(&s_ctx, u8_out);
+    return b_equals_hex(u8_out, "cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0");
+}
+
+/*******************************************************************************
+ *
+ * NAME: b_test_sha256_boundary
+ *
+ * DESCRIPTION:SHA-256：ブロック境界前後の長さでの逐次計算
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *
+ * RETURNS:
+ *   true:一致
+ *
+ * NOTES:
+ * 0～200バイトの各長さで、一括計算と全分割位置での2分割計算の結果が一致する事を検証する
+ * （パディングが1ブロックと2ブロックになる55/56バイト前後を含む）
+ ******************************************************************************/
+static bool b_test_sha256_boundary() {
+    uint8_t u8_data[200];
+    uint8_t u8_exp[CRYPTO_SHA256_DIGEST_SIZE];
+    uint8_t u8_out[CRYPTO_SHA256_DIGEST_SIZE];
+    ts_crypto_sha256_context_t s_ctx;
+    size_t t_idx;
+    for (t_idx = 0; t_idx < sizeof(u8_data); t_idx++) {
+        u8_data[t_idx] = (uint8_t)(t_idx * 7 + 3);
+    }
+    size_t t_len;
+    size_t t_split;
+    for (t_len = 0; t_len <= sizeof(u8_data); t_len++) {
+        v_sha256(u8_data, t_len, false, u8_exp);
+        for (t_split = 0; t_split <= t_len; t_split++) {
+            v_crypto_sha256_starts(&s_ctx, false);
+            v_crypto_sha256_update(&s_ctx, u8_data, t_split);
+            v_crypto_sha256_update(&s_ctx, &u8_data[t_split], t_len - t_split);
+            v_crypto_sha256_finish(&s_ctx, u8_out);
+            if (memcmp(u8_out, u8_exp, sizeof(u8_out)) != 0) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+/*******************************************************************************
+ *
+ * NAME: b_test_sha256_clone
+ *
+ * DESCRIPTION:SHA-256：計算途中の状態の複製と再開
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *
+ * RETURNS:
+ *   true:一致
+ *
+ * NOTES:
+ * v_crypto_be_sha256_cloneと同様に構造体の複製で状態を複製し、
+ * 同一の途中状態から異なるデータで再開しても互いに影響しない事を検証する
+ ******************************************************************************/
+static bool b_test_sha256_clone() {
+    const char* pc_msg = "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq";
+    size_t t_len = strlen(pc_msg);
+    uint8_t u8_out[CRYPTO_SHA256_DIGEST_SIZE];
+    ts_crypto_sha256_context_t s_base;
+    v_crypto_sha256_starts(&s_base, false);
+    v_crypto_sha256_update(&s_base, (const uint8_t*)pc_msg, 3);
+    // 複製した状態で"abc"を完了
+    ts_crypto_sha256_context_t s_clone = s_base;
+    v_crypto_sha256_finish(&s_clone, u8_out);
+    if (!b_equals_hex(u8_out, "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad")) {
+        return false;
+    }
+    // 元の状態で2ブロックメッセージを完了
+    v_crypto_sha256_update(&s_base, (const uint8_t*)&pc_msg[3], t_len - 3);
+    v_crypto_sha256_finish(&s_base, u8_out);
+    return b_equals_hex(u8_out, "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1");
+}
+
+/*******************************************************************************
+ *
+ * NAME: b_test_hmac_vector
+ *
+ * DESCRIPTION:HMAC-SHA256：RFC 4231のテストベクタ
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *
+ * RETURNS:
+ *   true:一致
+ *
+ * NOTES:
+ * ブロックサイズを超えるキー（テストケース6、7）を含む
+ ******************************************************************************/
+static bool b_test_hmac_vector() {
+    uint8_t u8_key[TEST_MAX_DATA_LEN];
+    uint8_t u8_data[TEST_MAX_DATA_LEN];
+    uint8_t u8_mac[CRYPTO_SHA256_DIGEST_SIZE];
+    size_t t_idx;
+    for (t_idx = 0; t_idx < TEST_ARRAY_CNT(s_hmac_vectors); t_idx++) {
+        const ts_hmac_vector_t* ps_vec = &s_hmac_vectors[t_idx];
+        size_t t_key_len = t_hex_to_bytes(ps_vec->pc_key, u8_key);
+        size_t t_data_len = t_hex_to_bytes(ps_vec->pc_data, u8_data);
+        v_hmac_sha256(u8_key, t_key_len, u8_data, t_data_len, u8_mac);
+        if (!b_equals_hex(u8_mac, ps_vec->pc_mac256)) {
+            fprintf(stderr, "  rfc4231 vector #%zu mismatch\n", t_idx);
+            return false;
+        }
+    }
+    return true;
+}
+
+/*******************************************************************************
+ *
+ * NAME: b_test_md_vector
+ *
+ * DESCRIPTION:SHA-1/SHA-2（mbedTLS）：FIPS 180-2のテストベクタ
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *
+ * RETURNS:
+ *   true:一致
+ *
+ * NOTES:
+ * SHA-1/SHA-224/SHA-256は448ビット、SHA-384/SHA-512は896ビットの2ブロックメッセージを含む
+ ******************************************************************************/
+static bool b_test_md_vector() {
+    uint8_t u8_out[TEST_MAX_HASH_LEN];
+    size_t t_idx;
+    for (t_idx = 0; t_idx < TEST_ARRAY_CNT(s_md_vectors); t_idx++) {
+        const ts_md_vector_t* ps_vec = &s_md_vectors[t_idx];
+        if (!b_md_stretching(ps_vec->e_type, (const uint8_t*)ps_vec->pc_msg, strlen(ps_vec->pc_msg),
+                             ps_vec->u32_stretching, u8_out) ||
+            !b_equals_hex(u8_out, ps_vec->pc_hash)) {
+            fprintf(stderr, "  fips180-2 vector #%zu mismatch\n", t_idx);
+            return false;
+        }
+    }
+    return true;
+}
+
+/*******************************************************************************
+ *
+ * NAME: b_test_md_stretching
+ *
+ * DESCRIPTION:SHA-1/SHA-2（mbedTLS）：ストレッチング
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *
+ * RETURNS:
+ *   true:一致
+ *
+ * NOTES:
+ * ストレッチング回数1と1,000回の既知解を検証する
+ ******************************************************************************/
+static bool b_test_md_stretching() {
+    uint8_t u8_out[TEST_MAX_HASH_LEN];
+    size_t t_idx;
+    for (t_idx = 0; t_idx < TEST_ARRAY_CNT(s_stretching_vectors); t_idx++) {
+        const ts_md_vector_t* ps_vec = &s_stretching_vectors[t_idx];
+        if (!b_md_stretching(ps_vec->e_type, (const uint8_t*)ps_vec->pc_msg, strlen(ps_vec->pc_msg),
+                             ps_vec->u32_stretching, u8_out) ||
+            !b_equals_hex(u8_out, ps_vec->pc_hash)) {
+            fprintf(stderr, "  stretching vector #%zu mismatch\n", t_idx);
+            return false;
+        }
+    }
+    return true;
+}
+
+/*******************************************************************************
+ *
+ * NAME: b_test_md_hmac_vector
+ *
+ * DESCRIPTION:HMAC-SHA256/SHA512（mbedTLS）：RFC 4231のテストベクタ
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *
+ * RETURNS:
+ *   true:一致
+ *
+ * NOTES:
+ * ブロックサイズを超えるキー（テストケース6、7）を含む
+ ******************************************************************************/
+static bool b_test_md_hmac_vector() {
+    const mbedtls_md_info_t* ps_sha256 = mbedtls_md_info_from_type(MBEDTLS_MD_SHA256);
+    const mbedtls_md_info_t* ps_sha512 = mbedtls_md_info_from_type(MBEDTLS_MD_SHA512);
+    if (ps_sha256 == NULL || ps_sha512 == NULL) {
+        return false;
+    }
+    uint8_t u8_key[TEST_MAX_DATA_LEN];
+    uint8_t u8_data[TEST_MAX_DATA_LEN];
+    uint8_t u8_mac[TEST_MAX_HASH_LEN];
+    size_t t_idx;
+    for (t_idx = 0; t_idx < TEST_ARRAY_CNT(s_hmac_vectors); t_idx++) {
+        const ts_hmac_vector_t* ps_vec = &s_hmac_vectors[t_idx];
+        size_t t_key_len = t_hex_to_bytes(ps_vec->pc_key, u8_key);
+        size_t t_data_len = t_hex_to_bytes(ps_vec->pc_data, u8_data);
+        if (mbedtls_md_hmac(ps_sha256, u8_key, t_key_len, u8_data, t_data_len, u8_mac) != 0 ||
+            !b_equals_hex(u8_mac, ps_vec->pc_mac256)) {
+            fprintf(stderr, "  rfc4231 sha256 vector #%zu mismatch\n", t_idx);
+            return false;
+        }
+        if (mbedtls_md_hmac(ps_sha512, u8_key, t_key_len, u8_data, t_data_len, u8_mac) != 0 ||
+            !b_equals_hex(u8_mac, ps_vec->pc_mac512)) {
+            fprintf(stderr, "  rfc4231 sha512 vector #%zu mismatch\n", t_idx);
+            return false;
+        }
+    }
+    return true;
+}
+
+/*******************************************************************************
+ *
+ * NAME: b_test_aes_ecb_vector
+ *
+ * DESCRIPTION:AES-ECB：FIPS 197 C.3とSP 800-38A F.1のテストベクタ
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *
+ * RETURNS:
+ *   true:一致
+ *
+ * NOTES:
+ * AES-128（F.1.1）とAES-256（C.3、F.1.5）の暗号化と復号を検証する
+ ******************************************************************************/
+static bool b_test_aes_ecb_vector() {
+    const char* pc_cipher128 =
+        "3ad77bb40d7a3660a89ecaf32466ef97f5d3d58503b9699de785895a96fdbaaf"
+        "43b1cd7f598ece23881b00e3ed0306887b0c785e27e8ad3f8223207104725dd4";
+    const char* pc_cipher256 =
+        "f3eed1bdb5d2a03c064b5a7e3db181f8591ccb10d410ed26dc5ba74a31362870"
+        "b6ed21b99ca6f4f9f153e7b1beafed1d23304b7a39f9f3ff067d8d8f9e24ecc7";
+    uint8_t u8_key[32];
+    uint8_t u8_plain[64];
+    uint8_t u8_data[64];
+    size_t t_len = t_hex_to_bytes(pc_sp800_38a_plain, u8_plain);
+    mbedtls_aes_context s_ctx;
+    mbedtls_aes_init(&s_ctx);
+    bool b_result = false;
+    size_t t_idx;
+    do {
+        //----------------------------------------------------------------------
+        // FIPS 197 C.3（AES-256）
+        //----------------------------------------------------------------------
+        t_hex_to_bytes("000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f", u8_key);
+        t_hex_to_bytes("00112233445566778899aabbccddeeff", u8_data);
+        if (mbedtls_aes_setkey_enc(&s_ctx, u8_key, 256) != 0 ||
+            mbedtls_aes_crypt_ecb(&s_ctx, MBEDTLS_AES_ENCRYPT, u8_data, u8_data) != 0 ||
+            !b_equals_hex(u8_data, "8ea2b7ca516745bfeafc49904b496089")) {
+            break;
+        }
+        //----------------------------------------------------------------------
+        // SP 800-38A F.1.1（AES-128）とF.1.5（AES-256）
+        //----------------------------------------------------------------------
+        const char* pc_keys[] = {pc_sp800_38a_key128, pc_sp800_38a_key256};
+        const char* pc_ciphers[] = {pc_cipher128, pc_cipher256};
+        size_t t_vec;
+        for (t_vec = 0; t_vec < TEST_ARRAY_CNT(pc_keys); t_vec++) {
+            unsigned int u_bits = (unsigned int)t_hex_to_bytes(pc_keys[t_vec], u8_key) * 8;
+            if (mbedtls_aes_setkey_enc(&s_ctx, u8_key, u_bits) != 0) {
+                break;
+            }
+            for (t_idx = 0; t_idx < t_len; t_idx += TEST_AES_BLOCK_SIZE) {
+                mbedtls_aes_crypt_ecb(&s_ctx, MBEDTLS_AES_ENCRYPT, &u8_plain[t_idx], &u8_data[t_idx]);
+            }
+            if (!b_equals_hex(u8_data, pc_ciphers[t_vec])) {
+                break;
+            }
+            if (mbedtls_aes_setkey_dec(&s_ctx, u8_key, u_bits) != 0) {
+                break;
+            }
+            for (t_idx = 0; t_idx < t_len; t_idx += TEST_AES_BLOCK_SIZE) {
+                mbedtls_aes_crypt_ecb(&s_ctx, MBEDTLS_AES_DECRYPT, &u8_data[t_idx], &u8_data[t_idx]);
+            }
+            if (memcmp(u8_data, u8_plain, t_len) != 0) {
+                break;
+            }
+        }
+        b_result = (t_vec == TEST_ARRAY_CNT(pc_keys));
+    } while (false);
+    mbedtls_aes_free(&s_ctx);
+    return b_result;
+}
+
+/*******************************************************************************
+ *
+ * NAME: b_test_aes_cbc_vector
+ *
+ * DESCRIPTION:AES-CBC：SP 800-38A F.2のテストベクタ
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *
+ * RETURNS:
+ *   true:一致
+ *
+ * NOTES:
+ * AES-128（F.2.1）とAES-256（F.2.5）の暗号化と復号を検証する
+ ******************************************************************************/
+static bool b_test_aes_cbc_vector() {
+    const char* pc_keys[] = {pc_sp800_38a_key128, pc_sp800_38a_key256};
+    const char* pc_ciphers[] = {
+        "7649abac8119b246cee98e9b12e9197d5086cb9b507219ee95db113a917678b2"
+        "73bed6b8e3c1743b7116e69e222295163ff1caa1681fac09120eca307586e1a7",
+        "f58c4c04d6e5f1ba779eabfb5f7bfbd69cfc4e967edb808d679f777bc6702c7d"
+        "39f23369a9d9bacfa530e26304231461b2eb05e2c39be9fcda6c19078c6a9d1b"
+    };
+    uint8_t u8_key[32];
+    uint8_t u8_iv[TEST_AES_BLOCK_SIZE];
+    uint8_t u8_plain[64];
+    uint8_t u8_data[64];
+    size_t t_len = t_hex_to_bytes(pc_sp800_38a_plain, u8_plain);
+    mbedtls_aes_context s_ctx;
+    mbedtls_aes_init(&s_ctx);
+    size_t t_vec;
+    for (t_vec = 0; t_vec < TEST_ARRAY_CNT(pc_keys); t_vec++) {
+        unsigned int u_bits = (unsigned int)t_hex_to_bytes(pc_keys[t_vec], u8_key) * 8;
+        // 暗号化
+        t_hex_to_bytes("000102030405060708090a0b0c0d0e0f", u8_iv);
+        if (mbedtls_aes_setkey_enc(&s_ctx, u8_key, u_bits) != 0 ||
+            mbedtls_aes_crypt_cbc(&s_ctx, MBEDTLS_AES_ENCRYPT, t_len, u8_iv, u8_plain, u8_data) != 0 ||
+            !b_equals_hex(u8_data, pc_ciphers[t_vec])) {
+            break;
+        }
+        // 復号
+        t_hex_to_bytes("000102030405060708090a0b0c0d0e0f", u8_iv);
+        if (mbedtls_aes_setkey_dec(&s_ctx, u8_key, u_bits) != 0 ||
+            mbedtls_aes_crypt_cbc(&s_ctx, MBEDTLS_AES_DECRYPT, t_len, u8_iv, u8_data, u8_data) != 0 ||
+            memcmp(u8_data, u8_plain, t_len) != 0) {
+            break;
+        }
+    }
+    mbedtls_aes_free(&s_ctx);
+    return (t_vec == TEST_ARRAY_CNT(pc_keys));
+}
+
+/*******************************************************************************
+ *
+ * NAME: b_test_aes_ctr_vector
+ *
+ * DESCRIPTION:AES-CTR：SP 800-38A F.5のテストベクタ
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *
+ * RETURNS:
+ *   true:一致
+ *
+ * NOTES:
+ * AES-128（F.5.1）とAES-256（F.5.5）を、ブロック境界と異なる位置で分割して検証する
+ ******************************************************************************/
+static bool b_test_aes_ctr_vector() {
+    const char* pc_keys[] = {pc_sp800_38a_key128, pc_sp800_38a_key256};
+    const char* pc_ciphers[] = {
+        "874d6191b620e3261bef6864990db6ce9806f66b7970fdff8617187bb9fffdff"
+        "5ae4df3edbd5d35e5b4f09020db03eab1e031dda2fbe03d1792170a0f3009cee",
+        "601ec313775789a5b7a7f504bbf3d228f443e3ca4d62b59aca84e990cacaf5c5"
+        "2b0930daa23de94ce87017ba2d84988ddfc9c58db67aada613c2dd08457941a6"
+    };
+    uint8_t u8_key[32];
+    uint8_t u8_counter[TEST_AES_BLOCK_SIZE];
+    uint8_t u8_stream[TEST_AES_BLOCK_SIZE];
+    uint8_t u8_plain[64];
+    uint8_t u8_data[64];
+    size_t t_len = t_hex_to_bytes(pc_sp800_38a_plain, u8_plain);
+    mbedtls_aes_context s_ctx;
+    mbedtls_aes_init(&s_ctx);
+    size_t t_vec;
+    for (t_vec = 0; t_vec < TEST_ARRAY_CNT(pc_keys); t_vec++) {
+        unsigned int u_bits = (unsigned int)t_hex_to_bytes(pc_keys[t_vec], u8_key) * 8;
+        size_t t_nc_off = 0;
+        t_hex_to_bytes("f0f1f2f3f4f5f6f7f8f9fafbfcfdfeff", u8_counter);
+        if (mbedtls_aes_setkey_enc(&s_ctx, u8_key, u_bits) != 0 ||
+            mbedtls_aes_crypt_ctr(&s_ctx, 7, &t_nc_off, u8_counter, u8_stream, u8_plain, u8_data) != 0 ||
+            mbedtls_aes_crypt_ctr(&s_ctx, t_len - 7, &t_nc_off, u8_counter, u8_stream,
+                                  &u8_plain[7], &u8_data[7]) != 0 ||
+            !b_equals_hex(u8_data, pc_ciphers[t_vec])) {
+            break;
+        }
+    }
+    mbedtls_aes_free(&s_ctx);
+    return (t_vec == TEST_ARRAY_CNT(pc_keys));
+}
+
+/*******************************************************************************
+ *
+ * NAME: b_test_aes_gcm_vector
+ *
+ * DESCRIPTION:AES-GCM：McGrew/Viegaのテストケースと改ざん検出
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *
+ * RETURNS:
+ *   true:一致
+ *
+ * NOTES:
+ * 認証タグ、暗号文、追加認証データのいずれを改ざんしても復号が失敗する事を検証する
+ ******************************************************************************/
+static bool b_test_aes_gcm_vector() {
+    uint8_t u8_key[32];
+    uint8_t u8_iv[12];
+    uint8_t u8_add[TEST_MAX_DATA_LEN];
+    uint8_t u8_plain[TEST_MAX_DATA_LEN];
+    uint8_t u8_cipher[TEST_MAX_DATA_LEN];
+    uint8_t u8_data[TEST_MAX_DATA_LEN];
+    uint8_t u8_tag[TEST_GCM_TAG_LEN];
+    mbedtls_gcm_context s_ctx;
+    mbedtls_gcm_init(&s_ctx);
+    size_t t_idx;
+    for (t_idx = 0; t_idx < TEST_ARRAY_CNT(s_gcm_vectors); t_idx++) {
+        const ts_gcm_vector_t* ps_vec = &s_gcm_vectors[t_idx];
+        unsigned int u_bits = (unsigned int)t_hex_to_bytes(ps_vec->pc_key, u8_key) * 8;
+        size_t t_iv_len = t_hex_to_bytes(ps_vec->pc_iv, u8_iv);
+        size_t t_add_len = t_hex_to_bytes(ps_vec->pc_add, u8_add);
+        size_t t_len = t_hex_to_bytes(ps_vec->pc_plain, u8_plain);
+        //----------------------------------------------------------------------
+        // 暗号化
+        //----------------------------------------------------------------------
+        if (mbedtls_gcm_setkey(&s_ctx, MBEDTLS_CIPHER_ID_AES, u8_key, u_bits) != 0 ||
+            mbedtls_gcm_crypt_and_tag(&s_ctx, MBEDTLS_GCM_ENCRYPT, t_len, u8_iv, t_iv_len,
+                                      u8_add, t_add_len, u8_plain, u8_cipher, sizeof(u8_tag), u8_tag) != 0 ||
+            !b_equals_hex(u8_cipher, ps_vec->pc_cipher) || !b_equals_hex(u8_tag, ps_vec->pc_tag)) {
+            break;
+        }
+        //----------------------------------------------------------------------
+        // 復号
+        //----------------------------------------------------------------------
+        if (mbedtls_gcm_auth_decrypt(&s_ctx, t_len, u8_iv, t_iv_len, u8_add, t_add_len,
+                                     u8_tag, sizeof(u8_tag), u8_cipher, u8_data) != 0 ||
+            memcmp(u8_data, u8_plain, t_len) != 0) {
+            break;
+        }
+        //----------------------------------------------------------------------
+        // 改ざん検出
+        //----------------------------------------------------------------------
+        // 認証タグ
+        u8_tag[0] ^= 0x01;
+        if (mbedtls_gcm_auth_decrypt(&s_ctx, t_len, u8_iv, t_iv_len, u8_add, t_add_len,
+                                     u8_tag, sizeof(u8_tag), u8_cipher, u8_data) == 0) {
+            break;
+        }
+        u8_tag[0] ^= 0x01;
+        // 暗号文
+        u8_cipher[t_len - 1] ^= 0x80;
+        if (mbedtls_gcm_auth_decrypt(&s_ctx, t_len, u8_iv, t_iv_len, u8_add, t_add_len,
+                                     u8_tag, sizeof(u8_tag), u8_cipher, u8_data) == 0) {
+            break;
+        }
+        u8_cipher[t_len - 1] ^= 0x80;
+        // 追加認証データ
+        if (t_add_len > 0) {
+            u8_add[0] ^= 0x01;
+            if (mbedtls_gcm_auth_decrypt(&s_ctx, t_len, u8_iv, t_iv_len, u8_add, t_add_len,
+                                         u8_tag, sizeof(u8_tag), u8_cipher, u8_data) == 0) {
+                break;
+            }
+        }
+    }
+    mbedtls_gcm_free(&s_ctx);
+    if (t_idx != TEST_ARRAY_CNT(s_gcm_vectors)) {
+        fprintf(stderr, "  gcm vector #%zu mismatch\n", t_idx);
+        return false;
+    }
+    return true;
+}
+
+/*******************************************************************************
+ *
+ * NAME: b_test_pkcs7_padding
+ *
+ * DESCRIPTION:PKCS#7：AES-CBCと組み合わせたパディングとパディングエラーの検出
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *
+ * RETURNS:
+ *   true:一致
+ *
+ * NOTES:
+ * SP 800-38A F.2.5の平文（ブロック長の倍数）に1ブロック分のパディングが付加され、
+ * 暗号文の先頭4ブロックがテストベクタと一致する事を検証する。
+ * パディング値0、ブロックサイズ超過、パディング値の不一致、端数の長さをエラーとする
+ ******************************************************************************/
+static bool b_test_pkcs7_padding() {
+    uint8_t u8_key[32];
+    uint8_t u8_iv[TEST_AES_BLOCK_SIZE];
+    uint8_t u8_plain[80];
+    uint8_t u8_data[80];
+    size_t t_unpad_len;
+    //--------------------------------------------------------------------------
+    // 各長さでのパディングとアンパディング
+    //--------------------------------------------------------------------------
+    size_t t_len;
+    for (t_len = 0; t_len <= 48; t_len++) {
+        memset(u8_data, 0xA5, t_len);
+        size_t t_pad_len = t_pkcs7_padding(u8_data, t_len, TEST_AES_BLOCK_SIZE);
+        if (t_pad_len != ((t_len / TEST_AES_BLOCK_SIZE) + 1) * TEST_AES_BLOCK_SIZE ||
+            u8_data[t_pad_len - 1] != (uint8_t)(t_pad_len - t_len)) {
+            return false;
+        }
+        if (!b_pkcs7_unpadding(u8_data, t_pad_len, TEST_AES_BLOCK_SIZE, &t_unpad_len) || t_unpad_len != t_len) {
+            return false;
+        }
+    }
+    //--------------------------------------------------------------------------
+    // AES-256-CBCとの組み合わせ
+    //--------------------------------------------------------------------------
+    size_t t_plain_len = t_hex_to_bytes(pc_sp800_38a_plain, u8_plain);
+    size_t t_pad_len = t_pkcs7_padding(u8_plain, t_plain_len, TEST_AES_BLOCK_SIZE);
+    unsigned int u_bits = (unsigned int)t_hex_to_bytes(pc_sp800_38a_key256, u8_key) * 8;
+    mbedtls_aes_context s_ctx;
+    mbedtls_aes_init(&s_ctx);
+    bool b_result = false;
+    do {
+        t_hex_to_bytes("000102030405060708090a0b0c0d0e0f", u8_iv);
+        if (mbedtls_aes_setkey_enc(&s_ctx, u8_key, u_bits) != 0 ||
+            mbedtls_aes_crypt_cbc(&s_ctx, MBEDTLS_AES_ENCRYPT, t_pad_len, u8_iv, u8_plain, u8_data) != 0) {
+            break;
+        }
+        if (t_pad_len != 80 ||
+            !b_equals_hex(u8_data,
+                "f58c4c04d6e5f1ba779eabfb5f7bfbd69cfc4e967edb808d679f777bc6702c7d"
+                "39f23369a9d9bacfa530e26304231461b2eb05e2c39be9fcda6c19078c6a9d1b"
+                "3f461796d6b0d6b2e0c2a72b4d80e644")) {
+            break;
+        }
+        t_hex_to_bytes("000102030405060708090a0b0c0d0e0f", u8_iv);
+        if (mbedtls_aes_setkey_dec(&s_ctx, u8_key, u_bits) != 0 ||
+            mbedtls_aes_crypt_cbc(&s_ctx, MBEDTLS_AES_DECRYPT, t_pad_len, u8_iv, u8_data, u8_data) != 0) {
+            break;
+        }
+        if (!b_pkcs7_unpadding(u8_data, t_pad_len, TEST_AES_BLOCK_SIZE, &t_unpad_len) ||
+            t_unpad_len != t_plain_len || memcmp(u8_data, u8_plain, t_plain_len) != 0) {
+            break;
+        }
+        b_result = true;
+    } while (false);
+    mbedtls_aes_free(&s_ctx);
+    if (!b_result) {
+        return false;
+    }
+    //--------------------------------------------------------------------------
+    // パディングエラー
+    //--------------------------------------------------------------------------
+    memset(u8_data, 0x04, 32);
+    // パディング値0
+    u8_data[31] = 0x00;
+    if (b_pkcs7_unpadding(u8_data, 32, TEST_AES_BLOCK_SIZE, &t_unpad_len)) {
+        return false;
+    }
+    // ブロックサイズ超過
+    memset(&u8_data[14], 0x11, 18);
+    if (b_pkcs7_unpadding(u8_data, 32, TEST_AES_BLOCK_SIZE, &t_unpad_len)) {
+        return false;
+    }
+    // パディング値の不一致
+    memset(&u8_data[28], 0x04, 4);
+    u8_data[29] = 0x05;
+    if (b_pkcs7_unpadding(u8_data, 32, TEST_AES_BLOCK_SIZE, &t_unpad_len)) {
+        return false;
+    }
+    // 端数の長さ
+    u8_data[29] = 0x04;
+    if (!b_pkcs7_unpadding(u8_data, 32, TEST_AES_BLOCK_SIZE, &t_unpad_len) || t_unpad_len != 28) {
+        return false;
+    }
+    return !b_pkcs7_unpadding(u8_data, 31, TEST_AES_BLOCK_SIZE, &t_unpad_len);
+}
+
+/*******************************************************************************
+ *
+ * NAME: b_test_ctr_drbg_vector
+ *
+ * DESCRIPTION:CTR-DRBG：SP 800-90Aの生成、再シード、追加入力
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *
+ * RETURNS:
+ *   true:一致
+ *
+ * NOTES:
+ * AES-256、導出関数有り、予測耐性無しの構成で、エントロピー32バイト、ナンス16バイト、
+ * パーソナライズデータ32バイトでシードし、64バイト生成、再シード（追加入力有り）、
+ * 64バイト生成（追加入力有り）の順に検証する。
+ * 既知解はSP 800-90A 10.2の手順をそのまま実装した参照実装で算出した値
+ ******************************************************************************/
+static bool b_test_ctr_drbg_vector() {
+    ts_test_entropy_t s_entropy;
+    uint8_t u8_personal[32];
+    uint8_t u8_reseed_add[32];
+    uint8_t u8_gen_add[32];
+    uint8_t u8_out[64];
+    size_t t_idx;
+    // エントロピー（初期シード32バイト、ナンス16バイト、再シード32バイト）
+    memset(&s_entropy, 0x00, sizeof(s_entropy));
+    for (t_idx = 0; t_idx < 48; t_idx++) {
+        s_entropy.u8_pool[t_idx] = (uint8_t)t_idx;
+    }
+    for (t_idx = 0; t_idx < 32; t_idx++) {
+        s_entropy.u8_pool[48 + t_idx] = (uint8_t)(0x80 + t_idx);
+        u8_personal[t_idx] = (uint8_t)(0x40 + t_idx);
+        u8_reseed_add[t_idx] = (uint8_t)(0xA0 + t_idx);
+        u8_gen_add[t_idx] = (uint8_t)(0xC0 + t_idx);
+    }
+    mbedtls_ctr_drbg_context s_ctx;
+    mbedtls_ctr_drbg_init(&s_ctx);
+    bool b_result = false;
+    do {
+        // シード
+        mbedtls_ctr_drbg_set_entropy_len(&s_ctx, 32);
+        if (mbedtls_ctr_drbg_set_nonce_len(&s_ctx, 16) != 0) {
+            break;
+        }
+        if (mbedtls_ctr_drbg_seed(&s_ctx, i_test_entropy, &s_entropy, u8_personal, sizeof(u8_personal)) != 0) {
+            break;
+        }
+        // 生成
+        if (mbedtls_ctr_drbg_random_with_add(&s_ctx, u8_out, sizeof(u8_out), NULL, 0) != 0 ||
+            !b_equals_hex(u8_out,
+                "defc57cab840db9d3badca6eb6f525ee87a9290a43d9c8a7b0179ddd6ed3faec"
+                "ef5976e1a626bc7273d3e0e13454478c406c2e3be87a84e75ccc7b19c68d5b79")) {
+            break;
+        }
+        // 再シードと追加入力有りの生成
+        if (mbedtls_ctr_drbg_reseed(&s_ctx, u8_reseed_add, sizeof(u8_reseed_add)) != 0) {
+            break;
+        }
+        if (mbedtls_ctr_drbg_random_with_add(&s_ctx, u8_out, sizeof(u8_out), u8_gen_add, sizeof(u8_gen_add)) != 0 ||
+            !b_equals_hex(u8_out,
+                "c458055a7110c4da9caaa808d79ae98e0c72b7746337388c1abcc43c7c81fc5e"
+                "a91e5da65fbc91e80393f23de11a76dfd5d6d75e43779eaed33fee057f41fa23")) {
+            break;
+        }
+        // 全てのエントロピーを消費
+        b_result = (s_entropy.t_pos == 80);
+    } while (false);
+    mbedtls_ctr_drbg_free(&s_ctx);
+    return b_result;
+}
+
+/*******************************************************************************
+ *
+ * NAME: b_test_chacha20_vector
+ *
+ * DESCRIPTION:ChaCha20：RFC 8439 2.4.2のテストベクタ
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *
+ * RETURNS:
+ *   true:一致
+ *
+ * NOTES:
+ * ブロックカウンタ1からの暗号化を検証する
+ ******************************************************************************/
+static bool b_test_chacha20_vector() {
+    uint8_t u8_key[CRYPTO_CHACHAPOLY_KEY_SIZE];
+    uint8_t u8_nonce[CRYPTO_CHACHAPOLY_NONCE_SIZE];
+    uint8_t u8_data[128];
+    t_hex_to_bytes("000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f", u8_key);
+    t_hex_to_bytes("000000000000004a00000000", u8_nonce);
+    size_t t_len = strlen(pc_sunscreen);
+    v_crypto_chacha20_xor(u8_key, u8_nonce, 1, u8_data, (const uint8_t*)pc_sunscreen, t_len);
+    return b_equals_hex(u8_data,
+        "6e2e359a2568f98041ba0728dd0d6981e97e7aec1d4360c20a27afccfd9fae0b"
+        "f91b65c5524733ab8f593dabcd62b3571639d624e65152ab8f530c359f0861d8"
+        "07ca0dbf500d6a6156a38e088a22b65e52bc514d16ccf806818ce91ab7793736"
+        "5af90bbf74a35be6b40b8eedf2785e42874d");
+}
+
+/*******************************************************************************
+ *
+ * NAME: b_test_poly1305_vector
+ *
+ * DESCRIPTION:Poly1305：RFC 8439 2.5.2のテストベクタ
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *
+ * RETURNS:
+ *   true:一致
+ *
+ * NOTES:
+ * None.
+ ******************************************************************************/
+static bool b_test_poly1305_vector() {
+    uint8_t u8_key[32];
+    uint8_t u8_tag[CRYPTO_CHACHAPOLY_TAG_SIZE];
+    const char* pc_msg = "Cryptographic Forum Research Group";
+    t_hex_to_bytes("85d6be7857556d337f4452fe42d506a80103808afb0db2fd4abff6af4149f51b", u8_key);
+    v_crypto_poly1305_mac(u8_key, (const uint8_t*)pc_msg, strlen(pc_msg), u8_tag);
+    return b_equals_hex(u8_tag, "a8061dc1305136c6c22b8baf0c0127a9");
+}
+
+/*******************************************************************************
+ *
+ * NAME: b_test_aead_vector
+ *
+ * DESCRIPTION:ChaCha20-Poly1305：RFC 8439 2.8.2のテストベクタと改ざん検出
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *
+ * RETURNS:
+ *   true:一致
+ *
+ * NOTES:
+ * 認証タグ、暗号文、追加認証データのいずれを改ざんしても復号が失敗する事を検証する
+ ******************************************************************************/
+static bool b_test_aead_vector() {
+    uint8_t u8_key[CRYPTO_CHACHAPOLY_KEY_SIZE];
+    uint8_t u8_nonce[CRYPTO_CHACHAPOLY_NONCE_SIZE];
+    uint8_t u8_add[12];
+    uint8_t u8_tag[CRYPTO_CHACHAPOLY_TAG_SIZE];
+    uint8_t u8_data[128];
+    uint8_t u8_cipher[128];
+    t_hex_to_bytes("808182838485868788898a8b8c8d8e8f909192939495969798999a9b9c9d9e9f", u8_key);
+    t_hex_to_bytes("070000004041424344454647", u8_nonce);
+    t_hex_to_bytes("50515253c0c1c2c3c4c5c6c7", u8_add);
+    size_t t_len = strlen(pc_sunscreen);
+    memcpy(u8_data, pc_sunscreen, t_len);
+    //--------------------------------------------------------------------------
+    // 暗号化
+    //--------------------------------------------------------------------------
+    v_crypto_chachapoly_enc_in_place(u8_key, u8_nonce, u8_add, sizeof(u8_add), u8_data, t_len, u8_tag);
+    if (!b_equals_hex(u8_data,
+            "d31a8d34648e60db7b86afbc53ef7ec2a4aded51296e08fea9e2b5a736ee62d6"
+            "3dbea45e8ca9671282fafb69da92728b1a71de0a9e060b2905d6a5b67ecd3b36"
+            "92ddbd7f2d778b8c9803aee328091b58fab324e4fad675945585808b4831d7bc"
+            "3ff4def08e4b7a9de576d26586cec64b6116")) {
+        return false;
+    }
+    if (!b_equals_hex(u8_tag, "1ae10b594f09e26a7e902ecbd0600691")) {
+        return false;
+    }
+    memcpy(u8_cipher, u8_data, t_len);
+    //--------------------------------------------------------------------------
+    // 復号
+    //--------------------------------------------------------------------------
+    if (!b_crypto_chachapoly_dec_in_place(u8_key, u8_nonce, u8_add, sizeof(u8_add), u8_data, t_len, u8_tag)) {
+        return false;
+    }
+    if (memcmp(u8_data, pc_sunscreen, t_len) != 0) {
+        return false;
+    }
+    //--------------------------------------------------------------------------
+    // 改ざん検出
+    //--------------------------------------------------------------------------
+    // 認証タグ
+    u8_tag[0] ^= 0x01;
+    memcpy(u8_data, u8_cipher, t_len);
+    if (b_crypto_chachapoly_dec_in_place(u8_key, u8_nonce, u8_add, sizeof(u8_add), u8_data, t_len, u8_tag)) {
+        return false;
+    }
+    u8_tag[0] ^= 0x01;
+    // 暗号文
+    memcpy(u8_data, u8_cipher, t_len);
+    u8_data[t_len - 1] ^= 0x80;
+    if (b_crypto_chachapoly_dec_in_place(u8_key, u8_nonce, u8_add, sizeof(u8_add), u8_data, t_len, u8_tag)) {
+        return false;
+    }
+    // 追加認証データ
+    memcpy(u8_data, u8_cipher, t_len);
+    u8_add[0] ^= 0x01;
+    return !b_crypto_chachapoly_dec_in_place(u8_key, u8_nonce, u8_add, sizeof(u8_add), u8_data, t_len, u8_tag);
+}
+
+/*******************************************************************************
+ *
+ * NAME: b_test_aead_round_trip
+ *
+ * DESCRIPTION:ChaCha20-Poly1305：各データ長での暗号化と復号の往復
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *
+ * RETURNS:
+ *   true:一致
+ *
+ * NOTES:
+ * 0～300バイトの各長さ（ブロック境界と追加認証データ無しを含む）で往復を検証する
+ ******************************************************************************/
+static bool b_test_aead_round_trip() {
+    uint8_t u8_key[CRYPTO_CHACHAPOLY_KEY_SIZE];
+    uint8_t u8_nonce[CRYPTO_CHACHAPOLY_NONCE_SIZE];
+    uint8_t u8_add[16];
+    uint8_t u8_tag[CRYPTO_CHACHAPOLY_TAG_SIZE];
+    uint8_t u8_plane[300];
+    uint8_t u8_data[300];
+    size_t t_idx;
+    for (t_idx = 0; t_idx < sizeof(u8_key); t_idx++) {
+        u8_key[t_idx] = (uint8_t)(t_idx * 13 + 1);
+    }
+    for (t_idx = 0; t_idx < sizeof(u8_nonce); t_idx++) {
+        u8_nonce[t_idx] = (uint8_t)(t_idx * 29 + 5);
+    }
+    for (t_idx = 0; t_idx < sizeof(u8_add); t_idx++) {
+        u8_add[t_idx] = (uint8_t)(t_idx * 3);
+    }
+    for (t_idx = 0; t_idx < sizeof(u8_plane); t_idx++) {
+        u8_plane[t_idx] = (uint8_t)(t_idx * 11 + 7);
+    }
+    size_t t_len;
+    for (t_len = 0; t_len <= sizeof(u8_plane); t_len++) {
+        size_t t_add_len = (t_len % 2 == 0) ? sizeof(u8_add) : 0;
+        memcpy(u8_data, u8_plane, t_len);
+        v_crypto_chachapoly_enc_in_place(u8_key, u8_nonce, u8_add, t_add_len, u8_data, t_len, u8_tag);
+        if (t_len >= 16 && memcmp(u8_data, u8_plane, t_len) == 0) {
+            return false;
+        }
+        if (!b_crypto_chachapoly_dec_in_place(u8_key, u8_nonce, u8_add, t_add_len, u8_data, t_len, u8_tag)) {
+            return false;
+        }
+        if (memcmp(u8_data, u8_plane, t_len) != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/*******************************************************************************
+ *
+ * NAME: b_test_x25519_vector
+ *
+ * DESCRIPTION:X25519：RFC 7748 5.2のスカラー倍算
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *
+ * RETURNS:
+ *   true:一致
+ *
+ * NOTES:
+ * None.
+ ******************************************************************************/
+static bool b_test_x25519_vector() {
+    uint8_t u8_scalar[CRYPTO_X25519_BYTES];
+    uint8_t u8_point[CRYPTO_X25519_BYTES];
+    uint8_t u8_out[CRYPTO_X25519_BYTES];
+    t_hex_to_bytes("a546e36bf0527c9d3b16154b82465edd62144c0ac1fc5a18506a2244ba449ac4", u8_scalar);
+    t_hex_to_bytes("e6db6867583030db3594c1a424b15f7c726624ec26b3353b10a903a6d0ab1c4c", u8_point);
+    if (!b_crypto_x25519_scalarmult(u8_out, u8_scalar, u8_point) ||
+        !b_equals_hex(u8_out, "c3da55379de9c6908e94ea4df28d084f32eccf03491c71f754b4075577a28552")) {
+        return false;
+    }
+    t_hex_to_bytes("4b66e9d4d1b4673c5ad22691957d6af5c11b6421e0ea01d42ca4169e7918ba0d", u8_scalar);
+    t_hex_to_bytes("e5210f12786811d3f4b7959d0538ae2c31dbe7106fc03c3efc4cd549c715a493", u8_point);
+    return b_crypto_x25519_scalarmult(u8_out, u8_scalar, u8_point) &&
+           b_equals_hex(u8_out, "95cbde9476e8907d7aade45cb4b873f88b595a68799fa152e6f8f7647aac7957");
+}
+
+/*******************************************************************************
+ *
+ * NAME: b_test_x25519_iterate
+ *
+ * DESCRIPTION:X25519：RFC 7748 5.2の1,000回の反復
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *
+ * RETURNS:
+ *   true:一致
+ *
+ * NOTES:
+ * k = X25519(k, u)、u = 元のkを反復し、1回目と1,000回目の結果を検証する
+ ******************************************************************************/
+static bool b_test_x25519_iterate() {
+    uint8_t u8_scalar[CRYPTO_X25519_BYTES];
+    uint8_t u8_point[CRYPTO_X25519_BYTES];
+    uint8_t u8_out[CRYPTO_X25519_BYTES];
+    memset(u8_scalar, 0x00, sizeof(u8_scalar));
+    u8_scalar[0] = 0x09;
+    memcpy(u8_point, u8_scalar, sizeof(u8_point));
+    uint32_t u32_cnt;
+    for (u32_cnt = 1; u32_cnt <= 1000; u32_cnt++) {
+        b_crypto_x25519_scalarmult(u8_out, u8_scalar, u8_point);
+        memcpy(u8_point, u8_scalar, sizeof(u8_point));
+        memcpy(u8_scalar, u8_out, sizeof(u8_scalar));
+        if (u32_cnt == 1 &&
+            !b_equals_hex(u8_scalar, "422c8e7a6227d7bca1350b3e2bb7279f7897b87bb6854b783c60e80311ae3079")) {
+            return false;
+        }
+    }
+    return b_equals_hex(u8_scalar, "684cf59ba83309552800ef566f2f4d3c1c3887c49360e3875f2eb94d99532c51");
+}
+
+/*******************************************************************************
+ *
+ * NAME: b_test_x25519_agreement
+ *
+ * DESCRIPTION:X25519：RFC 7748 6.1の鍵共有
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *
+ * RETURNS:
+ *   true:一致
+ *
+ * NOTES:
+ * 双方の公開鍵と、双方で算出した共有鍵を検証する
+ ******************************************************************************/
+static bool b_test_x25519_agreement() {
+    uint8_t u8_alice_priv[CRYPTO_X25519_BYTES];
+    uint8_t u8_alice_pub[CRYPTO_X25519_BYTES];
+    uint8_t u8_bob_priv[CRYPTO_X25519_BYTES];
+    uint8_t u8_bob_pub[CRYPTO_X25519_BYTES];
+    uint8_t u8_shared[CRYPTO_X25519_BYTES];
+    const char* pc_shared = "4a5d9d5ba4ce2de1728e3bf480350f25e07e21c947d19e3376f09b3c1e161742";
+    t_hex_to_bytes("77076d0a7318a57d3c16c17251b26645df4c2f87ebc0992ab177fba51db92c2a", u8_alice_priv);
+    t_hex_to_bytes("5dab087e624a8a4b79e17f8b83800ee66f3bb1292618b6fd1c2f8b27ff88e0eb", u8_bob_priv);
+    // 公開鍵
+    v_crypto_x25519_public_key(u8_alice_pub, u8_alice_priv);
+    if (!b_equals_hex(u8_alice_pub, "8520f0098930a754748b7ddcb43ef75a0dbf3a0d26381af4eba4a98eaa9b4e6a")) {
+        return false;
+    }
+    v_crypto_x25519_public_key(u8_bob_pub, u8_bob_priv);
+    if (!b_equals_hex(u8_bob_pub, "de9edb7d7b7dc1b4d35b61c2ece435373f8343c85b78674dadfc7e146f882b4f")) {
+        return false;
+    }
+    // 共有鍵
+    if (!b_crypto_x25519_scalarmult(u8_shared, u8_alice_priv, u8_bob_pub) || !b_equals_hex(u8_shared, pc_shared)) {
+        return false;
+    }
+    return b_crypto_x25519_scalarmult(u8_shared, u8_bob_priv, u8_alice_pub) && b_equals_hex(u8_shared, pc_shared);
+}
+
+/*******************************************************************************
+ *
+ * NAME: b_test_x25519_low_order
+ *
+ * DESCRIPTION:X25519：小位数点の拒否
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *
+ * RETURNS:
+ *   true:一致
+ *
+ * NOTES:
+ * 共有鍵が全て0になるu=0とu=1の点を拒否する事を検証する
+ ******************************************************************************/
+static bool b_test_x25519_low_order() {
+    uint8_t u8_scalar[CRYPTO_X25519_BYTES];
+    uint8_t u8_point[CRYPTO_X25519_BYTES];
+    uint8_t u8_out[CRYPTO_X25519_BYTES];
+    t_hex_to_bytes("77076d0a7318a57d3c16c17251b26645df4c2f87ebc0992ab177fba51db92c2a", u8_scalar);
+    memset(u8_point, 0x00, sizeof(u8_point));
+    if (b_crypto_x25519_scalarmult(u8_out, u8_scalar, u8_point)) {
+        return false;
+    }
+    u8_point[0] = 0x01;
+    return !b_crypto_x25519_scalarmult(u8_out, u8_scalar, u8_point);
+}
+
+/******************************************************************************/
+/***      END OF FILE                                                       ***/
+/******************************************************************************/
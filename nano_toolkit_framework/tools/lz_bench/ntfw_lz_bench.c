@@ -0,0 +1,316 @@
+/*******************************************************************************
+ *
+ * COMPONENT:Nano Toolkit Framework
+ *
+ * MODULE :LZ compression benchmark tool source file
+ *
+ * CREATED:2024/11/25 20:00:00
+ * AUTHOR :Kakuheiki.Nakanohito
+ *
+ * DESCRIPTION:LZ圧縮のLinux用ベンチマーク
+ *   ntfw_com_lz.cの圧縮と伸長の往復を乱数、ゼロ埋め、センサーステータス相当、
+ *   JSON設定相当のデータで検証した上で、圧縮率と処理速度を計測する。
+ *   不正な圧縮データ（切り詰め、ビット反転）で伸長が範囲外に書き込まない事も検証する
+ *
+ *   Build:gcc -O2 -I../../components/ntfw_com/include -o ntfw_lz_bench
+ *             ntfw_lz_bench.c ../../components/ntfw_com/ntfw_com_lz.c
+ *   Usage:ntfw_lz_bench [loop count]
+ *
+ * CHANGE HISTORY:
+ *
+ * LAST MODIFIED BY:
+ *
+ *******************************************************************************
+ *
+ * Copyright (c) 2024 Kakuheiki.Nakanohito
+ * Released under the MIT license
+ * https://opensource.org/licenses/mit-license.php
+ *
+ ******************************************************************************/
+
+/******************************************************************************/
+/***      Include files                                                     ***/
+/******************************************************************************/
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "ntfw_com_lz.h"
+
+/******************************************************************************/
+/***      Macro Definitions                                                 ***/
+/******************************************************************************/
+/** 計測回数（デフォルト） */
+#define BENCH_LOOP_CNT_DEFAULT  (20000)
+/** 最大データ長 */
+#define BENCH_MAX_LEN           (4096)
+/** 検証の試行回数 */
+#define BENCH_VERIFY_CNT        (2000)
+/** 出力バッファの番兵サイズ */
+#define BENCH_GUARD_LEN         (16)
+/** 番兵の値 */
+#define BENCH_GUARD_VALUE       (0xCC)
+
+/******************************************************************************/
+/***      Type Definitions                                                  ***/
+/******************************************************************************/
+/**
+ * 計測データの種別
+ */
+typedef enum {
+    BENCH_DATA_RANDOM = 0,      // 乱数
+    BENCH_DATA_ZERO,            // ゼロ埋め
+    BENCH_DATA_STATUS,          // センサーステータス相当
+    BENCH_DATA_JSON,            // JSON設定相当
+    BENCH_DATA_CNT,
+} te_bench_data_t;
+
+/******************************************************************************/
+/***      Local Variables                                                   ***/
+/******************************************************************************/
+/** データ種別名 */
+static const char* s_pc_data_name[BENCH_DATA_CNT] = {"random", "zero", "status", "json"};
+/** 計測するデータ長 */
+static const size_t s_data_len[] = {64, 256, 1024, 4096};
+/** 計測用バッファ */
+static uint8_t s_u8_src[BENCH_MAX_LEN];
+static uint8_t s_u8_cmp[COM_LZ_BOUND(BENCH_MAX_LEN) + BENCH_GUARD_LEN];
+static uint8_t s_u8_dec[BENCH_MAX_LEN + BENCH_GUARD_LEN];
+
+/******************************************************************************/
+/***      Local Function Prototypes                                         ***/
+/******************************************************************************/
+/** 現在時刻（ナノ秒） */
+static int64_t i64_now_nsec();
+/** 計測データの生成 */
+static void v_make_data(te_bench_data_t e_type, uint8_t* pu8_dst, size_t t_len);
+/** 往復の検証 */
+static bool b_verify();
+
+/******************************************************************************/
+/***      Exported Functions                                                ***/
+/******************************************************************************/
+
+/*******************************************************************************
+ *
+ * NAME: main
+ *
+ * DESCRIPTION:ベンチマークのメイン処理
+ *
+ * PARAMETERS:      Name            RW  Usage
+ * int              argc            R   引数の数
+ * char*            argv[]          R   引数
+ *
+ * RETURNS:
+ *   int:終了コード
+ *
+ * NOTES:
+ * None.
+ ******************************************************************************/
+int main(int argc, char* argv[]) {
+    //==========================================================================
+    // 引数の解析
+    //==========================================================================
+    uint32_t u32_loop_cnt = BENCH_LOOP_CNT_DEFAULT;
+    if (argc > 1) {
+        u32_loop_cnt = (uint32_t)strtoul(argv[1], NULL, 10);
+        if (u32_loop_cnt == 0) {
+            fprintf(stderr, "Usage:%s [loop count]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    //==========================================================================
+    // 検証
+    //==========================================================================
+    if (!b_verify()) {
+        fprintf(stderr, "lz verify:NG\n");
+        return 1;
+    }
+    printf("lz verify:OK\n");
+
+    //==========================================================================
+    // ベンチマーク
+    //==========================================================================
+    printf("loop count:%u\n", (unsigned)u32_loop_cnt);
+    uint32_t u32_cnt;
+    int64_t i64_begin;
+    int64_t i64_cmp_nsec;
+    int64_t i64_dec_nsec;
+    size_t t_cmp_len = 0;
+    size_t t_dec_len = 0;
+    for (int i_type = 0; i_type < BENCH_DATA_CNT; i_type++) {
+        for (size_t t_len_idx = 0; t_len_idx < sizeof(s_data_len) / sizeof(size_t); t_len_idx++) {
+            size_t t_len = s_data_len[t_len_idx];
+            v_make_data((te_bench_data_t)i_type, s_u8_src, t_len);
+            // 圧縮
+            i64_begin = i64_now_nsec();
+            for (u32_cnt = 0; u32_cnt < u32_loop_cnt; u32_cnt++) {
+                t_cmp_len = t_lz_compress(s_u8_src, t_len, s_u8_cmp, COM_LZ_BOUND(t_len));
+            }
+            i64_cmp_nsec = i64_now_nsec() - i64_begin;
+            // 伸長
+            i64_begin = i64_now_nsec();
+            for (u32_cnt = 0; u32_cnt < u32_loop_cnt; u32_cnt++) {
+                b_lz_decompress(s_u8_cmp, t_cmp_len, s_u8_dec, t_len, &t_dec_len);
+            }
+            i64_dec_nsec = i64_now_nsec() - i64_begin;
+            printf("%-7s %5zu byte -> %5zu byte (%5.1f%%) compress:%8.1f MB/s decompress:%8.1f MB/s\n",
+                   s_pc_data_name[i_type], t_len, t_cmp_len, (double)t_cmp_len * 100.0 / (double)t_len,
+                   (double)t_len * u32_loop_cnt * 1000.0 / (double)i64_cmp_nsec,
+                   (double)t_len * u32_loop_cnt * 1000.0 / (double)i64_dec_nsec);
+        }
+    }
+    return 0;
+}
+
+/******************************************************************************/
+/***      Local Functions                                                   ***/
+/******************************************************************************/
+
+/*******************************************************************************
+ *
+ * NAME: i64_now_nsec
+ *
+ * DESCRIPTION:現在時刻（ナノ秒）
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *
+ * RETURNS:
+ *   int64_t:単調増加時刻（ナノ秒）
+ *
+ * NOTES:
+ * None.
+ ******************************************************************************/
+static int64_t i64_now_nsec() {
+    struct timespec s_ts;
+    clock_gettime(CLOCK_MONOTONIC, &s_ts);
+    return (int64_t)s_ts.tv_sec * 1000000000LL + s_ts.tv_nsec;
+}
+
+/*******************************************************************************
+ *
+ * NAME: v_make_data
+ *
+ * DESCRIPTION:計測データの生成
+ *
+ * PARAMETERS:      Name            RW  Usage
+ * te_bench_data_t  e_type          R   データ種別
+ * uint8_t*         pu8_dst         W   出力先
+ * size_t           t_len           R   データ長
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * None.
+ ******************************************************************************/
+static void v_make_data(te_bench_data_t e_type, uint8_t* pu8_dst, size_t t_len) {
+    size_t t_pos = 0;
+    char c_work[128];
+    int i_len;
+    uint32_t u32_idx = 0;
+    switch (e_type) {
+    case BENCH_DATA_RANDOM:
+        // 乱数
+        for (t_pos = 0; t_pos < t_len; t_pos++) {
+            pu8_dst[t_pos] = (uint8_t)rand();
+        }
+        break;
+    case BENCH_DATA_ZERO:
+        // ゼロ埋め
+        memset(pu8_dst, 0x00, t_len);
+        break;
+    case BENCH_DATA_STATUS:
+        // センサーステータス相当（タイムスタンプと値が少しずつ変化する固定長レコード）
+        while (t_pos < t_len) {
+            uint8_t u8_rec[16] = {0x01, 0x00, (uint8_t)u32_idx, (uint8_t)(u32_idx >> 8), 0x65, 0x2A, 0x00, 0x00,
+                                  (uint8_t)(rand() & 0x03), 0x19, 0x00, 0x00, 0x40, 0x01, 0x00, 0x00};
+            size_t t_cpy = (t_len - t_pos < sizeof(u8_rec)) ? t_len - t_pos : sizeof(u8_rec);
+            memcpy(&pu8_dst[t_pos], u8_rec, t_cpy);
+            t_pos += t_cpy;
+            u32_idx++;
+        }
+        break;
+    case BENCH_DATA_JSON:
+        // JSON設定相当
+        while (t_pos < t_len) {
+            i_len = snprintf(c_work, sizeof(c_work),
+                             "{\"sensor_id\":%u,\"enabled\":true,\"threshold\":%u,\"interval_ms\":1000},",
+                             (unsigned)u32_idx, (unsigned)(rand() % 100));
+            size_t t_cpy = (t_len - t_pos < (size_t)i_len) ? t_len - t_pos : (size_t)i_len;
+            memcpy(&pu8_dst[t_pos], c_work, t_cpy);
+            t_pos += t_cpy;
+            u32_idx++;
+        }
+        break;
+    default:
+        break;
+    }
+}
+
+/*******************************************************************************
+ *
+ * NAME: b_verify
+ *
+ * DESCRIPTION:往復の検証
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *
+ * RETURNS:
+ *   true:全ての検証が正常
+ *
+ * NOTES:
+ * 出力バッファの後ろに番兵を置き、範囲外への書き込みが無い事も確認する。
+ ******************************************************************************/
+static bool b_verify() {
+    size_t t_cmp_len;
+    size_t t_dec_len;
+    for (uint32_t u32_cnt = 0; u32_cnt < BENCH_VERIFY_CNT; u32_cnt++) {
+        te_bench_data_t e_type = (te_bench_data_t)(u32_cnt % BENCH_DATA_CNT);
+        size_t t_len = 1 + (size_t)rand() % BENCH_MAX_LEN;
+        v_make_data(e_type, s_u8_src, t_len);
+        //----------------------------------------------------------------------
+        // 往復（全データ出力）
+        //----------------------------------------------------------------------
+        memset(s_u8_cmp, BENCH_GUARD_VALUE, sizeof(s_u8_cmp));
+        t_cmp_len = t_lz_compress(s_u8_src, t_len, s_u8_cmp, COM_LZ_BOUND(t_len));
+        if (t_cmp_len == 0 || t_cmp_len > COM_LZ_BOUND(t_len) || s_u8_cmp[COM_LZ_BOUND(t_len)] != BENCH_GUARD_VALUE) {
+            fprintf(stderr, "compress error type=%d len=%zu\n", e_type, t_len);
+            return false;
+        }
+        memset(s_u8_dec, BENCH_GUARD_VALUE, sizeof(s_u8_dec));
+        if (!b_lz_decompress(s_u8_cmp, t_cmp_len, s_u8_dec, t_len, &t_dec_len) ||
+            t_dec_len != t_len || memcmp(s_u8_src, s_u8_dec, t_len) != 0 || s_u8_dec[t_len] != BENCH_GUARD_VALUE) {
+            fprintf(stderr, "decompress error type=%d len=%zu\n", e_type, t_len);
+            return false;
+        }
+        //----------------------------------------------------------------------
+        // 縮まない場合の打ち切り
+        //----------------------------------------------------------------------
+        memset(s_u8_cmp, BENCH_GUARD_VALUE, sizeof(s_u8_cmp));
+        size_t t_cap = t_len - 1;
+        size_t t_short = t_lz_compress(s_u8_src, t_len, s_u8_cmp, t_cap);
+        if ((t_short == 0) != (t_cmp_len > t_cap) || s_u8_cmp[t_cap] != BENCH_GUARD_VALUE) {
+            fprintf(stderr, "bounded compress error type=%d len=%zu\n", e_type, t_len);
+            return false;
+        }
+        //----------------------------------------------------------------------
+        // 不正データ（切り詰め、ビット反転）で範囲外に書き込まない事
+        //----------------------------------------------------------------------
+        t_cmp_len = t_lz_compress(s_u8_src, t_len, s_u8_cmp, COM_LZ_BOUND(t_len));
+        s_u8_cmp[(size_t)rand() % t_cmp_len] ^= (uint8_t)(1 << (rand() % 8));
+        memset(s_u8_dec, BENCH_GUARD_VALUE, sizeof(s_u8_dec));
+        b_lz_decompress(s_u8_cmp, t_cmp_len - (size_t)rand() % (t_cmp_len / 2 + 1), s_u8_dec, t_len, &t_dec_len);
+        if (s_u8_dec[t_len] != BENCH_GUARD_VALUE) {
+            fprintf(stderr, "corrupt decompress overrun type=%d len=%zu\n", e_type, t_len);
+            return false;
+        }
+    }
+    return true;
+}
+
+/******************************************************************************/
+/***      END OF FILE                                                       ***/
+/******************************************************************************/
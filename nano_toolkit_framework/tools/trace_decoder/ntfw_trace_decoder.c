@@ -0,0 +1,609 @@
+/*******************************************************************************
+ *
+ * COMPONENT:Nano Toolkit Framework
+ *
+ * MODULE :trace decoder tool source file
+ *
+ * CREATED:2024/11/04 21:00:00
+ * AUTHOR :Kakuheiki.Nakanohito
+ *
+ * DESCRIPTION:トレースバッファ（ntfw_com_debug_util）のLinux用デコーダー
+ *   u32_dbg_trace_drain_fileで出力したバイナリファイル、もしくは
+ *   u32_dbg_trace_drain_logで出力したコンソールログを読み込み、
+ *   レコード一覧、区間統計、メッセージ（シーケンス番号）毎のタイムラインを表示する
+ *   区間開始と区間終了は（コア、イベントID、引数１）の組で対応付け、
+ *   時刻同期レコードでコア毎のサイクルカウントをesp_timerの時刻に揃えてから統合する
+ *
+ *   Build:gcc -O2 -o ntfw_trace_decoder ntfw_trace_decoder.c
+ *   Usage:ntfw_trace_decoder [-l] [-r] <file>
+ *         -l:入力ファイルはコンソールログ（"NTTR:"行を抽出）
+ *         -r:全レコードを表示
+ *
+ * CHANGE HISTORY:
+ *
+ * LAST MODIFIED BY:
+ *
+ *******************************************************************************
+ *
+ * Copyright (c) 2024 Kakuheiki.Nakanohito
+ * Released under the MIT license
+ * https://opensource.org/licenses/mit-license.php
+ *
+ ******************************************************************************/
+/******************************************************************************/
+/***      Include files                                                     ***/
+/******************************************************************************/
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+/******************************************************************************/
+/***      Macro Definitions                                                 ***/
+/******************************************************************************/
+/** トレースファイルのマジックナンバー("NTTR") */
+#define DBG_TRACE_MAGIC         (0x5254544E)
+/** トレースのログ出力接頭辞 */
+#define DBG_TRACE_LOG_PREFIX    "NTTR:"
+/** イベントIDの区間終了フラグ */
+#define DBG_TRACE_END           (0x8000)
+/** 時刻同期のイベントID */
+#define DBG_TRACE_EVT_SYNC      (0x0009)
+/** 最大コア数 */
+#define MAX_CORE_CNT            (8)
+/** 未対応の区間開始の最大数 */
+#define MAX_OPEN_CNT            (64)
+/** 統計対象のイベントID数 */
+#define MAX_EVT_CNT             (0x8000)
+
+/******************************************************************************/
+/***      Type Definitions                                                  ***/
+/******************************************************************************/
+/**
+ * トレースレコード（ntfw_com_debug_util.hと同一レイアウト）
+ */
+typedef struct {
+    uint32_t u32_ccount;
+    uint16_t u16_evt_id;
+    uint8_t u8_core_id;
+    uint8_t u8_seq;
+    uint32_t u32_arg1;
+    uint32_t u32_arg2;
+} ts_dbg_trace_record_t;
+
+/**
+ * ブロックヘッダー（ntfw_com_debug_util.hと同一レイアウト）
+ */
+typedef struct {
+    uint32_t u32_magic;
+    uint16_t u16_version;
+    uint8_t u8_core_id;
+    uint8_t u8_reserved;
+    uint32_t u32_cpu_freq_hz;
+    uint32_t u32_record_cnt;
+    uint32_t u32_lost_cnt;
+} ts_dbg_trace_header_t;
+
+/**
+ * 区間（開始～終了）
+ */
+typedef struct {
+    uint8_t u8_core_id;     // コアID
+    uint16_t u16_evt_id;    // イベントID
+    uint32_t u32_key;       // メッセージキー（終了レコードの引数１）
+    uint32_t u32_arg2;      // 終了レコードの引数２
+    double d_begin_us;      // 開始時刻（esp_timer基準、同期レコードが無い場合はコア毎の先頭レコード基準）
+    double d_elapsed_us;    // 経過時間
+} ts_span_t;
+
+/**
+ * 未対応の区間開始
+ */
+typedef struct {
+    uint16_t u16_evt_id;    // イベントID
+    uint32_t u32_arg1;      // 引数１（メッセージキー）
+    double d_begin_us;      // 開始時刻
+} ts_open_t;
+
+/**
+ * イベント毎の区間統計
+ */
+typedef struct {
+    uint32_t u32_cnt;
+    double d_min_us;
+    double d_max_us;
+    double d_sum_us;
+} ts_span_stat_t;
+
+/******************************************************************************/
+/***      Local Variables                                                   ***/
+/******************************************************************************/
+/** フレームワーク予約イベントの名称（te_dbg_trace_evt_tと一致させる事） */
+static const char* EVT_NAMES[] = {
+    "NONE",
+    "MSG_RX",
+    "MSG_AUTH",
+    "MSG_CHECK",
+    "MSG_EVENT",
+    "MSG_ENCRYPT",
+    "MSG_DECRYPT",
+    "MSG_TX",
+    "MSG_ENQUEUE",
+    "SYNC",
+};
+
+/** 入力データ */
+static uint8_t* pu8_data = NULL;
+/** 入力データサイズ */
+static size_t t_data_size = 0;
+/** 区間リスト */
+static ts_span_t* ps_spans = NULL;
+/** 区間数 */
+static size_t t_span_cnt = 0;
+/** 区間統計 */
+static ts_span_stat_t s_stats[MAX_EVT_CNT];
+/** 時刻同期レコードの無いブロック数 */
+static uint32_t u32_unsync_cnt = 0;
+
+/******************************************************************************/
+/***      Local Function Prototypes                                         ***/
+/******************************************************************************/
+/** バイナリファイルの読み込み */
+static bool b_load_binary(const char* pc_path);
+/** コンソールログの読み込み */
+static bool b_load_log(const char* pc_path);
+/** 入力データの追加 */
+static bool b_append(const uint8_t* pu8_buff, size_t t_size);
+/** イベント名の編集 */
+static const char* pc_evt_name(uint16_t u16_evt_id, char* pc_buff);
+/** ブロックの解析 */
+static void v_decode_block(const ts_dbg_trace_header_t* ps_header, const ts_dbg_trace_record_t* ps_records, bool b_raw);
+/** 区間の追加 */
+static void v_add_span(const ts_span_t* ps_span);
+/** 区間の比較（メッセージキー、開始時刻、コア順） */
+static int i_span_cmp(const void* pv_a, const void* pv_b);
+
+/******************************************************************************/
+/***      Exported Functions                                                ***/
+/******************************************************************************/
+
+/*******************************************************************************
+ *
+ * NAME: main
+ *
+ * DESCRIPTION:メイン処理
+ *
+ * PARAMETERS:      Name        RW  Usage
+ *   int            argc        R   引数の数
+ *   char**         argv        R   引数
+ *
+ * RETURNS:
+ *   int:終了コード
+ *
+ * NOTES:
+ * None.
+ ******************************************************************************/
+int main(int argc, char** argv) {
+    //==========================================================================
+    // 引数解析
+    //==========================================================================
+    bool b_log = false;
+    bool b_raw = false;
+    const char* pc_path = NULL;
+    int i_idx;
+    for (i_idx = 1; i_idx < argc; i_idx++) {
+        if (strcmp(argv[i_idx], "-l") == 0) {
+            b_log = true;
+        } else if (strcmp(argv[i_idx], "-r") == 0) {
+            b_raw = true;
+        } else {
+            pc_path = argv[i_idx];
+        }
+    }
+    if (pc_path == NULL) {
+        fprintf(stderr, "Usage:%s [-l] [-r] <file>\n", argv[0]);
+        return 1;
+    }
+
+    //==========================================================================
+    // 読み込み
+    //==========================================================================
+    bool b_result = b_log ? b_load_log(pc_path) : b_load_binary(pc_path);
+    if (!b_result) {
+        fprintf(stderr, "read error:%s\n", pc_path);
+        return 1;
+    }
+
+    //==========================================================================
+    // ブロック毎に解析
+    //==========================================================================
+    size_t t_pos = 0;
+    while (t_pos + sizeof(ts_dbg_trace_header_t) <= t_data_size) {
+        ts_dbg_trace_header_t s_header;
+        memcpy(&s_header, &pu8_data[t_pos], sizeof(ts_dbg_trace_header_t));
+        if (s_header.u32_magic != DBG_TRACE_MAGIC) {
+            // 同期が外れた場合は１バイトずつ読み飛ばす
+            t_pos++;
+            continue;
+        }
+        t_pos += sizeof(ts_dbg_trace_header_t);
+        size_t t_rec_size = (size_t)s_header.u32_record_cnt * sizeof(ts_dbg_trace_record_t);
+        if (t_pos + t_rec_size > t_data_size) {
+            fprintf(stderr, "truncated block core=%u\n", s_header.u8_core_id);
+            break;
+        }
+        ts_dbg_trace_record_t* ps_records = (ts_dbg_trace_record_t*)malloc(t_rec_size + 1);
+        if (ps_records == NULL) {
+            return 1;
+        }
+        memcpy(ps_records, &pu8_data[t_pos], t_rec_size);
+        v_decode_block(&s_header, ps_records, b_raw);
+        free(ps_records);
+        t_pos += t_rec_size;
+    }
+
+    //==========================================================================
+    // 区間統計の表示
+    //==========================================================================
+    char c_name[32];
+    printf("\n== span statistics (us) ==\n");
+    printf("%-16s %8s %12s %12s %12s\n", "event", "count", "min", "mean", "max");
+    uint32_t u32_evt;
+    for (u32_evt = 0; u32_evt < MAX_EVT_CNT; u32_evt++) {
+        ts_span_stat_t* ps_stat = &s_stats[u32_evt];
+        if (ps_stat->u32_cnt == 0) {
+            continue;
+        }
+        printf("%-16s %8u %12.2f %12.2f %12.2f\n",
+               pc_evt_name((uint16_t)u32_evt, c_name), ps_stat->u32_cnt,
+               ps_stat->d_min_us, ps_stat->d_sum_us / ps_stat->u32_cnt, ps_stat->d_max_us);
+    }
+
+    //==========================================================================
+    // メッセージ毎のタイムライン表示
+    //==========================================================================
+    if (u32_unsync_cnt > 0) {
+        fprintf(stderr, "warning:%u block(s) without sync record, their times are core-relative\n", u32_unsync_cnt);
+    }
+    printf("\n== message timeline (key=seq no, us from first span of the key) ==\n");
+    qsort(ps_spans, t_span_cnt, sizeof(ts_span_t), i_span_cmp);
+    size_t t_idx;
+    double d_origin = 0.0;
+    for (t_idx = 0; t_idx < t_span_cnt; t_idx++) {
+        ts_span_t* ps_span = &ps_spans[t_idx];
+        if (t_idx == 0 || ps_span->u32_key != ps_spans[t_idx - 1].u32_key) {
+            printf("seq=%u\n", ps_span->u32_key);
+            d_origin = ps_span->d_begin_us;
+        }
+        printf("  core%u +%10.2f %-16s %10.2f arg2=%u\n",
+               ps_span->u8_core_id, ps_span->d_begin_us - d_origin,
+               pc_evt_name(ps_span->u16_evt_id, c_name), ps_span->d_elapsed_us, ps_span->u32_arg2);
+    }
+
+    // 後処理
+    free(ps_spans);
+    free(pu8_data);
+    return 0;
+}
+
+/******************************************************************************/
+/***      Local Functions                                                   ***/
+/******************************************************************************/
+
+/*******************************************************************************
+ *
+ * NAME: b_load_binary
+ *
+ * DESCRIPTION:バイナリファイルの読み込み
+ *
+ * PARAMETERS:      Name        RW  Usage
+ *   const char*    pc_path     R   ファイルパス
+ *
+ * RETURNS:
+ *   bool:読み込み結果
+ *
+ * NOTES:
+ * None.
+ ******************************************************************************/
+static bool b_load_binary(const char* pc_path) {
+    FILE* ps_file = fopen(pc_path, "rb");
+    if (ps_file == NULL) {
+        return false;
+    }
+    uint8_t u8_buff[4096];
+    size_t t_len;
+    bool b_result = true;
+    while ((t_len = fread(u8_buff, 1, sizeof(u8_buff), ps_file)) > 0) {
+        if (!b_append(u8_buff, t_len)) {
+            b_result = false;
+            break;
+        }
+    }
+    fclose(ps_file);
+    return b_result;
+}
+
+/*******************************************************************************
+ *
+ * NAME: b_load_log
+ *
+ * DESCRIPTION:コンソールログの読み込み
+ *
+ * PARAMETERS:      Name        RW  Usage
+ *   const char*    pc_path     R   ファイルパス
+ *
+ * RETURNS:
+ *   bool:読み込み結果
+ *
+ * NOTES:
+ * 接頭辞"NTTR:"以降の１６進数文字列をバイナリに変換して連結する
+ ******************************************************************************/
+static bool b_load_log(const char* pc_path) {
+    FILE* ps_file = fopen(pc_path, "r");
+    if (ps_file == NULL) {
+        return false;
+    }
+    char c_line[1024];
+    uint8_t u8_buff[512];
+    bool b_result = true;
+    while (fgets(c_line, sizeof(c_line), ps_file) != NULL) {
+        char* pc_hex = strstr(c_line, DBG_TRACE_LOG_PREFIX);
+        if (pc_hex == NULL) {
+            continue;
+        }
+        pc_hex += strlen(DBG_TRACE_LOG_PREFIX);
+        size_t t_len = 0;
+        unsigned int u_val;
+        while (t_len < sizeof(u8_buff) && sscanf(pc_hex, "%2x", &u_val) == 1) {
+            u8_buff[t_len++] = (uint8_t)u_val;
+            pc_hex += 2;
+        }
+        if (!b_append(u8_buff, t_len)) {
+            b_result = false;
+            break;
+        }
+    }
+    fclose(ps_file);
+    return b_result;
+}
+
+/*******************************************************************************
+ *
+ * NAME: b_append
+ *
+ * DESCRIPTION:入力データの追加
+ *
+ * PARAMETERS:      Name        RW  Usage
+ *   const uint8_t* pu8_buff    R   追加データ
+ *   size_t         t_size      R   追加データサイズ
+ *
+ * RETURNS:
+ *   bool:追加結果
+ *
+ * NOTES:
+ * None.
+ ******************************************************************************/
+static bool b_append(const uint8_t* pu8_buff, size_t t_size) {
+    uint8_t* pu8_new = (uint8_t*)realloc(pu8_data, t_data_size + t_size + 1);
+    if (pu8_new == NULL) {
+        return false;
+    }
+    memcpy(&pu8_new[t_data_size], pu8_buff, t_size);
+    pu8_data = pu8_new;
+    t_data_size += t_size;
+    return true;
+}
+
+/*******************************************************************************
+ *
+ * NAME: pc_evt_name
+ *
+ * DESCRIPTION:イベント名の編集
+ *
+ * PARAMETERS:      Name        RW  Usage
+ *   uint16_t       u16_evt_id  R   イベントID（終了フラグ除く）
+ *   char*          pc_buff     W   編集バッファ（32バイト以上）
+ *
+ * RETURNS:
+ *   const char*:イベント名
+ *
+ * NOTES:
+ * None.
+ ******************************************************************************/
+static const char* pc_evt_name(uint16_t u16_evt_id, char* pc_buff) {
+    if (u16_evt_id < (sizeof(EVT_NAMES) / sizeof(EVT_NAMES[0]))) {
+        return EVT_NAMES[u16_evt_id];
+    }
+    snprintf(pc_buff, 32, "EVT_0x%04X", u16_evt_id);
+    return pc_buff;
+}
+
+/*******************************************************************************
+ *
+ * NAME: v_decode_block
+ *
+ * DESCRIPTION:ブロック（コア毎のレコード列）の解析
+ *
+ * PARAMETERS:                      Name        RW  Usage
+ *   const ts_dbg_trace_header_t*   ps_header   R   ブロックヘッダー
+ *   const ts_dbg_trace_record_t*   ps_records  R   レコード列
+ *   bool                           b_raw       R   全レコード表示フラグ
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * 区間開始レコードを同一のイベントIDと引数１の区間終了レコードと対応付ける。
+ * 時刻は直前（先頭側は直後）の時刻同期レコードを基準にesp_timerの時刻に換算する。
+ ******************************************************************************/
+static void v_decode_block(const ts_dbg_trace_header_t* ps_header, const ts_dbg_trace_record_t* ps_records, bool b_raw) {
+    // サイクル数からマイクロ秒への換算
+    double d_cycle_per_us = (ps_header->u32_cpu_freq_hz > 0) ? (ps_header->u32_cpu_freq_hz / 1000000.0) : 1.0;
+    printf("== core%u records=%u lost=%u cpu=%uHz ==\n",
+           ps_header->u8_core_id, ps_header->u32_record_cnt, ps_header->u32_lost_cnt, ps_header->u32_cpu_freq_hz);
+    uint32_t u32_cnt = ps_header->u32_record_cnt;
+    if (u32_cnt == 0) {
+        return;
+    }
+
+    //--------------------------------------------------------------------------
+    // 時刻の換算
+    //--------------------------------------------------------------------------
+    double* pd_time_us = (double*)malloc(sizeof(double) * u32_cnt);
+    if (pd_time_us == NULL) {
+        return;
+    }
+    // ブロック先頭からの経過時間（サイクルカウントの桁溢れを考慮して差分で積算）
+    uint32_t u32_idx;
+    pd_time_us[0] = 0.0;
+    for (u32_idx = 1; u32_idx < u32_cnt; u32_idx++) {
+        uint32_t u32_delta = ps_records[u32_idx].u32_ccount - ps_records[u32_idx - 1].u32_ccount;
+        pd_time_us[u32_idx] = pd_time_us[u32_idx - 1] + u32_delta / d_cycle_per_us;
+    }
+    // 時刻同期レコードによるesp_timer基準への換算
+    bool b_synced = false;
+    double d_offset_us = 0.0;
+    for (u32_idx = 0; u32_idx < u32_cnt; u32_idx++) {
+        if (ps_records[u32_idx].u16_evt_id == DBG_TRACE_EVT_SYNC) {
+            uint64_t u64_sync_us = ((uint64_t)ps_records[u32_idx].u32_arg2 << 32) | ps_records[u32_idx].u32_arg1;
+            d_offset_us = (double)u64_sync_us - pd_time_us[u32_idx];
+            b_synced = true;
+            break;
+        }
+    }
+    for (u32_idx = 0; u32_idx < u32_cnt; u32_idx++) {
+        if (ps_records[u32_idx].u16_evt_id == DBG_TRACE_EVT_SYNC) {
+            uint64_t u64_sync_us = ((uint64_t)ps_records[u32_idx].u32_arg2 << 32) | ps_records[u32_idx].u32_arg1;
+            d_offset_us = (double)u64_sync_us - pd_time_us[u32_idx];
+        }
+        pd_time_us[u32_idx] += d_offset_us;
+    }
+    if (!b_synced) {
+        u32_unsync_cnt++;
+    }
+
+    //--------------------------------------------------------------------------
+    // 区間の対応付け
+    //--------------------------------------------------------------------------
+    ts_open_t s_open[MAX_OPEN_CNT];
+    uint32_t u32_open_cnt = 0;
+    char c_name[32];
+    for (u32_idx = 0; u32_idx < u32_cnt; u32_idx++) {
+        const ts_dbg_trace_record_t* ps_rec = &ps_records[u32_idx];
+        double d_now_us = pd_time_us[u32_idx];
+        uint16_t u16_evt_id = ps_rec->u16_evt_id & (uint16_t)~DBG_TRACE_END;
+        bool b_end = (ps_rec->u16_evt_id & DBG_TRACE_END) != 0;
+        if (b_raw) {
+            printf("  %16.2f %c %-16s arg1=%u arg2=%u\n",
+                   d_now_us, b_end ? '<' : '>', pc_evt_name(u16_evt_id, c_name), ps_rec->u32_arg1, ps_rec->u32_arg2);
+        }
+        if (u16_evt_id == DBG_TRACE_EVT_SYNC) {
+            continue;
+        }
+        if (!b_end) {
+            // 区間開始を登録（溢れた場合は最古を捨てる）
+            if (u32_open_cnt == MAX_OPEN_CNT) {
+                memmove(&s_open[0], &s_open[1], sizeof(ts_open_t) * (MAX_OPEN_CNT - 1));
+                u32_open_cnt--;
+            }
+            s_open[u32_open_cnt].u16_evt_id = u16_evt_id;
+            s_open[u32_open_cnt].u32_arg1   = ps_rec->u32_arg1;
+            s_open[u32_open_cnt].d_begin_us = d_now_us;
+            u32_open_cnt++;
+            continue;
+        }
+        // 対応する区間開始を新しい方から検索
+        int32_t i32_pos;
+        for (i32_pos = (int32_t)u32_open_cnt - 1; i32_pos >= 0; i32_pos--) {
+            if (s_open[i32_pos].u16_evt_id == u16_evt_id && s_open[i32_pos].u32_arg1 == ps_rec->u32_arg1) {
+                break;
+            }
+        }
+        if (i32_pos < 0) {
+            // 開始レコードが失われている
+            continue;
+        }
+        ts_span_t s_span = {
+            .u8_core_id   = ps_header->u8_core_id,
+            .u16_evt_id   = u16_evt_id,
+            .u32_key      = ps_rec->u32_arg1,
+            .u32_arg2     = ps_rec->u32_arg2,
+            .d_begin_us   = s_open[i32_pos].d_begin_us,
+            .d_elapsed_us = d_now_us - s_open[i32_pos].d_begin_us,
+        };
+        v_add_span(&s_span);
+        // 対応した区間開始のみを除去（交差する他の区間は残す）
+        memmove(&s_open[i32_pos], &s_open[i32_pos + 1], sizeof(ts_open_t) * (u32_open_cnt - (uint32_t)i32_pos - 1));
+        u32_open_cnt--;
+    }
+    free(pd_time_us);
+}
+
+/*******************************************************************************
+ *
+ * NAME: v_add_span
+ *
+ * DESCRIPTION:区間の追加
+ *
+ * PARAMETERS:          Name        RW  Usage
+ *   const ts_span_t*   ps_span     R   区間
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * None.
+ ******************************************************************************/
+static void v_add_span(const ts_span_t* ps_span) {
+    // 統計
+    ts_span_stat_t* ps_stat = &s_stats[ps_span->u16_evt_id];
+    if (ps_stat->u32_cnt == 0 || ps_span->d_elapsed_us < ps_stat->d_min_us) {
+        ps_stat->d_min_us = ps_span->d_elapsed_us;
+    }
+    if (ps_stat->u32_cnt == 0 || ps_span->d_elapsed_us > ps_stat->d_max_us) {
+        ps_stat->d_max_us = ps_span->d_elapsed_us;
+    }
+    ps_stat->d_sum_us += ps_span->d_elapsed_us;
+    ps_stat->u32_cnt++;
+    // 区間リスト
+    ts_span_t* ps_new = (ts_span_t*)realloc(ps_spans, sizeof(ts_span_t) * (t_span_cnt + 1));
+    if (ps_new == NULL) {
+        return;
+    }
+    ps_spans = ps_new;
+    ps_spans[t_span_cnt++] = *ps_span;
+}
+
+/*******************************************************************************
+ *
+ * NAME: i_span_cmp
+ *
+ * DESCRIPTION:区間の比較（メッセージキー、開始時刻、コア順）
+ *
+ * PARAMETERS:      Name        RW  Usage
+ *   const void*    pv_a        R   比較対象A
+ *   const void*    pv_b        R   比較対象B
+ *
+ * RETURNS:
+ *   int:比較結果
+ *
+ * NOTES:
+ * 開始時刻は時刻同期レコードでコア間を揃えた値
+ ******************************************************************************/
+static int i_span_cmp(const void* pv_a, const void* pv_b) {
+    const ts_span_t* ps_a = (const ts_span_t*)pv_a;
+    const ts_span_t* ps_b = (const ts_span_t*)pv_b;
+    if (ps_a->u32_key != ps_b->u32_key) {
+        return (ps_a->u32_key < ps_b->u32_key) ? -1 : 1;
+    }
+    if (ps_a->d_begin_us != ps_b->d_begin_us) {
+        return (ps_a->d_begin_us < ps_b->d_begin_us) ? -1 : 1;
+    }
+    if (ps_a->u8_core_id != ps_b->u8_core_id) {
+        return (ps_a->u8_core_id < ps_b->u8_core_id) ? -1 : 1;
+    }
+    return 0;
+}
+
+/******************************************************************************/
+/***      END OF FILE                                                       ***/
+/******************************************************************************/
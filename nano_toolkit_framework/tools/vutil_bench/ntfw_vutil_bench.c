@@ -0,0 +1,385 @@
+/*******************************************************************************
+ *
+ * COMPONENT:Nano Toolkit Framework
+ *
+ * MODULE :value kernel benchmark tool source file
+ *
+ * CREATED:2024/11/20 21:00:00
+ * AUTHOR :Kakuheiki.Nakanohito
+ *
+ * DESCRIPTION:バイト列一括演算のLinux用ベンチマーク
+ *   ntfw_com_value_kernel.cの各関数をバイト単位のループ（従来実装）と比較検証した上で、
+ *   16B～2KBのサイズで従来実装との処理速度を計測する。
+ *   ESP32は非整列アクセスが例外となる為、アドレス境界を揃えた場合とずらした場合の双方を計測する
+ *
+ *   Build:gcc -O2 -fno-tree-vectorize -I../../components/ntfw_com/include -o ntfw_vutil_bench
+ *             ntfw_vutil_bench.c ../../components/ntfw_com/ntfw_com_value_kernel.c
+ *         (-fno-tree-vectorizeはSIMDの無いESP32に近付ける為の指定)
+ *   Usage:ntfw_vutil_bench [loop count]
+ *
+ * CHANGE HISTORY:
+ *
+ * LAST MODIFIED BY:
+ *
+ *******************************************************************************
+ *
+ * Copyright (c) 2024 Kakuheiki.Nakanohito
+ * Released under the MIT license
+ * https://opensource.org/licenses/mit-license.php
+ *
+ ******************************************************************************/
+
+/******************************************************************************/
+/***      Include files                                                     ***/
+/******************************************************************************/
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "ntfw_com_value_kernel.h"
+
+/******************************************************************************/
+/***      Macro Definitions                                                 ***/
+/******************************************************************************/
+/** 計測回数（デフォルト） */
+#define BENCH_LOOP_CNT_DEFAULT  (200000)
+/** 最大データ長 */
+#define BENCH_MAX_LEN           (2048)
+/** 検証の試行回数 */
+#define BENCH_VERIFY_CNT        (20000)
+
+/******************************************************************************/
+/***      Type Definitions                                                  ***/
+/******************************************************************************/
+
+/******************************************************************************/
+/***      Local Variables                                                   ***/
+/******************************************************************************/
+/** 計測するデータ長 */
+static const size_t s_data_len[] = {16, 32, 64, 256, 2048};
+/** 計測用バッファ（境界をずらす為の余白を含む） */
+static uint8_t s_u8_buff1[BENCH_MAX_LEN + 8] __attribute__((aligned(4)));
+static uint8_t s_u8_buff2[BENCH_MAX_LEN + 8] __attribute__((aligned(4)));
+/** 最適化による除去の抑止 */
+static volatile uint32_t s_u32_sink;
+
+/******************************************************************************/
+/***      Local Function Prototypes                                         ***/
+/******************************************************************************/
+/** 現在時刻（ナノ秒） */
+static int64_t i64_now_nsec();
+/** 従来実装：排他的論理和 */
+static void v_ref_xor_into(uint8_t* pu8_dst, const uint8_t* pu8_src, size_t t_len);
+/** 従来実装：排他的論理和の畳み込み */
+static uint32_t u32_ref_xor_fold(const uint8_t* pu8_src, size_t t_len);
+/** 従来実装：パターン埋め込み */
+static void v_ref_fill_u32(uint8_t* pu8_dst, uint32_t u32_pattern, size_t t_len);
+/** 各関数の検証 */
+static bool b_verify();
+/** 処理時間の表示 */
+static void v_print_rate(const char* pc_name, size_t t_len, uint32_t u32_loop_cnt,
+                         int64_t i64_ref_nsec, int64_t i64_nsec);
+
+/******************************************************************************/
+/***      Exported Functions                                                ***/
+/******************************************************************************/
+
+/*******************************************************************************
+ *
+ * NAME: main
+ *
+ * DESCRIPTION:ベンチマークのメイン処理
+ *
+ * PARAMETERS:      Name            RW  Usage
+ * int              argc            R   引数の数
+ * char*            argv[]          R   引数
+ *
+ * RETURNS:
+ *   int:終了コード
+ *
+ * NOTES:
+ * None.
+ ******************************************************************************/
+int main(int argc, char* argv[]) {
+    //==========================================================================
+    // 引数の解析
+    //==========================================================================
+    uint32_t u32_loop_cnt = BENCH_LOOP_CNT_DEFAULT;
+    if (argc > 1) {
+        u32_loop_cnt = (uint32_t)strtoul(argv[1], NULL, 10);
+        if (u32_loop_cnt == 0) {
+            fprintf(stderr, "Usage:%s [loop count]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    //==========================================================================
+    // 検証
+    //==========================================================================
+    if (!b_verify()) {
+        fprintf(stderr, "value kernel verify:NG\n");
+        return 1;
+    }
+    printf("value kernel verify:OK\n");
+
+    //==========================================================================
+    // ベンチマーク
+    //==========================================================================
+    size_t t_idx;
+    for (t_idx = 0; t_idx < sizeof(s_u8_buff1); t_idx++) {
+        s_u8_buff1[t_idx] = (uint8_t)rand();
+        s_u8_buff2[t_idx] = s_u8_buff1[t_idx];
+    }
+    printf("loop count:%u (ref:byte loop -> kernel)\n", (unsigned)u32_loop_cnt);
+    uint32_t u32_offset;
+    size_t t_len_idx;
+    uint32_t u32_cnt;
+    int64_t i64_begin;
+    int64_t i64_ref;
+    for (u32_offset = 0; u32_offset < 2; u32_offset++) {
+        printf("%s\n", (u32_offset == 0) ? "[aligned]" : "[offset +1]");
+        uint8_t* pu8_dst = &s_u8_buff1[u32_offset];
+        uint8_t* pu8_src = &s_u8_buff2[u32_offset];
+        for (t_len_idx = 0; t_len_idx < sizeof(s_data_len) / sizeof(size_t); t_len_idx++) {
+            size_t t_len = s_data_len[t_len_idx];
+            // 排他的論理和
+            i64_begin = i64_now_nsec();
+            for (u32_cnt = 0; u32_cnt < u32_loop_cnt; u32_cnt++) {
+                v_ref_xor_into(pu8_dst, pu8_src, t_len);
+            }
+            i64_ref = i64_now_nsec() - i64_begin;
+            i64_begin = i64_now_nsec();
+            for (u32_cnt = 0; u32_cnt < u32_loop_cnt; u32_cnt++) {
+                v_vutil_xor_into(pu8_dst, pu8_src, t_len);
+            }
+            v_print_rate("xor_into", t_len, u32_loop_cnt, i64_ref, i64_now_nsec() - i64_begin);
+            // 排他的論理和の畳み込み（マスキング）
+            i64_begin = i64_now_nsec();
+            for (u32_cnt = 0; u32_cnt < u32_loop_cnt; u32_cnt++) {
+                s_u32_sink ^= u32_ref_xor_fold(pu8_src, t_len);
+            }
+            i64_ref = i64_now_nsec() - i64_begin;
+            i64_begin = i64_now_nsec();
+            for (u32_cnt = 0; u32_cnt < u32_loop_cnt; u32_cnt++) {
+                s_u32_sink ^= u32_vutil_xor_fold(pu8_src, t_len);
+            }
+            v_print_rate("xor_fold", t_len, u32_loop_cnt, i64_ref, i64_now_nsec() - i64_begin);
+            // パターン埋め込み
+            i64_begin = i64_now_nsec();
+            for (u32_cnt = 0; u32_cnt < u32_loop_cnt; u32_cnt++) {
+                v_ref_fill_u32(pu8_dst, u32_cnt, t_len);
+            }
+            i64_ref = i64_now_nsec() - i64_begin;
+            i64_begin = i64_now_nsec();
+            for (u32_cnt = 0; u32_cnt < u32_loop_cnt; u32_cnt++) {
+                v_vutil_fill_u32(pu8_dst, u32_cnt, t_len);
+            }
+            v_print_rate("fill_u32", t_len, u32_loop_cnt, i64_ref, i64_now_nsec() - i64_begin);
+            // 比較（一致時、memcmpとの比較）
+            memcpy(pu8_dst, pu8_src, t_len);
+            i64_begin = i64_now_nsec();
+            for (u32_cnt = 0; u32_cnt < u32_loop_cnt; u32_cnt++) {
+                s_u32_sink ^= (uint32_t)memcmp(pu8_dst, pu8_src, t_len);
+            }
+            i64_ref = i64_now_nsec() - i64_begin;
+            i64_begin = i64_now_nsec();
+            for (u32_cnt = 0; u32_cnt < u32_loop_cnt; u32_cnt++) {
+                s_u32_sink ^= (uint32_t)b_vutil_ct_equal(pu8_dst, pu8_src, t_len);
+            }
+            v_print_rate("ct_equal(memcmp)", t_len, u32_loop_cnt, i64_ref, i64_now_nsec() - i64_begin);
+        }
+    }
+    return 0;
+}
+
+/******************************************************************************/
+/***      Local Functions                                                   ***/
+/******************************************************************************/
+
+/*******************************************************************************
+ *
+ * NAME: i64_now_nsec
+ *
+ * DESCRIPTION:現在時刻（ナノ秒）
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *
+ * RETURNS:
+ *   int64_t:単調増加時刻（ナノ秒）
+ *
+ * NOTES:
+ * None.
+ ******************************************************************************/
+static int64_t i64_now_nsec() {
+    struct timespec s_ts;
+    clock_gettime(CLOCK_MONOTONIC, &s_ts);
+    return ((int64_t)s_ts.tv_sec * 1000000000) + s_ts.tv_nsec;
+}
+
+/*******************************************************************************
+ *
+ * NAME: v_ref_xor_into
+ *
+ * DESCRIPTION:従来実装：排他的論理和（v_vutil_maskingの旧実装）
+ *
+ * PARAMETERS:      Name            RW  Usage
+ * uint8_t*         pu8_dst         RW  演算対象
+ * const uint8_t*   pu8_src         R   演算値
+ * size_t           t_len           R   演算サイズ
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * None.
+ ******************************************************************************/
+static __attribute__((noinline)) void v_ref_xor_into(uint8_t* pu8_dst, const uint8_t* pu8_src, size_t t_len) {
+    size_t t_idx;
+    for (t_idx = 0; t_idx < t_len; t_idx++) {
+        pu8_dst[t_idx] = pu8_dst[t_idx] ^ pu8_src[t_idx];
+    }
+}
+
+/*******************************************************************************
+ *
+ * NAME: u32_ref_xor_fold
+ *
+ * DESCRIPTION:従来実装：排他的論理和の畳み込み（u32_vutil_maskingの旧実装）
+ *
+ * PARAMETERS:      Name            RW  Usage
+ * const uint8_t*   pu8_src         R   演算対象
+ * size_t           t_len           R   演算サイズ
+ *
+ * RETURNS:
+ *   uint32_t:畳み込み結果
+ *
+ * NOTES:
+ * None.
+ ******************************************************************************/
+static __attribute__((noinline)) uint32_t u32_ref_xor_fold(const uint8_t* pu8_src, size_t t_len) {
+    uint32_t u32_acc = 0;
+    size_t t_idx;
+    for (t_idx = 0; t_idx < t_len; t_idx++) {
+        u32_acc = u32_acc ^ ((uint32_t)pu8_src[t_idx] << (8 * (t_idx % 4)));
+    }
+    return u32_acc;
+}
+
+/*******************************************************************************
+ *
+ * NAME: v_ref_fill_u32
+ *
+ * DESCRIPTION:従来実装：パターン埋め込み
+ *
+ * PARAMETERS:      Name            RW  Usage
+ * uint8_t*         pu8_dst         W   編集対象
+ * uint32_t         u32_pattern     R   パターン
+ * size_t           t_len           R   編集サイズ
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * None.
+ ******************************************************************************/
+static __attribute__((noinline)) void v_ref_fill_u32(uint8_t* pu8_dst, uint32_t u32_pattern, size_t t_len) {
+    size_t t_idx;
+    for (t_idx = 0; t_idx < t_len; t_idx++) {
+        pu8_dst[t_idx] = (uint8_t)(u32_pattern >> (8 * (t_idx % 4)));
+    }
+}
+
+/*******************************************************************************
+ *
+ * NAME: b_verify
+ *
+ * DESCRIPTION:各関数の検証
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *
+ * RETURNS:
+ *   true:従来実装と一致
+ *
+ * NOTES:
+ * ランダムなサイズとアドレス境界（0～3byteのずれ）の組み合わせで従来実装と比較する
+ ******************************************************************************/
+static bool b_verify() {
+    static uint8_t u8_exp[BENCH_MAX_LEN + 8] __attribute__((aligned(4)));
+    static uint8_t u8_act[BENCH_MAX_LEN + 8] __attribute__((aligned(4)));
+    static uint8_t u8_src[BENCH_MAX_LEN + 8] __attribute__((aligned(4)));
+    uint32_t u32_cnt;
+    size_t t_idx;
+    for (u32_cnt = 0; u32_cnt < BENCH_VERIFY_CNT; u32_cnt++) {
+        size_t t_len = (u32_cnt < 64) ? u32_cnt : (size_t)rand() % BENCH_MAX_LEN;
+        size_t t_dst_off = (size_t)rand() % 4;
+        size_t t_src_off = (size_t)rand() % 4;
+        for (t_idx = 0; t_idx < sizeof(u8_src); t_idx++) {
+            u8_src[t_idx] = (uint8_t)rand();
+            u8_exp[t_idx] = (uint8_t)rand();
+            u8_act[t_idx] = u8_exp[t_idx];
+        }
+        // 排他的論理和
+        v_ref_xor_into(&u8_exp[t_dst_off], &u8_src[t_src_off], t_len);
+        v_vutil_xor_into(&u8_act[t_dst_off], &u8_src[t_src_off], t_len);
+        if (memcmp(u8_exp, u8_act, sizeof(u8_exp)) != 0) {
+            return false;
+        }
+        // 排他的論理和の畳み込み
+        if (u32_ref_xor_fold(&u8_src[t_src_off], t_len) != u32_vutil_xor_fold(&u8_src[t_src_off], t_len)) {
+            return false;
+        }
+        // パターン埋め込み
+        uint32_t u32_pattern = (uint32_t)rand();
+        v_ref_fill_u32(&u8_exp[t_dst_off], u32_pattern, t_len);
+        v_vutil_fill_u32(&u8_act[t_dst_off], u32_pattern, t_len);
+        if (memcmp(u8_exp, u8_act, sizeof(u8_exp)) != 0) {
+            return false;
+        }
+        // 定数時間比較（一致と1byteの不一致）
+        memcpy(&u8_act[t_dst_off], &u8_src[t_src_off], t_len);
+        if (!b_vutil_ct_equal(&u8_act[t_dst_off], &u8_src[t_src_off], t_len)) {
+            return false;
+        }
+        if (t_len > 0) {
+            u8_act[t_dst_off + (size_t)rand() % t_len] ^= (uint8_t)(1 << (rand() % 8));
+            if (b_vutil_ct_equal(&u8_act[t_dst_off], &u8_src[t_src_off], t_len)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+/*******************************************************************************
+ *
+ * NAME: v_print_rate
+ *
+ * DESCRIPTION:処理時間の表示
+ *
+ * PARAMETERS:      Name            RW  Usage
+ * const char*      pc_name         R   関数名
+ * size_t           t_len           R   データ長
+ * uint32_t         u32_loop_cnt    R   計測回数
+ * int64_t          i64_ref_nsec    R   従来実装の経過時間（ナノ秒）
+ * int64_t          i64_nsec        R   経過時間（ナノ秒）
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * None.
+ ******************************************************************************/
+static void v_print_rate(const char* pc_name, size_t t_len, uint32_t u32_loop_cnt,
+                         int64_t i64_ref_nsec, int64_t i64_nsec) {
+    if (i64_nsec <= 0) {
+        i64_nsec = 1;
+    }
+    printf("%-18s len=%4zu %8.1f -> %8.1f ns/op (x%.2f)\n",
+           pc_name, t_len,
+           (double)i64_ref_nsec / (double)u32_loop_cnt,
+           (double)i64_nsec / (double)u32_loop_cnt,
+           (double)i64_ref_nsec / (double)i64_nsec);
+}
+
+/******************************************************************************/
+/***      END OF FILE                                                       ***/
+/******************************************************************************/